@@ -159,6 +159,7 @@ def envoy_dependencies(skip_targets = []):
     _com_github_datadog_dd_opentracing_cpp()
     _com_github_mirror_tclap()
     _com_github_envoyproxy_sqlparser()
+    _com_github_facebook_zstd()
     _com_github_fmtlib_fmt()
     _com_github_gabime_spdlog()
     _com_github_google_benchmark()
@@ -185,6 +186,7 @@ def envoy_dependencies(skip_targets = []):
     _com_lightstep_tracer_cpp()
     _io_opentracing_cpp()
     _net_zlib()
+    _org_brotli()
     _upb()
     _repository_impl("com_googlesource_code_re2")
     _com_google_cel_cpp()
@@ -369,6 +371,27 @@ def _net_zlib():
         actual = "@envoy//bazel/foreign_cc:zlib",
     )
 
+def _org_brotli():
+    _repository_impl("org_brotli")
+    native.bind(
+        name = "brotlienc",
+        actual = "@org_brotli//:brotlienc",
+    )
+    native.bind(
+        name = "brotlidec",
+        actual = "@org_brotli//:brotlidec",
+    )
+
+def _com_github_facebook_zstd():
+    _repository_impl(
+        name = "com_github_facebook_zstd",
+        build_file = "@envoy//bazel/external:zstd.BUILD",
+    )
+    native.bind(
+        name = "zstd",
+        actual = "@com_github_facebook_zstd//:zstd",
+    )
+
 def _com_google_cel_cpp():
     _repository_impl("com_google_cel_cpp")
 
@@ -262,6 +262,21 @@ DEPENDENCY_REPOSITORIES = dict(
         use_category = ["dataplane"],
         cpe = "cpe:2.3:a:gnu:zlib:*",
     ),
+    com_github_facebook_zstd = dict(
+        sha256 = "5194fbfa781fcf45b98c5e849651aa7b3b0a008c6b72d4a0db760f3002291e94",
+        strip_prefix = "zstd-1.5.0",
+        urls = ["https://github.com/facebook/zstd/releases/download/v1.5.0/zstd-1.5.0.tar.gz"],
+        use_category = ["dataplane"],
+        cpe = "N/A",
+    ),
+    org_brotli = dict(
+        # 1.1.0 is the first release able to use custom (shared) dictionaries.
+        sha256 = "e720a6ca29428b803f4ad165371771f5398faba397edf6778837a18599ea13ff",
+        strip_prefix = "brotli-1.1.0",
+        urls = ["https://github.com/google/brotli/archive/v1.1.0.tar.gz"],
+        use_category = ["dataplane"],
+        cpe = "cpe:2.3:a:google:brotli:*",
+    ),
     com_github_jbeder_yaml_cpp = dict(
         sha256 = "77ea1b90b3718aa0c324207cb29418f5bced2354c2e483a9523d98c3460af1ed",
         strip_prefix = "yaml-cpp-yaml-cpp-0.6.3",
@@ -117,6 +117,22 @@ public:
                              const Http::ResponseTrailerMap& response_trailers,
                              const StreamInfo::StreamInfo& stream_info,
                              absl::string_view local_reply_body) const PURE;
+
+  /**
+   * Append a formatted access log line to a buffer. This is equivalent to appending the result of
+   * format(), but lets callers reuse the same buffer for many log lines.
+   * @param request_headers supplies the request headers.
+   * @param response_headers supplies the response headers.
+   * @param response_trailers supplies the response trailers.
+   * @param stream_info supplies the stream info.
+   * @param local_reply_body supplies the local reply body.
+   * @param output supplies the buffer the complete formatted access log line is appended to.
+   */
+  virtual void formatTo(const Http::RequestHeaderMap& request_headers,
+                        const Http::ResponseHeaderMap& response_headers,
+                        const Http::ResponseTrailerMap& response_trailers,
+                        const StreamInfo::StreamInfo& stream_info,
+                        absl::string_view local_reply_body, std::string& output) const PURE;
 };
 
 using FormatterPtr = std::unique_ptr<Formatter>;
@@ -143,6 +159,21 @@ public:
                              const Http::ResponseTrailerMap& response_trailers,
                              const StreamInfo::StreamInfo& stream_info,
                              absl::string_view local_reply_body) const PURE;
+  /**
+   * Append a value extracted from the provided headers/trailers/stream to a buffer, without
+   * building an intermediate string. This is equivalent to appending the result of format().
+   * @param request_headers supplies the request headers.
+   * @param response_headers supplies the response headers.
+   * @param response_trailers supplies the response trailers.
+   * @param stream_info supplies the stream info.
+   * @param local_reply_body supplies the local reply body.
+   * @param output supplies the buffer the extracted value is appended to.
+   */
+  virtual void formatTo(const Http::RequestHeaderMap& request_headers,
+                        const Http::ResponseHeaderMap& response_headers,
+                        const Http::ResponseTrailerMap& response_trailers,
+                        const StreamInfo::StreamInfo& stream_info,
+                        absl::string_view local_reply_body, std::string& output) const PURE;
   /**
    * Extract a value from the provided headers/trailers/stream, preserving the value's type.
    * @param request_headers supplies the request headers.
@@ -238,6 +238,13 @@ public:
    * Updates approximate monotonic time to current value.
    */
   virtual void updateApproximateMonotonicTime() PURE;
+
+  /**
+   * Returns the duration of the longest iteration of the event loop since the previous call, and
+   * starts over. An iteration lasts from the return of the poll to the next poll, while the events
+   * returned by the poll are processed. Must be called from the dispatcher's thread.
+   */
+  virtual std::chrono::microseconds takeMaxLoopDuration() PURE;
 };
 
 using DispatcherPtr = std::unique_ptr<Dispatcher>;
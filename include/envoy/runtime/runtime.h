@@ -15,6 +15,7 @@
 #include "common/singleton/threadsafe_singleton.h"
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -66,6 +67,51 @@ public:
 
 using RandomGeneratorPtr = std::unique_ptr<RandomGenerator>;
 
+/**
+ * A runtime key registered ahead of time, usually when loading configuration. Snapshots resolve
+ * every registered key once when they are created, so that looking up a registered key is an
+ * index into the resolved entries rather than a hash of its name. A key stays registered as long
+ * as a handle to it exists.
+ */
+class KeyHandle {
+public:
+  /**
+   * The registration of a key, released along with the last handle to it. The index of a released
+   * key may be reused by another key, which gets another id.
+   */
+  struct Registration {
+    Registration(absl::string_view name, uint32_t index, uint64_t id)
+        : name_(name), index_(index), id_(id) {}
+
+    const std::string name_;
+    const uint32_t index_;
+    const uint64_t id_;
+  };
+
+  using RegistrationConstSharedPtr = std::shared_ptr<const Registration>;
+
+  explicit KeyHandle(RegistrationConstSharedPtr registration)
+      : registration_(std::move(registration)) {}
+
+  /**
+   * @return const std::string& the name of the key.
+   */
+  const std::string& name() const { return registration_->name_; }
+
+  /**
+   * @return uint32_t the index of the key among the keys currently registered.
+   */
+  uint32_t index() const { return registration_->index_; }
+
+  /**
+   * @return uint64_t the id of the registration, unique for the lifetime of the process.
+   */
+  uint64_t id() const { return registration_->id_; }
+
+private:
+  RegistrationConstSharedPtr registration_;
+};
+
 /**
  * A snapshot of runtime data.
  */
@@ -211,6 +257,20 @@ public:
                               const envoy::type::v3::FractionalPercent& default_value,
                               uint64_t random_value) const PURE;
 
+  /**
+   * Same as the featureEnabled() variants above, for a registered key.
+   */
+  virtual bool featureEnabled(const KeyHandle& key, uint64_t default_value) const PURE;
+  virtual bool featureEnabled(const KeyHandle& key, uint64_t default_value,
+                              uint64_t random_value) const PURE;
+  virtual bool featureEnabled(const KeyHandle& key, uint64_t default_value, uint64_t random_value,
+                              uint64_t num_buckets) const PURE;
+  virtual bool featureEnabled(const KeyHandle& key,
+                              const envoy::type::v3::FractionalPercent& default_value) const PURE;
+  virtual bool featureEnabled(const KeyHandle& key,
+                              const envoy::type::v3::FractionalPercent& default_value,
+                              uint64_t random_value) const PURE;
+
   using ConstStringOptRef = absl::optional<std::reference_wrapper<const std::string>>;
   /**
    * Fetch raw runtime data based on key.
@@ -247,6 +307,13 @@ public:
    */
   virtual bool getBoolean(absl::string_view key, bool default_value) const PURE;
 
+  /**
+   * Same as getInteger(), getDouble() and getBoolean() above, for a registered key.
+   */
+  virtual uint64_t getInteger(const KeyHandle& key, uint64_t default_value) const PURE;
+  virtual double getDouble(const KeyHandle& key, double default_value) const PURE;
+  virtual bool getBoolean(const KeyHandle& key, bool default_value) const PURE;
+
   /**
    * Fetch the OverrideLayers that provide values in this snapshot. Layers are ordered from bottom
    * to top; for instance, the second layer's entries override the first layer's entries, and so on.
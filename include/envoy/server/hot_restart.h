@@ -5,12 +5,15 @@
 
 #include "envoy/common/pure.h"
 #include "envoy/event/dispatcher.h"
+#include "envoy/ssl/context_manager.h"
 #include "envoy/stats/allocator.h"
 #include "envoy/stats/store.h"
 #include "envoy/thread/thread.h"
 
 #include "source/server/hot_restart.pb.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -74,6 +77,13 @@ public:
    */
   virtual ServerStatsFromParent mergeParentStatsIfAny(Stats::StoreRoot& stats_store) PURE;
 
+  /**
+   * Retrieve the TLS session resumption state (shared session cache and rotated session ticket
+   * keys) from our parent process, so that clients can keep resuming sessions across the restart.
+   * @return the parent's state, or absl::nullopt if there is not currently a parent.
+   */
+  virtual absl::optional<Ssl::SessionResumptionState> getParentSessionResumptionState() PURE;
+
   /**
    * Shutdown the half of our hot restarter that acts as a parent.
    */
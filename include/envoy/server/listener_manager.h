@@ -58,8 +58,10 @@ public:
   /**
    * @return an LDS API provider.
    * @param lds_config supplies the management server configuration.
+   * @param decode_threads supplies the number of threads decoding the resources of updates.
    */
-  virtual LdsApiPtr createLdsApi(const envoy::config::core::v3::ConfigSource& lds_config) PURE;
+  virtual LdsApiPtr createLdsApi(const envoy::config::core::v3::ConfigSource& lds_config,
+                                 uint32_t decode_threads) PURE;
 
   /**
    * Creates a socket.
@@ -157,8 +159,10 @@ public:
    * during server initialization because the listener manager is created prior to several core
    * pieces of the server existing.
    * @param lds_config supplies the management server configuration.
+   * @param decode_threads supplies the number of threads decoding the resources of updates.
    */
-  virtual void createLdsApi(const envoy::config::core::v3::ConfigSource& lds_config) PURE;
+  virtual void createLdsApi(const envoy::config::core::v3::ConfigSource& lds_config,
+                            uint32_t decode_threads) PURE;
 
   /**
    * @return std::vector<std::reference_wrapper<Network::ListenerConfig>> a list of the currently
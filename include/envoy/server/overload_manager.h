@@ -29,7 +29,9 @@ enum class OverloadActionState {
 using OverloadActionCb = std::function<void(OverloadActionState)>;
 
 /**
- * Thread-local copy of the state of each configured overload action.
+ * Thread-local copy of the state and of the scale of each configured overload action. The scale of
+ * an action is between 0 when it is inactive and 1 when it is active, or saturated. Actions
+ * triggered by scaled triggers take the values in between.
  */
 class ThreadLocalOverloadState : public ThreadLocal::ThreadLocalObject {
 public:
@@ -50,8 +52,19 @@ public:
     }
   }
 
+  const double& getScale(const std::string& action) {
+    auto it = scales_.find(action);
+    if (it == scales_.end()) {
+      it = scales_.insert(std::make_pair(action, 0.0)).first;
+    }
+    return it->second;
+  }
+
+  void setScale(const std::string& action, double scale) { scales_[action] = scale; }
+
 private:
   std::unordered_map<std::string, OverloadActionState> actions_;
+  std::unordered_map<std::string, double> scales_;
 };
 
 /**
@@ -70,6 +83,12 @@ public:
 
   // Overload action to try to shrink the heap by releasing free memory.
   const std::string ShrinkHeap = "envoy.overload_actions.shrink_heap";
+
+  // Scaled overload action to reject the given fraction of new HTTP requests.
+  const std::string ShedRequests = "envoy.overload_actions.shed_requests";
+
+  // Scaled overload action to shorten the idle timeout of HTTP connections by the given fraction.
+  const std::string ReduceTimeouts = "envoy.overload_actions.reduce_timeouts";
 };
 
 using OverloadActionNames = ConstSingleton<OverloadActionNameValues>;
@@ -117,6 +136,12 @@ public:
   static const OverloadActionState& getInactiveState() {
     CONSTRUCT_ON_FIRST_USE(OverloadActionState, OverloadActionState::Inactive);
   }
+
+  /**
+   * Convenience method to get a statically allocated reference to the scale of an inactive
+   * overload action, the counterpart of getInactiveState() for scaled actions.
+   */
+  static const double& getInactiveScale() { CONSTRUCT_ON_FIRST_USE(double, 0.0); }
 };
 
 } // namespace Server
@@ -6,6 +6,7 @@
 #include "envoy/event/dispatcher.h"
 #include "envoy/protobuf/message_validator.h"
 #include "envoy/server/resource_monitor.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "common/protobuf/protobuf.h"
 
@@ -23,6 +24,12 @@ public:
    */
   virtual Event::Dispatcher& dispatcher() PURE;
 
+  /**
+   * @return ThreadLocal::SlotAllocator& the thread local storage, which reaches the dispatchers of
+   *         the main thread and of the workers.
+   */
+  virtual ThreadLocal::SlotAllocator& threadLocal() PURE;
+
   /**
    * @return reference to the Api object
    */
@@ -134,6 +134,24 @@ public:
    * @return True if stateless TLS session resumption is disabled, false otherwise.
    */
   virtual bool disableStatelessSessionResumption() const PURE;
+
+  /**
+   * @return the interval at which the internally-generated session ticket keys shared by all
+   * server contexts are rotated, or absl::nullopt if the context doesn't use them.
+   */
+  virtual absl::optional<std::chrono::seconds> sessionTicketKeysRotationInterval() const PURE;
+
+  /**
+   * @return the number of sessions to keep in the session cache shared by all server contexts,
+   * or 0 if the context uses its own session cache.
+   */
+  virtual uint32_t sharedSessionCacheSize() const PURE;
+
+  /**
+   * @return the maximum number of certificates to keep loaded if the certificate is selected by
+   * SNI among the configured certificates, or absl::nullopt if it is selected by key type only.
+   */
+  virtual absl::optional<uint32_t> maxLoadedSniCertificates() const PURE;
 };
 
 using ServerContextConfigPtr = std::unique_ptr<ServerContextConfig>;
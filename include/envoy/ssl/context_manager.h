@@ -1,6 +1,8 @@
 #pragma once
 
 #include <functional>
+#include <string>
+#include <vector>
 
 #include "envoy/common/time.h"
 #include "envoy/config/typed_config.h"
@@ -12,6 +14,21 @@
 namespace Envoy {
 namespace Ssl {
 
+/**
+ * TLS session resumption state shared by all server contexts of the process. It is handed over
+ * to the new process on hot restart, so that clients keep resuming their sessions.
+ */
+struct SessionResumptionState {
+  // Sessions of the shared session cache, serialized with SSL_SESSION_to_bytes(). Most recently
+  // used first.
+  std::vector<std::string> sessions_;
+  // Rotated session ticket keys, serialized in the same 80 byte format as configured session
+  // ticket keys. The first key is the one used for encrypting new tickets.
+  std::vector<std::string> ticket_keys_;
+  // When the first ticket key was generated.
+  SystemTime ticket_key_created_;
+};
+
 /**
  * Manages all of the SSL contexts in the process
  */
@@ -47,6 +64,18 @@ public:
    * context manager.
    */
   virtual PrivateKeyMethodManager& privateKeyMethodManager() PURE;
+
+  /**
+   * @return the session resumption state shared by all server contexts, to be handed over to the
+   * new process on hot restart.
+   */
+  virtual SessionResumptionState exportSessionResumptionState() const PURE;
+
+  /**
+   * Seed the session resumption state shared by all server contexts with the state of the parent
+   * process. This must be called before any server context is created.
+   */
+  virtual void importSessionResumptionState(const SessionResumptionState& state) PURE;
 };
 
 using ContextManagerPtr = std::unique_ptr<ContextManager>;
@@ -68,6 +68,59 @@ public:
 
 using ClusterUpdateCallbacksHandlePtr = std::unique_ptr<ClusterUpdateCallbacksHandle>;
 
+/**
+ * Status of an on-demand cluster discovery, passed to its ClusterDiscoveryCallback.
+ */
+enum class ClusterDiscoveryStatus {
+  // The management server does not know the cluster.
+  Missing,
+  // The cluster was not discovered before the timeout of the discovery.
+  Timeout,
+  // The cluster is available on the thread which requested its discovery.
+  Available,
+};
+
+using ClusterDiscoveryCallback = std::function<void(ClusterDiscoveryStatus)>;
+using ClusterDiscoveryCallbackPtr = std::unique_ptr<ClusterDiscoveryCallback>;
+
+/**
+ * ClusterDiscoveryCallbackHandle is a RAII wrapper for a ClusterDiscoveryCallback. Deleting the
+ * handle before the discovery completes discards the callback, without stopping the discovery.
+ */
+class ClusterDiscoveryCallbackHandle {
+public:
+  virtual ~ClusterDiscoveryCallbackHandle() = default;
+};
+
+using ClusterDiscoveryCallbackHandlePtr = std::unique_ptr<ClusterDiscoveryCallbackHandle>;
+
+/**
+ * A handle to an on-demand CDS (ODCDS) subscription, through which clusters unknown to the
+ * cluster manager are discovered lazily when first needed.
+ */
+class OdCdsApiHandle {
+public:
+  virtual ~OdCdsApiHandle() = default;
+
+  /**
+   * Request the discovery of a cluster. This can be called from any thread, and the callback is
+   * invoked on the calling thread once the cluster is available there, or once the discovery
+   * failed. Concurrent requests for the same cluster share a single discovery, whose timeout is the
+   * one of the request that started it. If the cluster is already available on the calling thread,
+   * the callback is invoked before returning nullptr.
+   *
+   * @param name is the name of the cluster to discover.
+   * @param callback is invoked once the discovery completes.
+   * @param timeout is how long to wait for the discovery before failing with a timeout.
+   * @return ClusterDiscoveryCallbackHandlePtr the handle to delete to discard the callback.
+   */
+  virtual ClusterDiscoveryCallbackHandlePtr
+  requestOnDemandClusterDiscovery(const std::string& name, ClusterDiscoveryCallbackPtr callback,
+                                  std::chrono::milliseconds timeout) PURE;
+};
+
+using OdCdsApiHandlePtr = std::unique_ptr<OdCdsApiHandle>;
+
 class ClusterManagerFactory;
 
 /**
@@ -214,6 +267,12 @@ public:
    */
   virtual const envoy::config::core::v3::BindConfig& bindConfig() const PURE;
 
+  /**
+   * @return bool whether the stats and circuit breakers of clusters are only created the first
+   *         time they are used.
+   */
+  virtual bool lazyClusterStats() const PURE;
+
   /**
    * Returns a shared_ptr to the singleton xDS-over-gRPC provider for upstream control plane muxing
    * of xDS. This is treated somewhat as a special case in ClusterManager, since it does not relate
@@ -262,6 +321,21 @@ public:
    * @return Config::SubscriptionFactory& the subscription factory.
    */
   virtual Config::SubscriptionFactory& subscriptionFactory() PURE;
+
+  /**
+   * Allocate an on-demand CDS subscription. Clusters discovered through it are added as dynamic
+   * clusters, and removed again once they served no request for the idle timeout. This must be
+   * called from the main thread, while the returned handle may be used from any thread.
+   *
+   * @param odcds_config is the configuration source of the clusters, which must be a delta xDS one.
+   * @param idle_timeout is how long an unused discovered cluster is kept, 0 to keep them forever.
+   * @param validation_visitor is used to validate the discovered clusters.
+   * @return OdCdsApiHandlePtr the handle of the subscription.
+   */
+  virtual OdCdsApiHandlePtr
+  allocateOdCdsApi(const envoy::config::core::v3::ConfigSource& odcds_config,
+                   std::chrono::milliseconds idle_timeout,
+                   ProtobufMessage::ValidationVisitor& validation_visitor) PURE;
 };
 
 using ClusterManagerPtr = std::unique_ptr<ClusterManager>;
@@ -334,9 +408,12 @@ public:
 
   /**
    * Create a CDS API provider from configuration proto.
+   * @param cds_config supplies the management server configuration.
+   * @param cm supplies the cluster manager applying the updates.
+   * @param decode_threads supplies the number of threads decoding the resources of updates.
    */
   virtual CdsApiPtr createCds(const envoy::config::core::v3::ConfigSource& cds_config,
-                              ClusterManager& cm) PURE;
+                              ClusterManager& cm, uint32_t decode_threads) PURE;
 
   /**
    * Returns the secret manager.
@@ -513,11 +513,10 @@ public:
 };
 
 /**
- * All cluster stats. @see stats_macros.h
+ * All cluster stats, other than the endpoint stats. These are only updated as the cluster is used,
+ * so they may be created lazily. @see stats_macros.h
  */
 #define ALL_CLUSTER_STATS(COUNTER, GAUGE, HISTOGRAM)                                               \
-  COUNTER(assignment_stale)                                                                        \
-  COUNTER(assignment_timeout_received)                                                             \
   COUNTER(bind_errors)                                                                             \
   COUNTER(lb_healthy_panic)                                                                        \
   COUNTER(lb_local_cluster_not_ok)                                                                 \
@@ -533,14 +532,8 @@ public:
   COUNTER(lb_zone_routing_all_directly)                                                            \
   COUNTER(lb_zone_routing_cross_zone)                                                              \
   COUNTER(lb_zone_routing_sampled)                                                                 \
-  COUNTER(membership_change)                                                                       \
   COUNTER(original_dst_host_invalid)                                                               \
   COUNTER(retry_or_shadow_abandoned)                                                               \
-  COUNTER(update_attempt)                                                                          \
-  COUNTER(update_empty)                                                                            \
-  COUNTER(update_failure)                                                                          \
-  COUNTER(update_no_rebuild)                                                                       \
-  COUNTER(update_success)                                                                          \
   COUNTER(upstream_cx_close_notify)                                                                \
   COUNTER(upstream_cx_connect_attempts_exceeded)                                                   \
   COUNTER(upstream_cx_connect_fail)                                                                \
@@ -585,20 +578,35 @@ public:
   COUNTER(upstream_rq_total)                                                                       \
   COUNTER(upstream_rq_tx_reset)                                                                    \
   GAUGE(lb_subsets_active, Accumulate)                                                             \
-  GAUGE(max_host_weight, NeverImport)                                                              \
-  GAUGE(membership_degraded, NeverImport)                                                          \
-  GAUGE(membership_excluded, NeverImport)                                                          \
-  GAUGE(membership_healthy, NeverImport)                                                           \
-  GAUGE(membership_total, NeverImport)                                                             \
   GAUGE(upstream_cx_active, Accumulate)                                                            \
   GAUGE(upstream_cx_rx_bytes_buffered, Accumulate)                                                 \
   GAUGE(upstream_cx_tx_bytes_buffered, Accumulate)                                                 \
   GAUGE(upstream_rq_active, Accumulate)                                                            \
   GAUGE(upstream_rq_pending_active, Accumulate)                                                    \
-  GAUGE(version, NeverImport)                                                                      \
   HISTOGRAM(upstream_cx_connect_ms, Milliseconds)                                                  \
   HISTOGRAM(upstream_cx_length_ms, Milliseconds)
 
+/**
+ * All cluster endpoint stats. These are maintained by the main thread as the endpoints of the
+ * cluster are discovered and updated, so they are created along with the cluster. @see
+ * stats_macros.h
+ */
+#define ALL_CLUSTER_ENDPOINT_STATS(COUNTER, GAUGE)                                                 \
+  COUNTER(assignment_stale)                                                                        \
+  COUNTER(assignment_timeout_received)                                                             \
+  COUNTER(membership_change)                                                                       \
+  COUNTER(update_attempt)                                                                          \
+  COUNTER(update_empty)                                                                            \
+  COUNTER(update_failure)                                                                          \
+  COUNTER(update_no_rebuild)                                                                       \
+  COUNTER(update_success)                                                                          \
+  GAUGE(max_host_weight, NeverImport)                                                              \
+  GAUGE(membership_degraded, NeverImport)                                                          \
+  GAUGE(membership_excluded, NeverImport)                                                          \
+  GAUGE(membership_healthy, NeverImport)                                                           \
+  GAUGE(membership_total, NeverImport)                                                             \
+  GAUGE(version, NeverImport)
+
 /**
  * All cluster load report stats. These are only use for EDS load reporting and not sent to the
  * stats sink. See envoy.api.v2.endpoint.ClusterStats for the definition of upstream_rq_dropped.
@@ -636,6 +644,13 @@ struct ClusterStats {
   ALL_CLUSTER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT, GENERATE_HISTOGRAM_STRUCT)
 };
 
+/**
+ * Struct definition for all cluster endpoint stats. @see stats_macros.h
+ */
+struct ClusterEndpointStats {
+  ALL_CLUSTER_ENDPOINT_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
 /**
  * Struct definition for all cluster load report stats. @see stats_macros.h
  */
@@ -828,10 +843,16 @@ public:
   virtual TransportSocketMatcher& transportSocketMatcher() const PURE;
 
   /**
-   * @return ClusterStats& strongly named stats for this cluster.
+   * @return ClusterStats& strongly named stats for this cluster. These may be created on the first
+   *         call, so callers should avoid this on clusters that are not otherwise in use.
    */
   virtual ClusterStats& stats() const PURE;
 
+  /**
+   * @return ClusterEndpointStats& strongly named endpoint stats for this cluster.
+   */
+  virtual ClusterEndpointStats& endpointStats() const PURE;
+
   /**
    * @return the stats scope that contains all cluster stats. This can be used to produce dynamic
    *         stats that will be freed when the cluster is removed.
@@ -1,7 +1,10 @@
 #include "common/access_log/access_log_formatter.h"
 
+#include <algorithm>
 #include <climits>
+#include <cmath>
 #include <cstdint>
+#include <map>
 #include <regex>
 #include <string>
 #include <vector>
@@ -49,6 +52,13 @@ const std::regex& getStartTimeNewlinePattern() {
 }
 const std::regex& getNewlinePattern() { CONSTRUCT_ON_FIRST_USE(std::regex, "\n"); }
 
+// Whether a character is written as is in a JSON string. Other characters are escaped, as the
+// protobuf JSON printer does, which also escapes '<', '>' and DEL.
+bool isJsonSafe(char c) {
+  const unsigned char uc = c;
+  return uc >= 0x20 && uc < 0x7f && c != '"' && c != '\\' && c != '<' && c != '>';
+}
+
 } // namespace
 
 const std::string AccessLogFormatUtils::DEFAULT_FORMAT =
@@ -100,21 +110,55 @@ std::string FormatterImpl::format(const Http::RequestHeaderMap& request_headers,
                                   absl::string_view local_reply_body) const {
   std::string log_line;
   log_line.reserve(256);
+  formatTo(request_headers, response_headers, response_trailers, stream_info, local_reply_body,
+           log_line);
+  return log_line;
+}
 
+void FormatterImpl::formatTo(const Http::RequestHeaderMap& request_headers,
+                             const Http::ResponseHeaderMap& response_headers,
+                             const Http::ResponseTrailerMap& response_trailers,
+                             const StreamInfo::StreamInfo& stream_info,
+                             absl::string_view local_reply_body, std::string& output) const {
   for (const FormatterProviderPtr& provider : providers_) {
-    log_line += provider->format(request_headers, response_headers, response_trailers, stream_info,
-                                 local_reply_body);
+    provider->formatTo(request_headers, response_headers, response_trailers, stream_info,
+                       local_reply_body, output);
   }
-
-  return log_line;
 }
 
 JsonFormatterImpl::JsonFormatterImpl(
-    const absl::flat_hash_map<std::string, std::string>& format_mapping, bool preserve_types)
-    : preserve_types_(preserve_types) {
-  for (const auto& pair : format_mapping) {
-    json_output_format_.emplace(pair.first, AccessLogFormatParser::parse(pair.second));
+    const absl::flat_hash_map<std::string, std::string>& format_mapping, bool preserve_types) {
+  const std::map<std::string, std::string> sorted_format_mapping(format_mapping.begin(),
+                                                                 format_mapping.end());
+  std::string json = "{";
+  for (const auto& pair : sorted_format_mapping) {
+    if (&pair != &*sorted_format_mapping.begin()) {
+      json += ',';
+    }
+    AccessLogJsonUtils::appendString(pair.first, json);
+    json += ':';
+
+    std::vector<FormatterProviderPtr> providers = AccessLogFormatParser::parse(pair.second);
+    const bool constant =
+        std::all_of(providers.begin(), providers.end(), [](const FormatterProviderPtr& provider) {
+          return dynamic_cast<const PlainStringFormatter*>(provider.get()) != nullptr;
+        });
+    if (constant) {
+      // The value is known now, and becomes part of the text preceding the next value.
+      std::string value;
+      for (const FormatterProviderPtr& provider : providers) {
+        value += static_cast<const PlainStringFormatter&>(*provider).value();
+      }
+      AccessLogJsonUtils::appendString(value, json);
+      continue;
+    }
+
+    const bool typed = preserve_types && providers.size() == 1;
+    values_.push_back({std::move(json), std::move(providers), typed});
+    json.clear();
   }
+  json += "}\n";
+  suffix_ = std::move(json);
 }
 
 std::string JsonFormatterImpl::format(const Http::RequestHeaderMap& request_headers,
@@ -122,44 +166,128 @@ std::string JsonFormatterImpl::format(const Http::RequestHeaderMap& request_head
                                       const Http::ResponseTrailerMap& response_trailers,
                                       const StreamInfo::StreamInfo& stream_info,
                                       absl::string_view local_reply_body) const {
-  const auto output_struct =
-      toStruct(request_headers, response_headers, response_trailers, stream_info, local_reply_body);
+  std::string log_line;
+  log_line.reserve(256);
+  formatTo(request_headers, response_headers, response_trailers, stream_info, local_reply_body,
+           log_line);
+  return log_line;
+}
+
+void JsonFormatterImpl::formatTo(const Http::RequestHeaderMap& request_headers,
+                                 const Http::ResponseHeaderMap& response_headers,
+                                 const Http::ResponseTrailerMap& response_trailers,
+                                 const StreamInfo::StreamInfo& stream_info,
+                                 absl::string_view local_reply_body, std::string& output) const {
+  for (const JsonValue& value : values_) {
+    output += value.prefix_;
+    if (value.typed_) {
+      AccessLogJsonUtils::appendValue(
+          value.providers_.front()->formatValue(request_headers, response_headers,
+                                                response_trailers, stream_info, local_reply_body),
+          output);
+      continue;
+    }
 
-  const std::string log_line = MessageUtil::getJsonStringFromMessage(output_struct, false, true);
-  return absl::StrCat(log_line, "\n");
+    // Values are written unescaped first, and escaped only when needed.
+    const size_t start = output.size();
+    for (const FormatterProviderPtr& provider : value.providers_) {
+      provider->formatTo(request_headers, response_headers, response_trailers, stream_info,
+                         local_reply_body, output);
+    }
+    AccessLogJsonUtils::quoteTail(output, start);
+  }
+  output += suffix_;
 }
 
-ProtobufWkt::Struct JsonFormatterImpl::toStruct(const Http::RequestHeaderMap& request_headers,
-                                                const Http::ResponseHeaderMap& response_headers,
-                                                const Http::ResponseTrailerMap& response_trailers,
-                                                const StreamInfo::StreamInfo& stream_info,
-                                                absl::string_view local_reply_body) const {
-  ProtobufWkt::Struct output;
-  auto* fields = output.mutable_fields();
-  for (const auto& pair : json_output_format_) {
-    const auto& providers = pair.second;
-    ASSERT(!providers.empty());
-
-    if (providers.size() == 1) {
-      const auto& provider = providers.front();
-      const auto val =
-          preserve_types_ ? provider->formatValue(request_headers, response_headers,
-                                                  response_trailers, stream_info, local_reply_body)
-                          : ValueUtil::stringValue(
-                                provider->format(request_headers, response_headers,
-                                                 response_trailers, stream_info, local_reply_body));
-      (*fields)[pair.first] = val;
-    } else {
-      // Multiple providers forces string output.
-      std::string str;
-      for (const auto& provider : providers) {
-        str += provider->format(request_headers, response_headers, response_trailers, stream_info,
-                                local_reply_body);
-      }
-      (*fields)[pair.first] = ValueUtil::stringValue(str);
+void AccessLogJsonUtils::appendString(absl::string_view value, std::string& output) {
+  static constexpr char Hex[] = "0123456789abcdef";
+
+  const size_t begin = output.size();
+  output += '"';
+  for (const char c : value) {
+    if (isJsonSafe(c)) {
+      output += c;
+      continue;
+    }
+    if (static_cast<unsigned char>(c) >= 0x80) {
+      // Non-ASCII strings are left to the protobuf JSON printer, which also validates and escapes
+      // some UTF-8 sequences.
+      output.resize(begin);
+      output += MessageUtil::getJsonStringFromMessage(ValueUtil::stringValue(std::string(value)),
+                                                      false, true);
+      return;
+    }
+    switch (c) {
+    case '"':
+      output += "\\\"";
+      break;
+    case '\\':
+      output += "\\\\";
+      break;
+    case '\b':
+      output += "\\b";
+      break;
+    case '\f':
+      output += "\\f";
+      break;
+    case '\n':
+      output += "\\n";
+      break;
+    case '\r':
+      output += "\\r";
+      break;
+    case '\t':
+      output += "\\t";
+      break;
+    default:
+      output += "\\u00";
+      output += Hex[static_cast<unsigned char>(c) >> 4];
+      output += Hex[static_cast<unsigned char>(c) & 0xf];
+      break;
     }
   }
-  return output;
+  output += '"';
+}
+
+void AccessLogJsonUtils::quoteTail(std::string& output, size_t start) {
+  const absl::string_view tail = absl::string_view(output).substr(start);
+  if (std::all_of(tail.begin(), tail.end(), isJsonSafe)) {
+    output.insert(start, 1, '"');
+    output += '"';
+    return;
+  }
+
+  const std::string raw(tail);
+  output.resize(start);
+  appendString(raw, output);
+}
+
+void AccessLogJsonUtils::appendValue(const ProtobufWkt::Value& value, std::string& output) {
+  switch (value.kind_case()) {
+  case ProtobufWkt::Value::kNullValue:
+    output += "null";
+    return;
+  case ProtobufWkt::Value::kBoolValue:
+    output += value.bool_value() ? "true" : "false";
+    return;
+  case ProtobufWkt::Value::kStringValue:
+    appendString(value.string_value(), output);
+    return;
+  case ProtobufWkt::Value::kNumberValue: {
+    // Integers short enough to be printed in full by the protobuf JSON printer, which covers the
+    // byte counts, durations and response codes.
+    const double number = value.number_value();
+    if (number >= 0 && number < 1e15 && !std::signbit(number) && number == std::floor(number)) {
+      const fmt::format_int formatted(static_cast<uint64_t>(number));
+      output.append(formatted.data(), formatted.size());
+      return;
+    }
+    break;
+  }
+  default:
+    break;
+  }
+  output += MessageUtil::getJsonStringFromMessage(value, false, true);
 }
 
 void AccessLogFormatParser::parseCommandHeader(const std::string& token, const size_t start,
@@ -360,6 +488,9 @@ public:
   std::string extract(const StreamInfo::StreamInfo& stream_info) const override {
     return field_extractor_(stream_info);
   }
+  void extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    output += field_extractor_(stream_info);
+  }
   ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo& stream_info) const override {
     return ValueUtil::stringValue(field_extractor_(stream_info));
   }
@@ -384,6 +515,10 @@ public:
 
     return str.value();
   }
+  void extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    const auto str = field_extractor_(stream_info);
+    output += str ? str.value() : UnspecifiedValueString;
+  }
   ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo& stream_info) const override {
     const auto str = field_extractor_(stream_info);
     if (!str) {
@@ -414,6 +549,16 @@ public:
 
     return fmt::format_int(millis.value()).str();
   }
+  void extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    const auto millis = extractMillis(stream_info);
+    if (!millis) {
+      output += UnspecifiedValueString;
+      return;
+    }
+
+    const fmt::format_int formatted(millis.value());
+    output.append(formatted.data(), formatted.size());
+  }
   ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo& stream_info) const override {
     const auto millis = extractMillis(stream_info);
     if (!millis) {
@@ -446,6 +591,10 @@ public:
   std::string extract(const StreamInfo::StreamInfo& stream_info) const override {
     return fmt::format_int(field_extractor_(stream_info)).str();
   }
+  void extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    const fmt::format_int formatted(field_extractor_(stream_info));
+    output.append(formatted.data(), formatted.size());
+  }
   ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo& stream_info) const override {
     return ValueUtil::numberValue(field_extractor_(stream_info));
   }
@@ -488,6 +637,17 @@ public:
 
     return toString(*address);
   }
+  void extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    Network::Address::InstanceConstSharedPtr address = field_extractor_(stream_info);
+    if (!address) {
+      output += UnspecifiedValueString;
+    } else if (extraction_type_ ==
+               StreamInfoFormatter::StreamInfoAddressFieldExtractionType::WithPort) {
+      output += address->asString();
+    } else {
+      output += toString(*address);
+    }
+  }
   ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo& stream_info) const override {
     Network::Address::InstanceConstSharedPtr address = field_extractor_(stream_info);
     if (!address) {
@@ -534,6 +694,16 @@ public:
     return value;
   }
 
+  void extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    if (stream_info.downstreamSslConnection() == nullptr) {
+      output += UnspecifiedValueString;
+      return;
+    }
+
+    const auto value = field_extractor_(*stream_info.downstreamSslConnection());
+    output += value.empty() ? UnspecifiedValueString : value;
+  }
+
   ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo& stream_info) const override {
     if (stream_info.downstreamSslConnection() == nullptr) {
       return unspecifiedValue();
@@ -775,6 +945,13 @@ std::string StreamInfoFormatter::format(const Http::RequestHeaderMap&,
   return field_extractor_->extract(stream_info);
 }
 
+void StreamInfoFormatter::formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                                   const Http::ResponseTrailerMap&,
+                                   const StreamInfo::StreamInfo& stream_info, absl::string_view,
+                                   std::string& output) const {
+  field_extractor_->extractTo(stream_info, output);
+}
+
 ProtobufWkt::Value StreamInfoFormatter::formatValue(const Http::RequestHeaderMap&,
                                                     const Http::ResponseHeaderMap&,
                                                     const Http::ResponseTrailerMap&,
@@ -792,6 +969,12 @@ std::string PlainStringFormatter::format(const Http::RequestHeaderMap&,
   return str_.string_value();
 }
 
+void PlainStringFormatter::formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                                    const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
+                                    absl::string_view, std::string& output) const {
+  output += str_.string_value();
+}
+
 ProtobufWkt::Value PlainStringFormatter::formatValue(const Http::RequestHeaderMap&,
                                                      const Http::ResponseHeaderMap&,
                                                      const Http::ResponseTrailerMap&,
@@ -808,6 +991,15 @@ std::string LocalReplyBodyFormatter::format(const Http::RequestHeaderMap&,
   return std::string(local_reply_body);
 }
 
+void LocalReplyBodyFormatter::formatTo(const Http::RequestHeaderMap&,
+                                       const Http::ResponseHeaderMap&,
+                                       const Http::ResponseTrailerMap&,
+                                       const StreamInfo::StreamInfo&,
+                                       absl::string_view local_reply_body,
+                                       std::string& output) const {
+  output.append(local_reply_body.data(), local_reply_body.size());
+}
+
 ProtobufWkt::Value LocalReplyBodyFormatter::formatValue(const Http::RequestHeaderMap&,
                                                         const Http::ResponseHeaderMap&,
                                                         const Http::ResponseTrailerMap&,
@@ -842,6 +1034,20 @@ std::string HeaderFormatter::format(const Http::HeaderMap& headers) const {
   return val;
 }
 
+void HeaderFormatter::formatTo(const Http::HeaderMap& headers, std::string& output) const {
+  const Http::HeaderEntry* header = findHeader(headers);
+  if (!header) {
+    output += UnspecifiedValueString;
+    return;
+  }
+
+  absl::string_view val = header->value().getStringView();
+  if (max_length_) {
+    val = val.substr(0, max_length_.value());
+  }
+  output.append(val.data(), val.size());
+}
+
 ProtobufWkt::Value HeaderFormatter::formatValue(const Http::HeaderMap& headers) const {
   const Http::HeaderEntry* header = findHeader(headers);
   if (!header) {
@@ -866,6 +1072,14 @@ std::string ResponseHeaderFormatter::format(const Http::RequestHeaderMap&,
   return HeaderFormatter::format(response_headers);
 }
 
+void ResponseHeaderFormatter::formatTo(const Http::RequestHeaderMap&,
+                                       const Http::ResponseHeaderMap& response_headers,
+                                       const Http::ResponseTrailerMap&,
+                                       const StreamInfo::StreamInfo&, absl::string_view,
+                                       std::string& output) const {
+  HeaderFormatter::formatTo(response_headers, output);
+}
+
 ProtobufWkt::Value ResponseHeaderFormatter::formatValue(
     const Http::RequestHeaderMap&, const Http::ResponseHeaderMap& response_headers,
     const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view) const {
@@ -884,6 +1098,14 @@ std::string RequestHeaderFormatter::format(const Http::RequestHeaderMap& request
   return HeaderFormatter::format(request_headers);
 }
 
+void RequestHeaderFormatter::formatTo(const Http::RequestHeaderMap& request_headers,
+                                      const Http::ResponseHeaderMap&,
+                                      const Http::ResponseTrailerMap&,
+                                      const StreamInfo::StreamInfo&, absl::string_view,
+                                      std::string& output) const {
+  HeaderFormatter::formatTo(request_headers, output);
+}
+
 ProtobufWkt::Value
 RequestHeaderFormatter::formatValue(const Http::RequestHeaderMap& request_headers,
                                     const Http::ResponseHeaderMap&, const Http::ResponseTrailerMap&,
@@ -904,6 +1126,14 @@ std::string ResponseTrailerFormatter::format(const Http::RequestHeaderMap&,
   return HeaderFormatter::format(response_trailers);
 }
 
+void ResponseTrailerFormatter::formatTo(const Http::RequestHeaderMap&,
+                                        const Http::ResponseHeaderMap&,
+                                        const Http::ResponseTrailerMap& response_trailers,
+                                        const StreamInfo::StreamInfo&, absl::string_view,
+                                        std::string& output) const {
+  HeaderFormatter::formatTo(response_trailers, output);
+}
+
 ProtobufWkt::Value
 ResponseTrailerFormatter::formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                       const Http::ResponseTrailerMap& response_trailers,
@@ -933,6 +1163,14 @@ std::string GrpcStatusFormatter::format(const Http::RequestHeaderMap&,
   return grpc_status_message;
 }
 
+void GrpcStatusFormatter::formatTo(const Http::RequestHeaderMap& request_headers,
+                                   const Http::ResponseHeaderMap& response_headers,
+                                   const Http::ResponseTrailerMap& response_trailers,
+                                   const StreamInfo::StreamInfo& info,
+                                   absl::string_view local_reply_body, std::string& output) const {
+  output += format(request_headers, response_headers, response_trailers, info, local_reply_body);
+}
+
 ProtobufWkt::Value
 GrpcStatusFormatter::formatValue(const Http::RequestHeaderMap&,
                                  const Http::ResponseHeaderMap& response_headers,
@@ -1002,6 +1240,14 @@ std::string DynamicMetadataFormatter::format(const Http::RequestHeaderMap&,
   return MetadataFormatter::formatMetadata(stream_info.dynamicMetadata());
 }
 
+void DynamicMetadataFormatter::formatTo(const Http::RequestHeaderMap&,
+                                        const Http::ResponseHeaderMap&,
+                                        const Http::ResponseTrailerMap&,
+                                        const StreamInfo::StreamInfo& stream_info,
+                                        absl::string_view, std::string& output) const {
+  output += MetadataFormatter::formatMetadata(stream_info.dynamicMetadata());
+}
+
 ProtobufWkt::Value DynamicMetadataFormatter::formatValue(const Http::RequestHeaderMap&,
                                                          const Http::ResponseHeaderMap&,
                                                          const Http::ResponseTrailerMap&,
@@ -1060,6 +1306,15 @@ std::string FilterStateFormatter::format(const Http::RequestHeaderMap&,
   return value;
 }
 
+void FilterStateFormatter::formatTo(const Http::RequestHeaderMap& request_headers,
+                                    const Http::ResponseHeaderMap& response_headers,
+                                    const Http::ResponseTrailerMap& response_trailers,
+                                    const StreamInfo::StreamInfo& stream_info,
+                                    absl::string_view local_reply_body, std::string& output) const {
+  output +=
+      format(request_headers, response_headers, response_trailers, stream_info, local_reply_body);
+}
+
 ProtobufWkt::Value FilterStateFormatter::formatValue(const Http::RequestHeaderMap&,
                                                      const Http::ResponseHeaderMap&,
                                                      const Http::ResponseTrailerMap&,
@@ -1107,6 +1362,17 @@ std::string StartTimeFormatter::format(const Http::RequestHeaderMap&,
   }
 }
 
+void StartTimeFormatter::formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                                  const Http::ResponseTrailerMap&,
+                                  const StreamInfo::StreamInfo& stream_info, absl::string_view,
+                                  std::string& output) const {
+  if (date_formatter_.formatString().empty()) {
+    AccessLogDateTimeFormatter::fromTimeTo(stream_info.startTime(), output);
+  } else {
+    date_formatter_.fromTimeTo(stream_info.startTime(), output);
+  }
+}
+
 ProtobufWkt::Value StartTimeFormatter::formatValue(
     const Http::RequestHeaderMap& request_headers, const Http::ResponseHeaderMap& response_headers,
     const Http::ResponseTrailerMap& response_trailers, const StreamInfo::StreamInfo& stream_info,
@@ -98,11 +98,22 @@ public:
                      const Http::ResponseTrailerMap& response_trailers,
                      const StreamInfo::StreamInfo& stream_info,
                      absl::string_view local_reply_body) const override;
+  void formatTo(const Http::RequestHeaderMap& request_headers,
+                const Http::ResponseHeaderMap& response_headers,
+                const Http::ResponseTrailerMap& response_trailers,
+                const StreamInfo::StreamInfo& stream_info, absl::string_view local_reply_body,
+                std::string& output) const override;
 
 private:
   std::vector<FormatterProviderPtr> providers_;
 };
 
+/**
+ * JSON formatter implementation. The format mapping is compiled once into the JSON text known at
+ * configuration time, i.e. the punctuation, the escaped keys and the values without any command,
+ * interleaved with the commands. Each log line is then written directly into the output, without
+ * building a ProtobufWkt::Struct. Keys are written in lexicographic order.
+ */
 class JsonFormatterImpl : public Formatter {
 public:
   JsonFormatterImpl(const absl::flat_hash_map<std::string, std::string>& format_mapping,
@@ -114,16 +125,52 @@ public:
                      const Http::ResponseTrailerMap& response_trailers,
                      const StreamInfo::StreamInfo& stream_info,
                      absl::string_view local_reply_body) const override;
+  void formatTo(const Http::RequestHeaderMap& request_headers,
+                const Http::ResponseHeaderMap& response_headers,
+                const Http::ResponseTrailerMap& response_trailers,
+                const StreamInfo::StreamInfo& stream_info, absl::string_view local_reply_body,
+                std::string& output) const override;
 
 private:
-  const bool preserve_types_;
-  std::map<const std::string, const std::vector<FormatterProviderPtr>> json_output_format_;
-
-  ProtobufWkt::Struct toStruct(const Http::RequestHeaderMap& request_headers,
-                               const Http::ResponseHeaderMap& response_headers,
-                               const Http::ResponseTrailerMap& response_trailers,
-                               const StreamInfo::StreamInfo& stream_info,
-                               absl::string_view local_reply_body) const;
+  // A value of the log line computed for each log line, along with the JSON text preceding it.
+  struct JsonValue {
+    std::string prefix_;
+    std::vector<FormatterProviderPtr> providers_;
+    // Only values made of a single command keep their type, others are always strings.
+    bool typed_;
+  };
+
+  std::vector<JsonValue> values_;
+  // The JSON text following the last value, terminated by a newline.
+  std::string suffix_;
+};
+
+/**
+ * Utilities writing the JSON representation of access log values, as
+ * MessageUtil::getJsonStringFromMessage() would.
+ */
+class AccessLogJsonUtils {
+public:
+  /**
+   * Append a string as a quoted and escaped JSON string.
+   * @param value supplies the string to append.
+   * @param output supplies the buffer the JSON string is appended to.
+   */
+  static void appendString(absl::string_view value, std::string& output);
+
+  /**
+   * Quote and escape in place the end of a buffer, starting at a given position.
+   * @param output supplies the buffer to quote and escape.
+   * @param start supplies the position of the first character to quote and escape.
+   */
+  static void quoteTail(std::string& output, size_t start);
+
+  /**
+   * Append the JSON representation of a value.
+   * @param value supplies the value to append.
+   * @param output supplies the buffer the JSON value is appended to.
+   */
+  static void appendValue(const ProtobufWkt::Value& value, std::string& output);
 };
 
 /**
@@ -138,10 +185,15 @@ public:
   std::string format(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                      const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                      absl::string_view) const override;
+  void formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view,
+                std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
 
+  const std::string& value() const { return str_.string_value(); }
+
 private:
   ProtobufWkt::Value str_;
 };
@@ -157,6 +209,9 @@ public:
   std::string format(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                      const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                      absl::string_view local_reply_body) const override;
+  void formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view,
+                std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view local_reply_body) const override;
@@ -169,6 +224,7 @@ public:
 
 protected:
   std::string format(const Http::HeaderMap& headers) const;
+  void formatTo(const Http::HeaderMap& headers, std::string& output) const;
   ProtobufWkt::Value formatValue(const Http::HeaderMap& headers) const;
 
 private:
@@ -191,6 +247,9 @@ public:
   std::string format(const Http::RequestHeaderMap& request_headers, const Http::ResponseHeaderMap&,
                      const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                      absl::string_view) const override;
+  void formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view,
+                std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
@@ -208,6 +267,9 @@ public:
   std::string format(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap& response_headers,
                      const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                      absl::string_view) const override;
+  void formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view,
+                std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
@@ -225,6 +287,9 @@ public:
   std::string format(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                      const Http::ResponseTrailerMap& response_trailers,
                      const StreamInfo::StreamInfo&, absl::string_view) const override;
+  void formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view,
+                std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
@@ -242,6 +307,9 @@ public:
   std::string format(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap& response_headers,
                      const Http::ResponseTrailerMap& response_trailers,
                      const StreamInfo::StreamInfo&, absl::string_view) const override;
+  void formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view,
+                std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
@@ -258,6 +326,9 @@ public:
   std::string format(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                      const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                      absl::string_view) const override;
+  void formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view,
+                std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
@@ -267,6 +338,7 @@ public:
     virtual ~FieldExtractor() = default;
 
     virtual std::string extract(const StreamInfo::StreamInfo&) const PURE;
+    virtual void extractTo(const StreamInfo::StreamInfo&, std::string& output) const PURE;
     virtual ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo&) const PURE;
   };
   using FieldExtractorPtr = std::unique_ptr<FieldExtractor>;
@@ -307,6 +379,9 @@ public:
   std::string format(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                      const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                      absl::string_view) const override;
+  void formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view,
+                std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
@@ -324,6 +399,9 @@ public:
   std::string format(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                      const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                      absl::string_view) const override;
+  void formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view,
+                std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
@@ -349,6 +427,9 @@ public:
   std::string format(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                      const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                      absl::string_view) const override;
+  void formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view,
+                std::string& output) const override;
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
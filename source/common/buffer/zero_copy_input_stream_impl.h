@@ -36,7 +36,9 @@ public:
   // LimitingInputStream before passing to protobuf code to avoid a spin loop.
   bool Next(const void** data, int* size) override;
   void BackUp(int count) override;
-  bool Skip(int count) override; // Not implemented
+  // Skip() returns false if fewer than count bytes are buffered, whether or not the stream is
+  // finished.
+  bool Skip(int count) override;
   ProtobufTypes::Int64 ByteCount() const override { return byte_count_; }
 
 protected:
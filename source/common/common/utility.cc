@@ -36,19 +36,24 @@ public:
 using SpecifierConstants = ConstSingleton<SpecifierConstantValues>;
 using UnsignedMilliseconds = std::chrono::duration<uint64_t, std::milli>;
 
+constexpr uint64_t Pow10[] = {1,      10,      100,      1000,      10000,
+                              100000, 1000000, 10000000, 100000000, 1000000000};
+
 } // namespace
 
 std::string DateFormatter::fromTime(const SystemTime& time) const {
-  struct CachedTime {
-    // The string length of a number of seconds since the Epoch. E.g. for "1528270093", the length
-    // is 10.
-    size_t seconds_length;
+  std::string formatted_time;
+  fromTimeTo(time, formatted_time);
+  return formatted_time;
+}
 
+void DateFormatter::fromTimeTo(const SystemTime& time, std::string& output) const {
+  struct CachedTime {
     // A container object to hold a absl::FormatTime string, its timestamp (in seconds) and a list
     // of position offsets for each specifier found in a format string.
     struct Formatted {
       // The resulted string after format string is passed to absl::FormatTime at a given point in
-      // time.
+      // time. Subsecond specifiers are left as '?' placeholders of their width.
       std::string str;
 
       // A timestamp (in seconds) when this object is created.
@@ -60,7 +65,7 @@ std::string DateFormatter::fromTime(const SystemTime& time) const {
       SpecifierOffsets specifier_offsets;
     };
     // A map is used to keep different formatted format strings at a given second.
-    std::unordered_map<std::string, const Formatted> formatted;
+    std::unordered_map<std::string, Formatted> formatted;
   };
   static thread_local CachedTime cached_time;
 
@@ -70,11 +75,11 @@ std::string DateFormatter::fromTime(const SystemTime& time) const {
   const std::chrono::seconds epoch_time_seconds =
       std::chrono::duration_cast<std::chrono::seconds>(epoch_time_ns);
 
-  const auto& item = cached_time.formatted.find(raw_format_string_);
+  auto item = cached_time.formatted.find(raw_format_string_);
   if (item == cached_time.formatted.end() ||
       item->second.epoch_time_seconds != epoch_time_seconds) {
     // Remove all the expired cached items.
-    for (auto it = cached_time.formatted.cbegin(); it != cached_time.formatted.cend();) {
+    for (auto it = cached_time.formatted.begin(); it != cached_time.formatted.end();) {
       if (it->second.epoch_time_seconds != epoch_time_seconds) {
         it = cached_time.formatted.erase(it);
       } else {
@@ -89,41 +94,44 @@ std::string DateFormatter::fromTime(const SystemTime& time) const {
     const std::string seconds_str = fmt::format_int(epoch_time_seconds.count()).str();
     formatted.str =
         fromTimeAndPrepareSpecifierOffsets(current_time, formatted.specifier_offsets, seconds_str);
-    cached_time.seconds_length = seconds_str.size();
 
     // Stamp the formatted string using the current epoch time in seconds, and then cache it in.
     formatted.epoch_time_seconds = epoch_time_seconds;
-    cached_time.formatted.emplace(std::make_pair(raw_format_string_, formatted));
+    item = cached_time.formatted.emplace(raw_format_string_, std::move(formatted)).first;
   }
 
-  const auto& formatted = cached_time.formatted.at(raw_format_string_);
+  const auto& formatted = item->second;
   ASSERT(specifiers_.size() == formatted.specifier_offsets.size());
 
-  // Copy the current cached formatted format string, then replace its subseconds part (when it has
-  // non-zero width) by correcting its position using prepared subseconds offsets.
-  std::string formatted_str = formatted.str;
-  std::string nanoseconds = fmt::format_int(epoch_time_ns.count()).str();
-  // Special case handling for beginning of time, we should never need to do this outside of
-  // tests or a time machine.
-  if (nanoseconds.size() < 10) {
-    nanoseconds = std::string(10 - nanoseconds.size(), '0') + nanoseconds;
-  }
-
+  // Append the cached formatted format string, with its subseconds placeholders (when they have
+  // non-zero width) replaced by the subseconds of the given time. Only the digits of the
+  // subseconds are computed for each call.
+  const uint64_t subseconds = static_cast<uint64_t>(
+      (epoch_time_ns - std::chrono::duration_cast<std::chrono::nanoseconds>(epoch_time_seconds))
+          .count());
+  size_t appended = 0;
   for (size_t i = 0; i < specifiers_.size(); ++i) {
-    const auto& specifier = specifiers_.at(i);
+    const auto& specifier = specifiers_[i];
 
     // When specifier.width_ is zero, skip the replacement. This is the last segment or it has no
     // specifier.
     if (specifier.width_ > 0 && !specifier.second_) {
-      ASSERT(specifier.position_ + formatted.specifier_offsets.at(i) < formatted_str.size());
-      formatted_str.replace(specifier.position_ + formatted.specifier_offsets.at(i),
-                            specifier.width_,
-                            nanoseconds.substr(cached_time.seconds_length, specifier.width_));
+      const size_t position = specifier.position_ + formatted.specifier_offsets[i];
+      ASSERT(position + specifier.width_ <= formatted.str.size());
+      output.append(formatted.str, appended, position - appended);
+
+      // The first specifier.width_ digits of the nanoseconds, zero padded.
+      char digits[9];
+      uint64_t value = subseconds / Pow10[9 - specifier.width_];
+      for (size_t digit = specifier.width_; digit > 0; --digit) {
+        digits[digit - 1] = '0' + value % 10;
+        value /= 10;
+      }
+      output.append(digits, specifier.width_);
+      appended = position + specifier.width_;
     }
   }
-
-  ASSERT(formatted_str.size() == formatted.str.size());
-  return formatted_str;
+  output.append(formatted.str, appended, std::string::npos);
 }
 
 void DateFormatter::parse(const std::string& format_string) {
@@ -421,6 +429,12 @@ const std::string& getDefaultDateFormat() {
 }
 
 std::string AccessLogDateTimeFormatter::fromTime(const SystemTime& system_time) {
+  std::string formatted_time;
+  fromTimeTo(system_time, formatted_time);
+  return formatted_time;
+}
+
+void AccessLogDateTimeFormatter::fromTimeTo(const SystemTime& system_time, std::string& output) {
   struct CachedTime {
     std::chrono::seconds epoch_time_seconds;
     std::string formatted_time;
@@ -450,7 +464,7 @@ std::string AccessLogDateTimeFormatter::fromTime(const SystemTime& system_time)
     cached_time.formatted_time[offset++] = ('0' + msec);
   }
 
-  return cached_time.formatted_time;
+  output += cached_time.formatted_time;
 }
 
 const std::string& StringUtil::nonEmptyStringOrDefault(const std::string& s,
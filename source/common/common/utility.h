@@ -32,6 +32,14 @@ public:
    */
   std::string fromTime(const SystemTime& time) const;
 
+  /**
+   * Append the GMT/UTC time based on the input time to a buffer. The formatted time is cached for
+   * each second and each thread, so that only its subseconds are formatted on each call.
+   * @param time supplies the time to format.
+   * @param output supplies the buffer the formatted time is appended to.
+   */
+  void fromTimeTo(const SystemTime& time, std::string& output) const;
+
   /**
    * @param time_source time keeping source.
    * @return std::string representing the GMT/UTC time of a TimeSource based on the format string.
@@ -91,6 +99,7 @@ private:
 class AccessLogDateTimeFormatter {
 public:
   static std::string fromTime(const SystemTime& time);
+  static void fromTimeTo(const SystemTime& time, std::string& output);
 };
 
 /**
@@ -1,5 +1,6 @@
 #include "common/config/grpc_mux_impl.h"
 
+#include <algorithm>
 #include <unordered_set>
 
 #include "envoy/service/discovery/v3/discovery.pb.h"
@@ -9,6 +10,8 @@
 #include "common/memory/utils.h"
 #include "common/protobuf/protobuf.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Config {
 
@@ -153,20 +156,29 @@ void GrpcMuxImpl::onDiscoveryResponse(
     return;
   }
   try {
-    // To avoid O(n^2) explosion (e.g. when we have 1000s of EDS watches), we
-    // build a map here from resource name to resource and then walk watches_.
-    // We have to walk all watches (and need an efficient map as a result) to
-    // ensure we deliver empty config updates when a resource is dropped.
-    std::unordered_map<std::string, ProtobufWkt::Any> resources;
-    SubscriptionCallbacks& callbacks = api_state_[type_url].watches_.front()->callbacks_;
     for (const auto& resource : message->resources()) {
       if (type_url != resource.type_url()) {
         throw EnvoyException(
             fmt::format("{} does not match the message-wide type URL {} in DiscoveryResponse {}",
                         resource.type_url(), type_url, message->DebugString()));
       }
-      const std::string resource_name = callbacks.resourceName(resource);
-      resources.emplace(resource_name, resource);
+    }
+    // To avoid O(n^2) explosion (e.g. when we have 1000s of EDS watches), we
+    // build a map here from resource name to resource and then walk watches_.
+    // We have to walk all watches (and need an efficient map as a result) to
+    // ensure we deliver empty config updates when a resource is dropped. The map
+    // is only needed by watches of named resources: resources are decoded to find
+    // their name, which is wasted on watches of all the resources (i.e. Cluster
+    // and Listener), and they are indexed in place rather than copied.
+    absl::flat_hash_map<std::string, const ProtobufWkt::Any*> resources;
+    const bool any_named_watch =
+        std::any_of(api_state_[type_url].watches_.begin(), api_state_[type_url].watches_.end(),
+                    [](const GrpcMuxWatchImpl* watch) { return !watch->resources_.empty(); });
+    if (any_named_watch) {
+      SubscriptionCallbacks& callbacks = api_state_[type_url].watches_.front()->callbacks_;
+      for (const auto& resource : message->resources()) {
+        resources.emplace(callbacks.resourceName(resource), &resource);
+      }
     }
     for (auto watch : api_state_[type_url].watches_) {
       // onConfigUpdate should be called in all cases for single watch xDS (Cluster and
@@ -180,7 +192,7 @@ void GrpcMuxImpl::onDiscoveryResponse(
       for (const auto& watched_resource_name : watch->resources_) {
         auto it = resources.find(watched_resource_name);
         if (it != resources.end()) {
-          found_resources.Add()->MergeFrom(it->second);
+          found_resources.Add()->MergeFrom(*it->second);
         }
       }
       // onConfigUpdate should be called only on watches(clusters/routes) that have
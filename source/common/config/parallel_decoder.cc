@@ -0,0 +1,89 @@
+#include "common/config/parallel_decoder.h"
+
+#include "common/common/assert.h"
+#include "common/common/lock_guard.h"
+
+namespace Envoy {
+namespace Config {
+
+DecodeThreadPool::DecodeThreadPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count) {
+  for (uint32_t i = 0; i < thread_count; i++) {
+    threads_.emplace_back(thread_factory.createThread([this]() -> void { threadRoutine(); }));
+  }
+}
+
+DecodeThreadPool::~DecodeThreadPool() {
+  {
+    Thread::LockGuard lock(lock_);
+    shutdown_ = true;
+  }
+  work_event_.notifyAll();
+  for (auto& thread : threads_) {
+    thread->join();
+  }
+}
+
+void DecodeThreadPool::parallelFor(size_t count, const Work& work) {
+  if (threads_.empty() || count <= 1) {
+    for (size_t index = 0; index < count; index++) {
+      work(index);
+    }
+    return;
+  }
+
+  {
+    Thread::LockGuard lock(lock_);
+    ASSERT(work_ == nullptr);
+    work_ = &work;
+    count_ = count;
+    next_ = 0;
+    generation_++;
+  }
+  work_event_.notifyAll();
+  runWork(work, count);
+
+  // Pool threads still running an iteration reference the work of the caller.
+  Thread::LockGuard lock(lock_);
+  while (active_threads_ > 0) {
+    done_event_.wait(lock_);
+  }
+  // Pool threads waking up from now on have nothing left to join.
+  work_ = nullptr;
+}
+
+void DecodeThreadPool::runWork(const Work& work, size_t count) {
+  for (size_t index = next_++; index < count; index = next_++) {
+    work(index);
+  }
+}
+
+void DecodeThreadPool::threadRoutine() {
+  uint64_t generation = 0;
+  while (true) {
+    const Work* work;
+    size_t count;
+    {
+      Thread::LockGuard lock(lock_);
+      while (!shutdown_ && (work_ == nullptr || generation_ == generation)) {
+        // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
+        work_event_.wait(lock_);
+      }
+      if (shutdown_) {
+        return;
+      }
+      generation = generation_;
+      work = work_;
+      count = count_;
+      active_threads_++;
+    }
+    runWork(*work, count);
+    {
+      Thread::LockGuard lock(lock_);
+      active_threads_--;
+    }
+    done_event_.notifyAll();
+  }
+}
+
+} // namespace Config
+} // namespace Envoy
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/exception.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+#include "envoy/thread/thread.h"
+
+#include "common/common/thread.h"
+#include "common/protobuf/protobuf.h"
+#include "common/protobuf/utility.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Config {
+
+/**
+ * A fixed size pool of threads sharing loops of independent iterations with the thread running
+ * them. Unlike other pools, the caller blocks until the whole loop completed, so that config
+ * updates are still accepted or rejected synchronously. It must only be used from a single
+ * thread at a time, usually the main thread.
+ */
+class DecodeThreadPool {
+public:
+  using Work = std::function<void(size_t index)>;
+
+  DecodeThreadPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count);
+  ~DecodeThreadPool();
+
+  /**
+   * Run work for all indexes in [0, count), on the pool threads and the calling thread, and wait
+   * for all of them to complete.
+   * @param count supplies the number of iterations.
+   * @param work supplies the iteration, which must not throw.
+   */
+  void parallelFor(size_t count, const Work& work);
+
+  uint32_t threadCount() const { return threads_.size(); }
+
+private:
+  void threadRoutine();
+  void runWork(const Work& work, size_t count);
+
+  Thread::MutexBasicLockable lock_;
+  Thread::CondVar work_event_;
+  Thread::CondVar done_event_;
+  // The loop in progress, or nullptr once the caller collected it.
+  const Work* work_ ABSL_GUARDED_BY(lock_){};
+  size_t count_ ABSL_GUARDED_BY(lock_){};
+  // Incremented for every loop, so that pool threads join each loop at most once.
+  uint64_t generation_ ABSL_GUARDED_BY(lock_){};
+  uint32_t active_threads_ ABSL_GUARDED_BY(lock_){};
+  bool shutdown_ ABSL_GUARDED_BY(lock_){};
+  // The next iteration to run.
+  std::atomic<size_t> next_{};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+using DecodeThreadPoolPtr = std::unique_ptr<DecodeThreadPool>;
+
+/**
+ * A resource of a config update, unpacked and checked against its protoc-gen-validate
+ * constraints.
+ */
+template <class MessageType> struct DecodedResource {
+  MessageType message_;
+  // Set if the resource could not be unpacked.
+  absl::optional<std::string> unpack_error_;
+  // Set if the resource does not satisfy its constraints.
+  absl::optional<std::string> validation_error_;
+};
+
+/**
+ * Decoding of the resources of config updates, split between a pool and the main thread.
+ */
+class ParallelDecoder {
+public:
+  /**
+   * Unpack and validate the resources of a config update, in parallel on the pool if any. Only
+   * the checks independent of any shared state run here, the rest is left to checkResource().
+   * @param pool supplies the pool, or nullptr to decode on the calling thread.
+   * @param resources supplies the resources to decode.
+   * @return the decoded resources, in the order of resources.
+   */
+  template <class MessageType>
+  static std::vector<DecodedResource<MessageType>>
+  decodeResources(DecodeThreadPool* pool,
+                  const Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource>&
+                      resources) {
+    return decode<MessageType>(pool, resources.size(),
+                               [&resources](size_t index) -> const ProtobufWkt::Any& {
+                                 return resources[index].resource();
+                               });
+  }
+
+  /**
+   * Same as above, for the resources of state of the world updates.
+   */
+  template <class MessageType>
+  static std::vector<DecodedResource<MessageType>>
+  decodeResources(DecodeThreadPool* pool,
+                  const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources) {
+    return decode<MessageType>(
+        pool, resources.size(),
+        [&resources](size_t index) -> const ProtobufWkt::Any& { return resources[index]; });
+  }
+
+  /**
+   * Complete the validation of a decoded resource, checking for unknown and deprecated fields,
+   * which depends on the runtime and the validation visitor of the calling thread. The checks and
+   * the exceptions are the same as those of MessageUtil::anyConvertAndValidate().
+   * @param resource supplies the decoded resource.
+   * @param validation_visitor supplies the visitor of unknown and deprecated fields.
+   * @throw EnvoyException if the resource is invalid.
+   */
+  template <class MessageType>
+  static void checkResource(const DecodedResource<MessageType>& resource,
+                            ProtobufMessage::ValidationVisitor& validation_visitor) {
+    if (resource.unpack_error_.has_value()) {
+      throw EnvoyException(resource.unpack_error_.value());
+    }
+    if (!validation_visitor.skipValidation()) {
+      MessageUtil::checkForUnexpectedFields(resource.message_, validation_visitor);
+    }
+    if (resource.validation_error_.has_value()) {
+      throw ProtoValidationException(resource.validation_error_.value(),
+                                     API_RECOVER_ORIGINAL(resource.message_));
+    }
+  }
+
+private:
+  template <class MessageType, class ResourceGetter>
+  static std::vector<DecodedResource<MessageType>> decode(DecodeThreadPool* pool, size_t count,
+                                                          const ResourceGetter& resource_getter) {
+    std::vector<DecodedResource<MessageType>> decoded(count);
+    const DecodeThreadPool::Work work = [&resource_getter, &decoded](size_t index) {
+      DecodedResource<MessageType>& resource = decoded[index];
+      try {
+        MessageUtil::unpackTo(resource_getter(index), resource.message_);
+      } catch (const EnvoyException& e) {
+        resource.unpack_error_ = e.what();
+        return;
+      }
+      std::string err;
+      if (!Validate(resource.message_, &err)) {
+        resource.validation_error_ = std::move(err);
+      }
+    };
+    if (pool == nullptr) {
+      for (size_t index = 0; index < count; index++) {
+        work(index);
+      }
+    } else {
+      pool->parallelFor(count, work);
+    }
+    return decoded;
+  }
+};
+
+} // namespace Config
+} // namespace Envoy
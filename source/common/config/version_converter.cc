@@ -116,6 +116,16 @@ void VersionConverter::upgrade(const Protobuf::Message& prev_message,
   annotateWithOriginalType(*prev_message.GetDescriptor(), next_message);
 }
 
+void VersionConverter::upgrade(const Protobuf::Descriptor& prev_descriptor,
+                               absl::string_view prev_serialized,
+                               Protobuf::Message& next_message) {
+  if (!next_message.ParseFromArray(prev_serialized.data(), prev_serialized.size())) {
+    throw EnvoyException("Unable to deserialize during upgrade()");
+  }
+  // Track original type to support recoverOriginal().
+  annotateWithOriginalType(prev_descriptor, next_message);
+}
+
 void VersionConverter::eraseOriginalTypeInformation(Protobuf::Message& message) {
   class TypeErasingProtoVisitor : public ProtobufMessage::ProtoVisitor {
   public:
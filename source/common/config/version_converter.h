@@ -4,6 +4,8 @@
 
 #include "common/protobuf/protobuf.h"
 
+#include "absl/strings/string_view.h"
+
 // Convenience macro for downgrading a message and obtaining a reference.
 #define API_DOWNGRADE(msg) (*Envoy::Config::VersionConverter::downgrade(msg)->msg_)
 
@@ -43,6 +45,20 @@ public:
    */
   static void upgrade(const Protobuf::Message& prev_message, Protobuf::Message& next_message);
 
+  /**
+   * Same as above, for a previous version message still in its wire form, e.g. the value of an
+   * Any. The bytes are parsed directly as the next version, which saves materializing the
+   * previous version message and serializing it again.
+   *
+   * @param prev_descriptor descriptor of the previous version message.
+   * @param prev_serialized previous version message input, in wire format.
+   * @param next_message next version message to generate.
+   *
+   * @throw EnvoyException if a Protobuf deserialization error occurs.
+   */
+  static void upgrade(const Protobuf::Descriptor& prev_descriptor,
+                      absl::string_view prev_serialized, Protobuf::Message& next_message);
+
   /**
    * Downgrade a message to the previous version. If no previous version exists,
    * the given message is copied in the return value. This is not super
@@ -58,6 +58,14 @@ void WatchMap::onConfigUpdate(const Protobuf::RepeatedPtrField<ProtobufWkt::Any>
   if (watches_.empty()) {
     return;
   }
+  if (isSingleWildcard()) {
+    // The only watch is interested in all the resources (i.e. Cluster or Listener), which are
+    // delivered as is rather than copied, after decoding them to find their name.
+    Watch& watch = **watches_.begin();
+    watch.callbacks_.onConfigUpdate(resources, version_info);
+    watch.state_of_the_world_empty_ = resources.empty();
+    return;
+  }
   SubscriptionCallbacks& name_getter = (*watches_.begin())->callbacks_;
 
   // Build a map from watches, to the set of updated resources that each watch cares about. Each
@@ -72,19 +80,17 @@ void WatchMap::onConfigUpdate(const Protobuf::RepeatedPtrField<ProtobufWkt::Any>
     }
   }
 
-  const bool map_is_single_wildcard = (watches_.size() == 1 && wildcard_watches_.size() == 1);
   // We just bundled up the updates into nice per-watch packages. Now, deliver them.
   for (auto& watch : watches_) {
     const auto this_watch_updates = per_watch_updates.find(watch);
     if (this_watch_updates == per_watch_updates.end()) {
       // This update included no resources this watch cares about.
-      // 1) If there is only a single, wildcard watch (i.e. Cluster or Listener), always call
-      //    its onConfigUpdate even if just a no-op, to properly maintain state-of-the-world
-      //    semantics and the update_empty stat.
-      // 2) If this watch previously had some resources, it means this update is removing all
+      // 1) If this watch previously had some resources, it means this update is removing all
       //    of this watch's resources, so the watch must be informed with an onConfigUpdate.
-      // 3) Otherwise, we can skip onConfigUpdate for this watch.
-      if (map_is_single_wildcard || !watch->state_of_the_world_empty_) {
+      // 2) Otherwise, we can skip onConfigUpdate for this watch. A single, wildcard watch (i.e.
+      //    Cluster or Listener) is always called, even if just a no-op, to properly maintain
+      //    state-of-the-world semantics and the update_empty stat, but it is handled above.
+      if (!watch->state_of_the_world_empty_) {
         watch->callbacks_.onConfigUpdate({}, version_info);
         watch->state_of_the_world_empty_ = true;
       }
@@ -125,6 +131,14 @@ void WatchMap::onConfigUpdate(
     const Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource>& added_resources,
     const Protobuf::RepeatedPtrField<std::string>& removed_resources,
     const std::string& system_version_info) {
+  if (isSingleWildcard()) {
+    // As for state-of-the-world updates, the resources are delivered as is to the only watch.
+    if (!added_resources.empty() || !removed_resources.empty()) {
+      (*watches_.begin())
+          ->callbacks_.onConfigUpdate(added_resources, removed_resources, system_version_info);
+    }
+    return;
+  }
   // Build a pair of maps: from watches, to the set of resources {added,removed} that each watch
   // cares about. Each entry in the map-pair is then a nice little bundle that can be fed directly
   // into the individual onConfigUpdate()s.
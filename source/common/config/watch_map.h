@@ -110,6 +110,9 @@ private:
   // Returns the union of watch_interest_[resource_name] and wildcard_watches_.
   absl::flat_hash_set<Watch*> watchesInterestedIn(const std::string& resource_name);
 
+  // Whether the only watch is interested in all the resources.
+  bool isSingleWildcard() const { return watches_.size() == 1 && wildcard_watches_.size() == 1; }
+
   absl::flat_hash_set<std::unique_ptr<Watch>> watches_;
 
   // Watches whose interest set is currently empty, which is interpreted as "everything".
@@ -1,5 +1,6 @@
 #include "common/event/dispatcher_impl.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <functional>
@@ -48,8 +49,9 @@ DispatcherImpl::DispatcherImpl(const std::string& name, Buffer::WatermarkFactory
   SignalAction::registerFatalErrorHandler(*this);
 #endif
   updateApproximateMonotonicTimeInternal();
-  base_scheduler_.registerOnPrepareCallback(
-      std::bind(&DispatcherImpl::updateApproximateMonotonicTime, this));
+  base_scheduler_.registerOnPrepareCallback(std::bind(&DispatcherImpl::onPrepare, this));
+  base_scheduler_.registerOnCheckCallback(
+      [this]() { poll_complete_time_ = api_.timeSource().monotonicTime(); });
 }
 
 DispatcherImpl::~DispatcherImpl() {
@@ -213,6 +215,21 @@ void DispatcherImpl::updateApproximateMonotonicTimeInternal() {
   approximate_monotonic_time_ = api_.timeSource().monotonicTime();
 }
 
+void DispatcherImpl::onPrepare() {
+  updateApproximateMonotonicTimeInternal();
+  if (poll_complete_time_.has_value()) {
+    max_loop_duration_ =
+        std::max(max_loop_duration_, approximate_monotonic_time_ - poll_complete_time_.value());
+  }
+}
+
+std::chrono::microseconds DispatcherImpl::takeMaxLoopDuration() {
+  ASSERT(isThreadSafe());
+  const auto max_loop_duration = max_loop_duration_;
+  max_loop_duration_ = MonotonicTime::duration::zero();
+  return std::chrono::duration_cast<std::chrono::microseconds>(max_loop_duration);
+}
+
 void DispatcherImpl::runPostCallbacks() {
   while (true) {
     // It is important that this declaration is inside the body of the loop so that the callback is
@@ -20,6 +20,8 @@
 #include "common/event/libevent_scheduler.h"
 #include "common/signal/fatal_error_handler.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Event {
 
@@ -77,6 +79,7 @@ public:
   }
   MonotonicTime approximateMonotonicTime() const override;
   void updateApproximateMonotonicTime() override;
+  std::chrono::microseconds takeMaxLoopDuration() override;
 
   // FatalErrorInterface
   void onFatalError() const override {
@@ -92,6 +95,7 @@ public:
 private:
   TimerPtr createTimerInternal(TimerCb cb);
   void updateApproximateMonotonicTimeInternal();
+  void onPrepare();
   void runPostCallbacks();
 
   // Validate that an operation is thread safe, i.e. it's invoked on the same thread that the
@@ -119,6 +123,9 @@ private:
   const ScopeTrackedObject* current_object_{};
   bool deferred_deleting_{};
   MonotonicTime approximate_monotonic_time_;
+  // Time at which the last poll returned, unset before the first poll.
+  absl::optional<MonotonicTime> poll_complete_time_;
+  MonotonicTime::duration max_loop_duration_{};
 };
 
 } // namespace Event
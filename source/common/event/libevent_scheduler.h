@@ -17,6 +17,7 @@ namespace Event {
 class LibeventScheduler : public Scheduler {
 public:
   using OnPrepareCallback = std::function<void()>;
+  using OnCheckCallback = std::function<void()>;
   LibeventScheduler();
 
   // Scheduler
@@ -52,6 +53,12 @@ public:
    */
   void registerOnPrepareCallback(OnPrepareCallback&& callback);
 
+  /**
+   * Register callback to be called in the event loop right after polling for
+   * events. The same restrictions as for registerOnPrepareCallback() apply.
+   */
+  void registerOnCheckCallback(OnCheckCallback&& callback);
+
   /**
    * Start writing stats once thread-local storage is ready to receive them (see
    * ThreadLocalStoreImpl::initializeThreading).
@@ -60,6 +67,7 @@ public:
 
 private:
   static void onPrepareForCallback(evwatch*, const evwatch_prepare_cb_info* info, void* arg);
+  static void onCheckForCallback(evwatch*, const evwatch_check_cb_info* info, void* arg);
   static void onPrepareForStats(evwatch*, const evwatch_prepare_cb_info* info, void* arg);
   static void onCheckForStats(evwatch*, const evwatch_check_cb_info*, void* arg);
 
@@ -69,7 +77,8 @@ private:
   timeval timeout_{};        // the poll timeout for the current event loop iteration, if available
   timeval prepare_time_{};   // timestamp immediately before polling
   timeval check_time_{};     // timestamp immediately after polling
-  OnPrepareCallback callback_; // callback to be called from onPrepareForCallback()
+  OnPrepareCallback callback_;     // callback to be called from onPrepareForCallback()
+  OnCheckCallback check_callback_; // callback to be called from onCheckForCallback()
 };
 
 } // namespace Event
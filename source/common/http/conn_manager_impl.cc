@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <list>
 #include <memory>
 #include <string>
@@ -121,6 +122,14 @@ ConnectionManagerImpl::ConnectionManagerImpl(ConnectionManagerConfig& config,
           overload_manager ? overload_manager->getThreadLocalOverloadState().getState(
                                  Server::OverloadActionNames::get().DisableHttpKeepAlive)
                            : Server::OverloadManager::getInactiveState()),
+      overload_shed_requests_ref_(
+          overload_manager ? overload_manager->getThreadLocalOverloadState().getScale(
+                                 Server::OverloadActionNames::get().ShedRequests)
+                           : Server::OverloadManager::getInactiveScale()),
+      overload_reduce_timeouts_ref_(
+          overload_manager ? overload_manager->getThreadLocalOverloadState().getScale(
+                                 Server::OverloadActionNames::get().ReduceTimeouts)
+                           : Server::OverloadManager::getInactiveScale()),
       time_source_(time_source) {}
 
 const ResponseHeaderMap& ConnectionManagerImpl::continueHeader() {
@@ -143,7 +152,7 @@ void ConnectionManagerImpl::initializeReadFilterCallbacks(Network::ReadFilterCal
   if (config_.idleTimeout()) {
     connection_idle_timer_ = read_callbacks_->connection().dispatcher().createTimer(
         [this]() -> void { onIdleTimeout(); });
-    connection_idle_timer_->enableTimer(config_.idleTimeout().value());
+    connection_idle_timer_->enableTimer(connectionIdleTimeout());
   }
 
   if (config_.maxConnectionDuration()) {
@@ -248,7 +257,7 @@ void ConnectionManagerImpl::doDeferredStreamDestroy(ActiveStream& stream) {
   read_callbacks_->connection().dispatcher().deferredDelete(stream.removeFromList(streams_));
 
   if (connection_idle_timer_ && streams_.empty()) {
-    connection_idle_timer_->enableTimer(config_.idleTimeout().value());
+    connection_idle_timer_->enableTimer(connectionIdleTimeout());
   }
 }
 
@@ -481,6 +490,22 @@ void ConnectionManagerImpl::onIdleTimeout() {
   }
 }
 
+std::chrono::milliseconds ConnectionManagerImpl::connectionIdleTimeout() const {
+  const double reduction = overload_reduce_timeouts_ref_;
+  if (reduction == 0) {
+    return config_.idleTimeout().value();
+  }
+  return std::chrono::milliseconds(
+      static_cast<int64_t>(config_.idleTimeout().value().count() * (1 - reduction)));
+}
+
+bool ConnectionManagerImpl::shedRequest() {
+  // The action is inactive most of the time, and no random number is drawn then.
+  const double fraction = overload_shed_requests_ref_;
+  return fraction > 0 &&
+         random_generator_.random() < fraction * std::numeric_limits<uint64_t>::max();
+}
+
 void ConnectionManagerImpl::onConnectionDurationTimeout() {
   ENVOY_CONN_LOG(debug, "max connection duration reached", read_callbacks_->connection());
   stats_.named_.downstream_cx_max_duration_reached_.inc();
@@ -813,7 +838,8 @@ void ConnectionManagerImpl::ActiveStream::decodeHeaders(RequestHeaderMapPtr&& he
 
   // Drop new requests when overloaded as soon as we have decoded the headers.
   if (connection_manager_.overload_stop_accepting_requests_ref_ ==
-      Server::OverloadActionState::Active) {
+          Server::OverloadActionState::Active ||
+      connection_manager_.shedRequest()) {
     // In this one special case, do not create the filter chain. If there is a risk of memory
     // overload it is more important to avoid unnecessary allocation than to create the filters.
     state_.created_filter_chain_ = true;
@@ -765,6 +765,11 @@ private:
 
   void resetAllStreams(absl::optional<StreamInfo::ResponseFlag> response_flag);
   void onIdleTimeout();
+  // The connection idle timeout, shortened by the reduce timeouts overload action.
+  std::chrono::milliseconds connectionIdleTimeout() const;
+  // Whether to reject a new request as part of the fraction shed by the shed requests overload
+  // action.
+  bool shedRequest();
   void onConnectionDurationTimeout();
   void onDrainTimeout();
   void startDrainSequence();
@@ -802,6 +807,8 @@ private:
   // lookup in the hot path of processing each request.
   const Server::OverloadActionState& overload_stop_accepting_requests_ref_;
   const Server::OverloadActionState& overload_disable_keepalive_ref_;
+  const double& overload_shed_requests_ref_;
+  const double& overload_reduce_timeouts_ref_;
   TimeSource& time_source_;
   std::shared_ptr<StreamInfo::FilterState> filter_state_;
 };
@@ -17,6 +17,8 @@
 #include "common/http/utility.h"
 #include "common/network/utility.h"
 #include "common/runtime/runtime_features.h"
+#include "common/runtime/runtime_keys.h"
+#include "common/singleton/const_singleton.h"
 #include "common/tracing/http_tracer_impl.h"
 
 #include "absl/strings/str_cat.h"
@@ -25,6 +27,21 @@
 namespace Envoy {
 namespace Http {
 
+namespace {
+
+struct TracingRuntimeKeyValues {
+  const Runtime::KeyHandle ClientEnabled{
+      Runtime::KeyRegistry::registerKey("tracing.client_enabled")};
+  const Runtime::KeyHandle RandomSampling{
+      Runtime::KeyRegistry::registerKey("tracing.random_sampling")};
+  const Runtime::KeyHandle GlobalEnabled{
+      Runtime::KeyRegistry::registerKey("tracing.global_enabled")};
+};
+
+using TracingRuntimeKeys = ConstSingleton<TracingRuntimeKeyValues>;
+
+} // namespace
+
 std::string ConnectionManagerUtility::determineNextProtocol(Network::Connection& connection,
                                                             const Buffer::Instance& data) {
   if (!connection.nextProtocol().empty()) {
@@ -267,17 +284,19 @@ void ConnectionManagerUtility::mutateTracingRequestHeader(RequestHeaderMap& requ
   // Do not apply tracing transformations if we are currently tracing.
   if (TraceStatus::NoTrace == rid_extension->getTraceStatus(request_headers)) {
     if (request_headers.ClientTraceId() &&
-        runtime.snapshot().featureEnabled("tracing.client_enabled", *client_sampling)) {
+        runtime.snapshot().featureEnabled(TracingRuntimeKeys::get().ClientEnabled,
+                                          *client_sampling)) {
       rid_extension->setTraceStatus(request_headers, TraceStatus::Client);
     } else if (request_headers.EnvoyForceTrace()) {
       rid_extension->setTraceStatus(request_headers, TraceStatus::Forced);
-    } else if (runtime.snapshot().featureEnabled("tracing.random_sampling", *random_sampling,
-                                                 result)) {
+    } else if (runtime.snapshot().featureEnabled(TracingRuntimeKeys::get().RandomSampling,
+                                                 *random_sampling, result)) {
       rid_extension->setTraceStatus(request_headers, TraceStatus::Sampled);
     }
   }
 
-  if (!runtime.snapshot().featureEnabled("tracing.global_enabled", *overall_sampling, result)) {
+  if (!runtime.snapshot().featureEnabled(TracingRuntimeKeys::get().GlobalEnabled,
+                                         *overall_sampling, result)) {
     rid_extension->setTraceStatus(request_headers, TraceStatus::NoTrace);
   }
 }
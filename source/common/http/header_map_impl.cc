@@ -1,7 +1,6 @@
 #include "common/http/header_map_impl.h"
 
 #include <cstdint>
-#include <list>
 #include <memory>
 #include <string>
 
@@ -296,7 +295,7 @@ bool HeaderMapImpl::operator==(const HeaderMap& rhs) const {
   auto i = headers_.begin();
   auto j = rhs_headers.begin();
   for (; i != headers_.end(); ++i, ++j) {
-    if (i->key() != j->first || i->value() != j->second) {
+    if ((*i)->key() != j->first || (*i)->value() != j->second) {
       return false;
     }
   }
@@ -320,8 +319,7 @@ void HeaderMapImpl::insertByKey(HeaderString&& key, HeaderString&& value) {
     }
   } else {
     addSize(key.size() + value.size());
-    std::list<HeaderEntryImpl>::iterator i = headers_.insert(std::move(key), std::move(value));
-    i->entry_ = i;
+    headers_.insert(std::move(key), std::move(value));
   }
 }
 
@@ -439,17 +437,17 @@ uint64_t HeaderMapImpl::byteSize() const { return cached_byte_size_; }
 void HeaderMapImpl::verifyByteSizeInternalForTest() const {
   // Computes the total byte size by summing the byte size of the keys and values.
   uint64_t byte_size = 0;
-  for (const HeaderEntryImpl& header : headers_) {
-    byte_size += header.key().size();
-    byte_size += header.value().size();
+  for (const HeaderEntryImpl* header : headers_) {
+    byte_size += header->key().size();
+    byte_size += header->value().size();
   }
   ASSERT(cached_byte_size_ == byte_size);
 }
 
 const HeaderEntry* HeaderMapImpl::get(const LowerCaseString& key) const {
-  for (const HeaderEntryImpl& header : headers_) {
-    if (header.key() == key.get().c_str()) {
-      return &header;
+  for (const HeaderEntryImpl* header : headers_) {
+    if (header->key() == key.get().c_str()) {
+      return header;
     }
   }
 
@@ -457,9 +455,9 @@ const HeaderEntry* HeaderMapImpl::get(const LowerCaseString& key) const {
 }
 
 HeaderEntry* HeaderMapImpl::getExisting(const LowerCaseString& key) {
-  for (HeaderEntryImpl& header : headers_) {
-    if (header.key() == key.get().c_str()) {
-      return &header;
+  for (HeaderEntryImpl* header : headers_) {
+    if (header->key() == key.get().c_str()) {
+      return header;
     }
   }
 
@@ -467,8 +465,8 @@ HeaderEntry* HeaderMapImpl::getExisting(const LowerCaseString& key) {
 }
 
 void HeaderMapImpl::iterate(ConstIterateCb cb, void* context) const {
-  for (const HeaderEntryImpl& header : headers_) {
-    if (cb(header, context) == HeaderMap::Iterate::Break) {
+  for (const HeaderEntryImpl* header : headers_) {
+    if (cb(*header, context) == HeaderMap::Iterate::Break) {
       break;
     }
   }
@@ -476,7 +474,7 @@ void HeaderMapImpl::iterate(ConstIterateCb cb, void* context) const {
 
 void HeaderMapImpl::iterateReverse(ConstIterateCb cb, void* context) const {
   for (auto it = headers_.rbegin(); it != headers_.rend(); it++) {
-    if (cb(*it, context) == HeaderMap::Iterate::Break) {
+    if (cb(**it, context) == HeaderMap::Iterate::Break) {
       break;
     }
   }
@@ -516,14 +514,13 @@ size_t HeaderMapImpl::remove(const LowerCaseString& key) {
   if (lookup.has_value()) {
     removeInline(lookup.value().entry_);
   } else {
-    for (auto i = headers_.begin(); i != headers_.end();) {
-      if (i->key() == key.get().c_str()) {
-        subtractSize(i->key().size() + i->value().size());
-        i = headers_.erase(i);
-      } else {
-        ++i;
+    headers_.remove_if([&key, this](const HeaderEntryImpl& entry) {
+      if (entry.key() == key.get().c_str()) {
+        subtractSize(entry.key().size() + entry.value().size());
+        return true;
       }
-    }
+      return false;
+    });
   }
   return old_size - headers_.size();
 }
@@ -573,9 +570,7 @@ HeaderMapImpl::HeaderEntryImpl& HeaderMapImpl::maybeCreateInline(HeaderEntryImpl
   }
 
   addSize(key.get().size());
-  std::list<HeaderEntryImpl>::iterator i = headers_.insert(key);
-  i->entry_ = i;
-  *entry = &(*i);
+  *entry = &headers_.insert(key);
   return **entry;
 }
 
@@ -588,9 +583,7 @@ HeaderMapImpl::HeaderEntryImpl& HeaderMapImpl::maybeCreateInline(HeaderEntryImpl
   }
 
   addSize(key.get().size() + value.size());
-  std::list<HeaderEntryImpl>::iterator i = headers_.insert(key, std::move(value));
-  i->entry_ = i;
-  *entry = &(*i);
+  *entry = &headers_.insert(key, std::move(value));
   return **entry;
 }
 
@@ -608,10 +601,10 @@ size_t HeaderMapImpl::removeInline(HeaderEntryImpl** ptr_to_entry) {
   }
 
   HeaderEntryImpl* entry = *ptr_to_entry;
-  const uint64_t size_to_subtract = entry->entry_->key().size() + entry->entry_->value().size();
+  const uint64_t size_to_subtract = entry->key().size() + entry->value().size();
   subtractSize(size_to_subtract);
   *ptr_to_entry = nullptr;
-  headers_.erase(entry->entry_);
+  headers_.erase(*entry);
   return 1;
 }
 
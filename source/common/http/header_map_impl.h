@@ -1,17 +1,24 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
-#include <list>
+#include <iterator>
 #include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
 
 #include "envoy/http/header_map.h"
 
+#include "common/common/assert.h"
 #include "common/common/non_copyable.h"
 #include "common/common/utility.h"
 #include "common/http/headers.h"
 
+#include "absl/container/inlined_vector.h"
+
 namespace Envoy {
 namespace Http {
 
@@ -108,7 +115,9 @@ protected:
 
     HeaderString key_;
     HeaderString value_;
-    std::list<HeaderEntryImpl>::iterator entry_;
+    // The neighbours of the entry in its HeaderList.
+    HeaderEntryImpl* prev_{};
+    HeaderEntryImpl* next_{};
   };
 
   /**
@@ -143,68 +152,162 @@ protected:
    * List of HeaderEntryImpl that keeps the pseudo headers (key starting with ':') in the front
    * of the list (as required by nghttp2) and otherwise maintains insertion order.
    *
-   * Note: the internal iterators held in fields make this unsafe to copy and move, since the
-   * reference to end() is not preserved across a move (see Notes in
-   * https://en.cppreference.com/w/cpp/container/list/list). The NonCopyable will suppress both copy
-   * and move constructors/assignment.
-   * TODO(htuch): Maybe we want this to movable one day; for now, our header map moves happen on
-   * HeaderMapPtr, so the performance impact should not be evident.
+   * The entries are allocated in blocks, which double in size from MinEntriesPerBlock up to
+   * MaxEntriesPerBlock, so that a typical request or response takes a few allocations for all of
+   * its headers instead of one per header, without inflating small maps such as trailers. Entries
+   * are never moved, so that the pointers held to them (e.g., by the O(1) headers) remain valid
+   * until they are removed, and the slots of removed entries are reused by later insertions. The
+   * order of the entries is kept in a separate vector of pointers, which iteration walks
+   * contiguously.
+   *
+   * Note: this is not copyable or movable, as the O(1) headers point into the blocks.
    */
   class HeaderList : NonCopyable {
   public:
-    HeaderList() : pseudo_headers_end_(headers_.end()) {}
+    static constexpr size_t MinEntriesPerBlock = 4;
+    static constexpr size_t MaxEntriesPerBlock = 16;
+
+    // Iterates over the entries, in order or in reverse order, yielding pointers to them.
+    template <bool Reverse> class Iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = HeaderEntryImpl*;
+      using difference_type = std::ptrdiff_t;
+      using pointer = HeaderEntryImpl* const*;
+      using reference = HeaderEntryImpl* const&;
+
+      explicit Iterator(HeaderEntryImpl* entry) : entry_(entry) {}
+
+      reference operator*() const { return entry_; }
+      Iterator& operator++() {
+        entry_ = Reverse ? entry_->prev_ : entry_->next_;
+        return *this;
+      }
+      Iterator operator++(int) {
+        Iterator it = *this;
+        ++*this;
+        return it;
+      }
+      bool operator==(const Iterator& rhs) const { return entry_ == rhs.entry_; }
+      bool operator!=(const Iterator& rhs) const { return entry_ != rhs.entry_; }
+
+    private:
+      HeaderEntryImpl* entry_;
+    };
+
+    ~HeaderList() { clear(); }
 
     template <class Key> bool isPseudoHeader(const Key& key) {
       return !key.getStringView().empty() && key.getStringView()[0] == ':';
     }
 
-    template <class Key, class... Value>
-    std::list<HeaderEntryImpl>::iterator insert(Key&& key, Value&&... value) {
+    template <class Key, class... Value> HeaderEntryImpl& insert(Key&& key, Value&&... value) {
       const bool is_pseudo_header = isPseudoHeader(key);
-      std::list<HeaderEntryImpl>::iterator i =
-          headers_.emplace(is_pseudo_header ? pseudo_headers_end_ : headers_.end(),
-                           std::forward<Key>(key), std::forward<Value>(value)...);
-      if (!is_pseudo_header && pseudo_headers_end_ == headers_.end()) {
-        pseudo_headers_end_ = i;
+      HeaderEntryImpl* entry = new (allocateSlot())
+          HeaderEntryImpl(std::forward<Key>(key), std::forward<Value>(value)...);
+      if (is_pseudo_header) {
+        // Pseudo headers go after the other pseudo headers, before the regular headers.
+        link(entry, last_pseudo_header_);
+        last_pseudo_header_ = entry;
+      } else {
+        link(entry, tail_);
       }
-      return i;
+      return *entry;
     }
 
-    std::list<HeaderEntryImpl>::iterator erase(std::list<HeaderEntryImpl>::iterator i) {
-      if (pseudo_headers_end_ == i) {
-        pseudo_headers_end_++;
-      }
-      return headers_.erase(i);
+    void erase(HeaderEntryImpl& entry) {
+      unlink(&entry);
+      releaseSlot(&entry);
     }
 
     template <class UnaryPredicate> void remove_if(UnaryPredicate p) {
-      headers_.remove_if([&](const HeaderEntryImpl& entry) {
-        const bool to_remove = p(entry);
-        if (to_remove) {
-          if (pseudo_headers_end_ == entry.entry_) {
-            pseudo_headers_end_++;
-          }
+      HeaderEntryImpl* entry = head_;
+      while (entry != nullptr) {
+        HeaderEntryImpl* next = entry->next_;
+        if (p(*entry)) {
+          erase(*entry);
         }
-        return to_remove;
-      });
+        entry = next;
+      }
     }
 
-    std::list<HeaderEntryImpl>::iterator begin() { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::iterator end() { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_iterator begin() const { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::const_iterator end() const { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rend() const { return headers_.rend(); }
-    size_t size() const { return headers_.size(); }
-    bool empty() const { return headers_.empty(); }
+    Iterator<false> begin() const { return Iterator<false>(head_); }
+    Iterator<false> end() const { return Iterator<false>(nullptr); }
+    Iterator<true> rbegin() const { return Iterator<true>(tail_); }
+    Iterator<true> rend() const { return Iterator<true>(nullptr); }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
     void clear() {
-      headers_.clear();
-      pseudo_headers_end_ = headers_.end();
+      for (HeaderEntryImpl* entry = head_; entry != nullptr;) {
+        HeaderEntryImpl* next = entry->next_;
+        entry->~HeaderEntryImpl();
+        entry = next;
+      }
+      head_ = nullptr;
+      tail_ = nullptr;
+      last_pseudo_header_ = nullptr;
+      size_ = 0;
+      blocks_.clear();
+      block_size_ = 0;
+      next_slot_ = 0;
+      free_slots_ = nullptr;
     }
 
   private:
-    std::list<HeaderEntryImpl> headers_;
-    std::list<HeaderEntryImpl>::iterator pseudo_headers_end_;
+    using Slot = std::aligned_storage_t<sizeof(HeaderEntryImpl), alignof(HeaderEntryImpl)>;
+
+    // Link the entry after prev, or first if prev is nullptr.
+    void link(HeaderEntryImpl* entry, HeaderEntryImpl* prev) {
+      entry->prev_ = prev;
+      entry->next_ = prev != nullptr ? prev->next_ : head_;
+      (entry->next_ != nullptr ? entry->next_->prev_ : tail_) = entry;
+      (prev != nullptr ? prev->next_ : head_) = entry;
+      ++size_;
+    }
+
+    void unlink(HeaderEntryImpl* entry) {
+      if (entry == last_pseudo_header_) {
+        // The pseudo headers come first, so the previous entry is a pseudo header if any.
+        last_pseudo_header_ = entry->prev_;
+      }
+      (entry->prev_ != nullptr ? entry->prev_->next_ : head_) = entry->next_;
+      (entry->next_ != nullptr ? entry->next_->prev_ : tail_) = entry->prev_;
+      --size_;
+    }
+
+    void* allocateSlot() {
+      if (free_slots_ != nullptr) {
+        // The free slots are linked through their first bytes.
+        void* slot = free_slots_;
+        free_slots_ = *static_cast<void**>(slot);
+        return slot;
+      }
+      if (next_slot_ == block_size_) {
+        block_size_ = std::min(std::max(2 * block_size_, MinEntriesPerBlock), MaxEntriesPerBlock);
+        // Not value initialized, as the slots are constructed on use.
+        blocks_.push_back(std::unique_ptr<Slot[]>(new Slot[block_size_]));
+        next_slot_ = 0;
+      }
+      return &blocks_.back()[next_slot_++];
+    }
+
+    void releaseSlot(HeaderEntryImpl* entry) {
+      entry->~HeaderEntryImpl();
+      void* slot = entry;
+      *static_cast<void**>(slot) = free_slots_;
+      free_slots_ = slot;
+    }
+
+    // The entries are linked in order, so that any of them is removed in constant time.
+    HeaderEntryImpl* head_{};
+    HeaderEntryImpl* tail_{};
+    HeaderEntryImpl* last_pseudo_header_{};
+    size_t size_{};
+    absl::InlinedVector<std::unique_ptr<Slot[]>, 4> blocks_;
+    // The size of the last block, and the index of its next unused slot.
+    size_t block_size_{};
+    size_t next_slot_{};
+    void* free_slots_{};
   };
 
   void insertByKey(HeaderString&& key, HeaderString&& value);
@@ -290,7 +290,9 @@ public:
   } AcceptEncodingValues;
 
   struct {
+    const std::string Brotli{"br"};
     const std::string Gzip{"gzip"};
+    const std::string Zstd{"zstd"};
   } ContentEncodingValues;
 
   struct {
@@ -0,0 +1,190 @@
+#include "common/network/caching_dns_resolver.h"
+
+#include <algorithm>
+
+#include "common/common/assert.h"
+#include "common/common/hash.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Network {
+
+CachingDnsResolverImpl::CachingDnsResolverImpl(std::vector<DnsResolverSharedPtr> channels,
+                                               TimeSource& time_source,
+                                               const CachingDnsResolverConfig& config,
+                                               Stats::Scope& scope)
+    : channels_(std::move(channels)), time_source_(time_source), config_(config),
+      stats_(generateStats(scope)) {
+  ASSERT(!channels_.empty());
+  ASSERT(config_.max_entries_ > 0);
+}
+
+CachingDnsResolverImpl::~CachingDnsResolverImpl() {
+  // As for the resolvers of the channels, the callbacks of pending lookups are not invoked once the
+  // resolver is destroyed.
+  for (const auto& pending_query : pending_queries_) {
+    if (pending_query.second->active_query_ != nullptr) {
+      pending_query.second->active_query_->cancel();
+    }
+  }
+  stats_.pending_queries_.sub(pending_queries_.size());
+  stats_.cache_entries_.sub(cache_.size());
+}
+
+ActiveDnsQuery* CachingDnsResolverImpl::resolve(const std::string& dns_name,
+                                                DnsLookupFamily dns_lookup_family,
+                                                ResolveCb callback) {
+  const std::string key = absl::StrCat(static_cast<int>(dns_lookup_family), "/", dns_name);
+  const MonotonicTime now = time_source_.monotonicTime();
+  const CacheEntry* entry = lookup(key, now);
+  if (entry != nullptr) {
+    const std::chrono::seconds remaining_ttl =
+        std::chrono::ceil<std::chrono::seconds>(entry->expiry_time_ - now);
+    std::list<DnsResponse> response;
+    for (const DnsResponse& cached : entry->response_) {
+      response.emplace_back(cached.address_, remaining_ttl);
+    }
+    if (response.empty()) {
+      stats_.negative_cache_hit_.inc();
+    } else {
+      stats_.cache_hit_.inc();
+    }
+    // The callback may look up other names, so the entry must not be used past this point.
+    callback(entry->status_, std::move(response));
+    return nullptr;
+  }
+
+  auto it = pending_queries_.find(key);
+  if (it != pending_queries_.end()) {
+    stats_.query_deduplicated_.inc();
+    PendingQuery& query = *it->second;
+    query.waiters_.push_back(std::make_unique<Waiter>(query, std::move(callback)));
+    query.waiters_.back()->position_ = std::prev(query.waiters_.end());
+    return query.waiters_.back().get();
+  }
+
+  stats_.cache_miss_.inc();
+  stats_.pending_queries_.inc();
+  auto owned_query = std::make_unique<PendingQuery>(*this, key, now);
+  PendingQuery& query = *owned_query;
+  query.waiters_.push_back(std::make_unique<Waiter>(query, std::move(callback)));
+  query.waiters_.back()->position_ = query.waiters_.begin();
+  Waiter* waiter = query.waiters_.back().get();
+  pending_queries_.emplace(key, std::move(owned_query));
+
+  DnsResolver& channel = *channels_[HashUtil::xxHash64(dns_name) % channels_.size()];
+  ActiveDnsQuery* active_query = channel.resolve(
+      dns_name, dns_lookup_family,
+      [this, &query](ResolutionStatus status, std::list<DnsResponse>&& response) {
+        onQueryComplete(query, status, std::move(response));
+      });
+  if (active_query == nullptr) {
+    // The lookup completed synchronously, and the query is already gone.
+    return nullptr;
+  }
+  query.active_query_ = active_query;
+  return waiter;
+}
+
+void CachingDnsResolverImpl::Waiter::cancel() {
+  PendingQuery& query = query_;
+  // This deletes the waiter.
+  query.waiters_.erase(position_);
+  if (query.waiters_.empty() && query.active_query_ != nullptr) {
+    query.parent_.cancelQuery(query);
+  }
+}
+
+void CachingDnsResolverImpl::cancelQuery(PendingQuery& query) {
+  query.active_query_->cancel();
+  stats_.pending_queries_.dec();
+  pending_queries_.erase(query.key_);
+}
+
+void CachingDnsResolverImpl::onQueryComplete(PendingQuery& query, ResolutionStatus status,
+                                             std::list<DnsResponse>&& response) {
+  const MonotonicTime now = time_source_.monotonicTime();
+  stats_.resolve_time_.recordValue(
+      std::chrono::duration_cast<std::chrono::milliseconds>(now - query.start_time_).count());
+  if (status != ResolutionStatus::Success) {
+    stats_.resolve_failure_.inc();
+  }
+  insert(query.key_, status, response, now);
+
+  // The query is taken out before invoking the callbacks, which may look up the same name again.
+  auto it = pending_queries_.find(query.key_);
+  ASSERT(it != pending_queries_.end() && it->second.get() == &query);
+  PendingQueryPtr owned_query = std::move(it->second);
+  pending_queries_.erase(it);
+  stats_.pending_queries_.dec();
+  owned_query->active_query_ = nullptr;
+
+  // Waiters may be cancelled by the callbacks of other waiters.
+  while (!owned_query->waiters_.empty()) {
+    std::unique_ptr<Waiter> waiter = std::move(owned_query->waiters_.front());
+    owned_query->waiters_.pop_front();
+    if (owned_query->waiters_.empty()) {
+      waiter->callback_(status, std::move(response));
+    } else {
+      std::list<DnsResponse> response_copy = response;
+      waiter->callback_(status, std::move(response_copy));
+    }
+  }
+}
+
+const CachingDnsResolverImpl::CacheEntry* CachingDnsResolverImpl::lookup(const std::string& key,
+                                                                        MonotonicTime now) {
+  auto it = cache_.find(key);
+  if (it == cache_.end()) {
+    return nullptr;
+  }
+  if (it->second.expiry_time_ <= now) {
+    erase(it);
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lru_position_);
+  return &it->second;
+}
+
+void CachingDnsResolverImpl::insert(const std::string& key, ResolutionStatus status,
+                                    const std::list<DnsResponse>& response, MonotonicTime now) {
+  const std::chrono::seconds ttl = cacheTtl(status, response);
+  if (ttl.count() == 0) {
+    return;
+  }
+
+  auto it = cache_.find(key);
+  if (it != cache_.end()) {
+    erase(it);
+  }
+  while (cache_.size() >= config_.max_entries_) {
+    erase(cache_.find(lru_.back()));
+    stats_.cache_eviction_.inc();
+  }
+  lru_.push_front(key);
+  cache_.emplace(key, CacheEntry{status, response, now + ttl, lru_.begin()});
+  stats_.cache_entries_.inc();
+}
+
+void CachingDnsResolverImpl::erase(absl::flat_hash_map<std::string, CacheEntry>::iterator it) {
+  lru_.erase(it->second.lru_position_);
+  cache_.erase(it);
+  stats_.cache_entries_.dec();
+}
+
+std::chrono::seconds
+CachingDnsResolverImpl::cacheTtl(ResolutionStatus status,
+                                 const std::list<DnsResponse>& response) const {
+  if (status != ResolutionStatus::Success || response.empty()) {
+    return config_.negative_ttl_;
+  }
+  std::chrono::seconds ttl = response.front().ttl_;
+  for (const DnsResponse& address : response) {
+    ttl = std::min(ttl, address.ttl_);
+  }
+  return std::min(std::max(ttl, config_.min_ttl_), config_.max_ttl_);
+}
+
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/network/dns.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "common/common/logger.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * All caching DNS resolver stats. @see stats_macros.h
+ */
+#define ALL_CACHING_DNS_RESOLVER_STATS(COUNTER, GAUGE, HISTOGRAM)                                  \
+  COUNTER(cache_hit)                                                                               \
+  COUNTER(cache_miss)                                                                              \
+  COUNTER(negative_cache_hit)                                                                      \
+  COUNTER(query_deduplicated)                                                                      \
+  COUNTER(resolve_failure)                                                                         \
+  COUNTER(cache_eviction)                                                                          \
+  GAUGE(cache_entries, NeverImport)                                                                \
+  GAUGE(pending_queries, NeverImport)                                                              \
+  HISTOGRAM(resolve_time, Milliseconds)
+
+/**
+ * Struct definition for all caching DNS resolver stats. @see stats_macros.h
+ */
+struct CachingDnsResolverStats {
+  ALL_CACHING_DNS_RESOLVER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT,
+                                 GENERATE_HISTOGRAM_STRUCT)
+};
+
+/**
+ * Caching parameters of a CachingDnsResolverImpl.
+ */
+struct CachingDnsResolverConfig {
+  // Successful lookups are cached for the smallest TTL of their addresses, bounded by these.
+  std::chrono::seconds min_ttl_{0};
+  std::chrono::seconds max_ttl_{300};
+  // Failed lookups, and lookups without any address, are cached for this long.
+  std::chrono::seconds negative_ttl_{5};
+  uint32_t max_entries_{4096};
+};
+
+/**
+ * A DnsResolver caching the lookups of other resolvers, one per c-ares channel, and spreading
+ * lookups over them by the hash of the name. Concurrent lookups of the same name share a single
+ * query. As the resolvers it wraps, all calls and callbacks are assumed to happen on the thread
+ * that owns the dispatcher of the resolvers.
+ *
+ * Lookups found in the cache complete synchronously: their callback is invoked before resolve()
+ * returns nullptr. The TTL of the addresses returned from the cache is the time they have left in
+ * the cache, so that callers respecting the TTL refresh them once they expire.
+ */
+class CachingDnsResolverImpl : public DnsResolver,
+                               protected Logger::Loggable<Logger::Id::upstream> {
+public:
+  CachingDnsResolverImpl(std::vector<DnsResolverSharedPtr> channels, TimeSource& time_source,
+                         const CachingDnsResolverConfig& config, Stats::Scope& scope);
+  ~CachingDnsResolverImpl() override;
+
+  // Network::DnsResolver
+  ActiveDnsQuery* resolve(const std::string& dns_name, DnsLookupFamily dns_lookup_family,
+                          ResolveCb callback) override;
+
+  static CachingDnsResolverStats generateStats(Stats::Scope& scope) {
+    return {ALL_CACHING_DNS_RESOLVER_STATS(POOL_COUNTER_PREFIX(scope, "dns.cache."),
+                                           POOL_GAUGE_PREFIX(scope, "dns.cache."),
+                                           POOL_HISTOGRAM_PREFIX(scope, "dns.cache."))};
+  }
+
+private:
+  struct PendingQuery;
+
+  // A caller waiting for the completion of a shared query.
+  struct Waiter : public ActiveDnsQuery {
+    Waiter(PendingQuery& query, ResolveCb callback)
+        : query_(query), callback_(std::move(callback)) {}
+
+    // Network::ActiveDnsQuery
+    void cancel() override;
+
+    PendingQuery& query_;
+    const ResolveCb callback_;
+    std::list<std::unique_ptr<Waiter>>::iterator position_;
+  };
+
+  struct PendingQuery {
+    PendingQuery(CachingDnsResolverImpl& parent, const std::string& key, MonotonicTime start_time)
+        : parent_(parent), key_(key), start_time_(start_time) {}
+
+    CachingDnsResolverImpl& parent_;
+    const std::string key_;
+    const MonotonicTime start_time_;
+    std::list<std::unique_ptr<Waiter>> waiters_;
+    // nullptr once the query completed, or if it completed synchronously.
+    ActiveDnsQuery* active_query_{};
+  };
+  using PendingQueryPtr = std::unique_ptr<PendingQuery>;
+
+  struct CacheEntry {
+    ResolutionStatus status_;
+    std::list<DnsResponse> response_;
+    MonotonicTime expiry_time_;
+    std::list<std::string>::iterator lru_position_;
+  };
+
+  void onQueryComplete(PendingQuery& query, ResolutionStatus status,
+                       std::list<DnsResponse>&& response);
+  // Cancel the query shared by no one anymore.
+  void cancelQuery(PendingQuery& query);
+  // @return the cached lookup, or nullptr if not found or expired.
+  const CacheEntry* lookup(const std::string& key, MonotonicTime now);
+  void insert(const std::string& key, ResolutionStatus status,
+              const std::list<DnsResponse>& response, MonotonicTime now);
+  void erase(absl::flat_hash_map<std::string, CacheEntry>::iterator it);
+  std::chrono::seconds cacheTtl(ResolutionStatus status,
+                                const std::list<DnsResponse>& response) const;
+
+  const std::vector<DnsResolverSharedPtr> channels_;
+  TimeSource& time_source_;
+  const CachingDnsResolverConfig config_;
+  CachingDnsResolverStats stats_;
+  // Most recently used first.
+  std::list<std::string> lru_;
+  absl::flat_hash_map<std::string, CacheEntry> cache_;
+  absl::flat_hash_map<std::string, PendingQueryPtr> pending_queries_;
+};
+
+} // namespace Network
+} // namespace Envoy
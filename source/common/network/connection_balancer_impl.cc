@@ -1,5 +1,12 @@
 #include "common/network/connection_balancer_impl.h"
 
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <time.h>
+#endif
+
 namespace Envoy {
 namespace Network {
 
@@ -34,5 +41,104 @@ ExactConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler&) {
   return *min_connection_handler;
 }
 
+namespace {
+
+// Floor of the estimated cost of a connection, so that connections keep being spread across idle
+// workers between samples.
+constexpr double MinConnectionCost = 0.001;
+
+} // namespace
+
+LoadAwareConnectionBalancerImpl::LoadAwareConnectionBalancerImpl(
+    TimeSource& time_source, std::chrono::milliseconds sample_interval)
+    : time_source_(time_source), sample_interval_(sample_interval),
+      last_sample_time_(time_source.monotonicTime()), connection_cost_(MinConnectionCost) {}
+
+LoadAwareConnectionBalancerImpl::CpuClock LoadAwareConnectionBalancerImpl::currentThreadCpuClock() {
+#ifdef __linux__
+  clockid_t clock_id;
+  if (pthread_getcpuclockid(pthread_self(), &clock_id) == 0) {
+    return [clock_id]() -> absl::optional<std::chrono::nanoseconds> {
+      timespec cpu_time;
+      if (clock_gettime(clock_id, &cpu_time) != 0) {
+        return absl::nullopt;
+      }
+      return std::chrono::seconds(cpu_time.tv_sec) + std::chrono::nanoseconds(cpu_time.tv_nsec);
+    };
+  }
+#endif
+  return []() -> absl::optional<std::chrono::nanoseconds> { return absl::nullopt; };
+}
+
+void LoadAwareConnectionBalancerImpl::registerHandler(BalancedConnectionHandler& handler) {
+  CpuClock cpu_clock = currentThreadCpuClock();
+  const absl::optional<std::chrono::nanoseconds> cpu_time = cpu_clock();
+  absl::MutexLock lock(&lock_);
+  handlers_.push_back(HandlerLoad{&handler, std::move(cpu_clock), cpu_time});
+}
+
+void LoadAwareConnectionBalancerImpl::unregisterHandler(BalancedConnectionHandler& handler) {
+  absl::MutexLock lock(&lock_);
+  handlers_.erase(std::find_if(handlers_.begin(), handlers_.end(),
+                               [&handler](const HandlerLoad& handler_load) {
+                                 return handler_load.handler_ == &handler;
+                               }));
+}
+
+BalancedConnectionHandler&
+LoadAwareConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler& current_handler) {
+  absl::MutexLock lock(&lock_);
+  const MonotonicTime now = time_source_.monotonicTime();
+  if (now - last_sample_time_ >= sample_interval_) {
+    sample(now);
+  }
+
+  // Ties are broken by the number of connections, then in favor of the current handler, which
+  // saves a transfer to another worker.
+  HandlerLoad* target = nullptr;
+  double target_load = 0;
+  for (HandlerLoad& handler_load : handlers_) {
+    const double load =
+        handler_load.utilization_ + handler_load.connections_since_sample_ * connection_cost_;
+    if (target == nullptr || load < target_load ||
+        (load == target_load &&
+         (handler_load.handler_->numConnections() < target->handler_->numConnections() ||
+          (handler_load.handler_->numConnections() == target->handler_->numConnections() &&
+           handler_load.handler_ == &current_handler)))) {
+      target = &handler_load;
+      target_load = load;
+    }
+  }
+
+  ++target->connections_since_sample_;
+  target->handler_->incNumConnections();
+  return *target->handler_;
+}
+
+void LoadAwareConnectionBalancerImpl::sample(MonotonicTime now) {
+  const double elapsed =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_sample_time_).count();
+  last_sample_time_ = now;
+
+  double total_utilization = 0;
+  uint64_t total_connections = 0;
+  for (HandlerLoad& handler_load : handlers_) {
+    const absl::optional<std::chrono::nanoseconds> cpu_time = handler_load.cpu_clock_();
+    if (cpu_time.has_value() && handler_load.last_cpu_time_.has_value()) {
+      handler_load.utilization_ =
+          (cpu_time.value() - handler_load.last_cpu_time_.value()).count() / elapsed;
+    } else {
+      handler_load.utilization_ = 0;
+    }
+    handler_load.last_cpu_time_ = cpu_time;
+    handler_load.connections_since_sample_ = 0;
+    total_utilization += handler_load.utilization_;
+    total_connections += handler_load.handler_->numConnections();
+  }
+
+  connection_cost_ = std::max(total_utilization / std::max<uint64_t>(total_connections, 1),
+                              MinConnectionCost);
+}
+
 } // namespace Network
 } // namespace Envoy
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#include "envoy/common/time.h"
 #include "envoy/network/connection_balancer.h"
 
 #include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Network {
@@ -27,6 +33,56 @@ private:
   std::vector<BalancedConnectionHandler*> handlers_ GUARDED_BY(lock_);
 };
 
+/**
+ * Implementation of connection balancer that weighs handlers by the CPU time recently spent by the
+ * worker thread which registered them, rather than by their number of connections, as long-lived
+ * connections (e.g., HTTP/2 or gRPC) may carry very different loads. The CPU time of the workers
+ * is sampled on accept at most once per sample interval. Each connection is sent to the handler
+ * with the least estimated load, which is the CPU utilization of its worker over the last sample
+ * interval plus the average cost of a connection for each connection sent to it since. Handlers
+ * whose CPU time is not available are estimated as idle, so that this degrades to balancing
+ * connection counts. As ExactConnectionBalancerImpl, this holds a lock during balancing.
+ */
+class LoadAwareConnectionBalancerImpl : public ConnectionBalancer {
+public:
+  LoadAwareConnectionBalancerImpl(TimeSource& time_source,
+                                  std::chrono::milliseconds sample_interval);
+
+  // ConnectionBalancer
+  void registerHandler(BalancedConnectionHandler& handler) override;
+  void unregisterHandler(BalancedConnectionHandler& handler) override;
+  BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler) override;
+
+protected:
+  // @return the CPU time spent so far by a thread, or nullopt if not available.
+  using CpuClock = std::function<absl::optional<std::chrono::nanoseconds>()>;
+
+  /**
+   * @return the CPU clock of the calling thread. Handlers are registered by their worker thread.
+   */
+  virtual CpuClock currentThreadCpuClock();
+
+private:
+  struct HandlerLoad {
+    BalancedConnectionHandler* handler_;
+    CpuClock cpu_clock_;
+    absl::optional<std::chrono::nanoseconds> last_cpu_time_;
+    // Fraction of a CPU used by the worker over the last sample interval.
+    double utilization_{};
+    uint64_t connections_since_sample_{};
+  };
+
+  void sample(MonotonicTime now) EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  TimeSource& time_source_;
+  const std::chrono::milliseconds sample_interval_;
+  absl::Mutex lock_;
+  std::vector<HandlerLoad> handlers_ GUARDED_BY(lock_);
+  MonotonicTime last_sample_time_ GUARDED_BY(lock_);
+  // Estimated fraction of a CPU used by a connection, as of the last sample.
+  double connection_cost_ GUARDED_BY(lock_);
+};
+
 /**
  * A NOP connection balancer implementation that always continues execution after incrementing
  * the handler's connection count.
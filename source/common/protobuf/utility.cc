@@ -543,18 +543,16 @@ void MessageUtil::unpackTo(const ProtobufWkt::Any& any_message, Protobuf::Messag
   if (any_full_name != message.GetDescriptor()->full_name()) {
     const Protobuf::Descriptor* earlier_version_desc =
         Config::ApiTypeOracle::getEarlierVersionDescriptor(message.GetDescriptor()->full_name());
-    // If the earlier version matches, unpack and upgrade.
+    // If the earlier version matches, upgrade straight from the packed bytes. Both versions
+    // share their wire format, so there is no need for an intermediate earlier version message.
     if (earlier_version_desc != nullptr && any_full_name == earlier_version_desc->full_name()) {
-      Protobuf::DynamicMessageFactory dmf;
-      auto earlier_message =
-          ProtobufTypes::MessagePtr(dmf.GetPrototype(earlier_version_desc)->New());
-      ASSERT(earlier_message != nullptr);
-      if (!any_message.UnpackTo(earlier_message.get())) {
+      try {
+        Config::VersionConverter::upgrade(*earlier_version_desc, any_message.value(), message);
+      } catch (const EnvoyException&) {
         throw EnvoyException(fmt::format("Unable to unpack as {}: {}",
-                                         earlier_message->GetDescriptor()->full_name(),
+                                         earlier_version_desc->full_name(),
                                          any_message.DebugString()));
       }
-      Config::VersionConverter::upgrade(*earlier_message, message);
       return;
     }
   }
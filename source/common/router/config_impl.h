@@ -555,7 +555,7 @@ protected:
 
 private:
   struct RuntimeData {
-    std::string fractional_runtime_key_{};
+    Runtime::KeyHandle fractional_runtime_key_;
     envoy::type::v3::FractionalPercent fractional_runtime_default_{};
   };
 
@@ -699,7 +699,7 @@ private:
     const RouteSpecificFilterConfig* perFilterConfig(const std::string& name) const override;
 
   private:
-    const std::string runtime_key_;
+    const Runtime::KeyHandle runtime_key_;
     Runtime::Loader& loader_;
     const uint64_t cluster_weight_;
     MetadataMatchCriteriaConstPtr cluster_metadata_match_criteria_;
@@ -13,10 +13,24 @@
 #include "common/http/codes.h"
 #include "common/http/headers.h"
 #include "common/http/utility.h"
+#include "common/runtime/runtime_keys.h"
+#include "common/singleton/const_singleton.h"
 
 namespace Envoy {
 namespace Router {
 
+namespace {
+
+struct RuntimeKeyValues {
+  const Runtime::KeyHandle BaseRetryBackoffMs{
+      Runtime::KeyRegistry::registerKey("upstream.base_retry_backoff_ms")};
+  const Runtime::KeyHandle UseRetry{Runtime::KeyRegistry::registerKey("upstream.use_retry")};
+};
+
+using RuntimeKeys = ConstSingleton<RuntimeKeyValues>;
+
+} // namespace
+
 // These are defined in envoy/router/router.h, however during certain cases the compiler is
 // refusing to use the header version so allocate space here.
 const uint32_t RetryPolicy::RETRY_ON_5XX;
@@ -65,7 +79,7 @@ RetryStateImpl::RetryStateImpl(const RetryPolicy& route_policy,
       retriable_headers_(route_policy.retriableHeaders()) {
 
   std::chrono::milliseconds base_interval(
-      runtime_.snapshot().getInteger("upstream.base_retry_backoff_ms", 25));
+      runtime_.snapshot().getInteger(RuntimeKeys::get().BaseRetryBackoffMs, 25));
   if (route_policy.baseInterval()) {
     base_interval = *route_policy.baseInterval();
   }
@@ -243,7 +257,7 @@ RetryStatus RetryStateImpl::shouldRetry(bool would_retry, DoRetryCallback callba
     return RetryStatus::NoOverflow;
   }
 
-  if (!runtime_.snapshot().featureEnabled("upstream.use_retry", 100)) {
+  if (!runtime_.snapshot().featureEnabled(RuntimeKeys::get().UseRetry, 100)) {
     return RetryStatus::No;
   }
 
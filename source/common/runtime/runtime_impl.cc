@@ -190,19 +190,13 @@ bool SnapshotImpl::runtimeFeatureEnabled(absl::string_view key) const {
 
 bool SnapshotImpl::featureEnabled(absl::string_view key, uint64_t default_value,
                                   uint64_t random_value, uint64_t num_buckets) const {
-  return random_value % num_buckets < std::min(getInteger(key, default_value), num_buckets);
+  ASSERT(!isRuntimeFeature(key));
+  return entryEnabled(findEntry(key), default_value, random_value, num_buckets);
 }
 
 bool SnapshotImpl::featureEnabled(absl::string_view key, uint64_t default_value) const {
-  // Avoid PRNG if we know we don't need it.
-  uint64_t cutoff = std::min(getInteger(key, default_value), static_cast<uint64_t>(100));
-  if (cutoff == 0) {
-    return false;
-  } else if (cutoff == 100) {
-    return true;
-  } else {
-    return generator_.random() % 100 < cutoff;
-  }
+  ASSERT(!isRuntimeFeature(key));
+  return entryEnabled(findEntry(key), default_value);
 }
 
 bool SnapshotImpl::featureEnabled(absl::string_view key, uint64_t default_value,
@@ -212,11 +206,11 @@ bool SnapshotImpl::featureEnabled(absl::string_view key, uint64_t default_value,
 
 Snapshot::ConstStringOptRef SnapshotImpl::get(absl::string_view key) const {
   ASSERT(!isRuntimeFeature(key)); // Make sure runtime guarding is only used for getBoolean
-  auto entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end()) {
+  const Entry* entry = findEntry(key);
+  if (entry == nullptr) {
     return absl::nullopt;
   } else {
-    return entry->second.raw_string_value_;
+    return entry->raw_string_value_;
   }
 }
 
@@ -228,22 +222,109 @@ bool SnapshotImpl::featureEnabled(absl::string_view key,
 bool SnapshotImpl::featureEnabled(absl::string_view key,
                                   const envoy::type::v3::FractionalPercent& default_value,
                                   uint64_t random_value) const {
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
+  return entryEnabled(findEntry(key), default_value, random_value);
+}
+
+uint64_t SnapshotImpl::getInteger(absl::string_view key, uint64_t default_value) const {
+  ASSERT(!isRuntimeFeature(key));
+  return entryInteger(findEntry(key), default_value);
+}
+
+double SnapshotImpl::getDouble(absl::string_view key, double default_value) const {
+  ASSERT(!isRuntimeFeature(key)); // Make sure runtime guarding is only used for getBoolean
+  return entryDouble(findEntry(key), default_value);
+}
+
+bool SnapshotImpl::getBoolean(absl::string_view key, bool default_value) const {
+  return entryBoolean(findEntry(key), default_value);
+}
+
+bool SnapshotImpl::featureEnabled(const KeyHandle& key, uint64_t default_value) const {
+  ASSERT(!isRuntimeFeature(key.name()));
+  return entryEnabled(findEntry(key), default_value);
+}
+
+bool SnapshotImpl::featureEnabled(const KeyHandle& key, uint64_t default_value,
+                                  uint64_t random_value) const {
+  ASSERT(!isRuntimeFeature(key.name()));
+  return entryEnabled(findEntry(key), default_value, random_value, 100);
+}
+
+bool SnapshotImpl::featureEnabled(const KeyHandle& key, uint64_t default_value,
+                                  uint64_t random_value, uint64_t num_buckets) const {
+  ASSERT(!isRuntimeFeature(key.name()));
+  return entryEnabled(findEntry(key), default_value, random_value, num_buckets);
+}
+
+bool SnapshotImpl::featureEnabled(const KeyHandle& key,
+                                  const envoy::type::v3::FractionalPercent& default_value) const {
+  return entryEnabled(findEntry(key), default_value, generator_.random());
+}
+
+bool SnapshotImpl::featureEnabled(const KeyHandle& key,
+                                  const envoy::type::v3::FractionalPercent& default_value,
+                                  uint64_t random_value) const {
+  return entryEnabled(findEntry(key), default_value, random_value);
+}
+
+uint64_t SnapshotImpl::getInteger(const KeyHandle& key, uint64_t default_value) const {
+  ASSERT(!isRuntimeFeature(key.name()));
+  return entryInteger(findEntry(key), default_value);
+}
+
+double SnapshotImpl::getDouble(const KeyHandle& key, double default_value) const {
+  ASSERT(!isRuntimeFeature(key.name()));
+  return entryDouble(findEntry(key), default_value);
+}
+
+bool SnapshotImpl::getBoolean(const KeyHandle& key, bool default_value) const {
+  return entryBoolean(findEntry(key), default_value);
+}
+
+const Snapshot::Entry* SnapshotImpl::findEntry(absl::string_view key) const {
+  const auto entry = key.empty() ? values_.end() : values_.find(key);
+  return entry == values_.end() ? nullptr : &entry->second;
+}
+
+const Snapshot::Entry* SnapshotImpl::findEntry(const KeyHandle& key) const {
+  if (key.index() < registered_entries_.size() &&
+      registered_entries_[key.index()].id_ == key.id()) {
+    return registered_entries_[key.index()].entry_;
+  }
+  // The key was registered after this snapshot was created.
+  return findEntry(key.name());
+}
+
+bool SnapshotImpl::entryEnabled(const Entry* entry, uint64_t default_value) const {
+  // Avoid PRNG if we know we don't need it.
+  uint64_t cutoff = std::min(entryInteger(entry, default_value), static_cast<uint64_t>(100));
+  if (cutoff == 0) {
+    return false;
+  } else if (cutoff == 100) {
+    return true;
+  } else {
+    return generator_.random() % 100 < cutoff;
+  }
+}
+
+bool SnapshotImpl::entryEnabled(const Entry* entry,
+                                const envoy::type::v3::FractionalPercent& default_value,
+                                uint64_t random_value) const {
   envoy::type::v3::FractionalPercent percent;
-  if (entry != values_.end() && entry->second.fractional_percent_value_.has_value()) {
-    percent = entry->second.fractional_percent_value_.value();
-  } else if (entry != values_.end() && entry->second.uint_value_.has_value()) {
+  if (entry != nullptr && entry->fractional_percent_value_.has_value()) {
+    percent = entry->fractional_percent_value_.value();
+  } else if (entry != nullptr && entry->uint_value_.has_value()) {
     // Check for > 100 because the runtime value is assumed to be specified as
     // an integer, and it also ensures that truncating the uint64_t runtime
     // value into a uint32_t percent numerator later is safe
-    if (entry->second.uint_value_.value() > 100) {
+    if (entry->uint_value_.value() > 100) {
       return true;
     }
 
     // The runtime value was specified as an integer rather than a fractional
     // percent proto. To preserve legacy semantics, we treat it as a percentage
     // (i.e. denominator of 100).
-    percent.set_numerator(entry->second.uint_value_.value());
+    percent.set_numerator(entry->uint_value_.value());
     percent.set_denominator(envoy::type::v3::FractionalPercent::HUNDRED);
   } else {
     percent = default_value;
@@ -252,32 +333,32 @@ bool SnapshotImpl::featureEnabled(absl::string_view key,
   return ProtobufPercentHelper::evaluateFractionalPercent(percent, random_value);
 }
 
-uint64_t SnapshotImpl::getInteger(absl::string_view key, uint64_t default_value) const {
-  ASSERT(!isRuntimeFeature(key));
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.uint_value_) {
+bool SnapshotImpl::entryEnabled(const Entry* entry, uint64_t default_value, uint64_t random_value,
+                                uint64_t num_buckets) {
+  return random_value % num_buckets < std::min(entryInteger(entry, default_value), num_buckets);
+}
+
+uint64_t SnapshotImpl::entryInteger(const Entry* entry, uint64_t default_value) {
+  if (entry == nullptr || !entry->uint_value_) {
     return default_value;
   } else {
-    return entry->second.uint_value_.value();
+    return entry->uint_value_.value();
   }
 }
 
-double SnapshotImpl::getDouble(absl::string_view key, double default_value) const {
-  ASSERT(!isRuntimeFeature(key)); // Make sure runtime guarding is only used for getBoolean
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.double_value_) {
+double SnapshotImpl::entryDouble(const Entry* entry, double default_value) {
+  if (entry == nullptr || !entry->double_value_) {
     return default_value;
   } else {
-    return entry->second.double_value_.value();
+    return entry->double_value_.value();
   }
 }
 
-bool SnapshotImpl::getBoolean(absl::string_view key, bool default_value) const {
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.bool_value_.has_value()) {
+bool SnapshotImpl::entryBoolean(const Entry* entry, bool default_value) {
+  if (entry == nullptr || !entry->bool_value_.has_value()) {
     return default_value;
   } else {
-    return entry->second.bool_value_.value();
+    return entry->bool_value_.value();
   }
 }
 
@@ -294,6 +375,7 @@ SnapshotImpl::SnapshotImpl(RandomGenerator& generator, RuntimeStats& stats,
       values_.emplace(kv.first, kv.second);
     }
   }
+  registered_entries_ = KeyRegistry::resolve(values_);
   stats.num_keys_.set(values_.size());
 }
 
@@ -26,6 +26,7 @@
 #include "common/config/subscription_base.h"
 #include "common/init/manager_impl.h"
 #include "common/init/target_impl.h"
+#include "common/runtime/runtime_keys.h"
 #include "common/singleton/threadsafe_singleton.h"
 
 #include "spdlog/spdlog.h"
@@ -97,6 +98,19 @@ public:
   uint64_t getInteger(absl::string_view key, uint64_t default_value) const override;
   double getDouble(absl::string_view key, double default_value) const override;
   bool getBoolean(absl::string_view key, bool value) const override;
+  bool featureEnabled(const KeyHandle& key, uint64_t default_value) const override;
+  bool featureEnabled(const KeyHandle& key, uint64_t default_value,
+                      uint64_t random_value) const override;
+  bool featureEnabled(const KeyHandle& key, uint64_t default_value, uint64_t random_value,
+                      uint64_t num_buckets) const override;
+  bool featureEnabled(const KeyHandle& key,
+                      const envoy::type::v3::FractionalPercent& default_value) const override;
+  bool featureEnabled(const KeyHandle& key,
+                      const envoy::type::v3::FractionalPercent& default_value,
+                      uint64_t random_value) const override;
+  uint64_t getInteger(const KeyHandle& key, uint64_t default_value) const override;
+  double getDouble(const KeyHandle& key, double default_value) const override;
+  bool getBoolean(const KeyHandle& key, bool default_value) const override;
   const std::vector<OverrideLayerConstPtr>& getLayers() const override;
 
   static Entry createEntry(const std::string& value);
@@ -124,8 +138,24 @@ private:
   static bool parseEntryDoubleValue(Entry& entry);
   static void parseEntryFractionalPercentValue(Entry& entry);
 
+  // Lookups of entries, returning nullptr if the key does not exist.
+  const Entry* findEntry(absl::string_view key) const;
+  const Entry* findEntry(const KeyHandle& key) const;
+
+  // Evaluation of possibly missing entries, shared by the lookups by name and by handle.
+  bool entryEnabled(const Entry* entry, uint64_t default_value) const;
+  bool entryEnabled(const Entry* entry, const envoy::type::v3::FractionalPercent& default_value,
+                    uint64_t random_value) const;
+  static bool entryEnabled(const Entry* entry, uint64_t default_value, uint64_t random_value,
+                           uint64_t num_buckets);
+  static uint64_t entryInteger(const Entry* entry, uint64_t default_value);
+  static double entryDouble(const Entry* entry, double default_value);
+  static bool entryBoolean(const Entry* entry, bool default_value);
+
   const std::vector<OverrideLayerConstPtr> layers_;
   EntryMap values_;
+  // The entries of the keys registered when the snapshot was created, by key index.
+  std::vector<KeyRegistry::ResolvedKey> registered_entries_;
   RandomGenerator& generator_;
   RuntimeStats& stats_;
 };
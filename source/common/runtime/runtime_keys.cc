@@ -0,0 +1,92 @@
+#include "common/runtime/runtime_keys.h"
+
+#include <memory>
+#include <utility>
+
+#include "common/common/lock_guard.h"
+#include "common/common/macros.h"
+#include "common/common/thread.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Runtime {
+
+namespace {
+
+struct Registry {
+  Thread::MutexBasicLockable mutex_;
+  // The registration of each key, as long as a handle to it exists.
+  absl::flat_hash_map<std::string, std::weak_ptr<const KeyHandle::Registration>>
+      registrations_ ABSL_GUARDED_BY(mutex_);
+  // The name and the id of the registration of the key at each index. The id of a released index
+  // is 0.
+  std::vector<std::pair<std::string, uint64_t>> keys_ ABSL_GUARDED_BY(mutex_);
+  std::vector<uint32_t> released_indexes_ ABSL_GUARDED_BY(mutex_);
+  uint64_t next_id_ ABSL_GUARDED_BY(mutex_){1};
+};
+
+Registry& registry() { MUTABLE_CONSTRUCT_ON_FIRST_USE(Registry); }
+
+void releaseKey(const KeyHandle::Registration* registration) {
+  Registry& keys = registry();
+  {
+    Thread::LockGuard lock(keys.mutex_);
+    // The key may have been registered again since its last handle was destroyed.
+    const auto it = keys.registrations_.find(registration->name_);
+    if (it != keys.registrations_.end() && it->second.expired()) {
+      keys.registrations_.erase(it);
+    }
+    keys.keys_[registration->index_] = {};
+    keys.released_indexes_.push_back(registration->index_);
+  }
+  delete registration;
+}
+
+} // namespace
+
+KeyHandle KeyRegistry::registerKey(absl::string_view name) {
+  Registry& keys = registry();
+  Thread::LockGuard lock(keys.mutex_);
+  std::weak_ptr<const KeyHandle::Registration>& existing = keys.registrations_[name];
+  KeyHandle::RegistrationConstSharedPtr registration = existing.lock();
+  if (registration != nullptr) {
+    return KeyHandle(std::move(registration));
+  }
+
+  uint32_t index;
+  if (keys.released_indexes_.empty()) {
+    index = keys.keys_.size();
+    keys.keys_.emplace_back();
+  } else {
+    index = keys.released_indexes_.back();
+    keys.released_indexes_.pop_back();
+  }
+  const uint64_t id = keys.next_id_++;
+  keys.keys_[index] = {std::string(name), id};
+  registration.reset(new KeyHandle::Registration(name, index, id), releaseKey);
+  existing = registration;
+  return KeyHandle(std::move(registration));
+}
+
+std::vector<KeyRegistry::ResolvedKey> KeyRegistry::resolve(const Snapshot::EntryMap& values) {
+  Registry& keys = registry();
+  Thread::LockGuard lock(keys.mutex_);
+  std::vector<ResolvedKey> entries;
+  entries.reserve(keys.keys_.size());
+  for (const auto& key : keys.keys_) {
+    // Empty keys never match, as for lookups by name.
+    const auto it = key.second == 0 || key.first.empty() ? values.end() : values.find(key.first);
+    entries.push_back({key.second, it == values.end() ? nullptr : &it->second});
+  }
+  return entries;
+}
+
+uint64_t KeyRegistry::size() {
+  Registry& keys = registry();
+  Thread::LockGuard lock(keys.mutex_);
+  return keys.keys_.size() - keys.released_indexes_.size();
+}
+
+} // namespace Runtime
+} // namespace Envoy
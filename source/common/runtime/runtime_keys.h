@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "envoy/runtime/runtime.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Runtime {
+
+/**
+ * Process wide registry of the runtime keys looked up on hot paths. Keys are registered when
+ * loading configuration and stay registered as long as a handle to them exists: registering a key
+ * already registered returns a handle to the same registration, and the index of a key is reused
+ * once its last handle is destroyed. The registry thus only holds the keys of the configuration
+ * currently loaded, however often keys delivered by xDS change.
+ */
+class KeyRegistry {
+public:
+  /**
+   * The entry of a registered key in a snapshot.
+   */
+  struct ResolvedKey {
+    // The id of the registration, 0 if no key was registered at this index.
+    uint64_t id_;
+    // nullptr if the snapshot does not contain the key.
+    const Snapshot::Entry* entry_;
+  };
+
+  /**
+   * Register a runtime key. Thread safe.
+   * @param name supplies the name of the key.
+   * @return KeyHandle the handle to pass to the snapshot lookups.
+   */
+  static KeyHandle registerKey(absl::string_view name);
+
+  /**
+   * Resolve the keys currently registered against the values of a snapshot. Thread safe.
+   * @param values supplies the values of the snapshot.
+   * @return the resolved entry of each registered key, by index.
+   */
+  static std::vector<ResolvedKey> resolve(const Snapshot::EntryMap& values);
+
+  /**
+   * @return uint64_t the number of keys currently registered. Thread safe.
+   */
+  static uint64_t size();
+};
+
+} // namespace Runtime
+} // namespace Envoy
@@ -13,8 +13,10 @@
 #include "common/common/cleanup.h"
 #include "common/common/utility.h"
 #include "common/config/api_version.h"
+#include "common/config/parallel_decoder.h"
 #include "common/config/utility.h"
 #include "common/protobuf/utility.h"
+#include "common/stats/timespan_impl.h"
 
 #include "absl/strings/str_join.h"
 
@@ -23,16 +25,22 @@ namespace Upstream {
 
 CdsApiPtr CdsApiImpl::create(const envoy::config::core::v3::ConfigSource& cds_config,
                              ClusterManager& cm, Stats::Scope& scope,
-                             ProtobufMessage::ValidationVisitor& validation_visitor) {
-  return CdsApiPtr{new CdsApiImpl(cds_config, cm, scope, validation_visitor)};
+                             ProtobufMessage::ValidationVisitor& validation_visitor, Api::Api& api,
+                             uint32_t decode_threads) {
+  return CdsApiPtr{new CdsApiImpl(cds_config, cm, scope, validation_visitor, api, decode_threads)};
 }
 
 CdsApiImpl::CdsApiImpl(const envoy::config::core::v3::ConfigSource& cds_config, ClusterManager& cm,
-                       Stats::Scope& scope, ProtobufMessage::ValidationVisitor& validation_visitor)
+                       Stats::Scope& scope, ProtobufMessage::ValidationVisitor& validation_visitor,
+                       Api::Api& api, uint32_t decode_threads)
     : Envoy::Config::SubscriptionBase<envoy::config::cluster::v3::Cluster>(
           cds_config.resource_api_version()),
       cm_(cm), scope_(scope.createScope("cluster_manager.cds.")),
+      stats_({ALL_CDS_STATS(POOL_HISTOGRAM(*scope_))}), time_source_(api.timeSource()),
       validation_visitor_(validation_visitor) {
+  if (decode_threads > 0) {
+    decode_pool_ = std::make_unique<Config::DecodeThreadPool>(api.threadFactory(), decode_threads);
+  }
   const auto resource_name = getResourceName();
   subscription_ = cm_.subscriptionFactory().subscriptionFromConfigSource(
       cds_config, Grpc::Common::typeUrl(resource_name), *scope_, *this);
@@ -40,31 +48,50 @@ CdsApiImpl::CdsApiImpl(const envoy::config::core::v3::ConfigSource& cds_config,
 
 void CdsApiImpl::onConfigUpdate(const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources,
                                 const std::string& version_info) {
+  Stats::HistogramCompletableTimespanImpl decode_timespan(stats_.update_decode_time_, time_source_);
+  const std::vector<DecodedCluster> clusters =
+      Config::ParallelDecoder::decodeResources<envoy::config::cluster::v3::Cluster>(
+          decode_pool_.get(), resources);
+  decode_timespan.complete();
+
   ClusterManager::ClusterInfoMap clusters_to_remove = cm_.clusters();
-  std::vector<envoy::config::cluster::v3::Cluster> clusters;
-  for (const auto& cluster_blob : resources) {
-    // No validation needed here the overloaded call to onConfigUpdate validates.
-    clusters.push_back(MessageUtil::anyConvert<envoy::config::cluster::v3::Cluster>(cluster_blob));
-    clusters_to_remove.erase(clusters.back().name());
+  for (const auto& cluster : clusters) {
+    if (cluster.unpack_error_.has_value()) {
+      throw EnvoyException(cluster.unpack_error_.value());
+    }
+    clusters_to_remove.erase(cluster.message_.name());
   }
   Protobuf::RepeatedPtrField<std::string> to_remove_repeated;
   for (const auto& cluster : clusters_to_remove) {
     *to_remove_repeated.Add() = cluster.first;
   }
-  Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource> to_add_repeated;
-  for (const auto& cluster : clusters) {
-    envoy::service::discovery::v3::Resource* to_add = to_add_repeated.Add();
-    to_add->set_name(cluster.name());
-    to_add->set_version(version_info);
-    to_add->mutable_resource()->PackFrom(cluster);
-  }
-  onConfigUpdate(to_add_repeated, to_remove_repeated, version_info);
+  applyUpdate(
+      clusters, [&version_info](size_t) -> const std::string& { return version_info; },
+      to_remove_repeated, version_info);
 }
 
 void CdsApiImpl::onConfigUpdate(
     const Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource>& added_resources,
     const Protobuf::RepeatedPtrField<std::string>& removed_resources,
     const std::string& system_version_info) {
+  Stats::HistogramCompletableTimespanImpl decode_timespan(stats_.update_decode_time_, time_source_);
+  const std::vector<DecodedCluster> clusters =
+      Config::ParallelDecoder::decodeResources<envoy::config::cluster::v3::Cluster>(
+          decode_pool_.get(), added_resources);
+  decode_timespan.complete();
+
+  applyUpdate(
+      clusters,
+      [&added_resources](size_t index) -> const std::string& {
+        return added_resources[index].version();
+      },
+      removed_resources, system_version_info);
+}
+
+void CdsApiImpl::applyUpdate(const std::vector<DecodedCluster>& added_clusters,
+                             const std::function<const std::string&(size_t)>& cluster_version,
+                             const Protobuf::RepeatedPtrField<std::string>& removed_resources,
+                             const std::string& system_version_info) {
   std::unique_ptr<Cleanup> maybe_eds_resume;
   if (cm_.adsMux()) {
     const auto type_url = Config::getTypeUrl<envoy::config::endpoint::v3::ClusterLoadAssignment>(
@@ -74,29 +101,32 @@ void CdsApiImpl::onConfigUpdate(
         std::make_unique<Cleanup>([this, type_url] { cm_.adsMux()->resume(type_url); });
   }
 
-  ENVOY_LOG(info, "cds: add {} cluster(s), remove {} cluster(s)", added_resources.size(),
+  ENVOY_LOG(info, "cds: add {} cluster(s), remove {} cluster(s)", added_clusters.size(),
             removed_resources.size());
 
+  Stats::HistogramCompletableTimespanImpl apply_timespan(stats_.update_apply_time_, time_source_);
   std::vector<std::string> exception_msgs;
   std::unordered_set<std::string> cluster_names;
   bool any_applied = false;
-  for (const auto& resource : added_resources) {
-    envoy::config::cluster::v3::Cluster cluster;
+  for (size_t i = 0; i < added_clusters.size(); i++) {
+    std::string cluster_name;
     try {
-      cluster = MessageUtil::anyConvertAndValidate<envoy::config::cluster::v3::Cluster>(
-          resource.resource(), validation_visitor_);
+      // Only the checks depending on the runtime and the validation visitor are left to do here.
+      Config::ParallelDecoder::checkResource(added_clusters[i], validation_visitor_);
+      const envoy::config::cluster::v3::Cluster& cluster = added_clusters[i].message_;
+      cluster_name = cluster.name();
       if (!cluster_names.insert(cluster.name()).second) {
         // NOTE: at this point, the first of these duplicates has already been successfully applied.
         throw EnvoyException(fmt::format("duplicate cluster {} found", cluster.name()));
       }
-      if (cm_.addOrUpdateCluster(cluster, resource.version())) {
+      if (cm_.addOrUpdateCluster(cluster, cluster_version(i))) {
         any_applied = true;
         ENVOY_LOG(info, "cds: add/update cluster '{}'", cluster.name());
       } else {
         ENVOY_LOG(debug, "cds: add/update cluster '{}' skipped", cluster.name());
       }
     } catch (const EnvoyException& e) {
-      exception_msgs.push_back(fmt::format("{}: {}", cluster.name(), e.what()));
+      exception_msgs.push_back(fmt::format("{}: {}", cluster_name, e.what()));
     }
   }
   for (const auto& resource_name : removed_resources) {
@@ -105,6 +135,7 @@ void CdsApiImpl::onConfigUpdate(
       ENVOY_LOG(info, "cds: remove cluster '{}'", resource_name);
     }
   }
+  apply_timespan.complete();
 
   if (any_applied) {
     system_version_info_ = system_version_info;
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <functional>
+#include <string>
+#include <vector>
 
 #include "envoy/api/api.h"
+#include "envoy/common/time.h"
 #include "envoy/config/cluster/v3/cluster.pb.h"
 #include "envoy/config/core/v3/config_source.pb.h"
 #include "envoy/config/subscription.h"
@@ -10,14 +13,30 @@
 #include "envoy/local_info/local_info.h"
 #include "envoy/service/discovery/v3/discovery.pb.h"
 #include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
 #include "envoy/upstream/cluster_manager.h"
 
 #include "common/common/logger.h"
+#include "common/config/parallel_decoder.h"
 #include "common/config/subscription_base.h"
 
 namespace Envoy {
 namespace Upstream {
 
+/**
+ * All CDS stats. @see stats_macros.h
+ */
+#define ALL_CDS_STATS(HISTOGRAM)                                                                   \
+  HISTOGRAM(update_decode_time, Milliseconds)                                                      \
+  HISTOGRAM(update_apply_time, Milliseconds)
+
+/**
+ * Struct definition for all CDS stats. @see stats_macros.h
+ */
+struct CdsStats {
+  ALL_CDS_STATS(GENERATE_HISTOGRAM_STRUCT)
+};
+
 /**
  * CDS API implementation that fetches via Subscription.
  */
@@ -27,7 +46,8 @@ class CdsApiImpl : public CdsApi,
 public:
   static CdsApiPtr create(const envoy::config::core::v3::ConfigSource& cds_config,
                           ClusterManager& cm, Stats::Scope& scope,
-                          ProtobufMessage::ValidationVisitor& validation_visitor);
+                          ProtobufMessage::ValidationVisitor& validation_visitor, Api::Api& api,
+                          uint32_t decode_threads);
 
   // Upstream::CdsApi
   void initialize() override { subscription_->start({}); }
@@ -50,7 +70,14 @@ private:
     return MessageUtil::anyConvert<envoy::config::cluster::v3::Cluster>(resource).name();
   }
   CdsApiImpl(const envoy::config::core::v3::ConfigSource& cds_config, ClusterManager& cm,
-             Stats::Scope& scope, ProtobufMessage::ValidationVisitor& validation_visitor);
+             Stats::Scope& scope, ProtobufMessage::ValidationVisitor& validation_visitor,
+             Api::Api& api, uint32_t decode_threads);
+  using DecodedCluster = Config::DecodedResource<envoy::config::cluster::v3::Cluster>;
+
+  void applyUpdate(const std::vector<DecodedCluster>& added_clusters,
+                   const std::function<const std::string&(size_t)>& cluster_version,
+                   const Protobuf::RepeatedPtrField<std::string>& removed_resources,
+                   const std::string& system_version_info);
   void runInitializeCallbackIfAny();
 
   ClusterManager& cm_;
@@ -58,7 +85,11 @@ private:
   std::string system_version_info_;
   std::function<void()> initialize_callback_;
   Stats::ScopePtr scope_;
+  CdsStats stats_;
+  TimeSource& time_source_;
   ProtobufMessage::ValidationVisitor& validation_visitor_;
+  // Decodes the resources of large updates in parallel, nullptr if they are decoded serially.
+  Config::DecodeThreadPoolPtr decode_pool_;
 };
 
 } // namespace Upstream
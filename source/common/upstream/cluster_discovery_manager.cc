@@ -0,0 +1,35 @@
+#include "common/upstream/cluster_discovery_manager.h"
+
+namespace Envoy {
+namespace Upstream {
+
+ClusterDiscoveryManager::AddedCallbackData
+ClusterDiscoveryManager::addCallback(const std::string& name,
+                                     ClusterDiscoveryCallbackPtr callback) {
+  auto entry = std::make_shared<CallbackEntry>(CallbackEntry{std::move(callback)});
+  auto result = pending_clusters_.try_emplace(name);
+  result.first->second.push_back(entry);
+  return {std::make_unique<ClusterDiscoveryCallbackHandleImpl>(std::move(entry)), !result.second};
+}
+
+void ClusterDiscoveryManager::processClusterName(absl::string_view name,
+                                                 ClusterDiscoveryStatus status) {
+  auto it = pending_clusters_.find(name);
+  if (it == pending_clusters_.end()) {
+    return;
+  }
+  // The entries are taken out first, as the callbacks may request new discoveries.
+  std::vector<CallbackEntrySharedPtr> entries = std::move(it->second);
+  pending_clusters_.erase(it);
+  for (const CallbackEntrySharedPtr& entry : entries) {
+    // The callback may have been discarded, possibly by another callback.
+    if (entry->callback_ == nullptr) {
+      continue;
+    }
+    ClusterDiscoveryCallbackPtr callback = std::move(entry->callback_);
+    (*callback)(status);
+  }
+}
+
+} // namespace Upstream
+} // namespace Envoy
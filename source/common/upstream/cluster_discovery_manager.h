@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/upstream/cluster_manager.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Upstream {
+
+/**
+ * Thread local bookkeeping of the on-demand cluster discoveries requested on a thread. The
+ * callbacks of the requests are kept per cluster name until the cluster manager reports the outcome
+ * of the discovery of the cluster on this thread.
+ */
+class ClusterDiscoveryManager {
+public:
+  struct AddedCallbackData {
+    ClusterDiscoveryCallbackHandlePtr handle_ptr_;
+    // Whether a discovery of the cluster was already requested from this thread, in which case
+    // the new callback shares it.
+    bool discovery_in_progress_;
+  };
+
+  /**
+   * Keep the callback of a discovery until the outcome of the discovery of the cluster is known.
+   */
+  AddedCallbackData addCallback(const std::string& name, ClusterDiscoveryCallbackPtr callback);
+
+  /**
+   * Invoke, and forget, the callbacks waiting for the discovery of the cluster. Callbacks may
+   * request discoveries, including of the same cluster.
+   */
+  void processClusterName(absl::string_view name, ClusterDiscoveryStatus status);
+
+private:
+  // Shared between the pending discovery and the handle of the callback, which discards the
+  // callback on destruction.
+  struct CallbackEntry {
+    ClusterDiscoveryCallbackPtr callback_;
+  };
+  using CallbackEntrySharedPtr = std::shared_ptr<CallbackEntry>;
+
+  struct ClusterDiscoveryCallbackHandleImpl : public ClusterDiscoveryCallbackHandle {
+    explicit ClusterDiscoveryCallbackHandleImpl(CallbackEntrySharedPtr entry)
+        : entry_(std::move(entry)) {}
+    ~ClusterDiscoveryCallbackHandleImpl() override { entry_->callback_.reset(); }
+
+    const CallbackEntrySharedPtr entry_;
+  };
+
+  absl::flat_hash_map<std::string, std::vector<CallbackEntrySharedPtr>> pending_clusters_;
+};
+
+} // namespace Upstream
+} // namespace Envoy
@@ -240,6 +240,7 @@ ClusterManagerImpl::ClusterManagerImpl(
     Http::Context& http_context, Grpc::Context& grpc_context)
     : factory_(factory), runtime_(runtime), stats_(stats), tls_(tls.allocateSlot()),
       random_(random), bind_config_(bootstrap.cluster_manager().upstream_bind_config()),
+      lazy_cluster_stats_(bootstrap.cluster_manager().lazy_cluster_stats()),
       local_info_(local_info), cm_stats_(generateStats(stats)),
       init_helper_(*this, [this](Cluster& cluster) { onClusterInit(cluster); }),
       config_tracker_entry_(
@@ -368,7 +369,9 @@ ClusterManagerImpl::ClusterManagerImpl(
 
   // We can now potentially create the CDS API once the backing cluster exists.
   if (dyn_resources.has_cds_config()) {
-    cds_api_ = factory_.createCds(dyn_resources.cds_config(), *this);
+    cds_api_ = factory_.createCds(
+        dyn_resources.cds_config(), *this,
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(dyn_resources, resource_decode_threads, 0));
     init_helper_.setCds(cds_api_.get());
   } else {
     init_helper_.setCds(nullptr);
@@ -648,10 +651,11 @@ bool ClusterManagerImpl::addOrUpdateCluster(const envoy::config::cluster::v3::Cl
 }
 
 void ClusterManagerImpl::createOrUpdateThreadLocalCluster(ClusterData& cluster) {
-  tls_->runOnAllThreads([this, new_cluster = cluster.cluster_->info(),
-                         thread_aware_lb_factory = cluster.loadBalancerFactory()]() -> void {
+  postThreadLocalClusterUpdates();
+  tls_->runOnAllThreads([this, snapshot = cluster.thread_local_snapshot_]() -> void {
     ThreadLocalClusterManagerImpl& cluster_manager =
         tls_->getTyped<ThreadLocalClusterManagerImpl>();
+    const ClusterInfoConstSharedPtr& new_cluster = snapshot->cluster_info_;
 
     if (cluster_manager.thread_local_clusters_.count(new_cluster->name()) > 0) {
       ENVOY_LOG(debug, "updating TLS cluster {}", new_cluster->name());
@@ -659,13 +663,18 @@ void ClusterManagerImpl::createOrUpdateThreadLocalCluster(ClusterData& cluster)
       ENVOY_LOG(debug, "adding TLS cluster {}", new_cluster->name());
     }
 
-    auto thread_local_cluster = new ThreadLocalClusterManagerImpl::ClusterEntry(
-        cluster_manager, new_cluster, thread_aware_lb_factory);
+    auto thread_local_cluster =
+        new ThreadLocalClusterManagerImpl::ClusterEntry(cluster_manager, snapshot);
     cluster_manager.thread_local_clusters_[new_cluster->name()].reset(thread_local_cluster);
     for (auto& cb : cluster_manager.update_callbacks_) {
       cb->onClusterAddOrUpdate(*thread_local_cluster);
     }
+    // Requests waiting for the discovery of the cluster can now use it.
+    cluster_manager.cluster_discovery_manager_.processClusterName(
+        new_cluster->name(), ClusterDiscoveryStatus::Available);
   });
+  // The discovery completes with the above, if the cluster was being discovered.
+  pending_cluster_discoveries_.erase(cluster.cluster_->info()->name());
 }
 
 bool ClusterManagerImpl::removeCluster(const std::string& cluster_name) {
@@ -678,6 +687,7 @@ bool ClusterManagerImpl::removeCluster(const std::string& cluster_name) {
     active_clusters_.erase(existing_active_cluster);
 
     ENVOY_LOG(info, "removing cluster {}", cluster_name);
+    postThreadLocalClusterUpdates();
     tls_->runOnAllThreads([this, cluster_name]() -> void {
       ThreadLocalClusterManagerImpl& cluster_manager =
           tls_->getTyped<ThreadLocalClusterManagerImpl>();
@@ -782,6 +792,10 @@ void ClusterManagerImpl::loadCluster(const envoy::config::cluster::v3::Cluster&
     cluster_entry_it->second->thread_aware_lb_ = std::move(new_cluster_pair.second);
   }
 
+  // The workers only get the hosts once the cluster is initialized.
+  cluster_entry_it->second->thread_local_snapshot_ = std::make_shared<ThreadLocalClusterSnapshot>(
+      cluster_reference.info(), cluster_entry_it->second->loadBalancerFactory());
+
   updateClusterCounts();
 }
 
@@ -852,6 +866,7 @@ ClusterManagerImpl::tcpConnPoolForCluster(const std::string& cluster, ResourcePr
 
 void ClusterManagerImpl::postThreadLocalDrainConnections(const Cluster& cluster,
                                                          const HostVector& hosts_removed) {
+  postThreadLocalClusterUpdates();
   tls_->runOnAllThreads([this, name = cluster.info()->name(), hosts_removed]() {
     ThreadLocalClusterManagerImpl::removeHosts(name, hosts_removed, *tls_);
   });
@@ -860,19 +875,69 @@ void ClusterManagerImpl::postThreadLocalDrainConnections(const Cluster& cluster,
 void ClusterManagerImpl::postThreadLocalClusterUpdate(const Cluster& cluster, uint32_t priority,
                                                       const HostVector& hosts_added,
                                                       const HostVector& hosts_removed) {
+  const std::string& name = cluster.info()->name();
+  auto cluster_data = active_clusters_.find(name);
+  ASSERT(cluster_data != active_clusters_.end() &&
+         cluster_data->second->cluster_.get() == &cluster);
   const auto& host_set = cluster.prioritySet().hostSetsPerPriority()[priority];
+  const ThreadLocalClusterSnapshot::HostSet new_host_set{HostSetImpl::updateHostsParams(*host_set),
+                                                         host_set->localityWeights(),
+                                                         host_set->overprovisioningFactor()};
+
+  // Workers which do not use the cluster yet only keep the latest hosts of all priorities. The
+  // snapshot is copied once per batch, unless the cluster was replaced since, and then updated in
+  // place until the batch is posted.
+  ThreadLocalClusterSnapshotSharedPtr& snapshot = pending_thread_local_updates_.snapshots_[name];
+  if (snapshot == nullptr || snapshot != cluster_data->second->thread_local_snapshot_) {
+    snapshot =
+        std::make_shared<ThreadLocalClusterSnapshot>(*cluster_data->second->thread_local_snapshot_);
+    cluster_data->second->thread_local_snapshot_ = snapshot;
+  }
+  if (snapshot->host_sets_.size() <= priority) {
+    snapshot->host_sets_.resize(priority + 1);
+  }
+  snapshot->host_sets_[priority] = new_host_set;
+
+  // Workers which use the cluster replay the updates. An update which neither adds nor removes
+  // hosts is merged with the pending update of the same priority if any, like merged updates are.
+  std::vector<ThreadLocalClusterUpdate>& updates = pending_thread_local_updates_.updates_;
+  auto pending_update =
+      pending_thread_local_update_index_.try_emplace({name, priority}, updates.size());
+  if (!pending_update.second && hosts_added.empty() && hosts_removed.empty()) {
+    updates[pending_update.first->second].host_set_ = new_host_set;
+  } else {
+    pending_update.first->second = updates.size();
+    updates.push_back({name, priority, new_host_set, hosts_added, hosts_removed});
+  }
+
+  if (!*thread_local_updates_scheduled_) {
+    *thread_local_updates_scheduled_ = true;
+    dispatcher_.post([this, scheduled = std::weak_ptr<bool>(thread_local_updates_scheduled_)]() {
+      if (scheduled.expired()) {
+        return;
+      }
+      *thread_local_updates_scheduled_ = false;
+      postThreadLocalClusterUpdates();
+    });
+  }
+}
+
+void ClusterManagerImpl::postThreadLocalClusterUpdates() {
+  if (pending_thread_local_updates_.updates_.empty()) {
+    return;
+  }
 
-  tls_->runOnAllThreads([this, name = cluster.info()->name(), priority,
-                         update_params = HostSetImpl::updateHostsParams(*host_set),
-                         locality_weights = host_set->localityWeights(), hosts_added, hosts_removed,
-                         overprovisioning_factor = host_set->overprovisioningFactor()]() {
-    ThreadLocalClusterManagerImpl::updateClusterMembership(
-        name, priority, update_params, locality_weights, hosts_added, hosts_removed, *tls_,
-        overprovisioning_factor);
+  auto batch = std::make_shared<const ThreadLocalClusterUpdateBatch>(
+      std::move(pending_thread_local_updates_));
+  pending_thread_local_updates_ = {};
+  pending_thread_local_update_index_.clear();
+  tls_->runOnAllThreads([this, batch]() -> void {
+    tls_->getTyped<ThreadLocalClusterManagerImpl>().updateClusterMembership(*batch);
   });
 }
 
 void ClusterManagerImpl::postThreadLocalHealthFailure(const HostSharedPtr& host) {
+  postThreadLocalClusterUpdates();
   tls_->runOnAllThreads(
       [this, host] { ThreadLocalClusterManagerImpl::onHostHealthFailure(host, *tls_); });
 }
@@ -886,7 +951,7 @@ Host::CreateConnectionData ClusterManagerImpl::tcpConnForCluster(const std::stri
     throw EnvoyException(fmt::format("unknown cluster '{}'", cluster));
   }
 
-  HostConstSharedPtr logical_host = entry->second->lb_->chooseHost(context);
+  HostConstSharedPtr logical_host = entry->second->state().lb_->chooseHost(context);
   if (logical_host) {
     auto conn_info = logical_host->createConnection(
         cluster_manager.thread_local_dispatcher_, nullptr,
@@ -910,7 +975,7 @@ Http::AsyncClient& ClusterManagerImpl::httpAsyncClientForCluster(const std::stri
   ThreadLocalClusterManagerImpl& cluster_manager = tls_->getTyped<ThreadLocalClusterManagerImpl>();
   auto entry = cluster_manager.thread_local_clusters_.find(cluster);
   if (entry != cluster_manager.thread_local_clusters_.end()) {
-    return entry->second->http_async_client_;
+    return entry->second->state().http_async_client_;
   } else {
     throw EnvoyException(fmt::format("unknown cluster '{}'", cluster));
   }
@@ -922,6 +987,83 @@ ClusterManagerImpl::addThreadLocalClusterUpdateCallbacks(ClusterUpdateCallbacks&
   return std::make_unique<ClusterUpdateCallbacksHandleImpl>(cb, cluster_manager.update_callbacks_);
 }
 
+OdCdsApiHandlePtr
+ClusterManagerImpl::allocateOdCdsApi(const envoy::config::core::v3::ConfigSource& odcds_config,
+                                     std::chrono::milliseconds idle_timeout,
+                                     ProtobufMessage::ValidationVisitor& validation_visitor) {
+  return std::make_unique<OdCdsApiHandleImpl>(
+      *this, OdCdsApiImpl::create(odcds_config, idle_timeout, *this, *this, dispatcher_, stats_,
+                                  validation_visitor));
+}
+
+ClusterManagerImpl::OdCdsApiHandleImpl::~OdCdsApiHandleImpl() {
+  // The subscription may only be used, and thus destroyed, on the main thread, while the handle
+  // may be owned by filters living on workers.
+  parent_.dispatcher_.post([odcds = std::move(odcds_)]() {});
+}
+
+ClusterDiscoveryCallbackHandlePtr ClusterManagerImpl::requestOnDemandClusterDiscovery(
+    OdCdsApiSharedPtr odcds, const std::string& name, ClusterDiscoveryCallbackPtr callback,
+    std::chrono::milliseconds timeout) {
+  ThreadLocalClusterManagerImpl& cluster_manager = tls_->getTyped<ThreadLocalClusterManagerImpl>();
+  if (cluster_manager.thread_local_clusters_.count(name) > 0) {
+    (*callback)(ClusterDiscoveryStatus::Available);
+    return nullptr;
+  }
+
+  ClusterDiscoveryManager::AddedCallbackData added =
+      cluster_manager.cluster_discovery_manager_.addCallback(name, std::move(callback));
+  if (added.discovery_in_progress_) {
+    ENVOY_LOG(debug, "on-demand discovery of cluster {} is already in progress", name);
+    return std::move(added.handle_ptr_);
+  }
+
+  dispatcher_.post([this, odcds = std::move(odcds), name, timeout]() -> void {
+    if (pending_cluster_discoveries_.count(name) > 0) {
+      // Another thread requested the cluster first.
+      return;
+    }
+    if (active_clusters_.count(name) > 0) {
+      // The cluster became active since the request, and is on its way to all threads. This
+      // completes the discovery right after it got to the thread which requested it.
+      tls_->runOnAllThreads([this, name]() -> void {
+        tls_->getTyped<ThreadLocalClusterManagerImpl>()
+            .cluster_discovery_manager_.processClusterName(name,
+                                                           ClusterDiscoveryStatus::Available);
+      });
+      return;
+    }
+    ENVOY_LOG(debug, "starting on-demand discovery of cluster {}", name);
+    Event::TimerPtr timer = dispatcher_.createTimer([this, name]() -> void {
+      ENVOY_LOG(debug, "on-demand discovery of cluster {} timed out", name);
+      notifyClusterDiscoveryStatus(name, ClusterDiscoveryStatus::Timeout);
+    });
+    timer->enableTimer(timeout);
+    pending_cluster_discoveries_.emplace(name, std::move(timer));
+    odcds->updateOnDemand(name);
+  });
+  return std::move(added.handle_ptr_);
+}
+
+void ClusterManagerImpl::notifyMissingCluster(absl::string_view name) {
+  notifyClusterDiscoveryStatus(std::string(name), ClusterDiscoveryStatus::Missing);
+}
+
+void ClusterManagerImpl::notifyClusterDiscoveryStatus(std::string name,
+                                                      ClusterDiscoveryStatus status) {
+  auto it = pending_cluster_discoveries_.find(name);
+  if (it == pending_cluster_discoveries_.end()) {
+    return;
+  }
+  // This may be called from the callback of the timer, which is thus only destroyed on return.
+  const Event::TimerPtr timer = std::move(it->second);
+  pending_cluster_discoveries_.erase(it);
+  tls_->runOnAllThreads([this, name = std::move(name), status]() -> void {
+    tls_->getTyped<ThreadLocalClusterManagerImpl>().cluster_discovery_manager_.processClusterName(
+        name, status);
+  });
+}
+
 ProtobufTypes::MessagePtr ClusterManagerImpl::dumpClusterConfigs() {
   auto config_dump = std::make_unique<envoy::admin::v3::ClustersConfigDump>();
   config_dump->set_version_info(cds_api_ != nullptr ? cds_api_->versionInfo() : "");
@@ -961,14 +1103,12 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ThreadLocalClusterManagerImpl
   if (local_cluster_name) {
     ENVOY_LOG(debug, "adding TLS local cluster {}", local_cluster_name.value());
     auto& local_cluster = parent.active_clusters_.at(local_cluster_name.value());
-    thread_local_clusters_[local_cluster_name.value()] = std::make_unique<ClusterEntry>(
-        *this, local_cluster->cluster_->info(), local_cluster->loadBalancerFactory());
+    auto& local_entry = thread_local_clusters_[local_cluster_name.value()];
+    local_entry = std::make_unique<ClusterEntry>(*this, local_cluster->thread_local_snapshot_);
+    // The load balancers of the other clusters may depend on the hosts of the local cluster.
+    local_priority_set_ = &local_entry->state().priority_set_;
   }
 
-  local_priority_set_ = local_cluster_name
-                            ? &thread_local_clusters_[local_cluster_name.value()]->priority_set_
-                            : nullptr;
-
   for (auto& cluster : parent.active_clusters_) {
     // If local cluster name is set then we already initialized this cluster.
     if (local_cluster_name && local_cluster_name.value() == cluster.first) {
@@ -977,8 +1117,8 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ThreadLocalClusterManagerImpl
 
     ENVOY_LOG(debug, "adding TLS initial cluster {}", cluster.first);
     ASSERT(thread_local_clusters_.count(cluster.first) == 0);
-    thread_local_clusters_[cluster.first] = std::make_unique<ClusterEntry>(
-        *this, cluster.second->cluster_->info(), cluster.second->loadBalancerFactory());
+    thread_local_clusters_[cluster.first] =
+        std::make_unique<ClusterEntry>(*this, cluster.second->thread_local_snapshot_);
   }
 }
 
@@ -993,7 +1133,8 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::~ThreadLocalClusterManagerImp
   host_tcp_conn_pool_map_.clear();
   ASSERT(host_tcp_conn_map_.empty());
   for (auto& cluster : thread_local_clusters_) {
-    if (&cluster.second->priority_set_ != local_priority_set_) {
+    if (cluster.second->state_ == nullptr ||
+        &cluster.second->state_->priority_set_ != local_priority_set_) {
       cluster.second.reset();
     }
   }
@@ -1126,23 +1267,26 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::removeHosts(const std::s
 }
 
 void ClusterManagerImpl::ThreadLocalClusterManagerImpl::updateClusterMembership(
-    const std::string& name, uint32_t priority, PrioritySet::UpdateHostsParams update_hosts_params,
-    LocalityWeightsConstSharedPtr locality_weights, const HostVector& hosts_added,
-    const HostVector& hosts_removed, ThreadLocal::Slot& tls, uint64_t overprovisioning_factor) {
-  ThreadLocalClusterManagerImpl& config = tls.getTyped<ThreadLocalClusterManagerImpl>();
-
-  ASSERT(config.thread_local_clusters_.find(name) != config.thread_local_clusters_.end());
-  const auto& cluster_entry = config.thread_local_clusters_[name];
-  ENVOY_LOG(debug, "membership update for TLS cluster {} added {} removed {}", name,
-            hosts_added.size(), hosts_removed.size());
-  cluster_entry->priority_set_.updateHosts(priority, std::move(update_hosts_params),
-                                           std::move(locality_weights), hosts_added, hosts_removed,
-                                           overprovisioning_factor);
-
-  // If an LB is thread aware, create a new worker local LB on membership changes.
-  if (cluster_entry->lb_factory_ != nullptr) {
-    ENVOY_LOG(debug, "re-creating local LB for TLS cluster {}", name);
-    cluster_entry->lb_ = cluster_entry->lb_factory_->create();
+    const ThreadLocalClusterUpdateBatch& batch) {
+  for (const ThreadLocalClusterUpdate& update : batch.updates_) {
+    ASSERT(thread_local_clusters_.find(update.name_) != thread_local_clusters_.end());
+    const auto& cluster_entry = thread_local_clusters_[update.name_];
+    if (cluster_entry->state_ == nullptr) {
+      continue;
+    }
+    ENVOY_LOG(debug, "membership update for TLS cluster {} added {} removed {}", update.name_,
+              update.hosts_added_.size(), update.hosts_removed_.size());
+    cluster_entry->updateHosts(update.priority_, update.host_set_, update.hosts_added_,
+                               update.hosts_removed_);
+  }
+
+  // The clusters not used yet only keep the latest hosts.
+  for (const auto& snapshot : batch.snapshots_) {
+    ASSERT(thread_local_clusters_.find(snapshot.first) != thread_local_clusters_.end());
+    const auto& cluster_entry = thread_local_clusters_[snapshot.first];
+    if (cluster_entry->state_ == nullptr) {
+      cluster_entry->snapshot_ = snapshot.second;
+    }
   }
 }
 
@@ -1210,21 +1354,49 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::getHttpConnPoolsContainer(
 }
 
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::ClusterEntry(
-    ThreadLocalClusterManagerImpl& parent, ClusterInfoConstSharedPtr cluster,
-    const LoadBalancerFactorySharedPtr& lb_factory)
-    : parent_(parent), lb_factory_(lb_factory), cluster_info_(cluster),
-      http_async_client_(cluster, parent.parent_.stats_, parent.thread_local_dispatcher_,
-                         parent.parent_.local_info_, parent.parent_, parent.parent_.runtime_,
-                         parent.parent_.random_,
-                         Router::ShadowWriterPtr{new Router::ShadowWriterImpl(parent.parent_)},
-                         parent_.parent_.http_context_) {
+    ThreadLocalClusterManagerImpl& parent, ThreadLocalClusterSnapshotConstSharedPtr snapshot)
+    : parent_(parent), cluster_info_(snapshot->cluster_info_), snapshot_(std::move(snapshot)) {}
+
+ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::State&
+ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::state() {
+  if (state_ == nullptr) {
+    ENVOY_LOG(debug, "creating load balancing state of TLS cluster {}", cluster_info_->name());
+    state_ = std::make_unique<State>(*this, *snapshot_);
+    snapshot_.reset();
+  }
+  return *state_;
+}
+
+ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::State::State(
+    ClusterEntry& entry, const ThreadLocalClusterSnapshot& snapshot)
+    : lb_factory_(snapshot.lb_factory_),
+      http_async_client_(
+          entry.cluster_info_, entry.parent_.parent_.stats_, entry.parent_.thread_local_dispatcher_,
+          entry.parent_.parent_.local_info_, entry.parent_.parent_, entry.parent_.parent_.runtime_,
+          entry.parent_.parent_.random_,
+          Router::ShadowWriterPtr{new Router::ShadowWriterImpl(entry.parent_.parent_)},
+          entry.parent_.parent_.http_context_) {
+  ThreadLocalClusterManagerImpl& parent = entry.parent_;
+  const ClusterInfoConstSharedPtr& cluster = entry.cluster_info_;
+
+  // Start from the latest hosts. The load balancer is created after, so that it is built once.
   priority_set_.getOrCreateHostSet(0);
+  for (uint32_t priority = 0; priority < snapshot.host_sets_.size(); priority++) {
+    const ThreadLocalClusterSnapshot::HostSet& host_set = snapshot.host_sets_[priority];
+    if (host_set.update_hosts_params_.hosts == nullptr) {
+      continue;
+    }
+    priority_set_.updateHosts(
+        priority, PrioritySet::UpdateHostsParams(host_set.update_hosts_params_),
+        host_set.locality_weights_, *host_set.update_hosts_params_.hosts, {},
+        host_set.overprovisioning_factor_);
+  }
 
   // TODO(mattklein123): Consider converting other LBs over to thread local. All of them could
   // benefit given the healthy panic, locality, and priority calculations that take place.
   if (cluster->lbSubsetInfo().isEnabled()) {
     lb_ = std::make_unique<SubsetLoadBalancer>(
-        cluster->lbType(), priority_set_, parent_.local_priority_set_, cluster->stats(),
+        cluster->lbType(), priority_set_, parent.local_priority_set_, cluster->stats(),
         cluster->statsScope(), parent.parent_.runtime_, parent.parent_.random_,
         cluster->lbSubsetInfo(), cluster->lbRingHashConfig(), cluster->lbLeastRequestConfig(),
         cluster->lbConfig());
@@ -1233,20 +1405,20 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::ClusterEntry(
     case LoadBalancerType::LeastRequest: {
       ASSERT(lb_factory_ == nullptr);
       lb_ = std::make_unique<LeastRequestLoadBalancer>(
-          priority_set_, parent_.local_priority_set_, cluster->stats(), parent.parent_.runtime_,
+          priority_set_, parent.local_priority_set_, cluster->stats(), parent.parent_.runtime_,
           parent.parent_.random_, cluster->lbConfig(), cluster->lbLeastRequestConfig());
       break;
     }
     case LoadBalancerType::Random: {
       ASSERT(lb_factory_ == nullptr);
-      lb_ = std::make_unique<RandomLoadBalancer>(priority_set_, parent_.local_priority_set_,
+      lb_ = std::make_unique<RandomLoadBalancer>(priority_set_, parent.local_priority_set_,
                                                  cluster->stats(), parent.parent_.runtime_,
                                                  parent.parent_.random_, cluster->lbConfig());
       break;
     }
     case LoadBalancerType::RoundRobin: {
       ASSERT(lb_factory_ == nullptr);
-      lb_ = std::make_unique<RoundRobinLoadBalancer>(priority_set_, parent_.local_priority_set_,
+      lb_ = std::make_unique<RoundRobinLoadBalancer>(priority_set_, parent.local_priority_set_,
                                                      cluster->stats(), parent.parent_.runtime_,
                                                      parent.parent_.random_, cluster->lbConfig());
       break;
@@ -1263,6 +1435,21 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::ClusterEntry(
   }
 }
 
+void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::updateHosts(
+    uint32_t priority, const ThreadLocalClusterSnapshot::HostSet& host_set,
+    const HostVector& hosts_added, const HostVector& hosts_removed) {
+  ASSERT(state_ != nullptr);
+  state_->priority_set_.updateHosts(
+      priority, PrioritySet::UpdateHostsParams(host_set.update_hosts_params_),
+      host_set.locality_weights_, hosts_added, hosts_removed, host_set.overprovisioning_factor_);
+
+  // If an LB is thread aware, create a new worker local LB on membership changes.
+  if (state_->lb_factory_ != nullptr) {
+    ENVOY_LOG(debug, "re-creating local LB for TLS cluster {}", cluster_info_->name());
+    state_->lb_ = state_->lb_factory_->create();
+  }
+}
+
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::~ClusterEntry() {
   // We need to drain all connection pools for the cluster being removed. Then we can remove the
   // cluster.
@@ -1270,7 +1457,10 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::~ClusterEntry()
   // TODO(mattklein123): Optimally, we would just fire member changed callbacks and remove all of
   // the hosts inside of the HostImpl destructor. That is a change with wide implications, so we are
   // going with a more targeted approach for now.
-  for (auto& host_set : priority_set_.hostSetsPerPriority()) {
+  if (state_ == nullptr) {
+    return;
+  }
+  for (auto& host_set : state_->priority_set_.hostSetsPerPriority()) {
     parent_.drainConnPools(host_set->hosts());
   }
 }
@@ -1278,7 +1468,7 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::~ClusterEntry()
 Http::ConnectionPool::Instance*
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::connPool(
     ResourcePriority priority, Http::Protocol protocol, LoadBalancerContext* context) {
-  HostConstSharedPtr host = lb_->chooseHost(context);
+  HostConstSharedPtr host = state().lb_->chooseHost(context);
   if (!host) {
     ENVOY_LOG(debug, "no healthy host for HTTP connection pool");
     cluster_info_->stats().upstream_cx_none_healthy_.inc();
@@ -1331,7 +1521,7 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::connPool(
 Tcp::ConnectionPool::Instance*
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::tcpConnPool(
     ResourcePriority priority, LoadBalancerContext* context) {
-  HostConstSharedPtr host = lb_->chooseHost(context);
+  HostConstSharedPtr host = state().lb_->chooseHost(context);
   if (!host) {
     ENVOY_LOG(debug, "no healthy host for TCP connection pool");
     cluster_info_->stats().upstream_cx_none_healthy_.inc();
@@ -1419,9 +1609,10 @@ std::pair<ClusterSharedPtr, ThreadAwareLoadBalancerPtr> ProdClusterManagerFactor
 
 CdsApiPtr
 ProdClusterManagerFactory::createCds(const envoy::config::core::v3::ConfigSource& cds_config,
-                                     ClusterManager& cm) {
+                                     ClusterManager& cm, uint32_t decode_threads) {
   // TODO(htuch): Differentiate static vs. dynamic validation visitors.
-  return CdsApiImpl::create(cds_config, cm, stats_, validation_context_.dynamicValidationVisitor());
+  return CdsApiImpl::create(cds_config, cm, stats_, validation_context_.dynamicValidationVisitor(),
+                            api_, decode_threads);
 }
 
 } // namespace Upstream
@@ -7,6 +7,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "envoy/api/api.h"
@@ -27,7 +28,9 @@
 #include "common/config/grpc_mux_impl.h"
 #include "common/config/subscription_factory_impl.h"
 #include "common/http/async_client_impl.h"
+#include "common/upstream/cluster_discovery_manager.h"
 #include "common/upstream/load_stats_reporter.h"
+#include "common/upstream/od_cds_api_impl.h"
 #include "common/upstream/priority_conn_pool_map.h"
 #include "common/upstream/upstream_impl.h"
 
@@ -70,7 +73,7 @@ public:
   clusterFromProto(const envoy::config::cluster::v3::Cluster& cluster, ClusterManager& cm,
                    Outlier::EventLoggerSharedPtr outlier_event_logger, bool added_via_api) override;
   CdsApiPtr createCds(const envoy::config::core::v3::ConfigSource& cds_config,
-                      ClusterManager& cm) override;
+                      ClusterManager& cm, uint32_t decode_threads) override;
   Secret::SecretManager& secretManager() override { return secret_manager_; }
 
 protected:
@@ -187,7 +190,9 @@ struct ClusterManagerStats {
  * Implementation of ClusterManager that reads from a proto configuration, maintains a central
  * cluster list, as well as thread local caches of each cluster and associated connection pools.
  */
-class ClusterManagerImpl : public ClusterManager, Logger::Loggable<Logger::Id::upstream> {
+class ClusterManagerImpl : public ClusterManager,
+                           public MissingClusterNotifier,
+                           Logger::Loggable<Logger::Id::upstream> {
 public:
   ClusterManagerImpl(const envoy::config::bootstrap::v3::Bootstrap& bootstrap,
                      ClusterManagerFactory& factory, Stats::Store& stats,
@@ -240,10 +245,14 @@ public:
     ads_mux_.reset();
     active_clusters_.clear();
     warming_clusters_.clear();
+    pending_cluster_discoveries_.clear();
+    pending_thread_local_updates_ = {};
+    pending_thread_local_update_index_.clear();
     updateClusterCounts();
   }
 
   const envoy::config::core::v3::BindConfig& bindConfig() const override { return bind_config_; }
+  bool lazyClusterStats() const override { return lazy_cluster_stats_; }
 
   Config::GrpcMuxSharedPtr adsMux() override { return ads_mux_; }
   Grpc::AsyncClientManager& grpcAsyncClientManager() override { return *async_client_manager_; }
@@ -262,7 +271,20 @@ public:
   void
   initializeSecondaryClusters(const envoy::config::bootstrap::v3::Bootstrap& bootstrap) override;
 
+  OdCdsApiHandlePtr
+  allocateOdCdsApi(const envoy::config::core::v3::ConfigSource& odcds_config,
+                   std::chrono::milliseconds idle_timeout,
+                   ProtobufMessage::ValidationVisitor& validation_visitor) override;
+
+  // Upstream::MissingClusterNotifier
+  void notifyMissingCluster(absl::string_view name) override;
+
 protected:
+  ClusterDiscoveryCallbackHandlePtr
+  requestOnDemandClusterDiscovery(OdCdsApiSharedPtr odcds, const std::string& name,
+                                  ClusterDiscoveryCallbackPtr callback,
+                                  std::chrono::milliseconds timeout);
+
   virtual void postThreadLocalDrainConnections(const Cluster& cluster,
                                                const HostVector& hosts_removed);
   virtual void postThreadLocalClusterUpdate(const Cluster& cluster, uint32_t priority,
@@ -270,6 +292,49 @@ protected:
                                             const HostVector& hosts_removed);
 
 private:
+  /**
+   * The hosts of a cluster as last posted to the workers. It is immutable once posted and shared
+   * by all the workers, which only create the load balancing state of the cluster from it once they
+   * use the cluster, so that the clusters a worker never routes to cost it close to nothing.
+   */
+  struct ThreadLocalClusterSnapshot {
+    struct HostSet {
+      PrioritySet::UpdateHostsParams update_hosts_params_;
+      LocalityWeightsConstSharedPtr locality_weights_;
+      uint32_t overprovisioning_factor_{};
+    };
+
+    ThreadLocalClusterSnapshot(ClusterInfoConstSharedPtr cluster_info,
+                               LoadBalancerFactorySharedPtr lb_factory)
+        : cluster_info_(std::move(cluster_info)), lb_factory_(std::move(lb_factory)) {}
+
+    ClusterInfoConstSharedPtr cluster_info_;
+    LoadBalancerFactorySharedPtr lb_factory_;
+    // By priority. The hosts of the priorities which were never updated are null.
+    std::vector<HostSet> host_sets_;
+  };
+
+  using ThreadLocalClusterSnapshotSharedPtr = std::shared_ptr<ThreadLocalClusterSnapshot>;
+  using ThreadLocalClusterSnapshotConstSharedPtr =
+      std::shared_ptr<const ThreadLocalClusterSnapshot>;
+
+  // A membership update of a cluster, applied by the workers which already use the cluster.
+  struct ThreadLocalClusterUpdate {
+    std::string name_;
+    uint32_t priority_;
+    ThreadLocalClusterSnapshot::HostSet host_set_;
+    HostVector hosts_added_;
+    HostVector hosts_removed_;
+  };
+
+  // The membership updates accumulated by the main thread, posted to the workers at once.
+  struct ThreadLocalClusterUpdateBatch {
+    std::vector<ThreadLocalClusterUpdate> updates_;
+    // The latest snapshot of each updated cluster, for the workers which do not use it yet. The
+    // main thread updates them in place until the batch is posted.
+    absl::flat_hash_map<std::string, ThreadLocalClusterSnapshotSharedPtr> snapshots_;
+  };
+
   /**
    * Thread local cached cluster data. Each thread local cluster gets updates from the parent
    * central dynamic cluster (if applicable). It maintains load balancer state and any created
@@ -323,10 +388,30 @@ private:
         std::unordered_map<Network::ClientConnection*, std::unique_ptr<TcpConnContainer>>;
 
     struct ClusterEntry : public ThreadLocalCluster {
-      ClusterEntry(ThreadLocalClusterManagerImpl& parent, ClusterInfoConstSharedPtr cluster,
-                   const LoadBalancerFactorySharedPtr& lb_factory);
+      // The load balancing state of the cluster, only created once the worker uses the cluster.
+      struct State {
+        State(ClusterEntry& entry, const ThreadLocalClusterSnapshot& snapshot);
+
+        PrioritySetImpl priority_set_;
+        // LB factory if applicable. Not all load balancer types have a factory. LB types that have
+        // a factory will create a new LB on every membership update. LB types that don't have a
+        // factory will create an LB on construction and use it forever.
+        LoadBalancerFactorySharedPtr lb_factory_;
+        // Current active LB.
+        LoadBalancerPtr lb_;
+        Http::AsyncClientImpl http_async_client_;
+      };
+
+      ClusterEntry(ThreadLocalClusterManagerImpl& parent,
+                   ThreadLocalClusterSnapshotConstSharedPtr snapshot);
       ~ClusterEntry() override;
 
+      // Create the load balancing state from the latest snapshot on first use.
+      State& state();
+
+      void updateHosts(uint32_t priority, const ThreadLocalClusterSnapshot::HostSet& host_set,
+                       const HostVector& hosts_added, const HostVector& hosts_removed);
+
       Http::ConnectionPool::Instance* connPool(ResourcePriority priority, Http::Protocol protocol,
                                                LoadBalancerContext* context);
 
@@ -334,20 +419,15 @@ private:
                                                  LoadBalancerContext* context);
 
       // Upstream::ThreadLocalCluster
-      const PrioritySet& prioritySet() override { return priority_set_; }
+      const PrioritySet& prioritySet() override { return state().priority_set_; }
       ClusterInfoConstSharedPtr info() override { return cluster_info_; }
-      LoadBalancer& loadBalancer() override { return *lb_; }
+      LoadBalancer& loadBalancer() override { return *state().lb_; }
 
       ThreadLocalClusterManagerImpl& parent_;
-      PrioritySetImpl priority_set_;
-      // LB factory if applicable. Not all load balancer types have a factory. LB types that have
-      // a factory will create a new LB on every membership update. LB types that don't have a
-      // factory will create an LB on construction and use it forever.
-      LoadBalancerFactorySharedPtr lb_factory_;
-      // Current active LB.
-      LoadBalancerPtr lb_;
       ClusterInfoConstSharedPtr cluster_info_;
-      Http::AsyncClientImpl http_async_client_;
+      // The hosts to create the state from, until the worker uses the cluster.
+      ThreadLocalClusterSnapshotConstSharedPtr snapshot_;
+      std::unique_ptr<State> state_;
     };
 
     using ClusterEntryPtr = std::unique_ptr<ClusterEntry>;
@@ -362,12 +442,7 @@ private:
     void removeTcpConn(const HostConstSharedPtr& host, Network::ClientConnection& connection);
     static void removeHosts(const std::string& name, const HostVector& hosts_removed,
                             ThreadLocal::Slot& tls);
-    static void updateClusterMembership(const std::string& name, uint32_t priority,
-                                        PrioritySet::UpdateHostsParams update_hosts_params,
-                                        LocalityWeightsConstSharedPtr locality_weights,
-                                        const HostVector& hosts_added,
-                                        const HostVector& hosts_removed, ThreadLocal::Slot& tls,
-                                        uint64_t overprovisioning_factor);
+    void updateClusterMembership(const ThreadLocalClusterUpdateBatch& batch);
     static void onHostHealthFailure(const HostSharedPtr& host, ThreadLocal::Slot& tls);
 
     ConnPoolsContainer* getHttpConnPoolsContainer(const HostConstSharedPtr& host,
@@ -384,6 +459,7 @@ private:
     std::unordered_map<HostConstSharedPtr, TcpConnectionsMap> host_tcp_conn_map_;
 
     std::list<Envoy::Upstream::ClusterUpdateCallbacks*> update_callbacks_;
+    ClusterDiscoveryManager cluster_discovery_manager_;
     const PrioritySet* local_priority_set_{};
     bool destroying_{};
   };
@@ -413,6 +489,8 @@ private:
     ClusterSharedPtr cluster_;
     // Optional thread aware LB depending on the LB type. Not all clusters have one.
     ThreadAwareLoadBalancerPtr thread_aware_lb_;
+    // The hosts as last posted to the workers.
+    ThreadLocalClusterSnapshotConstSharedPtr thread_local_snapshot_;
     SystemTime last_updated_;
   };
 
@@ -423,6 +501,24 @@ private:
         : RaiiListElement<ClusterUpdateCallbacks*>(parent, &cb) {}
   };
 
+  class OdCdsApiHandleImpl : public OdCdsApiHandle {
+  public:
+    OdCdsApiHandleImpl(ClusterManagerImpl& parent, OdCdsApiSharedPtr odcds)
+        : parent_(parent), odcds_(std::move(odcds)) {}
+    ~OdCdsApiHandleImpl() override;
+
+    // Upstream::OdCdsApiHandle
+    ClusterDiscoveryCallbackHandlePtr
+    requestOnDemandClusterDiscovery(const std::string& name, ClusterDiscoveryCallbackPtr callback,
+                                    std::chrono::milliseconds timeout) override {
+      return parent_.requestOnDemandClusterDiscovery(odcds_, name, std::move(callback), timeout);
+    }
+
+  private:
+    ClusterManagerImpl& parent_;
+    OdCdsApiSharedPtr odcds_;
+  };
+
   using ClusterDataPtr = std::unique_ptr<ClusterData>;
   // This map is ordered so that config dumping is consistent.
   using ClusterMap = std::map<std::string, ClusterDataPtr>;
@@ -473,7 +569,12 @@ private:
   void loadCluster(const envoy::config::cluster::v3::Cluster& cluster,
                    const std::string& version_info, bool added_via_api, ClusterMap& cluster_map);
   void onClusterInit(Cluster& cluster);
+  // Complete the discovery of the cluster on all threads, if it is being discovered.
+  void notifyClusterDiscoveryStatus(std::string name, ClusterDiscoveryStatus status);
   void postThreadLocalHealthFailure(const HostSharedPtr& host);
+  // Post the pending membership updates to the workers. Anything else posted to the workers about
+  // clusters must be posted after these updates, so that workers see all changes in order.
+  void postThreadLocalClusterUpdates();
   void updateClusterCounts();
 
   ClusterManagerFactory& factory_;
@@ -488,6 +589,7 @@ protected:
 private:
   ClusterMap warming_clusters_;
   envoy::config::core::v3::BindConfig bind_config_;
+  const bool lazy_cluster_stats_;
   Outlier::EventLoggerSharedPtr outlier_event_logger_;
   const LocalInfo::LocalInfo& local_info_;
   CdsApiPtr cds_api_;
@@ -505,6 +607,18 @@ private:
   Http::Context& http_context_;
   Config::SubscriptionFactoryImpl subscription_factory_;
   ClusterSet primary_clusters_;
+  // The timeouts of the on-demand discoveries in progress, by cluster name.
+  absl::flat_hash_map<std::string, Event::TimerPtr> pending_cluster_discoveries_;
+  // The membership updates not posted to the workers yet. They are posted once per iteration of
+  // the main thread event loop, so that the many updates of a config update reach each worker at
+  // once.
+  ThreadLocalClusterUpdateBatch pending_thread_local_updates_;
+  // The index in pending_thread_local_updates_ of the last pending update of each cluster priority,
+  // which the next update of the priority may be merged with.
+  absl::flat_hash_map<std::pair<std::string, uint32_t>, size_t> pending_thread_local_update_index_;
+  // Whether posting the pending updates is scheduled. The scheduled callback only holds a weak
+  // reference to it, so that it does nothing once the cluster manager is destroyed.
+  std::shared_ptr<bool> thread_local_updates_scheduled_{std::make_shared<bool>(false)};
 };
 
 } // namespace Upstream
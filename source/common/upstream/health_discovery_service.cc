@@ -263,7 +263,7 @@ ProdClusterInfoFactory::createClusterInfo(const CreateClusterInfoParams& params)
 
   return std::make_unique<ClusterInfoImpl>(
       params.cluster_, params.bind_config_, params.runtime_, std::move(socket_matcher),
-      std::move(scope), params.added_via_api_, params.validation_visitor_, factory_context);
+      std::move(scope), params.added_via_api_, false, params.validation_visitor_, factory_context);
 }
 
 void HdsCluster::startHealthchecks(AccessLog::AccessLogManager& access_log_manager,
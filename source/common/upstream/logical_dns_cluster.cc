@@ -98,7 +98,7 @@ LogicalDnsCluster::~LogicalDnsCluster() {
 void LogicalDnsCluster::startResolve() {
   std::string dns_address = Network::Utility::hostFromTcpUrl(dns_url_);
   ENVOY_LOG(debug, "starting async DNS resolution for {}", dns_address);
-  info_->stats().update_attempt_.inc();
+  info_->endpointStats().update_attempt_.inc();
 
   active_dns_query_ = dns_resolver_->resolve(
       dns_address, dns_lookup_family_,
@@ -113,7 +113,7 @@ void LogicalDnsCluster::startResolve() {
         // cluster does not update. This ensures that a potentially previously resolved address does
         // not stabilize back to 0 hosts.
         if (status == Network::DnsResolver::ResolutionStatus::Success && !response.empty()) {
-          info_->stats().update_success_.inc();
+          info_->endpointStats().update_success_.inc();
           // TODO(mattklein123): Move port handling into the DNS interface.
           ASSERT(response.front().address_ != nullptr);
           Network::Address::InstanceConstSharedPtr new_address =
@@ -152,7 +152,7 @@ void LogicalDnsCluster::startResolve() {
           ENVOY_LOG(debug, "DNS refresh rate reset for {}, refresh rate {} ms", dns_address,
                     final_refresh_rate.count());
         } else {
-          info_->stats().update_failure_.inc();
+          info_->endpointStats().update_failure_.inc();
           final_refresh_rate =
               std::chrono::milliseconds(failure_backoff_strategy_->nextBackOffMs());
           ENVOY_LOG(debug, "DNS refresh rate reset for {}, (failure) refresh rate {} ms",
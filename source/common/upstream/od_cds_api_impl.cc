@@ -0,0 +1,179 @@
+#include "common/upstream/od_cds_api_impl.h"
+
+#include <string>
+#include <vector>
+
+#include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/config/cluster/v3/cluster.pb.validate.h"
+#include "envoy/config/core/v3/config_source.pb.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "common/common/assert.h"
+#include "common/config/utility.h"
+#include "common/protobuf/utility.h"
+
+#include "absl/strings/str_join.h"
+
+namespace Envoy {
+namespace Upstream {
+
+OdCdsApiSharedPtr OdCdsApiImpl::create(const envoy::config::core::v3::ConfigSource& odcds_config,
+                                       std::chrono::milliseconds idle_timeout, ClusterManager& cm,
+                                       MissingClusterNotifier& notifier,
+                                       Event::Dispatcher& dispatcher, Stats::Scope& scope,
+                                       ProtobufMessage::ValidationVisitor& validation_visitor) {
+  return OdCdsApiSharedPtr{new OdCdsApiImpl(odcds_config, idle_timeout, cm, notifier, dispatcher,
+                                            scope, validation_visitor)};
+}
+
+OdCdsApiImpl::OdCdsApiImpl(const envoy::config::core::v3::ConfigSource& odcds_config,
+                           std::chrono::milliseconds idle_timeout, ClusterManager& cm,
+                           MissingClusterNotifier& notifier, Event::Dispatcher& dispatcher,
+                           Stats::Scope& scope,
+                           ProtobufMessage::ValidationVisitor& validation_visitor)
+    : Envoy::Config::SubscriptionBase<envoy::config::cluster::v3::Cluster>(
+          odcds_config.resource_api_version()),
+      cm_(cm), notifier_(notifier), scope_(scope.createScope("cluster_manager.odcds.")),
+      stats_({ALL_ODCDS_STATS(POOL_COUNTER(*scope_))}), validation_visitor_(validation_visitor),
+      idle_timeout_(idle_timeout) {
+  // Growing the resource interest of a state of the world subscription would make the management
+  // server send all the requested clusters again on every discovery.
+  if (odcds_config.config_source_specifier_case() ==
+          envoy::config::core::v3::ConfigSource::ConfigSourceSpecifierCase::kApiConfigSource &&
+      odcds_config.api_config_source().api_type() !=
+          envoy::config::core::v3::ApiConfigSource::DELTA_GRPC) {
+    throw EnvoyException("odcds: only DELTA_GRPC API config sources are supported");
+  }
+  const auto resource_name = getResourceName();
+  subscription_ = cm_.subscriptionFactory().subscriptionFromConfigSource(
+      odcds_config, Grpc::Common::typeUrl(resource_name), *scope_, *this);
+  if (idle_timeout_.count() > 0) {
+    idle_timer_ = dispatcher.createTimer([this]() -> void { onIdleTimer(); });
+  }
+}
+
+void OdCdsApiImpl::updateOnDemand(const std::string& cluster_name) {
+  if (!started_) {
+    resource_interest_.insert(cluster_name);
+    subscription_->start(resource_interest_);
+    started_ = true;
+    return;
+  }
+  if (resource_interest_.count(cluster_name) > 0) {
+    // The cluster is known to the management server, which will not send it again unless the
+    // interest in it is removed and added back. This happens when the cluster was removed by
+    // another subscription, or when it was reported missing and may exist by now.
+    resource_interest_.erase(cluster_name);
+    subscription_->updateResourceInterest(resource_interest_);
+  }
+  resource_interest_.insert(cluster_name);
+  subscription_->updateResourceInterest(resource_interest_);
+}
+
+void OdCdsApiImpl::onConfigUpdate(const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources,
+                                  const std::string& version_info) {
+  // State of the world updates may come from an ADS mux. They only add or update clusters: the
+  // clusters of this subscription are removed when they go idle.
+  Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource> to_add_repeated;
+  for (const auto& cluster_blob : resources) {
+    envoy::service::discovery::v3::Resource* to_add = to_add_repeated.Add();
+    to_add->set_name(resourceName(cluster_blob));
+    to_add->set_version(version_info);
+    to_add->mutable_resource()->CopyFrom(cluster_blob);
+  }
+  onConfigUpdate(to_add_repeated, {}, version_info);
+}
+
+void OdCdsApiImpl::onConfigUpdate(
+    const Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource>& added_resources,
+    const Protobuf::RepeatedPtrField<std::string>& removed_resources, const std::string&) {
+  ENVOY_LOG(debug, "odcds: add {} cluster(s), remove {} cluster(s)", added_resources.size(),
+            removed_resources.size());
+
+  std::vector<std::string> exception_msgs;
+  for (const auto& resource : added_resources) {
+    envoy::config::cluster::v3::Cluster cluster;
+    try {
+      cluster = MessageUtil::anyConvertAndValidate<envoy::config::cluster::v3::Cluster>(
+          resource.resource(), validation_visitor_);
+      if (cm_.addOrUpdateCluster(cluster, resource.version())) {
+        ENVOY_LOG(debug, "odcds: add/update cluster '{}'", cluster.name());
+        if (discovered_clusters_.try_emplace(cluster.name()).second) {
+          stats_.cluster_discovered_.inc();
+        }
+      } else {
+        ENVOY_LOG(debug, "odcds: add/update cluster '{}' skipped", cluster.name());
+      }
+    } catch (const EnvoyException& e) {
+      exception_msgs.push_back(fmt::format("{}: {}", cluster.name(), e.what()));
+    }
+  }
+  for (const auto& resource_name : removed_resources) {
+    if (discovered_clusters_.erase(resource_name) > 0) {
+      cm_.removeCluster(resource_name);
+      ENVOY_LOG(debug, "odcds: remove cluster '{}'", resource_name);
+    } else {
+      ENVOY_LOG(debug, "odcds: cluster '{}' is missing", resource_name);
+      stats_.cluster_missing_.inc();
+    }
+    // This is a no-op unless the cluster is being discovered.
+    notifier_.notifyMissingCluster(resource_name);
+  }
+
+  if (idle_timer_ != nullptr && !idle_timer_->enabled() && !discovered_clusters_.empty()) {
+    idle_timer_->enableTimer(idle_timeout_);
+  }
+  if (!exception_msgs.empty()) {
+    throw EnvoyException(
+        fmt::format("Error adding/updating cluster(s) {}", absl::StrJoin(exception_msgs, ", ")));
+  }
+}
+
+void OdCdsApiImpl::onConfigUpdateFailed(Envoy::Config::ConfigUpdateFailureReason reason,
+                                        const EnvoyException*) {
+  ASSERT(Envoy::Config::ConfigUpdateFailureReason::ConnectionFailure != reason);
+  // Pending discoveries fail with their timeout.
+}
+
+void OdCdsApiImpl::onIdleTimer() {
+  std::vector<std::string> expired;
+  for (auto it = discovered_clusters_.begin(); it != discovered_clusters_.end();) {
+    ThreadLocalCluster* cluster = cm_.get(it->first);
+    if (cluster == nullptr) {
+      // A cluster which was active already was removed by another subscription, while the others
+      // are still warming.
+      if (it->second.has_value()) {
+        discovered_clusters_.erase(it++);
+      } else {
+        ++it;
+      }
+      continue;
+    }
+    const ClusterStats& stats = cluster->info()->stats();
+    const uint64_t usage = stats.upstream_rq_total_.value() + stats.upstream_cx_total_.value();
+    if (it->second == usage && stats.upstream_rq_active_.value() == 0 &&
+        stats.upstream_cx_active_.value() == 0) {
+      expired.push_back(it->first);
+      discovered_clusters_.erase(it++);
+      continue;
+    }
+    it->second = usage;
+    ++it;
+  }
+
+  for (const std::string& name : expired) {
+    ENVOY_LOG(debug, "odcds: removing idle cluster '{}'", name);
+    cm_.removeCluster(name);
+    resource_interest_.erase(name);
+    stats_.cluster_expired_.inc();
+  }
+  if (!expired.empty()) {
+    subscription_->updateResourceInterest(resource_interest_);
+  }
+  if (!discovered_clusters_.empty()) {
+    idle_timer_->enableTimer(idle_timeout_);
+  }
+}
+
+} // namespace Upstream
+} // namespace Envoy
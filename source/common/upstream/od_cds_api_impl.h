@@ -0,0 +1,122 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <set>
+#include <string>
+
+#include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/config/core/v3/config_source.pb.h"
+#include "envoy/config/subscription.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/upstream/cluster_manager.h"
+
+#include "common/common/logger.h"
+#include "common/config/subscription_base.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Upstream {
+
+/**
+ * All on-demand CDS stats. @see stats_macros.h
+ */
+#define ALL_ODCDS_STATS(COUNTER)                                                                   \
+  COUNTER(cluster_discovered)                                                                      \
+  COUNTER(cluster_expired)                                                                         \
+  COUNTER(cluster_missing)
+
+/**
+ * Struct definition for all on-demand CDS stats. @see stats_macros.h
+ */
+struct OdCdsStats {
+  ALL_ODCDS_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * Receives the names of the clusters which the management server reported as missing.
+ */
+class MissingClusterNotifier {
+public:
+  virtual ~MissingClusterNotifier() = default;
+
+  virtual void notifyMissingCluster(absl::string_view name) PURE;
+};
+
+/**
+ * The interface of an on-demand CDS subscription, used from the main thread only.
+ */
+class OdCdsApi {
+public:
+  virtual ~OdCdsApi() = default;
+
+  /**
+   * Subscribe to the cluster, or subscribe to it again if the cluster was already subscribed to
+   * but is not known to the cluster manager anymore.
+   */
+  virtual void updateOnDemand(const std::string& cluster_name) PURE;
+};
+
+using OdCdsApiSharedPtr = std::shared_ptr<OdCdsApi>;
+
+/**
+ * On-demand CDS API implementation fetching clusters via a delta Subscription, whose resource
+ * interest grows with the clusters requested. The discovered clusters are added to the cluster
+ * manager, and removed again from it, and from the resource interest, once they have not served
+ * any request or connection for a whole idle timeout period. As clusters are only checked at the
+ * end of each period, an unused cluster lives for up to twice the idle timeout.
+ */
+class OdCdsApiImpl : public OdCdsApi,
+                     Envoy::Config::SubscriptionBase<envoy::config::cluster::v3::Cluster>,
+                     Logger::Loggable<Logger::Id::upstream> {
+public:
+  static OdCdsApiSharedPtr create(const envoy::config::core::v3::ConfigSource& odcds_config,
+                                  std::chrono::milliseconds idle_timeout, ClusterManager& cm,
+                                  MissingClusterNotifier& notifier, Event::Dispatcher& dispatcher,
+                                  Stats::Scope& scope,
+                                  ProtobufMessage::ValidationVisitor& validation_visitor);
+
+  // Upstream::OdCdsApi
+  void updateOnDemand(const std::string& cluster_name) override;
+
+private:
+  // Config::SubscriptionCallbacks
+  void onConfigUpdate(const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources,
+                      const std::string& version_info) override;
+  void onConfigUpdate(
+      const Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource>& added_resources,
+      const Protobuf::RepeatedPtrField<std::string>& removed_resources,
+      const std::string& system_version_info) override;
+  void onConfigUpdateFailed(Envoy::Config::ConfigUpdateFailureReason reason,
+                            const EnvoyException* e) override;
+  std::string resourceName(const ProtobufWkt::Any& resource) override {
+    return MessageUtil::anyConvert<envoy::config::cluster::v3::Cluster>(resource).name();
+  }
+
+  OdCdsApiImpl(const envoy::config::core::v3::ConfigSource& odcds_config,
+               std::chrono::milliseconds idle_timeout, ClusterManager& cm,
+               MissingClusterNotifier& notifier, Event::Dispatcher& dispatcher, Stats::Scope& scope,
+               ProtobufMessage::ValidationVisitor& validation_visitor);
+  void onIdleTimer();
+
+  ClusterManager& cm_;
+  MissingClusterNotifier& notifier_;
+  Stats::ScopePtr scope_;
+  OdCdsStats stats_;
+  ProtobufMessage::ValidationVisitor& validation_visitor_;
+  std::unique_ptr<Config::Subscription> subscription_;
+  bool started_{};
+  std::set<std::string> resource_interest_;
+  const std::chrono::milliseconds idle_timeout_;
+  Event::TimerPtr idle_timer_;
+  // The clusters added by this subscription, with the number of requests and connections they
+  // served at the last idle check. Clusters which were not active yet then have no usage.
+  absl::flat_hash_map<std::string, absl::optional<uint64_t>> discovered_clusters_;
+};
+
+} // namespace Upstream
+} // namespace Envoy
@@ -104,7 +104,7 @@ StrictDnsClusterImpl::ResolveTarget::~ResolveTarget() {
 
 void StrictDnsClusterImpl::ResolveTarget::startResolve() {
   ENVOY_LOG(trace, "starting async DNS resolution for {}", dns_address_);
-  parent_.info_->stats().update_attempt_.inc();
+  parent_.info_->endpointStats().update_attempt_.inc();
 
   active_query_ = parent_.dns_resolver_->resolve(
       dns_address_, parent_.dns_lookup_family_,
@@ -116,7 +116,7 @@ void StrictDnsClusterImpl::ResolveTarget::startResolve() {
         std::chrono::milliseconds final_refresh_rate = parent_.dns_refresh_rate_ms_;
 
         if (status == Network::DnsResolver::ResolutionStatus::Success) {
-          parent_.info_->stats().update_success_.inc();
+          parent_.info_->endpointStats().update_success_.inc();
 
           std::unordered_map<std::string, HostSharedPtr> updated_hosts;
           HostVector new_hosts;
@@ -149,7 +149,7 @@ void StrictDnsClusterImpl::ResolveTarget::startResolve() {
             }));
             parent_.updateAllHosts(hosts_added, hosts_removed, locality_lb_endpoint_.priority());
           } else {
-            parent_.info_->stats().update_no_rebuild_.inc();
+            parent_.info_->endpointStats().update_no_rebuild_.inc();
           }
 
           all_hosts_ = std::move(updated_hosts);
@@ -166,7 +166,7 @@ void StrictDnsClusterImpl::ResolveTarget::startResolve() {
           ENVOY_LOG(debug, "DNS refresh rate reset for {}, refresh rate {} ms", dns_address_,
                     final_refresh_rate.count());
         } else {
-          parent_.info_->stats().update_failure_.inc();
+          parent_.info_->endpointStats().update_failure_.inc();
 
           final_refresh_rate =
               std::chrono::milliseconds(parent_.failure_backoff_strategy_->nextBackOffMs());
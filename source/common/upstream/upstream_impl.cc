@@ -611,6 +611,10 @@ ClusterStats ClusterInfoImpl::generateStats(Stats::Scope& scope) {
   return {ALL_CLUSTER_STATS(POOL_COUNTER(scope), POOL_GAUGE(scope), POOL_HISTOGRAM(scope))};
 }
 
+ClusterEndpointStats ClusterInfoImpl::generateEndpointStats(Stats::Scope& scope) {
+  return {ALL_CLUSTER_ENDPOINT_STATS(POOL_COUNTER(scope), POOL_GAUGE(scope))};
+}
+
 ClusterLoadReportStats ClusterInfoImpl::generateLoadReportStats(Stats::Scope& scope) {
   return {ALL_CLUSTER_LOAD_REPORT_STATS(POOL_COUNTER(scope))};
 }
@@ -664,7 +668,7 @@ ClusterInfoImpl::ClusterInfoImpl(
     const envoy::config::cluster::v3::Cluster& config,
     const envoy::config::core::v3::BindConfig& bind_config, Runtime::Loader& runtime,
     TransportSocketMatcherPtr&& socket_matcher, Stats::ScopePtr&& stats_scope, bool added_via_api,
-    ProtobufMessage::ValidationVisitor& validation_visitor,
+    bool lazy_stats, ProtobufMessage::ValidationVisitor& validation_visitor,
     Server::Configuration::TransportSocketFactoryContext& factory_context)
     : runtime_(runtime), name_(config.name()), type_(config.type()),
       max_requests_per_connection_(
@@ -678,8 +682,7 @@ ClusterInfoImpl::ClusterInfoImpl(
       per_connection_buffer_limit_bytes_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, per_connection_buffer_limit_bytes, 1024 * 1024)),
       socket_matcher_(std::move(socket_matcher)), stats_scope_(std::move(stats_scope)),
-      stats_(generateStats(*stats_scope_)), load_report_stats_store_(stats_scope_->symbolTable()),
-      load_report_stats_(generateLoadReportStats(load_report_stats_store_)),
+      endpoint_stats_(generateEndpointStats(*stats_scope_)),
       timeout_budget_stats_(config.track_timeout_budgets()
                                 ? absl::make_optional<ClusterTimeoutBudgetStats>(
                                       generateTimeoutBudgetStats(*stats_scope_))
@@ -811,6 +814,14 @@ ClusterInfoImpl::ClusterInfoImpl(
         factory.createFilterFactoryFromProto(*message, *factory_context_);
     filter_factories_.push_back(callback);
   }
+
+  if (!lazy_stats) {
+    // Create the stats and circuit breakers along with the cluster, so that they are reported even
+    // if the cluster is never used.
+    stats();
+    resourceManager(ResourcePriority::Default);
+    resourceManager(ResourcePriority::High);
+  }
 }
 
 ProtocolOptionsConfigConstSharedPtr
@@ -881,15 +892,15 @@ ClusterImplBase::ClusterImplBase(
       cluster.transport_socket_matches(), factory_context, socket_factory, *stats_scope);
   info_ = std::make_unique<ClusterInfoImpl>(
       cluster, factory_context.clusterManager().bindConfig(), runtime, std::move(socket_matcher),
-      std::move(stats_scope), added_via_api, factory_context.messageValidationVisitor(),
-      factory_context);
+      std::move(stats_scope), added_via_api, factory_context.clusterManager().lazyClusterStats(),
+      factory_context.messageValidationVisitor(), factory_context);
   // Create the default (empty) priority set before registering callbacks to
   // avoid getting an update the first time it is accessed.
   priority_set_.getOrCreateHostSet(0);
   priority_set_.addPriorityUpdateCb(
       [this](uint32_t, const HostVector& hosts_added, const HostVector& hosts_removed) {
         if (!hosts_added.empty() || !hosts_removed.empty()) {
-          info_->stats().membership_change_.inc();
+          info_->endpointStats().membership_change_.inc();
         }
 
         uint32_t healthy_hosts = 0;
@@ -902,10 +913,10 @@ ClusterImplBase::ClusterImplBase(
           degraded_hosts += host_set->degradedHosts().size();
           excluded_hosts += host_set->excludedHosts().size();
         }
-        info_->stats().membership_total_.set(hosts);
-        info_->stats().membership_healthy_.set(healthy_hosts);
-        info_->stats().membership_degraded_.set(degraded_hosts);
-        info_->stats().membership_excluded_.set(excluded_hosts);
+        info_->endpointStats().membership_total_.set(hosts);
+        info_->endpointStats().membership_healthy_.set(healthy_hosts);
+        info_->endpointStats().membership_degraded_.set(degraded_hosts);
+        info_->endpointStats().membership_excluded_.set(excluded_hosts);
       });
 }
 
@@ -947,9 +958,19 @@ bool ClusterInfoImpl::maintenanceMode() const {
   return runtime_.snapshot().featureEnabled(maintenance_mode_runtime_key_, 0);
 }
 
+ClusterStats& ClusterInfoImpl::stats() const {
+  return *stats_.get(
+      [this]() -> ClusterStats* { return new ClusterStats(generateStats(*stats_scope_)); });
+}
+
+ClusterLoadReportStats& ClusterInfoImpl::loadReportStats() const {
+  LoadReportStats* load_report_stats = load_report_stats_.get(
+      [this]() -> LoadReportStats* { return new LoadReportStats(stats_scope_->symbolTable()); });
+  return load_report_stats->stats_;
+}
+
 ResourceManager& ClusterInfoImpl::resourceManager(ResourcePriority priority) const {
-  ASSERT(enumToInt(priority) < resource_managers_.managers_.size());
-  return *resource_managers_.managers_[enumToInt(priority)];
+  return resource_managers_.get(priority);
 }
 
 void ClusterImplBase::initialize(std::function<void()> callback) {
@@ -1083,13 +1104,19 @@ void ClusterImplBase::validateEndpointsForZoneAwareRouting(
   }
 }
 
+ClusterInfoImpl::LoadReportStats::LoadReportStats(Stats::SymbolTable& symbol_table)
+    : store_(symbol_table), stats_(generateLoadReportStats(store_)) {}
+
 ClusterInfoImpl::ResourceManagers::ResourceManagers(
     const envoy::config::cluster::v3::Cluster& config, Runtime::Loader& runtime,
-    const std::string& cluster_name, Stats::Scope& stats_scope) {
-  managers_[enumToInt(ResourcePriority::Default)] =
-      load(config, runtime, cluster_name, stats_scope, envoy::config::core::v3::DEFAULT);
-  managers_[enumToInt(ResourcePriority::High)] =
-      load(config, runtime, cluster_name, stats_scope, envoy::config::core::v3::HIGH);
+    const std::string& cluster_name, Stats::Scope& stats_scope)
+    : circuit_breakers_(config.circuit_breakers()), runtime_(runtime), cluster_name_(cluster_name),
+      stats_scope_(stats_scope) {}
+
+ResourceManager& ClusterInfoImpl::ResourceManagers::get(ResourcePriority priority) {
+  ASSERT(enumToInt(priority) < NumResourcePriorities);
+  return *managers_.get(enumToInt(priority),
+                        [this, priority]() -> ResourceManagerImpl* { return load(priority); });
 }
 
 ClusterCircuitBreakersStats
@@ -1113,11 +1140,7 @@ Http::Http2::CodecStats& ClusterInfoImpl::http2CodecStats() const {
   return Http::Http2::CodecStats::atomicGet(http2_codec_stats_, *stats_scope_);
 }
 
-ResourceManagerImplPtr
-ClusterInfoImpl::ResourceManagers::load(const envoy::config::cluster::v3::Cluster& config,
-                                        Runtime::Loader& runtime, const std::string& cluster_name,
-                                        Stats::Scope& stats_scope,
-                                        const envoy::config::core::v3::RoutingPriority& priority) {
+ResourceManagerImpl* ClusterInfoImpl::ResourceManagers::load(ResourcePriority priority) {
   uint64_t max_connections = 1024;
   uint64_t max_pending_requests = 1024;
   uint64_t max_requests = 1024;
@@ -1127,25 +1150,28 @@ ClusterInfoImpl::ResourceManagers::load(const envoy::config::cluster::v3::Cluste
   bool track_remaining = false;
 
   std::string priority_name;
+  envoy::config::core::v3::RoutingPriority routing_priority;
   switch (priority) {
-  case envoy::config::core::v3::DEFAULT:
+  case ResourcePriority::Default:
     priority_name = "default";
+    routing_priority = envoy::config::core::v3::DEFAULT;
     break;
-  case envoy::config::core::v3::HIGH:
+  case ResourcePriority::High:
     priority_name = "high";
+    routing_priority = envoy::config::core::v3::HIGH;
     break;
   default:
     NOT_REACHED_GCOVR_EXCL_LINE;
   }
 
   const std::string runtime_prefix =
-      fmt::format("circuit_breakers.{}.{}.", cluster_name, priority_name);
+      fmt::format("circuit_breakers.{}.{}.", cluster_name_, priority_name);
 
-  const auto& thresholds = config.circuit_breakers().thresholds();
+  const auto& thresholds = circuit_breakers_.thresholds();
   const auto it = std::find_if(
       thresholds.cbegin(), thresholds.cend(),
-      [priority](const envoy::config::cluster::v3::CircuitBreakers::Thresholds& threshold) {
-        return threshold.priority() == priority;
+      [routing_priority](const envoy::config::cluster::v3::CircuitBreakers::Thresholds& threshold) {
+        return threshold.priority() == routing_priority;
       });
 
   absl::optional<double> budget_percent;
@@ -1173,10 +1199,10 @@ ClusterInfoImpl::ResourceManagers::load(const envoy::config::cluster::v3::Cluste
               : min_retry_concurrency;
     }
   }
-  return std::make_unique<ResourceManagerImpl>(
-      runtime, runtime_prefix, max_connections, max_pending_requests, max_requests, max_retries,
+  return new ResourceManagerImpl(
+      runtime_, runtime_prefix, max_connections, max_pending_requests, max_requests, max_retries,
       max_connection_pools,
-      ClusterInfoImpl::generateCircuitBreakersStats(stats_scope, priority_name, track_remaining),
+      ClusterInfoImpl::generateCircuitBreakersStats(stats_scope_, priority_name, track_remaining),
       budget_percent, min_retry_concurrency);
 }
 
@@ -1478,7 +1504,7 @@ bool BaseDynamicClusterImpl::updateDynamicHostList(const HostVector& new_hosts,
 
   // At this point we've accounted for all the new hosts as well the hosts that previously
   // existed in this priority.
-  info_->stats().max_host_weight_.set(max_host_weight);
+  info_->endpointStats().max_host_weight_.set(max_host_weight);
 
   // Whatever remains in current_priority_hosts should be removed.
   if (!hosts_added_to_current_priority.empty() || !current_priority_hosts.empty()) {
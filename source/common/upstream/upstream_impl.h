@@ -515,10 +515,12 @@ public:
   ClusterInfoImpl(const envoy::config::cluster::v3::Cluster& config,
                   const envoy::config::core::v3::BindConfig& bind_config, Runtime::Loader& runtime,
                   TransportSocketMatcherPtr&& socket_matcher, Stats::ScopePtr&& stats_scope,
-                  bool added_via_api, ProtobufMessage::ValidationVisitor& validation_visitor,
+                  bool added_via_api, bool lazy_stats,
+                  ProtobufMessage::ValidationVisitor& validation_visitor,
                   Server::Configuration::TransportSocketFactoryContext&);
 
   static ClusterStats generateStats(Stats::Scope& scope);
+  static ClusterEndpointStats generateEndpointStats(Stats::Scope& scope);
   static ClusterLoadReportStats generateLoadReportStats(Stats::Scope& scope);
   static ClusterCircuitBreakersStats generateCircuitBreakersStats(Stats::Scope& scope,
                                                                   const std::string& stat_prefix,
@@ -571,9 +573,10 @@ public:
   const std::string& name() const override { return name_; }
   ResourceManager& resourceManager(ResourcePriority priority) const override;
   TransportSocketMatcher& transportSocketMatcher() const override { return *socket_matcher_; }
-  ClusterStats& stats() const override { return stats_; }
+  ClusterStats& stats() const override;
+  ClusterEndpointStats& endpointStats() const override { return endpoint_stats_; }
   Stats::Scope& statsScope() const override { return *stats_scope_; }
-  ClusterLoadReportStats& loadReportStats() const override { return load_report_stats_; }
+  ClusterLoadReportStats& loadReportStats() const override;
   const absl::optional<ClusterTimeoutBudgetStats>& timeoutBudgetStats() const override {
     return timeout_budget_stats_;
   }
@@ -605,19 +608,32 @@ public:
   Http::Http2::CodecStats& http2CodecStats() const override;
 
 private:
+  // The resource managers of each priority, created on first use.
   struct ResourceManagers {
     ResourceManagers(const envoy::config::cluster::v3::Cluster& config, Runtime::Loader& runtime,
                      const std::string& cluster_name, Stats::Scope& stats_scope);
-    ResourceManagerImplPtr load(const envoy::config::cluster::v3::Cluster& config,
-                                Runtime::Loader& runtime, const std::string& cluster_name,
-                                Stats::Scope& stats_scope,
-                                const envoy::config::core::v3::RoutingPriority& priority);
+    ResourceManager& get(ResourcePriority priority);
+    ResourceManagerImpl* load(ResourcePriority priority);
 
-    using Managers = std::array<ResourceManagerImplPtr, NumResourcePriorities>;
+    using Managers = Thread::AtomicPtrArray<ResourceManagerImpl, NumResourcePriorities,
+                                            Thread::AtomicPtrAllocMode::DeleteOnDestruct>;
 
+    const envoy::config::cluster::v3::CircuitBreakers circuit_breakers_;
+    Runtime::Loader& runtime_;
+    const std::string& cluster_name_;
+    Stats::Scope& stats_scope_;
     Managers managers_;
   };
 
+  // The load report stats, created on first use as they are only used by the load stats reporter
+  // and the router.
+  struct LoadReportStats {
+    LoadReportStats(Stats::SymbolTable& symbol_table);
+
+    Stats::IsolatedStoreImpl store_;
+    ClusterLoadReportStats stats_;
+  };
+
   Runtime::Loader& runtime_;
   const std::string name_;
   const envoy::config::cluster::v3::Cluster::DiscoveryType type_;
@@ -628,9 +644,10 @@ private:
   const uint32_t per_connection_buffer_limit_bytes_;
   TransportSocketMatcherPtr socket_matcher_;
   Stats::ScopePtr stats_scope_;
-  mutable ClusterStats stats_;
-  Stats::IsolatedStoreImpl load_report_stats_store_;
-  mutable ClusterLoadReportStats load_report_stats_;
+  mutable Thread::AtomicPtr<ClusterStats, Thread::AtomicPtrAllocMode::DeleteOnDestruct> stats_;
+  mutable ClusterEndpointStats endpoint_stats_;
+  mutable Thread::AtomicPtr<LoadReportStats, Thread::AtomicPtrAllocMode::DeleteOnDestruct>
+      load_report_stats_;
   const absl::optional<ClusterTimeoutBudgetStats> timeout_budget_stats_;
   const uint64_t features_;
   const Http::Http1Settings http1_settings_;
@@ -16,8 +16,12 @@ void FileAccessLog::emitLog(const Http::RequestHeaderMap& request_headers,
                             const Http::ResponseHeaderMap& response_headers,
                             const Http::ResponseTrailerMap& response_trailers,
                             const StreamInfo::StreamInfo& stream_info) {
-  log_file_->write(formatter_->format(request_headers, response_headers, response_trailers,
-                                      stream_info, absl::string_view()));
+  // The log lines of a worker are all formatted in the same buffer, which is copied by write().
+  static thread_local std::string log_line;
+  log_line.clear();
+  formatter_->formatTo(request_headers, response_headers, response_trailers, stream_info,
+                       absl::string_view(), log_line);
+  log_file_->write(log_line);
 }
 
 } // namespace File
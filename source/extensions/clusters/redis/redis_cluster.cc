@@ -116,7 +116,7 @@ void RedisCluster::onClusterSlotUpdate(ClusterSlotsPtr&& slots) {
     }));
     updateAllHosts(hosts_added, hosts_removed, localityLbEndpoint().priority());
   } else {
-    info_->stats().update_no_rebuild_.inc();
+    info_->endpointStats().update_no_rebuild_.inc();
   }
 
   all_hosts_ = std::move(updated_hosts);
@@ -162,9 +162,9 @@ void RedisCluster::DnsDiscoveryResolveTarget::startResolveDns() {
         ENVOY_LOG(trace, "async DNS resolution complete for {}", dns_address_);
         if (status == Network::DnsResolver::ResolutionStatus::Failure || response.empty()) {
           if (status == Network::DnsResolver::ResolutionStatus::Failure) {
-            parent_.info_->stats().update_failure_.inc();
+            parent_.info_->endpointStats().update_failure_.inc();
           } else {
-            parent_.info_->stats().update_empty_.inc();
+            parent_.info_->endpointStats().update_empty_.inc();
           }
 
           if (!resolve_timer_) {
@@ -253,7 +253,7 @@ void RedisCluster::RedisDiscoverySession::registerDiscoveryAddress(
 }
 
 void RedisCluster::RedisDiscoverySession::startResolveRedis() {
-  parent_.info_->stats().update_attempt_.inc();
+  parent_.info_->endpointStats().update_attempt_.inc();
   // If a resolution is currently in progress, skip it.
   if (current_request_) {
     return;
@@ -348,7 +348,7 @@ void RedisCluster::RedisDiscoverySession::onResponse(
 void RedisCluster::RedisDiscoverySession::onUnexpectedResponse(
     const NetworkFilters::Common::Redis::RespValuePtr& value) {
   ENVOY_LOG(warn, "Unexpected response to cluster slot command: {}", value->toString());
-  this->parent_.info_->stats().update_failure_.inc();
+  this->parent_.info_->endpointStats().update_failure_.inc();
   resolve_timer_->enableTimer(parent_.cluster_refresh_rate_);
 }
 
@@ -358,7 +358,7 @@ void RedisCluster::RedisDiscoverySession::onFailure() {
     auto client_to_delete = client_map_.find(current_host_address_);
     client_to_delete->second->client_->close();
   }
-  parent_.info()->stats().update_failure_.inc();
+  parent_.info()->endpointStats().update_failure_.inc();
   resolve_timer_->enableTimer(parent_.cluster_refresh_rate_);
 }
 
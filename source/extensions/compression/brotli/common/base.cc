@@ -0,0 +1,33 @@
+#include "extensions/compression/brotli/common/base.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Brotli {
+namespace Common {
+
+Base::Base(uint32_t chunk_size)
+    : chunk_size_{chunk_size}, chunk_ptr_{std::make_unique<uint8_t[]>(chunk_size)},
+      avail_out_{chunk_size}, next_out_{chunk_ptr_.get()} {}
+
+void Base::setInput(const Buffer::RawSlice& input_slice) {
+  avail_in_ = input_slice.len_;
+  next_in_ = static_cast<const uint8_t*>(input_slice.mem_);
+}
+
+void Base::updateOutput(Buffer::Instance& output_buffer) {
+  const uint64_t n_output = chunk_size_ - avail_out_;
+  if (n_output == 0) {
+    return;
+  }
+
+  output_buffer.add(static_cast<void*>(chunk_ptr_.get()), n_output);
+  avail_out_ = chunk_size_;
+  next_out_ = chunk_ptr_.get();
+}
+
+} // namespace Common
+} // namespace Brotli
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
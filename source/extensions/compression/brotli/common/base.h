@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+
+#include "envoy/buffer/buffer.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Brotli {
+namespace Common {
+
+/**
+ * Shared code between the compressor and the decompressor. It holds the input and output
+ * positions in the form taken by the brotli streaming functions.
+ */
+class Base {
+public:
+  Base(uint32_t chunk_size);
+
+protected:
+  void setInput(const Buffer::RawSlice& input_slice);
+  void updateOutput(Buffer::Instance& output_buffer);
+
+  const uint32_t chunk_size_;
+  const std::unique_ptr<uint8_t[]> chunk_ptr_;
+  size_t avail_in_{0};
+  const uint8_t* next_in_{nullptr};
+  size_t avail_out_;
+  uint8_t* next_out_;
+};
+
+} // namespace Common
+} // namespace Brotli
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,79 @@
+#include "extensions/compression/brotli/compressor/brotli_compressor_impl.h"
+
+#include "common/common/assert.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Brotli {
+namespace Compressor {
+
+BrotliEncoderDictionary::BrotliEncoderDictionary(std::string content)
+    : content_(std::move(content)),
+      prepared_(BrotliEncoderPrepareDictionary(BROTLI_SHARED_DICTIONARY_RAW, content_.size(),
+                                               reinterpret_cast<const uint8_t*>(content_.data()),
+                                               BROTLI_MAX_QUALITY, nullptr, nullptr, nullptr),
+                &BrotliEncoderDestroyPreparedDictionary) {
+  RELEASE_ASSERT(prepared_ != nullptr, "");
+}
+
+BrotliCompressorImpl::BrotliCompressorImpl(uint32_t quality, uint32_t window_bits,
+                                           EncoderMode mode,
+                                           BrotliEncoderDictionaryConstSharedPtr dictionary,
+                                           uint32_t chunk_size)
+    : Common::Base(chunk_size),
+      state_(BrotliEncoderCreateInstance(nullptr, nullptr, nullptr), &BrotliEncoderDestroyInstance),
+      dictionary_(std::move(dictionary)) {
+  RELEASE_ASSERT(state_ != nullptr, "");
+  RELEASE_ASSERT(BrotliEncoderSetParameter(state_.get(), BROTLI_PARAM_QUALITY, quality), "");
+  RELEASE_ASSERT(BrotliEncoderSetParameter(state_.get(), BROTLI_PARAM_LGWIN, window_bits), "");
+  RELEASE_ASSERT(
+      BrotliEncoderSetParameter(state_.get(), BROTLI_PARAM_MODE, static_cast<uint32_t>(mode)), "");
+  if (dictionary_ != nullptr) {
+    RELEASE_ASSERT(
+        BrotliEncoderAttachPreparedDictionary(state_.get(), dictionary_->prepared()), "");
+  }
+}
+
+void BrotliCompressorImpl::compress(Buffer::Instance& buffer,
+                                    Envoy::Compression::Compressor::State state) {
+  for (const Buffer::RawSlice& input_slice : buffer.getRawSlices()) {
+    setInput(input_slice);
+    // As with zlib, BROTLI_OPERATION_PROCESS lets brotli buffer the input to compress it in
+    // blocks, and only full output chunks are appended to the end of the buffer, which is drained
+    // from the beginning by the size of the input.
+    process(buffer, BROTLI_OPERATION_PROCESS);
+    buffer.drain(input_slice.len_);
+  }
+
+  setInput({nullptr, 0});
+  process(buffer, state == Envoy::Compression::Compressor::State::Finish
+                      ? BROTLI_OPERATION_FINISH
+                      : BROTLI_OPERATION_FLUSH);
+}
+
+void BrotliCompressorImpl::process(Buffer::Instance& output_buffer,
+                                   BrotliEncoderOperation operation) {
+  // Brotli keeps the output it has no room for until it's called again, so it's called until all
+  // the input is taken in and all the output is out, and for the last block, until the stream is
+  // finished.
+  do {
+    RELEASE_ASSERT(BrotliEncoderCompressStream(state_.get(), operation, &avail_in_, &next_in_,
+                                               &avail_out_, &next_out_, nullptr),
+                   "");
+    if (avail_out_ == 0) {
+      updateOutput(output_buffer);
+    }
+  } while (avail_in_ > 0 || BrotliEncoderHasMoreOutput(state_.get()) ||
+           (operation == BROTLI_OPERATION_FINISH && !BrotliEncoderIsFinished(state_.get())));
+
+  if (operation != BROTLI_OPERATION_PROCESS) {
+    updateOutput(output_buffer);
+  }
+}
+
+} // namespace Compressor
+} // namespace Brotli
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "envoy/compression/compressor/compressor.h"
+
+#include "extensions/compression/brotli/common/base.h"
+
+#include "brotli/encode.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Brotli {
+namespace Compressor {
+
+/**
+ * A raw dictionary, prepared once for the encoder and shared by all the compressors, whatever
+ * their thread.
+ */
+class BrotliEncoderDictionary {
+public:
+  BrotliEncoderDictionary(std::string content);
+
+  const BrotliEncoderPreparedDictionary* prepared() const { return prepared_.get(); }
+
+private:
+  // The prepared dictionary refers to the content.
+  const std::string content_;
+  const std::unique_ptr<BrotliEncoderPreparedDictionary,
+                        decltype(&BrotliEncoderDestroyPreparedDictionary)>
+      prepared_;
+};
+
+using BrotliEncoderDictionaryConstSharedPtr = std::shared_ptr<const BrotliEncoderDictionary>;
+
+/**
+ * Implementation of compressor's interface.
+ */
+class BrotliCompressorImpl : public Common::Base,
+                             public Envoy::Compression::Compressor::Compressor {
+public:
+  /**
+   * Enum values used to tune the compression algorithm for the kind of content.
+   * @see BrotliEncoderMode in the brotli manual.
+   */
+  enum class EncoderMode : uint32_t {
+    Generic = BROTLI_MODE_GENERIC,
+    Text = BROTLI_MODE_TEXT,
+    Font = BROTLI_MODE_FONT,
+    Default = BROTLI_DEFAULT_MODE,
+  };
+
+  /**
+   * @param quality supplies the compression quality, from 0 to 11.
+   * @param window_bits supplies the base two logarithm of the window size, from 10 to 24.
+   * @param mode supplies the kind of content. @see EncoderMode enum
+   * @param dictionary supplies the dictionary to compress with, or nullptr.
+   * @param chunk_size supplies the amount of memory reserved for the compressor output.
+   */
+  BrotliCompressorImpl(uint32_t quality, uint32_t window_bits, EncoderMode mode,
+                       BrotliEncoderDictionaryConstSharedPtr dictionary, uint32_t chunk_size);
+
+  // Compression::Compressor::Compressor
+  void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State state) override;
+
+private:
+  void process(Buffer::Instance& output_buffer, BrotliEncoderOperation operation);
+
+  const std::unique_ptr<BrotliEncoderState, decltype(&BrotliEncoderDestroyInstance)> state_;
+  // Keeps the dictionary attached to state_ alive.
+  const BrotliEncoderDictionaryConstSharedPtr dictionary_;
+};
+
+} // namespace Compressor
+} // namespace Brotli
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,71 @@
+#include "extensions/compression/brotli/compressor/config.h"
+
+#include "common/config/datasource.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Brotli {
+namespace Compressor {
+
+namespace {
+// Default brotli quality. The brotli default of 11 is meant for static content, and is too slow
+// to compress on the fly.
+const uint32_t DefaultQuality = 3;
+
+// Default compression window size, which is BROTLI_DEFAULT_WINDOW.
+const uint32_t DefaultWindowBits = 18;
+
+// Default brotli chunk size.
+const uint32_t DefaultChunkSize = 4096;
+} // namespace
+
+BrotliCompressorFactory::BrotliCompressorFactory(
+    const envoy::extensions::compression::brotli::compressor::v3::Brotli& brotli, Api::Api& api)
+    : quality_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(brotli, quality, DefaultQuality)),
+      window_bits_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(brotli, window_bits, DefaultWindowBits)),
+      encoder_mode_(encoderModeEnum(brotli.encoder_mode())),
+      chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(brotli, chunk_size, DefaultChunkSize)) {
+  if (brotli.has_dictionary()) {
+    dictionary_ = std::make_shared<const BrotliEncoderDictionary>(
+        Config::DataSource::read(brotli.dictionary(), false, api));
+  }
+}
+
+BrotliCompressorImpl::EncoderMode BrotliCompressorFactory::encoderModeEnum(
+    envoy::extensions::compression::brotli::compressor::v3::Brotli::EncoderMode encoder_mode) {
+  switch (encoder_mode) {
+  case envoy::extensions::compression::brotli::compressor::v3::Brotli::GENERIC:
+    return BrotliCompressorImpl::EncoderMode::Generic;
+  case envoy::extensions::compression::brotli::compressor::v3::Brotli::TEXT:
+    return BrotliCompressorImpl::EncoderMode::Text;
+  case envoy::extensions::compression::brotli::compressor::v3::Brotli::FONT:
+    return BrotliCompressorImpl::EncoderMode::Font;
+  default:
+    return BrotliCompressorImpl::EncoderMode::Default;
+  }
+}
+
+Envoy::Compression::Compressor::CompressorPtr BrotliCompressorFactory::createCompressor() {
+  return std::make_unique<BrotliCompressorImpl>(quality_, window_bits_, encoder_mode_, dictionary_,
+                                                chunk_size_);
+}
+
+Envoy::Compression::Compressor::CompressorFactoryPtr
+BrotliCompressorLibraryFactory::createCompressorFactoryFromProtoTyped(
+    const envoy::extensions::compression::brotli::compressor::v3::Brotli& proto_config,
+    Server::Configuration::FactoryContext& context) {
+  return std::make_unique<BrotliCompressorFactory>(proto_config, context.api());
+}
+
+/**
+ * Static registration for the brotli compressor library. @see NamedCompressorLibraryConfigFactory.
+ */
+REGISTER_FACTORY(BrotliCompressorLibraryFactory,
+                 Envoy::Compression::Compressor::NamedCompressorLibraryConfigFactory);
+
+} // namespace Compressor
+} // namespace Brotli
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
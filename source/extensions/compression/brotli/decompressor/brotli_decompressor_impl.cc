@@ -0,0 +1,64 @@
+#include "extensions/compression/brotli/decompressor/brotli_decompressor_impl.h"
+
+#include "common/common/assert.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Brotli {
+namespace Decompressor {
+
+BrotliDecompressorImpl::BrotliDecompressorImpl(std::shared_ptr<const std::string> dictionary,
+                                               uint32_t chunk_size)
+    : Common::Base(chunk_size),
+      state_(BrotliDecoderCreateInstance(nullptr, nullptr, nullptr), &BrotliDecoderDestroyInstance),
+      dictionary_(std::move(dictionary)) {
+  RELEASE_ASSERT(state_ != nullptr, "");
+  if (dictionary_ != nullptr) {
+    RELEASE_ASSERT(BrotliDecoderAttachDictionary(
+                       state_.get(), BROTLI_SHARED_DICTIONARY_RAW, dictionary_->size(),
+                       reinterpret_cast<const uint8_t*>(dictionary_->data())),
+                   "");
+  }
+}
+
+void BrotliDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
+                                        Buffer::Instance& output_buffer) {
+  for (const Buffer::RawSlice& input_slice : input_buffer.getRawSlices()) {
+    setInput(input_slice);
+    if (!process(output_buffer)) {
+      break;
+    }
+  }
+
+  // Flush the output chunk. Otherwise its content would pollute the output upon the next call to
+  // decompress().
+  updateOutput(output_buffer);
+}
+
+bool BrotliDecompressorImpl::process(Buffer::Instance& output_buffer) {
+  while (true) {
+    const BrotliDecoderResult result = BrotliDecoderDecompressStream(
+        state_.get(), &avail_in_, &next_in_, &avail_out_, &next_out_, nullptr);
+    if (result == BROTLI_DECODER_RESULT_ERROR) {
+      decompression_error_ = BrotliDecoderGetErrorCode(state_.get());
+      ENVOY_LOG(trace, "brotli decompression error: {}",
+                BrotliDecoderErrorString(BrotliDecoderGetErrorCode(state_.get())));
+      return false;
+    }
+
+    if (avail_out_ == 0) {
+      updateOutput(output_buffer);
+    }
+    if (result != BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT) {
+      // Either all the input was taken in, or the stream is complete.
+      return true;
+    }
+  }
+}
+
+} // namespace Decompressor
+} // namespace Brotli
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "envoy/compression/decompressor/decompressor.h"
+
+#include "common/common/logger.h"
+
+#include "extensions/compression/brotli/common/base.h"
+
+#include "brotli/decode.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Brotli {
+namespace Decompressor {
+
+/**
+ * Implementation of decompressor's interface.
+ */
+class BrotliDecompressorImpl : public Common::Base,
+                               public Envoy::Compression::Decompressor::Decompressor,
+                               public Logger::Loggable<Logger::Id::decompression> {
+public:
+  /**
+   * @param dictionary supplies the raw dictionary the content was compressed with, or nullptr.
+   *        The decoder refers to it, so it is shared rather than copied.
+   * @param chunk_size supplies the amount of memory reserved for the decompressor output.
+   */
+  BrotliDecompressorImpl(std::shared_ptr<const std::string> dictionary, uint32_t chunk_size);
+
+  // Compression::Decompressor::Decompressor
+  void decompress(const Buffer::Instance& input_buffer, Buffer::Instance& output_buffer) override;
+
+  // Flag to track whether error occurred during decompression.
+  // When an error occurs, the error code (a negative BrotliDecoderErrorCode) will be stored in
+  // this variable.
+  int decompression_error_{0};
+
+private:
+  bool process(Buffer::Instance& output_buffer);
+
+  const std::unique_ptr<BrotliDecoderState, decltype(&BrotliDecoderDestroyInstance)> state_;
+  const std::shared_ptr<const std::string> dictionary_;
+};
+
+} // namespace Decompressor
+} // namespace Brotli
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
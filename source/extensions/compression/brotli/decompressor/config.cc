@@ -0,0 +1,44 @@
+#include "extensions/compression/brotli/decompressor/config.h"
+
+#include "common/config/datasource.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Brotli {
+namespace Decompressor {
+
+namespace {
+const uint32_t DefaultChunkSize = 4096;
+} // namespace
+
+BrotliDecompressorFactory::BrotliDecompressorFactory(
+    const envoy::extensions::compression::brotli::decompressor::v3::Brotli& brotli, Api::Api& api)
+    : chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(brotli, chunk_size, DefaultChunkSize)) {
+  if (brotli.has_dictionary()) {
+    dictionary_ = std::make_shared<const std::string>(
+        Config::DataSource::read(brotli.dictionary(), false, api));
+  }
+}
+
+Envoy::Compression::Decompressor::DecompressorPtr BrotliDecompressorFactory::createDecompressor() {
+  return std::make_unique<BrotliDecompressorImpl>(dictionary_, chunk_size_);
+}
+
+Envoy::Compression::Decompressor::DecompressorFactoryPtr
+BrotliDecompressorLibraryFactory::createDecompressorFactoryFromProtoTyped(
+    const envoy::extensions::compression::brotli::decompressor::v3::Brotli& proto_config,
+    Server::Configuration::FactoryContext& context) {
+  return std::make_unique<BrotliDecompressorFactory>(proto_config, context.api());
+}
+
+/**
+ * Static registration for the brotli decompressor. @see NamedDecompressorLibraryConfigFactory.
+ */
+REGISTER_FACTORY(BrotliDecompressorLibraryFactory,
+                 Envoy::Compression::Decompressor::NamedDecompressorLibraryConfigFactory);
+} // namespace Decompressor
+} // namespace Brotli
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -59,7 +59,8 @@ public:
 
 private:
   Envoy::Compression::Compressor::CompressorFactoryPtr createCompressorFactoryFromProtoTyped(
-      const envoy::extensions::compression::gzip::compressor::v3::Gzip& config) override;
+      const envoy::extensions::compression::gzip::compressor::v3::Gzip& config,
+      Server::Configuration::FactoryContext& context) override;
 };
 
 DECLARE_FACTORY(GzipCompressorLibraryFactory);
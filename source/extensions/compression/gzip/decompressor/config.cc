@@ -28,7 +28,8 @@ Envoy::Compression::Decompressor::DecompressorPtr GzipDecompressorFactory::creat
 
 Envoy::Compression::Decompressor::DecompressorFactoryPtr
 GzipDecompressorLibraryFactory::createDecompressorFactoryFromProtoTyped(
-    const envoy::extensions::compression::gzip::decompressor::v3::Gzip& proto_config) {
+    const envoy::extensions::compression::gzip::decompressor::v3::Gzip& proto_config,
+    Server::Configuration::FactoryContext&) {
   return std::make_unique<GzipDecompressorFactory>(proto_config);
 }
 
@@ -47,7 +47,8 @@ public:
 
 private:
   Envoy::Compression::Decompressor::DecompressorFactoryPtr createDecompressorFactoryFromProtoTyped(
-      const envoy::extensions::compression::gzip::decompressor::v3::Gzip& config) override;
+      const envoy::extensions::compression::gzip::decompressor::v3::Gzip& config,
+      Server::Configuration::FactoryContext& context) override;
 };
 
 DECLARE_FACTORY(GzipDecompressorLibraryFactory);
@@ -0,0 +1,44 @@
+#include "extensions/compression/zstd/common/base.h"
+
+#include "envoy/common/exception.h"
+
+#include "common/config/datasource.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Common {
+
+Base::Base(uint32_t chunk_size)
+    : chunk_size_{chunk_size}, chunk_ptr_{std::make_unique<uint8_t[]>(chunk_size)}, input_{},
+      output_{chunk_ptr_.get(), chunk_size_, 0} {}
+
+void Base::setInput(const Buffer::RawSlice& input_slice) {
+  input_.src = input_slice.mem_;
+  input_.size = input_slice.len_;
+  input_.pos = 0;
+}
+
+void Base::updateOutput(Buffer::Instance& output_buffer) {
+  if (output_.pos == 0) {
+    return;
+  }
+
+  output_buffer.add(static_cast<void*>(chunk_ptr_.get()), output_.pos);
+  output_.pos = 0;
+}
+
+std::string readDictionary(const envoy::config::core::v3::DataSource& source, Api::Api& api) {
+  std::string dictionary = Config::DataSource::read(source, false, api);
+  if (ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size()) == 0) {
+    throw EnvoyException("zstd dictionary has no dictionary ID; it must be trained with zstd");
+  }
+  return dictionary;
+}
+
+} // namespace Common
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
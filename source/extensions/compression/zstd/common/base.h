@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+
+#include "envoy/api/api.h"
+#include "envoy/buffer/buffer.h"
+#include "envoy/config/core/v3/base.pb.h"
+
+#define ZSTD_STATIC_LINKING_ONLY
+#include "zstd.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Common {
+
+/**
+ * Shared code between the compressor and the decompressor.
+ */
+class Base {
+public:
+  Base(uint32_t chunk_size);
+
+protected:
+  void setInput(const Buffer::RawSlice& input_slice);
+  void updateOutput(Buffer::Instance& output_buffer);
+
+  const uint32_t chunk_size_;
+  const std::unique_ptr<uint8_t[]> chunk_ptr_;
+  ZSTD_inBuffer input_;
+  ZSTD_outBuffer output_;
+};
+
+/**
+ * Read a dictionary trained by zstd from a data source.
+ * @param source supplies the data source of the dictionary.
+ * @param api supplies the API used to read files.
+ * @return the content of the dictionary.
+ * @throw EnvoyException if the dictionary can't be read or has no ID, which is the case of raw
+ *        content that was not trained as a dictionary.
+ */
+std::string readDictionary(const envoy::config::core::v3::DataSource& source, Api::Api& api);
+
+} // namespace Common
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,52 @@
+#include "extensions/compression/zstd/compressor/config.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Compressor {
+
+namespace {
+// Default zstd compression level, which is ZSTD_CLEVEL_DEFAULT.
+const uint32_t DefaultCompressionLevel = 3;
+
+// Default zstd chunk size.
+const uint32_t DefaultChunkSize = 4096;
+} // namespace
+
+ZstdCompressorFactory::ZstdCompressorFactory(
+    const envoy::extensions::compression::zstd::compressor::v3::Zstd& zstd, Api::Api& api)
+    : compression_level_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(zstd, compression_level, DefaultCompressionLevel)),
+      window_log_(zstd.has_window_log() ? absl::make_optional(zstd.window_log().value())
+                                        : absl::nullopt),
+      enable_checksum_(zstd.enable_checksum()),
+      chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(zstd, chunk_size, DefaultChunkSize)) {
+  if (zstd.has_dictionary()) {
+    dictionary_ = createCDict(Common::readDictionary(zstd.dictionary(), api), compression_level_);
+  }
+}
+
+Envoy::Compression::Compressor::CompressorPtr ZstdCompressorFactory::createCompressor() {
+  return std::make_unique<ZstdCompressorImpl>(compression_level_, window_log_, enable_checksum_,
+                                              dictionary_, chunk_size_);
+}
+
+Envoy::Compression::Compressor::CompressorFactoryPtr
+ZstdCompressorLibraryFactory::createCompressorFactoryFromProtoTyped(
+    const envoy::extensions::compression::zstd::compressor::v3::Zstd& proto_config,
+    Server::Configuration::FactoryContext& context) {
+  return std::make_unique<ZstdCompressorFactory>(proto_config, context.api());
+}
+
+/**
+ * Static registration for the zstd compressor library. @see NamedCompressorLibraryConfigFactory.
+ */
+REGISTER_FACTORY(ZstdCompressorLibraryFactory,
+                 Envoy::Compression::Compressor::NamedCompressorLibraryConfigFactory);
+
+} // namespace Compressor
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,77 @@
+#include "extensions/compression/zstd/compressor/zstd_compressor_impl.h"
+
+#include "common/common/assert.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Compressor {
+
+ZstdCDictSharedPtr createCDict(const std::string& dictionary, uint32_t compression_level) {
+  ZSTD_CDict* cdict = ZSTD_createCDict(dictionary.data(), dictionary.size(), compression_level);
+  RELEASE_ASSERT(cdict != nullptr, "");
+  return {cdict, [](const ZSTD_CDict* cdict) { ZSTD_freeCDict(const_cast<ZSTD_CDict*>(cdict)); }};
+}
+
+ZstdCompressorImpl::ZstdCompressorImpl(uint32_t compression_level,
+                                       absl::optional<uint32_t> window_log, bool enable_checksum,
+                                       ZstdCDictSharedPtr dictionary, uint32_t chunk_size)
+    : Common::Base(chunk_size), cctx_(ZSTD_createCCtx(), &ZSTD_freeCCtx),
+      dictionary_(std::move(dictionary)) {
+  RELEASE_ASSERT(cctx_ != nullptr, "");
+  setParameter(ZSTD_c_compressionLevel, compression_level);
+  setParameter(ZSTD_c_checksumFlag, enable_checksum);
+  if (window_log.has_value()) {
+    setParameter(ZSTD_c_windowLog, window_log.value());
+  }
+  if (dictionary_ != nullptr) {
+    const size_t result = ZSTD_CCtx_refCDict(cctx_.get(), dictionary_.get());
+    RELEASE_ASSERT(!ZSTD_isError(result), ZSTD_getErrorName(result));
+  }
+}
+
+void ZstdCompressorImpl::setParameter(ZSTD_cParameter parameter, int value) {
+  const size_t result = ZSTD_CCtx_setParameter(cctx_.get(), parameter, value);
+  RELEASE_ASSERT(!ZSTD_isError(result), ZSTD_getErrorName(result));
+}
+
+void ZstdCompressorImpl::compress(Buffer::Instance& buffer,
+                                  Envoy::Compression::Compressor::State state) {
+  for (const Buffer::RawSlice& input_slice : buffer.getRawSlices()) {
+    setInput(input_slice);
+    // As with zlib, ZSTD_e_continue lets zstd buffer the input to compress it in blocks, and only
+    // full output chunks are appended to the end of the buffer, which is drained from the
+    // beginning by the size of the input.
+    process(buffer, ZSTD_e_continue);
+    buffer.drain(input_slice.len_);
+  }
+
+  setInput({nullptr, 0});
+  process(buffer, state == Envoy::Compression::Compressor::State::Finish ? ZSTD_e_end
+                                                                          : ZSTD_e_flush);
+}
+
+void ZstdCompressorImpl::process(Buffer::Instance& output_buffer, ZSTD_EndDirective mode) {
+  // With ZSTD_e_continue, zstd returns once all the input is consumed. With ZSTD_e_flush and
+  // ZSTD_e_end, the result is the amount of data left to flush, so it is called until it's 0.
+  bool finished = false;
+  while (!finished) {
+    const size_t remaining = ZSTD_compressStream2(cctx_.get(), &output_, &input_, mode);
+    RELEASE_ASSERT(!ZSTD_isError(remaining), ZSTD_getErrorName(remaining));
+    if (output_.pos == output_.size) {
+      updateOutput(output_buffer);
+    }
+    finished = mode == ZSTD_e_continue ? input_.pos == input_.size : remaining == 0;
+  }
+
+  if (mode != ZSTD_e_continue) {
+    updateOutput(output_buffer);
+  }
+}
+
+} // namespace Compressor
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
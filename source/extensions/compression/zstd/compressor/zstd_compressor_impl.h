@@ -0,0 +1,62 @@
+#pragma once
+
+#include "envoy/compression/compressor/compressor.h"
+
+#include "extensions/compression/zstd/common/base.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Compressor {
+
+/**
+ * A compression dictionary, digested for a compression level. It is immutable, so that it can be
+ * shared by all the compressors, whatever their thread.
+ */
+using ZstdCDictSharedPtr = std::shared_ptr<const ZSTD_CDict>;
+
+/**
+ * Digest a dictionary for compressing at a given level.
+ * @param dictionary supplies the content of the dictionary.
+ * @param compression_level supplies the compression level.
+ */
+ZstdCDictSharedPtr createCDict(const std::string& dictionary, uint32_t compression_level);
+
+/**
+ * Implementation of compressor's interface.
+ */
+class ZstdCompressorImpl : public Common::Base, public Envoy::Compression::Compressor::Compressor {
+public:
+  /**
+   * @param compression_level supplies the compression level, from 1 to ZSTD_maxCLevel().
+   * @param window_log supplies the base two logarithm of the window size, or absl::nullopt to
+   *        size the window according to the compression level.
+   * @param enable_checksum supplies whether to write a checksum of the content at the end of the
+   *        stream.
+   * @param dictionary supplies the dictionary to compress with, or nullptr. It must have been
+   *        created for compression_level.
+   * @param chunk_size supplies the amount of memory reserved for the compressor output.
+   */
+  ZstdCompressorImpl(uint32_t compression_level, absl::optional<uint32_t> window_log,
+                     bool enable_checksum, ZstdCDictSharedPtr dictionary, uint32_t chunk_size);
+
+  // Compression::Compressor::Compressor
+  void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State state) override;
+
+private:
+  void setParameter(ZSTD_cParameter parameter, int value);
+  void process(Buffer::Instance& output_buffer, ZSTD_EndDirective mode);
+
+  const std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx_;
+  // Keeps the dictionary referenced by cctx_ alive.
+  const ZstdCDictSharedPtr dictionary_;
+};
+
+} // namespace Compressor
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,48 @@
+#include "extensions/compression/zstd/decompressor/config.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Decompressor {
+
+namespace {
+// Default window size limit, which is ZSTD_WINDOWLOG_LIMIT_DEFAULT.
+const uint32_t DefaultWindowLogMax = 27;
+const uint32_t DefaultChunkSize = 4096;
+} // namespace
+
+ZstdDecompressorFactory::ZstdDecompressorFactory(
+    const envoy::extensions::compression::zstd::decompressor::v3::Zstd& zstd, Api::Api& api)
+    : window_log_max_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(zstd, window_log_max, DefaultWindowLogMax)),
+      chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(zstd, chunk_size, DefaultChunkSize)) {
+  if (!zstd.dictionaries().empty()) {
+    std::vector<std::string> dictionaries;
+    for (const auto& dictionary : zstd.dictionaries()) {
+      dictionaries.push_back(Common::readDictionary(dictionary, api));
+    }
+    dictionaries_ = std::make_shared<const ZstdDDicts>(dictionaries);
+  }
+}
+
+Envoy::Compression::Decompressor::DecompressorPtr ZstdDecompressorFactory::createDecompressor() {
+  return std::make_unique<ZstdDecompressorImpl>(window_log_max_, dictionaries_, chunk_size_);
+}
+
+Envoy::Compression::Decompressor::DecompressorFactoryPtr
+ZstdDecompressorLibraryFactory::createDecompressorFactoryFromProtoTyped(
+    const envoy::extensions::compression::zstd::decompressor::v3::Zstd& proto_config,
+    Server::Configuration::FactoryContext& context) {
+  return std::make_unique<ZstdDecompressorFactory>(proto_config, context.api());
+}
+
+/**
+ * Static registration for the zstd decompressor. @see NamedDecompressorLibraryConfigFactory.
+ */
+REGISTER_FACTORY(ZstdDecompressorLibraryFactory,
+                 Envoy::Compression::Decompressor::NamedDecompressorLibraryConfigFactory);
+} // namespace Decompressor
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
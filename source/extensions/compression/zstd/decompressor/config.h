@@ -0,0 +1,62 @@
+#pragma once
+
+#include "envoy/compression/decompressor/config.h"
+#include "envoy/extensions/compression/zstd/decompressor/v3/zstd.pb.h"
+#include "envoy/extensions/compression/zstd/decompressor/v3/zstd.pb.validate.h"
+
+#include "common/http/headers.h"
+
+#include "extensions/compression/common/decompressor/factory_base.h"
+#include "extensions/compression/zstd/decompressor/zstd_decompressor_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Decompressor {
+
+namespace {
+const std::string& zstdStatsPrefix() { CONSTRUCT_ON_FIRST_USE(std::string, "zstd."); }
+const std::string& zstdExtensionName() {
+  CONSTRUCT_ON_FIRST_USE(std::string, "envoy.compression.zstd.decompressor");
+}
+
+} // namespace
+
+class ZstdDecompressorFactory : public Envoy::Compression::Decompressor::DecompressorFactory {
+public:
+  ZstdDecompressorFactory(const envoy::extensions::compression::zstd::decompressor::v3::Zstd& zstd,
+                          Api::Api& api);
+
+  // Envoy::Compression::Decompressor::DecompressorFactory
+  Envoy::Compression::Decompressor::DecompressorPtr createDecompressor() override;
+  const std::string& statsPrefix() const override { return zstdStatsPrefix(); }
+  const std::string& contentEncoding() const override {
+    return Http::Headers::get().ContentEncodingValues.Zstd;
+  }
+
+private:
+  const uint32_t window_log_max_;
+  const uint32_t chunk_size_;
+  ZstdDDictsConstSharedPtr dictionaries_;
+};
+
+class ZstdDecompressorLibraryFactory
+    : public Common::Decompressor::DecompressorLibraryFactoryBase<
+          envoy::extensions::compression::zstd::decompressor::v3::Zstd> {
+public:
+  ZstdDecompressorLibraryFactory() : DecompressorLibraryFactoryBase(zstdExtensionName()) {}
+
+private:
+  Envoy::Compression::Decompressor::DecompressorFactoryPtr createDecompressorFactoryFromProtoTyped(
+      const envoy::extensions::compression::zstd::decompressor::v3::Zstd& config,
+      Server::Configuration::FactoryContext& context) override;
+};
+
+DECLARE_FACTORY(ZstdDecompressorLibraryFactory);
+
+} // namespace Decompressor
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,87 @@
+#include "extensions/compression/zstd/decompressor/zstd_decompressor_impl.h"
+
+#include "envoy/common/exception.h"
+
+#include "common/common/assert.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "zstd_errors.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Decompressor {
+
+ZstdDDicts::ZstdDDicts(const std::vector<std::string>& dictionaries) {
+  absl::flat_hash_set<uint32_t> ids;
+  for (const std::string& dictionary : dictionaries) {
+    ZSTD_DDict* ddict = ZSTD_createDDict(dictionary.data(), dictionary.size());
+    RELEASE_ASSERT(ddict != nullptr, "");
+    ddicts_.emplace_back(ddict, &ZSTD_freeDDict);
+    if (!ids.insert(ZSTD_getDictID_fromDDict(ddict)).second) {
+      throw EnvoyException(fmt::format("duplicate zstd dictionary ID {}",
+                                       ZSTD_getDictID_fromDDict(ddict)));
+    }
+  }
+}
+
+ZstdDecompressorImpl::ZstdDecompressorImpl(uint32_t window_log_max,
+                                           ZstdDDictsConstSharedPtr dictionaries,
+                                           uint32_t chunk_size)
+    : Common::Base(chunk_size), dctx_(ZSTD_createDCtx(), &ZSTD_freeDCtx),
+      dictionaries_(std::move(dictionaries)) {
+  RELEASE_ASSERT(dctx_ != nullptr, "");
+  size_t result = ZSTD_DCtx_setParameter(dctx_.get(), ZSTD_d_windowLogMax, window_log_max);
+  RELEASE_ASSERT(!ZSTD_isError(result), ZSTD_getErrorName(result));
+  if (dictionaries_ != nullptr && !dictionaries_->ddicts().empty()) {
+    // Let zstd pick the dictionary of each frame from its header, rather than only using the last
+    // dictionary referenced.
+    result = ZSTD_DCtx_setParameter(dctx_.get(), ZSTD_d_refMultipleDDicts,
+                                    ZSTD_rmd_refMultipleDDicts);
+    RELEASE_ASSERT(!ZSTD_isError(result), ZSTD_getErrorName(result));
+    for (const auto& ddict : dictionaries_->ddicts()) {
+      result = ZSTD_DCtx_refDDict(dctx_.get(), ddict.get());
+      RELEASE_ASSERT(!ZSTD_isError(result), ZSTD_getErrorName(result));
+    }
+  }
+}
+
+void ZstdDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
+                                      Buffer::Instance& output_buffer) {
+  for (const Buffer::RawSlice& input_slice : input_buffer.getRawSlices()) {
+    setInput(input_slice);
+    if (!process(output_buffer)) {
+      break;
+    }
+  }
+
+  // Flush the output chunk. Otherwise its content would pollute the output upon the next call to
+  // decompress().
+  updateOutput(output_buffer);
+}
+
+bool ZstdDecompressorImpl::process(Buffer::Instance& output_buffer) {
+  // Call zstd until all the input is consumed and it doesn't fill the output chunk anymore, which
+  // means that it doesn't hold decompressed data left to output.
+  while (true) {
+    const size_t result = ZSTD_decompressStream(dctx_.get(), &output_, &input_);
+    if (ZSTD_isError(result)) {
+      decompression_error_ = ZSTD_getErrorCode(result);
+      ENVOY_LOG(trace, "zstd decompression error: {}", ZSTD_getErrorName(result));
+      return false;
+    }
+
+    if (output_.pos == output_.size) {
+      updateOutput(output_buffer);
+    } else if (input_.pos == input_.size) {
+      return true;
+    }
+  }
+}
+
+} // namespace Decompressor
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+
+#include "envoy/compression/decompressor/decompressor.h"
+
+#include "common/common/logger.h"
+
+#include "extensions/compression/zstd/common/base.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Decompressor {
+
+/**
+ * Decompression dictionaries, digested once and shared by all the decompressors, whatever their
+ * thread.
+ */
+class ZstdDDicts {
+public:
+  /**
+   * @param dictionaries supplies the content of the dictionaries.
+   * @throw EnvoyException if several dictionaries have the same ID.
+   */
+  ZstdDDicts(const std::vector<std::string>& dictionaries);
+
+  const std::vector<std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)>>& ddicts() const {
+    return ddicts_;
+  }
+
+private:
+  std::vector<std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)>> ddicts_;
+};
+
+using ZstdDDictsConstSharedPtr = std::shared_ptr<const ZstdDDicts>;
+
+/**
+ * Implementation of decompressor's interface.
+ */
+class ZstdDecompressorImpl : public Common::Base,
+                             public Envoy::Compression::Decompressor::Decompressor,
+                             public Logger::Loggable<Logger::Id::decompression> {
+public:
+  /**
+   * @param window_log_max supplies the base two logarithm of the largest window accepted.
+   * @param dictionaries supplies the dictionaries the content may be compressed with, or nullptr.
+   *        The dictionary of each frame is selected by the dictionary ID in its header.
+   * @param chunk_size supplies the amount of memory reserved for the decompressor output.
+   */
+  ZstdDecompressorImpl(uint32_t window_log_max, ZstdDDictsConstSharedPtr dictionaries,
+                       uint32_t chunk_size);
+
+  // Compression::Decompressor::Decompressor
+  void decompress(const Buffer::Instance& input_buffer, Buffer::Instance& output_buffer) override;
+
+  // Flag to track whether error occurred during decompression.
+  // When an error occurs, the zstd error code (a ZSTD_ErrorCode) will be stored in this variable.
+  int decompression_error_{0};
+
+private:
+  bool process(Buffer::Instance& output_buffer);
+
+  const std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx_;
+  // Keeps the dictionaries referenced by dctx_ alive.
+  const ZstdDDictsConstSharedPtr dictionaries_;
+};
+
+} // namespace Decompressor
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -20,8 +20,12 @@ EXTENSIONS = {
     # Compression
     #
 
+    "envoy.compression.brotli.compressor":              "//source/extensions/compression/brotli/compressor:config",
+    "envoy.compression.brotli.decompressor":            "//source/extensions/compression/brotli/decompressor:config",
     "envoy.compression.gzip.compressor":                "//source/extensions/compression/gzip/compressor:config",
     "envoy.compression.gzip.decompressor":              "//source/extensions/compression/gzip/decompressor:config",
+    "envoy.compression.zstd.compressor":                "//source/extensions/compression/zstd/compressor:config",
+    "envoy.compression.zstd.decompressor":              "//source/extensions/compression/zstd/decompressor:config",
 
     #
     # gRPC Credentials Plugins
@@ -98,6 +102,7 @@ EXTENSIONS = {
     "envoy.filters.network.http_connection_manager":    "//source/extensions/filters/network/http_connection_manager:config",
     # WiP
     "envoy.filters.network.kafka_broker":               "//source/extensions/filters/network/kafka:kafka_broker_config_lib",
+    "envoy.filters.network.kafka_mesh":                 "//source/extensions/filters/network/kafka:kafka_mesh_config_lib",
     "envoy.filters.network.local_ratelimit":            "//source/extensions/filters/network/local_ratelimit:config",
     "envoy.filters.network.mongo_proxy":                "//source/extensions/filters/network/mongo_proxy:config",
     "envoy.filters.network.mysql_proxy":                "//source/extensions/filters/network/mysql_proxy:config",
@@ -123,8 +128,11 @@ EXTENSIONS = {
     # Resource monitors
     #
 
+    "envoy.resource_monitors.dispatcher_load":          "//source/extensions/resource_monitors/dispatcher_load:config",
+    "envoy.resource_monitors.downstream_connections":   "//source/extensions/resource_monitors/downstream_connections:config",
     "envoy.resource_monitors.fixed_heap":               "//source/extensions/resource_monitors/fixed_heap:config",
     "envoy.resource_monitors.injected_resource":        "//source/extensions/resource_monitors/injected_resource:config",
+    "envoy.resource_monitors.pressure_stall":           "//source/extensions/resource_monitors/pressure_stall:config",
 
     #
     # Stat sinks
@@ -162,6 +170,12 @@ EXTENSIONS = {
     "envoy.transport_sockets.raw_buffer":               "//source/extensions/transport_sockets/raw_buffer:config",
     "envoy.transport_sockets.tap":                      "//source/extensions/transport_sockets/tap:config",
 
+    #
+    # Private key providers
+    #
+
+    "envoy.tls.key_providers.thread_pool":              "//source/extensions/private_key_providers/thread_pool:config",
+
     #
     # Retry host predicates
     #
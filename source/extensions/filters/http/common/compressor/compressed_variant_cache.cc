@@ -0,0 +1,62 @@
+#include "extensions/filters/http/common/compressor/compressed_variant_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Common {
+namespace Compressors {
+
+CompressedVariantSharedPtr CompressedVariantCache::lookup(absl::string_view key) {
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lru_position_);
+  return it->second.variant_;
+}
+
+uint64_t CompressedVariantCache::insert(absl::string_view key,
+                                        CompressedVariantSharedPtr variant) {
+  // A body larger than the whole cache would only evict everything else.
+  if (variant->size() > max_cache_bytes_) {
+    return 0;
+  }
+
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    erase(it);
+  }
+  uint64_t evicted = 0;
+  while (bytes_ + variant->size() > max_cache_bytes_) {
+    erase(entries_.find(lru_.back()));
+    ++evicted;
+  }
+  bytes_ += variant->size();
+  lru_.emplace_front(key);
+  entries_.emplace(key, Entry{std::move(variant), lru_.begin()});
+  return evicted;
+}
+
+void CompressedVariantCache::erase(absl::flat_hash_map<std::string, Entry>::iterator it) {
+  bytes_ -= it->second.variant_->size();
+  lru_.erase(it->second.lru_position_);
+  entries_.erase(it);
+}
+
+uint64_t CompressedVariantCache::size() const {
+  absl::MutexLock lock(&mutex_);
+  return entries_.size();
+}
+
+uint64_t CompressedVariantCache::bytes() const {
+  absl::MutexLock lock(&mutex_);
+  return bytes_;
+}
+
+} // namespace Compressors
+} // namespace Common
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
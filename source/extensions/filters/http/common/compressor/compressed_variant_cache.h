@@ -0,0 +1,72 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Common {
+namespace Compressors {
+
+using CompressedVariantSharedPtr = std::shared_ptr<const std::string>;
+
+/**
+ * A cache of compressed response bodies, bounded by their total size and evicting the least
+ * recently used bodies when full. This is shared by the worker threads of a filter config, so
+ * that a body is only compressed once no matter which worker serves it.
+ */
+class CompressedVariantCache {
+public:
+  CompressedVariantCache(uint64_t max_cache_bytes, uint32_t max_body_bytes)
+      : max_cache_bytes_(max_cache_bytes), max_body_bytes_(max_body_bytes) {}
+
+  /**
+   * @return the compressed body cached for a key, or nullptr.
+   */
+  CompressedVariantSharedPtr lookup(absl::string_view key);
+
+  /**
+   * Cache the compressed body for a key, replacing any body cached for it.
+   * @return the number of bodies evicted to make room for it.
+   */
+  uint64_t insert(absl::string_view key, CompressedVariantSharedPtr variant);
+
+  /**
+   * @return the maximum content length of the responses to cache.
+   */
+  uint32_t maxBodyBytes() const { return max_body_bytes_; }
+
+  uint64_t size() const;
+  uint64_t bytes() const;
+
+private:
+  struct Entry {
+    CompressedVariantSharedPtr variant_;
+    std::list<std::string>::iterator lru_position_;
+  };
+
+  void erase(absl::flat_hash_map<std::string, Entry>::iterator it)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const uint64_t max_cache_bytes_;
+  const uint32_t max_body_bytes_;
+  mutable absl::Mutex mutex_;
+  // Most recently used first.
+  std::list<std::string> lru_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<std::string, Entry> entries_ ABSL_GUARDED_BY(mutex_);
+  uint64_t bytes_ ABSL_GUARDED_BY(mutex_){0};
+};
+
+using CompressedVariantCachePtr = std::unique_ptr<CompressedVariantCache>;
+
+} // namespace Compressors
+} // namespace Common
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -1,6 +1,8 @@
 #include "extensions/filters/http/common/compressor/compressor.h"
 
 #include "common/buffer/buffer_impl.h"
+#include "common/common/hex.h"
+#include "common/crypto/utility.h"
 #include "common/http/header_map_impl.h"
 
 namespace Envoy {
@@ -14,6 +16,9 @@ namespace {
 // Default minimum length of an upstream response that allows compression.
 const uint64_t DefaultMinimumContentLength = 30;
 
+// Default maximum length of an upstream response whose compressed body is cached.
+const uint32_t DefaultMaxCachedBodyBytes = 1024 * 1024;
+
 // Default content types will be used if any is provided by the user.
 const std::vector<std::string>& defaultContentEncoding() {
   CONSTRUCT_ON_FIRST_USE(
@@ -32,6 +37,22 @@ struct CompressorRegistry : public StreamInfo::FilterState::Object {
 // Key to per stream CompressorRegistry objects.
 const std::string& compressorRegistryKey() { CONSTRUCT_ON_FIRST_USE(std::string, "compressors"); }
 
+const Http::LowerCaseString& contentRangeHeader() {
+  CONSTRUCT_ON_FIRST_USE(Http::LowerCaseString, "content-range");
+}
+
+// Only complete representations are cached: a partial response shares the etag of the complete
+// one, so caching it would serve a fragment of the body as the whole, and the reverse.
+bool isCompleteResponse(const Http::ResponseHeaderMap& headers) {
+  return headers.getStatusValue() == "200" && headers.get(contentRangeHeader()) == nullptr;
+}
+
+// Weak etags only guarantee that representations are semantically equivalent, not that their
+// bodies are identical.
+bool isStrongEtag(absl::string_view value) {
+  return value.length() > 2 && !((value[0] == 'w' || value[0] == 'W') && value[1] == '/');
+}
+
 } // namespace
 
 CompressorFilterConfig::CompressorFilterConfig(
@@ -43,7 +64,8 @@ CompressorFilterConfig::CompressorFilterConfig(
       disable_on_etag_header_(compressor.disable_on_etag_header()),
       remove_accept_encoding_header_(compressor.remove_accept_encoding_header()),
       stats_(generateStats(stats_prefix, scope)), enabled_(compressor.runtime_enabled(), runtime),
-      content_encoding_(content_encoding) {}
+      content_encoding_(content_encoding),
+      compressed_variant_cache_(createCompressedVariantCache(compressor)) {}
 
 StringUtil::CaseUnorderedSet
 CompressorFilterConfig::contentTypeSet(const Protobuf::RepeatedPtrField<std::string>& types) {
@@ -57,6 +79,17 @@ uint32_t CompressorFilterConfig::contentLengthUint(Protobuf::uint32 length) {
   return length > 0 ? length : DefaultMinimumContentLength;
 }
 
+CompressedVariantCachePtr CompressorFilterConfig::createCompressedVariantCache(
+    const envoy::extensions::filters::http::compressor::v3::Compressor& compressor) {
+  if (!compressor.has_compressed_variant_cache()) {
+    return nullptr;
+  }
+  const auto& cache_config = compressor.compressed_variant_cache();
+  return std::make_unique<CompressedVariantCache>(
+      cache_config.max_cache_bytes(),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(cache_config, max_body_bytes, DefaultMaxCachedBodyBytes));
+}
+
 CompressorFilter::CompressorFilter(const CompressorFilterConfigSharedPtr config)
     : skip_compression_{true}, config_(std::move(config)) {}
 
@@ -72,6 +105,10 @@ Http::FilterHeadersStatus CompressorFilter::decodeHeaders(Http::RequestHeaderMap
     headers.removeAcceptEncoding();
   }
 
+  if (config_->compressedVariantCache() != nullptr) {
+    request_key_ = absl::StrCat(headers.getHostValue(), headers.getPathValue(), "\n");
+  }
+
   return Http::FilterHeadersStatus::Continue;
 }
 
@@ -105,13 +142,18 @@ Http::FilterHeadersStatus CompressorFilter::encodeHeaders(Http::ResponseHeaderMa
       !hasCacheControlNoTransform(headers) && isEtagAllowed(headers) &&
       isTransferEncodingAllowed(headers) && !headers.ContentEncoding()) {
     skip_compression_ = false;
+    lookupVariantByEtag(headers);
     sanitizeEtagHeader(headers);
     insertVaryHeader(headers);
     headers.removeContentLength();
     headers.setContentEncoding(config_->contentEncoding());
     config_->stats().compressed_.inc();
-    // Finally instantiate the compressor.
-    compressor_ = config_->makeCompressor();
+    // Finally instantiate the compressor. Responses looked up by their body only need one if they
+    // are not found.
+    if (variant_cache_state_ == VariantCacheState::Disabled ||
+        variant_cache_state_ == VariantCacheState::Insert) {
+      compressor_ = config_->makeCompressor();
+    }
   } else {
     config_->stats().not_compressed_.inc();
   }
@@ -121,8 +163,9 @@ Http::FilterHeadersStatus CompressorFilter::encodeHeaders(Http::ResponseHeaderMa
 Http::FilterDataStatus CompressorFilter::encodeData(Buffer::Instance& data, bool end_stream) {
   if (!skip_compression_) {
     config_->stats().total_uncompressed_bytes_.add(data.length());
-    compressor_->compress(data, end_stream ? Envoy::Compression::Compressor::State::Finish
-                                           : Envoy::Compression::Compressor::State::Flush);
+    if (!compressData(data, end_stream)) {
+      return Http::FilterDataStatus::StopIterationNoBuffer;
+    }
     config_->stats().total_compressed_bytes_.add(data.length());
   }
   return Http::FilterDataStatus::Continue;
@@ -131,13 +174,119 @@ Http::FilterDataStatus CompressorFilter::encodeData(Buffer::Instance& data, bool
 Http::FilterTrailersStatus CompressorFilter::encodeTrailers(Http::ResponseTrailerMap&) {
   if (!skip_compression_) {
     Buffer::OwnedImpl empty_buffer;
-    compressor_->compress(empty_buffer, Envoy::Compression::Compressor::State::Finish);
+    compressData(empty_buffer, true);
     config_->stats().total_compressed_bytes_.add(empty_buffer.length());
     encoder_callbacks_->addEncodedData(empty_buffer, true);
   }
   return Http::FilterTrailersStatus::Continue;
 }
 
+// Responses are only cached if complete and their length is known, so that they are never buffered
+// past the maximum body size of the cache.
+void CompressorFilter::lookupVariantByEtag(Http::ResponseHeaderMap& headers) {
+  CompressedVariantCache* cache = config_->compressedVariantCache();
+  if (cache == nullptr) {
+    return;
+  }
+  uint64_t content_length;
+  if (!isCompleteResponse(headers) || headers.ContentLength() == nullptr ||
+      !absl::SimpleAtoi(headers.getContentLengthValue(), &content_length) ||
+      content_length > cache->maxBodyBytes()) {
+    return;
+  }
+
+  const Http::HeaderEntry* etag = headers.Etag();
+  if (etag == nullptr || !isStrongEtag(etag->value().getStringView())) {
+    variant_cache_state_ = VariantCacheState::LookupByBody;
+    return;
+  }
+  variant_key_ = absl::StrCat("etag:", request_key_, etag->value().getStringView());
+  cached_variant_ = cache->lookup(variant_key_);
+  if (cached_variant_ != nullptr) {
+    variant_cache_state_ = VariantCacheState::Hit;
+    config_->stats().compressed_variant_cache_hit_.inc();
+  } else {
+    variant_cache_state_ = VariantCacheState::Insert;
+    config_->stats().compressed_variant_cache_miss_.inc();
+  }
+}
+
+bool CompressorFilter::compressData(Buffer::Instance& data, bool end_stream) {
+  switch (variant_cache_state_) {
+  case VariantCacheState::Hit:
+    data.drain(data.length());
+    if (!end_stream) {
+      return false;
+    }
+    addCachedVariant(data);
+    return true;
+  case VariantCacheState::LookupByBody:
+    buffered_body_.move(data);
+    if (!end_stream) {
+      return false;
+    }
+    compressBufferedBody(data);
+    return true;
+  case VariantCacheState::Insert:
+    compressor_->compress(data, end_stream ? Envoy::Compression::Compressor::State::Finish
+                                           : Envoy::Compression::Compressor::State::Flush);
+    appendVariant(data);
+    if (end_stream) {
+      insertVariant();
+    }
+    return true;
+  case VariantCacheState::Disabled:
+    compressor_->compress(data, end_stream ? Envoy::Compression::Compressor::State::Finish
+                                           : Envoy::Compression::Compressor::State::Flush);
+    return true;
+  }
+  NOT_REACHED_GCOVR_EXCL_LINE;
+}
+
+// Bodies are keyed by a cryptographic digest, since they are not compared when found: a body
+// crafted to collide with another one would otherwise be sent the compressed body of the latter.
+void CompressorFilter::compressBufferedBody(Buffer::Instance& data) {
+  const std::vector<uint8_t> digest =
+      Envoy::Common::Crypto::UtilitySingleton::get().getSha256Digest(buffered_body_);
+  variant_key_ = absl::StrCat("body:", Hex::encode(digest));
+  cached_variant_ = config_->compressedVariantCache()->lookup(variant_key_);
+  if (cached_variant_ != nullptr) {
+    config_->stats().compressed_variant_cache_hit_.inc();
+    buffered_body_.drain(buffered_body_.length());
+    addCachedVariant(data);
+    return;
+  }
+
+  config_->stats().compressed_variant_cache_miss_.inc();
+  data.move(buffered_body_);
+  compressor_ = config_->makeCompressor();
+  compressor_->compress(data, Envoy::Compression::Compressor::State::Finish);
+  appendVariant(data);
+  insertVariant();
+}
+
+// The compressed data is still sent downstream, so its slices are copied into the variant as is.
+void CompressorFilter::appendVariant(const Buffer::Instance& data) {
+  for (const Buffer::RawSlice& slice : data.getRawSlices()) {
+    compressed_variant_.append(static_cast<const char*>(slice.mem_), slice.len_);
+  }
+}
+
+void CompressorFilter::insertVariant() {
+  const uint64_t evicted = config_->compressedVariantCache()->insert(
+      variant_key_, std::make_shared<const std::string>(std::move(compressed_variant_)));
+  config_->stats().compressed_variant_cache_eviction_.add(evicted);
+}
+
+// The cached variant is referenced rather than copied, and kept alive until sent.
+void CompressorFilter::addCachedVariant(Buffer::Instance& data) {
+  auto fragment = new Buffer::BufferFragmentImpl(
+      cached_variant_->data(), cached_variant_->size(),
+      [variant = cached_variant_](const void*, size_t,
+                                  const Buffer::BufferFragmentImpl* fragment) { delete fragment; });
+  data.addBufferFragment(*fragment);
+}
+
 bool CompressorFilter::hasCacheControlNoTransform(Http::ResponseHeaderMap& headers) const {
   const Http::HeaderEntry* cache_control = headers.CacheControl();
   if (cache_control) {
@@ -416,11 +565,8 @@ void CompressorFilter::insertVaryHeader(Http::ResponseHeaderMap& headers) {
 // the strong ones when disable_on_etag_header is false. Envoy does NOT re-write entity tags.
 void CompressorFilter::sanitizeEtagHeader(Http::ResponseHeaderMap& headers) {
   const Http::HeaderEntry* etag = headers.Etag();
-  if (etag != nullptr) {
-    absl::string_view value(etag->value().getStringView());
-    if (value.length() > 2 && !((value[0] == 'w' || value[0] == 'W') && value[1] == '/')) {
-      headers.removeEtag();
-    }
+  if (etag != nullptr && isStrongEtag(etag->value().getStringView())) {
+    headers.removeEtag();
   }
 }
 
@@ -6,9 +6,11 @@
 #include "envoy/stats/stats_macros.h"
 #include "envoy/stream_info/filter_state.h"
 
+#include "common/buffer/buffer_impl.h"
 #include "common/protobuf/protobuf.h"
 #include "common/runtime/runtime_protos.h"
 
+#include "extensions/filters/http/common/compressor/compressed_variant_cache.h"
 #include "extensions/filters/http/common/pass_through_filter.h"
 
 namespace Envoy {
@@ -32,6 +34,10 @@ namespace Compressors {
  *
  * "header_gzip" is specific to the gzip filter and is deprecated since it duplicates
  * "header_compressor_used".
+ *
+ * "compressed_variant_cache_hit" and "compressed_variant_cache_miss" only count the responses
+ * eligible for the compressed variant cache. Both cached responses and responses served from the
+ * cache are counted in "total_uncompressed_bytes" and "total_compressed_bytes".
  */
 #define ALL_COMPRESSOR_STATS(COUNTER)                                                              \
   COUNTER(compressed)                                                                              \
@@ -46,7 +52,10 @@ namespace Compressors {
   COUNTER(total_uncompressed_bytes)                                                                \
   COUNTER(total_compressed_bytes)                                                                  \
   COUNTER(content_length_too_small)                                                                \
-  COUNTER(not_compressed_etag)
+  COUNTER(not_compressed_etag)                                                                     \
+  COUNTER(compressed_variant_cache_hit)                                                            \
+  COUNTER(compressed_variant_cache_miss)                                                           \
+  COUNTER(compressed_variant_cache_eviction)
 
 /**
  * Struct definition for compressor stats. @see stats_macros.h
@@ -71,6 +80,10 @@ public:
   bool removeAcceptEncodingHeader() const { return remove_accept_encoding_header_; }
   uint32_t minimumLength() const { return content_length_; }
   const std::string contentEncoding() const { return content_encoding_; };
+  // nullptr if compressed bodies are not cached.
+  CompressedVariantCache* compressedVariantCache() const {
+    return compressed_variant_cache_.get();
+  }
 
 protected:
   CompressorFilterConfig(
@@ -84,6 +97,10 @@ private:
 
   static uint32_t contentLengthUint(Protobuf::uint32 length);
 
+  static CompressedVariantCachePtr
+  createCompressedVariantCache(const envoy::extensions::filters::http::compressor::v3::Compressor&
+                                   compressor);
+
   static CompressorStats generateStats(const std::string& prefix, Stats::Scope& scope) {
     return CompressorStats{ALL_COMPRESSOR_STATS(POOL_COUNTER_PREFIX(scope, prefix))};
   }
@@ -96,6 +113,7 @@ private:
   const CompressorStats stats_;
   Runtime::FeatureFlag enabled_;
   const std::string content_encoding_;
+  const CompressedVariantCachePtr compressed_variant_cache_;
 };
 using CompressorFilterConfigSharedPtr = std::shared_ptr<CompressorFilterConfig>;
 
@@ -132,6 +150,27 @@ private:
   void sanitizeEtagHeader(Http::ResponseHeaderMap& headers);
   void insertVaryHeader(Http::ResponseHeaderMap& headers);
 
+  // How the compressed variant cache is used for the response.
+  enum class VariantCacheState {
+    // The response is not cached.
+    Disabled,
+    // The response body is buffered, and looked up by its SHA-256 digest once complete.
+    LookupByBody,
+    // The response was not found by its etag. Its compressed body is cached once complete.
+    Insert,
+    // The response was found by its etag. Its body is dropped, and the cached variant sent instead.
+    Hit,
+  };
+
+  void lookupVariantByEtag(Http::ResponseHeaderMap& headers);
+  // Compress a chunk of the response body, or replace it with a cached variant.
+  // @return false if the chunk was consumed, and there is nothing to send yet.
+  bool compressData(Buffer::Instance& data, bool end_stream);
+  void compressBufferedBody(Buffer::Instance& data);
+  void appendVariant(const Buffer::Instance& data);
+  void insertVariant();
+  void addCachedVariant(Buffer::Instance& data);
+
   class EncodingDecision : public StreamInfo::FilterState::Object {
   public:
     enum class HeaderStat { NotValid, Identity, Wildcard, ValidCompressor };
@@ -152,6 +191,15 @@ private:
   Envoy::Compression::Compressor::CompressorPtr compressor_;
   const CompressorFilterConfigSharedPtr config_;
   std::unique_ptr<std::string> accept_encoding_;
+
+  VariantCacheState variant_cache_state_{VariantCacheState::Disabled};
+  // The authority and path of the request, to look up its response by etag.
+  std::string request_key_;
+  std::string variant_key_;
+  CompressedVariantSharedPtr cached_variant_;
+  // The compressed body so far, when it is to be cached.
+  std::string compressed_variant_;
+  Buffer::OwnedImpl buffered_body_;
 };
 
 } // namespace Compressors
@@ -19,6 +19,7 @@
 #include "common/http/headers.h"
 #include "common/http/utility.h"
 #include "common/protobuf/utility.h"
+#include "common/runtime/runtime_keys.h"
 #include "common/stats/utility.h"
 
 #include "extensions/filters/http/well_known_names.h"
@@ -36,21 +37,22 @@ using RcDetails = ConstSingleton<RcDetailsValues>;
 
 FaultSettings::FaultSettings(const envoy::extensions::filters::http::fault::v3::HTTPFault& fault)
     : fault_filter_headers_(Http::HeaderUtility::buildHeaderDataVector(fault.headers())),
-      delay_percent_runtime_(PROTOBUF_GET_STRING_OR_DEFAULT(fault, delay_percent_runtime,
-                                                            RuntimeKeys::get().DelayPercentKey)),
-      abort_percent_runtime_(PROTOBUF_GET_STRING_OR_DEFAULT(fault, abort_percent_runtime,
-                                                            RuntimeKeys::get().AbortPercentKey)),
-      delay_duration_runtime_(PROTOBUF_GET_STRING_OR_DEFAULT(fault, delay_duration_runtime,
-                                                             RuntimeKeys::get().DelayDurationKey)),
-      abort_http_status_runtime_(PROTOBUF_GET_STRING_OR_DEFAULT(
-          fault, abort_http_status_runtime, RuntimeKeys::get().AbortHttpStatusKey)),
-      abort_grpc_status_runtime_(PROTOBUF_GET_STRING_OR_DEFAULT(
-          fault, abort_grpc_status_runtime, RuntimeKeys::get().AbortGrpcStatusKey)),
-      max_active_faults_runtime_(PROTOBUF_GET_STRING_OR_DEFAULT(
-          fault, max_active_faults_runtime, RuntimeKeys::get().MaxActiveFaultsKey)),
+      delay_percent_runtime_(Runtime::KeyRegistry::registerKey(PROTOBUF_GET_STRING_OR_DEFAULT(
+          fault, delay_percent_runtime, RuntimeKeys::get().DelayPercentKey))),
+      abort_percent_runtime_(Runtime::KeyRegistry::registerKey(PROTOBUF_GET_STRING_OR_DEFAULT(
+          fault, abort_percent_runtime, RuntimeKeys::get().AbortPercentKey))),
+      delay_duration_runtime_(Runtime::KeyRegistry::registerKey(PROTOBUF_GET_STRING_OR_DEFAULT(
+          fault, delay_duration_runtime, RuntimeKeys::get().DelayDurationKey))),
+      abort_http_status_runtime_(Runtime::KeyRegistry::registerKey(PROTOBUF_GET_STRING_OR_DEFAULT(
+          fault, abort_http_status_runtime, RuntimeKeys::get().AbortHttpStatusKey))),
+      abort_grpc_status_runtime_(Runtime::KeyRegistry::registerKey(PROTOBUF_GET_STRING_OR_DEFAULT(
+          fault, abort_grpc_status_runtime, RuntimeKeys::get().AbortGrpcStatusKey))),
+      max_active_faults_runtime_(Runtime::KeyRegistry::registerKey(PROTOBUF_GET_STRING_OR_DEFAULT(
+          fault, max_active_faults_runtime, RuntimeKeys::get().MaxActiveFaultsKey))),
       response_rate_limit_percent_runtime_(
-          PROTOBUF_GET_STRING_OR_DEFAULT(fault, response_rate_limit_percent_runtime,
-                                         RuntimeKeys::get().ResponseRateLimitPercentKey)) {
+          Runtime::KeyRegistry::registerKey(PROTOBUF_GET_STRING_OR_DEFAULT(
+              fault, response_rate_limit_percent_runtime,
+              RuntimeKeys::get().ResponseRateLimitPercentKey))) {
   if (fault.has_abort()) {
     request_abort_config_ =
         std::make_unique<Filters::Common::Fault::FaultAbortConfig>(fault.abort());
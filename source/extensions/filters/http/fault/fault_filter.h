@@ -64,13 +64,13 @@ public:
   const Filters::Common::Fault::FaultRateLimitConfig* responseRateLimit() const {
     return response_rate_limit_.get();
   }
-  const std::string& abortPercentRuntime() const { return abort_percent_runtime_; }
-  const std::string& delayPercentRuntime() const { return delay_percent_runtime_; }
-  const std::string& abortHttpStatusRuntime() const { return abort_http_status_runtime_; }
-  const std::string& abortGrpcStatusRuntime() const { return abort_grpc_status_runtime_; }
-  const std::string& delayDurationRuntime() const { return delay_duration_runtime_; }
-  const std::string& maxActiveFaultsRuntime() const { return max_active_faults_runtime_; }
-  const std::string& responseRateLimitPercentRuntime() const {
+  const Runtime::KeyHandle& abortPercentRuntime() const { return abort_percent_runtime_; }
+  const Runtime::KeyHandle& delayPercentRuntime() const { return delay_percent_runtime_; }
+  const Runtime::KeyHandle& abortHttpStatusRuntime() const { return abort_http_status_runtime_; }
+  const Runtime::KeyHandle& abortGrpcStatusRuntime() const { return abort_grpc_status_runtime_; }
+  const Runtime::KeyHandle& delayDurationRuntime() const { return delay_duration_runtime_; }
+  const Runtime::KeyHandle& maxActiveFaultsRuntime() const { return max_active_faults_runtime_; }
+  const Runtime::KeyHandle& responseRateLimitPercentRuntime() const {
     return response_rate_limit_percent_runtime_;
   }
 
@@ -96,13 +96,13 @@ private:
   absl::flat_hash_set<std::string> downstream_nodes_{}; // Inject failures for specific downstream
   absl::optional<uint64_t> max_active_faults_;
   Filters::Common::Fault::FaultRateLimitConfigPtr response_rate_limit_;
-  const std::string delay_percent_runtime_;
-  const std::string abort_percent_runtime_;
-  const std::string delay_duration_runtime_;
-  const std::string abort_http_status_runtime_;
-  const std::string abort_grpc_status_runtime_;
-  const std::string max_active_faults_runtime_;
-  const std::string response_rate_limit_percent_runtime_;
+  const Runtime::KeyHandle delay_percent_runtime_;
+  const Runtime::KeyHandle abort_percent_runtime_;
+  const Runtime::KeyHandle delay_duration_runtime_;
+  const Runtime::KeyHandle abort_http_status_runtime_;
+  const Runtime::KeyHandle abort_grpc_status_runtime_;
+  const Runtime::KeyHandle max_active_faults_runtime_;
+  const Runtime::KeyHandle response_rate_limit_percent_runtime_;
 };
 
 /**
@@ -18,6 +18,7 @@
 
 #include "extensions/filters/http/grpc_json_transcoder/http_body_utils.h"
 
+#include "absl/strings/str_cat.h"
 #include "google/api/annotations.pb.h"
 #include "google/api/http.pb.h"
 #include "google/api/httpbody.pb.h"
@@ -61,6 +62,22 @@ const Http::LowerCaseString& trailerHeader() {
   CONSTRUCT_ON_FIRST_USE(Http::LowerCaseString, "trailer");
 }
 
+// HttpBody payloads at least this large are moved to the response rather than copied.
+constexpr uint64_t MinMovedHttpBodySize = 16384;
+
+// Append the payload of an HttpBody message to data, moving it out of the message when large.
+void addHttpBodyData(google::api::HttpBody& http_body, Buffer::Instance& data) {
+  if (http_body.data().size() < MinMovedHttpBodySize) {
+    data.add(http_body.data());
+    return;
+  }
+  auto body = std::make_shared<const std::string>(std::move(*http_body.mutable_data()));
+  auto fragment = new Buffer::BufferFragmentImpl(
+      body->data(), body->size(),
+      [body](const void*, size_t, const Buffer::BufferFragmentImpl* fragment) { delete fragment; });
+  data.addBufferFragment(*fragment);
+}
+
 // Transcoder:
 // https://github.com/grpc-ecosystem/grpc-httpjson-transcoding/blob/master/src/include/grpc_transcoding/transcoder.h
 // implementation based on JsonRequestTranslator & ResponseToJsonTranslator
@@ -221,12 +238,17 @@ Status JsonTranscoderConfig::createMethodInfo(const Protobuf::MethodDescriptor*
   method_info->response_type_is_http_body_ =
       descriptor->output_type()->full_name() == google::api::HttpBody::descriptor()->full_name();
 
+  method_info->response_type_url_ = Grpc::Common::typeUrl(descriptor->output_type()->full_name());
+  method_info->grpc_path_ = absl::StrCat("/", descriptor->service()->full_name(), "/",
+                                         descriptor->name());
+
   const Protobuf::Type* request_type = type_helper_->Info()->GetTypeByTypeUrl(
       Grpc::Common::typeUrl(descriptor->input_type()->full_name()));
   if (request_type == nullptr) {
     return ProtobufUtil::Status(Code::NOT_FOUND,
                                 "Could not resolve type: " + descriptor->input_type()->full_name());
   }
+  method_info->request_type_ = request_type;
 
   Status status =
       type_helper_->ResolveFieldPath(*request_type, http_rule.body() == "*" ? "" : http_rule.body(),
@@ -264,14 +286,11 @@ ProtobufUtil::Status JsonTranscoderConfig::createTranscoder(
                                 "Request headers has application/grpc content-type");
   }
   const std::string method(headers.getMethodValue());
-  std::string path(headers.getPathValue());
-  std::string args;
-
-  const size_t pos = path.find('?');
-  if (pos != std::string::npos) {
-    args = path.substr(pos + 1);
-    path = path.substr(0, pos);
-  }
+  const absl::string_view path_and_args = headers.getPathValue();
+  const size_t pos = path_and_args.find('?');
+  const std::string path(path_and_args.substr(0, pos));
+  const std::string args(pos == absl::string_view::npos ? absl::string_view()
+                                                        : path_and_args.substr(pos + 1));
 
   struct RequestInfo request_info;
   std::vector<VariableBinding> variable_bindings;
@@ -281,15 +300,13 @@ ProtobufUtil::Status JsonTranscoderConfig::createTranscoder(
     return ProtobufUtil::Status(Code::NOT_FOUND, "Could not resolve " + path + " to a method");
   }
 
-  auto status = methodToRequestInfo(method_info, &request_info);
-  if (!status.ok()) {
-    return status;
-  }
+  // The request type was resolved along with the method when loading the config.
+  request_info.message_type = method_info->request_type_;
 
   for (const auto& binding : variable_bindings) {
     google::grpc::transcoding::RequestWeaver::BindingInfo resolved_binding;
-    status = type_helper_->ResolveFieldPath(*request_info.message_type, binding.field_path,
-                                            &resolved_binding.field_path);
+    const auto status = type_helper_->ResolveFieldPath(
+        *request_info.message_type, binding.field_path, &resolved_binding.field_path);
     if (!status.ok()) {
       if (ignore_unknown_query_parameters_) {
         continue;
@@ -314,11 +331,9 @@ ProtobufUtil::Status JsonTranscoderConfig::createTranscoder(
         method_info->descriptor_->client_streaming(), true);
   }
 
-  const auto response_type_url =
-      Grpc::Common::typeUrl(method_info->descriptor_->output_type()->full_name());
   std::unique_ptr<ResponseToJsonTranslator> response_translator{new ResponseToJsonTranslator(
-      type_helper_->Resolver(), response_type_url, method_info->descriptor_->server_streaming(),
-      &response_input, print_options_)};
+      type_helper_->Resolver(), method_info->response_type_url_,
+      method_info->descriptor_->server_streaming(), &response_input, print_options_)};
 
   transcoder = std::make_unique<TranscoderImpl>(std::move(request_translator),
                                                 std::move(json_request_translator),
@@ -326,21 +341,6 @@ ProtobufUtil::Status JsonTranscoderConfig::createTranscoder(
   return ProtobufUtil::Status();
 }
 
-ProtobufUtil::Status
-JsonTranscoderConfig::methodToRequestInfo(const MethodInfoSharedPtr& method_info,
-                                          google::grpc::transcoding::RequestInfo* info) {
-  const std::string& request_type_full_name = method_info->descriptor_->input_type()->full_name();
-  auto request_type_url = Grpc::Common::typeUrl(request_type_full_name);
-  info->message_type = type_helper_->Info()->GetTypeByTypeUrl(request_type_url);
-  if (info->message_type == nullptr) {
-    ENVOY_LOG(debug, "Cannot resolve input-type: {}", request_type_full_name);
-    return ProtobufUtil::Status(Code::NOT_FOUND,
-                                "Could not resolve type: " + request_type_full_name);
-  }
-
-  return ProtobufUtil::Status();
-}
-
 ProtobufUtil::Status
 JsonTranscoderConfig::translateProtoMessageToJson(const Protobuf::Message& message,
                                                   std::string* json_out) {
@@ -387,8 +387,7 @@ Http::FilterHeadersStatus JsonTranscoderFilter::decodeHeaders(Http::RequestHeade
   headers.removeContentLength();
   headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Grpc);
   headers.setEnvoyOriginalPath(headers.getPathValue());
-  headers.setPath("/" + method_->descriptor_->service()->full_name() + "/" +
-                  method_->descriptor_->name());
+  headers.setPath(method_->grpc_path_);
   headers.setReferenceMethod(Http::Headers::get().MethodValues.Post);
   headers.setReferenceTE(Http::Headers::get().TEValues.Trailers);
 
@@ -683,14 +682,14 @@ bool JsonTranscoderFilter::buildResponseFromHttpBodyOutput(
     if (frame.length_ > 0) {
       Buffer::ZeroCopyInputStreamImpl stream(std::move(frame.data_));
       http_body.ParseFromZeroCopyStream(&stream);
-      const auto& body = http_body.data();
+      const uint64_t body_size = http_body.data().size();
 
-      data.add(body);
+      addHttpBodyData(http_body, data);
 
       if (!method_->descriptor_->server_streaming()) {
         // Non streaming case: single message with content type / length
         response_headers.setContentType(http_body.content_type());
-        response_headers.setContentLength(body.size());
+        response_headers.setContentLength(body_size);
         return true;
       } else if (!http_body_response_headers_set_) {
         // Streaming case: set content type only once from first HttpBody message
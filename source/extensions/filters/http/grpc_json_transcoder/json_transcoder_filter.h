@@ -41,11 +41,21 @@ struct VariableBinding {
   std::string value;
 };
 
+/**
+ * The transcoding plan of a method, resolved once when loading the config rather than on every
+ * request.
+ */
 struct MethodInfo {
   const Protobuf::MethodDescriptor* descriptor_ = nullptr;
   std::vector<const Protobuf::Field*> request_body_field_path;
   bool request_type_is_http_body_ = false;
   bool response_type_is_http_body_ = false;
+  // The type of the request message, as known to the type resolver of the config.
+  const Protobuf::Type* request_type_ = nullptr;
+  // The type URL of the response message.
+  std::string response_type_url_;
+  // The path of the gRPC request, i.e. "/<service full name>/<method name>".
+  std::string grpc_path_;
 };
 using MethodInfoSharedPtr = std::shared_ptr<MethodInfo>;
 
@@ -102,13 +112,6 @@ public:
    */
   bool convertGrpcStatus() const;
 
-private:
-  /**
-   * Convert method descriptor to RequestInfo that needed for transcoding library
-   */
-  ProtobufUtil::Status methodToRequestInfo(const MethodInfoSharedPtr& method_info,
-                                           google::grpc::transcoding::RequestInfo* info);
-
 private:
   void addFileDescriptor(const Protobuf::FileDescriptorProto& file);
   void addBuiltinSymbolDescriptor(const std::string& symbol_name);
@@ -1,6 +1,7 @@
 #include "extensions/filters/http/on_demand/config.h"
 
-#include "envoy/config/filter/http/on_demand/v2/on_demand.pb.validate.h"
+#include "envoy/extensions/filters/http/on_demand/v3/on_demand.pb.h"
+#include "envoy/extensions/filters/http/on_demand/v3/on_demand.pb.validate.h"
 
 #include "extensions/filters/http/on_demand/on_demand_update.h"
 
@@ -10,11 +11,13 @@ namespace HttpFilters {
 namespace OnDemand {
 
 Http::FilterFactoryCb OnDemandFilterFactory::createFilterFactoryFromProtoTyped(
-    const envoy::config::filter::http::on_demand::v2::OnDemand&, const std::string&,
-    Server::Configuration::FactoryContext&) {
-  return [](Http::FilterChainFactoryCallbacks& callbacks) -> void {
+    const envoy::extensions::filters::http::on_demand::v3::OnDemand& proto_config,
+    const std::string&, Server::Configuration::FactoryContext& context) {
+  auto config = std::make_shared<OnDemandFilterConfig>(proto_config, context.clusterManager(),
+                                                       context.messageValidationVisitor());
+  return [config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
     callbacks.addStreamDecoderFilter(
-        std::make_shared<Extensions::HttpFilters::OnDemand::OnDemandRouteUpdate>());
+        std::make_shared<Extensions::HttpFilters::OnDemand::OnDemandRouteUpdate>(config));
   };
 }
 
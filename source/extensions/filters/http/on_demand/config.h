@@ -1,6 +1,7 @@
 #pragma once
 
-#include "envoy/config/filter/http/on_demand/v2/on_demand.pb.h"
+#include "envoy/extensions/filters/http/on_demand/v3/on_demand.pb.h"
+#include "envoy/extensions/filters/http/on_demand/v3/on_demand.pb.validate.h"
 
 #include "extensions/filters/http/common/factory_base.h"
 #include "extensions/filters/http/well_known_names.h"
@@ -14,14 +15,14 @@ namespace OnDemand {
  * Config registration for the OnDemand filter. @see NamedHttpFilterConfigFactory.
  */
 class OnDemandFilterFactory
-    : public Common::FactoryBase<envoy::config::filter::http::on_demand::v2::OnDemand> {
+    : public Common::FactoryBase<envoy::extensions::filters::http::on_demand::v3::OnDemand> {
 public:
   OnDemandFilterFactory() : FactoryBase(HttpFilterNames::get().OnDemand) {}
 
 private:
   Http::FilterFactoryCb createFilterFactoryFromProtoTyped(
-      const envoy::config::filter::http::on_demand::v2::OnDemand& proto_config, const std::string&,
-      Server::Configuration::FactoryContext& context) override;
+      const envoy::extensions::filters::http::on_demand::v3::OnDemand& proto_config,
+      const std::string&, Server::Configuration::FactoryContext& context) override;
 };
 
 } // namespace OnDemand
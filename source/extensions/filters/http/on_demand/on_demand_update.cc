@@ -3,16 +3,36 @@
 #include "common/common/assert.h"
 #include "common/common/enum_to_int.h"
 #include "common/http/codes.h"
+#include "common/protobuf/utility.h"
 
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
 namespace OnDemand {
 
+namespace {
+constexpr uint64_t DefaultOdCdsTimeoutMs = 5000;
+} // namespace
+
+OnDemandFilterConfig::OnDemandFilterConfig(
+    const envoy::extensions::filters::http::on_demand::v3::OnDemand& proto_config,
+    Upstream::ClusterManager& cm, ProtobufMessage::ValidationVisitor& validation_visitor) {
+  if (proto_config.has_odcds()) {
+    const auto& odcds_config = proto_config.odcds();
+    odcds_ = cm.allocateOdCdsApi(
+        odcds_config.source(),
+        std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(odcds_config, idle_timeout, 0)),
+        validation_visitor);
+    odcds_timeout_ = std::chrono::milliseconds(
+        PROTOBUF_GET_MS_OR_DEFAULT(odcds_config, timeout, DefaultOdCdsTimeoutMs));
+  }
+}
+
 Http::FilterHeadersStatus OnDemandRouteUpdate::decodeHeaders(Http::RequestHeaderMap&, bool) {
   if (callbacks_->route() != nullptr ||
       !(callbacks_->routeConfig().has_value() && callbacks_->routeConfig().value()->usesVhds())) {
-    filter_iteration_state_ = Http::FilterHeadersStatus::Continue;
+    filter_iteration_state_ = requestClusterDiscovery() ? Http::FilterHeadersStatus::StopIteration
+                                                        : Http::FilterHeadersStatus::Continue;
     return filter_iteration_state_;
   }
   route_config_updated_callback_ =
@@ -30,13 +50,36 @@ Http::FilterDataStatus OnDemandRouteUpdate::decodeData(Buffer::Instance&, bool)
 }
 
 Http::FilterTrailersStatus OnDemandRouteUpdate::decodeTrailers(Http::RequestTrailerMap&) {
-  return Http::FilterTrailersStatus::Continue;
+  return filter_iteration_state_ == Http::FilterHeadersStatus::StopIteration
+             ? Http::FilterTrailersStatus::StopIteration
+             : Http::FilterTrailersStatus::Continue;
 }
 
 void OnDemandRouteUpdate::setDecoderFilterCallbacks(Http::StreamDecoderFilterCallbacks& callbacks) {
   callbacks_ = &callbacks;
 }
 
+bool OnDemandRouteUpdate::requestClusterDiscovery() {
+  if (config_->odcds() == nullptr) {
+    return false;
+  }
+  Router::RouteConstSharedPtr route = callbacks_->route();
+  // The cluster info is only missing when the cluster of the route is not known.
+  if (route == nullptr || route->routeEntry() == nullptr || callbacks_->clusterInfo() != nullptr) {
+    return false;
+  }
+  // The callback is invoked before returning nullptr if the cluster became available in the
+  // meantime, in which case it is a no-op as decoding was not stopped.
+  cluster_discovery_handle_ = config_->odcds()->requestOnDemandClusterDiscovery(
+      route->routeEntry()->clusterName(),
+      std::make_unique<Upstream::ClusterDiscoveryCallback>(
+          [this](Upstream::ClusterDiscoveryStatus cluster_status) -> void {
+            onClusterDiscoveryCompletion(cluster_status);
+          }),
+      config_->odcdsTimeout());
+  return cluster_discovery_handle_ != nullptr;
+}
+
 // This is the callback which is called when an update requested in requestRouteConfigUpdate()
 // has been propagated to workers, at which point the request processing is restarted from the
 // beginning.
@@ -55,6 +98,25 @@ void OnDemandRouteUpdate::onRouteConfigUpdateCompletion(bool route_exists) {
   callbacks_->continueDecoding();
 }
 
+// This is the callback which is called when the discovery of the cluster of the route requested in
+// requestClusterDiscovery() completed on this worker. Unlike route updates, the stream needs not be
+// recreated, so that requests with a body can use discovered clusters too.
+void OnDemandRouteUpdate::onClusterDiscoveryCompletion(
+    Upstream::ClusterDiscoveryStatus cluster_status) {
+  cluster_discovery_handle_.reset();
+  if (filter_iteration_state_ != Http::FilterHeadersStatus::StopIteration) {
+    return;
+  }
+  filter_iteration_state_ = Http::FilterHeadersStatus::Continue;
+
+  if (cluster_status == Upstream::ClusterDiscoveryStatus::Available) {
+    // The cluster info of the route is cached along with it.
+    callbacks_->clearRouteCache();
+  }
+  // A missing cluster is reported by the router.
+  callbacks_->continueDecoding();
+}
+
 } // namespace OnDemand
 } // namespace HttpFilters
 } // namespace Extensions
@@ -1,18 +1,48 @@
 #pragma once
 
+#include <chrono>
+#include <memory>
+
+#include "envoy/extensions/filters/http/on_demand/v3/on_demand.pb.h"
 #include "envoy/http/filter.h"
+#include "envoy/upstream/cluster_manager.h"
 
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
 namespace OnDemand {
 
+/**
+ * Configuration of the on-demand filter, shared by all its instances.
+ */
+class OnDemandFilterConfig {
+public:
+  // Only performs on-demand VHDS updates.
+  OnDemandFilterConfig() = default;
+  OnDemandFilterConfig(const envoy::extensions::filters::http::on_demand::v3::OnDemand& proto_config,
+                       Upstream::ClusterManager& cm,
+                       ProtobufMessage::ValidationVisitor& validation_visitor);
+
+  // @return the on-demand CDS subscription, or nullptr if on-demand CDS is not enabled.
+  Upstream::OdCdsApiHandle* odcds() const { return odcds_.get(); }
+  std::chrono::milliseconds odcdsTimeout() const { return odcds_timeout_; }
+
+private:
+  Upstream::OdCdsApiHandlePtr odcds_;
+  std::chrono::milliseconds odcds_timeout_{};
+};
+
+using OnDemandFilterConfigSharedPtr = std::shared_ptr<const OnDemandFilterConfig>;
+
 class OnDemandRouteUpdate : public Http::StreamDecoderFilter {
 public:
-  OnDemandRouteUpdate() = default;
+  OnDemandRouteUpdate() : OnDemandRouteUpdate(std::make_shared<OnDemandFilterConfig>()) {}
+  explicit OnDemandRouteUpdate(OnDemandFilterConfigSharedPtr config) : config_(std::move(config)) {}
 
   void onRouteConfigUpdateCompletion(bool route_exists);
 
+  void onClusterDiscoveryCompletion(Upstream::ClusterDiscoveryStatus cluster_status);
+
   void setFilterIterationState(Envoy::Http::FilterHeadersStatus status) {
     filter_iteration_state_ = status;
   }
@@ -27,11 +57,16 @@ public:
 
   void setDecoderFilterCallbacks(Http::StreamDecoderFilterCallbacks& callbacks) override;
 
-  void onDestroy() override {}
+  void onDestroy() override { cluster_discovery_handle_.reset(); }
 
 private:
+  // @return whether the discovery of the cluster of the route was requested and is in progress.
+  bool requestClusterDiscovery();
+
+  const OnDemandFilterConfigSharedPtr config_;
   Http::StreamDecoderFilterCallbacks* callbacks_{};
   Http::RouteConfigUpdatedCallbackSharedPtr route_config_updated_callback_;
+  Upstream::ClusterDiscoveryCallbackHandlePtr cluster_discovery_handle_;
   Envoy::Http::FilterHeadersStatus filter_iteration_state_{Http::FilterHeadersStatus::Continue};
 };
 
@@ -158,6 +158,13 @@ public:
    */
   virtual std::chrono::milliseconds bufferFlushTimeoutInMs() const PURE;
 
+  /**
+   * @return when enabled, commands sent to a single upstream host while earlier ones are
+   * outstanding are batched until the end of the event loop iteration, instead of until
+   * bufferFlushTimeoutInMs().
+   */
+  virtual bool enableAutoPipelining() const PURE;
+
   /**
    * @return the maximum number of upstream connections to unknown hosts when enableRedirection() is
    * true.
@@ -26,6 +26,7 @@ ConfigImpl::ConfigImpl(
           config, buffer_flush_timeout,
           3)), // Default timeout is 3ms. If max_buffer_size_before_flush is zero, this is not used
                // as the buffer is flushed on each request immediately.
+      enable_auto_pipelining_(config.enable_auto_pipelining()),
       max_upstream_unknown_connections_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_upstream_unknown_connections, 100)),
       enable_command_stats_(config.enable_command_stats()) {
@@ -97,6 +98,10 @@ void ClientImpl::flushBufferAndResetTimer() {
   if (flush_timer_->enabled()) {
     flush_timer_->disableTimer();
   }
+  if (config_.enableAutoPipelining()) {
+    redis_command_stats_->updateBatchSize(scope_, buffered_requests_);
+  }
+  buffered_requests_ = 0;
   connection_->write(encoder_buffer_, false);
 }
 
@@ -117,9 +122,21 @@ PoolRequest* ClientImpl::makeRequest(const RespValue& request, ClientCallbacks&
 
   pending_requests_.emplace_back(*this, callbacks, command);
   encoder_->encode(request, encoder_buffer_);
-
-  // If buffer is full, flush. If the buffer was empty before the request, start the timer.
-  if (encoder_buffer_.length() >= config_.maxBufferSizeBeforeFlush()) {
+  buffered_requests_++;
+
+  if (config_.enableAutoPipelining()) {
+    // Requests to an idle upstream are written right away. Otherwise, the server is busy with
+    // earlier requests anyway, and all the requests made during the current event loop iteration,
+    // usually by many downstream connections, are written at once on the next one.
+    if (pending_requests_.size() == 1 ||
+        (config_.maxBufferSizeBeforeFlush() > 0 &&
+         encoder_buffer_.length() >= config_.maxBufferSizeBeforeFlush())) {
+      flushBufferAndResetTimer();
+    } else if (empty_buffer) {
+      flush_timer_->enableTimer(std::chrono::milliseconds(0));
+    }
+  } else if (encoder_buffer_.length() >= config_.maxBufferSizeBeforeFlush()) {
+    // If buffer is full, flush. If the buffer was empty before the request, start the timer.
     flushBufferAndResetTimer();
   } else if (empty_buffer) {
     flush_timer_->enableTimer(std::chrono::milliseconds(config_.bufferFlushTimeoutInMs()));
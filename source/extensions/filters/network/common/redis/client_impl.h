@@ -49,6 +49,7 @@ public:
   std::chrono::milliseconds bufferFlushTimeoutInMs() const override {
     return buffer_flush_timeout_;
   }
+  bool enableAutoPipelining() const override { return enable_auto_pipelining_; }
   uint32_t maxUpstreamUnknownConnections() const override {
     return max_upstream_unknown_connections_;
   }
@@ -61,6 +62,7 @@ private:
   const bool enable_redirection_;
   const uint32_t max_buffer_size_before_flush_;
   const std::chrono::milliseconds buffer_flush_timeout_;
+  const bool enable_auto_pipelining_;
   const uint32_t max_upstream_unknown_connections_;
   const bool enable_command_stats_;
   ReadPolicy read_policy_;
@@ -135,6 +137,8 @@ private:
   Network::ClientConnectionPtr connection_;
   EncoderPtr encoder_;
   Buffer::OwnedImpl encoder_buffer_;
+  // The number of requests encoded in encoder_buffer_.
+  uint32_t buffered_requests_{};
   DecoderPtr decoder_;
   const Config& config_;
   std::list<PendingRequest> pending_requests_;
@@ -126,6 +126,16 @@ public:
   CompositeArray& asCompositeArray();
   const CompositeArray& asCompositeArray() const;
 
+  /**
+   * Get/set the buffer holding the contents of a BulkString. Large bulk strings are decoded into
+   * the buffer slices they were received in, and then shared by copies of the value and encoded
+   * without copying their contents. The buffer must not be modified once set. The non-const
+   * asString() converts the value back to a plain string.
+   * @return the buffer, or nullptr if the value is held in a string.
+   */
+  std::shared_ptr<const Buffer::Instance> bulkStringBuffer() const;
+  void bulkStringBuffer(std::shared_ptr<const Buffer::Instance> buffer);
+
   /**
    * Get/set the type of the RespValue. A RespValue can only be a single type at a time. Each time
    * type() is called the type is changed and then the type specific as* methods can be used.
@@ -134,16 +144,28 @@ public:
   void type(RespType type);
 
 private:
+  /**
+   * Holds the data for a BulkString backed by a buffer.
+   */
+  struct BufferedString {
+    std::shared_ptr<const Buffer::Instance> buffer_;
+    // Copy of the buffer, only made for callers of the const asString().
+    mutable std::unique_ptr<std::string> string_;
+  };
+
   union {
     std::vector<RespValue> array_;
     std::string string_;
     int64_t integer_;
     CompositeArray composite_array_;
+    BufferedString buffered_string_;
   };
 
   void cleanup();
 
   RespType type_{};
+  // Whether a BulkString is held in buffered_string_ rather than string_.
+  bool buffered_{};
 };
 
 using RespValuePtr = std::unique_ptr<RespValue>;
@@ -7,6 +7,7 @@
 
 #include "envoy/common/platform.h"
 
+#include "common/buffer/buffer_impl.h"
 #include "common/common/assert.h"
 #include "common/common/fmt.h"
 #include "common/common/utility.h"
@@ -68,15 +69,41 @@ const std::vector<RespValue>& RespValue::asArray() const {
 std::string& RespValue::asString() {
   ASSERT(type_ == RespType::BulkString || type_ == RespType::Error ||
          type_ == RespType::SimpleString);
+  if (buffered_) {
+    // The string may be modified by the caller, so it can't share the buffer anymore.
+    std::string string = buffered_string_.buffer_->toString();
+    cleanup();
+    new (&string_) std::string(std::move(string));
+  }
   return string_;
 }
 
 const std::string& RespValue::asString() const {
   ASSERT(type_ == RespType::BulkString || type_ == RespType::Error ||
          type_ == RespType::SimpleString);
+  if (buffered_) {
+    if (buffered_string_.string_ == nullptr) {
+      buffered_string_.string_ =
+          std::make_unique<std::string>(buffered_string_.buffer_->toString());
+    }
+    return *buffered_string_.string_;
+  }
   return string_;
 }
 
+std::shared_ptr<const Buffer::Instance> RespValue::bulkStringBuffer() const {
+  ASSERT(type_ == RespType::BulkString);
+  return buffered_ ? buffered_string_.buffer_ : nullptr;
+}
+
+void RespValue::bulkStringBuffer(std::shared_ptr<const Buffer::Instance> buffer) {
+  ASSERT(type_ == RespType::BulkString);
+  ASSERT(buffer != nullptr);
+  cleanup();
+  new (&buffered_string_) BufferedString{std::move(buffer), nullptr};
+  buffered_ = true;
+}
+
 int64_t& RespValue::asInteger() {
   ASSERT(type_ == RespType::Integer);
   return integer_;
@@ -111,7 +138,12 @@ void RespValue::cleanup() {
   case RespType::SimpleString:
   case RespType::BulkString:
   case RespType::Error: {
-    string_.~basic_string<char>();
+    if (buffered_) {
+      buffered_string_.~BufferedString();
+      buffered_ = false;
+    } else {
+      string_.~basic_string<char>();
+    }
     break;
   }
   case RespType::Null:
@@ -162,7 +194,11 @@ RespValue::RespValue(const RespValue& other) : type_(RespType::Null) {
   case RespType::SimpleString:
   case RespType::BulkString:
   case RespType::Error: {
-    asString() = other.asString();
+    if (other.buffered_) {
+      bulkStringBuffer(other.buffered_string_.buffer_);
+    } else {
+      asString() = other.asString();
+    }
     break;
   }
   case RespType::Integer: {
@@ -187,7 +223,14 @@ RespValue::RespValue(RespValue&& other) noexcept : type_(other.type_) {
   case RespType::SimpleString:
   case RespType::BulkString:
   case RespType::Error: {
-    new (&string_) std::string(std::move(other.string_));
+    if (other.buffered_) {
+      new (&buffered_string_) BufferedString(std::move(other.buffered_string_));
+      buffered_ = true;
+      // Leave other holding an empty string rather than a null buffer.
+      other.type(other.type_);
+    } else {
+      new (&string_) std::string(std::move(other.string_));
+    }
     break;
   }
   case RespType::Integer: {
@@ -216,7 +259,11 @@ RespValue& RespValue::operator=(const RespValue& other) {
   case RespType::SimpleString:
   case RespType::BulkString:
   case RespType::Error: {
-    asString() = other.asString();
+    if (other.buffered_) {
+      bulkStringBuffer(other.buffered_string_.buffer_);
+    } else {
+      asString() = other.asString();
+    }
     break;
   }
   case RespType::Integer: {
@@ -247,7 +294,12 @@ RespValue& RespValue::operator=(RespValue&& other) noexcept {
   case RespType::SimpleString:
   case RespType::BulkString:
   case RespType::Error: {
-    string_ = std::move(other.string_);
+    if (other.buffered_) {
+      bulkStringBuffer(std::move(other.buffered_string_.buffer_));
+      other.type(other.type_);
+    } else {
+      string_ = std::move(other.string_);
+    }
     break;
   }
   case RespType::Integer: {
@@ -330,14 +382,29 @@ RespValue::CompositeArray::CompositeArrayConstIterator::empty() {
 }
 
 void DecoderImpl::decode(Buffer::Instance& data) {
-  for (const Buffer::RawSlice& slice : data.getRawSlices()) {
-    parseSlice(slice);
-  }
+  while (data.length() > 0) {
+    if (pending_bulk_string_ != nullptr) {
+      // Whole slices are moved, only the ends of the body sharing a slice with other values are
+      // copied.
+      ASSERT(state_ == State::BulkStringBody);
+      const uint64_t length = std::min(pending_integer_.integer_, data.length());
+      pending_bulk_string_->move(data, length);
+      pending_integer_.integer_ -= length;
+      if (pending_integer_.integer_ == 0) {
+        ENVOY_LOG(trace, "parse slice: BulkStringBody complete: {} bytes",
+                  pending_bulk_string_->length());
+        pending_value_stack_.front().value_->bulkStringBuffer(std::move(pending_bulk_string_));
+        state_ = State::CR;
+      }
+      continue;
+    }
 
-  data.drain(data.length());
+    const Buffer::RawSlice slice = data.getRawSlices(1)[0];
+    data.drain(parseSlice(slice));
+  }
 }
 
-void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
+uint64_t DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
   const char* buffer = reinterpret_cast<const char*>(slice.mem_);
   uint64_t remaining = slice.len_;
 
@@ -460,6 +527,11 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
         if (!pending_integer_.negative_) {
           // TODO(mattklein123): reserve and define max length since we don't stream currently.
           state_ = State::BulkStringBody;
+          if (pending_integer_.integer_ >= BufferedBulkStringMinSize) {
+            // Let decode() move the body out of the decoded buffer.
+            pending_bulk_string_ = std::make_unique<Buffer::OwnedImpl>();
+            return slice.len_ - remaining;
+          }
         } else {
           // Null bulk string. Switch type to null and move to value complete.
           current_value.value_->type(RespType::Null);
@@ -472,6 +544,7 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
 
     case State::BulkStringBody: {
       ASSERT(!pending_integer_.negative_);
+      ASSERT(pending_bulk_string_ == nullptr);
       uint64_t length_to_copy =
           std::min(static_cast<uint64_t>(pending_integer_.integer_), remaining);
       pending_value_stack_.front().value_->asString().append(buffer, length_to_copy);
@@ -547,6 +620,8 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
     }
     }
   }
+
+  return slice.len_;
 }
 
 void EncoderImpl::encode(const RespValue& value, Buffer::Instance& out) {
@@ -564,7 +639,12 @@ void EncoderImpl::encode(const RespValue& value, Buffer::Instance& out) {
     break;
   }
   case RespType::BulkString: {
-    encodeBulkString(value.asString(), out);
+    const std::shared_ptr<const Buffer::Instance> buffer = value.bulkStringBuffer();
+    if (buffer != nullptr) {
+      encodeBulkString(buffer, out);
+    } else {
+      encodeBulkString(value.asString(), out);
+    }
     break;
   }
   case RespType::Error: {
@@ -621,6 +701,28 @@ void EncoderImpl::encodeBulkString(const std::string& string, Buffer::Instance&
   out.add("\r\n", 2);
 }
 
+void EncoderImpl::encodeBulkString(const std::shared_ptr<const Buffer::Instance>& buffer,
+                                   Buffer::Instance& out) {
+  char header[32];
+  char* current = header;
+  *current++ = '$';
+  current += StringUtil::itoa(current, 21, buffer->length());
+  *current++ = '\r';
+  *current++ = '\n';
+  out.add(header, current - header);
+  // The fragments keep the buffer alive until they are drained from out, so that the slices are
+  // neither copied nor consumed, and the value can still be encoded again, e.g. when mirrored.
+  for (const Buffer::RawSlice& slice : buffer->getRawSlices()) {
+    auto fragment = new Buffer::BufferFragmentImpl(
+        slice.mem_, slice.len_,
+        [buffer](const void*, size_t, const Buffer::BufferFragmentImpl* fragment) {
+          delete fragment;
+        });
+    out.addBufferFragment(*fragment);
+  }
+  out.add("\r\n", 2);
+}
+
 void EncoderImpl::encodeError(const std::string& string, Buffer::Instance& out) {
   out.add("-", 1);
   out.add(string);
@@ -19,6 +19,8 @@ namespace Redis {
  * Decoder implementation of https://redis.io/topics/protocol
  *
  * This implementation buffers when needed and will always consume all bytes passed for decoding.
+ * Bulk strings of at least BufferedBulkStringMinSize bytes are moved out of the decoded buffer
+ * rather than copied, see RespValue::bulkStringBuffer().
  */
 class DecoderImpl : public Decoder, Logger::Loggable<Logger::Id::redis> {
 public:
@@ -27,6 +29,10 @@ public:
   // RedisProxy::Decoder
   void decode(Buffer::Instance& data) override;
 
+  // The size of a slice of an OwnedImpl, below which moving slices rather than copying their
+  // contents saves little.
+  static constexpr uint64_t BufferedBulkStringMinSize = 16384;
+
 private:
   enum class State {
     ValueRootStart,
@@ -56,11 +62,13 @@ private:
     uint64_t current_array_element_;
   };
 
-  void parseSlice(const Buffer::RawSlice& slice);
+  uint64_t parseSlice(const Buffer::RawSlice& slice);
 
   DecoderCallbacks& callbacks_;
   State state_{State::ValueRootStart};
   PendingInteger pending_integer_;
+  // The body of a large bulk string in progress, if any.
+  Buffer::InstancePtr pending_bulk_string_;
   RespValuePtr pending_value_root_;
   std::forward_list<PendingValue> pending_value_stack_;
 };
@@ -88,6 +96,8 @@ private:
   void encodeArray(const std::vector<RespValue>& array, Buffer::Instance& out);
   void encodeCompositeArray(const RespValue::CompositeArray& array, Buffer::Instance& out);
   void encodeBulkString(const std::string& string, Buffer::Instance& out);
+  void encodeBulkString(const std::shared_ptr<const Buffer::Instance>& buffer,
+                        Buffer::Instance& out);
   void encodeError(const std::string& string, Buffer::Instance& out);
   void encodeInteger(int64_t integer, Buffer::Instance& out);
   void encodeSimpleString(const std::string& string, Buffer::Instance& out);
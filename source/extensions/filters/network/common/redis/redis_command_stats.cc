@@ -15,6 +15,7 @@ RedisCommandStats::RedisCommandStats(Stats::SymbolTable& symbol_table, const std
     : symbol_table_(symbol_table), stat_name_set_(symbol_table_.makeSet("Redis")),
       prefix_(stat_name_set_->add(prefix)),
       upstream_rq_time_(stat_name_set_->add("upstream_rq_time")),
+      batch_size_(stat_name_set_->add("batch_size")),
       latency_(stat_name_set_->add("latency")), total_(stat_name_set_->add("total")),
       success_(stat_name_set_->add("success")), failure_(stat_name_set_->add("failure")),
       unused_metric_(stat_name_set_->add("unused")), null_metric_(stat_name_set_->add("null")),
@@ -81,6 +82,12 @@ void RedisCommandStats::updateStats(Stats::Scope& scope, Stats::StatName command
   Stats::Utility::counterFromStatNames(scope, {prefix_, command, status}).inc();
 }
 
+void RedisCommandStats::updateBatchSize(Stats::Scope& scope, uint64_t requests) {
+  Stats::Utility::histogramFromStatNames(scope, {prefix_, batch_size_},
+                                         Stats::Histogram::Unit::Unspecified)
+      .recordValue(requests);
+}
+
 } // namespace Redis
 } // namespace Common
 } // namespace NetworkFilters
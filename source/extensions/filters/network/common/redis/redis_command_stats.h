@@ -34,6 +34,7 @@ public:
   Stats::StatName getCommandFromRequest(const RespValue& request);
   void updateStatsTotal(Stats::Scope& scope, Stats::StatName command);
   void updateStats(Stats::Scope& scope, Stats::StatName command, const bool success);
+  void updateBatchSize(Stats::Scope& scope, uint64_t requests);
   Stats::StatName getUnusedStatName() { return unused_metric_; }
 
 private:
@@ -41,6 +42,7 @@ private:
   Stats::StatNameSetPtr stat_name_set_;
   const Stats::StatName prefix_;
   const Stats::StatName upstream_rq_time_;
+  const Stats::StatName batch_size_;
   const Stats::StatName latency_;
   const Stats::StatName total_;
   const Stats::StatName success_;
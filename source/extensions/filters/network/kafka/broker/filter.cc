@@ -69,15 +69,28 @@ absl::flat_hash_map<int32_t, MonotonicTime>& KafkaMetricsFacadeImpl::getRequestA
   return request_arrivals_;
 }
 
+// When skipping payloads, the skipping resolvers make the decoders consume message data without
+// deserializing it, what is sufficient for the metrics (only message headers are used).
 KafkaBrokerFilter::KafkaBrokerFilter(Stats::Scope& scope, TimeSource& time_source,
-                                     const std::string& stat_prefix)
+                                     const std::string& stat_prefix,
+                                     const bool skip_payload_parsing)
     : KafkaBrokerFilter{
-          std::make_shared<KafkaMetricsFacadeImpl>(scope, time_source, stat_prefix)} {};
-
-KafkaBrokerFilter::KafkaBrokerFilter(const KafkaMetricsFacadeSharedPtr& metrics)
-    : metrics_{metrics}, response_decoder_{new ResponseDecoder({metrics})},
-      request_decoder_{
-          new RequestDecoder({std::make_shared<Forwarder>(*response_decoder_), metrics})} {};
+          std::make_shared<KafkaMetricsFacadeImpl>(scope, time_source, stat_prefix),
+          skip_payload_parsing ? SkippingRequestParserResolver::getSkippingInstance()
+                               : RequestParserResolver::getDefaultInstance(),
+          skip_payload_parsing ? SkippingResponseParserResolver::getSkippingInstance()
+                               : ResponseParserResolver::getDefaultInstance()} {};
+
+KafkaBrokerFilter::KafkaBrokerFilter(const KafkaMetricsFacadeSharedPtr& metrics,
+                                     const RequestParserResolver& request_parser_resolver,
+                                     const ResponseParserResolver& response_parser_resolver)
+    : metrics_{metrics}, response_decoder_{new ResponseDecoder(
+                             ResponseInitialParserFactory::getDefaultInstance(),
+                             response_parser_resolver, {metrics})},
+      request_decoder_{new RequestDecoder(InitialParserFactory::getDefaultInstance(),
+                                          request_parser_resolver,
+                                          {std::make_shared<Forwarder>(*response_decoder_),
+                                           metrics})} {};
 
 KafkaBrokerFilter::KafkaBrokerFilter(KafkaMetricsFacadeSharedPtr metrics,
                                      ResponseDecoderSharedPtr response_decoder,
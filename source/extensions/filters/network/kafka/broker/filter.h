@@ -138,8 +138,11 @@ public:
    * Main constructor.
    * Creates decoders that eventually update prefixed metrics stored in scope, using time source for
    * duration calculation.
+   * If payload parsing is to be skipped, the decoders only extract message headers, as these are
+   * sufficient to compute the metrics.
    */
-  KafkaBrokerFilter(Stats::Scope& scope, TimeSource& time_source, const std::string& stat_prefix);
+  KafkaBrokerFilter(Stats::Scope& scope, TimeSource& time_source, const std::string& stat_prefix,
+                    bool skip_payload_parsing);
 
   /**
    * Visible for testing.
@@ -161,9 +164,11 @@ public:
 private:
   /**
    * Helper delegate constructor.
-   * Passes metrics facade as argument to decoders.
+   * Passes metrics facade as argument to decoders, that use given parser resolvers.
    */
-  KafkaBrokerFilter(const KafkaMetricsFacadeSharedPtr& metrics);
+  KafkaBrokerFilter(const KafkaMetricsFacadeSharedPtr& metrics,
+                    const RequestParserResolver& request_parser_resolver,
+                    const ResponseParserResolver& response_parser_resolver);
 
   const KafkaMetricsFacadeSharedPtr metrics_;
   const ResponseDecoderSharedPtr response_decoder_;
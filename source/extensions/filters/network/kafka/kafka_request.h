@@ -163,10 +163,47 @@ public:
     return request_header_ == rhs.request_header_ && data_ == rhs.data_;
   };
 
-private:
+  /**
+   * The request's data.
+   */
   const Data data_;
 };
 
+/**
+ * Request whose data has been skipped over instead of being deserialized, so only its header is
+ * known (used when the consumer does not need the request-specific data, e.g. for metrics).
+ * As the data is not captured, the request cannot be encoded.
+ */
+class SkippedRequest : public AbstractRequest {
+public:
+  SkippedRequest(const RequestHeader& request_header, const uint32_t data_size)
+      : AbstractRequest{request_header}, data_size_{data_size} {};
+
+  /**
+   * Compute the size of request, which includes both the request header and the data skipped.
+   */
+  uint32_t computeSize() const override {
+    const EncodingContext context{request_header_.api_version_};
+    return context.computeSize(request_header_) + data_size_;
+  }
+
+  /**
+   * Always throws, as skipped data cannot be re-created.
+   */
+  uint32_t encode(Buffer::Instance&) const override {
+    throw EnvoyException("skipped request cannot be encoded");
+  }
+
+  bool operator==(const SkippedRequest& rhs) const {
+    return request_header_ == rhs.request_header_ && data_size_ == rhs.data_size_;
+  };
+
+  /**
+   * Size of the request's data, that has been skipped.
+   */
+  const uint32_t data_size_;
+};
+
 } // namespace Kafka
 } // namespace NetworkFilters
 } // namespace Extensions
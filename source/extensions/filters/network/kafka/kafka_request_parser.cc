@@ -9,6 +9,10 @@ const RequestParserResolver& RequestParserResolver::getDefaultInstance() {
   CONSTRUCT_ON_FIRST_USE(RequestParserResolver);
 }
 
+const SkippingRequestParserResolver& SkippingRequestParserResolver::getSkippingInstance() {
+  CONSTRUCT_ON_FIRST_USE(SkippingRequestParserResolver);
+}
+
 RequestParseResponse RequestStartParser::parse(absl::string_view& data) {
   request_length_.feed(data);
   if (request_length_.ready()) {
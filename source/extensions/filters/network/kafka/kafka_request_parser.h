@@ -72,6 +72,24 @@ public:
   static const RequestParserResolver& getDefaultInstance();
 };
 
+/**
+ * Request parser resolver used when request-specific data is not needed: for requests that would be
+ * handled by default resolver, it provides parsers that skip the request data instead of
+ * deserializing it (so only the request header gets extracted).
+ * Requests with unknown api_key & api_version are still handled by sentinel parser.
+ */
+class SkippingRequestParserResolver : public RequestParserResolver {
+public:
+  // RequestParserResolver
+  RequestParserSharedPtr createParser(int16_t api_key, int16_t api_version,
+                                      RequestContextSharedPtr context) const override;
+
+  /**
+   * Return skipping resolver instance.
+   */
+  static const SkippingRequestParserResolver& getSkippingInstance();
+};
+
 /**
  * Request parser responsible for consuming request length and setting up context with this data.
  * @see http://kafka.apache.org/protocol.html#protocol_common
@@ -176,6 +194,21 @@ public:
   }
 };
 
+/**
+ * Parser that consumes the data of a request without deserializing it.
+ * When all the bytes have been consumed, it returns a request carrying only the request header.
+ */
+class SkippingParser
+    : public AbstractSkippingParser<RequestContextSharedPtr, RequestParseResponse, SkippedRequest>,
+      public RequestParser {
+public:
+  SkippingParser(RequestContextSharedPtr context) : AbstractSkippingParser{context} {};
+
+  RequestParseResponse parse(absl::string_view& data) override {
+    return AbstractSkippingParser::parse(data);
+  }
+};
+
 /**
  * Request parser uses a single deserializer to construct a request object.
  * This parser is responsible for consuming request-specific data (e.g. topic names) and always
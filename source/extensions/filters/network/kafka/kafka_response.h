@@ -1,5 +1,7 @@
 #pragma once
 
+#include "envoy/common/exception.h"
+
 #include "extensions/filters/network/kafka/external/serialization_composite.h"
 #include "extensions/filters/network/kafka/serialization.h"
 #include "extensions/filters/network/kafka/tagged_fields.h"
@@ -141,10 +143,47 @@ public:
     return metadata_ == rhs.metadata_ && data_ == rhs.data_;
   };
 
-private:
+  /**
+   * The response's data.
+   */
   const Data data_;
 };
 
+/**
+ * Response whose data has been skipped over instead of being deserialized, so only its metadata is
+ * known (used when the consumer does not need the response-specific data, e.g. for metrics).
+ * As the data is not captured, the response cannot be encoded.
+ */
+class SkippedResponse : public AbstractResponse {
+public:
+  SkippedResponse(const ResponseMetadata& metadata, const uint32_t data_size)
+      : AbstractResponse{metadata}, data_size_{data_size} {};
+
+  /**
+   * Compute the size of response, which includes both the response header and the data skipped.
+   */
+  uint32_t computeSize() const override {
+    const EncodingContext context{metadata_.api_version_};
+    return context.computeSize(metadata_) + data_size_;
+  }
+
+  /**
+   * Always throws, as skipped data cannot be re-created.
+   */
+  uint32_t encode(Buffer::Instance&) const override {
+    throw EnvoyException("skipped response cannot be encoded");
+  }
+
+  bool operator==(const SkippedResponse& rhs) const {
+    return metadata_ == rhs.metadata_ && data_size_ == rhs.data_size_;
+  };
+
+  /**
+   * Size of the response's data, that has been skipped.
+   */
+  const uint32_t data_size_;
+};
+
 } // namespace Kafka
 } // namespace NetworkFilters
 } // namespace Extensions
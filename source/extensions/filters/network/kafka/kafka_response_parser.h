@@ -94,6 +94,23 @@ public:
   static const ResponseParserResolver& getDefaultInstance();
 };
 
+/**
+ * Response parser resolver used when response-specific data is not needed: for responses that would
+ * be handled by default resolver, it provides parsers that skip the response data instead of
+ * deserializing it (so only the response metadata gets extracted).
+ * Responses with unknown api_key & api_version are still handled by sentinel parser.
+ */
+class SkippingResponseParserResolver : public ResponseParserResolver {
+public:
+  // ResponseParserResolver
+  ResponseParserSharedPtr createParser(ResponseContextSharedPtr metadata) const override;
+
+  /**
+   * Return skipping resolver instance.
+   */
+  static const SkippingResponseParserResolver& getSkippingInstance();
+};
+
 /**
  * Response parser responsible for consuming response header (payload length and correlation id) and
  * setting up context with this data.
@@ -151,6 +168,22 @@ public:
   }
 };
 
+/**
+ * Parser that consumes the data of a response without deserializing it.
+ * When all the bytes have been consumed, it returns a response carrying only the response metadata.
+ */
+class SkippingResponseParser
+    : public AbstractSkippingParser<ResponseContextSharedPtr, ResponseParseResponse,
+                                    SkippedResponse>,
+      public ResponseParser {
+public:
+  SkippingResponseParser(ResponseContextSharedPtr context) : AbstractSkippingParser{context} {};
+
+  ResponseParseResponse parse(absl::string_view& data) override {
+    return AbstractSkippingParser::parse(data);
+  }
+};
+
 /**
  * Response parser uses a single deserializer to construct a response object.
  * This parser is responsible for consuming response-specific data (e.g. topic names) and always
@@ -0,0 +1,19 @@
+#include "extensions/filters/network/kafka/mesh/abstract_command.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+void BaseInFlightRequest::notifyFilter() {
+  if (filter_active_) {
+    filter_.onRequestReadyForAnswer();
+  }
+}
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
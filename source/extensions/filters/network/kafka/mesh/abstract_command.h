@@ -0,0 +1,90 @@
+#pragma once
+
+#include <memory>
+
+#include "envoy/common/pure.h"
+
+#include "extensions/filters/network/kafka/kafka_response.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+class InFlightRequest;
+
+using InFlightRequestSharedPtr = std::shared_ptr<InFlightRequest>;
+
+/**
+ * Receives the requests decoded from a downstream connection, and is notified when they can be
+ * answered.
+ */
+class AbstractRequestListener {
+public:
+  virtual ~AbstractRequestListener() = default;
+
+  /**
+   * Invoked when a request has been decoded, before its processing starts.
+   */
+  virtual void onRequest(InFlightRequestSharedPtr request) PURE;
+
+  /**
+   * Invoked when a request has finished, possibly while its processing is being started.
+   */
+  virtual void onRequestReadyForAnswer() PURE;
+};
+
+/**
+ * A request received from a downstream client, being processed by upstream clusters or locally.
+ */
+class InFlightRequest {
+public:
+  virtual ~InFlightRequest() = default;
+
+  /**
+   * Starts processing the request, e.g. sends its records upstream.
+   */
+  virtual void startProcessing() PURE;
+
+  /**
+   * @return whether the request can be answered.
+   */
+  virtual bool finished() const PURE;
+
+  /**
+   * @return the answer to the request, or nullptr if the client does not expect one.
+   */
+  virtual AbstractResponseSharedPtr computeAnswer() const PURE;
+
+  /**
+   * Invoked when the downstream connection is gone, so that the request does not notify it.
+   */
+  virtual void abandon() PURE;
+};
+
+/**
+ * Base for requests, notifying their listener unless abandoned.
+ */
+class BaseInFlightRequest : public InFlightRequest {
+public:
+  BaseInFlightRequest(AbstractRequestListener& filter) : filter_(filter) {}
+
+  // InFlightRequest
+  void abandon() override { filter_active_ = false; }
+
+protected:
+  /**
+   * Notifies the listener that this request has finished.
+   */
+  void notifyFilter();
+
+  AbstractRequestListener& filter_;
+  bool filter_active_{true};
+};
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,38 @@
+#include "extensions/filters/network/kafka/mesh/command_handlers/api_versions.h"
+
+#include "extensions/filters/network/kafka/external/responses.h"
+#include "extensions/filters/network/kafka/mesh/kafka_constants.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+ApiVersionsRequestHolder::ApiVersionsRequestHolder(
+    AbstractRequestListener& filter, const std::shared_ptr<Request<ApiVersionsRequest>> request)
+    : BaseInFlightRequest{filter}, request_{request} {}
+
+void ApiVersionsRequestHolder::startProcessing() { notifyFilter(); }
+
+bool ApiVersionsRequestHolder::finished() const { return true; }
+
+AbstractResponseSharedPtr ApiVersionsRequestHolder::computeAnswer() const {
+  // Produce requests older than version 3 carry message sets, which cannot be re-batched.
+  const std::vector<ApiVersionsResponseKey> api_keys = {
+      {ApiKeys::Produce, 3, 8},
+      {ApiKeys::Metadata, 0, 9},
+      {ApiKeys::ApiVersions, 0, 3},
+  };
+
+  const RequestHeader& header = request_->request_header_;
+  const ResponseMetadata metadata = {header.api_key_, header.api_version_, header.correlation_id_};
+  const ApiVersionsResponse data = {ErrorCodes::None, api_keys};
+  return std::make_shared<Response<ApiVersionsResponse>>(metadata, data);
+}
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
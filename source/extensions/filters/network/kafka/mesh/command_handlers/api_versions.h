@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+
+#include "extensions/filters/network/kafka/external/requests.h"
+#include "extensions/filters/network/kafka/mesh/abstract_command.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+/**
+ * ApiVersions request, answered locally with the versions of the requests the filter handles.
+ */
+class ApiVersionsRequestHolder : public BaseInFlightRequest {
+public:
+  ApiVersionsRequestHolder(AbstractRequestListener& filter,
+                           const std::shared_ptr<Request<ApiVersionsRequest>> request);
+
+  // InFlightRequest
+  void startProcessing() override;
+  bool finished() const override;
+  AbstractResponseSharedPtr computeAnswer() const override;
+
+private:
+  const std::shared_ptr<Request<ApiVersionsRequest>> request_;
+};
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,62 @@
+#include "extensions/filters/network/kafka/mesh/command_handlers/metadata.h"
+
+#include "extensions/filters/network/kafka/external/responses.h"
+#include "extensions/filters/network/kafka/mesh/kafka_constants.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+namespace {
+
+// The node id of the filter, advertised as the only broker.
+constexpr int32_t BrokerId = 0;
+
+} // namespace
+
+MetadataRequestHolder::MetadataRequestHolder(
+    AbstractRequestListener& filter, const UpstreamKafkaConfiguration& configuration,
+    const std::shared_ptr<Request<MetadataRequest>> request)
+    : BaseInFlightRequest{filter}, configuration_{configuration}, request_{request} {}
+
+void MetadataRequestHolder::startProcessing() { notifyFilter(); }
+
+bool MetadataRequestHolder::finished() const { return true; }
+
+AbstractResponseSharedPtr MetadataRequestHolder::computeAnswer() const {
+  const auto advertised_address = configuration_.getAdvertisedAddress();
+  const MetadataResponseBroker broker = {BrokerId, advertised_address.first,
+                                         advertised_address.second};
+
+  // All topics are requested if none is given, which cannot be listed.
+  std::vector<MetadataResponseTopic> topics;
+  if (request_->data_.topics_) {
+    for (const MetadataRequestTopic& topic : *request_->data_.topics_) {
+      const ClusterConfig* cluster = configuration_.computeClusterConfigForTopic(topic.name_);
+      if (cluster == nullptr) {
+        topics.emplace_back(ErrorCodes::UnknownTopicOrPartition, topic.name_, false,
+                            std::vector<MetadataResponsePartition>{});
+        continue;
+      }
+      std::vector<MetadataResponsePartition> partitions;
+      for (int32_t partition = 0; partition < cluster->partition_count_; partition++) {
+        partitions.emplace_back(ErrorCodes::None, partition, BrokerId,
+                                std::vector<int32_t>{BrokerId}, std::vector<int32_t>{BrokerId});
+      }
+      topics.emplace_back(ErrorCodes::None, topic.name_, false, partitions);
+    }
+  }
+
+  const RequestHeader& header = request_->request_header_;
+  const ResponseMetadata metadata = {header.api_key_, header.api_version_, header.correlation_id_};
+  const MetadataResponse data = {{broker}, BrokerId, topics};
+  return std::make_shared<Response<MetadataResponse>>(metadata, data);
+}
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
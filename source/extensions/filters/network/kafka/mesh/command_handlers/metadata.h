@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+
+#include "extensions/filters/network/kafka/external/requests.h"
+#include "extensions/filters/network/kafka/mesh/abstract_command.h"
+#include "extensions/filters/network/kafka/mesh/upstream_config.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+/**
+ * Metadata request, answered locally: the filter is the only broker, and the leader of all the
+ * partitions of the topics of the upstream clusters.
+ */
+class MetadataRequestHolder : public BaseInFlightRequest {
+public:
+  MetadataRequestHolder(AbstractRequestListener& filter,
+                        const UpstreamKafkaConfiguration& configuration,
+                        const std::shared_ptr<Request<MetadataRequest>> request);
+
+  // InFlightRequest
+  void startProcessing() override;
+  bool finished() const override;
+  AbstractResponseSharedPtr computeAnswer() const override;
+
+private:
+  const UpstreamKafkaConfiguration& configuration_;
+  const std::shared_ptr<Request<MetadataRequest>> request_;
+};
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
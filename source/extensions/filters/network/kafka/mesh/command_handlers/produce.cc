@@ -0,0 +1,112 @@
+#include "extensions/filters/network/kafka/mesh/command_handlers/produce.h"
+
+#include "extensions/filters/network/kafka/external/responses.h"
+#include "extensions/filters/network/kafka/mesh/kafka_constants.h"
+#include "extensions/filters/network/kafka/mesh/record_batch.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+ProduceRequestHolder::ProduceRequestHolder(AbstractRequestListener& filter,
+                                           const UpstreamKafkaConfiguration& configuration,
+                                           UpstreamKafkaFacade& kafka_facade,
+                                           const std::shared_ptr<Request<ProduceRequest>> request)
+    : BaseInFlightRequest{filter}, configuration_{configuration}, kafka_facade_{kafka_facade},
+      request_{request} {}
+
+void ProduceRequestHolder::startProcessing() {
+  std::vector<OutboundRecord> records;
+  for (const TopicProduceData& topic : request_->data_.topics_) {
+    const ClusterConfig* cluster = configuration_.computeClusterConfigForTopic(topic.name_);
+    for (const PartitionProduceData& partition : topic.partitions_) {
+      const uint32_t record_id = results_.size();
+      results_.push_back({topic.name_, partition.partition_index_, ErrorCodes::None});
+      if (cluster == nullptr) {
+        results_.back().error_code_ = ErrorCodes::UnknownTopicOrPartition;
+        continue;
+      }
+      if (!partition.records_) {
+        continue;
+      }
+
+      records.clear();
+      try {
+        const Bytes& data = *partition.records_;
+        RecordExtractor::extract(topic.name_, partition.partition_index_,
+                                 {reinterpret_cast<const char*>(data.data()), data.size()},
+                                 records);
+      } catch (const InvalidRecordBatchException& e) {
+        ENVOY_LOG(debug, "kafka mesh: invalid records for {}-{}: {}", topic.name_,
+                  partition.partition_index_, e.what());
+        results_.back().error_code_ = e.errorCode();
+        continue;
+      }
+
+      KafkaProducer& producer = kafka_facade_.getProducer(*cluster);
+      pending_ += records.size();
+      for (const OutboundRecord& record : records) {
+        producer.send(record, shared_from_this(), record_id);
+      }
+    }
+  }
+
+  // All records have been sent, possibly delivered already.
+  pending_--;
+  if (finished()) {
+    notifyFilter();
+  }
+}
+
+bool ProduceRequestHolder::finished() const {
+  // Clients not waiting for acknowledgements do not get answers.
+  return request_->data_.acks_ == 0 || pending_ == 0;
+}
+
+void ProduceRequestHolder::onRecordDelivery(uint32_t record_id, int16_t error_code,
+                                            int64_t offset) {
+  PartitionResult& result = results_[record_id];
+  if (error_code != ErrorCodes::None) {
+    if (result.error_code_ == ErrorCodes::None) {
+      result.error_code_ = error_code;
+    }
+  } else if (result.base_offset_ == -1 || offset < result.base_offset_) {
+    result.base_offset_ = offset;
+  }
+
+  pending_--;
+  if (pending_ == 0 && request_->data_.acks_ != 0) {
+    notifyFilter();
+  }
+}
+
+AbstractResponseSharedPtr ProduceRequestHolder::computeAnswer() const {
+  if (request_->data_.acks_ == 0) {
+    return nullptr;
+  }
+
+  // The partitions of the request are grouped by topic, and so are the results.
+  std::vector<TopicProduceResponse> topics;
+  for (auto result = results_.begin(); result != results_.end();) {
+    std::vector<PartitionProduceResponse> partitions;
+    const std::string& topic = result->topic_;
+    for (; result != results_.end() && result->topic_ == topic; ++result) {
+      const int64_t offset = result->error_code_ == ErrorCodes::None ? result->base_offset_ : -1;
+      partitions.emplace_back(result->partition_, result->error_code_, offset);
+    }
+    topics.emplace_back(topic, partitions);
+  }
+
+  const RequestHeader& header = request_->request_header_;
+  const ResponseMetadata metadata = {header.api_key_, header.api_version_, header.correlation_id_};
+  const ProduceResponse data = {topics, 0};
+  return std::make_shared<Response<ProduceResponse>>(metadata, data);
+}
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
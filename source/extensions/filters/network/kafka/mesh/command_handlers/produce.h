@@ -0,0 +1,67 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common/logger.h"
+
+#include "extensions/filters/network/kafka/external/requests.h"
+#include "extensions/filters/network/kafka/mesh/abstract_command.h"
+#include "extensions/filters/network/kafka/mesh/upstream_config.h"
+#include "extensions/filters/network/kafka/mesh/upstream_kafka_client.h"
+#include "extensions/filters/network/kafka/mesh/upstream_kafka_facade.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+/**
+ * Produce request, whose records are re-batched by the producers of their upstream clusters.
+ * The partitions are answered once all of their records have been delivered, with the first error
+ * of their records, if any.
+ */
+class ProduceRequestHolder : public BaseInFlightRequest,
+                             public RecordCallback,
+                             public std::enable_shared_from_this<ProduceRequestHolder>,
+                             private Logger::Loggable<Logger::Id::kafka> {
+public:
+  ProduceRequestHolder(AbstractRequestListener& filter,
+                       const UpstreamKafkaConfiguration& configuration,
+                       UpstreamKafkaFacade& kafka_facade,
+                       const std::shared_ptr<Request<ProduceRequest>> request);
+
+  // InFlightRequest
+  void startProcessing() override;
+  bool finished() const override;
+  AbstractResponseSharedPtr computeAnswer() const override;
+
+  // RecordCallback
+  void onRecordDelivery(uint32_t record_id, int16_t error_code, int64_t offset) override;
+
+private:
+  struct PartitionResult {
+    std::string topic_;
+    int32_t partition_;
+    int16_t error_code_;
+    // Offset of the first record stored, -1 if none.
+    int64_t base_offset_{-1};
+  };
+
+  const UpstreamKafkaConfiguration& configuration_;
+  UpstreamKafkaFacade& kafka_facade_;
+  const std::shared_ptr<Request<ProduceRequest>> request_;
+  // The records are sent with the index of their partition as id.
+  std::vector<PartitionResult> results_;
+  // Records not delivered yet, plus one until all of them have been sent, as they may be
+  // delivered immediately.
+  uint32_t pending_{1};
+};
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
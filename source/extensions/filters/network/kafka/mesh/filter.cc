@@ -0,0 +1,86 @@
+#include "extensions/filters/network/kafka/mesh/filter.h"
+
+#include "envoy/network/connection.h"
+
+#include "common/buffer/buffer_impl.h"
+
+#include "extensions/filters/network/kafka/external/requests.h"
+#include "extensions/filters/network/kafka/mesh/request_processor.h"
+#include "extensions/filters/network/kafka/response_codec.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+KafkaMeshFilter::KafkaMeshFilter(const UpstreamKafkaConfiguration& configuration,
+                                 UpstreamKafkaFacade& upstream_kafka_facade)
+    : KafkaMeshFilter{std::make_shared<RequestDecoder>(std::vector<RequestCallbackSharedPtr>(
+          {std::make_shared<RequestProcessor>(*this, configuration, upstream_kafka_facade)}))} {}
+
+KafkaMeshFilter::KafkaMeshFilter(RequestDecoderSharedPtr request_decoder)
+    : request_decoder_{request_decoder} {}
+
+KafkaMeshFilter::~KafkaMeshFilter() { abandonAllInFlightRequests(); }
+
+Network::FilterStatus KafkaMeshFilter::onNewConnection() { return Network::FilterStatus::Continue; }
+
+void KafkaMeshFilter::initializeReadFilterCallbacks(Network::ReadFilterCallbacks& callbacks) {
+  read_filter_callbacks_ = &callbacks;
+  read_filter_callbacks_->connection().addConnectionCallbacks(*this);
+}
+
+Network::FilterStatus KafkaMeshFilter::onData(Buffer::Instance& data, bool) {
+  try {
+    request_decoder_->onData(data);
+    data.drain(data.length()); // All the data has been consumed by the decoder.
+  } catch (const EnvoyException& e) {
+    ENVOY_LOG(trace, "kafka mesh: could not process data from downstream client: {}", e.what());
+    abandonAllInFlightRequests();
+    read_filter_callbacks_->connection().close(Network::ConnectionCloseType::NoFlush);
+  }
+  return Network::FilterStatus::StopIteration;
+}
+
+void KafkaMeshFilter::onEvent(Network::ConnectionEvent event) {
+  if (event == Network::ConnectionEvent::RemoteClose ||
+      event == Network::ConnectionEvent::LocalClose) {
+    abandonAllInFlightRequests();
+  }
+}
+
+void KafkaMeshFilter::onRequest(InFlightRequestSharedPtr request) {
+  // The request is queued first, as it may finish while being started.
+  requests_in_flight_.push_back(request);
+  request->startProcessing();
+}
+
+void KafkaMeshFilter::onRequestReadyForAnswer() {
+  // The answers of all the finished requests at the front are written at once.
+  Buffer::OwnedImpl buffer;
+  ResponseEncoder encoder{buffer};
+  while (!requests_in_flight_.empty() && requests_in_flight_.front()->finished()) {
+    const AbstractResponseSharedPtr response = requests_in_flight_.front()->computeAnswer();
+    if (response != nullptr) {
+      encoder.encode(*response);
+    }
+    requests_in_flight_.pop_front();
+  }
+  if (buffer.length() > 0) {
+    read_filter_callbacks_->connection().write(buffer, false);
+  }
+}
+
+void KafkaMeshFilter::abandonAllInFlightRequests() {
+  for (const InFlightRequestSharedPtr& request : requests_in_flight_) {
+    request->abandon();
+  }
+  requests_in_flight_.clear();
+}
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
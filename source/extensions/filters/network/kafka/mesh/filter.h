@@ -0,0 +1,75 @@
+#pragma once
+
+#include <list>
+
+#include "envoy/network/filter.h"
+
+#include "common/common/logger.h"
+
+#include "extensions/filters/network/kafka/mesh/abstract_command.h"
+#include "extensions/filters/network/kafka/mesh/upstream_config.h"
+#include "extensions/filters/network/kafka/mesh/upstream_kafka_facade.h"
+#include "extensions/filters/network/kafka/request_codec.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+/**
+ * Main entry point.
+ * Decoded requests are passed to the request processor, which turns them into in-flight requests.
+ * Produce requests have their records sent to the upstream clusters matching their topics, where
+ * they are re-batched with the records of the other connections of the worker thread. Metadata
+ * requests are answered locally, advertising this filter as the only broker of all topics, so
+ * clients send it all their records.
+ * Requests are answered in the order they were received, as expected by clients.
+ */
+class KafkaMeshFilter : public Network::ReadFilter,
+                        public Network::ConnectionCallbacks,
+                        public AbstractRequestListener,
+                        private Logger::Loggable<Logger::Id::kafka> {
+public:
+  // Main constructor.
+  KafkaMeshFilter(const UpstreamKafkaConfiguration& configuration,
+                  UpstreamKafkaFacade& upstream_kafka_facade);
+
+  // Visible for testing.
+  KafkaMeshFilter(RequestDecoderSharedPtr request_decoder);
+
+  // Non-trivial. See 'abandonAllInFlightRequests'.
+  ~KafkaMeshFilter() override;
+
+  // Network::ReadFilter
+  Network::FilterStatus onNewConnection() override;
+  void initializeReadFilterCallbacks(Network::ReadFilterCallbacks& callbacks) override;
+  Network::FilterStatus onData(Buffer::Instance& data, bool end_stream) override;
+
+  // Network::ConnectionCallbacks
+  void onEvent(Network::ConnectionEvent event) override;
+  void onAboveWriteBufferHighWatermark() override {}
+  void onBelowWriteBufferLowWatermark() override {}
+
+  // AbstractRequestListener
+  void onRequest(InFlightRequestSharedPtr request) override;
+  void onRequestReadyForAnswer() override;
+
+  std::list<InFlightRequestSharedPtr>& getRequestsInFlightForTest() { return requests_in_flight_; }
+
+private:
+  // Mark the requests as abandoned, so they do not notify this filter once delivered.
+  void abandonAllInFlightRequests();
+
+  const RequestDecoderSharedPtr request_decoder_;
+
+  Network::ReadFilterCallbacks* read_filter_callbacks_;
+
+  std::list<InFlightRequestSharedPtr> requests_in_flight_;
+};
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+/**
+ * Api keys of the requests used by the mesh filter.
+ * @see http://kafka.apache.org/protocol.html#protocol_api_keys
+ */
+namespace ApiKeys {
+constexpr int16_t Produce = 0;
+constexpr int16_t Metadata = 3;
+constexpr int16_t ApiVersions = 18;
+} // namespace ApiKeys
+
+/**
+ * Error codes returned by the mesh filter.
+ * @see http://kafka.apache.org/protocol.html#protocol_error_codes
+ */
+namespace ErrorCodes {
+constexpr int16_t UnknownServerError = -1;
+constexpr int16_t None = 0;
+constexpr int16_t CorruptMessage = 2;
+constexpr int16_t UnknownTopicOrPartition = 3;
+constexpr int16_t LeaderNotAvailable = 5;
+constexpr int16_t NotLeaderForPartition = 6;
+constexpr int16_t NetworkException = 13;
+constexpr int16_t UnsupportedCompressionType = 76;
+} // namespace ErrorCodes
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
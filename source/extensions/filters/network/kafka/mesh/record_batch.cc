@@ -0,0 +1,279 @@
+#include "extensions/filters/network/kafka/mesh/record_batch.h"
+
+#include <array>
+#include <cstring>
+
+#include "common/common/byte_order.h"
+#include "common/common/fmt.h"
+
+#include "extensions/filters/network/kafka/mesh/kafka_constants.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+namespace {
+
+// Offsets of the fields of record batches.
+constexpr uint32_t LogOverhead = 12; // Base offset and batch length, excluded from the latter.
+constexpr uint32_t CrcOffset = 17;
+constexpr uint32_t AttributesOffset = 21; // The checksum covers the batch from its attributes.
+
+// Flags of the attributes of record batches.
+constexpr int16_t CompressionCodecMask = 0x07;
+constexpr int16_t TransactionalFlag = 0x10;
+constexpr int16_t ControlFlag = 0x20;
+
+constexpr int8_t CurrentMagic = 2;
+
+constexpr std::array<uint32_t, 256> makeCrc32cTable() {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < table.size(); i++) {
+    uint32_t crc = i;
+    for (uint32_t bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+
+constexpr std::array<uint32_t, 256> Crc32cTable = makeCrc32cTable();
+
+// The CRC-32C (Castagnoli) checksum used by record batches.
+uint32_t crc32c(absl::string_view data) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (const char c : data) {
+    crc = Crc32cTable[(crc ^ static_cast<uint8_t>(c)) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+/**
+ * Consumes the fields of a record batch from its data, throwing if the data is too short.
+ */
+class Reader {
+public:
+  Reader(absl::string_view data) : data_(data) {}
+
+  bool empty() const { return data_.empty(); }
+
+  /**
+   * @return the data not consumed yet.
+   */
+  absl::string_view remaining() const { return data_; }
+
+  template <typename T> T readInt() {
+    const absl::string_view bytes = readBytes(sizeof(T));
+    T result;
+    memcpy(&result, bytes.data(), sizeof(T));
+    if constexpr (sizeof(T) == 2) {
+      return be16toh(result);
+    } else if constexpr (sizeof(T) == 4) {
+      return be32toh(result);
+    } else if constexpr (sizeof(T) == 8) {
+      return be64toh(result);
+    }
+    return result;
+  }
+
+  // Records use zig-zag encoded variable length integers.
+  int64_t readVarlong() {
+    uint64_t value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+      const uint8_t byte = readInt<uint8_t>();
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return static_cast<int64_t>((value >> 1) ^ (0 - (value & 1)));
+      }
+    }
+    throw InvalidRecordBatchException("invalid varint in record", ErrorCodes::CorruptMessage);
+  }
+
+  absl::string_view readBytes(int64_t length) {
+    if (length < 0 || static_cast<uint64_t>(length) > data_.size()) {
+      throw InvalidRecordBatchException("truncated record batch", ErrorCodes::CorruptMessage);
+    }
+    const absl::string_view result = data_.substr(0, length);
+    data_.remove_prefix(length);
+    return result;
+  }
+
+  absl::optional<absl::string_view> readNullableBytes() {
+    const int64_t length = readVarlong();
+    if (length == -1) {
+      return absl::nullopt;
+    }
+    return readBytes(length);
+  }
+
+private:
+  absl::string_view data_;
+};
+
+template <typename T> void appendInt(Bytes& dst, T value) {
+  for (int32_t shift = (sizeof(T) - 1) * 8; shift >= 0; shift -= 8) {
+    dst.push_back(static_cast<unsigned char>(static_cast<uint64_t>(value) >> shift));
+  }
+}
+
+uint64_t zigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+uint32_t varlongSize(int64_t value) {
+  uint64_t encoded = zigZag(value);
+  uint32_t size = 1;
+  while (encoded >= 0x80) {
+    encoded >>= 7;
+    size++;
+  }
+  return size;
+}
+
+void appendVarlong(Bytes& dst, int64_t value) {
+  uint64_t encoded = zigZag(value);
+  while (encoded >= 0x80) {
+    dst.push_back(static_cast<unsigned char>(encoded | 0x80));
+    encoded >>= 7;
+  }
+  dst.push_back(static_cast<unsigned char>(encoded));
+}
+
+uint32_t nullableBytesSize(const absl::optional<absl::string_view>& bytes) {
+  return bytes ? varlongSize(bytes->size()) + bytes->size() : varlongSize(-1);
+}
+
+void appendNullableBytes(Bytes& dst, const absl::optional<absl::string_view>& bytes) {
+  if (bytes) {
+    appendVarlong(dst, bytes->size());
+    dst.insert(dst.end(), bytes->begin(), bytes->end());
+  } else {
+    appendVarlong(dst, -1);
+  }
+}
+
+} // namespace
+
+void RecordExtractor::extract(absl::string_view topic, int32_t partition, absl::string_view data,
+                              std::vector<OutboundRecord>& records) {
+  Reader reader{data};
+  while (!reader.empty()) {
+    reader.readInt<int64_t>(); // Base offset, assigned by the broker.
+    Reader batch{reader.readBytes(reader.readInt<int32_t>())};
+
+    batch.readInt<int32_t>(); // Partition leader epoch.
+    const int8_t magic = batch.readInt<int8_t>();
+    if (magic != CurrentMagic) {
+      throw InvalidRecordBatchException(fmt::format("unsupported record batch magic: {}", magic),
+                                        ErrorCodes::CorruptMessage);
+    }
+    const uint32_t crc = batch.readInt<uint32_t>();
+    const absl::string_view checked = batch.remaining();
+    const int16_t attributes = batch.readInt<int16_t>();
+    if (attributes & CompressionCodecMask) {
+      throw InvalidRecordBatchException("compressed record batches are not supported",
+                                        ErrorCodes::UnsupportedCompressionType);
+    }
+    if (attributes & (TransactionalFlag | ControlFlag)) {
+      throw InvalidRecordBatchException("transactional record batches are not supported",
+                                        ErrorCodes::CorruptMessage);
+    }
+    if (crc != crc32c(checked)) {
+      throw InvalidRecordBatchException("record batch checksum mismatch",
+                                        ErrorCodes::CorruptMessage);
+    }
+    batch.readInt<int32_t>(); // Last offset delta.
+    const int64_t first_timestamp = batch.readInt<int64_t>();
+    batch.readInt<int64_t>(); // Max timestamp.
+    // The producer id, epoch and base sequence of idempotent producers do not survive
+    // re-batching, so they are dropped.
+    batch.readInt<int64_t>();
+    batch.readInt<int16_t>();
+    batch.readInt<int32_t>();
+
+    const int32_t count = batch.readInt<int32_t>();
+    for (int32_t i = 0; i < count; i++) {
+      Reader record{batch.readBytes(batch.readVarlong())};
+      record.readInt<int8_t>(); // Attributes, unused.
+      const int64_t timestamp_delta = record.readVarlong();
+      record.readVarlong(); // Offset delta, re-assigned when re-batched.
+      const absl::optional<absl::string_view> key = record.readNullableBytes();
+      const absl::optional<absl::string_view> value = record.readNullableBytes();
+      const absl::string_view headers = record.remaining();
+      const int64_t header_count = record.readVarlong();
+      for (int64_t header = 0; header < header_count; header++) {
+        record.readBytes(record.readVarlong()); // Header key.
+        record.readNullableBytes();             // Header value.
+      }
+      if (!record.empty()) {
+        throw InvalidRecordBatchException("invalid record length", ErrorCodes::CorruptMessage);
+      }
+      records.push_back({topic, partition, first_timestamp + timestamp_delta, key, value, headers});
+    }
+    if (!batch.empty()) {
+      throw InvalidRecordBatchException("invalid record batch length", ErrorCodes::CorruptMessage);
+    }
+  }
+}
+
+void RecordBatchBuilder::add(const OutboundRecord& record) {
+  if (count_ == 0) {
+    first_timestamp_ = record.timestamp_;
+    max_timestamp_ = record.timestamp_;
+  }
+  max_timestamp_ = std::max(max_timestamp_, record.timestamp_);
+
+  const int64_t timestamp_delta = record.timestamp_ - first_timestamp_;
+  const uint32_t headers_size = record.headers_.empty() ? varlongSize(0) : record.headers_.size();
+  const int64_t length = sizeof(int8_t) + varlongSize(timestamp_delta) + varlongSize(count_) +
+                         nullableBytesSize(record.key_) + nullableBytesSize(record.value_) +
+                         headers_size;
+
+  appendVarlong(records_, length);
+  appendInt<int8_t>(records_, 0); // Attributes, unused.
+  appendVarlong(records_, timestamp_delta);
+  appendVarlong(records_, count_); // Offset delta.
+  appendNullableBytes(records_, record.key_);
+  appendNullableBytes(records_, record.value_);
+  if (record.headers_.empty()) {
+    appendVarlong(records_, 0);
+  } else {
+    records_.insert(records_.end(), record.headers_.begin(), record.headers_.end());
+  }
+  count_++;
+}
+
+Bytes RecordBatchBuilder::build() const {
+  Bytes batch;
+  batch.reserve(size());
+  appendInt<int64_t>(batch, 0); // Base offset, assigned by the broker.
+  appendInt<int32_t>(batch, size() - LogOverhead);
+  appendInt<int32_t>(batch, -1); // Partition leader epoch.
+  appendInt<int8_t>(batch, CurrentMagic);
+  appendInt<uint32_t>(batch, 0); // Checksum, computed once the batch is complete.
+  appendInt<int16_t>(batch, 0);  // Attributes: no compression, creation timestamps.
+  appendInt<int32_t>(batch, count_ - 1);
+  appendInt<int64_t>(batch, first_timestamp_);
+  appendInt<int64_t>(batch, max_timestamp_);
+  appendInt<int64_t>(batch, -1); // Producer id.
+  appendInt<int16_t>(batch, -1); // Producer epoch.
+  appendInt<int32_t>(batch, -1); // Base sequence.
+  appendInt<int32_t>(batch, count_);
+  ASSERT(batch.size() == HeaderSize);
+  batch.insert(batch.end(), records_.begin(), records_.end());
+
+  const uint32_t crc = crc32c({reinterpret_cast<const char*>(batch.data()) + AttributesOffset,
+                               batch.size() - AttributesOffset});
+  const uint32_t encoded_crc = htobe32(crc);
+  memcpy(batch.data() + CrcOffset, &encoded_crc, sizeof(encoded_crc));
+  return batch;
+}
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
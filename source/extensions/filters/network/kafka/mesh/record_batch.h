@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "envoy/common/exception.h"
+
+#include "extensions/filters/network/kafka/kafka_types.h"
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+/**
+ * Record received from a downstream client, to be sent to an upstream cluster.
+ * Its topic, key, value and headers reference the request it was extracted from.
+ */
+struct OutboundRecord {
+  absl::string_view topic_;
+  int32_t partition_;
+  // Creation time in milliseconds since epoch.
+  int64_t timestamp_;
+  absl::optional<absl::string_view> key_;
+  absl::optional<absl::string_view> value_;
+  // Header count followed by the headers, as encoded in record batches.
+  absl::string_view headers_;
+};
+
+/**
+ * Thrown when the record batches of a partition cannot be re-batched.
+ */
+class InvalidRecordBatchException : public EnvoyException {
+public:
+  InvalidRecordBatchException(const std::string& message, int16_t error_code)
+      : EnvoyException(message), error_code_(error_code) {}
+
+  /**
+   * @return the Kafka error code to be returned for the partition.
+   */
+  int16_t errorCode() const { return error_code_; }
+
+private:
+  const int16_t error_code_;
+};
+
+/**
+ * Extracts the records from the record batches of a partition in a produce request.
+ * @see https://kafka.apache.org/documentation/#recordbatch
+ */
+class RecordExtractor {
+public:
+  /**
+   * Appends the records of the batches to a vector. Only uncompressed, non-transactional batches
+   * of the current format (magic v2) are supported.
+   * @param topic topic of the partition.
+   * @param partition partition index.
+   * @param data record batches of the partition.
+   * @param records receives the records, referencing the topic and data.
+   * @throw InvalidRecordBatchException if the batches are malformed or not supported.
+   */
+  static void extract(absl::string_view topic, int32_t partition, absl::string_view data,
+                      std::vector<OutboundRecord>& records);
+};
+
+/**
+ * Re-encodes the records of a partition, whatever batches they were received in, into a single
+ * record batch.
+ */
+class RecordBatchBuilder {
+public:
+  /**
+   * Appends a record to the batch, copying its data.
+   */
+  void add(const OutboundRecord& record);
+
+  /**
+   * @return the number of records added.
+   */
+  uint32_t count() const { return count_; }
+
+  /**
+   * @return the size in bytes of the batch of the records added.
+   */
+  uint32_t size() const { return HeaderSize + records_.size(); }
+
+  /**
+   * @return the record batch of the records added.
+   */
+  Bytes build() const;
+
+  // The size of the header of record batches, before their records.
+  static constexpr uint32_t HeaderSize = 61;
+
+private:
+  Bytes records_;
+  uint32_t count_{};
+  int64_t first_timestamp_{};
+  int64_t max_timestamp_{};
+};
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
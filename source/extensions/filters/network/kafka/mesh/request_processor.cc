@@ -0,0 +1,64 @@
+#include "extensions/filters/network/kafka/mesh/request_processor.h"
+
+#include "envoy/common/exception.h"
+
+#include "common/common/fmt.h"
+
+#include "extensions/filters/network/kafka/mesh/command_handlers/api_versions.h"
+#include "extensions/filters/network/kafka/mesh/command_handlers/metadata.h"
+#include "extensions/filters/network/kafka/mesh/command_handlers/produce.h"
+#include "extensions/filters/network/kafka/mesh/kafka_constants.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+RequestProcessor::RequestProcessor(AbstractRequestListener& origin,
+                                   const UpstreamKafkaConfiguration& configuration,
+                                   UpstreamKafkaFacade& upstream_kafka_facade)
+    : origin_{origin}, configuration_{configuration}, upstream_kafka_facade_{
+                                                          upstream_kafka_facade} {}
+
+template <typename T>
+std::shared_ptr<Request<T>> RequestProcessor::cast(const AbstractRequestSharedPtr& arg) {
+  auto result = std::dynamic_pointer_cast<Request<T>>(arg);
+  if (result == nullptr) {
+    throw EnvoyException(fmt::format("kafka mesh: unexpected request with api key {}",
+                                     arg->request_header_.api_key_));
+  }
+  return result;
+}
+
+void RequestProcessor::onMessage(AbstractRequestSharedPtr arg) {
+  InFlightRequestSharedPtr request;
+  switch (arg->request_header_.api_key_) {
+  case ApiKeys::Produce:
+    request = std::make_shared<ProduceRequestHolder>(
+        origin_, configuration_, upstream_kafka_facade_, cast<ProduceRequest>(arg));
+    break;
+  case ApiKeys::Metadata:
+    request = std::make_shared<MetadataRequestHolder>(origin_, configuration_,
+                                                      cast<MetadataRequest>(arg));
+    break;
+  case ApiKeys::ApiVersions:
+    request = std::make_shared<ApiVersionsRequestHolder>(origin_, cast<ApiVersionsRequest>(arg));
+    break;
+  default:
+    throw EnvoyException(fmt::format("kafka mesh: unsupported request with api key {}",
+                                     arg->request_header_.api_key_));
+  }
+  origin_.onRequest(request);
+}
+
+void RequestProcessor::onFailedParse(RequestParseFailureSharedPtr arg) {
+  throw EnvoyException(fmt::format("kafka mesh: could not parse request with api key {}",
+                                   arg->request_header_.api_key_));
+}
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
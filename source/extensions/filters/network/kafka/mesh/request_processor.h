@@ -0,0 +1,48 @@
+#pragma once
+
+#include "common/common/logger.h"
+
+#include "extensions/filters/network/kafka/external/requests.h"
+#include "extensions/filters/network/kafka/mesh/abstract_command.h"
+#include "extensions/filters/network/kafka/mesh/upstream_config.h"
+#include "extensions/filters/network/kafka/mesh/upstream_kafka_facade.h"
+#include "extensions/filters/network/kafka/request_codec.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+/**
+ * Turns the requests decoded into in-flight requests, passed to the listener.
+ */
+class RequestProcessor : public RequestCallback, private Logger::Loggable<Logger::Id::kafka> {
+public:
+  RequestProcessor(AbstractRequestListener& origin,
+                   const UpstreamKafkaConfiguration& configuration,
+                   UpstreamKafkaFacade& upstream_kafka_facade);
+
+  /**
+   * @throw EnvoyException if the request is not supported.
+   */
+  void onMessage(AbstractRequestSharedPtr arg) override;
+
+  /**
+   * @throw EnvoyException, as requests that cannot be parsed cannot be answered.
+   */
+  void onFailedParse(RequestParseFailureSharedPtr) override;
+
+private:
+  template <typename T> std::shared_ptr<Request<T>> cast(const AbstractRequestSharedPtr& arg);
+
+  AbstractRequestListener& origin_;
+  const UpstreamKafkaConfiguration& configuration_;
+  UpstreamKafkaFacade& upstream_kafka_facade_;
+};
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,55 @@
+#include "extensions/filters/network/kafka/mesh/upstream_config.h"
+
+#include "envoy/common/exception.h"
+
+#include "common/common/fmt.h"
+#include "common/protobuf/utility.h"
+
+#include "absl/strings/match.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+UpstreamKafkaConfigurationImpl::UpstreamKafkaConfigurationImpl(const KafkaMeshProtoConfig& config)
+    : advertised_address_{config.advertised_host(), config.advertised_port()} {
+  for (const auto& cluster : config.upstream_clusters()) {
+    const std::string& name = cluster.cluster_name();
+    clusters_[name] = {name, cluster.partition_count(),
+                       std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(cluster, linger, 5)),
+                       PROTOBUF_GET_WRAPPED_OR_DEFAULT(cluster, max_batch_size_bytes, 16384),
+                       std::chrono::milliseconds(
+                           PROTOBUF_GET_MS_OR_DEFAULT(cluster, request_timeout, 30000))};
+  }
+
+  for (const auto& rule : config.forwarding_rules()) {
+    const auto cluster = clusters_.find(rule.target_cluster());
+    if (cluster == clusters_.end()) {
+      throw EnvoyException(fmt::format("kafka mesh: forwarding rule targets unknown cluster '{}'",
+                                       rule.target_cluster()));
+    }
+    topic_prefixes_.emplace_back(rule.topic_prefix(), &cluster->second);
+  }
+}
+
+const ClusterConfig*
+UpstreamKafkaConfigurationImpl::computeClusterConfigForTopic(const std::string& topic) const {
+  for (const auto& [prefix, cluster] : topic_prefixes_) {
+    if (absl::StartsWith(topic, prefix)) {
+      return cluster;
+    }
+  }
+  return nullptr;
+}
+
+std::pair<std::string, int32_t> UpstreamKafkaConfigurationImpl::getAdvertisedAddress() const {
+  return advertised_address_;
+}
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
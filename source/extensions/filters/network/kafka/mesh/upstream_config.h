@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "envoy/common/pure.h"
+#include "envoy/extensions/filters/network/kafka_mesh/v3alpha/kafka_mesh.pb.h"
+#include "envoy/extensions/filters/network/kafka_mesh/v3alpha/kafka_mesh.pb.validate.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+using KafkaMeshProtoConfig = envoy::extensions::filters::network::kafka_mesh::v3alpha::KafkaMesh;
+
+/**
+ * Upstream Kafka cluster, with the properties of the batches of records sent to it.
+ */
+struct ClusterConfig {
+  // Name of the Envoy cluster whose hosts are the brokers.
+  std::string name_;
+  // Number of partitions advertised to clients for the topics of the cluster.
+  int32_t partition_count_;
+  std::chrono::milliseconds linger_;
+  uint32_t max_batch_size_;
+  std::chrono::milliseconds request_timeout_;
+
+  bool operator==(const ClusterConfig& rhs) const {
+    return name_ == rhs.name_ && partition_count_ == rhs.partition_count_ &&
+           linger_ == rhs.linger_ && max_batch_size_ == rhs.max_batch_size_ &&
+           request_timeout_ == rhs.request_timeout_;
+  }
+};
+
+/**
+ * Keeps the configuration related to upstream Kafka clusters, and decides which cluster the
+ * records of a topic are sent to.
+ */
+class UpstreamKafkaConfiguration {
+public:
+  virtual ~UpstreamKafkaConfiguration() = default;
+
+  /**
+   * @param topic topic name.
+   * @return the cluster the records of the topic are sent to, or nullptr if no rule matches it.
+   */
+  virtual const ClusterConfig* computeClusterConfigForTopic(const std::string& topic) const PURE;
+
+  /**
+   * @return the host and port that clients are told to connect to.
+   */
+  virtual std::pair<std::string, int32_t> getAdvertisedAddress() const PURE;
+};
+
+using UpstreamKafkaConfigurationSharedPtr = std::shared_ptr<const UpstreamKafkaConfiguration>;
+
+class UpstreamKafkaConfigurationImpl : public UpstreamKafkaConfiguration {
+public:
+  /**
+   * @throw EnvoyException if a forwarding rule targets a cluster that is not defined.
+   */
+  UpstreamKafkaConfigurationImpl(const KafkaMeshProtoConfig& config);
+
+  // UpstreamKafkaConfiguration
+  const ClusterConfig* computeClusterConfigForTopic(const std::string& topic) const override;
+  std::pair<std::string, int32_t> getAdvertisedAddress() const override;
+
+private:
+  const std::pair<std::string, int32_t> advertised_address_;
+  // Keyed by cluster name.
+  std::map<std::string, ClusterConfig> clusters_;
+  // Prefixes and their clusters, in the order of the rules.
+  std::vector<std::pair<std::string, const ClusterConfig*>> topic_prefixes_;
+};
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/common/pure.h"
+
+#include "extensions/filters/network/kafka/mesh/record_batch.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+/**
+ * Notified when the records it was registered with have been delivered, or have failed.
+ */
+class RecordCallback {
+public:
+  virtual ~RecordCallback() = default;
+
+  /**
+   * Invoked once per record sent.
+   * @param record_id the id the record was sent with.
+   * @param error_code Kafka error code, ErrorCodes::None if the record was stored.
+   * @param offset offset of the record in its partition, if it was stored.
+   */
+  virtual void onRecordDelivery(uint32_t record_id, int16_t error_code, int64_t offset) PURE;
+};
+
+using RecordCallbackSharedPtr = std::shared_ptr<RecordCallback>;
+
+/**
+ * Sends records to an upstream Kafka cluster, batching them per partition.
+ */
+class KafkaProducer {
+public:
+  virtual ~KafkaProducer() = default;
+
+  /**
+   * Sends a record. Its data is copied, so it does not need to outlive this call.
+   * The callback may be invoked before this method returns, e.g. if the cluster has no hosts.
+   * @param record record to be sent.
+   * @param callback notified when the record has been delivered.
+   * @param record_id id the callback is notified with.
+   */
+  virtual void send(const OutboundRecord& record, RecordCallbackSharedPtr callback,
+                    uint32_t record_id) PURE;
+};
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
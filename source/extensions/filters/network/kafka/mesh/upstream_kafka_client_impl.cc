@@ -0,0 +1,418 @@
+#include "extensions/filters/network/kafka/mesh/upstream_kafka_client_impl.h"
+
+#include "common/buffer/buffer_impl.h"
+#include "common/common/fmt.h"
+
+#include "extensions/filters/network/kafka/external/requests.h"
+#include "extensions/filters/network/kafka/external/responses.h"
+#include "extensions/filters/network/kafka/mesh/kafka_constants.h"
+#include "extensions/filters/network/kafka/request_codec.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+namespace {
+
+// The records are acknowledged once stored by all in-sync replicas, as clients may rely on it.
+constexpr int16_t AcksAll = -1;
+
+constexpr char ClientId[] = "envoy";
+
+bool isStaleMetadataError(int16_t error_code) {
+  return error_code == ErrorCodes::UnknownTopicOrPartition ||
+         error_code == ErrorCodes::LeaderNotAvailable ||
+         error_code == ErrorCodes::NotLeaderForPartition;
+}
+
+} // namespace
+
+uint32_t ProduceBatchesRequest::computeSize() const {
+  const EncodingContext context{request_header_.api_version_};
+  const NullableString transactional_id = absl::nullopt;
+  uint32_t result{0};
+  result += context.computeSize(request_header_);
+  result += context.computeSize(transactional_id);
+  result += context.computeSize(acks_);
+  result += context.computeSize(timeout_ms_);
+  result += sizeof(int32_t); // Topic count.
+  for (const auto& [topic, partitions] : batches_) {
+    result += context.computeSize(topic);
+    result += sizeof(int32_t); // Partition count.
+    for (const auto& [partition, batch] : partitions) {
+      result += context.computeSize(partition);
+      result += context.computeSize(batch);
+    }
+  }
+  return result;
+}
+
+uint32_t ProduceBatchesRequest::encode(Buffer::Instance& dst) const {
+  EncodingContext context{request_header_.api_version_};
+  const NullableString transactional_id = absl::nullopt;
+  uint32_t written{0};
+  written += context.encode(request_header_, dst);
+  written += context.encode(transactional_id, dst);
+  written += context.encode(acks_, dst);
+  written += context.encode(timeout_ms_, dst);
+  written += context.encode(static_cast<int32_t>(batches_.size()), dst);
+  for (const auto& [topic, partitions] : batches_) {
+    written += context.encode(topic, dst);
+    written += context.encode(static_cast<int32_t>(partitions.size()), dst);
+    for (const auto& [partition, batch] : partitions) {
+      written += context.encode(partition, dst);
+      written += context.encode(batch, dst);
+    }
+  }
+  return written;
+}
+
+BrokerConnection::BrokerConnection(KafkaProducerImpl& parent, Upstream::HostConstSharedPtr host,
+                                   Event::Dispatcher& dispatcher,
+                                   std::chrono::milliseconds request_timeout)
+    : parent_(parent), host_(std::move(host)), dispatcher_(dispatcher),
+      request_timeout_(request_timeout),
+      decoder_{std::vector<ResponseCallbackSharedPtr>{std::make_shared<DecoderCallbacks>(*this)}},
+      timer_(dispatcher.createTimer([this]() -> void { onError("timeout"); })) {
+  connection_ = host_->createConnection(dispatcher_, nullptr, nullptr).connection_;
+  connection_->addConnectionCallbacks(*this);
+  connection_->addReadFilter(std::make_shared<ReadFilter>(*this));
+  connection_->connect();
+  connection_->noDelay(true);
+  timer_->enableTimer(host_->cluster().connectTimeout());
+}
+
+BrokerConnection::~BrokerConnection() {
+  closing_ = true;
+  if (connection_ != nullptr) {
+    connection_->close(Network::ConnectionCloseType::NoFlush);
+  }
+}
+
+RequestHeader BrokerConnection::nextRequestHeader(int16_t api_key, int16_t api_version) {
+  return {api_key, api_version, correlation_id_++, NullableString{ClientId}};
+}
+
+void BrokerConnection::send(const AbstractRequest& request, ResponseHandler handler) {
+  ASSERT(connection_ != nullptr);
+  const RequestHeader& header = request.request_header_;
+  decoder_.expectResponse(header.correlation_id_, header.api_key_, header.api_version_);
+  pending_.push_back(std::move(handler));
+  if (connected_ && !timer_->enabled()) {
+    timer_->enableTimer(request_timeout_);
+  }
+
+  Buffer::OwnedImpl buffer;
+  RequestEncoder{buffer}.encode(request);
+  connection_->write(buffer, false);
+}
+
+Network::FilterStatus BrokerConnection::ReadFilter::onData(Buffer::Instance& data, bool) {
+  try {
+    parent_.decoder_.onData(data);
+  } catch (const EnvoyException& e) {
+    parent_.onError(e.what());
+  }
+  data.drain(data.length());
+  return Network::FilterStatus::StopIteration;
+}
+
+void BrokerConnection::onResponse(AbstractResponseSharedPtr response) {
+  if (connection_ == nullptr || pending_.empty()) {
+    // Closed by an earlier response of the same read.
+    return;
+  }
+
+  const ResponseHandler handler = std::move(pending_.front());
+  pending_.pop_front();
+  if (pending_.empty()) {
+    timer_->disableTimer();
+  } else {
+    timer_->enableTimer(request_timeout_);
+  }
+  handler(response);
+}
+
+void BrokerConnection::onError(const std::string& error) {
+  ENVOY_LOG(debug, "kafka mesh: connection to {} failed: {}", host_->address()->asString(), error);
+  if (connection_ != nullptr) {
+    connection_->close(Network::ConnectionCloseType::NoFlush);
+  }
+}
+
+void BrokerConnection::onEvent(Network::ConnectionEvent event) {
+  if (event == Network::ConnectionEvent::Connected) {
+    connected_ = true;
+    timer_->disableTimer();
+    if (!pending_.empty()) {
+      timer_->enableTimer(request_timeout_);
+    }
+    return;
+  }
+
+  timer_->disableTimer();
+  dispatcher_.deferredDelete(std::move(connection_));
+  if (closing_) {
+    return;
+  }
+
+  // The parent schedules the deletion of this connection, which outlives the handlers.
+  std::deque<ResponseHandler> pending;
+  pending.swap(pending_);
+  parent_.onConnectionClosed(*this);
+  for (const ResponseHandler& handler : pending) {
+    handler(nullptr);
+  }
+}
+
+KafkaProducerImpl::KafkaProducerImpl(const ClusterConfig& config,
+                                     Upstream::ClusterManager& cluster_manager,
+                                     Event::Dispatcher& dispatcher)
+    : config_(config), cluster_manager_(cluster_manager), dispatcher_(dispatcher),
+      linger_timer_(dispatcher.createTimer([this]() -> void { flush(); })) {}
+
+void KafkaProducerImpl::send(const OutboundRecord& record, RecordCallbackSharedPtr callback,
+                             uint32_t record_id) {
+  PartitionBatch& batch = topics_[record.topic_].batches_[record.partition_];
+  batch.builder_.add(record);
+  batch.records_.push_back({std::move(callback), record_id});
+
+  if (batch.builder_.size() >= config_.max_batch_size_) {
+    flush();
+  } else if (!linger_timer_->enabled()) {
+    linger_timer_->enableTimer(config_.linger_);
+  }
+}
+
+void KafkaProducerImpl::flush() {
+  linger_timer_->disableTimer();
+
+  struct BrokerRequest {
+    ProduceBatchesRequest::Batches batches_;
+    SentRecords records_;
+  };
+  std::unordered_map<Upstream::HostConstSharedPtr, BrokerRequest> requests;
+  std::vector<std::pair<PendingRecord, int16_t>> failures;
+  std::vector<std::string> unknown_topics;
+
+  for (auto& [name, topic] : topics_) {
+    if (topic.batches_.empty()) {
+      continue;
+    }
+    if (!topic.metadata_known_) {
+      unknown_topics.push_back(name);
+      continue;
+    }
+
+    for (auto& [partition, batch] : topic.batches_) {
+      const auto leader = topic.leaders_.find(partition);
+      if (topic.error_code_ != ErrorCodes::None || leader == topic.leaders_.end()) {
+        const int16_t error_code = topic.error_code_ != ErrorCodes::None
+                                       ? topic.error_code_
+                                       : ErrorCodes::LeaderNotAvailable;
+        for (PendingRecord& record : batch.records_) {
+          failures.emplace_back(std::move(record), error_code);
+        }
+        // The metadata is refreshed for the next records of the topic.
+        topic.metadata_known_ = false;
+        continue;
+      }
+
+      BrokerRequest& request = requests[leader->second];
+      request.batches_[name].emplace_back(partition, batch.builder_.build());
+      request.records_[name][partition] = std::move(batch.records_);
+    }
+    topic.batches_.clear();
+  }
+
+  for (auto& [host, request] : requests) {
+    BrokerConnection& connection = getConnection(host);
+    const ProduceBatchesRequest produce{
+        connection.nextRequestHeader(ApiKeys::Produce, ProduceBatchesRequest::ApiVersion), AcksAll,
+        static_cast<int32_t>(config_.request_timeout_.count()), std::move(request.batches_)};
+    const auto records = std::make_shared<const SentRecords>(std::move(request.records_));
+    connection.send(produce, [this, records](AbstractResponseSharedPtr response) -> void {
+      onProduceResponse(*records, response);
+    });
+  }
+
+  if (!unknown_topics.empty() && !metadata_pending_) {
+    refreshMetadata(std::move(unknown_topics));
+  }
+
+  for (const auto& [record, error_code] : failures) {
+    record.callback_->onRecordDelivery(record.record_id_, error_code, -1);
+  }
+}
+
+void KafkaProducerImpl::refreshMetadata(std::vector<std::string> topics) {
+  Upstream::ThreadLocalCluster* cluster = cluster_manager_.get(config_.name_);
+  const Upstream::HostConstSharedPtr host =
+      cluster != nullptr ? cluster->loadBalancer().chooseHost(nullptr) : nullptr;
+  if (host == nullptr) {
+    ENVOY_LOG(debug, "kafka mesh: no host available in cluster {}", config_.name_);
+    onMetadata(topics, nullptr);
+    return;
+  }
+
+  std::vector<MetadataRequestTopic> request_topics;
+  for (const std::string& topic : topics) {
+    request_topics.emplace_back(topic);
+  }
+  BrokerConnection& connection = getConnection(host);
+  const Request<MetadataRequest> request{
+      connection.nextRequestHeader(ApiKeys::Metadata, MetadataApiVersion),
+      MetadataRequest{NullableArray<MetadataRequestTopic>{std::move(request_topics)}}};
+  metadata_pending_ = true;
+  connection.send(request,
+                  [this, topics = std::move(topics)](AbstractResponseSharedPtr response) -> void {
+                    onMetadata(topics, response);
+                  });
+}
+
+void KafkaProducerImpl::onMetadata(const std::vector<std::string>& topics,
+                                   AbstractResponseSharedPtr response) {
+  metadata_pending_ = false;
+
+  const auto metadata = std::dynamic_pointer_cast<Response<MetadataResponse>>(response);
+  if (metadata != nullptr) {
+    absl::flat_hash_map<int32_t, Upstream::HostConstSharedPtr> brokers;
+    for (const MetadataResponseBroker& broker : metadata->data_.brokers_) {
+      Upstream::HostConstSharedPtr host = findHost(broker.host_, broker.port_);
+      if (host == nullptr) {
+        ENVOY_LOG(debug, "kafka mesh: broker {}:{} is not a host of cluster {}", broker.host_,
+                  broker.port_, config_.name_);
+        continue;
+      }
+      brokers[broker.node_id_] = std::move(host);
+    }
+
+    for (const MetadataResponseTopic& topic_metadata : metadata->data_.topics_) {
+      const auto topic = topics_.find(topic_metadata.name_);
+      if (topic == topics_.end()) {
+        continue;
+      }
+      TopicState& state = topic->second;
+      state.metadata_known_ = true;
+      state.error_code_ = topic_metadata.error_code_;
+      state.leaders_.clear();
+      for (const MetadataResponsePartition& partition : topic_metadata.partitions_) {
+        const auto broker = brokers.find(partition.leader_id_);
+        if (broker != brokers.end()) {
+          state.leaders_[partition.partition_index_] = broker->second;
+        }
+      }
+    }
+  }
+
+  // The records of the topics whose metadata could not be retrieved fail.
+  for (const std::string& name : topics) {
+    const auto topic = topics_.find(name);
+    if (topic != topics_.end() && !topic->second.metadata_known_) {
+      topic->second.metadata_known_ = true;
+      topic->second.error_code_ = metadata != nullptr ? ErrorCodes::UnknownTopicOrPartition
+                                                      : ErrorCodes::NetworkException;
+    }
+  }
+  flush();
+}
+
+void KafkaProducerImpl::onProduceResponse(const SentRecords& records,
+                                          AbstractResponseSharedPtr response) {
+  const auto produce = std::dynamic_pointer_cast<Response<ProduceResponse>>(response);
+  for (const auto& [topic, partitions] : records) {
+    const TopicProduceResponse* topic_response = nullptr;
+    if (produce != nullptr) {
+      for (const TopicProduceResponse& candidate : produce->data_.responses_) {
+        if (candidate.name_ == topic) {
+          topic_response = &candidate;
+          break;
+        }
+      }
+    }
+
+    for (const auto& [partition, partition_records] : partitions) {
+      int16_t error_code =
+          response == nullptr ? ErrorCodes::NetworkException : ErrorCodes::UnknownServerError;
+      int64_t base_offset = -1;
+      if (topic_response != nullptr) {
+        for (const PartitionProduceResponse& candidate : topic_response->partitions_) {
+          if (candidate.partition_index_ == partition) {
+            error_code = candidate.error_code_;
+            base_offset = candidate.base_offset_;
+            break;
+          }
+        }
+      }
+
+      if (isStaleMetadataError(error_code)) {
+        const auto state = topics_.find(topic);
+        if (state != topics_.end()) {
+          state->second.metadata_known_ = false;
+        }
+      }
+
+      for (uint32_t i = 0; i < partition_records.size(); i++) {
+        const PendingRecord& record = partition_records[i];
+        record.callback_->onRecordDelivery(record.record_id_, error_code,
+                                           error_code == ErrorCodes::None ? base_offset + i : -1);
+      }
+    }
+  }
+}
+
+BrokerConnection& KafkaProducerImpl::getConnection(const Upstream::HostConstSharedPtr& host) {
+  BrokerConnectionPtr& connection = connections_[host];
+  if (connection == nullptr) {
+    connection =
+        std::make_unique<BrokerConnection>(*this, host, dispatcher_, config_.request_timeout_);
+  }
+  return *connection;
+}
+
+void KafkaProducerImpl::onConnectionClosed(BrokerConnection& connection) {
+  const auto it = connections_.find(connection.host());
+  if (it != connections_.end() && it->second.get() == &connection) {
+    dispatcher_.deferredDelete(std::move(it->second));
+    connections_.erase(it);
+  }
+
+  // The leaders may have changed, e.g. if the broker was stopped.
+  for (auto& topic : topics_) {
+    topic.second.metadata_known_ = false;
+  }
+  if (!linger_timer_->enabled()) {
+    linger_timer_->enableTimer(config_.linger_);
+  }
+}
+
+Upstream::HostConstSharedPtr KafkaProducerImpl::findHost(const std::string& hostname,
+                                                         int32_t port) const {
+  Upstream::ThreadLocalCluster* cluster = cluster_manager_.get(config_.name_);
+  if (cluster == nullptr) {
+    return nullptr;
+  }
+
+  // Brokers advertise either the address or the hostname of their host.
+  const std::string address = fmt::format("{}:{}", hostname, port);
+  for (const auto& host_set : cluster->prioritySet().hostSetsPerPriority()) {
+    for (const Upstream::HostSharedPtr& host : host_set->hosts()) {
+      if (host->address()->asString() == address) {
+        return host;
+      }
+      if (host->hostname() == hostname && host->address()->ip() != nullptr &&
+          host->address()->ip()->port() == static_cast<uint32_t>(port)) {
+        return host;
+      }
+    }
+  }
+  return nullptr;
+}
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
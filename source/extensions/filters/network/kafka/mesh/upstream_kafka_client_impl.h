@@ -0,0 +1,208 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "envoy/event/deferred_deletable.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+#include "envoy/network/connection.h"
+#include "envoy/upstream/cluster_manager.h"
+#include "envoy/upstream/upstream.h"
+
+#include "common/common/logger.h"
+#include "common/network/filter_impl.h"
+
+#include "extensions/filters/network/kafka/kafka_request.h"
+#include "extensions/filters/network/kafka/kafka_response.h"
+#include "extensions/filters/network/kafka/mesh/record_batch.h"
+#include "extensions/filters/network/kafka/mesh/upstream_config.h"
+#include "extensions/filters/network/kafka/mesh/upstream_kafka_client.h"
+#include "extensions/filters/network/kafka/response_codec.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+/**
+ * Produce request carrying record batches that have already been encoded.
+ * The generated ProduceRequest would need the batches to be copied into its (immutable) data, so
+ * this request encodes the fields of its version 3 directly.
+ */
+class ProduceBatchesRequest : public AbstractRequest {
+public:
+  // Record batches of the partitions of a topic, keyed by topic.
+  using Batches = std::map<std::string, std::vector<std::pair<int32_t, Bytes>>>;
+
+  ProduceBatchesRequest(const RequestHeader& request_header, int16_t acks, int32_t timeout_ms,
+                        Batches&& batches)
+      : AbstractRequest{request_header}, acks_{acks}, timeout_ms_{timeout_ms},
+        batches_{std::move(batches)} {}
+
+  // AbstractRequest
+  uint32_t computeSize() const override;
+  uint32_t encode(Buffer::Instance& dst) const override;
+
+  // The produce request version, the first one supporting record batches v2.
+  static constexpr int16_t ApiVersion = 3;
+
+private:
+  const int16_t acks_;
+  const int32_t timeout_ms_;
+  const Batches batches_;
+};
+
+class KafkaProducerImpl;
+
+/**
+ * A connection to a broker, matching its responses to the requests sent.
+ */
+class BrokerConnection : public Network::ConnectionCallbacks,
+                         public Event::DeferredDeletable,
+                         Logger::Loggable<Logger::Id::kafka> {
+public:
+  // Invoked with the response to a request, or nullptr if the connection closed before it arrived.
+  using ResponseHandler = std::function<void(AbstractResponseSharedPtr)>;
+
+  BrokerConnection(KafkaProducerImpl& parent, Upstream::HostConstSharedPtr host,
+                   Event::Dispatcher& dispatcher, std::chrono::milliseconds request_timeout);
+  ~BrokerConnection() override;
+
+  /**
+   * @return the header of the next request sent.
+   */
+  RequestHeader nextRequestHeader(int16_t api_key, int16_t api_version);
+
+  /**
+   * Sends a request, whose header needs to come from nextRequestHeader().
+   */
+  void send(const AbstractRequest& request, ResponseHandler handler);
+
+  const Upstream::HostConstSharedPtr& host() const { return host_; }
+
+  // Network::ConnectionCallbacks
+  void onEvent(Network::ConnectionEvent event) override;
+  void onAboveWriteBufferHighWatermark() override {}
+  void onBelowWriteBufferLowWatermark() override {}
+
+private:
+  struct ReadFilter : public Network::ReadFilterBaseImpl {
+    ReadFilter(BrokerConnection& parent) : parent_(parent) {}
+
+    // Network::ReadFilter
+    Network::FilterStatus onData(Buffer::Instance& data, bool) override;
+
+    BrokerConnection& parent_;
+  };
+
+  struct DecoderCallbacks : public ResponseCallback {
+    DecoderCallbacks(BrokerConnection& parent) : parent_(parent) {}
+
+    // ResponseCallback
+    void onMessage(AbstractResponseSharedPtr response) override { parent_.onResponse(response); }
+    void onFailedParse(ResponseMetadataSharedPtr) override { parent_.onError("invalid response"); }
+
+    BrokerConnection& parent_;
+  };
+
+  void onResponse(AbstractResponseSharedPtr response);
+  void onError(const std::string& error);
+
+  KafkaProducerImpl& parent_;
+  const Upstream::HostConstSharedPtr host_;
+  Event::Dispatcher& dispatcher_;
+  const std::chrono::milliseconds request_timeout_;
+  ResponseDecoder decoder_;
+  Network::ClientConnectionPtr connection_;
+  // The connect timeout until connected, then the timeout of the oldest pending request.
+  Event::TimerPtr timer_;
+  bool connected_{};
+  int32_t correlation_id_{};
+  std::deque<ResponseHandler> pending_;
+  bool closing_{};
+};
+
+using BrokerConnectionPtr = std::unique_ptr<BrokerConnection>;
+
+/**
+ * Sends records to the brokers of an upstream cluster, from a single worker thread.
+ * Records are added to a batch per partition, which is sent when it is large enough or its linger
+ * has elapsed, together with the other batches for the same broker. The leaders of the partitions
+ * are discovered with metadata requests, refreshed when a broker reports a stale leader.
+ */
+class KafkaProducerImpl : public KafkaProducer, Logger::Loggable<Logger::Id::kafka> {
+public:
+  KafkaProducerImpl(const ClusterConfig& config, Upstream::ClusterManager& cluster_manager,
+                    Event::Dispatcher& dispatcher);
+
+  // KafkaProducer
+  void send(const OutboundRecord& record, RecordCallbackSharedPtr callback,
+            uint32_t record_id) override;
+
+  /**
+   * Sends the batches of all partitions whose leader is known now.
+   */
+  void flush();
+
+  /**
+   * Invoked by a connection once closed, before failing its pending requests.
+   */
+  void onConnectionClosed(BrokerConnection& connection);
+
+  // The version of the metadata requests sent, the first one able to request specific topics
+  // without creating them.
+  static constexpr int16_t MetadataApiVersion = 1;
+
+private:
+  struct PendingRecord {
+    RecordCallbackSharedPtr callback_;
+    uint32_t record_id_;
+  };
+
+  struct PartitionBatch {
+    RecordBatchBuilder builder_;
+    std::vector<PendingRecord> records_;
+  };
+
+  struct TopicState {
+    // Whether the leaders and error are up to date, otherwise the batches wait for metadata.
+    bool metadata_known_{};
+    int16_t error_code_{};
+    absl::flat_hash_map<int32_t, Upstream::HostConstSharedPtr> leaders_;
+    absl::flat_hash_map<int32_t, PartitionBatch> batches_;
+  };
+
+  // The records of the batches sent in a produce request, keyed by topic and partition.
+  using SentRecords = std::map<std::string, std::map<int32_t, std::vector<PendingRecord>>>;
+
+  void refreshMetadata(std::vector<std::string> topics);
+  void onMetadata(const std::vector<std::string>& topics, AbstractResponseSharedPtr response);
+  void onProduceResponse(const SentRecords& records, AbstractResponseSharedPtr response);
+  BrokerConnection& getConnection(const Upstream::HostConstSharedPtr& host);
+  Upstream::HostConstSharedPtr findHost(const std::string& hostname, int32_t port) const;
+
+  const ClusterConfig config_;
+  Upstream::ClusterManager& cluster_manager_;
+  Event::Dispatcher& dispatcher_;
+  const Event::TimerPtr linger_timer_;
+  absl::flat_hash_map<std::string, TopicState> topics_;
+  std::unordered_map<Upstream::HostConstSharedPtr, BrokerConnectionPtr> connections_;
+  bool metadata_pending_{};
+};
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
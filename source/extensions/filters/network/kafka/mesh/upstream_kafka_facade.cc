@@ -0,0 +1,35 @@
+#include "extensions/filters/network/kafka/mesh/upstream_kafka_facade.h"
+
+#include "extensions/filters/network/kafka/mesh/upstream_kafka_client_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+KafkaProducer& ThreadLocalKafkaFacade::getProducer(const ClusterConfig& cluster_config) {
+  std::unique_ptr<KafkaProducer>& producer = producers_[cluster_config.name_];
+  if (producer == nullptr) {
+    producer = std::make_unique<KafkaProducerImpl>(cluster_config, cluster_manager_, dispatcher_);
+  }
+  return *producer;
+}
+
+UpstreamKafkaFacadeImpl::UpstreamKafkaFacadeImpl(ThreadLocal::SlotAllocator& slot_allocator,
+                                                 Upstream::ClusterManager& cluster_manager)
+    : tls_(slot_allocator.allocateSlot()) {
+  tls_->set([&cluster_manager](Event::Dispatcher& dispatcher) {
+    return std::make_shared<ThreadLocalKafkaFacade>(cluster_manager, dispatcher);
+  });
+}
+
+KafkaProducer& UpstreamKafkaFacadeImpl::getProducer(const ClusterConfig& cluster_config) {
+  return tls_->getTyped<ThreadLocalKafkaFacade>().getProducer(cluster_config);
+}
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
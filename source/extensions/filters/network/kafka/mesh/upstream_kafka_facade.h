@@ -0,0 +1,69 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "envoy/common/pure.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/thread_local/thread_local.h"
+#include "envoy/upstream/cluster_manager.h"
+
+#include "extensions/filters/network/kafka/mesh/upstream_config.h"
+#include "extensions/filters/network/kafka/mesh/upstream_kafka_client.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+/**
+ * Provides the producers of the upstream clusters to the filters of the current worker thread.
+ */
+class UpstreamKafkaFacade {
+public:
+  virtual ~UpstreamKafkaFacade() = default;
+
+  /**
+   * @return the producer sending records to the cluster, shared by the filters of the thread.
+   */
+  virtual KafkaProducer& getProducer(const ClusterConfig& cluster_config) PURE;
+};
+
+using UpstreamKafkaFacadeSharedPtr = std::shared_ptr<UpstreamKafkaFacade>;
+
+/**
+ * The producers of a worker thread, keyed by cluster name. Created on first use.
+ */
+class ThreadLocalKafkaFacade : public ThreadLocal::ThreadLocalObject {
+public:
+  ThreadLocalKafkaFacade(Upstream::ClusterManager& cluster_manager, Event::Dispatcher& dispatcher)
+      : cluster_manager_(cluster_manager), dispatcher_(dispatcher) {}
+
+  KafkaProducer& getProducer(const ClusterConfig& cluster_config);
+
+private:
+  Upstream::ClusterManager& cluster_manager_;
+  Event::Dispatcher& dispatcher_;
+  absl::flat_hash_map<std::string, std::unique_ptr<KafkaProducer>> producers_;
+};
+
+class UpstreamKafkaFacadeImpl : public UpstreamKafkaFacade {
+public:
+  UpstreamKafkaFacadeImpl(ThreadLocal::SlotAllocator& slot_allocator,
+                          Upstream::ClusterManager& cluster_manager);
+
+  // UpstreamKafkaFacade
+  KafkaProducer& getProducer(const ClusterConfig& cluster_config) override;
+
+private:
+  ThreadLocal::SlotPtr tls_;
+};
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
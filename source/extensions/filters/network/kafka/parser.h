@@ -113,6 +113,41 @@ private:
   ContextType context_;
 };
 
+/**
+ * Parser that consumes the message data without deserializing it, and then returns a message
+ * carrying only the data extracted before (header), together with the size of data skipped.
+ * This makes the cost of parsing a message independent of its data, as no objects get created out
+ * of it (e.g. records carried by produce requests).
+ * @param ContextType parse context type, needs to provide the remaining bytes & the header.
+ * @param ResponseType parse response type.
+ * @param SkippedMessageType message type constructed from the header and size of data skipped.
+ */
+template <typename ContextType, typename ResponseType, typename SkippedMessageType>
+class AbstractSkippingParser {
+public:
+  AbstractSkippingParser(ContextType context)
+      : context_{context}, data_size_{context->remaining()} {};
+
+  ResponseType parse(absl::string_view& data) {
+    const uint32_t min = std::min<uint32_t>(context_->remaining(), data.size());
+    data = {data.data() + min, data.size() - min};
+    context_->remaining() -= min;
+    if (0 == context_->remaining()) {
+      // Header data is the same as the one that would be used in case of failures.
+      auto message = std::make_shared<SkippedMessageType>(context_->asFailureData(), data_size_);
+      return ResponseType::parsedMessage(message);
+    } else {
+      return ResponseType::stillWaiting();
+    }
+  }
+
+  const ContextType contextForTest() const { return context_; }
+
+private:
+  ContextType context_;
+  const uint32_t data_size_;
+};
+
 } // namespace Kafka
 } // namespace NetworkFilters
 } // namespace Extensions
@@ -372,139 +372,270 @@ std::string FieldImpl::toString() const {
   NOT_REACHED_GCOVR_EXCL_LINE;
 }
 
+namespace {
+
+// Minimum document size: length and terminating zero.
+constexpr uint32_t MinDocumentSize = sizeof(int32_t) + 1;
+
+template <typename T> T readLittleEndian(absl::string_view value) {
+  ASSERT(value.size() >= sizeof(T));
+  T result;
+  std::memcpy(&result, value.data(), sizeof(T));
+  if constexpr (sizeof(T) == sizeof(int32_t)) {
+    return le32toh(result);
+  } else {
+    return le64toh(result);
+  }
+}
+
+absl::string_view readCString(absl::string_view data) {
+  const size_t end = data.find('\0');
+  if (end == absl::string_view::npos) {
+    throw EnvoyException("invalid CString");
+  }
+
+  return data.substr(0, end);
+}
+
+/**
+ * @return the size of the value of an element, checking that it fits in the data given.
+ */
+size_t elementValueSize(Field::Type type, absl::string_view key, absl::string_view data) {
+  size_t size;
+  switch (type) {
+  case Field::Type::Double:
+  case Field::Type::Datetime:
+  case Field::Type::Timestamp:
+  case Field::Type::Int64: {
+    size = sizeof(int64_t);
+    break;
+  }
+
+  case Field::Type::String:
+  case Field::Type::Symbol:
+  case Field::Type::Binary:
+  case Field::Type::Document:
+  case Field::Type::Array: {
+    if (data.size() < sizeof(int32_t)) {
+      throw EnvoyException("invalid buffer size");
+    }
+    const int32_t length = readLittleEndian<int32_t>(data);
+    if (length < 0) {
+      throw EnvoyException("invalid buffer size");
+    }
+    if (type == Field::Type::Document || type == Field::Type::Array) {
+      // The length of documents includes itself.
+      size = length;
+    } else if (type == Field::Type::Binary) {
+      // Length and subtype.
+      size = sizeof(int32_t) + 1 + length;
+    } else {
+      size = sizeof(int32_t) + length;
+    }
+    break;
+  }
+
+  case Field::Type::ObjectId: {
+    size = sizeof(Field::ObjectId);
+    break;
+  }
+
+  case Field::Type::Boolean: {
+    size = 1;
+    break;
+  }
+
+  case Field::Type::NullValue: {
+    size = 0;
+    break;
+  }
+
+  case Field::Type::Regex: {
+    // Pattern and options.
+    const absl::string_view pattern = readCString(data);
+    const absl::string_view options = readCString(data.substr(pattern.size() + 1));
+    size = pattern.size() + options.size() + 2;
+    break;
+  }
+
+  case Field::Type::Int32: {
+    size = sizeof(int32_t);
+    break;
+  }
+
+  default:
+    throw EnvoyException(fmt::format("invalid BSON element type: {:#x} key: {}",
+                                     static_cast<uint8_t>(type), key));
+  }
+
+  if (size > data.size()) {
+    throw EnvoyException("invalid buffer size");
+  }
+
+  return size;
+}
+
+/**
+ * Invokes the callback with the type, key and value bytes of every element of a document, after
+ * checking that they are well formed and contained in the document.
+ */
+template <typename Callback> void forEachElement(absl::string_view document, Callback callback) {
+  const size_t end = document.size() - 1;
+  size_t offset = sizeof(int32_t);
+  while (offset < end) {
+    const auto type = static_cast<Field::Type>(document[offset]);
+    const absl::string_view key = readCString(document.substr(offset + 1, end - offset - 1));
+    offset += 1 + key.size() + 1;
+    const absl::string_view rest = document.substr(offset, end - offset);
+    const absl::string_view value = rest.substr(0, elementValueSize(type, key, rest));
+    callback(type, key, value);
+    offset += value.size();
+  }
+
+  if (document[end] != 0) {
+    throw EnvoyException("invalid document");
+  }
+}
+
+} // namespace
+
+DocumentImpl::DocumentImpl(std::shared_ptr<const std::string> storage, absl::string_view raw)
+    : storage_(std::move(storage)), raw_(raw), fields_decoded_(false) {
+  if (raw_.size() < MinDocumentSize ||
+      static_cast<uint32_t>(readLittleEndian<int32_t>(raw_)) != raw_.size()) {
+    throw EnvoyException("invalid BSON message length");
+  }
+
+  // Only the top level elements are checked, nested documents get checked when decoded.
+  forEachElement(raw_, [](Field::Type, absl::string_view, absl::string_view) {});
+}
+
 void DocumentImpl::fromBuffer(Buffer::Instance& data) {
-  uint64_t original_buffer_length = data.length();
-  int32_t message_length = BufferHelper::removeInt32(data);
-  if (static_cast<uint64_t>(message_length) > original_buffer_length) {
+  const uint64_t original_buffer_length = data.length();
+  const int32_t message_length = BufferHelper::peekInt32(data);
+  if (message_length < static_cast<int32_t>(MinDocumentSize) ||
+      static_cast<uint64_t>(message_length) > original_buffer_length) {
     throw EnvoyException("invalid BSON message length");
   }
 
   ENVOY_LOG(trace, "BSON document length: {} data length: {}", message_length,
             original_buffer_length);
 
-  while (true) {
-    uint64_t document_bytes_remaining = data.length() - (original_buffer_length - message_length);
-    ENVOY_LOG(trace, "BSON document bytes remaining: {}", document_bytes_remaining);
-    if (document_bytes_remaining == 1) {
-      uint8_t last_byte = BufferHelper::removeByte(data);
-      if (last_byte != 0) {
-        throw EnvoyException("invalid document");
-      }
+  // The document gets copied out as a whole, and checked in place.
+  auto storage = std::make_shared<std::string>(message_length, '\0');
+  data.copyOut(0, message_length, &(*storage)[0]);
+  data.drain(message_length);
 
-      return;
-    }
+  storage_ = std::move(storage);
+  raw_ = *storage_;
+  fields_decoded_ = false;
+  forEachElement(raw_, [](Field::Type, absl::string_view, absl::string_view) {});
+}
 
-    uint8_t element_type = BufferHelper::removeByte(data);
-    std::string key = BufferHelper::removeCString(data);
-    ENVOY_LOG(trace, "BSON element type: {:#x} key: {}", element_type, key);
-    switch (static_cast<Field::Type>(element_type)) {
-    case Field::Type::Double: {
-      double value = BufferHelper::removeDouble(data);
-      ENVOY_LOG(trace, "BSON double: {}", value);
-      addDouble(key, value);
-      break;
-    }
+const std::list<FieldPtr>& DocumentImpl::fields() const {
+  if (fields_decoded_) {
+    return fields_;
+  }
 
-    case Field::Type::String: {
-      std::string value = BufferHelper::removeString(data);
-      ENVOY_LOG(trace, "BSON string: {}", value);
-      addString(key, std::move(value));
+  std::list<FieldPtr> fields;
+  forEachElement(raw_, [this, &fields](Field::Type type, absl::string_view key_view,
+                                       absl::string_view value) {
+    const std::string key{key_view};
+    ENVOY_LOG(trace, "BSON element type: {:#x} key: {}", static_cast<uint8_t>(type), key);
+    switch (type) {
+    case Field::Type::Double: {
+      // There is not really official endian support for floating point so we unpack an 8 byte
+      // integer into a double.
+      const int64_t bits = readLittleEndian<int64_t>(value);
+      double double_value;
+      std::memcpy(&double_value, &bits, sizeof(double_value));
+      fields.emplace_back(new FieldImpl(key, double_value));
       break;
     }
 
+    case Field::Type::String:
     case Field::Type::Symbol: {
-      std::string value = BufferHelper::removeString(data);
-      ENVOY_LOG(trace, "BSON symbol: {}", value);
-      addSymbol(key, std::move(value));
-      break;
-    }
-
-    case Field::Type::Document: {
-      ENVOY_LOG(trace, "BSON document");
-      addDocument(key, DocumentImpl::create(data));
+      // Strings are read up to their terminating zero.
+      const absl::string_view string_value = value.substr(sizeof(int32_t));
+      fields.emplace_back(
+          new FieldImpl(type, key, std::string(string_value.substr(0, string_value.find('\0')))));
       break;
     }
 
+    case Field::Type::Document:
     case Field::Type::Array: {
-      ENVOY_LOG(trace, "BSON array");
-      addArray(key, DocumentImpl::create(data));
+      fields.emplace_back(
+          new FieldImpl(type, key, DocumentSharedPtr{new DocumentImpl(storage_, value)}));
       break;
     }
 
     case Field::Type::Binary: {
-      std::string value = BufferHelper::removeBinary(data);
-      ENVOY_LOG(trace, "BSON binary: {}", value);
-      addBinary(key, std::move(value));
+      // Skip the subtype, we do not store it for now.
+      fields.emplace_back(new FieldImpl(type, key, std::string(value.substr(sizeof(int32_t) + 1))));
       break;
     }
 
     case Field::Type::ObjectId: {
-      Field::ObjectId value;
-      BufferHelper::removeBytes(data, &value[0], value.size());
-      addObjectId(key, std::move(value));
+      Field::ObjectId object_id;
+      std::memcpy(&object_id[0], value.data(), object_id.size());
+      fields.emplace_back(new FieldImpl(key, std::move(object_id)));
       break;
     }
 
     case Field::Type::Boolean: {
-      const bool value = BufferHelper::removeByte(data) != 0;
-      ENVOY_LOG(trace, "BSON boolean: {}", value);
-      addBoolean(key, value);
+      fields.emplace_back(new FieldImpl(key, value[0] != 0));
       break;
     }
 
-    case Field::Type::Datetime: {
-      const int64_t value = BufferHelper::removeInt64(data);
-      ENVOY_LOG(trace, "BSON datetime: {}", value);
-      addDatetime(key, value);
+    case Field::Type::Datetime:
+    case Field::Type::Timestamp:
+    case Field::Type::Int64: {
+      fields.emplace_back(new FieldImpl(type, key, readLittleEndian<int64_t>(value)));
       break;
     }
 
     case Field::Type::NullValue: {
-      ENVOY_LOG(trace, "BSON null value");
-      addNull(key);
+      fields.emplace_back(new FieldImpl(key));
       break;
     }
 
     case Field::Type::Regex: {
-      Field::Regex value;
-      value.pattern_ = BufferHelper::removeCString(data);
-      value.options_ = BufferHelper::removeCString(data);
-      ENVOY_LOG(trace, "BSON regex pattern: {} options: {}", value.pattern_, value.options_);
-      addRegex(key, std::move(value));
+      Field::Regex regex;
+      regex.pattern_ = std::string(readCString(value));
+      regex.options_ = std::string(readCString(value.substr(regex.pattern_.size() + 1)));
+      fields.emplace_back(new FieldImpl(key, std::move(regex)));
       break;
     }
 
     case Field::Type::Int32: {
-      int32_t value = BufferHelper::removeInt32(data);
-      ENVOY_LOG(trace, "BSON int32: {}", value);
-      addInt32(key, value);
+      fields.emplace_back(new FieldImpl(key, readLittleEndian<int32_t>(value)));
       break;
     }
 
-    case Field::Type::Timestamp: {
-      int64_t value = BufferHelper::removeInt64(data);
-      ENVOY_LOG(trace, "BSON timestamp: {}", value);
-      addTimestamp(key, value);
-      break;
+    default:
+      NOT_REACHED_GCOVR_EXCL_LINE;
     }
+  });
 
-    case Field::Type::Int64: {
-      int64_t value = BufferHelper::removeInt64(data);
-      ENVOY_LOG(trace, "BSON int64: {}", value);
-      addInt64(key, value);
-      break;
-    }
+  fields_ = std::move(fields);
+  fields_decoded_ = true;
+  return fields_;
+}
 
-    default:
-      throw EnvoyException(
-          fmt::format("invalid BSON element type: {:#x} key: {}", element_type, key));
-    }
-  }
+std::list<FieldPtr>& DocumentImpl::mutableFields() {
+  fields();
+  storage_.reset();
+  raw_ = {};
+  return fields_;
 }
 
 int32_t DocumentImpl::byteSize() const {
+  if (!raw_.empty()) {
+    return raw_.size();
+  }
+
   // Minimum size is 5.
-  int32_t total_size = sizeof(int32_t) + 1;
+  int32_t total_size = MinDocumentSize;
   for (const FieldPtr& field : fields_) {
     total_size += field->byteSize();
   }
@@ -513,6 +644,11 @@ int32_t DocumentImpl::byteSize() const {
 }
 
 void DocumentImpl::encode(Buffer::Instance& output) const {
+  if (!raw_.empty()) {
+    output.add(raw_.data(), raw_.size());
+    return;
+  }
+
   BufferHelper::writeInt32(output, byteSize());
   for (const FieldPtr& field : fields_) {
     field->encode(output);
@@ -543,7 +679,7 @@ std::string DocumentImpl::toString() const {
   out << "{";
 
   bool first = true;
-  for (const FieldPtr& field : fields_) {
+  for (const FieldPtr& field : fields()) {
     if (!first) {
       out << ", ";
     }
@@ -557,7 +693,7 @@ std::string DocumentImpl::toString() const {
 }
 
 const Field* DocumentImpl::find(const std::string& name) const {
-  for (const FieldPtr& field : fields_) {
+  for (const FieldPtr& field : fields()) {
     if (field->key() == name) {
       return field.get();
     }
@@ -567,7 +703,7 @@ const Field* DocumentImpl::find(const std::string& name) const {
 }
 
 const Field* DocumentImpl::find(const std::string& name, Field::Type type) const {
-  for (const FieldPtr& field : fields_) {
+  for (const FieldPtr& field : fields()) {
     if (field->key() == name && field->type() == type) {
       return field.get();
     }
@@ -11,6 +11,8 @@
 
 #include "extensions/filters/network/mongo_proxy/bson.h"
 
+#include "absl/strings/string_view.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -177,6 +179,12 @@ private:
   Value value_;
 };
 
+/**
+ * A BSON document. Documents created from a buffer keep the raw document bytes, and only check that
+ * their top level elements are well formed. The fields get decoded from the raw bytes when first
+ * accessed (nested documents in turn being decoded only when their fields are accessed), so that
+ * documents that are only passed through (e.g. inserted documents) are never decoded.
+ */
 class DocumentImpl : public Document,
                      Logger::Loggable<Logger::Id::mongo>,
                      public std::enable_shared_from_this<DocumentImpl> {
@@ -190,72 +198,72 @@ public:
 
   // Mongo::Document
   DocumentSharedPtr addDouble(const std::string& key, double value) override {
-    fields_.emplace_back(new FieldImpl(key, value));
+    mutableFields().emplace_back(new FieldImpl(key, value));
     return shared_from_this();
   }
 
   DocumentSharedPtr addString(const std::string& key, std::string&& value) override {
-    fields_.emplace_back(new FieldImpl(Field::Type::String, key, std::move(value)));
+    mutableFields().emplace_back(new FieldImpl(Field::Type::String, key, std::move(value)));
     return shared_from_this();
   }
 
   DocumentSharedPtr addSymbol(const std::string& key, std::string&& value) override {
-    fields_.emplace_back(new FieldImpl(Field::Type::Symbol, key, std::move(value)));
+    mutableFields().emplace_back(new FieldImpl(Field::Type::Symbol, key, std::move(value)));
     return shared_from_this();
   }
 
   DocumentSharedPtr addDocument(const std::string& key, DocumentSharedPtr value) override {
-    fields_.emplace_back(new FieldImpl(Field::Type::Document, key, value));
+    mutableFields().emplace_back(new FieldImpl(Field::Type::Document, key, value));
     return shared_from_this();
   }
 
   DocumentSharedPtr addArray(const std::string& key, DocumentSharedPtr value) override {
-    fields_.emplace_back(new FieldImpl(Field::Type::Array, key, value));
+    mutableFields().emplace_back(new FieldImpl(Field::Type::Array, key, value));
     return shared_from_this();
   }
 
   DocumentSharedPtr addBinary(const std::string& key, std::string&& value) override {
-    fields_.emplace_back(new FieldImpl(Field::Type::Binary, key, std::move(value)));
+    mutableFields().emplace_back(new FieldImpl(Field::Type::Binary, key, std::move(value)));
     return shared_from_this();
   }
 
   DocumentSharedPtr addObjectId(const std::string& key, Field::ObjectId&& value) override {
-    fields_.emplace_back(new FieldImpl(key, std::move(value)));
+    mutableFields().emplace_back(new FieldImpl(key, std::move(value)));
     return shared_from_this();
   }
 
   DocumentSharedPtr addBoolean(const std::string& key, bool value) override {
-    fields_.emplace_back(new FieldImpl(key, value));
+    mutableFields().emplace_back(new FieldImpl(key, value));
     return shared_from_this();
   }
 
   DocumentSharedPtr addDatetime(const std::string& key, int64_t value) override {
-    fields_.emplace_back(new FieldImpl(Field::Type::Datetime, key, value));
+    mutableFields().emplace_back(new FieldImpl(Field::Type::Datetime, key, value));
     return shared_from_this();
   }
 
   DocumentSharedPtr addNull(const std::string& key) override {
-    fields_.emplace_back(new FieldImpl(key));
+    mutableFields().emplace_back(new FieldImpl(key));
     return shared_from_this();
   }
 
   DocumentSharedPtr addRegex(const std::string& key, Field::Regex&& value) override {
-    fields_.emplace_back(new FieldImpl(key, std::move(value)));
+    mutableFields().emplace_back(new FieldImpl(key, std::move(value)));
     return shared_from_this();
   }
 
   DocumentSharedPtr addInt32(const std::string& key, int32_t value) override {
-    fields_.emplace_back(new FieldImpl(key, value));
+    mutableFields().emplace_back(new FieldImpl(key, value));
     return shared_from_this();
   }
 
   DocumentSharedPtr addTimestamp(const std::string& key, int64_t value) override {
-    fields_.emplace_back(new FieldImpl(Field::Type::Timestamp, key, value));
+    mutableFields().emplace_back(new FieldImpl(Field::Type::Timestamp, key, value));
     return shared_from_this();
   }
 
   DocumentSharedPtr addInt64(const std::string& key, int64_t value) override {
-    fields_.emplace_back(new FieldImpl(Field::Type::Int64, key, value));
+    mutableFields().emplace_back(new FieldImpl(Field::Type::Int64, key, value));
     return shared_from_this();
   }
 
@@ -265,14 +273,35 @@ public:
   const Field* find(const std::string& name) const override;
   const Field* find(const std::string& name, Field::Type type) const override;
   std::string toString() const override;
-  const std::list<FieldPtr>& values() const override { return fields_; }
+  const std::list<FieldPtr>& values() const override { return fields(); }
 
 private:
   DocumentImpl() = default;
 
+  /**
+   * Creates a document out of its raw bytes, that are kept alive by the storage.
+   */
+  DocumentImpl(std::shared_ptr<const std::string> storage, absl::string_view raw);
+
   void fromBuffer(Buffer::Instance& data);
 
-  std::list<FieldPtr> fields_;
+  /**
+   * @return the fields of the document, decoding them from the raw bytes if not done yet.
+   */
+  const std::list<FieldPtr>& fields() const;
+
+  /**
+   * @return the fields of the document for modification, after which the raw bytes no longer
+   * represent the document.
+   */
+  std::list<FieldPtr>& mutableFields();
+
+  // Raw bytes of the document (from its length to its terminating zero), when it was created from a
+  // buffer and has not been modified since. The storage is shared with the nested documents.
+  std::shared_ptr<const std::string> storage_;
+  absl::string_view raw_;
+  mutable bool fields_decoded_{true};
+  mutable std::list<FieldPtr> fields_;
 };
 
 } // namespace Bson
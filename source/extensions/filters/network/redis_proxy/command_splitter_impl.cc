@@ -2,6 +2,9 @@
 
 #include "extensions/filters/network/common/redis/supported_commands.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/ascii.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -14,7 +17,17 @@ namespace {
 ConnPool::DoNothingPoolCallbacks null_pool_callbacks;
 
 /**
- * Make request and maybe mirror the request based on the mirror policies of the route.
+ * @return whether a command may modify its keys.
+ * @param command supplies the command, in any case.
+ */
+bool isWriteCommand(const std::string& command) {
+  return !Common::Redis::SupportedCommands::isReadCommand(absl::AsciiStrToLower(command));
+}
+
+/**
+ * Make request and maybe mirror the request based on the mirror policies of the route. The replies
+ * cached by the near cache of the upstream for the key of a write are removed first, so that the
+ * reads of the key following the write through the proxy observe it.
  * @param route supplies the route matched with the request.
  * @param command supplies the command of the request.
  * @param key supplies the key of the request.
@@ -26,6 +39,11 @@ ConnPool::DoNothingPoolCallbacks null_pool_callbacks;
 Common::Redis::Client::PoolRequest* makeSingleServerRequest(
     const RouteSharedPtr& route, const std::string& command, const std::string& key,
     Common::Redis::RespValueConstSharedPtr incoming_request, ConnPool::PoolCallbacks& callbacks) {
+  NearCache::Cache* near_cache = route->upstream()->nearCache();
+  if (near_cache != nullptr && isWriteCommand(command)) {
+    near_cache->invalidate(key);
+  }
+
   auto handler =
       route->upstream()->makeRequest(key, ConnPool::RespVariant(incoming_request), callbacks);
   if (handler) {
@@ -86,12 +104,17 @@ SingleServerRequest::~SingleServerRequest() { ASSERT(!handle_); }
 
 void SingleServerRequest::onResponse(Common::Redis::RespValuePtr&& response) {
   handle_ = nullptr;
+  if (near_cache_fill_ != nullptr) {
+    near_cache_fill_->onReply(*response);
+    near_cache_fill_.reset();
+  }
   updateStats(true);
   callbacks_.onResponse(std::move(response));
 }
 
 void SingleServerRequest::onFailure() {
   handle_ = nullptr;
+  near_cache_fill_.reset();
   updateStats(false);
   callbacks_.onResponse(Common::Redis::Utility::makeError(Response::get().UpstreamFailure));
 }
@@ -110,6 +133,17 @@ SplitRequestPtr SimpleRequest::create(Router& router,
 
   const auto route = router.upstreamPool(incoming_request->asArray()[1].asString());
   if (route) {
+    NearCache::Cache* near_cache = route->upstream()->nearCache();
+    if (near_cache != nullptr) {
+      Common::Redis::RespValuePtr cached_response =
+          near_cache->lookup(*incoming_request, request_ptr->near_cache_fill_);
+      if (cached_response != nullptr) {
+        request_ptr->updateStats(true);
+        callbacks.onResponse(std::move(cached_response));
+        return nullptr;
+      }
+    }
+
     Common::Redis::RespValueSharedPtr base_request = std::move(incoming_request);
     request_ptr->handle_ =
         makeSingleServerRequest(route, base_request->asArray()[0].asString(),
@@ -175,31 +209,96 @@ void FragmentedRequest::onChildFailure(uint32_t index) {
   onChildResponse(Common::Redis::Utility::makeError(Response::get().UpstreamFailure), index);
 }
 
+void FragmentedRequest::makeFragments(Router& router, Common::Redis::RespValue& incoming_request,
+                                      uint32_t arguments_per_key) {
+  std::vector<Common::Redis::RespValue>& arguments = incoming_request.asArray();
+  const uint32_t num_keys = (arguments.size() - 1) / arguments_per_key;
+  fragments_.reserve(num_keys);
+
+  // The fragments of the keys aggregated by their upstream, keyed by the upstream and the shard.
+  absl::flat_hash_map<std::pair<const ConnPool::Instance*, uint64_t>, uint32_t> shard_fragments;
+  const bool write_command = isWriteCommand(arguments[0].asString());
+  for (uint32_t key = 0; key < num_keys; key++) {
+    std::string& key_string = arguments[1 + key * arguments_per_key].asString();
+    RouteSharedPtr route = router.upstreamPool(key_string);
+    if (route) {
+      const ConnPool::InstanceSharedPtr upstream = route->upstream();
+      NearCache::Cache* near_cache = upstream->nearCache();
+      if (write_command && near_cache != nullptr) {
+        // As for single server requests, reads following the write must observe it.
+        near_cache->invalidate(key_string);
+      }
+      const absl::optional<uint64_t> shard = upstream->shardKey(key_string);
+      if (shard.has_value()) {
+        auto fragment = shard_fragments.try_emplace(
+            std::make_pair(upstream.get(), shard.value()), fragments_.size());
+        if (!fragment.second) {
+          fragments_[fragment.first->second].keys_.push_back(key);
+          continue;
+        }
+      }
+    }
+    fragments_.push_back(Fragment{std::move(route), {key}});
+  }
+}
+
+Common::Redis::RespValue
+FragmentedRequest::fragmentRequest(const Common::Redis::RespValueSharedPtr& base_request,
+                                   const Common::Redis::RespValue& single_key_command,
+                                   const Fragment& fragment, uint32_t arguments_per_key) {
+  const uint64_t start = 1 + fragment.keys_.front() * arguments_per_key;
+  if (fragment.keys_.size() == 1) {
+    return Common::Redis::RespValue(base_request, single_key_command, start,
+                                    start + arguments_per_key - 1);
+  }
+
+  if (fragment.keys_.back() - fragment.keys_.front() + 1 == fragment.keys_.size()) {
+    // Consecutive keys, e.g. all of them when served by a single shard, are not copied.
+    const uint64_t end = (fragment.keys_.back() + 1) * arguments_per_key;
+    return Common::Redis::RespValue(base_request, base_request->asArray()[0], start, end);
+  }
+
+  Common::Redis::RespValue request;
+  request.type(Common::Redis::RespType::Array);
+  std::vector<Common::Redis::RespValue>& arguments = request.asArray();
+  arguments.reserve(1 + fragment.keys_.size() * arguments_per_key);
+  arguments.push_back(base_request->asArray()[0]);
+  for (const uint32_t key : fragment.keys_) {
+    for (uint32_t i = 1; i <= arguments_per_key; i++) {
+      arguments.push_back(base_request->asArray()[key * arguments_per_key + i]);
+    }
+  }
+  return request;
+}
+
 SplitRequestPtr MGETRequest::create(Router& router, Common::Redis::RespValuePtr&& incoming_request,
                                     SplitCallbacks& callbacks, CommandStats& command_stats,
                                     TimeSource& time_source) {
   std::unique_ptr<MGETRequest> request_ptr{new MGETRequest(callbacks, command_stats, time_source)};
 
-  request_ptr->num_pending_responses_ = incoming_request->asArray().size() - 1;
+  request_ptr->makeFragments(router, *incoming_request, 1);
+  request_ptr->num_pending_responses_ = request_ptr->fragments_.size();
   request_ptr->pending_requests_.reserve(request_ptr->num_pending_responses_);
 
   request_ptr->pending_response_ = std::make_unique<Common::Redis::RespValue>();
   request_ptr->pending_response_->type(Common::Redis::RespType::Array);
-  std::vector<Common::Redis::RespValue> responses(request_ptr->num_pending_responses_);
+  std::vector<Common::Redis::RespValue> responses(incoming_request->asArray().size() - 1);
   request_ptr->pending_response_->asArray().swap(responses);
 
   Common::Redis::RespValueSharedPtr base_request = std::move(incoming_request);
-  for (uint32_t i = 1; i < base_request->asArray().size(); i++) {
-    request_ptr->pending_requests_.emplace_back(*request_ptr, i - 1);
+  for (uint32_t i = 0; i < request_ptr->fragments_.size(); i++) {
+    request_ptr->pending_requests_.emplace_back(*request_ptr, i);
     PendingRequest& pending_request = request_ptr->pending_requests_.back();
 
-    const auto route = router.upstreamPool(base_request->asArray()[i].asString());
-    if (route) {
-      // Create composite array for a single get.
-      const Common::Redis::RespValue single_mget(
-          base_request, Common::Redis::Utility::GetRequest::instance(), i, i);
+    const Fragment& fragment = request_ptr->fragments_[i];
+    if (fragment.route_) {
+      // Create composite array for a single get, or an mget of the keys of a shard.
+      const Common::Redis::RespValue fragment_request = fragmentRequest(
+          base_request, Common::Redis::Utility::GetRequest::instance(), fragment, 1);
       pending_request.handle_ = makeFragmentedRequest(
-          route, "get", base_request->asArray()[i].asString(), single_mget, pending_request);
+          fragment.route_, fragment.keys_.size() == 1 ? "get" : "mget",
+          base_request->asArray()[fragment.keys_.front() + 1].asString(), fragment_request,
+          pending_request);
     }
 
     if (!pending_request.handle_) {
@@ -217,14 +316,44 @@ SplitRequestPtr MGETRequest::create(Router& router, Common::Redis::RespValuePtr&
 void MGETRequest::onChildResponse(Common::Redis::RespValuePtr&& value, uint32_t index) {
   pending_requests_[index].handle_ = nullptr;
 
-  pending_response_->asArray()[index].type(value->type());
-  switch (value->type()) {
+  const Fragment& fragment = fragments_[index];
+  if (fragment.keys_.size() == 1) {
+    onKeyResponse(std::move(*value), fragment.keys_.front());
+  } else if (value->type() == Common::Redis::RespType::Array &&
+             value->asArray().size() == fragment.keys_.size()) {
+    for (uint32_t i = 0; i < fragment.keys_.size(); i++) {
+      onKeyResponse(std::move(value->asArray()[i]), fragment.keys_[i]);
+    }
+  } else {
+    // The error of the fragment, or the protocol error of its malformed response, is the response
+    // for each of its keys.
+    Common::Redis::RespValue error;
+    error.type(Common::Redis::RespType::Error);
+    error.asString() = value->type() == Common::Redis::RespType::Error
+                           ? value->asString()
+                           : Response::get().UpstreamProtocolError;
+    for (const uint32_t key : fragment.keys_) {
+      onKeyResponse(Common::Redis::RespValue(error), key);
+    }
+  }
+
+  ASSERT(num_pending_responses_ > 0);
+  if (--num_pending_responses_ == 0) {
+    updateStats(error_count_ == 0);
+    ENVOY_LOG(debug, "redis: response: '{}'", pending_response_->toString());
+    callbacks_.onResponse(std::move(pending_response_));
+  }
+}
+
+void MGETRequest::onKeyResponse(Common::Redis::RespValue&& value, uint32_t key) {
+  pending_response_->asArray()[key].type(value.type());
+  switch (value.type()) {
   case Common::Redis::RespType::Array:
   case Common::Redis::RespType::Integer:
   case Common::Redis::RespType::SimpleString:
   case Common::Redis::RespType::CompositeArray: {
-    pending_response_->asArray()[index].type(Common::Redis::RespType::Error);
-    pending_response_->asArray()[index].asString() = Response::get().UpstreamProtocolError;
+    pending_response_->asArray()[key].type(Common::Redis::RespType::Error);
+    pending_response_->asArray()[key].asString() = Response::get().UpstreamProtocolError;
     error_count_++;
     break;
   }
@@ -233,19 +362,13 @@ void MGETRequest::onChildResponse(Common::Redis::RespValuePtr&& value, uint32_t
     FALLTHRU;
   }
   case Common::Redis::RespType::BulkString: {
-    pending_response_->asArray()[index].asString().swap(value->asString());
+    // Moved as a whole so that buffered bulk strings are not copied into strings.
+    pending_response_->asArray()[key] = std::move(value);
     break;
   }
   case Common::Redis::RespType::Null:
     break;
   }
-
-  ASSERT(num_pending_responses_ > 0);
-  if (--num_pending_responses_ == 0) {
-    updateStats(error_count_ == 0);
-    ENVOY_LOG(debug, "redis: response: '{}'", pending_response_->toString());
-    callbacks_.onResponse(std::move(pending_response_));
-  }
 }
 
 SplitRequestPtr MSETRequest::create(Router& router, Common::Redis::RespValuePtr&& incoming_request,
@@ -258,26 +381,28 @@ SplitRequestPtr MSETRequest::create(Router& router, Common::Redis::RespValuePtr&
   }
   std::unique_ptr<MSETRequest> request_ptr{new MSETRequest(callbacks, command_stats, time_source)};
 
-  request_ptr->num_pending_responses_ = (incoming_request->asArray().size() - 1) / 2;
+  request_ptr->makeFragments(router, *incoming_request, 2);
+  request_ptr->num_pending_responses_ = request_ptr->fragments_.size();
   request_ptr->pending_requests_.reserve(request_ptr->num_pending_responses_);
 
   request_ptr->pending_response_ = std::make_unique<Common::Redis::RespValue>();
   request_ptr->pending_response_->type(Common::Redis::RespType::SimpleString);
 
   Common::Redis::RespValueSharedPtr base_request = std::move(incoming_request);
-  uint32_t fragment_index = 0;
-  for (uint32_t i = 1; i < base_request->asArray().size(); i += 2) {
-    request_ptr->pending_requests_.emplace_back(*request_ptr, fragment_index++);
+  for (uint32_t i = 0; i < request_ptr->fragments_.size(); i++) {
+    request_ptr->pending_requests_.emplace_back(*request_ptr, i);
     PendingRequest& pending_request = request_ptr->pending_requests_.back();
 
-    const auto route = router.upstreamPool(base_request->asArray()[i].asString());
-    if (route) {
-      // Create composite array for a single set command.
-      const Common::Redis::RespValue single_set(
-          base_request, Common::Redis::Utility::SetRequest::instance(), i, i + 1);
-      ENVOY_LOG(debug, "redis: parallel set: '{}'", single_set.toString());
+    const Fragment& fragment = request_ptr->fragments_[i];
+    if (fragment.route_) {
+      // Create composite array for a single set command, or an mset of the pairs of a shard.
+      const Common::Redis::RespValue fragment_request = fragmentRequest(
+          base_request, Common::Redis::Utility::SetRequest::instance(), fragment, 2);
+      ENVOY_LOG(debug, "redis: parallel set: '{}'", fragment_request.toString());
       pending_request.handle_ = makeFragmentedRequest(
-          route, "set", base_request->asArray()[i].asString(), single_set, pending_request);
+          fragment.route_, fragment.keys_.size() == 1 ? "set" : "mset",
+          base_request->asArray()[fragment.keys_.front() * 2 + 1].asString(), fragment_request,
+          pending_request);
     }
 
     if (!pending_request.handle_) {
@@ -303,7 +428,7 @@ void MSETRequest::onChildResponse(Common::Redis::RespValuePtr&& value, uint32_t
     FALLTHRU;
   }
   default: {
-    error_count_++;
+    error_count_ += fragments_[index].keys_.size();
     break;
   }
   }
@@ -329,26 +454,29 @@ SplitRequestPtr SplitKeysSumResultRequest::create(Router& router,
   std::unique_ptr<SplitKeysSumResultRequest> request_ptr{
       new SplitKeysSumResultRequest(callbacks, command_stats, time_source)};
 
-  request_ptr->num_pending_responses_ = incoming_request->asArray().size() - 1;
+  request_ptr->makeFragments(router, *incoming_request, 1);
+  request_ptr->num_pending_responses_ = request_ptr->fragments_.size();
   request_ptr->pending_requests_.reserve(request_ptr->num_pending_responses_);
 
   request_ptr->pending_response_ = std::make_unique<Common::Redis::RespValue>();
   request_ptr->pending_response_->type(Common::Redis::RespType::Integer);
 
   Common::Redis::RespValueSharedPtr base_request = std::move(incoming_request);
-  for (uint32_t i = 1; i < base_request->asArray().size(); i++) {
-    request_ptr->pending_requests_.emplace_back(*request_ptr, i - 1);
+  for (uint32_t i = 0; i < request_ptr->fragments_.size(); i++) {
+    request_ptr->pending_requests_.emplace_back(*request_ptr, i);
     PendingRequest& pending_request = request_ptr->pending_requests_.back();
 
-    // Create the composite array for a single fragment.
-    const Common::Redis::RespValue single_fragment(base_request, base_request->asArray()[0], i, i);
-    ENVOY_LOG(debug, "redis: parallel {}: '{}'", base_request->asArray()[0].asString(),
-              single_fragment.toString());
-    const auto route = router.upstreamPool(base_request->asArray()[i].asString());
-    if (route) {
-      pending_request.handle_ = makeFragmentedRequest(route, base_request->asArray()[0].asString(),
-                                                      base_request->asArray()[i].asString(),
-                                                      single_fragment, pending_request);
+    const Fragment& fragment = request_ptr->fragments_[i];
+    if (fragment.route_) {
+      // Create the composite array for a single fragment.
+      const Common::Redis::RespValue fragment_request =
+          fragmentRequest(base_request, base_request->asArray()[0], fragment, 1);
+      ENVOY_LOG(debug, "redis: parallel {}: '{}'", base_request->asArray()[0].asString(),
+                fragment_request.toString());
+      pending_request.handle_ = makeFragmentedRequest(
+          fragment.route_, base_request->asArray()[0].asString(),
+          base_request->asArray()[fragment.keys_.front() + 1].asString(), fragment_request,
+          pending_request);
     }
 
     if (!pending_request.handle_) {
@@ -373,7 +501,7 @@ void SplitKeysSumResultRequest::onChildResponse(Common::Redis::RespValuePtr&& va
     break;
   }
   default: {
-    error_count_++;
+    error_count_ += fragments_[index].keys_.size();
     break;
   }
   }
@@ -20,6 +20,8 @@
 #include "extensions/filters/network/redis_proxy/conn_pool_impl.h"
 #include "extensions/filters/network/redis_proxy/router.h"
 
+#include "absl/container/inlined_vector.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -107,6 +109,8 @@ protected:
   ConnPool::InstanceSharedPtr conn_pool_;
   Common::Redis::Client::PoolRequest* handle_{};
   Common::Redis::RespValuePtr incoming_request_;
+  // Set if the response is to be cached.
+  NearCache::FillPtr near_cache_fill_;
 };
 
 /**
@@ -139,7 +143,8 @@ private:
 
 /**
  * FragmentedRequest is a base class for requests that contains multiple keys. An individual request
- * is sent to the appropriate server for each key. The responses from all servers are combined and
+ * is sent to the appropriate server for each key, or for each group of keys served by the same
+ * shard when the upstream aggregates keys. The responses from all servers are combined and
  * returned to the client.
  */
 class FragmentedRequest : public SplitRequestBase {
@@ -167,12 +172,44 @@ protected:
     Common::Redis::Client::PoolRequest* handle_{};
   };
 
+  // The keys of the incoming request sent in a single upstream request.
+  struct Fragment {
+    RouteSharedPtr route_;
+    // The indexes of the keys among the keys of the incoming request, in increasing order.
+    absl::InlinedVector<uint32_t, 4> keys_;
+  };
+
   virtual void onChildResponse(Common::Redis::RespValuePtr&& value, uint32_t index) PURE;
   void onChildFailure(uint32_t index);
 
+  /**
+   * Route the keys of the incoming request and group them into fragments_, each key in its own
+   * fragment unless its upstream aggregates the keys of the same shard. The near cached replies
+   * for the keys of a write are removed.
+   * @param router supplies the router.
+   * @param incoming_request supplies the incoming request, whose keys may be rewritten by the
+   *        routes.
+   * @param arguments_per_key supplies the number of arguments of each key, the key included.
+   */
+  void makeFragments(Router& router, Common::Redis::RespValue& incoming_request,
+                     uint32_t arguments_per_key);
+
+  /**
+   * @return the upstream request of a fragment, referencing the incoming request when possible.
+   * @param base_request supplies the incoming request.
+   * @param single_key_command supplies the command of fragments of a single key.
+   * @param fragment supplies the fragment.
+   * @param arguments_per_key supplies the number of arguments of each key, the key included.
+   */
+  static Common::Redis::RespValue
+  fragmentRequest(const Common::Redis::RespValueSharedPtr& base_request,
+                  const Common::Redis::RespValue& single_key_command, const Fragment& fragment,
+                  uint32_t arguments_per_key);
+
   SplitCallbacks& callbacks_;
 
   Common::Redis::RespValuePtr pending_response_;
+  std::vector<Fragment> fragments_;
   std::vector<PendingRequest> pending_requests_;
   uint32_t num_pending_responses_;
   uint32_t error_count_{0};
@@ -180,7 +217,8 @@ protected:
 
 /**
  * MGETRequest takes each key from the command and sends a GET for each to the appropriate Redis
- * server. The response contains the result from each command.
+ * server, or an MGET for each group of keys aggregated by the upstream. The response contains the
+ * result from each command.
  */
 class MGETRequest : public FragmentedRequest, Logger::Loggable<Logger::Id::redis> {
 public:
@@ -194,6 +232,8 @@ private:
 
   // RedisProxy::CommandSplitter::FragmentedRequest
   void onChildResponse(Common::Redis::RespValuePtr&& value, uint32_t index) override;
+
+  void onKeyResponse(Common::Redis::RespValue&& value, uint32_t key);
 };
 
 /**
@@ -221,8 +261,8 @@ private:
 
 /**
  * MSETRequest takes each key and value pair from the command and sends a SET for each to the
- * appropriate Redis server. The response is an OK if all commands succeeded or an ERR if any
- * failed.
+ * appropriate Redis server, or an MSET for each group of pairs aggregated by the upstream. The
+ * response is an OK if all commands succeeded or an ERR if any failed.
  */
 class MSETRequest : public FragmentedRequest, Logger::Loggable<Logger::Id::redis> {
 public:
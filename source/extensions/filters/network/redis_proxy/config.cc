@@ -6,6 +6,7 @@
 #include "extensions/common/redis/cluster_refresh_manager_impl.h"
 #include "extensions/filters/network/common/redis/client_impl.h"
 #include "extensions/filters/network/redis_proxy/command_splitter_impl.h"
+#include "extensions/filters/network/redis_proxy/near_cache_impl.h"
 #include "extensions/filters/network/redis_proxy/proxy_filter.h"
 #include "extensions/filters/network/redis_proxy/router_impl.h"
 
@@ -71,6 +72,11 @@ Network::FilterFactoryCb RedisProxyFilterConfigFactory::createFilterFactoryFromP
   auto redis_command_stats =
       Common::Redis::RedisCommandStats::createRedisCommandStats(context.scope().symbolTable());
 
+  NearCache::ConfigConstSharedPtr near_cache_config;
+  if (proto_config.has_near_cache()) {
+    near_cache_config = std::make_shared<const NearCache::Config>(proto_config.near_cache());
+  }
+
   Upstreams upstreams;
   for (auto& cluster : unique_clusters) {
     Stats::ScopePtr stats_scope =
@@ -80,7 +86,8 @@ Network::FilterFactoryCb RedisProxyFilterConfigFactory::createFilterFactoryFromP
                                    cluster, context.clusterManager(),
                                    Common::Redis::Client::ClientFactoryImpl::instance_,
                                    context.threadLocal(), proto_config.settings(), context.api(),
-                                   std::move(stats_scope), redis_command_stats, refresh_manager));
+                                   std::move(stats_scope), redis_command_stats, refresh_manager,
+                                   near_cache_config));
   }
 
   auto router =
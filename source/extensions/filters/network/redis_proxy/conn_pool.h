@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -8,7 +9,9 @@
 
 #include "extensions/filters/network/common/redis/client.h"
 #include "extensions/filters/network/common/redis/codec.h"
+#include "extensions/filters/network/redis_proxy/near_cache.h"
 
+#include "absl/types/optional.h"
 #include "absl/types/variant.h"
 
 namespace Envoy {
@@ -70,6 +73,20 @@ public:
    * to be called from the main thread dispatcher, false otherwise.
    */
   virtual bool onRedirection() PURE;
+
+  /**
+   * @return NearCache::Cache* the near cache of the calling thread, or nullptr if the replies
+   *         received from the pool's cluster are not cached.
+   */
+  virtual NearCache::Cache* nearCache() PURE;
+
+  /**
+   * @return an identifier of the upstream shard serving a key, such that keys with equal
+   *         identifiers may be sent together in a single multi-key request, or absl::nullopt if
+   *         keys must be sent separately.
+   * @param hash_key supplies the key.
+   */
+  virtual absl::optional<uint64_t> shardKey(const std::string& hash_key) PURE;
 };
 
 using InstanceSharedPtr = std::shared_ptr<Instance>;
@@ -42,12 +42,17 @@ InstanceImpl::InstanceImpl(
         config,
     Api::Api& api, Stats::ScopePtr&& stats_scope,
     const Common::Redis::RedisCommandStatsSharedPtr& redis_command_stats,
-    Extensions::Common::Redis::ClusterRefreshManagerSharedPtr refresh_manager)
+    Extensions::Common::Redis::ClusterRefreshManagerSharedPtr refresh_manager,
+    const NearCache::ConfigConstSharedPtr& near_cache_config)
     : cluster_name_(cluster_name), cm_(cm), client_factory_(client_factory),
-      tls_(tls.allocateSlot()), config_(config), api_(api), stats_scope_(std::move(stats_scope)),
-      redis_command_stats_(redis_command_stats), redis_cluster_stats_{REDIS_CLUSTER_STATS(
-                                                     POOL_COUNTER(*stats_scope_))},
-      refresh_manager_(std::move(refresh_manager)) {
+      tls_(tls.allocateSlot()), config_(config),
+      enable_key_aggregation_(config.enable_key_aggregation()), api_(api),
+      stats_scope_(std::move(stats_scope)), redis_command_stats_(redis_command_stats),
+      redis_cluster_stats_{REDIS_CLUSTER_STATS(POOL_COUNTER(*stats_scope_))},
+      refresh_manager_(std::move(refresh_manager)), near_cache_config_(near_cache_config) {
+  if (near_cache_config_ != nullptr) {
+    near_cache_stats_.emplace(NearCache::Config::generateStats(*stats_scope_));
+  }
   tls_->set([this, cluster_name](
                 Event::Dispatcher& dispatcher) -> ThreadLocal::ThreadLocalObjectSharedPtr {
     return std::make_shared<ThreadLocalPool>(*this, dispatcher, cluster_name);
@@ -59,6 +64,17 @@ InstanceImpl::makeRequest(const std::string& key, RespVariant&& request, PoolCal
   return tls_->getTyped<ThreadLocalPool>().makeRequest(key, std::move(request), callbacks);
 }
 
+NearCache::Cache* InstanceImpl::nearCache() {
+  return tls_->getTyped<ThreadLocalPool>().near_cache_.get();
+}
+
+absl::optional<uint64_t> InstanceImpl::shardKey(const std::string& hash_key) {
+  if (!enable_key_aggregation_) {
+    return absl::nullopt;
+  }
+  return tls_->getTyped<ThreadLocalPool>().shardKey(hash_key);
+}
+
 Common::Redis::Client::PoolRequest*
 InstanceImpl::makeRequestToHost(const std::string& host_address,
                                 const Common::Redis::RespValue& request,
@@ -69,6 +85,11 @@ InstanceImpl::makeRequestToHost(const std::string& host_address,
 InstanceImpl::ThreadLocalPool::ThreadLocalPool(InstanceImpl& parent, Event::Dispatcher& dispatcher,
                                                std::string cluster_name)
     : parent_(parent), dispatcher_(dispatcher), cluster_name_(std::move(cluster_name)),
+      near_cache_(parent.near_cache_config_ != nullptr
+                      ? std::make_shared<NearCache::CacheImpl>(parent.near_cache_config_,
+                                                               *parent.near_cache_stats_,
+                                                               dispatcher.timeSource())
+                      : nullptr),
       drain_timer_(dispatcher.createTimer([this]() -> void { drainClients(); })),
       is_redis_cluster_(false) {
   cluster_update_handle_ = parent_.cm_.addThreadLocalClusterUpdateCallbacks(*this);
@@ -92,6 +113,9 @@ InstanceImpl::ThreadLocalPool::~ThreadLocalPool() {
   while (!clients_to_drain_.empty()) {
     (*clients_to_drain_.begin())->redis_client_->close();
   }
+  if (near_cache_ != nullptr) {
+    near_cache_->untrackAllHosts();
+  }
 }
 
 void InstanceImpl::ThreadLocalPool::onClusterAddOrUpdateNonVirtual(
@@ -119,6 +143,9 @@ void InstanceImpl::ThreadLocalPool::onClusterAddOrUpdateNonVirtual(
   for (const auto& i : cluster_->prioritySet().hostSetsPerPriority()) {
     for (auto& host : i->hosts()) {
       host_address_map_[host->address()->asString()] = host;
+      if (near_cache_ != nullptr) {
+        near_cache_->trackHost(host, dispatcher_, auth_password_);
+      }
     }
   }
 
@@ -151,6 +178,11 @@ void InstanceImpl::ThreadLocalPool::onClusterRemoval(const std::string& cluster_
     (*clients_to_drain_.begin())->redis_client_->close();
   }
 
+  if (near_cache_ != nullptr) {
+    near_cache_->untrackAllHosts();
+    near_cache_->flush();
+  }
+
   cluster_ = nullptr;
   host_address_map_.clear();
 }
@@ -161,6 +193,9 @@ void InstanceImpl::ThreadLocalPool::onHostsAdded(
     std::string host_address = host->address()->asString();
     // Insert new host into address map, possibly overwriting a previous host's entry.
     host_address_map_[host_address] = host;
+    if (near_cache_ != nullptr) {
+      near_cache_->trackHost(host, dispatcher_, auth_password_);
+    }
     for (const auto& created_host : created_via_redirect_hosts_) {
       if (created_host->address()->asString() == host_address) {
         // Remove our "temporary" host created in makeRequestToHost().
@@ -175,6 +210,9 @@ void InstanceImpl::ThreadLocalPool::onHostsAdded(
 void InstanceImpl::ThreadLocalPool::onHostsRemoved(
     const std::vector<Upstream::HostSharedPtr>& hosts_removed) {
   for (const auto& host : hosts_removed) {
+    if (near_cache_ != nullptr) {
+      near_cache_->untrackHost(host);
+    }
     auto it = client_map_.find(host);
     if (it != client_map_.end()) {
       if (it->second->redis_client_->active()) {
@@ -251,6 +289,28 @@ InstanceImpl::ThreadLocalPool::makeRequest(const std::string& key, RespVariant&&
   }
 }
 
+absl::optional<uint64_t> InstanceImpl::ThreadLocalPool::shardKey(const std::string& key) {
+  if (cluster_ == nullptr) {
+    return absl::nullopt;
+  }
+
+  // The request only matters to the read policy, which selects among the hosts of a shard.
+  Clusters::Redis::RedisLoadBalancerContextImpl lb_context(key, parent_.config_.enableHashtagging(),
+                                                           is_redis_cluster_,
+                                                           Common::Redis::RespValue());
+  if (is_redis_cluster_) {
+    // Servers reject multi-key commands whose keys map to different slots, even when serving all
+    // of them.
+    return lb_context.computeHashKey().value() % Clusters::Redis::MaxSlot;
+  }
+
+  Upstream::HostConstSharedPtr host = cluster_->loadBalancer().chooseHost(&lb_context);
+  if (!host) {
+    return absl::nullopt;
+  }
+  return reinterpret_cast<uintptr_t>(host.get());
+}
+
 Common::Redis::Client::PoolRequest* InstanceImpl::ThreadLocalPool::makeRequestToHost(
     const std::string& host_address, const Common::Redis::RespValue& request,
     Common::Redis::Client::ClientCallbacks& callbacks) {
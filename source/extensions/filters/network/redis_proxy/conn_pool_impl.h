@@ -28,6 +28,9 @@
 #include "extensions/filters/network/common/redis/codec_impl.h"
 #include "extensions/filters/network/common/redis/utility.h"
 #include "extensions/filters/network/redis_proxy/conn_pool.h"
+#include "extensions/filters/network/redis_proxy/near_cache_impl.h"
+
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -61,10 +64,13 @@ public:
           config,
       Api::Api& api, Stats::ScopePtr&& stats_scope,
       const Common::Redis::RedisCommandStatsSharedPtr& redis_command_stats,
-      Extensions::Common::Redis::ClusterRefreshManagerSharedPtr refresh_manager);
+      Extensions::Common::Redis::ClusterRefreshManagerSharedPtr refresh_manager,
+      const NearCache::ConfigConstSharedPtr& near_cache_config = nullptr);
   // RedisProxy::ConnPool::Instance
   Common::Redis::Client::PoolRequest* makeRequest(const std::string& key, RespVariant&& request,
                                                   PoolCallbacks& callbacks) override;
+  NearCache::Cache* nearCache() override;
+  absl::optional<uint64_t> shardKey(const std::string& hash_key) override;
   /**
    * Makes a redis request based on IP address and TCP port of the upstream host (e.g.,
    * moved/ask cluster redirection). This is now only kept mostly for testing.
@@ -135,6 +141,7 @@ private:
     Common::Redis::Client::PoolRequest*
     makeRequestToHost(const std::string& host_address, const Common::Redis::RespValue& request,
                       Common::Redis::Client::ClientCallbacks& callbacks);
+    absl::optional<uint64_t> shardKey(const std::string& key);
 
     void onClusterAddOrUpdateNonVirtual(Upstream::ThreadLocalCluster& cluster);
     void onHostsAdded(const std::vector<Upstream::HostSharedPtr>& hosts_added);
@@ -161,6 +168,8 @@ private:
     std::list<Upstream::HostSharedPtr> created_via_redirect_hosts_;
     std::list<ThreadLocalActiveClientPtr> clients_to_drain_;
     std::list<PendingRequest> pending_requests_;
+    // Set if the replies received from the cluster are cached.
+    const NearCache::CacheImplSharedPtr near_cache_;
 
     /* This timer is used to poll the active clients in clients_to_drain_ to determine whether they
      * have been drained (have no active requests) or not. It is only enabled after a client has
@@ -177,11 +186,14 @@ private:
   Common::Redis::Client::ClientFactory& client_factory_;
   ThreadLocal::SlotPtr tls_;
   Common::Redis::Client::ConfigImpl config_;
+  const bool enable_key_aggregation_;
   Api::Api& api_;
   Stats::ScopePtr stats_scope_;
   Common::Redis::RedisCommandStatsSharedPtr redis_command_stats_;
   RedisClusterStats redis_cluster_stats_;
   const Extensions::Common::Redis::ClusterRefreshManagerSharedPtr refresh_manager_;
+  const NearCache::ConfigConstSharedPtr near_cache_config_;
+  absl::optional<NearCache::CacheStats> near_cache_stats_;
 };
 
 } // namespace ConnPool
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+
+#include "envoy/common/pure.h"
+
+#include "extensions/filters/network/common/redis/codec.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+namespace NearCache {
+
+/**
+ * A pending insertion of the reply of a request missing from a near cache. Destroying it without
+ * a reply, e.g. when the request fails or is canceled, abandons the insertion.
+ */
+class Fill {
+public:
+  virtual ~Fill() = default;
+
+  /**
+   * Called when the reply of the request is received. The reply is only cached if it is not an
+   * error and its key was not invalidated since the request was looked up.
+   * @param reply supplies the reply.
+   */
+  virtual void onReply(const Common::Redis::RespValue& reply) PURE;
+};
+
+using FillPtr = std::unique_ptr<Fill>;
+
+/**
+ * A cache of the replies of read commands received from the upstream servers of a cluster, local
+ * to the calling thread.
+ */
+class Cache {
+public:
+  virtual ~Cache() = default;
+
+  /**
+   * Look up the reply of a request.
+   * @param request supplies the request, an array of bulk strings whose second element is the key.
+   * @param fill receives, for requests which are cached but missing, the insertion of the reply
+   *        once received.
+   * @return Common::Redis::RespValuePtr a copy of the cached reply, or nullptr if the request is
+   *         not cached or missing.
+   */
+  virtual Common::Redis::RespValuePtr lookup(const Common::Redis::RespValue& request,
+                                             FillPtr& fill) PURE;
+
+  /**
+   * Remove the replies for a key, e.g. when a request writing the key is sent upstream. Replies
+   * pending for the key when invalidated are not cached. This is a no-op for keys not cached.
+   * @param key supplies the key.
+   */
+  virtual void invalidate(absl::string_view key) PURE;
+};
+
+} // namespace NearCache
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
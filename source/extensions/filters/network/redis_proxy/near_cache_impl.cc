@@ -0,0 +1,393 @@
+#include "extensions/filters/network/redis_proxy/near_cache_impl.h"
+
+#include <algorithm>
+
+#include "envoy/common/exception.h"
+
+#include "common/buffer/buffer_impl.h"
+#include "common/common/assert.h"
+#include "common/common/fmt.h"
+#include "common/protobuf/utility.h"
+
+#include "extensions/filters/network/common/redis/supported_commands.h"
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+namespace NearCache {
+namespace {
+
+// The channel on which the invalidations of client side caching are published.
+const std::string& invalidationChannel() {
+  CONSTRUCT_ON_FIRST_USE(std::string, "__redis__:invalidate");
+}
+
+} // namespace
+
+Config::Config(
+    const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::NearCache& config)
+    : key_prefixes_(config.key_prefixes().begin(), config.key_prefixes().end()),
+      max_entries_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entries, 10000)),
+      ttl_(PROTOBUF_GET_MS_REQUIRED(config, ttl)) {
+  if (config.commands().empty()) {
+    commands_.insert("get");
+  }
+  for (const std::string& command : config.commands()) {
+    const std::string lower_command = absl::AsciiStrToLower(command);
+    if (!Common::Redis::SupportedCommands::simpleCommands().contains(lower_command) ||
+        !Common::Redis::SupportedCommands::isReadCommand(lower_command)) {
+      throw EnvoyException(
+          fmt::format("redis near cache: '{}' is not a read command hashing on its first argument",
+                      command));
+    }
+    commands_.insert(lower_command);
+  }
+
+  // Servers reject overlapping prefixes, so only the shortest of them are tracked.
+  std::vector<std::string> prefixes = key_prefixes_;
+  std::sort(prefixes.begin(), prefixes.end());
+  for (const std::string& prefix : prefixes) {
+    if (prefix.empty()) {
+      // All keys are cached, and tracked without prefixes.
+      tracked_prefixes_.clear();
+      break;
+    }
+    if (tracked_prefixes_.empty() || !absl::StartsWith(prefix, tracked_prefixes_.back())) {
+      tracked_prefixes_.push_back(prefix);
+    }
+  }
+}
+
+bool Config::cachesKey(absl::string_view key) const {
+  return std::any_of(key_prefixes_.begin(), key_prefixes_.end(),
+                     [key](const std::string& prefix) { return absl::StartsWith(key, prefix); });
+}
+
+CacheStats Config::generateStats(Stats::Scope& scope) {
+  const std::string prefix = "near_cache.";
+  return CacheStats{
+      ALL_NEAR_CACHE_STATS(POOL_COUNTER_PREFIX(scope, prefix), POOL_GAUGE_PREFIX(scope, prefix))};
+}
+
+TrackingClient::TrackingClient(CacheImpl& parent, Upstream::HostConstSharedPtr host,
+                               Event::Dispatcher& dispatcher, const std::string& auth_password)
+    : parent_(parent), host_(std::move(host)), dispatcher_(dispatcher),
+      auth_password_(auth_password),
+      connect_timer_(dispatcher.createTimer([this]() -> void { onError("connect timeout"); })),
+      reconnect_timer_(dispatcher.createTimer([this]() -> void { connect(); })) {
+  connect();
+}
+
+TrackingClient::~TrackingClient() {
+  closing_ = true;
+  if (connection_ != nullptr) {
+    connection_->close(Network::ConnectionCloseType::NoFlush);
+  }
+  if (subscribed_) {
+    parent_.onTrackingStopped();
+  }
+}
+
+void TrackingClient::connect() {
+  ASSERT(connection_ == nullptr);
+  decoder_ = std::make_unique<Common::Redis::DecoderImpl>(*this);
+  connection_ = host_->createConnection(dispatcher_, nullptr, nullptr).connection_;
+  connection_->addConnectionCallbacks(*this);
+  connection_->addReadFilter(std::make_shared<ReadFilter>(*this));
+  connection_->connect();
+  connection_->noDelay(true);
+  connect_timer_->enableTimer(host_->cluster().connectTimeout());
+
+  // The id of the connection is needed to redirect the invalidations to it.
+  if (!auth_password_.empty()) {
+    write({"auth", auth_password_});
+  }
+  write({"client", "id"});
+}
+
+void TrackingClient::write(const std::vector<std::string>& request) {
+  Common::Redis::RespValue value;
+  value.type(Common::Redis::RespType::Array);
+  value.asArray().resize(request.size());
+  for (uint64_t i = 0; i < request.size(); i++) {
+    value.asArray()[i].type(Common::Redis::RespType::BulkString);
+    value.asArray()[i].asString() = request[i];
+  }
+  Buffer::OwnedImpl buffer;
+  encoder_.encode(value, buffer);
+  connection_->write(buffer, false);
+}
+
+Network::FilterStatus TrackingClient::ReadFilter::onData(Buffer::Instance& data, bool) {
+  try {
+    parent_.decoder_->decode(data);
+  } catch (Common::Redis::ProtocolError&) {
+    parent_.onError("protocol error");
+  }
+  return Network::FilterStatus::Continue;
+}
+
+void TrackingClient::onRespValue(Common::Redis::RespValuePtr&& value) {
+  if (connection_ == nullptr) {
+    // Closed by an earlier value of the same read.
+    return;
+  }
+
+  switch (value->type()) {
+  case Common::Redis::RespType::Error:
+    // Servers older than Redis 6 don't support client side caching, in which case replies are
+    // only invalidated by their TTL.
+    onError(value->asString());
+    break;
+  case Common::Redis::RespType::Integer: {
+    // The reply to CLIENT ID.
+    std::vector<std::string> request = {"client", "tracking", "on", "redirect",
+                                        std::to_string(value->asInteger()), "bcast"};
+    for (const std::string& prefix : parent_.config().trackedPrefixes()) {
+      request.push_back("prefix");
+      request.push_back(prefix);
+    }
+    write(request);
+    write({"subscribe", invalidationChannel()});
+    break;
+  }
+  case Common::Redis::RespType::Array:
+    onMessage(*value);
+    break;
+  default:
+    // The replies to AUTH and CLIENT TRACKING.
+    break;
+  }
+}
+
+void TrackingClient::onMessage(const Common::Redis::RespValue& value) {
+  const std::vector<Common::Redis::RespValue>& elements = value.asArray();
+  if (elements.size() != 3 || elements[0].type() != Common::Redis::RespType::BulkString) {
+    return;
+  }
+
+  if (elements[0].asString() == "subscribe") {
+    // Invalidations may have been missed until now.
+    ENVOY_LOG(debug, "redis near cache: tracking keys of {}", host_->address()->asString());
+    reconnect_delay_ = MinReconnectDelay;
+    parent_.flush();
+    if (!subscribed_) {
+      subscribed_ = true;
+      parent_.onTrackingStarted();
+    }
+  } else if (elements[0].asString() == "message" &&
+             elements[1].type() == Common::Redis::RespType::BulkString &&
+             elements[1].asString() == invalidationChannel()) {
+    const Common::Redis::RespValue& keys = elements[2];
+    if (keys.type() == Common::Redis::RespType::Array) {
+      for (const Common::Redis::RespValue& key : keys.asArray()) {
+        if (key.type() == Common::Redis::RespType::BulkString) {
+          parent_.invalidate(key.asString());
+        }
+      }
+    } else {
+      // All keys are invalidated by FLUSHALL and FLUSHDB.
+      parent_.flush();
+    }
+  }
+}
+
+void TrackingClient::onError(const std::string& error) {
+  ENVOY_LOG(debug, "redis near cache: tracking keys of {} failed: {}",
+            host_->address()->asString(), error);
+  parent_.stats().tracking_error_.inc();
+  if (connection_ != nullptr) {
+    connection_->close(Network::ConnectionCloseType::NoFlush);
+  }
+}
+
+void TrackingClient::onEvent(Network::ConnectionEvent event) {
+  if (event == Network::ConnectionEvent::Connected) {
+    connect_timer_->disableTimer();
+    return;
+  }
+
+  connect_timer_->disableTimer();
+  dispatcher_.deferredDelete(std::move(connection_));
+  if (subscribed_) {
+    subscribed_ = false;
+    parent_.onTrackingStopped();
+  }
+  if (!closing_) {
+    // The invalidations published until subscribed again are missed, so the cached replies can't
+    // be trusted anymore.
+    parent_.flush();
+    // Servers which keep failing, e.g. those not supporting client side caching, are retried less
+    // and less often.
+    reconnect_timer_->enableTimer(reconnect_delay_);
+    reconnect_delay_ = std::min(2 * reconnect_delay_, MaxReconnectDelay);
+  }
+}
+
+CacheImpl::CacheImpl(const ConfigConstSharedPtr& config, CacheStats& stats,
+                     TimeSource& time_source)
+    : config_(config), stats_(stats), time_source_(time_source) {}
+
+CacheImpl::~CacheImpl() {
+  ASSERT(tracking_clients_.empty());
+  stats_.entries_.sub(size_);
+}
+
+Common::Redis::RespValuePtr CacheImpl::lookup(const Common::Redis::RespValue& request,
+                                              FillPtr& fill) {
+  const std::vector<Common::Redis::RespValue>& arguments = request.asArray();
+  ASSERT(arguments.size() >= 2);
+  const std::string command = absl::AsciiStrToLower(arguments[0].asString());
+  const std::string& key = arguments[1].asString();
+  if (!config_->cachesCommand(command) || !config_->cachesKey(key)) {
+    return nullptr;
+  }
+  if (!tracking()) {
+    // The key may be served by a server whose invalidations are not received. Which one is only
+    // known once the request is routed, so the cache is bypassed for all keys.
+    return nullptr;
+  }
+
+  std::string reply_key = replyKey(command, arguments);
+  auto entry = entry_map_.find(key);
+  if (entry != entry_map_.end()) {
+    auto reply = entry->second->replies_.find(reply_key);
+    if (reply != entry->second->replies_.end()) {
+      if (reply->second.expiry_ > time_source_.monotonicTime()) {
+        entries_.splice(entries_.begin(), entries_, entry->second);
+        stats_.hit_.inc();
+        return std::make_unique<Common::Redis::RespValue>(reply->second.value_);
+      }
+
+      entry->second->replies_.erase(reply);
+      size_--;
+      stats_.entries_.dec();
+      if (entry->second->replies_.empty()) {
+        removeEntry(entry->second);
+      }
+    }
+  }
+
+  stats_.miss_.inc();
+  PendingFills& pending_fills = pending_fills_[key];
+  pending_fills.count_++;
+  fill = std::make_unique<FillImpl>(shared_from_this(), key, std::move(reply_key),
+                                    pending_fills.generation_);
+  return nullptr;
+}
+
+void CacheImpl::trackHost(const Upstream::HostConstSharedPtr& host,
+                          Event::Dispatcher& dispatcher, const std::string& auth_password) {
+  TrackingClientPtr& client = tracking_clients_[host];
+  if (client == nullptr) {
+    client = std::make_unique<TrackingClient>(*this, host, dispatcher, auth_password);
+  }
+}
+
+void CacheImpl::untrackHost(const Upstream::HostConstSharedPtr& host) {
+  tracking_clients_.erase(host);
+}
+
+void CacheImpl::untrackAllHosts() { tracking_clients_.clear(); }
+
+void CacheImpl::invalidate(absl::string_view key) {
+  auto pending_fills = pending_fills_.find(key);
+  if (pending_fills != pending_fills_.end()) {
+    pending_fills->second.generation_++;
+  }
+
+  auto entry = entry_map_.find(key);
+  if (entry != entry_map_.end()) {
+    stats_.invalidation_.inc();
+    removeEntry(entry->second);
+  }
+}
+
+void CacheImpl::flush() {
+  for (auto& pending_fills : pending_fills_) {
+    pending_fills.second.generation_++;
+  }
+
+  stats_.flush_.inc();
+  stats_.entries_.sub(size_);
+  size_ = 0;
+  entry_map_.clear();
+  entries_.clear();
+}
+
+std::string CacheImpl::replyKey(const std::string& command,
+                                const std::vector<Common::Redis::RespValue>& arguments) {
+  // Arguments are prefixed with their length, since they may contain any character.
+  std::string reply_key = command;
+  for (uint64_t i = 2; i < arguments.size(); i++) {
+    const std::string& argument = arguments[i].asString();
+    absl::StrAppend(&reply_key, " ", argument.size(), ":", argument);
+  }
+  return reply_key;
+}
+
+void CacheImpl::insert(const std::string& key, const std::string& reply_key,
+                       uint64_t generation, const Common::Redis::RespValue& reply) {
+  auto pending_fills = pending_fills_.find(key);
+  ASSERT(pending_fills != pending_fills_.end());
+  if (pending_fills->second.generation_ != generation) {
+    // The reply may predate the invalidation.
+    return;
+  }
+
+  auto entry = entry_map_.find(key);
+  if (entry == entry_map_.end()) {
+    entries_.emplace_front(key);
+    entry = entry_map_.emplace(entries_.front().key_, entries_.begin()).first;
+  } else {
+    entries_.splice(entries_.begin(), entries_, entry->second);
+  }
+
+  const MonotonicTime expiry = time_source_.monotonicTime() + config_->ttl();
+  auto inserted = entry->second->replies_.try_emplace(reply_key, Reply{reply, expiry});
+  if (!inserted.second) {
+    inserted.first->second = Reply{reply, expiry};
+    return;
+  }
+
+  size_++;
+  stats_.entries_.inc();
+  while (size_ > config_->maxEntries()) {
+    stats_.eviction_.inc();
+    removeEntry(std::prev(entries_.end()));
+  }
+}
+
+void CacheImpl::releaseFill(const std::string& key) {
+  auto pending_fills = pending_fills_.find(key);
+  ASSERT(pending_fills != pending_fills_.end());
+  if (--pending_fills->second.count_ == 0) {
+    pending_fills_.erase(pending_fills);
+  }
+}
+
+void CacheImpl::removeEntry(EntryList::iterator entry) {
+  size_ -= entry->replies_.size();
+  stats_.entries_.sub(entry->replies_.size());
+  entry_map_.erase(entry->key_);
+  entries_.erase(entry);
+}
+
+CacheImpl::FillImpl::~FillImpl() { parent_->releaseFill(key_); }
+
+void CacheImpl::FillImpl::onReply(const Common::Redis::RespValue& reply) {
+  if (reply.type() != Common::Redis::RespType::Error) {
+    parent_->insert(key_, reply_key_, generation_, reply);
+  }
+}
+
+} // namespace NearCache
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
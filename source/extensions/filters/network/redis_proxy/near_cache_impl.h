@@ -0,0 +1,287 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+#include "envoy/extensions/filters/network/redis_proxy/v3/redis_proxy.pb.h"
+#include "envoy/network/connection.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/upstream/upstream.h"
+
+#include "common/common/logger.h"
+#include "common/network/filter_impl.h"
+
+#include "extensions/filters/network/common/redis/codec_impl.h"
+#include "extensions/filters/network/redis_proxy/near_cache.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+namespace NearCache {
+
+/**
+ * All near cache stats. @see stats_macros.h
+ */
+#define ALL_NEAR_CACHE_STATS(COUNTER, GAUGE)                                                       \
+  COUNTER(eviction)                                                                                \
+  COUNTER(flush)                                                                                   \
+  COUNTER(hit)                                                                                     \
+  COUNTER(invalidation)                                                                            \
+  COUNTER(miss)                                                                                    \
+  COUNTER(tracking_error)                                                                          \
+  GAUGE(entries, Accumulate)
+
+/**
+ * Struct definition for all near cache stats. @see stats_macros.h
+ */
+struct CacheStats {
+  ALL_NEAR_CACHE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+/**
+ * The configuration of the near caches of a filter, shared by its upstream clusters.
+ */
+class Config {
+public:
+  Config(const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::NearCache& config);
+
+  /**
+   * @return whether the replies of a command are cached.
+   * @param command supplies the lower case command.
+   */
+  bool cachesCommand(const std::string& command) const { return commands_.contains(command); }
+
+  /**
+   * @return whether the replies for a key are cached.
+   */
+  bool cachesKey(absl::string_view key) const;
+
+  /**
+   * @return the prefixes to track on the upstream servers, none of which is a prefix of another.
+   *         Empty if all keys are cached.
+   */
+  const std::vector<std::string>& trackedPrefixes() const { return tracked_prefixes_; }
+
+  uint32_t maxEntries() const { return max_entries_; }
+  std::chrono::milliseconds ttl() const { return ttl_; }
+
+  static CacheStats generateStats(Stats::Scope& scope);
+
+private:
+  std::vector<std::string> key_prefixes_;
+  std::vector<std::string> tracked_prefixes_;
+  absl::flat_hash_set<std::string> commands_;
+  const uint32_t max_entries_;
+  const std::chrono::milliseconds ttl_;
+};
+
+using ConfigConstSharedPtr = std::shared_ptr<const Config>;
+
+class CacheImpl;
+
+/**
+ * A connection to an upstream server receiving the invalidations of the keys of a cache. The
+ * server is asked to broadcast the invalidations of the tracked prefixes to the connection itself,
+ * on which it then subscribes to them. This is the form of client side caching available to RESP2
+ * connections, which the codec is limited to.
+ */
+class TrackingClient : public Common::Redis::DecoderCallbacks,
+                       public Network::ConnectionCallbacks,
+                       Logger::Loggable<Logger::Id::redis> {
+public:
+  TrackingClient(CacheImpl& parent, Upstream::HostConstSharedPtr host,
+                 Event::Dispatcher& dispatcher, const std::string& auth_password);
+  ~TrackingClient() override;
+
+  // Common::Redis::DecoderCallbacks
+  void onRespValue(Common::Redis::RespValuePtr&& value) override;
+
+  // Network::ConnectionCallbacks
+  void onEvent(Network::ConnectionEvent event) override;
+  void onAboveWriteBufferHighWatermark() override {}
+  void onBelowWriteBufferLowWatermark() override {}
+
+  // The bounds of the delay before reconnecting after the connection closed.
+  static constexpr std::chrono::milliseconds MinReconnectDelay{1000};
+  static constexpr std::chrono::milliseconds MaxReconnectDelay{60000};
+
+private:
+  struct ReadFilter : public Network::ReadFilterBaseImpl {
+    ReadFilter(TrackingClient& parent) : parent_(parent) {}
+
+    // Network::ReadFilter
+    Network::FilterStatus onData(Buffer::Instance& data, bool) override;
+
+    TrackingClient& parent_;
+  };
+
+  void connect();
+  void write(const std::vector<std::string>& request);
+  void onError(const std::string& error);
+  void onMessage(const Common::Redis::RespValue& value);
+
+  CacheImpl& parent_;
+  const Upstream::HostConstSharedPtr host_;
+  Event::Dispatcher& dispatcher_;
+  const std::string auth_password_;
+  Common::Redis::EncoderImpl encoder_;
+  Common::Redis::DecoderPtr decoder_;
+  Network::ClientConnectionPtr connection_;
+  Event::TimerPtr connect_timer_;
+  Event::TimerPtr reconnect_timer_;
+  std::chrono::milliseconds reconnect_delay_{MinReconnectDelay};
+  // Whether the connection is subscribed to the invalidations.
+  bool subscribed_{};
+  bool closing_{};
+};
+
+using TrackingClientPtr = std::unique_ptr<TrackingClient>;
+
+/**
+ * A bounded LRU cache of replies, grouped by key so that all the replies for a key are
+ * invalidated at once. Each reply also expires after the TTL of the configuration. Replies
+ * received for keys invalidated while their request was pending are not cached, since they may
+ * predate the invalidation. The cache is bypassed while the invalidations of any tracked upstream
+ * server are not received.
+ */
+class CacheImpl : public Cache,
+                  public std::enable_shared_from_this<CacheImpl>,
+                  Logger::Loggable<Logger::Id::redis> {
+public:
+  CacheImpl(const ConfigConstSharedPtr& config, CacheStats& stats, TimeSource& time_source);
+  ~CacheImpl() override;
+
+  // RedisProxy::NearCache::Cache
+  Common::Redis::RespValuePtr lookup(const Common::Redis::RespValue& request,
+                                     FillPtr& fill) override;
+  void invalidate(absl::string_view key) override;
+
+  /**
+   * Start receiving the invalidations of an upstream server.
+   */
+  void trackHost(const Upstream::HostConstSharedPtr& host, Event::Dispatcher& dispatcher,
+                 const std::string& auth_password);
+
+  /**
+   * Stop receiving the invalidations of an upstream server, if received.
+   */
+  void untrackHost(const Upstream::HostConstSharedPtr& host);
+
+  /**
+   * Stop receiving invalidations from all upstream servers.
+   */
+  void untrackAllHosts();
+
+  /**
+   * Remove all the replies, e.g. when invalidations may have been missed.
+   */
+  void flush();
+
+  /**
+   * Called when the invalidations of a tracked upstream server start being received.
+   */
+  void onTrackingStarted() { subscribed_hosts_++; }
+
+  /**
+   * Called when the invalidations of a tracked upstream server stop being received.
+   */
+  void onTrackingStopped() {
+    ASSERT(subscribed_hosts_ > 0);
+    subscribed_hosts_--;
+  }
+
+  /**
+   * @return whether the invalidations of all the tracked upstream servers are received.
+   */
+  bool tracking() const { return subscribed_hosts_ == tracking_clients_.size(); }
+
+  const Config& config() const { return *config_; }
+  CacheStats& stats() { return stats_; }
+
+  /**
+   * @return the number of cached replies.
+   */
+  uint64_t size() const { return size_; }
+
+private:
+  class FillImpl : public Fill {
+  public:
+    FillImpl(std::shared_ptr<CacheImpl> parent, std::string key, std::string reply_key,
+             uint64_t generation)
+        : parent_(std::move(parent)), key_(std::move(key)), reply_key_(std::move(reply_key)),
+          generation_(generation) {}
+    ~FillImpl() override;
+
+    // RedisProxy::NearCache::Fill
+    void onReply(const Common::Redis::RespValue& reply) override;
+
+  private:
+    const std::shared_ptr<CacheImpl> parent_;
+    const std::string key_;
+    const std::string reply_key_;
+    const uint64_t generation_;
+  };
+
+  struct Reply {
+    Common::Redis::RespValue value_;
+    MonotonicTime expiry_;
+  };
+
+  struct Entry {
+    Entry(std::string key) : key_(std::move(key)) {}
+
+    const std::string key_;
+    // Keyed by the command and the arguments following the key.
+    absl::flat_hash_map<std::string, Reply> replies_;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  // The requests pending for a key, and the number of invalidations of the key since the first
+  // one was looked up.
+  struct PendingFills {
+    uint32_t count_{};
+    uint64_t generation_{};
+  };
+
+  static std::string replyKey(const std::string& command,
+                              const std::vector<Common::Redis::RespValue>& arguments);
+  void insert(const std::string& key, const std::string& reply_key, uint64_t generation,
+              const Common::Redis::RespValue& reply);
+  void releaseFill(const std::string& key);
+  void removeEntry(EntryList::iterator entry);
+
+  const ConfigConstSharedPtr config_;
+  CacheStats& stats_;
+  TimeSource& time_source_;
+  // Most recently used first.
+  EntryList entries_;
+  // Keyed by views of the keys of the entries.
+  absl::flat_hash_map<absl::string_view, EntryList::iterator> entry_map_;
+  absl::flat_hash_map<std::string, PendingFills> pending_fills_;
+  uint64_t size_{};
+  std::unordered_map<Upstream::HostConstSharedPtr, TrackingClientPtr> tracking_clients_;
+  // The number of tracking clients subscribed to the invalidations.
+  uint64_t subscribed_hosts_{};
+};
+
+using CacheImplSharedPtr = std::shared_ptr<CacheImpl>;
+
+} // namespace NearCache
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -85,6 +85,7 @@ private:
     std::chrono::milliseconds bufferFlushTimeoutInMs() const override {
       return std::chrono::milliseconds(1);
     }
+    bool enableAutoPipelining() const override { return false; }
 
     uint32_t maxUpstreamUnknownConnections() const override { return 0; }
     bool enableCommandStats() const override { return false; }
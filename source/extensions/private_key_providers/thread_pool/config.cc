@@ -0,0 +1,37 @@
+#include "extensions/private_key_providers/thread_pool/config.h"
+
+#include <memory>
+
+#include "envoy/extensions/private_key_providers/thread_pool/v3alpha/thread_pool.pb.h"
+#include "envoy/extensions/private_key_providers/thread_pool/v3alpha/thread_pool.pb.validate.h"
+#include "envoy/registry/registry.h"
+#include "envoy/server/transport_socket_config.h"
+
+#include "common/config/utility.h"
+#include "common/protobuf/utility.h"
+
+#include "extensions/private_key_providers/thread_pool/thread_pool_private_key_provider.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+Ssl::PrivateKeyMethodProviderSharedPtr
+ThreadPoolPrivateKeyMethodFactory::createPrivateKeyMethodProviderInstance(
+    const envoy::extensions::transport_sockets::tls::v3::PrivateKeyProvider& proto_config,
+    Server::Configuration::TransportSocketFactoryContext& factory_context) {
+  envoy::extensions::private_key_providers::thread_pool::v3alpha::ThreadPoolPrivateKeyMethodConfig
+      config;
+  Config::Utility::translateOpaqueConfig(proto_config.typed_config(), ProtobufWkt::Struct(),
+                                         factory_context.messageValidationVisitor(), config);
+  MessageUtil::validate(config, factory_context.messageValidationVisitor());
+  return std::make_shared<ThreadPoolPrivateKeyMethodProvider>(config, factory_context);
+}
+
+REGISTER_FACTORY(ThreadPoolPrivateKeyMethodFactory, Ssl::PrivateKeyMethodProviderInstanceFactory);
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,333 @@
+#include "extensions/private_key_providers/thread_pool/thread_pool_private_key_provider.h"
+
+#include <memory>
+
+#include "envoy/common/exception.h"
+
+#include "common/common/assert.h"
+#include "common/common/lock_guard.h"
+#include "common/config/datasource.h"
+#include "common/protobuf/utility.h"
+
+#include "openssl/evp.h"
+#include "openssl/pem.h"
+#include "openssl/rsa.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+namespace {
+
+constexpr uint32_t DefaultThreadCount = 1;
+constexpr uint32_t DefaultMaxQueueDepth = 1024;
+
+ThreadPoolPrivateKeyConnection* getConnection(SSL* ssl) {
+  return static_cast<ThreadPoolPrivateKeyConnection*>(
+      SSL_get_ex_data(ssl, ThreadPoolPrivateKeyMethodProvider::connectionIndex()));
+}
+
+ssl_private_key_result_t privateKeySign(SSL* ssl, uint8_t* out, size_t* out_len, size_t max_out,
+                                        uint16_t signature_algorithm, const uint8_t* in,
+                                        size_t in_len) {
+  ThreadPoolPrivateKeyConnection* connection = getConnection(ssl);
+  if (connection == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return connection->start(PrivateKeyOperation::Type::Sign, signature_algorithm, in, in_len, out,
+                           out_len, max_out);
+}
+
+ssl_private_key_result_t privateKeyDecrypt(SSL* ssl, uint8_t* out, size_t* out_len, size_t max_out,
+                                           const uint8_t* in, size_t in_len) {
+  ThreadPoolPrivateKeyConnection* connection = getConnection(ssl);
+  if (connection == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return connection->start(PrivateKeyOperation::Type::Decrypt, 0, in, in_len, out, out_len,
+                           max_out);
+}
+
+ssl_private_key_result_t privateKeyComplete(SSL* ssl, uint8_t* out, size_t* out_len,
+                                            size_t max_out) {
+  ThreadPoolPrivateKeyConnection* connection = getConnection(ssl);
+  if (connection == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return connection->complete(out, out_len, max_out);
+}
+
+ssl_private_key_result_t copyOutput(const PrivateKeyOperation& op, uint8_t* out, size_t* out_len,
+                                    size_t max_out) {
+  if (!op.success_ || op.output_.size() > max_out) {
+    return ssl_private_key_failure;
+  }
+  std::copy(op.output_.begin(), op.output_.end(), out);
+  *out_len = op.output_.size();
+  return ssl_private_key_success;
+}
+
+int createIndex() {
+  int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  RELEASE_ASSERT(index >= 0, "Failed to get SSL user data index.");
+  return index;
+}
+
+} // namespace
+
+PrivateKeyOperationPool::PrivateKeyOperationPool(Thread::ThreadFactory& thread_factory,
+                                                 uint32_t thread_count, uint32_t max_queue_depth,
+                                                 Stats::Gauge& queue_depth)
+    : max_queue_depth_(max_queue_depth), queue_depth_(queue_depth) {
+  for (uint32_t i = 0; i < thread_count; i++) {
+    threads_.emplace_back(thread_factory.createThread([this]() -> void { threadRoutine(); }));
+  }
+}
+
+PrivateKeyOperationPool::~PrivateKeyOperationPool() {
+  {
+    Thread::LockGuard lock(lock_);
+    shutdown_ = true;
+  }
+  work_event_.notifyAll();
+  for (auto& thread : threads_) {
+    thread->join();
+  }
+}
+
+bool PrivateKeyOperationPool::enqueue(Work work) {
+  {
+    Thread::LockGuard lock(lock_);
+    if (queue_.size() >= max_queue_depth_) {
+      return false;
+    }
+    queue_.emplace_back(std::move(work));
+  }
+  queue_depth_.inc();
+  work_event_.notifyOne();
+  return true;
+}
+
+void PrivateKeyOperationPool::threadRoutine() {
+  while (true) {
+    Work work;
+    {
+      Thread::LockGuard lock(lock_);
+      while (queue_.empty() && !shutdown_) {
+        // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
+        work_event_.wait(lock_);
+      }
+      // Pending work is dropped on shutdown; the connections owning it are gone by now.
+      if (shutdown_) {
+        return;
+      }
+      work = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    queue_depth_.dec();
+    work();
+  }
+}
+
+ThreadPoolPrivateKeyConnection::ThreadPoolPrivateKeyConnection(
+    ThreadPoolPrivateKeyMethodProvider& provider, Ssl::PrivateKeyConnectionCallbacks& cb,
+    Event::Dispatcher& dispatcher)
+    : provider_(provider), cb_(cb), dispatcher_(dispatcher) {}
+
+ThreadPoolPrivateKeyConnection::~ThreadPoolPrivateKeyConnection() {
+  if (op_ != nullptr) {
+    op_->cancelled_ = true;
+  }
+}
+
+ssl_private_key_result_t ThreadPoolPrivateKeyConnection::start(PrivateKeyOperation::Type type,
+                                                               uint16_t signature_algorithm,
+                                                               const uint8_t* in, size_t in_len,
+                                                               uint8_t* out, size_t* out_len,
+                                                               size_t max_out) {
+  if (type == PrivateKeyOperation::Type::Sign) {
+    provider_.stats().sign_ops_.inc();
+  } else {
+    provider_.stats().decrypt_ops_.inc();
+  }
+
+  auto op = std::make_shared<PrivateKeyOperation>(type, signature_algorithm, in, in_len, max_out,
+                                                  provider_.timeSource().monotonicTime());
+
+  const bool queued = provider_.pool().enqueue([this, op, dispatcher = &dispatcher_,
+                                                provider = &provider_]() -> void {
+    if (op->cancelled_) {
+      return;
+    }
+    op->queue_time_ = std::chrono::duration_cast<std::chrono::microseconds>(
+        provider->timeSource().monotonicTime() - op->enqueue_time_);
+    provider->runOperation(*op);
+    // The connection can only be destroyed on its own dispatcher, so the cancelled flag has to be
+    // checked again once the result is back on that thread.
+    dispatcher->post([this, op]() -> void {
+      if (!op->cancelled_) {
+        onOperationDone(op);
+      }
+    });
+  });
+
+  if (!queued) {
+    // The pool is saturated. Performing the operation inline stalls this worker, but it is still
+    // better than failing the handshake.
+    provider_.stats().queue_overflow_.inc();
+    provider_.runOperation(*op);
+    const ssl_private_key_result_t result = copyOutput(*op, out, out_len, max_out);
+    if (result != ssl_private_key_success) {
+      provider_.stats().failed_ops_.inc();
+    }
+    return result;
+  }
+
+  op_ = std::move(op);
+  return ssl_private_key_retry;
+}
+
+void ThreadPoolPrivateKeyConnection::onOperationDone(const PrivateKeyOperationSharedPtr& op) {
+  ASSERT(op == op_);
+  provider_.stats().queue_time_us_.recordValue(op->queue_time_.count());
+  op->finished_ = true;
+  cb_.onPrivateKeyMethodComplete();
+}
+
+ssl_private_key_result_t ThreadPoolPrivateKeyConnection::complete(uint8_t* out, size_t* out_len,
+                                                                  size_t max_out) {
+  if (op_ == nullptr) {
+    return ssl_private_key_failure;
+  }
+  if (!op_->finished_) {
+    // The operation didn't finish yet, retry.
+    return ssl_private_key_retry;
+  }
+
+  const ssl_private_key_result_t result = copyOutput(*op_, out, out_len, max_out);
+  if (result != ssl_private_key_success) {
+    provider_.stats().failed_ops_.inc();
+  }
+  op_.reset();
+  return result;
+}
+
+ThreadPoolPrivateKeyMethodProvider::ThreadPoolPrivateKeyMethodProvider(
+    const envoy::extensions::private_key_providers::thread_pool::v3alpha::
+        ThreadPoolPrivateKeyMethodConfig& config,
+    Server::Configuration::TransportSocketFactoryContext& factory_context)
+    : stats_(generateStats(factory_context.scope())),
+      time_source_(factory_context.api().timeSource()) {
+  const std::string private_key =
+      Config::DataSource::read(config.private_key(), false, factory_context.api());
+  bssl::UniquePtr<BIO> bio(
+      BIO_new_mem_buf(const_cast<char*>(private_key.data()), private_key.size()));
+  pkey_.reset(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  if (pkey_ == nullptr) {
+    throw EnvoyException("Failed to load private key for the thread pool private key provider.");
+  }
+  const int key_type = EVP_PKEY_id(pkey_.get());
+  if (key_type != EVP_PKEY_RSA && key_type != EVP_PKEY_EC) {
+    throw EnvoyException("Thread pool private key provider only supports RSA and ECDSA keys.");
+  }
+
+  method_ = std::make_shared<SSL_PRIVATE_KEY_METHOD>();
+  method_->sign = privateKeySign;
+  method_->decrypt = privateKeyDecrypt;
+  method_->complete = privateKeyComplete;
+
+  pool_ = std::make_unique<PrivateKeyOperationPool>(
+      factory_context.api().threadFactory(),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, thread_count, DefaultThreadCount),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_queue_depth, DefaultMaxQueueDepth),
+      stats_.queue_depth_);
+}
+
+ThreadPoolPrivateKeyStats ThreadPoolPrivateKeyMethodProvider::generateStats(Stats::Scope& scope) {
+  const std::string prefix = "private_key_provider.thread_pool.";
+  return {ALL_THREAD_POOL_PRIVATE_KEY_STATS(POOL_COUNTER_PREFIX(scope, prefix),
+                                            POOL_GAUGE_PREFIX(scope, prefix),
+                                            POOL_HISTOGRAM_PREFIX(scope, prefix))};
+}
+
+void ThreadPoolPrivateKeyMethodProvider::runOperation(PrivateKeyOperation& op) const {
+  op.success_ = false;
+  op.output_.resize(op.max_out_);
+
+  if (op.type_ == PrivateKeyOperation::Type::Decrypt) {
+    RSA* rsa = EVP_PKEY_get0_RSA(pkey_.get());
+    size_t out_len = 0;
+    if (rsa == nullptr || !RSA_decrypt(rsa, &out_len, op.output_.data(), op.max_out_,
+                                       op.input_.data(), op.input_.size(), RSA_NO_PADDING)) {
+      return;
+    }
+    op.output_.resize(out_len);
+    op.success_ = true;
+    return;
+  }
+
+  if (SSL_get_signature_algorithm_key_type(op.signature_algorithm_) != EVP_PKEY_id(pkey_.get())) {
+    return;
+  }
+  const EVP_MD* md = SSL_get_signature_algorithm_digest(op.signature_algorithm_);
+  if (md == nullptr) {
+    return;
+  }
+
+  bssl::ScopedEVP_MD_CTX ctx;
+  EVP_PKEY_CTX* pctx = nullptr;
+  if (!EVP_DigestSignInit(ctx.get(), &pctx, md, nullptr, pkey_.get())) {
+    return;
+  }
+  if (SSL_is_signature_algorithm_rsa_pss(op.signature_algorithm_) &&
+      (!EVP_PKEY_CTX_set_rsa_padding(pctx, RSA_PKCS1_PSS_PADDING) ||
+       !EVP_PKEY_CTX_set_rsa_pss_saltlen(pctx, -1 /* salt length is the digest length */))) {
+    return;
+  }
+  size_t out_len = op.max_out_;
+  if (!EVP_DigestSign(ctx.get(), op.output_.data(), &out_len, op.input_.data(),
+                      op.input_.size())) {
+    return;
+  }
+  op.output_.resize(out_len);
+  op.success_ = true;
+}
+
+void ThreadPoolPrivateKeyMethodProvider::registerPrivateKeyMethod(
+    SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher& dispatcher) {
+  if (SSL_get_ex_data(ssl, connectionIndex()) != nullptr) {
+    throw EnvoyException(
+        "Can't distinguish between two registered providers for the same SSL object.");
+  }
+  SSL_set_ex_data(ssl, connectionIndex(), new ThreadPoolPrivateKeyConnection(*this, cb, dispatcher));
+}
+
+void ThreadPoolPrivateKeyMethodProvider::unregisterPrivateKeyMethod(SSL* ssl) {
+  ThreadPoolPrivateKeyConnection* connection = getConnection(ssl);
+  SSL_set_ex_data(ssl, connectionIndex(), nullptr);
+  delete connection;
+}
+
+bool ThreadPoolPrivateKeyMethodProvider::checkFips() {
+  if (EVP_PKEY_id(pkey_.get()) == EVP_PKEY_RSA) {
+    RSA* rsa_private_key = EVP_PKEY_get0_RSA(pkey_.get());
+    return rsa_private_key != nullptr && RSA_check_fips(rsa_private_key);
+  }
+  const EC_KEY* ecdsa_private_key = EVP_PKEY_get0_EC_KEY(pkey_.get());
+  return ecdsa_private_key != nullptr && EC_KEY_check_fips(ecdsa_private_key);
+}
+
+Ssl::BoringSslPrivateKeyMethodSharedPtr
+ThreadPoolPrivateKeyMethodProvider::getBoringSslPrivateKeyMethod() {
+  return method_;
+}
+
+int ThreadPoolPrivateKeyMethodProvider::connectionIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, createIndex());
+}
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "envoy/api/api.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/extensions/private_key_providers/thread_pool/v3alpha/thread_pool.pb.h"
+#include "envoy/server/transport_socket_config.h"
+#include "envoy/ssl/private_key/private_key.h"
+#include "envoy/ssl/private_key/private_key_config.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread/thread.h"
+
+#include "common/common/logger.h"
+#include "common/common/thread.h"
+
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+/**
+ * All thread pool private key provider stats. @see stats_macros.h
+ */
+#define ALL_THREAD_POOL_PRIVATE_KEY_STATS(COUNTER, GAUGE, HISTOGRAM)                               \
+  COUNTER(sign_ops)                                                                                \
+  COUNTER(decrypt_ops)                                                                             \
+  COUNTER(failed_ops)                                                                              \
+  COUNTER(queue_overflow)                                                                          \
+  GAUGE(queue_depth, Accumulate)                                                                   \
+  HISTOGRAM(queue_time_us, Microseconds)
+
+/**
+ * Struct definition for all thread pool private key provider stats. @see stats_macros.h
+ */
+struct ThreadPoolPrivateKeyStats {
+  ALL_THREAD_POOL_PRIVATE_KEY_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT,
+                                    GENERATE_HISTOGRAM_STRUCT)
+};
+
+/**
+ * A fixed size pool of threads executing private key operations off the worker threads. The
+ * number of pending operations is bounded; callers are expected to fall back to running the
+ * operation inline when the queue is full.
+ */
+class PrivateKeyOperationPool : Logger::Loggable<Logger::Id::connection> {
+public:
+  using Work = std::function<void()>;
+
+  PrivateKeyOperationPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count,
+                          uint32_t max_queue_depth, Stats::Gauge& queue_depth);
+  ~PrivateKeyOperationPool();
+
+  /**
+   * Queue a unit of work for a pool thread.
+   * @param work supplies the work to run.
+   * @return false if the queue is full and the work was not queued.
+   */
+  bool enqueue(Work work);
+
+private:
+  void threadRoutine();
+
+  const uint32_t max_queue_depth_;
+  Stats::Gauge& queue_depth_;
+  Thread::MutexBasicLockable lock_;
+  Thread::CondVar work_event_;
+  std::list<Work> queue_ ABSL_GUARDED_BY(lock_);
+  bool shutdown_ ABSL_GUARDED_BY(lock_){};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+/**
+ * The state of a single in-flight private key operation. It is shared between the connection
+ * that started it and the pool thread executing it, so that the connection can go away while the
+ * operation is still running.
+ */
+struct PrivateKeyOperation {
+  enum class Type { Sign, Decrypt };
+
+  PrivateKeyOperation(Type type, uint16_t signature_algorithm, const uint8_t* in, size_t in_len,
+                      size_t max_out, MonotonicTime enqueue_time)
+      : type_(type), signature_algorithm_(signature_algorithm), input_(in, in + in_len),
+        max_out_(max_out), enqueue_time_(enqueue_time) {}
+
+  const Type type_;
+  const uint16_t signature_algorithm_;
+  const std::vector<uint8_t> input_;
+  const size_t max_out_;
+  const MonotonicTime enqueue_time_;
+  std::chrono::microseconds queue_time_{};
+  std::vector<uint8_t> output_;
+  bool success_{};
+  // Set by the connection when it is torn down before the operation completes.
+  std::atomic<bool> cancelled_{};
+  // Set on the connection's dispatcher once the result is ready to be consumed.
+  bool finished_{};
+};
+
+using PrivateKeyOperationSharedPtr = std::shared_ptr<PrivateKeyOperation>;
+
+class ThreadPoolPrivateKeyMethodProvider;
+
+/**
+ * Per SSL connection state of the provider, attached to the SSL object as user data.
+ */
+class ThreadPoolPrivateKeyConnection {
+public:
+  ThreadPoolPrivateKeyConnection(ThreadPoolPrivateKeyMethodProvider& provider,
+                                 Ssl::PrivateKeyConnectionCallbacks& cb,
+                                 Event::Dispatcher& dispatcher);
+  ~ThreadPoolPrivateKeyConnection();
+
+  /**
+   * Start an operation, either on the pool or inline if the pool is saturated.
+   * @return ssl_private_key_retry if the operation was queued, otherwise the result of the inline
+   *         operation with the output written to out/out_len.
+   */
+  ssl_private_key_result_t start(PrivateKeyOperation::Type type, uint16_t signature_algorithm,
+                                 const uint8_t* in, size_t in_len, uint8_t* out, size_t* out_len,
+                                 size_t max_out);
+
+  /**
+   * Collect the result of a queued operation.
+   */
+  ssl_private_key_result_t complete(uint8_t* out, size_t* out_len, size_t max_out);
+
+private:
+  void onOperationDone(const PrivateKeyOperationSharedPtr& op);
+
+  ThreadPoolPrivateKeyMethodProvider& provider_;
+  Ssl::PrivateKeyConnectionCallbacks& cb_;
+  Event::Dispatcher& dispatcher_;
+  PrivateKeyOperationSharedPtr op_;
+};
+
+class ThreadPoolPrivateKeyMethodProvider : public virtual Ssl::PrivateKeyMethodProvider,
+                                           Logger::Loggable<Logger::Id::connection> {
+public:
+  ThreadPoolPrivateKeyMethodProvider(
+      const envoy::extensions::private_key_providers::thread_pool::v3alpha::
+          ThreadPoolPrivateKeyMethodConfig& config,
+      Server::Configuration::TransportSocketFactoryContext& factory_context);
+
+  // Ssl::PrivateKeyMethodProvider
+  void registerPrivateKeyMethod(SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb,
+                                Event::Dispatcher& dispatcher) override;
+  void unregisterPrivateKeyMethod(SSL* ssl) override;
+  bool checkFips() override;
+  Ssl::BoringSslPrivateKeyMethodSharedPtr getBoringSslPrivateKeyMethod() override;
+
+  /**
+   * Run a private key operation with the configured key. This is thread safe and is called from
+   * the pool threads as well as from the worker threads when the pool is saturated.
+   */
+  void runOperation(PrivateKeyOperation& op) const;
+
+  PrivateKeyOperationPool& pool() { return *pool_; }
+  ThreadPoolPrivateKeyStats& stats() { return stats_; }
+  TimeSource& timeSource() { return time_source_; }
+
+  static int connectionIndex();
+
+private:
+  static ThreadPoolPrivateKeyStats generateStats(Stats::Scope& scope);
+
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  ThreadPoolPrivateKeyStats stats_;
+  TimeSource& time_source_;
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  std::unique_ptr<PrivateKeyOperationPool> pool_;
+};
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,30 @@
+#include "extensions/resource_monitors/dispatcher_load/config.h"
+
+#include "envoy/config/resource_monitor/dispatcher_load/v2alpha/dispatcher_load.pb.h"
+#include "envoy/config/resource_monitor/dispatcher_load/v2alpha/dispatcher_load.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "common/protobuf/utility.h"
+
+#include "extensions/resource_monitors/dispatcher_load/dispatcher_load_monitor.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace DispatcherLoadMonitor {
+
+Server::ResourceMonitorPtr DispatcherLoadMonitorFactory::createResourceMonitorFromProtoTyped(
+    const envoy::config::resource_monitor::dispatcher_load::v2alpha::DispatcherLoadConfig& config,
+    Server::Configuration::ResourceMonitorFactoryContext& context) {
+  return std::make_unique<DispatcherLoadMonitor>(config, context);
+}
+
+/**
+ * Static registration for the dispatcher load resource monitor factory. @see RegistryFactory.
+ */
+REGISTER_FACTORY(DispatcherLoadMonitorFactory, Server::Configuration::ResourceMonitorFactory);
+
+} // namespace DispatcherLoadMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
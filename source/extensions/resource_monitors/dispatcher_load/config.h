@@ -0,0 +1,30 @@
+#pragma once
+
+#include "envoy/config/resource_monitor/dispatcher_load/v2alpha/dispatcher_load.pb.h"
+#include "envoy/config/resource_monitor/dispatcher_load/v2alpha/dispatcher_load.pb.validate.h"
+#include "envoy/server/resource_monitor_config.h"
+
+#include "extensions/resource_monitors/common/factory_base.h"
+#include "extensions/resource_monitors/well_known_names.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace DispatcherLoadMonitor {
+
+class DispatcherLoadMonitorFactory
+    : public Common::FactoryBase<
+          envoy::config::resource_monitor::dispatcher_load::v2alpha::DispatcherLoadConfig> {
+public:
+  DispatcherLoadMonitorFactory() : FactoryBase(ResourceMonitorNames::get().DispatcherLoad) {}
+
+private:
+  Server::ResourceMonitorPtr createResourceMonitorFromProtoTyped(
+      const envoy::config::resource_monitor::dispatcher_load::v2alpha::DispatcherLoadConfig& config,
+      Server::Configuration::ResourceMonitorFactoryContext& context) override;
+};
+
+} // namespace DispatcherLoadMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,76 @@
+#include "extensions/resource_monitors/dispatcher_load/dispatcher_load_monitor.h"
+
+#include <algorithm>
+
+#include "envoy/config/resource_monitor/dispatcher_load/v2alpha/dispatcher_load.pb.h"
+
+#include "common/common/assert.h"
+#include "common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace DispatcherLoadMonitor {
+
+DispatcherLoadMonitor::DispatcherLoadMonitor(
+    const envoy::config::resource_monitor::dispatcher_load::v2alpha::DispatcherLoadConfig& config,
+    Server::Configuration::ResourceMonitorFactoryContext& context)
+    : max_loop_duration_us_(
+          DurationUtil::durationToMilliseconds(config.max_loop_duration()) * 1000.0),
+      max_queue_lag_us_(DurationUtil::durationToMilliseconds(config.max_queue_lag()) * 1000.0),
+      time_source_(context.api().timeSource()), slot_(context.threadLocal().allocateSlot()) {}
+
+DispatcherLoadMonitor::~DispatcherLoadMonitor() {
+  if (pending_probe_ != nullptr) {
+    pending_probe_->callbacks_ = nullptr;
+  }
+}
+
+void DispatcherLoadMonitor::recordMax(std::atomic<std::chrono::microseconds::rep>& max,
+                                      std::chrono::microseconds value) {
+  auto current = max.load();
+  while (value.count() > current && !max.compare_exchange_weak(current, value.count())) {
+  }
+}
+
+void DispatcherLoadMonitor::updateResourceUsage(Server::ResourceMonitor::Callbacks& callbacks) {
+  // The workers are only all registered with the thread local storage once the overload manager
+  // starts updating the resources.
+  if (!slot_initialized_) {
+    slot_initialized_ = true;
+    slot_->set([](Event::Dispatcher& dispatcher) -> ThreadLocal::ThreadLocalObjectSharedPtr {
+      return std::make_shared<ThreadDispatcher>(dispatcher);
+    });
+  }
+
+  // The overload manager does not start another update until this one completes.
+  ASSERT(pending_probe_ == nullptr);
+  pending_probe_ = std::make_shared<Probe>(time_source_.monotonicTime(), callbacks);
+  ProbeSharedPtr probe = pending_probe_;
+  TimeSource& time_source = time_source_;
+  slot_->runOnAllThreads(
+      [probe, &time_source](ThreadLocal::ThreadLocalObjectSharedPtr object)
+          -> ThreadLocal::ThreadLocalObjectSharedPtr {
+        auto& thread = *std::dynamic_pointer_cast<ThreadDispatcher>(object);
+        recordMax(probe->max_queue_lag_us_,
+                  std::chrono::duration_cast<std::chrono::microseconds>(
+                      time_source.monotonicTime() - probe->start_time_));
+        recordMax(probe->max_loop_duration_us_, thread.dispatcher_.takeMaxLoopDuration());
+        return object;
+      },
+      [this, probe]() {
+        if (probe->callbacks_ == nullptr) {
+          return;
+        }
+        pending_probe_ = nullptr;
+        const double pressure =
+            std::max(probe->max_loop_duration_us_.load() / max_loop_duration_us_,
+                     probe->max_queue_lag_us_.load() / max_queue_lag_us_);
+        probe->callbacks_->onSuccess({pressure});
+      });
+}
+
+} // namespace DispatcherLoadMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include "envoy/common/time.h"
+#include "envoy/config/resource_monitor/dispatcher_load/v2alpha/dispatcher_load.pb.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/server/resource_monitor.h"
+#include "envoy/server/resource_monitor_config.h"
+#include "envoy/thread_local/thread_local.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace DispatcherLoadMonitor {
+
+/**
+ * A monitor of the load of the event loops of the main thread and of the workers. Each update
+ * posts a probe to every thread, which measures how long it waited in the queue of the thread and
+ * takes the longest iteration of the event loop of the thread. The resource pressure is the
+ * largest of these durations relative to their configured maximums, so that the overload manager
+ * can react to a loaded worker before its latency makes the whole process overloaded.
+ */
+class DispatcherLoadMonitor : public Server::ResourceMonitor {
+public:
+  DispatcherLoadMonitor(
+      const envoy::config::resource_monitor::dispatcher_load::v2alpha::DispatcherLoadConfig& config,
+      Server::Configuration::ResourceMonitorFactoryContext& context);
+  ~DispatcherLoadMonitor() override;
+
+  // Server::ResourceMonitor
+  void updateResourceUsage(Server::ResourceMonitor::Callbacks& callbacks) override;
+
+private:
+  struct ThreadDispatcher : public ThreadLocal::ThreadLocalObject {
+    ThreadDispatcher(Event::Dispatcher& dispatcher) : dispatcher_(dispatcher) {}
+
+    Event::Dispatcher& dispatcher_;
+  };
+
+  // An update in progress, shared with the probes posted to the threads.
+  struct Probe {
+    Probe(MonotonicTime start_time, Server::ResourceMonitor::Callbacks& callbacks)
+        : start_time_(start_time), callbacks_(&callbacks) {}
+
+    const MonotonicTime start_time_;
+    // Only accessed from the main thread. Reset if the monitor is destroyed during the update.
+    Server::ResourceMonitor::Callbacks* callbacks_;
+    std::atomic<std::chrono::microseconds::rep> max_loop_duration_us_{0};
+    std::atomic<std::chrono::microseconds::rep> max_queue_lag_us_{0};
+  };
+  using ProbeSharedPtr = std::shared_ptr<Probe>;
+
+  static void recordMax(std::atomic<std::chrono::microseconds::rep>& max,
+                        std::chrono::microseconds value);
+
+  const double max_loop_duration_us_;
+  const double max_queue_lag_us_;
+  TimeSource& time_source_;
+  ThreadLocal::SlotPtr slot_;
+  bool slot_initialized_{};
+  ProbeSharedPtr pending_probe_;
+};
+
+} // namespace DispatcherLoadMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
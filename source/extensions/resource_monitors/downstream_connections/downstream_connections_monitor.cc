@@ -0,0 +1,28 @@
+#include "extensions/resource_monitors/downstream_connections/downstream_connections_monitor.h"
+
+#include "envoy/config/resource_monitor/downstream_connections/v2alpha/downstream_connections.pb.h"
+
+#include "server/connection_handler_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace DownstreamConnectionsMonitor {
+
+DownstreamConnectionsMonitor::DownstreamConnectionsMonitor(
+    const envoy::config::resource_monitor::downstream_connections::v2alpha::
+        DownstreamConnectionsConfig& config)
+    : max_active_downstream_connections_(config.max_active_downstream_connections()) {}
+
+void DownstreamConnectionsMonitor::updateResourceUsage(
+    Server::ResourceMonitor::Callbacks& callbacks) {
+  const uint64_t connections = Server::ConnectionHandlerImpl::numGlobalConnections();
+  Server::ResourceUsage usage;
+  usage.resource_pressure_ = connections / static_cast<double>(max_active_downstream_connections_);
+  callbacks.onSuccess(usage);
+}
+
+} // namespace DownstreamConnectionsMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
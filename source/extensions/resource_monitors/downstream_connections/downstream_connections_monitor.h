@@ -0,0 +1,31 @@
+#pragma once
+
+#include "envoy/config/resource_monitor/downstream_connections/v2alpha/downstream_connections.pb.h"
+#include "envoy/server/resource_monitor.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace DownstreamConnectionsMonitor {
+
+/**
+ * A monitor of the number of downstream connections open on all the listeners of all the
+ * workers. The resource pressure is the number of connections divided by a statically configured
+ * maximum.
+ */
+class DownstreamConnectionsMonitor : public Server::ResourceMonitor {
+public:
+  DownstreamConnectionsMonitor(const envoy::config::resource_monitor::downstream_connections::
+                                   v2alpha::DownstreamConnectionsConfig& config);
+
+  // Server::ResourceMonitor
+  void updateResourceUsage(Server::ResourceMonitor::Callbacks& callbacks) override;
+
+private:
+  const uint64_t max_active_downstream_connections_;
+};
+
+} // namespace DownstreamConnectionsMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,30 @@
+#include "extensions/resource_monitors/pressure_stall/config.h"
+
+#include "envoy/config/resource_monitor/pressure_stall/v2alpha/pressure_stall.pb.h"
+#include "envoy/config/resource_monitor/pressure_stall/v2alpha/pressure_stall.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "common/protobuf/utility.h"
+
+#include "extensions/resource_monitors/pressure_stall/pressure_stall_monitor.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace PressureStallMonitor {
+
+Server::ResourceMonitorPtr PressureStallMonitorFactory::createResourceMonitorFromProtoTyped(
+    const envoy::config::resource_monitor::pressure_stall::v2alpha::PressureStallConfig& config,
+    Server::Configuration::ResourceMonitorFactoryContext& context) {
+  return std::make_unique<PressureStallMonitor>(config, context);
+}
+
+/**
+ * Static registration for the pressure stall resource monitor factory. @see RegistryFactory.
+ */
+REGISTER_FACTORY(PressureStallMonitorFactory, Server::Configuration::ResourceMonitorFactory);
+
+} // namespace PressureStallMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
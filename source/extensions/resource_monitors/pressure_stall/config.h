@@ -0,0 +1,30 @@
+#pragma once
+
+#include "envoy/config/resource_monitor/pressure_stall/v2alpha/pressure_stall.pb.h"
+#include "envoy/config/resource_monitor/pressure_stall/v2alpha/pressure_stall.pb.validate.h"
+#include "envoy/server/resource_monitor_config.h"
+
+#include "extensions/resource_monitors/common/factory_base.h"
+#include "extensions/resource_monitors/well_known_names.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace PressureStallMonitor {
+
+class PressureStallMonitorFactory
+    : public Common::FactoryBase<
+          envoy::config::resource_monitor::pressure_stall::v2alpha::PressureStallConfig> {
+public:
+  PressureStallMonitorFactory() : FactoryBase(ResourceMonitorNames::get().PressureStall) {}
+
+private:
+  Server::ResourceMonitorPtr createResourceMonitorFromProtoTyped(
+      const envoy::config::resource_monitor::pressure_stall::v2alpha::PressureStallConfig& config,
+      Server::Configuration::ResourceMonitorFactoryContext& context) override;
+};
+
+} // namespace PressureStallMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,112 @@
+#include "extensions/resource_monitors/pressure_stall/pressure_stall_monitor.h"
+
+#include <vector>
+
+#include "envoy/common/exception.h"
+#include "envoy/config/resource_monitor/pressure_stall/v2alpha/pressure_stall.pb.h"
+
+#include "common/common/assert.h"
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace PressureStallMonitor {
+
+namespace {
+
+using PressureStallConfig =
+    envoy::config::resource_monitor::pressure_stall::v2alpha::PressureStallConfig;
+
+std::string pressurePath(const PressureStallConfig& config) {
+  std::string resource;
+  switch (config.resource()) {
+  case PressureStallConfig::CPU:
+    resource = "cpu";
+    break;
+  case PressureStallConfig::MEMORY:
+    resource = "memory";
+    break;
+  case PressureStallConfig::IO:
+    resource = "io";
+    break;
+  default:
+    NOT_REACHED_GCOVR_EXCL_LINE;
+  }
+  if (config.cgroup_path().empty()) {
+    return absl::StrCat("/proc/pressure/", resource);
+  }
+  return absl::StrCat(config.cgroup_path(), "/", resource, ".pressure");
+}
+
+std::string stallLine(const PressureStallConfig& config) {
+  switch (config.stall()) {
+  case PressureStallConfig::SOME:
+    return "some";
+  case PressureStallConfig::FULL:
+    return "full";
+  default:
+    NOT_REACHED_GCOVR_EXCL_LINE;
+  }
+}
+
+std::string windowField(const PressureStallConfig& config) {
+  switch (config.window()) {
+  case PressureStallConfig::AVG10:
+    return "avg10";
+  case PressureStallConfig::AVG60:
+    return "avg60";
+  case PressureStallConfig::AVG300:
+    return "avg300";
+  default:
+    NOT_REACHED_GCOVR_EXCL_LINE;
+  }
+}
+
+} // namespace
+
+PressureStallMonitor::PressureStallMonitor(
+    const envoy::config::resource_monitor::pressure_stall::v2alpha::PressureStallConfig& config,
+    Server::Configuration::ResourceMonitorFactoryContext& context)
+    : path_(pressurePath(config)), line_(stallLine(config)), field_(windowField(config)),
+      max_stall_percent_(config.max_stall_percent()), api_(context.api()) {}
+
+void PressureStallMonitor::updateResourceUsage(Server::ResourceMonitor::Callbacks& callbacks) {
+  double stall_percent;
+  try {
+    stall_percent = parseStallPercent(api_.fileSystem().fileReadToEnd(path_), line_, field_);
+  } catch (const EnvoyException& error) {
+    callbacks.onFailure(error);
+    return;
+  }
+
+  Server::ResourceUsage usage;
+  usage.resource_pressure_ = stall_percent / max_stall_percent_;
+  callbacks.onSuccess(usage);
+}
+
+double PressureStallMonitor::parseStallPercent(absl::string_view contents, absl::string_view line,
+                                               absl::string_view field) {
+  for (absl::string_view contents_line : absl::StrSplit(contents, '\n', absl::SkipEmpty())) {
+    std::vector<absl::string_view> words = absl::StrSplit(contents_line, ' ', absl::SkipEmpty());
+    if (words.empty() || words[0] != line) {
+      continue;
+    }
+    for (size_t i = 1; i < words.size(); ++i) {
+      std::pair<absl::string_view, absl::string_view> value = absl::StrSplit(words[i], '=');
+      double percent;
+      if (value.first == field && absl::SimpleAtod(value.second, &percent)) {
+        return percent;
+      }
+    }
+  }
+  throw EnvoyException(absl::StrCat("failed to parse ", line, " ", field, " pressure stall"));
+}
+
+} // namespace PressureStallMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+
+#include "envoy/api/api.h"
+#include "envoy/config/resource_monitor/pressure_stall/v2alpha/pressure_stall.pb.h"
+#include "envoy/server/resource_monitor.h"
+#include "envoy/server/resource_monitor_config.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace PressureStallMonitor {
+
+/**
+ * A monitor of the pressure stall information (PSI) of the Linux kernel, for the whole system or
+ * for a cgroup v2. The resource pressure is the configured average of the share of stalled time,
+ * relative to a configured maximum. Unlike the heap size, the stalled time grows as soon as the
+ * CPU, memory or IO of the container become contended, before Envoy runs out of them.
+ */
+class PressureStallMonitor : public Server::ResourceMonitor {
+public:
+  PressureStallMonitor(
+      const envoy::config::resource_monitor::pressure_stall::v2alpha::PressureStallConfig& config,
+      Server::Configuration::ResourceMonitorFactoryContext& context);
+
+  // Server::ResourceMonitor
+  void updateResourceUsage(Server::ResourceMonitor::Callbacks& callbacks) override;
+
+  /**
+   * Parses the contents of a PSI file, such as:
+   *   some avg10=1.53 avg60=0.87 avg300=0.32 total=2178234
+   *   full avg10=0.00 avg60=0.00 avg300=0.00 total=0
+   * @param contents the contents of the file.
+   * @param line the first word of the line to read, "some" or "full".
+   * @param field the average to read, "avg10", "avg60" or "avg300".
+   * @return the average percentage of stalled time.
+   * @throw EnvoyException if the file does not contain the average.
+   */
+  static double parseStallPercent(absl::string_view contents, absl::string_view line,
+                                  absl::string_view field);
+
+private:
+  const std::string path_;
+  const std::string line_;
+  const std::string field_;
+  const double max_stall_percent_;
+  Api::Api& api_;
+};
+
+} // namespace PressureStallMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
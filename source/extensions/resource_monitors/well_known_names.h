@@ -18,6 +18,15 @@ public:
 
   // File-based injected resource monitor.
   const std::string InjectedResource = "envoy.resource_monitors.injected_resource";
+
+  // Monitor of the event loop latency of the main thread and of the workers.
+  const std::string DispatcherLoad = "envoy.resource_monitors.dispatcher_load";
+
+  // Monitor of the number of downstream connections of all the workers.
+  const std::string DownstreamConnections = "envoy.resource_monitors.downstream_connections";
+
+  // Monitor of the pressure stall information of the system or of a cgroup.
+  const std::string PressureStall = "envoy.resource_monitors.pressure_stall";
 };
 
 using ResourceMonitorNames = ConstSingleton<ResourceMonitorNameValues>;
@@ -139,6 +139,8 @@ Secret::TlsSessionTicketKeysConfigProviderSharedPtr getTlsSessionTicketKeysConfi
   }
   case envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext::
       SessionTicketKeysTypeCase::kDisableStatelessSessionResumption:
+  case envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext::
+      SessionTicketKeysTypeCase::kSessionTicketKeysRotationInterval:
   case envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext::
       SessionTicketKeysTypeCase::SESSION_TICKET_KEYS_TYPE_NOT_SET:
     return nullptr;
@@ -393,7 +395,9 @@ ServerContextConfigImpl::ServerContextConfigImpl(
       require_client_certificate_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, require_client_certificate, false)),
       session_ticket_keys_provider_(getTlsSessionTicketKeysConfigProvider(factory_context, config)),
-      disable_stateless_session_resumption_(getStatelessSessionResumptionDisabled(config)) {
+      disable_stateless_session_resumption_(getStatelessSessionResumptionDisabled(config)),
+      shared_session_cache_size_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, shared_session_cache_size, 0)) {
 
   if (session_ticket_keys_provider_ != nullptr) {
     // Validate tls session ticket keys early to reject bad sds updates.
@@ -419,6 +423,17 @@ ServerContextConfigImpl::ServerContextConfigImpl(
     session_timeout_ =
         std::chrono::seconds(DurationUtil::durationToSeconds(config.session_timeout()));
   }
+
+  if (config.has_session_ticket_keys_rotation_interval()) {
+    session_ticket_keys_rotation_interval_ = std::chrono::seconds(
+        DurationUtil::durationToSeconds(config.session_ticket_keys_rotation_interval()));
+  }
+
+  if (config.has_sni_certificate_selection()) {
+    max_loaded_sni_certificates_ = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+        config.sni_certificate_selection(), max_loaded_certificates,
+        DEFAULT_MAX_LOADED_SNI_CERTIFICATES);
+  }
 }
 
 ServerContextConfigImpl::~ServerContextConfigImpl() {
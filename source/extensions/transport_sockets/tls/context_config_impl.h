@@ -150,12 +150,20 @@ public:
   bool disableStatelessSessionResumption() const override {
     return disable_stateless_session_resumption_;
   }
+  absl::optional<std::chrono::seconds> sessionTicketKeysRotationInterval() const override {
+    return session_ticket_keys_rotation_interval_;
+  }
+  uint32_t sharedSessionCacheSize() const override { return shared_session_cache_size_; }
+  absl::optional<uint32_t> maxLoadedSniCertificates() const override {
+    return max_loaded_sni_certificates_;
+  }
 
 private:
   static const unsigned DEFAULT_MIN_VERSION;
   static const unsigned DEFAULT_MAX_VERSION;
   static const std::string DEFAULT_CIPHER_SUITES;
   static const std::string DEFAULT_CURVES;
+  static constexpr uint32_t DEFAULT_MAX_LOADED_SNI_CERTIFICATES = 1024;
 
   const bool require_client_certificate_;
   std::vector<SessionTicketKey> session_ticket_keys_;
@@ -169,6 +177,9 @@ private:
 
   absl::optional<std::chrono::seconds> session_timeout_;
   const bool disable_stateless_session_resumption_;
+  absl::optional<std::chrono::seconds> session_ticket_keys_rotation_interval_;
+  const uint32_t shared_session_cache_size_;
+  absl::optional<uint32_t> max_loaded_sni_certificates_;
 };
 
 } // namespace Tls
@@ -49,6 +49,83 @@ bool cbsContainsU16(CBS& cbs, uint16_t n) {
   return false;
 }
 
+// Check that the public key of a certificate is of a supported type and size.
+// @return true if the key is an ECDSA key.
+bool checkPublicKey(EVP_PKEY* public_key, const std::string& cert_chain_file_path) {
+  switch (EVP_PKEY_id(public_key)) {
+  case EVP_PKEY_EC: {
+    // We only support P-256 ECDSA today.
+    const EC_KEY* ecdsa_public_key = EVP_PKEY_get0_EC_KEY(public_key);
+    // Since we checked the key type above, this should be valid.
+    ASSERT(ecdsa_public_key != nullptr);
+    const EC_GROUP* ecdsa_group = EC_KEY_get0_group(ecdsa_public_key);
+    if (ecdsa_group == nullptr || EC_GROUP_get_curve_name(ecdsa_group) != NID_X9_62_prime256v1) {
+      throw EnvoyException(fmt::format("Failed to load certificate chain from {}, only P-256 "
+                                       "ECDSA certificates are supported",
+                                       cert_chain_file_path));
+    }
+    return true;
+  }
+  case EVP_PKEY_RSA: {
+    // We require RSA certificates with 2048-bit or larger keys.
+    const RSA* rsa_public_key = EVP_PKEY_get0_RSA(public_key);
+    // Since we checked the key type above, this should be valid.
+    ASSERT(rsa_public_key != nullptr);
+    const unsigned rsa_key_length = RSA_size(rsa_public_key);
+#ifdef BORINGSSL_FIPS
+    if (rsa_key_length != 2048 / 8 && rsa_key_length != 3072 / 8) {
+      throw EnvoyException(
+          fmt::format("Failed to load certificate chain from {}, only RSA certificates with "
+                      "2048-bit or 3072-bit keys are supported in FIPS mode",
+                      cert_chain_file_path));
+    }
+#else
+    if (rsa_key_length < 2048 / 8) {
+      throw EnvoyException(fmt::format("Failed to load certificate chain from {}, only RSA "
+                                       "certificates with 2048-bit or larger keys are supported",
+                                       cert_chain_file_path));
+    }
+#endif
+    return false;
+  }
+  default:
+#ifdef BORINGSSL_FIPS
+    throw EnvoyException(fmt::format("Failed to load certificate chain from {}, only RSA and "
+                                     "ECDSA certificates are supported in FIPS mode",
+                                     cert_chain_file_path));
+#else
+    return false;
+#endif
+  }
+}
+
+// Verify that private keys are passing FIPS pairwise consistency tests.
+void checkPrivateKeyFips(EVP_PKEY* pkey, const std::string& private_key_path) {
+#ifdef BORINGSSL_FIPS
+  switch (EVP_PKEY_id(pkey)) {
+  case EVP_PKEY_EC: {
+    const EC_KEY* ecdsa_private_key = EVP_PKEY_get0_EC_KEY(pkey);
+    if (!EC_KEY_check_fips(ecdsa_private_key)) {
+      throw EnvoyException(fmt::format("Failed to load private key from {}, ECDSA key failed "
+                                       "pairwise consistency test required in FIPS mode",
+                                       private_key_path));
+    }
+  } break;
+  case EVP_PKEY_RSA: {
+    RSA* rsa_private_key = EVP_PKEY_get0_RSA(pkey);
+    if (!RSA_check_fips(rsa_private_key)) {
+      throw EnvoyException(fmt::format("Failed to load private key from {}, RSA key failed "
+                                       "pairwise consistency test required in FIPS mode",
+                                       private_key_path));
+    }
+  } break;
+  }
+#else
+  UNREFERENCED_PARAMETER(pkey);
+  UNREFERENCED_PARAMETER(private_key_path);
+#endif
+}
+
 } // namespace
 
 int ContextImpl::sslExtendedSocketInfoIndex() {
@@ -60,7 +137,7 @@ int ContextImpl::sslExtendedSocketInfoIndex() {
 }
 
 ContextImpl::ContextImpl(Stats::Scope& scope, const Envoy::Ssl::ContextConfig& config,
-                         TimeSource& time_source)
+                         TimeSource& time_source, bool load_certificates)
     : scope_(scope), stats_(generateStats(scope)), time_source_(time_source),
       tls_max_version_(config.maxProtocolVersion()),
       stat_name_set_(scope.symbolTable().makeSet("TransportSockets::Tls")),
@@ -72,7 +149,10 @@ ContextImpl::ContextImpl(Stats::Scope& scope, const Envoy::Ssl::ContextConfig& c
       ssl_versions_(stat_name_set_->add("ssl.versions")),
       ssl_curves_(stat_name_set_->add("ssl.curves")),
       ssl_sigalgs_(stat_name_set_->add("ssl.sigalgs")) {
-  const auto tls_certificates = config.tlsCertificates();
+  std::vector<std::reference_wrapper<const Envoy::Ssl::TlsCertificateConfig>> tls_certificates;
+  if (load_certificates) {
+    tls_certificates = config.tlsCertificates();
+  }
   tls_contexts_.resize(std::max(static_cast<size_t>(1), tls_certificates.size()));
 
   for (auto& ctx : tls_contexts_) {
@@ -303,49 +383,7 @@ ContextImpl::ContextImpl(Stats::Scope& scope, const Envoy::Ssl::ContextConfig& c
                                        "certificate of a given type may be specified",
                                        ctx.cert_chain_file_path_));
     }
-    ctx.is_ecdsa_ = pkey_id == EVP_PKEY_EC;
-    switch (pkey_id) {
-    case EVP_PKEY_EC: {
-      // We only support P-256 ECDSA today.
-      const EC_KEY* ecdsa_public_key = EVP_PKEY_get0_EC_KEY(public_key.get());
-      // Since we checked the key type above, this should be valid.
-      ASSERT(ecdsa_public_key != nullptr);
-      const EC_GROUP* ecdsa_group = EC_KEY_get0_group(ecdsa_public_key);
-      if (ecdsa_group == nullptr || EC_GROUP_get_curve_name(ecdsa_group) != NID_X9_62_prime256v1) {
-        throw EnvoyException(fmt::format("Failed to load certificate chain from {}, only P-256 "
-                                         "ECDSA certificates are supported",
-                                         ctx.cert_chain_file_path_));
-      }
-      ctx.is_ecdsa_ = true;
-    } break;
-    case EVP_PKEY_RSA: {
-      // We require RSA certificates with 2048-bit or larger keys.
-      const RSA* rsa_public_key = EVP_PKEY_get0_RSA(public_key.get());
-      // Since we checked the key type above, this should be valid.
-      ASSERT(rsa_public_key != nullptr);
-      const unsigned rsa_key_length = RSA_size(rsa_public_key);
-#ifdef BORINGSSL_FIPS
-      if (rsa_key_length != 2048 / 8 && rsa_key_length != 3072 / 8) {
-        throw EnvoyException(
-            fmt::format("Failed to load certificate chain from {}, only RSA certificates with "
-                        "2048-bit or 3072-bit keys are supported in FIPS mode",
-                        ctx.cert_chain_file_path_));
-      }
-#else
-      if (rsa_key_length < 2048 / 8) {
-        throw EnvoyException(fmt::format("Failed to load certificate chain from {}, only RSA "
-                                         "certificates with 2048-bit or larger keys are supported",
-                                         ctx.cert_chain_file_path_));
-      }
-#endif
-    } break;
-#ifdef BORINGSSL_FIPS
-    default:
-      throw EnvoyException(fmt::format("Failed to load certificate chain from {}, only RSA and "
-                                       "ECDSA certificates are supported in FIPS mode",
-                                       ctx.cert_chain_file_path_));
-#endif
-    }
+    ctx.is_ecdsa_ = checkPublicKey(public_key.get(), ctx.cert_chain_file_path_);
 
     Envoy::Ssl::PrivateKeyMethodProviderSharedPtr private_key_method_provider =
         tls_certificate.privateKeyMethod();
@@ -381,27 +419,7 @@ ContextImpl::ContextImpl(Stats::Scope& scope, const Envoy::Ssl::ContextConfig& c
             absl::StrCat("Failed to load private key from ", tls_certificate.privateKeyPath()));
       }
 
-#ifdef BORINGSSL_FIPS
-      // Verify that private keys are passing FIPS pairwise consistency tests.
-      switch (pkey_id) {
-      case EVP_PKEY_EC: {
-        const EC_KEY* ecdsa_private_key = EVP_PKEY_get0_EC_KEY(pkey.get());
-        if (!EC_KEY_check_fips(ecdsa_private_key)) {
-          throw EnvoyException(fmt::format("Failed to load private key from {}, ECDSA key failed "
-                                           "pairwise consistency test required in FIPS mode",
-                                           tls_certificate.privateKeyPath()));
-        }
-      } break;
-      case EVP_PKEY_RSA: {
-        RSA* rsa_private_key = EVP_PKEY_get0_RSA(pkey.get());
-        if (!RSA_check_fips(rsa_private_key)) {
-          throw EnvoyException(fmt::format("Failed to load private key from {}, RSA key failed "
-                                           "pairwise consistency test required in FIPS mode",
-                                           tls_certificate.privateKeyPath()));
-        }
-      } break;
-      }
-#endif
+      checkPrivateKeyFips(pkey.get(), tls_certificate.privateKeyPath());
     }
   }
 
@@ -813,7 +831,7 @@ Envoy::Ssl::CertificateDetailsPtr ContextImpl::certificateDetails(X509* cert,
 ClientContextImpl::ClientContextImpl(Stats::Scope& scope,
                                      const Envoy::Ssl::ClientContextConfig& config,
                                      TimeSource& time_source)
-    : ContextImpl(scope, config, time_source),
+    : ContextImpl(scope, config, time_source, true),
       server_name_indication_(config.serverNameIndication()),
       allow_renegotiation_(config.allowRenegotiation()),
       max_session_keys_(config.maxSessionKeys()) {
@@ -941,12 +959,20 @@ uint16_t ClientContextImpl::parseSigningAlgorithmsForTest(const std::string& sig
 ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
                                      const Envoy::Ssl::ServerContextConfig& config,
                                      const std::vector<std::string>& server_names,
-                                     TimeSource& time_source)
-    : ContextImpl(scope, config, time_source), session_ticket_keys_(config.sessionTicketKeys()) {
+                                     TimeSource& time_source,
+                                     SharedSessionCacheSharedPtr session_cache,
+                                     SessionTicketKeyRotatorSharedPtr ticket_key_rotator)
+    : ContextImpl(scope, config, time_source, !config.maxLoadedSniCertificates().has_value()),
+      session_ticket_keys_(config.sessionTicketKeys()), session_cache_(std::move(session_cache)),
+      ticket_key_rotator_(std::move(ticket_key_rotator)) {
   if (config.tlsCertificates().empty()) {
     throw EnvoyException("Server TlsCertificates must have a certificate specified");
   }
 
+  if (config.maxLoadedSniCertificates().has_value()) {
+    initializeSniCertificates(config.tlsCertificates(), config.maxLoadedSniCertificates().value());
+  }
+
   // Compute the session context ID hash. We use all the certificate identities,
   // since we should have a common ID for session resumption no matter what cert
   // is used. We do this early because it can throw an EnvoyException.
@@ -982,7 +1008,7 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
 
     if (config.disableStatelessSessionResumption()) {
       SSL_CTX_set_options(ctx.ssl_ctx_.get(), SSL_OP_NO_TICKET);
-    } else if (!session_ticket_keys_.empty()) {
+    } else if (!session_ticket_keys_.empty() || ticket_key_rotator_ != nullptr) {
       SSL_CTX_set_tlsext_ticket_key_cb(
           ctx.ssl_ctx_.get(),
           [](SSL* ssl, uint8_t* key_name, uint8_t* iv, EVP_CIPHER_CTX* ctx, HMAC_CTX* hmac_ctx,
@@ -1001,6 +1027,10 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
       SSL_CTX_set_timeout(ctx.ssl_ctx_.get(), uint32_t(timeout));
     }
 
+    if (session_cache_ != nullptr) {
+      session_cache_->configureContext(ctx.ssl_ctx_.get());
+    }
+
     int rc =
         SSL_CTX_set_session_id_context(ctx.ssl_ctx_.get(), session_id.data(), session_id.size());
     RELEASE_ASSERT(rc == 1, Utility::getLastCryptoError().value_or(""));
@@ -1022,8 +1052,17 @@ ServerContextImpl::generateHashForSessionContextId(const std::vector<std::string
   // case that different Envoy instances each have their own certs. All certificates in a
   // ServerContextImpl context are hashed together, since they all constitute a match on a filter
   // chain for resumption purposes.
-  for (const auto& ctx : tls_contexts_) {
-    X509* cert = SSL_CTX_get0_certificate(ctx.ssl_ctx_.get());
+  std::vector<X509*> certs;
+  if (sni_certificates_.empty()) {
+    for (const auto& ctx : tls_contexts_) {
+      certs.push_back(SSL_CTX_get0_certificate(ctx.ssl_ctx_.get()));
+    }
+  } else {
+    for (const auto& sni_certificate : sni_certificates_) {
+      certs.push_back(sni_certificate.leaf_.get());
+    }
+  }
+  for (X509* cert : certs) {
     RELEASE_ASSERT(cert != nullptr, "TLS context should have an active certificate");
     X509_NAME* cert_subject = X509_get_subject_name(cert);
     RELEASE_ASSERT(cert_subject != nullptr, "TLS certificate should have a subject");
@@ -1143,62 +1182,11 @@ ServerContextImpl::generateHashForSessionContextId(const std::vector<std::string
 
 int ServerContextImpl::sessionTicketProcess(SSL*, uint8_t* key_name, uint8_t* iv,
                                             EVP_CIPHER_CTX* ctx, HMAC_CTX* hmac_ctx, int encrypt) {
-  const EVP_MD* hmac = EVP_sha256();
-  const EVP_CIPHER* cipher = EVP_aes_256_cbc();
-
-  if (encrypt == 1) {
-    // Encrypt
-    RELEASE_ASSERT(!session_ticket_keys_.empty(), "");
-    // TODO(ggreenway): validate in SDS that session_ticket_keys_ cannot be empty,
-    // or if we allow it to be emptied, reconfigure the context so this callback
-    // isn't set.
-
-    const Envoy::Ssl::ServerContextConfig::SessionTicketKey& key = session_ticket_keys_.front();
-
-    static_assert(std::tuple_size<decltype(key.name_)>::value == SSL_TICKET_KEY_NAME_LEN,
-                  "Expected key.name length");
-    std::copy_n(key.name_.begin(), SSL_TICKET_KEY_NAME_LEN, key_name);
-
-    const int rc = RAND_bytes(iv, EVP_CIPHER_iv_length(cipher));
-    ASSERT(rc);
-
-    // This RELEASE_ASSERT is logically a static_assert, but we can't actually get
-    // EVP_CIPHER_key_length(cipher) at compile-time
-    RELEASE_ASSERT(key.aes_key_.size() == EVP_CIPHER_key_length(cipher), "");
-    if (!EVP_EncryptInit_ex(ctx, cipher, nullptr, key.aes_key_.data(), iv)) {
-      return -1;
-    }
-
-    if (!HMAC_Init_ex(hmac_ctx, key.hmac_key_.data(), key.hmac_key_.size(), hmac, nullptr)) {
-      return -1;
-    }
-
-    return 1; // success
-  } else {
-    // Decrypt
-    bool is_enc_key = true; // first element is the encryption key
-    for (const Envoy::Ssl::ServerContextConfig::SessionTicketKey& key : session_ticket_keys_) {
-      static_assert(std::tuple_size<decltype(key.name_)>::value == SSL_TICKET_KEY_NAME_LEN,
-                    "Expected key.name length");
-      if (std::equal(key.name_.begin(), key.name_.end(), key_name)) {
-        if (!HMAC_Init_ex(hmac_ctx, key.hmac_key_.data(), key.hmac_key_.size(), hmac, nullptr)) {
-          return -1;
-        }
-
-        RELEASE_ASSERT(key.aes_key_.size() == EVP_CIPHER_key_length(cipher), "");
-        if (!EVP_DecryptInit_ex(ctx, cipher, nullptr, key.aes_key_.data(), iv)) {
-          return -1;
-        }
-
-        // If our current encryption was not the decryption key, renew
-        return is_enc_key ? 1  // success; do not renew
-                          : 2; // success: renew key
-      }
-      is_enc_key = false;
-    }
-
-    return 0; // decryption failed
+  if (ticket_key_rotator_ != nullptr) {
+    return ticket_key_rotator_->processTicket(key_name, iv, ctx, hmac_ctx, encrypt);
   }
+  return SessionTicketKeyRotator::processTicket(session_ticket_keys_, key_name, iv, ctx, hmac_ctx,
+                                                encrypt);
 }
 
 bool ServerContextImpl::isClientEcdsaCapable(const SSL_CLIENT_HELLO* ssl_client_hello) {
@@ -1274,6 +1262,9 @@ bool ServerContextImpl::isClientEcdsaCapable(const SSL_CLIENT_HELLO* ssl_client_
 enum ssl_select_cert_result_t
 ServerContextImpl::selectTlsContext(const SSL_CLIENT_HELLO* ssl_client_hello) {
   const bool client_ecdsa_capable = isClientEcdsaCapable(ssl_client_hello);
+  if (loaded_sni_certificates_ != nullptr) {
+    return selectSniCertificate(ssl_client_hello, client_ecdsa_capable);
+  }
   // Fallback on first certificate.
   const TlsContext* selected_ctx = &tls_contexts_[0];
   for (const auto& ctx : tls_contexts_) {
@@ -1287,6 +1278,153 @@ ServerContextImpl::selectTlsContext(const SSL_CLIENT_HELLO* ssl_client_hello) {
   return ssl_select_cert_success;
 }
 
+void ServerContextImpl::initializeSniCertificates(
+    const std::vector<std::reference_wrapper<const Envoy::Ssl::TlsCertificateConfig>>&
+        tls_certificates,
+    uint32_t max_loaded_certificates) {
+  const std::string prefix("ssl.sni_certificates.");
+  sni_certificate_stats_ = std::make_unique<SniCertificateStats>(SniCertificateStats{
+      ALL_SNI_CERTIFICATE_STATS(POOL_COUNTER_PREFIX(scope_, prefix),
+                                POOL_GAUGE_PREFIX(scope_, prefix))});
+
+  sni_certificates_.reserve(tls_certificates.size());
+  for (const Envoy::Ssl::TlsCertificateConfig& tls_certificate : tls_certificates) {
+    if (tls_certificate.privateKeyMethod() != nullptr) {
+      throw EnvoyException("Private key providers are not supported with SNI certificate selection");
+    }
+
+    // Only the leaf certificate is parsed here, for its names and key type. The rest of the chain
+    // and the private key are parsed on first use.
+    SniCertificate& certificate = sni_certificates_.emplace_back();
+    certificate.cert_chain_ = tls_certificate.certificateChain();
+    certificate.cert_chain_file_path_ = tls_certificate.certificateChainPath();
+    certificate.private_key_ = tls_certificate.privateKey();
+    certificate.private_key_path_ = tls_certificate.privateKeyPath();
+    certificate.password_ = tls_certificate.password();
+    bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(const_cast<char*>(certificate.cert_chain_.data()),
+                                             certificate.cert_chain_.size()));
+    RELEASE_ASSERT(bio != nullptr, "");
+    certificate.leaf_.reset(PEM_read_bio_X509_AUX(bio.get(), nullptr, nullptr, nullptr));
+    if (certificate.leaf_ == nullptr) {
+      throw EnvoyException(
+          absl::StrCat("Failed to load certificate chain from ", certificate.cert_chain_file_path_));
+    }
+    bssl::UniquePtr<EVP_PKEY> public_key(X509_get_pubkey(certificate.leaf_.get()));
+    const bool is_ecdsa = checkPublicKey(public_key.get(), certificate.cert_chain_file_path_);
+
+    std::vector<std::string> names = Utility::getSubjectAltNames(*certificate.leaf_, GEN_DNS);
+    if (names.empty()) {
+      X509_NAME* subject = X509_get_subject_name(certificate.leaf_.get());
+      const int cn_index = X509_NAME_get_index_by_NID(subject, NID_commonName, -1);
+      if (cn_index >= 0) {
+        ASN1_STRING* cn_asn1 = X509_NAME_ENTRY_get_data(X509_NAME_get_entry(subject, cn_index));
+        names.emplace_back(reinterpret_cast<const char*>(ASN1_STRING_data(cn_asn1)),
+                           ASN1_STRING_length(cn_asn1));
+      }
+    }
+    sni_certificate_index_.add(names, is_ecdsa);
+  }
+
+  loaded_sni_certificates_ = std::make_unique<LoadedCertificateCache>(
+      max_loaded_certificates, [this](size_t index) { return loadSniCertificate(index); },
+      *sni_certificate_stats_);
+}
+
+LoadedCertificateConstSharedPtr ServerContextImpl::loadSniCertificate(size_t index) const {
+  const SniCertificate& certificate = sni_certificates_[index];
+  auto loaded = std::make_shared<LoadedCertificate>();
+
+  bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(const_cast<char*>(certificate.cert_chain_.data()),
+                                           certificate.cert_chain_.size()));
+  RELEASE_ASSERT(bio != nullptr, "");
+  while (true) {
+    bssl::UniquePtr<X509> cert(
+        loaded->chain_.empty() ? PEM_read_bio_X509_AUX(bio.get(), nullptr, nullptr, nullptr)
+                               : PEM_read_bio_X509(bio.get(), nullptr, nullptr, nullptr));
+    if (cert == nullptr) {
+      break;
+    }
+    uint8_t* der = nullptr;
+    const int der_len = i2d_X509(cert.get(), &der);
+    if (der_len <= 0) {
+      break;
+    }
+    loaded->chain_.push_back(CRYPTO_BUFFER_new(der, der_len, nullptr));
+    OPENSSL_free(der);
+  }
+  ERR_clear_error();
+  if (loaded->chain_.empty()) {
+    ENVOY_LOG_MISC(warn, "Failed to load certificate chain from {}",
+                   certificate.cert_chain_file_path_);
+    return nullptr;
+  }
+
+  bio.reset(BIO_new_mem_buf(const_cast<char*>(certificate.private_key_.data()),
+                            certificate.private_key_.size()));
+  RELEASE_ASSERT(bio != nullptr, "");
+  loaded->private_key_.reset(PEM_read_bio_PrivateKey(
+      bio.get(), nullptr, nullptr,
+      !certificate.password_.empty() ? const_cast<char*>(certificate.password_.c_str())
+                                     : nullptr));
+  if (loaded->private_key_ == nullptr ||
+      !X509_check_private_key(certificate.leaf_.get(), loaded->private_key_.get())) {
+    ERR_clear_error();
+    ENVOY_LOG_MISC(warn, "Failed to load private key from {}", certificate.private_key_path_);
+    return nullptr;
+  }
+  try {
+    checkPrivateKeyFips(loaded->private_key_.get(), certificate.private_key_path_);
+  } catch (const EnvoyException& e) {
+    ENVOY_LOG_MISC(warn, "{}", e.what());
+    return nullptr;
+  }
+  return loaded;
+}
+
+enum ssl_select_cert_result_t
+ServerContextImpl::selectSniCertificate(const SSL_CLIENT_HELLO* ssl_client_hello,
+                                        bool client_ecdsa_capable) {
+  const char* server_name = SSL_get_servername(ssl_client_hello->ssl, TLSEXT_NAMETYPE_host_name);
+  absl::optional<size_t> index;
+  if (server_name != nullptr) {
+    index = sni_certificate_index_.find(server_name, client_ecdsa_capable);
+  }
+  if (!index.has_value()) {
+    // Fallback on first certificate.
+    sni_certificate_stats_->no_match_.inc();
+    index = 0;
+  }
+
+  LoadedCertificateConstSharedPtr certificate = loaded_sni_certificates_->get(index.value());
+  // The SSL takes its own references, so the certificate can be unloaded at any time.
+  if (certificate == nullptr ||
+      !SSL_set_chain_and_key(ssl_client_hello->ssl, certificate->chain_.data(),
+                             certificate->chain_.size(), certificate->private_key_.get(),
+                             nullptr)) {
+    return ssl_select_cert_error;
+  }
+  return ssl_select_cert_success;
+}
+
+size_t ServerContextImpl::daysUntilFirstCertExpires() const {
+  size_t days_until_expiration = ContextImpl::daysUntilFirstCertExpires();
+  for (const auto& certificate : sni_certificates_) {
+    const int days = Utility::getDaysUntilExpiration(certificate.leaf_.get(), time_source_);
+    days_until_expiration = std::min<size_t>(std::max(days, 0), days_until_expiration);
+  }
+  return days_until_expiration;
+}
+
+std::vector<Envoy::Ssl::CertificateDetailsPtr> ServerContextImpl::getCertChainInformation() const {
+  std::vector<Envoy::Ssl::CertificateDetailsPtr> cert_details =
+      ContextImpl::getCertChainInformation();
+  for (const auto& certificate : sni_certificates_) {
+    cert_details.emplace_back(
+        certificateDetails(certificate.leaf_.get(), certificate.cert_chain_file_path_));
+  }
+  return cert_details;
+}
+
 void ServerContextImpl::TlsContext::addClientValidationContext(
     const Envoy::Ssl::CertificateValidationContextConfig& config, bool require_client_cert) {
   bssl::UniquePtr<BIO> bio(
@@ -18,6 +18,8 @@
 #include "common/stats/symbol_table_impl.h"
 
 #include "extensions/transport_sockets/tls/context_manager_impl.h"
+#include "extensions/transport_sockets/tls/session_resumption_impl.h"
+#include "extensions/transport_sockets/tls/sni_certificate_index.h"
 
 #include "absl/synchronization/mutex.h"
 #include "openssl/ssl.h"
@@ -102,8 +104,10 @@ public:
   std::vector<Ssl::PrivateKeyMethodProviderSharedPtr> getPrivateKeyMethodProviders();
 
 protected:
+  // If load_certificates is false, the configured certificates are not loaded into tls_contexts_,
+  // which then only holds the context used for new SSL objects.
   ContextImpl(Stats::Scope& scope, const Envoy::Ssl::ContextConfig& config,
-              TimeSource& time_source);
+              TimeSource& time_source, bool load_certificates);
 
   /**
    * The global SSL-library index used for storing a pointer to the context
@@ -227,7 +231,13 @@ private:
 class ServerContextImpl : public ContextImpl, public Envoy::Ssl::ServerContext {
 public:
   ServerContextImpl(Stats::Scope& scope, const Envoy::Ssl::ServerContextConfig& config,
-                    const std::vector<std::string>& server_names, TimeSource& time_source);
+                    const std::vector<std::string>& server_names, TimeSource& time_source,
+                    SharedSessionCacheSharedPtr session_cache,
+                    SessionTicketKeyRotatorSharedPtr ticket_key_rotator);
+
+  // Ssl::Context
+  size_t daysUntilFirstCertExpires() const override;
+  std::vector<Envoy::Ssl::CertificateDetailsPtr> getCertChainInformation() const override;
 
 private:
   using SessionContextID = std::array<uint8_t, SSL_MAX_SSL_SESSION_ID_LENGTH>;
@@ -241,9 +251,37 @@ private:
   // ClientHello details.
   enum ssl_select_cert_result_t selectTlsContext(const SSL_CLIENT_HELLO* ssl_client_hello);
 
+  // A configured certificate when the certificate is selected by SNI.
+  struct SniCertificate {
+    std::string cert_chain_;
+    std::string cert_chain_file_path_;
+    std::string private_key_;
+    std::string private_key_path_;
+    std::string password_;
+    bssl::UniquePtr<X509> leaf_;
+  };
+
+  void initializeSniCertificates(
+      const std::vector<std::reference_wrapper<const Envoy::Ssl::TlsCertificateConfig>>&
+          tls_certificates,
+      uint32_t max_loaded_certificates);
+  LoadedCertificateConstSharedPtr loadSniCertificate(size_t index) const;
+  enum ssl_select_cert_result_t selectSniCertificate(const SSL_CLIENT_HELLO* ssl_client_hello,
+                                                     bool client_ecdsa_capable);
+
   SessionContextID generateHashForSessionContextId(const std::vector<std::string>& server_names);
 
   const std::vector<Envoy::Ssl::ServerContextConfig::SessionTicketKey> session_ticket_keys_;
+  // Set if the context stores sessions in the process wide cache.
+  const SharedSessionCacheSharedPtr session_cache_;
+  // Set if the context uses the process wide rotated session ticket keys.
+  const SessionTicketKeyRotatorSharedPtr ticket_key_rotator_;
+  // Only used if the certificate is selected by SNI, in which case the certificates are set on
+  // each SSL after ClientHello instead of being loaded into tls_contexts_.
+  std::vector<SniCertificate> sni_certificates_;
+  SniCertificateIndex sni_certificate_index_;
+  std::unique_ptr<SniCertificateStats> sni_certificate_stats_;
+  std::unique_ptr<LoadedCertificateCache> loaded_sni_certificates_;
 };
 
 } // namespace Tls
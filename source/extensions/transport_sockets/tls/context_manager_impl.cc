@@ -44,8 +44,19 @@ ContextManagerImpl::createSslServerContext(Stats::Scope& scope,
     return nullptr;
   }
 
-  Envoy::Ssl::ServerContextSharedPtr context =
-      std::make_shared<ServerContextImpl>(scope, config, server_names, time_source_);
+  SharedSessionCacheSharedPtr session_cache;
+  if (config.sharedSessionCacheSize() > 0) {
+    session_cache_->ensureCapacity(config.sharedSessionCacheSize());
+    session_cache = session_cache_;
+  }
+  SessionTicketKeyRotatorSharedPtr ticket_key_rotator;
+  if (config.sessionTicketKeysRotationInterval().has_value()) {
+    ticket_key_rotator_->ensureInterval(config.sessionTicketKeysRotationInterval().value());
+    ticket_key_rotator = ticket_key_rotator_;
+  }
+
+  Envoy::Ssl::ServerContextSharedPtr context = std::make_shared<ServerContextImpl>(
+      scope, config, server_names, time_source_, session_cache, ticket_key_rotator);
   removeEmptyContexts();
   contexts_.emplace_back(context);
   return context;
@@ -62,6 +73,18 @@ size_t ContextManagerImpl::daysUntilFirstCertExpires() const {
   return ret;
 }
 
+Ssl::SessionResumptionState ContextManagerImpl::exportSessionResumptionState() const {
+  Ssl::SessionResumptionState state;
+  state.sessions_ = session_cache_->exportSessions();
+  ticket_key_rotator_->exportKeys(state);
+  return state;
+}
+
+void ContextManagerImpl::importSessionResumptionState(const Ssl::SessionResumptionState& state) {
+  session_cache_->importSessions(state.sessions_);
+  ticket_key_rotator_->importKeys(state);
+}
+
 void ContextManagerImpl::iterateContexts(std::function<void(const Envoy::Ssl::Context&)> callback) {
   for (const auto& ctx_weak_ptr : contexts_) {
     Envoy::Ssl::ContextSharedPtr context = ctx_weak_ptr.lock();
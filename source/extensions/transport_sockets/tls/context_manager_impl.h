@@ -9,6 +9,7 @@
 #include "envoy/stats/scope.h"
 
 #include "extensions/transport_sockets/tls/private_key/private_key_manager_impl.h"
+#include "extensions/transport_sockets/tls/session_resumption_impl.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -24,7 +25,9 @@ namespace Tls {
  */
 class ContextManagerImpl final : public Envoy::Ssl::ContextManager {
 public:
-  ContextManagerImpl(TimeSource& time_source) : time_source_(time_source) {}
+  ContextManagerImpl(TimeSource& time_source)
+      : time_source_(time_source), session_cache_(std::make_shared<SharedSessionCache>()),
+        ticket_key_rotator_(std::make_shared<SessionTicketKeyRotator>(time_source)) {}
   ~ContextManagerImpl() override;
 
   // Ssl::ContextManager
@@ -39,12 +42,18 @@ public:
   Ssl::PrivateKeyMethodManager& privateKeyMethodManager() override {
     return private_key_method_manager_;
   };
+  Ssl::SessionResumptionState exportSessionResumptionState() const override;
+  void importSessionResumptionState(const Ssl::SessionResumptionState& state) override;
 
 private:
   void removeEmptyContexts();
   TimeSource& time_source_;
   std::list<std::weak_ptr<Envoy::Ssl::Context>> contexts_;
   PrivateKeyMethodManagerImpl private_key_method_manager_{};
+  // Session resumption state shared by the server contexts which opt into it. Contexts hold their
+  // own references, since they can outlive the manager.
+  const SharedSessionCacheSharedPtr session_cache_;
+  const SessionTicketKeyRotatorSharedPtr ticket_key_rotator_;
 };
 
 } // namespace Tls
@@ -0,0 +1,313 @@
+#include "extensions/transport_sockets/tls/session_resumption_impl.h"
+
+#include <algorithm>
+
+#include "common/common/assert.h"
+#include "common/common/hash.h"
+
+#include "openssl/hmac.h"
+#include "openssl/rand.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+namespace {
+
+int sessionCacheIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, []() -> int {
+    int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    RELEASE_ASSERT(index >= 0, "Failed to get SSL_CTX user data index.");
+    return index;
+  }());
+}
+
+SharedSessionCache* sessionCache(const SSL_CTX* ctx) {
+  return static_cast<SharedSessionCache*>(SSL_CTX_get_ex_data(ctx, sessionCacheIndex()));
+}
+
+} // namespace
+
+SharedSessionCache::SharedSessionCache() : parse_ctx_(SSL_CTX_new(TLS_method())) {
+  RELEASE_ASSERT(parse_ctx_ != nullptr, "");
+}
+
+void SharedSessionCache::ensureCapacity(uint32_t capacity) {
+  uint32_t current = capacity_.load();
+  while (capacity > current && !capacity_.compare_exchange_weak(current, capacity)) {
+  }
+}
+
+uint32_t SharedSessionCache::shardCapacity() const {
+  return (capacity_.load() + NumShards - 1) / NumShards;
+}
+
+void SharedSessionCache::configureContext(SSL_CTX* ctx) {
+  SSL_CTX_set_ex_data(ctx, sessionCacheIndex(), this);
+  SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+  SSL_CTX_sess_set_new_cb(ctx, [](SSL* ssl, SSL_SESSION* session) -> int {
+    sessionCache(SSL_get_SSL_CTX(ssl))->insert(session);
+    return 0; // The cache took its own reference.
+  });
+  SSL_CTX_sess_set_get_cb(
+      ctx, [](SSL* ssl, const uint8_t* id, int id_len, int* out_copy) -> SSL_SESSION* {
+        // The returned reference is handed over to BoringSSL, so that a concurrent eviction
+        // can't free the session before it gets used.
+        *out_copy = 0;
+        return sessionCache(SSL_get_SSL_CTX(ssl))
+            ->lookup(absl::string_view(reinterpret_cast<const char*>(id), id_len))
+            .release();
+      });
+  SSL_CTX_sess_set_remove_cb(ctx, [](SSL_CTX* ctx, SSL_SESSION* session) -> void {
+    sessionCache(ctx)->remove(session);
+  });
+}
+
+std::string SharedSessionCache::sessionId(const SSL_SESSION* session) {
+  unsigned int len = 0;
+  const uint8_t* id = SSL_SESSION_get_id(session, &len);
+  return {reinterpret_cast<const char*>(id), len};
+}
+
+SharedSessionCache::Shard& SharedSessionCache::shard(absl::string_view session_id) {
+  return shards_[HashUtil::xxHash64(session_id) % NumShards];
+}
+
+void SharedSessionCache::insert(SSL_SESSION* session) {
+  const uint32_t shard_capacity = shardCapacity();
+  if (shard_capacity == 0) {
+    return;
+  }
+  const std::string id = sessionId(session);
+  if (id.empty()) {
+    return;
+  }
+
+  Shard& s = shard(id);
+  absl::MutexLock lock(&s.mutex_);
+  auto it = s.index_.find(id);
+  if (it != s.index_.end()) {
+    s.sessions_.erase(it->second);
+    s.index_.erase(it);
+  }
+  while (s.sessions_.size() >= shard_capacity) {
+    s.index_.erase(sessionId(s.sessions_.back().get()));
+    s.sessions_.pop_back();
+  }
+  s.sessions_.emplace_front(bssl::UpRef(session));
+  s.index_.emplace(id, s.sessions_.begin());
+}
+
+bssl::UniquePtr<SSL_SESSION> SharedSessionCache::lookup(absl::string_view session_id) {
+  Shard& s = shard(session_id);
+  absl::MutexLock lock(&s.mutex_);
+  auto it = s.index_.find(session_id);
+  if (it == s.index_.end()) {
+    return nullptr;
+  }
+  // Move the session to the front of the LRU list.
+  s.sessions_.splice(s.sessions_.begin(), s.sessions_, it->second);
+  return bssl::UpRef(s.sessions_.front().get());
+}
+
+void SharedSessionCache::remove(SSL_SESSION* session) {
+  const std::string id = sessionId(session);
+  Shard& s = shard(id);
+  absl::MutexLock lock(&s.mutex_);
+  auto it = s.index_.find(id);
+  // Only remove the session if it's the same object, the ID could have been reused since.
+  if (it != s.index_.end() && it->second->get() == session) {
+    s.sessions_.erase(it->second);
+    s.index_.erase(it);
+  }
+}
+
+size_t SharedSessionCache::size() const {
+  size_t size = 0;
+  for (const Shard& s : shards_) {
+    absl::MutexLock lock(&s.mutex_);
+    size += s.sessions_.size();
+  }
+  return size;
+}
+
+std::vector<std::string> SharedSessionCache::exportSessions() const {
+  std::vector<std::string> sessions;
+  for (const Shard& s : shards_) {
+    absl::MutexLock lock(&s.mutex_);
+    for (const auto& session : s.sessions_) {
+      uint8_t* data = nullptr;
+      size_t len = 0;
+      if (SSL_SESSION_to_bytes(session.get(), &data, &len)) {
+        sessions.emplace_back(reinterpret_cast<const char*>(data), len);
+        OPENSSL_free(data);
+      }
+    }
+  }
+  return sessions;
+}
+
+void SharedSessionCache::importSessions(const std::vector<std::string>& sessions) {
+  // The parent's cache was big enough to hold these, so make sure they are not evicted before any
+  // context configures the cache.
+  ensureCapacity(sessions.size());
+  // Insert in reverse order, so that the most recently used sessions end up at the front.
+  for (auto it = sessions.rbegin(); it != sessions.rend(); ++it) {
+    bssl::UniquePtr<SSL_SESSION> session(SSL_SESSION_from_bytes(
+        reinterpret_cast<const uint8_t*>(it->data()), it->size(), parse_ctx_.get()));
+    if (session != nullptr) {
+      insert(session.get());
+    }
+  }
+}
+
+SessionTicketKeyRotator::SessionTicketKeyRotator(TimeSource& time_source)
+    : time_source_(time_source) {}
+
+void SessionTicketKeyRotator::ensureInterval(std::chrono::seconds interval) {
+  std::chrono::seconds::rep current = interval_seconds_.load();
+  while (interval.count() < current &&
+         !interval_seconds_.compare_exchange_weak(current, interval.count())) {
+  }
+}
+
+Ssl::ServerContextConfig::SessionTicketKey SessionTicketKeyRotator::generateKey() {
+  Ssl::ServerContextConfig::SessionTicketKey key;
+  RELEASE_ASSERT(RAND_bytes(key.name_.data(), key.name_.size()) == 1, "");
+  RELEASE_ASSERT(RAND_bytes(key.hmac_key_.data(), key.hmac_key_.size()) == 1, "");
+  RELEASE_ASSERT(RAND_bytes(key.aes_key_.data(), key.aes_key_.size()) == 1, "");
+  return key;
+}
+
+void SessionTicketKeyRotator::maybeRotate() {
+  const std::chrono::seconds interval(interval_seconds_.load());
+  const SystemTime now = time_source_.systemTime();
+  {
+    absl::ReaderMutexLock lock(&mutex_);
+    if (!keys_.empty() && (interval == NoRotation || now - current_key_created_ < interval)) {
+      return;
+    }
+  }
+
+  absl::WriterMutexLock lock(&mutex_);
+  // Another thread could have rotated the keys in the meantime.
+  if (!keys_.empty() && (interval == NoRotation || now - current_key_created_ < interval)) {
+    return;
+  }
+  keys_.insert(keys_.begin(), generateKey());
+  if (keys_.size() > MaxKeys) {
+    keys_.pop_back();
+  }
+  current_key_created_ = now;
+}
+
+int SessionTicketKeyRotator::processTicket(uint8_t* key_name, uint8_t* iv, EVP_CIPHER_CTX* ctx,
+                                           HMAC_CTX* hmac_ctx, int encrypt) {
+  maybeRotate();
+  absl::ReaderMutexLock lock(&mutex_);
+  return processTicket(keys_, key_name, iv, ctx, hmac_ctx, encrypt);
+}
+
+int SessionTicketKeyRotator::processTicket(
+    const std::vector<Ssl::ServerContextConfig::SessionTicketKey>& keys, uint8_t* key_name,
+    uint8_t* iv, EVP_CIPHER_CTX* ctx, HMAC_CTX* hmac_ctx, int encrypt) {
+  const EVP_MD* hmac = EVP_sha256();
+  const EVP_CIPHER* cipher = EVP_aes_256_cbc();
+
+  if (encrypt == 1) {
+    // Encrypt
+    RELEASE_ASSERT(!keys.empty(), "");
+    // TODO(ggreenway): validate in SDS that session_ticket_keys_ cannot be empty,
+    // or if we allow it to be emptied, reconfigure the context so this callback
+    // isn't set.
+
+    const Envoy::Ssl::ServerContextConfig::SessionTicketKey& key = keys.front();
+
+    static_assert(std::tuple_size<decltype(key.name_)>::value == SSL_TICKET_KEY_NAME_LEN,
+                  "Expected key.name length");
+    std::copy_n(key.name_.begin(), SSL_TICKET_KEY_NAME_LEN, key_name);
+
+    const int rc = RAND_bytes(iv, EVP_CIPHER_iv_length(cipher));
+    ASSERT(rc);
+
+    // This RELEASE_ASSERT is logically a static_assert, but we can't actually get
+    // EVP_CIPHER_key_length(cipher) at compile-time
+    RELEASE_ASSERT(key.aes_key_.size() == EVP_CIPHER_key_length(cipher), "");
+    if (!EVP_EncryptInit_ex(ctx, cipher, nullptr, key.aes_key_.data(), iv)) {
+      return -1;
+    }
+
+    if (!HMAC_Init_ex(hmac_ctx, key.hmac_key_.data(), key.hmac_key_.size(), hmac, nullptr)) {
+      return -1;
+    }
+
+    return 1; // success
+  } else {
+    // Decrypt
+    bool is_enc_key = true; // first element is the encryption key
+    for (const Envoy::Ssl::ServerContextConfig::SessionTicketKey& key : keys) {
+      static_assert(std::tuple_size<decltype(key.name_)>::value == SSL_TICKET_KEY_NAME_LEN,
+                    "Expected key.name length");
+      if (std::equal(key.name_.begin(), key.name_.end(), key_name)) {
+        if (!HMAC_Init_ex(hmac_ctx, key.hmac_key_.data(), key.hmac_key_.size(), hmac, nullptr)) {
+          return -1;
+        }
+
+        RELEASE_ASSERT(key.aes_key_.size() == EVP_CIPHER_key_length(cipher), "");
+        if (!EVP_DecryptInit_ex(ctx, cipher, nullptr, key.aes_key_.data(), iv)) {
+          return -1;
+        }
+
+        // If our current encryption was not the decryption key, renew
+        return is_enc_key ? 1  // success; do not renew
+                          : 2; // success: renew key
+      }
+      is_enc_key = false;
+    }
+
+    return 0; // decryption failed
+  }
+}
+
+void SessionTicketKeyRotator::exportKeys(Ssl::SessionResumptionState& state) const {
+  absl::ReaderMutexLock lock(&mutex_);
+  for (const auto& key : keys_) {
+    std::string serialized;
+    serialized.reserve(sizeof(key));
+    serialized.append(reinterpret_cast<const char*>(key.name_.data()), key.name_.size());
+    serialized.append(reinterpret_cast<const char*>(key.hmac_key_.data()), key.hmac_key_.size());
+    serialized.append(reinterpret_cast<const char*>(key.aes_key_.data()), key.aes_key_.size());
+    state.ticket_keys_.emplace_back(std::move(serialized));
+  }
+  state.ticket_key_created_ = current_key_created_;
+}
+
+void SessionTicketKeyRotator::importKeys(const Ssl::SessionResumptionState& state) {
+  std::vector<Ssl::ServerContextConfig::SessionTicketKey> keys;
+  for (const std::string& serialized : state.ticket_keys_) {
+    Ssl::ServerContextConfig::SessionTicketKey key;
+    if (serialized.size() != sizeof(key) || keys.size() == MaxKeys) {
+      continue;
+    }
+    size_t pos = 0;
+    std::copy_n(serialized.begin() + pos, key.name_.size(), key.name_.begin());
+    pos += key.name_.size();
+    std::copy_n(serialized.begin() + pos, key.hmac_key_.size(), key.hmac_key_.begin());
+    pos += key.hmac_key_.size();
+    std::copy_n(serialized.begin() + pos, key.aes_key_.size(), key.aes_key_.begin());
+    keys.push_back(key);
+  }
+  if (keys.empty()) {
+    return;
+  }
+
+  absl::WriterMutexLock lock(&mutex_);
+  keys_ = std::move(keys);
+  current_key_created_ = state.ticket_key_created_;
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
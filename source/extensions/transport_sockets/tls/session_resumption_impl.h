@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/ssl/context_config.h"
+#include "envoy/ssl/context_manager.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * A TLS session cache shared by all server contexts of the process, used in place of the
+ * per-SSL_CTX internal cache of BoringSSL. Sessions are keyed by their session ID; BoringSSL
+ * verifies the session ID context on lookup, so sessions are still only resumed by contexts with
+ * the same server certificates.
+ *
+ * The cache is striped into independently locked shards, each of which evicts its least recently
+ * used sessions once it is full, so that workers handshaking concurrently rarely contend.
+ */
+class SharedSessionCache {
+public:
+  SharedSessionCache();
+
+  /**
+   * Raise the number of sessions the cache may hold. The capacity is never lowered, since the
+   * cache is shared by contexts configured with different sizes.
+   */
+  void ensureCapacity(uint32_t capacity);
+  uint32_t capacity() const { return capacity_; }
+
+  /**
+   * Install the session cache callbacks on a server SSL_CTX, in place of its internal cache. The
+   * cache must outlive the SSL_CTX.
+   */
+  void configureContext(SSL_CTX* ctx);
+
+  /**
+   * Store a new session. The cache takes its own reference.
+   */
+  void insert(SSL_SESSION* session);
+
+  /**
+   * @return a new reference to the session with the given ID, or nullptr if not found.
+   */
+  bssl::UniquePtr<SSL_SESSION> lookup(absl::string_view session_id);
+
+  void remove(SSL_SESSION* session);
+
+  size_t size() const;
+
+  /**
+   * @return all sessions serialized with SSL_SESSION_to_bytes(), for hot restart hand over.
+   */
+  std::vector<std::string> exportSessions() const;
+
+  /**
+   * Insert sessions serialized by exportSessions(). Sessions that fail to parse are skipped.
+   */
+  void importSessions(const std::vector<std::string>& sessions);
+
+private:
+  static constexpr size_t NumShards = 16;
+
+  struct Shard {
+    using SessionList = std::list<bssl::UniquePtr<SSL_SESSION>>;
+
+    mutable absl::Mutex mutex_;
+    // Most recently used first.
+    SessionList sessions_ ABSL_GUARDED_BY(mutex_);
+    absl::flat_hash_map<std::string, SessionList::iterator> index_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  static std::string sessionId(const SSL_SESSION* session);
+  Shard& shard(absl::string_view session_id);
+  uint32_t shardCapacity() const;
+
+  std::atomic<uint32_t> capacity_{};
+  std::array<Shard, NumShards> shards_;
+  // Only used for parsing imported sessions.
+  bssl::UniquePtr<SSL_CTX> parse_ctx_;
+};
+
+using SharedSessionCacheSharedPtr = std::shared_ptr<SharedSessionCache>;
+
+/**
+ * Session ticket keys generated and rotated in process, shared by all server contexts configured
+ * for rotation. The current key encrypts new tickets, and the previous keys are kept so that
+ * tickets issued before a rotation can still be decrypted (and are renewed when they are).
+ *
+ * Rotation is driven by the ticket callbacks rather than a timer: the first ticket operation after
+ * the interval has elapsed generates the new key.
+ */
+class SessionTicketKeyRotator {
+public:
+  SessionTicketKeyRotator(TimeSource& time_source);
+
+  /**
+   * Lower the rotation interval. The smallest interval configured by any context is used.
+   */
+  void ensureInterval(std::chrono::seconds interval);
+
+  /**
+   * Session ticket callback, with the semantics of SSL_CTX_set_tlsext_ticket_key_cb().
+   */
+  int processTicket(uint8_t* key_name, uint8_t* iv, EVP_CIPHER_CTX* ctx, HMAC_CTX* hmac_ctx,
+                    int encrypt);
+
+  /**
+   * Session ticket callback implementation for a given set of keys, where the first key encrypts
+   * new tickets and all keys are candidates for decrypting received tickets.
+   */
+  static int processTicket(const std::vector<Ssl::ServerContextConfig::SessionTicketKey>& keys,
+                           uint8_t* key_name, uint8_t* iv, EVP_CIPHER_CTX* ctx, HMAC_CTX* hmac_ctx,
+                           int encrypt);
+
+  void exportKeys(Ssl::SessionResumptionState& state) const;
+  void importKeys(const Ssl::SessionResumptionState& state);
+
+private:
+  static constexpr size_t MaxKeys = 3;
+  static constexpr std::chrono::seconds NoRotation = std::chrono::seconds::max();
+
+  void maybeRotate();
+  static Ssl::ServerContextConfig::SessionTicketKey generateKey();
+
+  TimeSource& time_source_;
+  std::atomic<std::chrono::seconds::rep> interval_seconds_{NoRotation.count()};
+  mutable absl::Mutex mutex_;
+  // The current encryption key first.
+  std::vector<Ssl::ServerContextConfig::SessionTicketKey> keys_ ABSL_GUARDED_BY(mutex_);
+  SystemTime current_key_created_ ABSL_GUARDED_BY(mutex_);
+};
+
+using SessionTicketKeyRotatorSharedPtr = std::shared_ptr<SessionTicketKeyRotator>;
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,131 @@
+#include "extensions/transport_sockets/tls/sni_certificate_index.h"
+
+#include <algorithm>
+
+#include "common/common/assert.h"
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+size_t SniCertificateIndex::add(const std::vector<std::string>& names, bool is_ecdsa) {
+  const size_t index = is_ecdsa_.size();
+  is_ecdsa_.push_back(is_ecdsa);
+  for (const std::string& name : names) {
+    std::string lower_name = absl::AsciiStrToLower(name);
+    if (absl::StartsWith(lower_name, "*.")) {
+      addName(wildcard_names_, lower_name.substr(2), index);
+    } else {
+      addName(exact_names_, std::move(lower_name), index);
+    }
+  }
+  return index;
+}
+
+void SniCertificateIndex::addName(absl::flat_hash_map<std::string, CertificateList>& names,
+                                  std::string&& name, size_t index) {
+  CertificateList& certificates = names[std::move(name)];
+  // A certificate may list the same name more than once.
+  if (certificates.empty() || certificates.back() != index) {
+    certificates.push_back(index);
+  }
+}
+
+absl::optional<size_t> SniCertificateIndex::find(absl::string_view server_name,
+                                                 bool client_ecdsa_capable) const {
+  // Clients are expected to send lower case names, so only convert them if needed.
+  std::string lower_name;
+  if (std::any_of(server_name.begin(), server_name.end(), absl::ascii_isupper)) {
+    lower_name = absl::AsciiStrToLower(server_name);
+    server_name = lower_name;
+  }
+
+  auto it = exact_names_.find(server_name);
+  if (it != exact_names_.end()) {
+    return select(it->second, client_ecdsa_capable);
+  }
+
+  // A wildcard only replaces the leftmost label, and never matches a name by itself.
+  const size_t label_end = server_name.find('.');
+  if (label_end == absl::string_view::npos || label_end == 0) {
+    return absl::nullopt;
+  }
+  it = wildcard_names_.find(server_name.substr(label_end + 1));
+  if (it != wildcard_names_.end()) {
+    return select(it->second, client_ecdsa_capable);
+  }
+  return absl::nullopt;
+}
+
+size_t SniCertificateIndex::select(const CertificateList& certificates,
+                                   bool client_ecdsa_capable) const {
+  ASSERT(!certificates.empty());
+  for (const size_t index : certificates) {
+    if (is_ecdsa_[index] == client_ecdsa_capable) {
+      return index;
+    }
+  }
+  return certificates.front();
+}
+
+LoadedCertificateCache::LoadedCertificateCache(uint32_t capacity, Loader loader,
+                                               SniCertificateStats& stats)
+    : capacity_(capacity), loader_(std::move(loader)), stats_(stats) {
+  ASSERT(capacity_ > 0);
+}
+
+LoadedCertificateCache::~LoadedCertificateCache() {
+  absl::MutexLock lock(&mutex_);
+  stats_.loaded_.sub(entries_.size());
+}
+
+LoadedCertificateConstSharedPtr LoadedCertificateCache::get(size_t index) {
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = entries_.find(index);
+    if (it != entries_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second.lru_position_);
+      return it->second.certificate_;
+    }
+  }
+
+  // Concurrent handshakes may load the same certificate more than once, in which case the first
+  // one to finish wins.
+  LoadedCertificateConstSharedPtr certificate = loader_(index);
+  if (certificate == nullptr) {
+    stats_.load_error_.inc();
+    return nullptr;
+  }
+  stats_.load_.inc();
+
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(index);
+  if (it != entries_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second.lru_position_);
+    return it->second.certificate_;
+  }
+  while (entries_.size() >= capacity_) {
+    entries_.erase(lru_.back());
+    lru_.pop_back();
+    stats_.eviction_.inc();
+    stats_.loaded_.dec();
+  }
+  lru_.push_front(index);
+  entries_.emplace(index, Entry{certificate, lru_.begin()});
+  stats_.loaded_.inc();
+  return certificate;
+}
+
+size_t LoadedCertificateCache::size() const {
+  absl::MutexLock lock(&mutex_);
+  return entries_.size();
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
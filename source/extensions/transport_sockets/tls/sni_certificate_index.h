@@ -0,0 +1,139 @@
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * All SNI certificate selection stats. @see stats_macros.h
+ */
+#define ALL_SNI_CERTIFICATE_STATS(COUNTER, GAUGE)                                                  \
+  COUNTER(no_match)                                                                                \
+  COUNTER(load)                                                                                    \
+  COUNTER(load_error)                                                                              \
+  COUNTER(eviction)                                                                                \
+  GAUGE(loaded, NeverImport)
+
+/**
+ * Struct definition for all SNI certificate selection stats. @see stats_macros.h
+ */
+struct SniCertificateStats {
+  ALL_SNI_CERTIFICATE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+/**
+ * Maps server names to the certificates configured for them. Certificates are identified by the
+ * order in which they were added.
+ */
+class SniCertificateIndex {
+public:
+  /**
+   * Add a certificate to the index.
+   * @param names supplies the DNS names of the certificate. A name beginning with a "*." label
+   *        matches any single label in its place.
+   * @param is_ecdsa supplies whether the certificate has an ECDSA key.
+   * @return the index of the certificate.
+   */
+  size_t add(const std::vector<std::string>& names, bool is_ecdsa);
+
+  /**
+   * Find the certificate to serve for a server name. Exact names are preferred over wildcards,
+   * and among the certificates for the best matching name, the first one with an ECDSA key is
+   * preferred for clients supporting ECDSA, and the first one with another key otherwise.
+   * @param server_name supplies the SNI of the client.
+   * @param client_ecdsa_capable supplies whether the client supports ECDSA.
+   * @return the index of the certificate, or absl::nullopt if none matches the name.
+   */
+  absl::optional<size_t> find(absl::string_view server_name, bool client_ecdsa_capable) const;
+
+  size_t size() const { return is_ecdsa_.size(); }
+
+private:
+  using CertificateList = std::vector<size_t>;
+
+  static void addName(absl::flat_hash_map<std::string, CertificateList>& names,
+                      std::string&& name, size_t index);
+  size_t select(const CertificateList& certificates, bool client_ecdsa_capable) const;
+
+  std::vector<bool> is_ecdsa_;
+  absl::flat_hash_map<std::string, CertificateList> exact_names_;
+  // Keyed by the name without its wildcard label, e.g. "example.com" for "*.example.com".
+  absl::flat_hash_map<std::string, CertificateList> wildcard_names_;
+};
+
+/**
+ * The certificate chain and private key of a certificate, in the form taken by
+ * SSL_set_chain_and_key().
+ */
+struct LoadedCertificate {
+  LoadedCertificate() = default;
+  LoadedCertificate(const LoadedCertificate&) = delete;
+  LoadedCertificate& operator=(const LoadedCertificate&) = delete;
+  ~LoadedCertificate() {
+    for (CRYPTO_BUFFER* cert : chain_) {
+      CRYPTO_BUFFER_free(cert);
+    }
+  }
+
+  // Leaf certificate first. Owned.
+  std::vector<CRYPTO_BUFFER*> chain_;
+  bssl::UniquePtr<EVP_PKEY> private_key_;
+};
+
+using LoadedCertificateConstSharedPtr = std::shared_ptr<const LoadedCertificate>;
+
+/**
+ * A bounded set of loaded certificates, evicting the least recently used ones when full. This is
+ * shared by the worker threads; certificates are loaded outside of the lock, so that a handshake
+ * loading a certificate doesn't stall handshakes using other certificates.
+ */
+class LoadedCertificateCache {
+public:
+  // Returns nullptr if the certificate failed to load.
+  using Loader = std::function<LoadedCertificateConstSharedPtr(size_t index)>;
+
+  LoadedCertificateCache(uint32_t capacity, Loader loader, SniCertificateStats& stats);
+  ~LoadedCertificateCache();
+
+  /**
+   * @return the loaded certificate, loading it if needed, or nullptr if it failed to load.
+   */
+  LoadedCertificateConstSharedPtr get(size_t index);
+
+  size_t size() const;
+
+private:
+  struct Entry {
+    LoadedCertificateConstSharedPtr certificate_;
+    std::list<size_t>::iterator lru_position_;
+  };
+
+  const uint32_t capacity_;
+  const Loader loader_;
+  SniCertificateStats& stats_;
+  mutable absl::Mutex mutex_;
+  // Most recently used first.
+  std::list<size_t> lru_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<size_t, Entry> entries_ ABSL_GUARDED_BY(mutex_);
+};
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
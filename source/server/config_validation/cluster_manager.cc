@@ -18,9 +18,9 @@ ClusterManagerPtr ValidationClusterManagerFactory::clusterManagerFromProto(
 
 CdsApiPtr
 ValidationClusterManagerFactory::createCds(const envoy::config::core::v3::ConfigSource& cds_config,
-                                           ClusterManager& cm) {
-  // Create the CdsApiImpl...
-  ProdClusterManagerFactory::createCds(cds_config, cm);
+                                           ClusterManager& cm, uint32_t) {
+  // Create the CdsApiImpl, without decode threads as it never receives any update...
+  ProdClusterManagerFactory::createCds(cds_config, cm, 0);
   // ... and then throw it away, so that we don't actually connect to it.
   return nullptr;
 }
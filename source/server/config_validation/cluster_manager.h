@@ -42,7 +42,7 @@ public:
   // Delegates to ProdClusterManagerFactory::createCds, but discards the result and returns nullptr
   // unconditionally.
   CdsApiPtr createCds(const envoy::config::core::v3::ConfigSource& cds_config,
-                      ClusterManager& cm) override;
+                      ClusterManager& cm, uint32_t decode_threads) override;
 
 private:
   Grpc::Context& grpc_context_;
@@ -119,10 +119,12 @@ public:
   }
 
   // Server::ListenerComponentFactory
-  LdsApiPtr createLdsApi(const envoy::config::core::v3::ConfigSource& lds_config) override {
+  LdsApiPtr createLdsApi(const envoy::config::core::v3::ConfigSource& lds_config,
+                         uint32_t decode_threads) override {
     return std::make_unique<LdsApiImpl>(lds_config, clusterManager(), initManager(), stats(),
                                         listenerManager(),
-                                        messageValidationContext().dynamicValidationVisitor());
+                                        messageValidationContext().dynamicValidationVisitor(),
+                                        api(), decode_threads);
   }
   std::vector<Network::FilterFactoryCb> createNetworkFilterFactoryList(
       const Protobuf::RepeatedPtrField<envoy::config::listener::v3::Filter>& filters,
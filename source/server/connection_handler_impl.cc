@@ -20,11 +20,17 @@ ConnectionHandlerImpl::ConnectionHandlerImpl(Event::Dispatcher& dispatcher)
     : dispatcher_(dispatcher), per_handler_stat_prefix_(dispatcher.name() + "."),
       disable_listeners_(false) {}
 
-void ConnectionHandlerImpl::incNumConnections() { ++num_handler_connections_; }
+std::atomic<uint64_t> ConnectionHandlerImpl::num_global_connections_;
+
+void ConnectionHandlerImpl::incNumConnections() {
+  ++num_handler_connections_;
+  ++num_global_connections_;
+}
 
 void ConnectionHandlerImpl::decNumConnections() {
   ASSERT(num_handler_connections_ > 0);
   --num_handler_connections_;
+  --num_global_connections_;
 }
 
 void ConnectionHandlerImpl::addListener(absl::optional<uint64_t> overridden_listener,
@@ -503,7 +509,7 @@ ConnectionHandlerImpl::ActiveTcpConnection::ActiveTcpConnection(
   // Active connections on the handler (not listener). The per listener connections have already
   // been incremented at this point either via the connection balancer or in the socket accept
   // path if there is no configured balancer.
-  ++active_connections_.listener_.parent_.num_handler_connections_;
+  active_connections_.listener_.parent_.incNumConnections();
 }
 
 ConnectionHandlerImpl::ActiveTcpConnection::~ActiveTcpConnection() {
@@ -70,6 +70,12 @@ public:
   void addListener(absl::optional<uint64_t> overridden_listener,
                    Network::ListenerConfig& config) override;
   void removeListeners(uint64_t listener_tag) override;
+
+  /**
+   * @return the number of connections of all the connection handlers of the process, which is
+   *         safe to read from any thread.
+   */
+  static uint64_t numGlobalConnections() { return num_global_connections_; }
   void removeFilterChains(uint64_t listener_tag,
                           const std::list<const Network::FilterChain*>& filter_chains,
                           std::function<void()> completion) override;
@@ -318,6 +324,7 @@ private:
   const std::string per_handler_stat_prefix_;
   std::list<std::pair<Network::Address::InstanceConstSharedPtr, ActiveListenerDetails>> listeners_;
   std::atomic<uint64_t> num_handler_connections_{};
+  static std::atomic<uint64_t> num_global_connections_;
   bool disable_listeners_;
 };
 
@@ -305,11 +305,12 @@ void FilterChainManagerImpl::addFilterChainForApplicationProtocols(
 }
 
 void FilterChainManagerImpl::addFilterChainForSourceTypes(
-    SourceTypesArray& source_types_array,
+    SourceTypesMatch& source_types_match,
     const envoy::config::listener::v3::FilterChainMatch::ConnectionSourceType source_type,
     const std::vector<std::string>& source_ips,
     const absl::Span<const Protobuf::uint32> source_ports,
     const Network::FilterChainSharedPtr& filter_chain) {
+  SourceTypesArray& source_types_array = source_types_match.source_types_;
   if (source_ips.empty()) {
     addFilterChainForSourceIPs(source_types_array[source_type].first, EMPTY_STRING, source_ports,
                                filter_chain);
@@ -416,7 +417,7 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDestinatio
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName(
     const ServerNamesMap& server_names_map, const Network::ConnectionSocket& socket) const {
-  const std::string server_name(socket.requestedServerName());
+  const absl::string_view server_name = socket.requestedServerName();
 
   // Match on exact server name, i.e. "www.example.com" for "www.example.com".
   const auto server_name_exact_match = server_names_map.find(server_name);
@@ -426,8 +427,8 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
 
   // Match on all wildcard domains, i.e. ".example.com" and ".com" for "www.example.com".
   size_t pos = server_name.find('.', 1);
-  while (pos < server_name.size() - 1 && pos != std::string::npos) {
-    const std::string wildcard = server_name.substr(pos);
+  while (pos < server_name.size() - 1 && pos != absl::string_view::npos) {
+    const absl::string_view wildcard = server_name.substr(pos);
     const auto server_name_wildcard_match = server_names_map.find(wildcard);
     if (server_name_wildcard_match != server_names_map.end()) {
       return findFilterChainForTransportProtocol(server_name_wildcard_match->second, socket);
@@ -447,7 +448,7 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForTransportProtocol(
     const TransportProtocolsMap& transport_protocols_map,
     const Network::ConnectionSocket& socket) const {
-  const std::string transport_protocol(socket.detectedTransportProtocol());
+  const absl::string_view transport_protocol = socket.detectedTransportProtocol();
 
   // Match on exact transport protocol, e.g. "tls".
   const auto transport_protocol_match = transport_protocols_map.find(transport_protocol);
@@ -485,8 +486,12 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForApplicatio
 }
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForSourceTypes(
-    const SourceTypesArray& source_types, const Network::ConnectionSocket& socket) const {
+    const SourceTypesMatch& source_types_match, const Network::ConnectionSocket& socket) const {
+  if (source_types_match.any_source_filter_chain_ != nullptr) {
+    return source_types_match.any_source_filter_chain_;
+  }
 
+  const SourceTypesArray& source_types = source_types_match.source_types_;
   const auto& filter_chain_local =
       source_types[envoy::config::listener::v3::FilterChainMatch::SAME_IP_OR_LOOPBACK];
 
@@ -570,19 +575,7 @@ void FilterChainManagerImpl::convertIPsToTries() {
       for (auto& server_names_entry : *entry.second) {
         for (auto& transport_protocols_entry : server_names_entry.second) {
           for (auto& application_protocols_entry : transport_protocols_entry.second) {
-            for (auto& source_array_entry : application_protocols_entry.second) {
-              auto& source_ips_map = source_array_entry.first;
-              std::vector<
-                  std::pair<SourcePortsMapSharedPtr, std::vector<Network::Address::CidrRange>>>
-                  source_ips_list;
-              source_ips_list.reserve(source_ips_map.size());
-
-              for (auto& source_ip : source_ips_map) {
-                source_ips_list.push_back(makeCidrListEntry(source_ip.first, source_ip.second));
-              }
-
-              source_array_entry.second = std::make_unique<SourceIPsTrie>(source_ips_list, true);
-            }
+            convertSourceIPsToTries(application_protocols_entry.second);
           }
         }
       }
@@ -592,6 +585,41 @@ void FilterChainManagerImpl::convertIPsToTries() {
   }
 }
 
+void FilterChainManagerImpl::convertSourceIPsToTries(SourceTypesMatch& source_types_match) {
+  for (auto& source_array_entry : source_types_match.source_types_) {
+    auto& source_ips_map = source_array_entry.first;
+    // Empty source types are never looked up.
+    if (source_ips_map.empty()) {
+      continue;
+    }
+    std::vector<std::pair<SourcePortsMapSharedPtr, std::vector<Network::Address::CidrRange>>>
+        source_ips_list;
+    source_ips_list.reserve(source_ips_map.size());
+
+    for (auto& source_ip : source_ips_map) {
+      source_ips_list.push_back(makeCidrListEntry(source_ip.first, source_ip.second));
+    }
+
+    source_array_entry.second = std::make_unique<SourceIPsTrie>(source_ips_list, true);
+  }
+
+  // Flatten the lookup of a single filter chain without any source criteria.
+  const SourceTypesArray& source_types = source_types_match.source_types_;
+  const auto& local =
+      source_types[envoy::config::listener::v3::FilterChainMatch::SAME_IP_OR_LOOPBACK];
+  const auto& external = source_types[envoy::config::listener::v3::FilterChainMatch::EXTERNAL];
+  const auto& any = source_types[envoy::config::listener::v3::FilterChainMatch::ANY];
+  if (local.first.empty() && external.first.empty() && any.first.size() == 1) {
+    const auto any_source_ip = any.first.find(EMPTY_STRING);
+    if (any_source_ip != any.first.end() && any_source_ip->second->size() == 1) {
+      const auto any_source_port = any_source_ip->second->find(0);
+      if (any_source_port != any_source_ip->second->end()) {
+        source_types_match.any_source_filter_chain_ = any_source_port->second.get();
+      }
+    }
+  }
+}
+
 std::shared_ptr<Network::DrainableFilterChain> FilterChainManagerImpl::findExistingFilterChain(
     const envoy::config::listener::v3::FilterChain& filter_chain_message) {
   // Origin filter chain manager could be empty if the current is the ancestor.
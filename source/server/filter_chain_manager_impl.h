@@ -199,13 +199,22 @@ public:
 
 private:
   void convertIPsToTries();
+  static void convertSourceIPsToTries(SourceTypesMatch& source_types_match);
   using SourcePortsMap = absl::flat_hash_map<uint16_t, Network::FilterChainSharedPtr>;
   using SourcePortsMapSharedPtr = std::shared_ptr<SourcePortsMap>;
   using SourceIPsMap = absl::flat_hash_map<std::string, SourcePortsMapSharedPtr>;
   using SourceIPsTrie = Network::LcTrie::LcTrie<SourcePortsMapSharedPtr>;
   using SourceIPsTriePtr = std::unique_ptr<SourceIPsTrie>;
   using SourceTypesArray = std::array<std::pair<SourceIPsMap, SourceIPsTriePtr>, 3>;
-  using ApplicationProtocolsMap = absl::flat_hash_map<std::string, SourceTypesArray>;
+  // The filter chains sharing the same destination, server name, transport protocol and
+  // application protocol criteria, by source criteria. When a single filter chain matches any
+  // source, which is the common case for listeners with many filter chains, it is also kept in
+  // any_source_filter_chain_, so that finding it takes neither the source address nor a trie.
+  struct SourceTypesMatch {
+    SourceTypesArray source_types_;
+    const Network::FilterChain* any_source_filter_chain_{};
+  };
+  using ApplicationProtocolsMap = absl::flat_hash_map<std::string, SourceTypesMatch>;
   using TransportProtocolsMap = absl::flat_hash_map<std::string, ApplicationProtocolsMap>;
   // Both exact server names and wildcard domains are part of the same map, in which wildcard
   // domains are prefixed with "." (i.e. ".example.com" for "*.example.com") to differentiate
@@ -254,7 +263,7 @@ private:
       const absl::Span<const Protobuf::uint32> source_ports,
       const Network::FilterChainSharedPtr& filter_chain);
   void addFilterChainForSourceTypes(
-      SourceTypesArray& source_types_array,
+      SourceTypesMatch& source_types_match,
       const envoy::config::listener::v3::FilterChainMatch::ConnectionSourceType source_type,
       const std::vector<std::string>& source_ips,
       const absl::Span<const Protobuf::uint32> source_ports,
@@ -279,7 +288,7 @@ private:
   findFilterChainForApplicationProtocols(const ApplicationProtocolsMap& application_protocols_map,
                                          const Network::ConnectionSocket& socket) const;
   const Network::FilterChain*
-  findFilterChainForSourceTypes(const SourceTypesArray& source_types,
+  findFilterChainForSourceTypes(const SourceTypesMatch& source_types_match,
                                 const Network::ConnectionSocket& socket) const;
 
   const Network::FilterChain*
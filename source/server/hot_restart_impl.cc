@@ -135,6 +135,21 @@ HotRestartImpl::mergeParentStatsIfAny(Stats::StoreRoot& stats_store) {
   return response;
 }
 
+absl::optional<Ssl::SessionResumptionState> HotRestartImpl::getParentSessionResumptionState() {
+  std::unique_ptr<envoy::HotRestartMessage> wrapper_msg =
+      as_child_.getParentSessionResumptionState();
+  if (!wrapper_msg) {
+    return absl::nullopt;
+  }
+  const auto& state_proto = wrapper_msg->reply().session_resumption_state();
+  Ssl::SessionResumptionState state;
+  state.sessions_.assign(state_proto.sessions().begin(), state_proto.sessions().end());
+  state.ticket_keys_.assign(state_proto.ticket_keys().begin(), state_proto.ticket_keys().end());
+  state.ticket_key_created_ =
+      SystemTime(std::chrono::seconds(state_proto.ticket_key_created_unix_seconds()));
+  return state;
+}
+
 void HotRestartImpl::shutdown() { as_parent_.shutdown(); }
 
 std::string HotRestartImpl::version() { return hotRestartVersion(); }
@@ -22,6 +22,9 @@ public:
   void sendParentAdminShutdownRequest(time_t&) override {}
   void sendParentTerminateRequest() override {}
   ServerStatsFromParent mergeParentStatsIfAny(Stats::StoreRoot&) override { return {}; }
+  absl::optional<Ssl::SessionResumptionState> getParentSessionResumptionState() override {
+    return absl::nullopt;
+  }
   void shutdown() override {}
   std::string version() override { return "disabled"; }
   Thread::BasicLockable& logLock() override { return log_lock_; }
@@ -47,6 +47,24 @@ std::unique_ptr<HotRestartMessage> HotRestartingChild::getParentStats() {
   return wrapped_reply;
 }
 
+std::unique_ptr<HotRestartMessage> HotRestartingChild::getParentSessionResumptionState() {
+  if (restart_epoch_ == 0 || parent_terminated_) {
+    return nullptr;
+  }
+
+  HotRestartMessage wrapped_request;
+  wrapped_request.mutable_request()->mutable_session_resumption_state();
+  sendHotRestartMessage(parent_address_, wrapped_request);
+
+  std::unique_ptr<HotRestartMessage> wrapped_reply = receiveHotRestartMessage(Blocking::Yes);
+  if (!replyIsExpectedType(wrapped_reply.get(),
+                           HotRestartMessage::Reply::kSessionResumptionState)) {
+    // An older parent doesn't know about the request; start with empty state.
+    return nullptr;
+  }
+  return wrapped_reply;
+}
+
 void HotRestartingChild::drainParentListeners() {
   if (restart_epoch_ == 0 || parent_terminated_) {
     return;
@@ -16,6 +16,7 @@ public:
 
   int duplicateParentListenSocket(const std::string& address);
   std::unique_ptr<envoy::HotRestartMessage> getParentStats();
+  std::unique_ptr<envoy::HotRestartMessage> getParentSessionResumptionState();
   void drainParentListeners();
   void sendParentAdminShutdownRequest(time_t& original_start_time);
   void sendParentTerminateRequest();
@@ -60,6 +60,14 @@ void HotRestartingParent::onSocketEvent() {
       break;
     }
 
+    case HotRestartMessage::Request::kSessionResumptionState: {
+      HotRestartMessage wrapped_reply;
+      internal_->exportSessionResumptionStateToChild(
+          wrapped_reply.mutable_reply()->mutable_session_resumption_state());
+      sendHotRestartMessage(child_address_, wrapped_reply);
+      break;
+    }
+
     case HotRestartMessage::Request::kDrainListeners: {
       internal_->drainListeners();
       break;
@@ -180,5 +188,21 @@ void HotRestartingParent::Internal::recordDynamics(HotRestartMessage::Reply::Sta
 
 void HotRestartingParent::Internal::drainListeners() { server_->drainListeners(); }
 
+void HotRestartingParent::Internal::exportSessionResumptionStateToChild(
+    HotRestartMessage::Reply::SessionResumptionState* state) {
+  const Ssl::SessionResumptionState exported =
+      server_->sslContextManager().exportSessionResumptionState();
+  for (const std::string& session : exported.sessions_) {
+    state->add_sessions(session);
+  }
+  for (const std::string& key : exported.ticket_keys_) {
+    state->add_ticket_keys(key);
+  }
+  state->set_ticket_key_created_unix_seconds(
+      std::chrono::duration_cast<std::chrono::seconds>(
+          exported.ticket_key_created_.time_since_epoch())
+          .count());
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -33,6 +33,9 @@ public:
     void recordDynamics(envoy::HotRestartMessage::Reply::Stats* stats, const std::string& name,
                         Stats::StatName stat_name);
     void drainListeners();
+    // 'state' is a field in the reply protobuf to be sent to the child, which we should populate.
+    void exportSessionResumptionStateToChild(
+        envoy::HotRestartMessage::Reply::SessionResumptionState* state);
 
   private:
     Server::Instance* const server_{};
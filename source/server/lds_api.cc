@@ -14,8 +14,10 @@
 #include "common/common/assert.h"
 #include "common/common/cleanup.h"
 #include "common/config/api_version.h"
+#include "common/config/parallel_decoder.h"
 #include "common/config/utility.h"
 #include "common/protobuf/utility.h"
+#include "common/stats/timespan_impl.h"
 
 #include "absl/strings/str_join.h"
 
@@ -25,12 +27,17 @@ namespace Server {
 LdsApiImpl::LdsApiImpl(const envoy::config::core::v3::ConfigSource& lds_config,
                        Upstream::ClusterManager& cm, Init::Manager& init_manager,
                        Stats::Scope& scope, ListenerManager& lm,
-                       ProtobufMessage::ValidationVisitor& validation_visitor)
+                       ProtobufMessage::ValidationVisitor& validation_visitor, Api::Api& api,
+                       uint32_t decode_threads)
     : Envoy::Config::SubscriptionBase<envoy::config::listener::v3::Listener>(
           lds_config.resource_api_version()),
-      listener_manager_(lm), scope_(scope.createScope("listener_manager.lds.")), cm_(cm),
+      listener_manager_(lm), scope_(scope.createScope("listener_manager.lds.")),
+      stats_({ALL_LDS_STATS(POOL_HISTOGRAM(*scope_))}), time_source_(api.timeSource()), cm_(cm),
       init_target_("LDS", [this]() { subscription_->start({}); }),
       validation_visitor_(validation_visitor) {
+  if (decode_threads > 0) {
+    decode_pool_ = std::make_unique<Config::DecodeThreadPool>(api.threadFactory(), decode_threads);
+  }
   const auto resource_name = getResourceName();
   subscription_ = cm.subscriptionFactory().subscriptionFromConfigSource(
       lds_config, Grpc::Common::typeUrl(resource_name), *scope_, *this);
@@ -41,6 +48,20 @@ void LdsApiImpl::onConfigUpdate(
     const Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource>& added_resources,
     const Protobuf::RepeatedPtrField<std::string>& removed_resources,
     const std::string& system_version_info) {
+  Stats::HistogramCompletableTimespanImpl decode_timespan(stats_.update_decode_time_, time_source_);
+  const std::vector<DecodedListener> listeners =
+      Config::ParallelDecoder::decodeResources<envoy::config::listener::v3::Listener>(
+          decode_pool_.get(), added_resources);
+  decode_timespan.complete();
+
+  applyUpdate(added_resources, listeners, removed_resources, system_version_info);
+}
+
+void LdsApiImpl::applyUpdate(
+    const Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource>& added_resources,
+    const std::vector<DecodedListener>& added_listeners,
+    const Protobuf::RepeatedPtrField<std::string>& removed_resources,
+    const std::string& system_version_info) {
   std::unique_ptr<Cleanup> maybe_eds_resume;
   if (cm_.adsMux()) {
     const auto type_url = Config::getTypeUrl<envoy::config::route::v3::RouteConfiguration>(
@@ -50,6 +71,7 @@ void LdsApiImpl::onConfigUpdate(
         std::make_unique<Cleanup>([this, type_url] { cm_.adsMux()->resume(type_url); });
   }
 
+  Stats::HistogramCompletableTimespanImpl apply_timespan(stats_.update_apply_time_, time_source_);
   bool any_applied = false;
   listener_manager_.beginListenerUpdate();
 
@@ -65,11 +87,14 @@ void LdsApiImpl::onConfigUpdate(
   ListenerManager::FailureStates failure_state;
   std::unordered_set<std::string> listener_names;
   std::string message;
-  for (const auto& resource : added_resources) {
-    envoy::config::listener::v3::Listener listener;
+  for (int i = 0; i < added_resources.size(); i++) {
+    const auto& resource = added_resources[i];
+    std::string listener_name;
     try {
-      listener = MessageUtil::anyConvertAndValidate<envoy::config::listener::v3::Listener>(
-          resource.resource(), validation_visitor_);
+      // Only the checks depending on the runtime and the validation visitor are left to do here.
+      Config::ParallelDecoder::checkResource(added_listeners[i], validation_visitor_);
+      const envoy::config::listener::v3::Listener& listener = added_listeners[i].message_;
+      listener_name = listener.name();
       if (!listener_names.insert(listener.name()).second) {
         // NOTE: at this point, the first of these duplicates has already been successfully applied.
         throw EnvoyException(fmt::format("duplicate listener {} found", listener.name()));
@@ -85,10 +110,11 @@ void LdsApiImpl::onConfigUpdate(
       auto& state = failure_state.back();
       state->set_details(e.what());
       state->mutable_failed_configuration()->PackFrom(resource);
-      absl::StrAppend(&message, listener.name(), ": ", e.what(), "\n");
+      absl::StrAppend(&message, listener_name, ": ", e.what(), "\n");
     }
   }
   listener_manager_.endListenerUpdate(std::move(failure_state));
+  apply_timespan.complete();
 
   if (any_applied) {
     system_version_info_ = system_version_info;
@@ -101,6 +127,12 @@ void LdsApiImpl::onConfigUpdate(
 
 void LdsApiImpl::onConfigUpdate(const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources,
                                 const std::string& version_info) {
+  Stats::HistogramCompletableTimespanImpl decode_timespan(stats_.update_decode_time_, time_source_);
+  const std::vector<DecodedListener> listeners =
+      Config::ParallelDecoder::decodeResources<envoy::config::listener::v3::Listener>(
+          decode_pool_.get(), resources);
+  decode_timespan.complete();
+
   // We need to keep track of which listeners need to remove.
   // Specifically, it's [listeners we currently have] - [listeners found in the response].
   std::unordered_set<std::string> listeners_to_remove;
@@ -109,15 +141,16 @@ void LdsApiImpl::onConfigUpdate(const Protobuf::RepeatedPtrField<ProtobufWkt::An
   }
 
   Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource> to_add_repeated;
-  for (const auto& listener_blob : resources) {
+  for (int i = 0; i < resources.size(); i++) {
+    if (listeners[i].unpack_error_.has_value()) {
+      throw EnvoyException(listeners[i].unpack_error_.value());
+    }
     // Add this resource to our delta added/updated pile...
     envoy::service::discovery::v3::Resource* to_add = to_add_repeated.Add();
-    // No validation needed here the overloaded call to onConfigUpdate validates.
-    const std::string listener_name =
-        MessageUtil::anyConvert<envoy::config::listener::v3::Listener>(listener_blob).name();
+    const std::string& listener_name = listeners[i].message_.name();
     to_add->set_name(listener_name);
     to_add->set_version(version_info);
-    to_add->mutable_resource()->MergeFrom(listener_blob);
+    to_add->mutable_resource()->MergeFrom(resources[i]);
     // ...and remove its name from our delta removed pile.
     listeners_to_remove.erase(listener_name);
   }
@@ -127,7 +160,7 @@ void LdsApiImpl::onConfigUpdate(const Protobuf::RepeatedPtrField<ProtobufWkt::An
   for (const auto& listener : listeners_to_remove) {
     *to_remove_repeated.Add() = listener;
   }
-  onConfigUpdate(to_add_repeated, to_remove_repeated, version_info);
+  applyUpdate(to_add_repeated, listeners, to_remove_repeated, version_info);
 }
 
 void LdsApiImpl::onConfigUpdateFailed(Envoy::Config::ConfigUpdateFailureReason reason,
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <functional>
+#include <string>
+#include <vector>
 
+#include "envoy/api/api.h"
+#include "envoy/common/time.h"
 #include "envoy/config/core/v3/config_source.pb.h"
 #include "envoy/config/listener/v3/listener.pb.h"
 #include "envoy/config/subscription.h"
@@ -10,14 +14,30 @@
 #include "envoy/server/listener_manager.h"
 #include "envoy/service/discovery/v3/discovery.pb.h"
 #include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
 
 #include "common/common/logger.h"
+#include "common/config/parallel_decoder.h"
 #include "common/config/subscription_base.h"
 #include "common/init/target_impl.h"
 
 namespace Envoy {
 namespace Server {
 
+/**
+ * All LDS stats. @see stats_macros.h
+ */
+#define ALL_LDS_STATS(HISTOGRAM)                                                                   \
+  HISTOGRAM(update_decode_time, Milliseconds)                                                      \
+  HISTOGRAM(update_apply_time, Milliseconds)
+
+/**
+ * Struct definition for all LDS stats. @see stats_macros.h
+ */
+struct LdsStats {
+  ALL_LDS_STATS(GENERATE_HISTOGRAM_STRUCT)
+};
+
 /**
  * LDS API implementation that fetches via Subscription.
  */
@@ -27,7 +47,8 @@ class LdsApiImpl : public LdsApi,
 public:
   LdsApiImpl(const envoy::config::core::v3::ConfigSource& lds_config, Upstream::ClusterManager& cm,
              Init::Manager& init_manager, Stats::Scope& scope, ListenerManager& lm,
-             ProtobufMessage::ValidationVisitor& validation_visitor);
+             ProtobufMessage::ValidationVisitor& validation_visitor, Api::Api& api,
+             uint32_t decode_threads);
 
   // Server::LdsApi
   std::string versionInfo() const override { return system_version_info_; }
@@ -46,13 +67,25 @@ private:
     return MessageUtil::anyConvert<envoy::config::listener::v3::Listener>(resource).name();
   }
 
+  using DecodedListener = Config::DecodedResource<envoy::config::listener::v3::Listener>;
+
+  void applyUpdate(
+      const Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource>& added_resources,
+      const std::vector<DecodedListener>& added_listeners,
+      const Protobuf::RepeatedPtrField<std::string>& removed_resources,
+      const std::string& system_version_info);
+
   std::unique_ptr<Config::Subscription> subscription_;
   std::string system_version_info_;
   ListenerManager& listener_manager_;
   Stats::ScopePtr scope_;
+  LdsStats stats_;
+  TimeSource& time_source_;
   Upstream::ClusterManager& cm_;
   Init::TargetImpl init_target_;
   ProtobufMessage::ValidationVisitor& validation_visitor_;
+  // Decodes the resources of large updates in parallel, nullptr if they are decoded serially.
+  Config::DecodeThreadPoolPtr decode_pool_;
 };
 
 } // namespace Server
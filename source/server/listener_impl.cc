@@ -431,12 +431,19 @@ void ListenerImpl::buildFilterChains() {
 
 void ListenerImpl::buildSocketOptions() {
   // TCP specific setup.
-  if (config_.has_connection_balance_config()) {
-    // Currently exact balance is the only supported type and there are no options.
-    ASSERT(config_.connection_balance_config().has_exact_balance());
+  switch (config_.connection_balance_config().balance_type_case()) {
+  case envoy::config::listener::v3::Listener::ConnectionBalanceConfig::kExactBalance:
     connection_balancer_ = std::make_unique<Network::ExactConnectionBalancerImpl>();
-  } else {
+    break;
+  case envoy::config::listener::v3::Listener::ConnectionBalanceConfig::kLoadAwareBalance:
+    connection_balancer_ = std::make_unique<Network::LoadAwareConnectionBalancerImpl>(
+        parent_.server_.timeSource(),
+        std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
+            config_.connection_balance_config().load_aware_balance(), sample_interval, 1000)));
+    break;
+  case envoy::config::listener::v3::Listener::ConnectionBalanceConfig::BALANCE_TYPE_NOT_SET:
     connection_balancer_ = std::make_unique<Network::NopConnectionBalancerImpl>();
+    break;
   }
 
   if (config_.has_tcp_fast_open_queue_length()) {
@@ -67,10 +67,12 @@ public:
   createListenerFilterMatcher(const envoy::config::listener::v3::ListenerFilter& listener_filter);
 
   // Server::ListenerComponentFactory
-  LdsApiPtr createLdsApi(const envoy::config::core::v3::ConfigSource& lds_config) override {
+  LdsApiPtr createLdsApi(const envoy::config::core::v3::ConfigSource& lds_config,
+                         uint32_t decode_threads) override {
     return std::make_unique<LdsApiImpl>(
         lds_config, server_.clusterManager(), server_.initManager(), server_.stats(),
-        server_.listenerManager(), server_.messageValidationContext().dynamicValidationVisitor());
+        server_.listenerManager(), server_.messageValidationContext().dynamicValidationVisitor(),
+        server_.api(), decode_threads);
   }
   std::vector<Network::FilterFactoryCb> createNetworkFilterFactoryList(
       const Protobuf::RepeatedPtrField<envoy::config::listener::v3::Filter>& filters,
@@ -182,9 +184,10 @@ public:
   // Server::ListenerManager
   bool addOrUpdateListener(const envoy::config::listener::v3::Listener& config,
                            const std::string& version_info, bool added_via_api) override;
-  void createLdsApi(const envoy::config::core::v3::ConfigSource& lds_config) override {
+  void createLdsApi(const envoy::config::core::v3::ConfigSource& lds_config,
+                    uint32_t decode_threads) override {
     ASSERT(lds_api_ == nullptr);
-    lds_api_ = factory_.createLdsApi(lds_config);
+    lds_api_ = factory_.createLdsApi(lds_config, decode_threads);
   }
   std::vector<std::reference_wrapper<Network::ListenerConfig>> listeners() override;
   uint64_t numConnections() const override;
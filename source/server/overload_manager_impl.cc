@@ -1,5 +1,7 @@
 #include "server/overload_manager_impl.h"
 
+#include <algorithm>
+
 #include "envoy/config/overload/v3/overload.pb.h"
 #include "envoy/stats/scope.h"
 
@@ -28,13 +30,45 @@ public:
     return fired != isFired();
   }
 
-  bool isFired() const override { return value_.has_value() && value_ >= threshold_; }
+  double scale() const override { return isFired() ? 1 : 0; }
 
 private:
+  bool isFired() const { return value_.has_value() && value_ >= threshold_; }
+
   const double threshold_;
   absl::optional<double> value_;
 };
 
+class ScaledTriggerImpl : public OverloadAction::Trigger {
+public:
+  ScaledTriggerImpl(const envoy::config::overload::v3::ScaledTrigger& config)
+      : scaling_threshold_(config.scaling_threshold()),
+        saturation_threshold_(config.saturation_threshold()) {
+    if (scaling_threshold_ >= saturation_threshold_) {
+      throw EnvoyException("scaling_threshold must be less than saturation_threshold");
+    }
+  }
+
+  bool updateValue(double value) override {
+    const double scale = scale_;
+    if (value <= scaling_threshold_) {
+      scale_ = 0;
+    } else if (value >= saturation_threshold_) {
+      scale_ = 1;
+    } else {
+      scale_ = (value - scaling_threshold_) / (saturation_threshold_ - scaling_threshold_);
+    }
+    return scale != scale_;
+  }
+
+  double scale() const override { return scale_; }
+
+private:
+  const double scaling_threshold_;
+  const double saturation_threshold_;
+  double scale_{0};
+};
+
 Stats::Counter& makeCounter(Stats::Scope& scope, absl::string_view a, absl::string_view b) {
   Stats::StatNameManagedStorage stat_name(absl::StrCat("overload.", a, ".", b),
                                           scope.symbolTable());
@@ -53,7 +87,9 @@ Stats::Gauge& makeGauge(Stats::Scope& scope, absl::string_view a, absl::string_v
 OverloadAction::OverloadAction(const envoy::config::overload::v3::OverloadAction& config,
                                Stats::Scope& stats_scope)
     : active_gauge_(
-          makeGauge(stats_scope, config.name(), "active", Stats::Gauge::ImportMode::Accumulate)) {
+          makeGauge(stats_scope, config.name(), "active", Stats::Gauge::ImportMode::Accumulate)),
+      scale_percent_gauge_(makeGauge(stats_scope, config.name(), "scale_percent",
+                                     Stats::Gauge::ImportMode::NeverImport)) {
   for (const auto& trigger_config : config.triggers()) {
     TriggerPtr trigger;
 
@@ -61,6 +97,9 @@ OverloadAction::OverloadAction(const envoy::config::overload::v3::OverloadAction
     case envoy::config::overload::v3::Trigger::TriggerOneofCase::kThreshold:
       trigger = std::make_unique<ThresholdTriggerImpl>(trigger_config.threshold());
       break;
+    case envoy::config::overload::v3::Trigger::TriggerOneofCase::kScaled:
+      trigger = std::make_unique<ScaledTriggerImpl>(trigger_config.scaled());
+      break;
     default:
       NOT_REACHED_GCOVR_EXCL_LINE;
     }
@@ -72,29 +111,27 @@ OverloadAction::OverloadAction(const envoy::config::overload::v3::OverloadAction
   }
 
   active_gauge_.set(0);
+  scale_percent_gauge_.set(0);
 }
 
 bool OverloadAction::updateResourcePressure(const std::string& name, double pressure) {
-  const bool active = isActive();
-
   auto it = triggers_.find(name);
   ASSERT(it != triggers_.end());
-  if (it->second->updateValue(pressure)) {
-    if (it->second->isFired()) {
-      active_gauge_.set(1);
-      const auto result = fired_triggers_.insert(name);
-      ASSERT(result.second);
-    } else {
-      active_gauge_.set(0);
-      const auto result = fired_triggers_.erase(name);
-      ASSERT(result == 1);
-    }
+  if (!it->second->updateValue(pressure)) {
+    return false;
   }
 
-  return active != isActive();
+  const double scale = scale_;
+  scale_ = 0;
+  for (const auto& trigger : triggers_) {
+    scale_ = std::max(scale_, trigger.second->scale());
+  }
+  active_gauge_.set(isActive() ? 1 : 0);
+  scale_percent_gauge_.set(scale_ * 100); // convert to percent
+  return scale != scale_;
 }
 
-bool OverloadAction::isActive() const { return !fired_triggers_.empty(); }
+bool OverloadAction::isActive() const { return scale_ >= 1; }
 
 OverloadManagerImpl::OverloadManagerImpl(Event::Dispatcher& dispatcher, Stats::Scope& stats_scope,
                                          ThreadLocal::SlotAllocator& slot_allocator,
@@ -104,7 +141,8 @@ OverloadManagerImpl::OverloadManagerImpl(Event::Dispatcher& dispatcher, Stats::S
     : started_(false), dispatcher_(dispatcher), tls_(slot_allocator.allocateSlot()),
       refresh_interval_(
           std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(config, refresh_interval, 1000))) {
-  Configuration::ResourceMonitorFactoryContextImpl context(dispatcher, api, validation_visitor);
+  Configuration::ResourceMonitorFactoryContextImpl context(dispatcher, slot_allocator, api,
+                                                           validation_visitor);
   for (const auto& resource : config.resource_monitors()) {
     const auto& name = resource.name();
     ENVOY_LOG(debug, "Adding resource monitor for {}", name);
@@ -201,15 +239,23 @@ void OverloadManagerImpl::updateResourcePressure(const std::string& resource, do
                   const std::string& action = entry.second;
                   auto action_it = actions_.find(action);
                   ASSERT(action_it != actions_.end());
-                  if (action_it->second.updateResourcePressure(resource, pressure)) {
-                    const bool is_active = action_it->second.isActive();
-                    const auto state =
-                        is_active ? OverloadActionState::Active : OverloadActionState::Inactive;
+                  const bool was_active = action_it->second.isActive();
+                  if (!action_it->second.updateResourcePressure(resource, pressure)) {
+                    return;
+                  }
+
+                  const bool is_active = action_it->second.isActive();
+                  const auto state =
+                      is_active ? OverloadActionState::Active : OverloadActionState::Inactive;
+                  const double scale = action_it->second.scale();
+                  tls_->runOnAllThreads([this, action, state, scale] {
+                    auto& overload_state = tls_->getTyped<ThreadLocalOverloadState>();
+                    overload_state.setState(action, state);
+                    overload_state.setScale(action, scale);
+                  });
+                  if (was_active != is_active) {
                     ENVOY_LOG(info, "Overload action {} became {}", action,
                               is_active ? "active" : "inactive");
-                    tls_->runOnAllThreads([this, action, state] {
-                      tls_->getTyped<ThreadLocalOverloadState>().setState(action, state);
-                    });
                     auto callback_range = action_to_callbacks_.equal_range(action);
                     std::for_each(callback_range.first, callback_range.second,
                                   [&](ActionToCallbackMap::value_type& cb_entry) {
@@ -2,7 +2,6 @@
 
 #include <chrono>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "envoy/api/api.h"
@@ -25,29 +24,34 @@ public:
   OverloadAction(const envoy::config::overload::v3::OverloadAction& config,
                  Stats::Scope& stats_scope);
 
-  // Updates the current pressure for the given resource and returns whether the action
-  // has changed state.
+  // Updates the current pressure for the given resource and returns whether the scale of the
+  // action has changed.
   bool updateResourcePressure(const std::string& name, double pressure);
 
-  // Returns whether the action is currently active or not.
+  // Returns whether the action is currently active, or saturated, or not.
   bool isActive() const;
 
+  // Returns the current scale of the action, between 0 when inactive and 1 when active.
+  double scale() const { return scale_; }
+
   class Trigger {
   public:
     virtual ~Trigger() = default;
 
-    // Updates the current value of the metric and returns whether the trigger has changed state.
+    // Updates the current value of the metric and returns whether the scale of the trigger has
+    // changed.
     virtual bool updateValue(double value) PURE;
 
-    // Returns whether the trigger is currently fired or not.
-    virtual bool isFired() const PURE;
+    // Returns the current scale of the trigger, between 0 when not fired and 1 when fired.
+    virtual double scale() const PURE;
   };
   using TriggerPtr = std::unique_ptr<Trigger>;
 
 private:
   std::unordered_map<std::string, TriggerPtr> triggers_;
-  std::unordered_set<std::string> fired_triggers_;
+  double scale_{0};
   Stats::Gauge& active_gauge_;
+  Stats::Gauge& scale_percent_gauge_;
 };
 
 class OverloadManagerImpl : Logger::Loggable<Logger::Id::main>, public OverloadManager {
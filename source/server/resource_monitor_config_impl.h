@@ -8,12 +8,16 @@ namespace Configuration {
 
 class ResourceMonitorFactoryContextImpl : public ResourceMonitorFactoryContext {
 public:
-  ResourceMonitorFactoryContextImpl(Event::Dispatcher& dispatcher, Api::Api& api,
+  ResourceMonitorFactoryContextImpl(Event::Dispatcher& dispatcher,
+                                    ThreadLocal::SlotAllocator& thread_local, Api::Api& api,
                                     ProtobufMessage::ValidationVisitor& validation_visitor)
-      : dispatcher_(dispatcher), api_(api), validation_visitor_(validation_visitor) {}
+      : dispatcher_(dispatcher), thread_local_(thread_local), api_(api),
+        validation_visitor_(validation_visitor) {}
 
   Event::Dispatcher& dispatcher() override { return dispatcher_; }
 
+  ThreadLocal::SlotAllocator& threadLocal() override { return thread_local_; }
+
   Api::Api& api() override { return api_; }
 
   ProtobufMessage::ValidationVisitor& messageValidationVisitor() override {
@@ -22,6 +26,7 @@ public:
 
 private:
   Event::Dispatcher& dispatcher_;
+  ThreadLocal::SlotAllocator& thread_local_;
   Api::Api& api_;
   ProtobufMessage::ValidationVisitor& validation_visitor_;
 };
@@ -33,6 +33,7 @@
 #include "common/local_info/local_info_impl.h"
 #include "common/memory/stats.h"
 #include "common/network/address_impl.h"
+#include "common/network/caching_dns_resolver.h"
 #include "common/protobuf/utility.h"
 #include "common/router/rds_impl.h"
 #include "common/runtime/runtime_impl.h"
@@ -248,6 +249,34 @@ void loadBootsrap(absl::optional<uint32_t> bootstrap_version,
     throw EnvoyException(fmt::format("Unknown bootstrap version {}.", *bootstrap_version));
   }
 }
+
+// Creates the DNS resolver shared by the clusters, caching its lookups if configured to.
+Network::DnsResolverSharedPtr
+createDnsResolver(const envoy::config::bootstrap::v3::Bootstrap& bootstrap,
+                  Event::Dispatcher& dispatcher, Stats::Scope& scope) {
+  const bool use_tcp_for_dns_lookups = bootstrap.use_tcp_for_dns_lookups();
+  if (!bootstrap.has_caching_dns_resolver()) {
+    return dispatcher.createDnsResolver({}, use_tcp_for_dns_lookups);
+  }
+
+  const auto& caching_dns_resolver = bootstrap.caching_dns_resolver();
+  // Each resolver has its own c-ares channel.
+  std::vector<Network::DnsResolverSharedPtr> channels;
+  const uint32_t channel_count = PROTOBUF_GET_WRAPPED_OR_DEFAULT(caching_dns_resolver, channels, 1);
+  for (uint32_t i = 0; i < channel_count; ++i) {
+    channels.push_back(dispatcher.createDnsResolver({}, use_tcp_for_dns_lookups));
+  }
+  Network::CachingDnsResolverConfig config;
+  config.min_ttl_ = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::milliseconds(
+      PROTOBUF_GET_MS_OR_DEFAULT(caching_dns_resolver, min_ttl, 0)));
+  config.max_ttl_ = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::milliseconds(
+      PROTOBUF_GET_MS_OR_DEFAULT(caching_dns_resolver, max_ttl, 300000)));
+  config.negative_ttl_ = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::milliseconds(
+      PROTOBUF_GET_MS_OR_DEFAULT(caching_dns_resolver, negative_ttl, 5000)));
+  config.max_entries_ = PROTOBUF_GET_WRAPPED_OR_DEFAULT(caching_dns_resolver, max_entries, 4096);
+  return std::make_shared<Network::CachingDnsResolverImpl>(
+      std::move(channels), dispatcher.timeSource(), config, scope);
+}
 } // namespace
 
 void InstanceUtil::loadBootstrapConfig(envoy::config::bootstrap::v3::Bootstrap& bootstrap,
@@ -440,9 +469,15 @@ void InstanceImpl::initialize(const Options& options,
 
   // Once we have runtime we can initialize the SSL context manager.
   ssl_context_manager_ = createContextManager("ssl_context_manager", time_source_);
+  // Pick up the parent's TLS sessions and ticket keys before any server context is created, so
+  // that clients can keep resuming their sessions across the hot restart.
+  absl::optional<Ssl::SessionResumptionState> parent_session_resumption_state =
+      restarter_.getParentSessionResumptionState();
+  if (parent_session_resumption_state.has_value()) {
+    ssl_context_manager_->importSessionResumptionState(parent_session_resumption_state.value());
+  }
 
-  const bool use_tcp_for_dns_lookups = bootstrap_.use_tcp_for_dns_lookups();
-  dns_resolver_ = dispatcher_->createDnsResolver({}, use_tcp_for_dns_lookups);
+  dns_resolver_ = createDnsResolver(bootstrap_, *dispatcher_, stats_store_);
 
   cluster_manager_factory_ = std::make_unique<Upstream::ProdClusterManagerFactory>(
       *admin_, Runtime::LoaderSingleton::get(), stats_store_, thread_local_, *random_generator_,
@@ -459,7 +494,10 @@ void InstanceImpl::initialize(const Options& options,
   // Instruct the listener manager to create the LDS provider if needed. This must be done later
   // because various items do not yet exist when the listener manager is created.
   if (bootstrap_.dynamic_resources().has_lds_config()) {
-    listener_manager_->createLdsApi(bootstrap_.dynamic_resources().lds_config());
+    const auto& dynamic_resources = bootstrap_.dynamic_resources();
+    listener_manager_->createLdsApi(
+        dynamic_resources.lds_config(),
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(dynamic_resources, resource_decode_threads, 0));
   }
 
   // We have to defer RTDS initialization until after the cluster manager is
@@ -31,6 +31,10 @@ class SslContextManagerNoTlsStub final : public Envoy::Ssl::ContextManager {
 
   Ssl::PrivateKeyMethodManager& privateKeyMethodManager() override { throwException(); }
 
+  Ssl::SessionResumptionState exportSessionResumptionState() const override { return {}; }
+
+  void importSessionResumptionState(const Ssl::SessionResumptionState&) override {}
+
 private:
   [[noreturn]] void throwException() {
     throw EnvoyException("SSL is not supported in this configuration");
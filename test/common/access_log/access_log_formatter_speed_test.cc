@@ -102,4 +102,27 @@ static void BM_TypedJsonAccessLogFormatter(benchmark::State& state) {
 }
 BENCHMARK(BM_TypedJsonAccessLogFormatter);
 
+// Formats into a buffer reused across log lines, as the file access log does.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_TypedJsonAccessLogFormatterReusedBuffer(benchmark::State& state) {
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeStreamInfo();
+  std::unique_ptr<Envoy::AccessLog::JsonFormatterImpl> typed_json_formatter =
+      makeJsonFormatter(true);
+
+  size_t output_bytes = 0;
+  Http::TestRequestHeaderMapImpl request_headers;
+  Http::TestResponseHeaderMapImpl response_headers;
+  Http::TestResponseTrailerMapImpl response_trailers;
+  std::string body;
+  std::string log_line;
+  for (auto _ : state) {
+    log_line.clear();
+    typed_json_formatter->formatTo(request_headers, response_headers, response_trailers,
+                                   *stream_info, body, log_line);
+    output_bytes += log_line.length();
+  }
+  benchmark::DoNotOptimize(output_bytes);
+}
+BENCHMARK(BM_TypedJsonAccessLogFormatterReusedBuffer);
+
 } // namespace Envoy
@@ -1882,6 +1882,104 @@ TEST(AccessLogFormatterTest, JsonFormatterTypedTest) {
   EXPECT_THAT(output.fields().at("filter_state"), ProtoEq(expected));
 }
 
+TEST(AccessLogFormatterTest, JsonFormatterEscapingTest) {
+  Http::TestRequestHeaderMapImpl request_headers{{"x-quoted", "say \"hi\" <b>"},
+                                                 {"x-unicode", "caf\xc3\xa9 \xe2\x80\xa8"}};
+  Http::TestResponseHeaderMapImpl response_headers;
+  Http::TestResponseTrailerMapImpl response_trailers;
+  StreamInfo::MockStreamInfo stream_info;
+  std::string body;
+  EXPECT_CALL(Const(stream_info), lastDownstreamRxByteReceived())
+      .WillRepeatedly(Return(std::chrono::nanoseconds(5000000)));
+
+  absl::flat_hash_map<std::string, std::string> key_mapping = {
+      {"constant", "plain \"value\"\t"},
+      {"duration", "%REQUEST_DURATION%"},
+      {"quoted", "%REQ(x-quoted)%"},
+      {"unicode", "%REQ(x-unicode)%"},
+      {"with\nnewline", "%REQ(x-missing)%"},
+  };
+
+  {
+    JsonFormatterImpl formatter(key_mapping, false);
+    EXPECT_EQ("{\"constant\":\"plain \\\"value\\\"\\t\",\"duration\":\"5\","
+              "\"quoted\":\"say \\\"hi\\\" \\u003cb\\u003e\",\"unicode\":\"caf\xc3\xa9 \\u2028\","
+              "\"with\\nnewline\":\"-\"}\n",
+              formatter.format(request_headers, response_headers, response_trailers, stream_info,
+                               body));
+  }
+  {
+    JsonFormatterImpl formatter(key_mapping, true);
+    EXPECT_EQ("{\"constant\":\"plain \\\"value\\\"\\t\",\"duration\":5,"
+              "\"quoted\":\"say \\\"hi\\\" \\u003cb\\u003e\",\"unicode\":\"caf\xc3\xa9 \\u2028\","
+              "\"with\\nnewline\":null}\n",
+              formatter.format(request_headers, response_headers, response_trailers, stream_info,
+                               body));
+  }
+}
+
+TEST(AccessLogFormatterTest, JsonFormatterMatchesProtobufJson) {
+  for (int c = 1; c < 256; ++c) {
+    const std::string value = "a" + std::string(1, static_cast<char>(c)) + "b";
+    std::string output;
+    AccessLogJsonUtils::appendString(value, output);
+    EXPECT_EQ(MessageUtil::getJsonStringFromMessage(ValueUtil::stringValue(value), false, true),
+              output)
+        << c;
+  }
+
+  for (const double number : {0.0, -0.0, 1.0, 200.0, 0.5, -3.0, 1e14, 1e15, 1e20}) {
+    std::string output;
+    AccessLogJsonUtils::appendValue(ValueUtil::numberValue(number), output);
+    EXPECT_EQ(MessageUtil::getJsonStringFromMessage(ValueUtil::numberValue(number), false, true),
+              output)
+        << number;
+  }
+}
+
+// formatTo() of every command appends what format() returns.
+TEST(AccessLogFormatterTest, FormatToAppendsFormat) {
+  Http::TestRequestHeaderMapImpl request_headers{{":method", "GET"}, {"x-long", "0123456789"}};
+  Http::TestResponseHeaderMapImpl response_headers{{"grpc-status", "3"}};
+  Http::TestResponseTrailerMapImpl response_trailers{{"x-trailer", "value"}};
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  std::string body = "local reply";
+
+  const std::vector<std::string> formats = {"plain",
+                                            "%LOCAL_REPLY_BODY%",
+                                            "%REQ(:METHOD)%",
+                                            "%REQ(X-LONG):4%",
+                                            "%REQ(X-MISSING?:METHOD)%",
+                                            "%RESP(X-MISSING)%",
+                                            "%TRAILER(X-TRAILER)%",
+                                            "%GRPC_STATUS%",
+                                            "%PROTOCOL%",
+                                            "%RESPONSE_CODE%",
+                                            "%RESPONSE_CODE_DETAILS%",
+                                            "%BYTES_SENT%",
+                                            "%DURATION%",
+                                            "%RESPONSE_FLAGS%",
+                                            "%UPSTREAM_HOST%",
+                                            "%DOWNSTREAM_LOCAL_ADDRESS%",
+                                            "%DOWNSTREAM_LOCAL_ADDRESS_WITHOUT_PORT%",
+                                            "%DOWNSTREAM_LOCAL_PORT%",
+                                            "%DOWNSTREAM_TLS_VERSION%",
+                                            "%DYNAMIC_METADATA(com.test)%",
+                                            "%FILTER_STATE(missing)%",
+                                            "%START_TIME(%Y/%m/%d)%"};
+  for (const std::string& format : formats) {
+    for (const FormatterProviderPtr& provider : AccessLogFormatParser::parse(format)) {
+      std::string output = "prefix ";
+      provider->formatTo(request_headers, response_headers, response_trailers, stream_info, body,
+                         output);
+      EXPECT_EQ("prefix " + provider->format(request_headers, response_headers,
+                                             response_trailers, stream_info, body),
+                output)
+          << format;
+    }
+  }
+}
+
 TEST(AccessLogFormatterTest, CompositeFormatterSuccess) {
   StreamInfo::MockStreamInfo stream_info;
   Http::TestRequestHeaderMapImpl request_header{{"first", "GET"}, {":path", "/"}};
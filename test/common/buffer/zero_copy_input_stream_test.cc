@@ -82,6 +82,29 @@ TEST_F(ZeroCopyInputStreamTest, ByteCount) {
   EXPECT_EQ(4, stream_.ByteCount());
 }
 
+TEST_F(ZeroCopyInputStreamTest, Skip) {
+  Buffer::OwnedImpl buffer(std::string(1024, 'A') + "efgh");
+  stream_.move(buffer);
+
+  EXPECT_TRUE(stream_.Next(&data_, &size_));
+  stream_.BackUp(2);
+  // Skips the rest of the first slice and all but the last 4 bytes of the second one.
+  EXPECT_TRUE(stream_.Skip(1026));
+  EXPECT_EQ(1028, stream_.ByteCount());
+  EXPECT_TRUE(stream_.Next(&data_, &size_));
+  EXPECT_EQ("efgh", absl::string_view(static_cast<const char*>(data_), size_));
+
+  EXPECT_FALSE(stream_.Skip(1));
+  EXPECT_EQ(1032, stream_.ByteCount());
+}
+
+TEST_F(ZeroCopyInputStreamTest, SkipPastEnd) {
+  EXPECT_FALSE(stream_.Skip(5));
+  EXPECT_EQ(4, stream_.ByteCount());
+  stream_.finish();
+  EXPECT_FALSE(stream_.Next(&data_, &size_));
+}
+
 TEST_F(ZeroCopyInputStreamTest, Finish) {
   EXPECT_TRUE(stream_.Next(&data_, &size_));
   EXPECT_TRUE(stream_.Next(&data_, &size_));
@@ -77,6 +77,30 @@ static void BM_DateTimeFormatterWithoutSubseconds(benchmark::State& state) {
 }
 BENCHMARK(BM_DateTimeFormatterWithoutSubseconds);
 
+// Formats the same time with several formats, as an access log with several time fields does,
+// appending to the same buffer.
+static void BM_DateTimeFormatterMultipleFormats(benchmark::State& state) {
+  int outputBytes = 0;
+
+  Envoy::SystemTime time(std::chrono::seconds(1522796769));
+  std::mt19937 prng(1);
+  std::uniform_int_distribution<long> distribution(-10, 20);
+  const Envoy::DateFormatter date_formatters[] = {Envoy::DateFormatter("%Y-%m-%dT%H:%M:%S.%3fZ"),
+                                                  Envoy::DateFormatter("%s.%6f"),
+                                                  Envoy::DateFormatter("%d/%b/%Y:%H:%M:%S %z")};
+  std::string output;
+  for (auto _ : state) {
+    time += std::chrono::milliseconds(static_cast<int>(distribution(prng)));
+    output.clear();
+    for (const Envoy::DateFormatter& date_formatter : date_formatters) {
+      date_formatter.fromTimeTo(time, output);
+    }
+    outputBytes += output.length();
+  }
+  benchmark::DoNotOptimize(outputBytes);
+}
+BENCHMARK(BM_DateTimeFormatterMultipleFormats);
+
 static void BM_RTrimStringView(benchmark::State& state) {
   int accum = 0;
   for (auto _ : state) {
@@ -427,6 +427,13 @@ TEST(AccessLogDateTimeFormatter, fromTime) {
   EXPECT_EQ("2018-04-03T23:06:08.999Z", AccessLogDateTimeFormatter::fromTime(time4));
 }
 
+TEST(AccessLogDateTimeFormatter, fromTimeTo) {
+  std::string output = "time: ";
+  AccessLogDateTimeFormatter::fromTimeTo(SystemTime(std::chrono::milliseconds(1522796769123)),
+                                         output);
+  EXPECT_EQ("time: 2018-04-03T23:06:09.123Z", output);
+}
+
 TEST(Primes, isPrime) {
   EXPECT_TRUE(Primes::isPrime(67));
   EXPECT_FALSE(Primes::isPrime(49));
@@ -824,6 +831,30 @@ TEST(DateFormatter, FromTimeSameWildcard) {
             DateFormatter("%Y-%m-%dT%H:%M:%S.000Z%1f%2f").fromTime(time1));
 }
 
+TEST(DateFormatter, FromTimeTo) {
+  const SystemTime time(std::chrono::seconds(1522796769) + std::chrono::nanoseconds(123456789));
+  std::string output = "time: ";
+  DateFormatter("%Y-%m-%dT%H:%M:%S.%3f %s %f %1f%9f").fromTimeTo(time, output);
+  EXPECT_EQ("time: 2018-04-03T23:06:09.123 1522796769 123456789 1123456789", output);
+}
+
+// Formats used alternately keep their own formatted second, and only their subseconds are
+// formatted again within a second.
+TEST(DateFormatter, FromTimeInterleavedFormats) {
+  const DateFormatter with_millis("%H:%M:%S.%3f");
+  const DateFormatter with_seconds("%s.%6f");
+  for (int i = 0; i < 3; ++i) {
+    for (int millis = 5; millis < 1000; millis += 330) {
+      const SystemTime time(std::chrono::seconds(1522796770 + i) +
+                            std::chrono::milliseconds(millis));
+      EXPECT_EQ(absl::StrCat("23:06:", 10 + i, ".", millis < 10 ? "00" : "", millis),
+                with_millis.fromTime(time));
+      EXPECT_EQ(absl::StrCat(1522796770 + i, ".", millis < 10 ? "00" : "", millis, "000"),
+                with_seconds.fromTime(time));
+    }
+  }
+}
+
 TEST(TrieLookupTable, AddItems) {
   TrieLookupTable<const char*> trie;
   const char* cstr_a = "a";
@@ -0,0 +1,128 @@
+#include <atomic>
+#include <vector>
+
+#include "envoy/api/v2/cluster.pb.h"
+#include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/config/cluster/v3/cluster.pb.validate.h"
+#include "envoy/config/listener/v3/listener.pb.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "common/config/parallel_decoder.h"
+
+#include "test/mocks/protobuf/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Config {
+namespace {
+
+class DecodeThreadPoolTest : public testing::Test {
+protected:
+  // Run a few loops, checking that every iteration runs exactly once.
+  void runLoops(DecodeThreadPool& pool) {
+    for (size_t count : {0, 1, 2, 7, 1000}) {
+      std::vector<std::atomic<uint32_t>> runs(count);
+      pool.parallelFor(count, [&runs](size_t index) { runs[index]++; });
+      for (size_t index = 0; index < count; index++) {
+        EXPECT_EQ(1, runs[index]) << index;
+      }
+    }
+  }
+
+  Api::ApiPtr api_{Api::createApiForTest()};
+};
+
+TEST_F(DecodeThreadPoolTest, NoThreads) {
+  DecodeThreadPool pool(api_->threadFactory(), 0);
+  EXPECT_EQ(0, pool.threadCount());
+  runLoops(pool);
+}
+
+TEST_F(DecodeThreadPoolTest, Threads) {
+  DecodeThreadPool pool(api_->threadFactory(), 4);
+  EXPECT_EQ(4, pool.threadCount());
+  runLoops(pool);
+  runLoops(pool);
+}
+
+class ParallelDecoderTest : public testing::TestWithParam<uint32_t> {
+protected:
+  ParallelDecoderTest() {
+    if (GetParam() > 0) {
+      pool_ = std::make_unique<DecodeThreadPool>(api_->threadFactory(), GetParam());
+    }
+  }
+
+  Api::ApiPtr api_{Api::createApiForTest()};
+  DecodeThreadPoolPtr pool_;
+  testing::NiceMock<ProtobufMessage::MockValidationVisitor> validation_visitor_;
+};
+
+INSTANTIATE_TEST_SUITE_P(DecodeThreads, ParallelDecoderTest, testing::Values(0, 3));
+
+// Resources are decoded in order, and the errors of invalid resources are only thrown once
+// checked.
+TEST_P(ParallelDecoderTest, DecodeResources) {
+  Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource> resources;
+  for (int i = 0; i < 100; i++) {
+    auto* resource = resources.Add();
+    if (i == 10) {
+      // Not a cluster.
+      envoy::config::listener::v3::Listener listener;
+      listener.set_name("listener");
+      resource->mutable_resource()->PackFrom(listener);
+    } else if (i == 20) {
+      // A cluster without name does not satisfy its constraints.
+      resource->mutable_resource()->PackFrom(envoy::config::cluster::v3::Cluster());
+    } else if (i == 30) {
+      // Earlier versions are upgraded.
+      envoy::api::v2::Cluster cluster;
+      cluster.set_name("cluster_30");
+      resource->mutable_resource()->PackFrom(cluster);
+    } else {
+      envoy::config::cluster::v3::Cluster cluster;
+      cluster.set_name(absl::StrCat("cluster_", i));
+      resource->mutable_resource()->PackFrom(cluster);
+    }
+  }
+
+  const auto clusters =
+      ParallelDecoder::decodeResources<envoy::config::cluster::v3::Cluster>(pool_.get(), resources);
+  ASSERT_EQ(100, clusters.size());
+  for (int i = 0; i < 100; i++) {
+    if (i == 10) {
+      EXPECT_THROW_WITH_REGEX(ParallelDecoder::checkResource(clusters[i], validation_visitor_),
+                              EnvoyException, "Unable to unpack as envoy.config.cluster.v3");
+    } else if (i == 20) {
+      EXPECT_THROW_WITH_REGEX(ParallelDecoder::checkResource(clusters[i], validation_visitor_),
+                              ProtoValidationException, "ClusterValidationError.Name");
+    } else {
+      EXPECT_NO_THROW(ParallelDecoder::checkResource(clusters[i], validation_visitor_));
+      EXPECT_EQ(absl::StrCat("cluster_", i), clusters[i].message_.name());
+    }
+  }
+}
+
+TEST_P(ParallelDecoderTest, DecodeStateOfTheWorldResources) {
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> resources;
+  for (int i = 0; i < 10; i++) {
+    envoy::config::cluster::v3::Cluster cluster;
+    cluster.set_name(absl::StrCat("cluster_", i));
+    resources.Add()->PackFrom(cluster);
+  }
+
+  const auto clusters =
+      ParallelDecoder::decodeResources<envoy::config::cluster::v3::Cluster>(pool_.get(), resources);
+  ASSERT_EQ(10, clusters.size());
+  for (int i = 0; i < 10; i++) {
+    EXPECT_NO_THROW(ParallelDecoder::checkResource(clusters[i], validation_visitor_));
+    EXPECT_EQ(absl::StrCat("cluster_", i), clusters[i].message_.name());
+  }
+}
+
+} // namespace
+} // namespace Config
+} // namespace Envoy
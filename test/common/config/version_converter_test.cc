@@ -62,6 +62,34 @@ TEST(VersionConverterTest, Upgrade) {
   EXPECT_THAT(original_sub_msg, ProtoEq(source.eds_cluster_config()));
 }
 
+// Upgrading from the wire form of the earlier version matches upgrading from the message.
+TEST(VersionConverterTest, UpgradeSerialized) {
+  API_NO_BOOST(envoy::api::v2::Cluster) source;
+  source.add_hosts();
+  source.mutable_load_assignment()->set_cluster_name("bar");
+  source.mutable_eds_cluster_config()->set_service_name("foo");
+  source.set_drain_connections_on_host_removal(true);
+  API_NO_BOOST(envoy::config::cluster::v3::Cluster) expected;
+  VersionConverter::upgrade(source, expected);
+  API_NO_BOOST(envoy::config::cluster::v3::Cluster) dst;
+  VersionConverter::upgrade(*source.GetDescriptor(), source.SerializeAsString(), dst);
+  EXPECT_THAT(dst, ProtoEq(expected));
+  EXPECT_TRUE(hasOriginalTypeInformation(dst));
+  EXPECT_TRUE(hasOriginalTypeInformation(dst.eds_cluster_config()));
+  auto original_dynamic_msg = VersionConverter::recoverOriginal(dst);
+  EXPECT_THAT(*original_dynamic_msg->msg_, ProtoEq(source));
+}
+
+// Bad UTF-8 fails the upgrade from the wire form too.
+TEST(VersionConverterTest, UpgradeSerializedException) {
+  API_NO_BOOST(envoy::api::v2::Cluster) source;
+  source.mutable_eds_cluster_config()->set_service_name("UPST128\tAM_HO\001\202\247ST");
+  API_NO_BOOST(envoy::config::cluster::v3::Cluster) dst;
+  EXPECT_THROW_WITH_MESSAGE(
+      VersionConverter::upgrade(*source.GetDescriptor(), source.SerializeAsString(), dst),
+      EnvoyException, "Unable to deserialize during upgrade()");
+}
+
 // Empty upgrade between version_converter.proto entities. TODO(htuch): consider migrating all the
 // upgrades in this test to version_converter.proto to reduce dependence on APIs that will be
 // removed at EOY.
@@ -369,6 +369,43 @@ TEST(WatchMapTest, WatchingEverything) {
   doDeltaAndSotwUpdate(watch_map, updated_resources, {}, "version1");
 }
 
+// Tests that the resources of a single, wildcard watch are delivered as is, without looking up
+// their names, and that empty SotW updates still reach it.
+TEST(WatchMapTest, SingleWildcardWatch) {
+  MockSubscriptionCallbacks callbacks;
+  WatchMap watch_map;
+  watch_map.addWatch(callbacks);
+
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> updated_resources;
+  envoy::config::endpoint::v3::ClusterLoadAssignment alice;
+  alice.set_cluster_name("alice");
+  updated_resources.Add()->PackFrom(alice);
+  Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource> delta_resources =
+      wrapInResource(updated_resources, "version1");
+  Protobuf::RepeatedPtrField<std::string> removed_names;
+
+  EXPECT_CALL(callbacks, resourceName(_)).Times(0);
+  EXPECT_CALL(callbacks, onConfigUpdate(_, "version1"))
+      .WillOnce(Invoke([&updated_resources](
+                           const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& gotten_resources,
+                           const std::string&) { EXPECT_EQ(&updated_resources, &gotten_resources); }));
+  EXPECT_CALL(callbacks, onConfigUpdate(_, _, "version1"))
+      .WillOnce(Invoke(
+          [&delta_resources](
+              const Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource>&
+                  gotten_resources,
+              const Protobuf::RepeatedPtrField<std::string>&,
+              const std::string&) { EXPECT_EQ(&delta_resources, &gotten_resources); }));
+  watch_map.onConfigUpdate(updated_resources, "version1");
+  watch_map.onConfigUpdate(delta_resources, removed_names, "version1");
+
+  // An empty SotW update is still delivered, but an empty delta update is not.
+  EXPECT_CALL(callbacks, onConfigUpdate(_, "version2"));
+  EXPECT_CALL(callbacks, onConfigUpdate(_, _, "version2")).Times(0);
+  watch_map.onConfigUpdate({}, "version2");
+  watch_map.onConfigUpdate({}, removed_names, "version2");
+}
+
 // Delta onConfigUpdate has some slightly subtle details with how it handles the three cases where a
 // watch receives {only updates, updates+removals, only removals} to its resources. This test
 // exercise those cases. Also, the removal-only case tests that SotW does call a watch's
@@ -0,0 +1,108 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "envoy/api/v2/cluster.pb.h"
+#include "envoy/api/v2/route.pb.h"
+#include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/config/route/v3/route.pb.h"
+
+#include "common/config/watch_map.h"
+#include "common/protobuf/utility.h"
+
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Config {
+
+// A CDS-like watch, decoding every resource it is delivered.
+class DecodingCallbacks : public SubscriptionCallbacks {
+public:
+  // Config::SubscriptionCallbacks
+  void onConfigUpdate(const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources,
+                      const std::string&) override {
+    for (const auto& resource : resources) {
+      envoy::config::cluster::v3::Cluster cluster;
+      MessageUtil::unpackTo(resource, cluster);
+      benchmark::DoNotOptimize(cluster);
+    }
+  }
+  void onConfigUpdate(const Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource>&,
+                      const Protobuf::RepeatedPtrField<std::string>&,
+                      const std::string&) override {}
+  void onConfigUpdateFailed(ConfigUpdateFailureReason, const EnvoyException*) override {}
+  std::string resourceName(const ProtobufWkt::Any& resource) override {
+    return TestUtility::anyConvert<envoy::config::cluster::v3::Cluster>(resource).name();
+  }
+};
+
+template <class ClusterType>
+Protobuf::RepeatedPtrField<ProtobufWkt::Any> makeClusters(uint32_t num_clusters) {
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> resources;
+  for (uint32_t i = 0; i < num_clusters; i++) {
+    ClusterType cluster;
+    cluster.set_name(absl::StrCat("cluster_", i));
+    cluster.mutable_connect_timeout()->set_seconds(1);
+    cluster.mutable_eds_cluster_config()->set_service_name(absl::StrCat("service_", i));
+    cluster.mutable_eds_cluster_config()->mutable_eds_config()->mutable_ads();
+    resources.Add()->PackFrom(cluster);
+  }
+  return resources;
+}
+
+template <class RouteConfigurationType>
+ProtobufWkt::Any makeRouteConfiguration(uint32_t num_routes) {
+  RouteConfigurationType route_config;
+  route_config.set_name("route_config");
+  auto* virtual_host = route_config.add_virtual_hosts();
+  virtual_host->set_name("virtual_host");
+  virtual_host->add_domains("*");
+  for (uint32_t i = 0; i < num_routes; i++) {
+    auto* route = virtual_host->add_routes();
+    route->mutable_match()->set_prefix(absl::StrCat("/prefix_", i));
+    route->mutable_route()->set_cluster(absl::StrCat("cluster_", i));
+  }
+  ProtobufWkt::Any resource;
+  resource.PackFrom(route_config);
+  return resource;
+}
+
+} // namespace Config
+} // namespace Envoy
+
+// Delivery of a state of the world CDS update through a single, wildcard watch.
+// Range args are: the number of clusters, and whether they are packed at v2 rather than v3.
+static void deliverClusters(benchmark::State& state) {
+  const auto resources =
+      state.range(1) ? Envoy::Config::makeClusters<envoy::api::v2::Cluster>(state.range(0))
+                     : Envoy::Config::makeClusters<envoy::config::cluster::v3::Cluster>(
+                           state.range(0));
+  Envoy::Config::DecodingCallbacks callbacks;
+  Envoy::Config::WatchMap watch_map;
+  watch_map.addWatch(callbacks);
+  for (auto _ : state) {
+    watch_map.onConfigUpdate(resources, "version");
+  }
+}
+BENCHMARK(deliverClusters)->Ranges({{1000, 50000}, {false, true}})->Unit(benchmark::kMillisecond);
+
+// Decoding of a single, large RDS resource.
+// Range args are: the number of routes, and whether they are packed at v2 rather than v3.
+static void unpackRouteConfiguration(benchmark::State& state) {
+  const auto resource =
+      state.range(1)
+          ? Envoy::Config::makeRouteConfiguration<envoy::api::v2::RouteConfiguration>(
+                state.range(0))
+          : Envoy::Config::makeRouteConfiguration<envoy::config::route::v3::RouteConfiguration>(
+                state.range(0));
+  for (auto _ : state) {
+    envoy::config::route::v3::RouteConfiguration route_config;
+    Envoy::MessageUtil::unpackTo(resource, route_config);
+    benchmark::DoNotOptimize(route_config);
+  }
+}
+BENCHMARK(unpackRouteConfiguration)
+    ->Ranges({{1000, 100000}, {false, true}})
+    ->Unit(benchmark::kMillisecond);
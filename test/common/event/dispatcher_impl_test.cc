@@ -1,4 +1,5 @@
 #include <functional>
+#include <thread>
 
 #include "envoy/thread/thread.h"
 
@@ -324,6 +325,20 @@ TEST_F(DispatcherMonotonicTimeTest, ApproximateMonotonicTime) {
   dispatcher_->run(Dispatcher::RunType::Block);
 }
 
+TEST_F(DispatcherMonotonicTimeTest, TakeMaxLoopDuration) {
+  // An iteration of the event loop busy for at least 10ms.
+  Event::TimerPtr timer = dispatcher_->createTimer(
+      []() { std::this_thread::sleep_for(std::chrono::milliseconds(10)); });
+  timer->enableTimer(std::chrono::milliseconds(0));
+  dispatcher_->run(Dispatcher::RunType::Block);
+
+  dispatcher_->post([this]() {
+    EXPECT_GE(dispatcher_->takeMaxLoopDuration(), std::chrono::milliseconds(10));
+    EXPECT_EQ(std::chrono::microseconds(0), dispatcher_->takeMaxLoopDuration());
+  });
+  dispatcher_->run(Dispatcher::RunType::Block);
+}
+
 TEST(TimerImplTest, TimerEnabledDisabled) {
   Api::ApiPtr api = Api::createApiForTest();
   DispatcherPtr dispatcher(api->allocateDispatcher("test_thread"));
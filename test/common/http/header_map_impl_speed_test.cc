@@ -220,5 +220,51 @@ static void HeaderMapImplPopulate(benchmark::State& state) {
 }
 BENCHMARK(HeaderMapImplPopulate);
 
+/**
+ * Measure the speed of creating a HeaderMapImpl with a realistic set of request headers, iterating
+ * over them as a codec encoding them does, and removing some of them as a filter does.
+ */
+static void HeaderMapImplPopulateIterateRemove(benchmark::State& state) {
+  const std::pair<LowerCaseString, std::string> headers_to_add[] = {
+      {LowerCaseString(":method"), "GET"},
+      {LowerCaseString(":path"), "/index.html?query=1"},
+      {LowerCaseString(":scheme"), "https"},
+      {LowerCaseString(":authority"), "www.example.com"},
+      {LowerCaseString("accept"), "text/html,application/xhtml+xml"},
+      {LowerCaseString("accept-encoding"), "gzip, deflate, br"},
+      {LowerCaseString("accept-language"), "en-US,en;q=0.9"},
+      {LowerCaseString("cache-control"), "max-age=0"},
+      {LowerCaseString("cookie"), "_cookie1=12345678"},
+      {LowerCaseString("cookie"), "_cookie2=12345678"},
+      {LowerCaseString("user-agent"), "Mozilla/5.0 (X11; Linux x86_64)"},
+      {LowerCaseString("x-forwarded-for"), "10.0.0.1"},
+      {LowerCaseString("x-forwarded-proto"), "https"},
+      {LowerCaseString("x-request-id"), "5a1b3b8e-4b9c-4f3e-9c4e-0f4b1f9d7a6c"},
+      {LowerCaseString("x-envoy-expected-rq-timeout-ms"), "15000"},
+      {LowerCaseString("x-envoy-internal"), "true"},
+      {LowerCaseString("x-custom-header-1"), "example 1"},
+      {LowerCaseString("x-custom-header-2"), "example 2"},
+      {LowerCaseString("x-custom-header-3"), "example 3"},
+      {LowerCaseString("x-custom-header-4"), "example 4"},
+  };
+  for (auto _ : state) {
+    HeaderMapImpl headers;
+    for (const auto& key_value : headers_to_add) {
+      headers.addReference(key_value.first, key_value.second);
+    }
+    size_t size = 0;
+    headers.iterate(
+        [](const HeaderEntry& header, void* context) -> HeaderMap::Iterate {
+          *static_cast<size_t*>(context) += header.key().size() + header.value().size();
+          return HeaderMap::Iterate::Continue;
+        },
+        &size);
+    headers.removePrefix(LowerCaseString("x-envoy-"));
+    benchmark::DoNotOptimize(size);
+    benchmark::DoNotOptimize(headers.size());
+  }
+}
+BENCHMARK(HeaderMapImplPopulateIterateRemove);
+
 } // namespace Http
 } // namespace Envoy
@@ -9,6 +9,7 @@
 #include "test/test_common/printers.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gtest/gtest.h"
 
 using ::testing::ElementsAre;
@@ -1349,5 +1350,42 @@ TEST(HeaderMapImplTest, InlineHeaderByteSize) {
   }
 }
 
+// Entries keep their address and their order as more headers than a block holds are added and
+// removed.
+TEST(HeaderMapImplTest, ManyHeadersWithRemovals) {
+  TestRequestHeaderMapImpl headers;
+  headers.setPath("/");
+  const HeaderEntry* path = headers.Path();
+  for (uint32_t i = 0; i < 40; ++i) {
+    headers.addCopy(LowerCaseString(absl::StrCat("x-header-", i)), absl::StrCat(i));
+  }
+  for (uint32_t i = 0; i < 40; i += 2) {
+    EXPECT_EQ(1UL, headers.remove(LowerCaseString(absl::StrCat("x-header-", i))));
+  }
+  // These reuse the slots of removed headers.
+  headers.setMethod("GET");
+  headers.addCopy(LowerCaseString("x-header-last"), "last");
+  EXPECT_EQ(path, headers.Path());
+  EXPECT_EQ(23UL, headers.size());
+
+  std::vector<std::string> expected_keys{":path", ":method"};
+  for (uint32_t i = 1; i < 40; i += 2) {
+    expected_keys.push_back(absl::StrCat("x-header-", i));
+  }
+  expected_keys.push_back("x-header-last");
+  std::vector<std::string> keys;
+  headers.iterate(
+      [](const Http::HeaderEntry& header, void* context) -> HeaderMap::Iterate {
+        static_cast<std::vector<std::string>*>(context)->emplace_back(
+            header.key().getStringView());
+        return HeaderMap::Iterate::Continue;
+      },
+      &keys);
+  EXPECT_EQ(expected_keys, keys);
+
+  EXPECT_EQ(21UL, headers.removePrefix(LowerCaseString("x-header-")));
+  EXPECT_EQ(2UL, headers.size());
+}
+
 } // namespace Http
 } // namespace Envoy
@@ -0,0 +1,271 @@
+#include <chrono>
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "common/network/caching_dns_resolver.h"
+#include "common/network/utility.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/network/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "absl/strings/str_cat.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::DoAll;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+using testing::SaveArg;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class CachingDnsResolverImplTest : public testing::Test {
+protected:
+  void setUp(uint32_t channel_count = 1) {
+    std::vector<DnsResolverSharedPtr> channels;
+    for (uint32_t i = 0; i < channel_count; ++i) {
+      channels_.push_back(std::make_shared<NiceMock<MockDnsResolver>>());
+      channels.push_back(channels_.back());
+    }
+    resolver_ = std::make_unique<CachingDnsResolverImpl>(std::move(channels), time_system_,
+                                                         config_, store_);
+  }
+
+  // Start a lookup, and capture the callback of the query it sends to the channel.
+  ActiveDnsQuery* resolveMiss(const std::string& name, DnsResolver::ResolveCb& channel_callback,
+                              DnsResolver::ResolveCb callback = nullptr) {
+    EXPECT_CALL(*channels_[0], resolve(name, DnsLookupFamily::V4Only, _))
+        .WillOnce(DoAll(SaveArg<2>(&channel_callback), Return(&channels_[0]->active_query_)));
+    return resolver_->resolve(name, DnsLookupFamily::V4Only,
+                              callback != nullptr ? callback : recordCallback());
+  }
+
+  DnsResolver::ResolveCb recordCallback() {
+    return [this](DnsResolver::ResolutionStatus status, std::list<DnsResponse>&& response) {
+      statuses_.push_back(status);
+      responses_.push_back(std::move(response));
+    };
+  }
+
+  static std::list<DnsResponse> response(std::vector<std::pair<std::string, uint32_t>> addresses) {
+    std::list<DnsResponse> response;
+    for (const auto& address : addresses) {
+      response.emplace_back(Utility::parseInternetAddress(address.first),
+                            std::chrono::seconds(address.second));
+    }
+    return response;
+  }
+
+  uint64_t counter(const std::string& name) {
+    return store_.counter("dns.cache." + name).value();
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Stats::TestUtil::TestStore store_;
+  CachingDnsResolverConfig config_;
+  std::vector<std::shared_ptr<NiceMock<MockDnsResolver>>> channels_;
+  std::unique_ptr<CachingDnsResolverImpl> resolver_;
+  std::vector<DnsResolver::ResolutionStatus> statuses_;
+  std::vector<std::list<DnsResponse>> responses_;
+};
+
+TEST_F(CachingDnsResolverImplTest, CacheForSmallestTtl) {
+  setUp();
+  DnsResolver::ResolveCb channel_callback;
+  EXPECT_NE(nullptr, resolveMiss("example.com", channel_callback));
+  time_system_.advanceTimeWait(std::chrono::milliseconds(20));
+  channel_callback(DnsResolver::ResolutionStatus::Success,
+                   response({{"10.0.0.1", 60}, {"10.0.0.2", 30}}));
+  ASSERT_EQ(1, responses_.size());
+  EXPECT_EQ(2, responses_[0].size());
+  EXPECT_EQ(1, counter("cache_miss"));
+  EXPECT_EQ(1, store_.gauge("dns.cache.cache_entries", Stats::Gauge::ImportMode::NeverImport)
+                   .value());
+
+  // Cached lookups complete synchronously, with the TTL they have left.
+  time_system_.advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_EQ(nullptr, resolver_->resolve("example.com", DnsLookupFamily::V4Only, recordCallback()));
+  ASSERT_EQ(2, responses_.size());
+  EXPECT_EQ(DnsResolver::ResolutionStatus::Success, statuses_[1]);
+  ASSERT_EQ(2, responses_[1].size());
+  EXPECT_EQ("10.0.0.1:0", responses_[1].front().address_->asString());
+  EXPECT_EQ(std::chrono::seconds(20), responses_[1].front().ttl_);
+  EXPECT_EQ(1, counter("cache_hit"));
+
+  // Other lookup families are cached separately.
+  EXPECT_CALL(*channels_[0], resolve("example.com", DnsLookupFamily::Auto, _))
+      .WillOnce(Return(&channels_[0]->active_query_));
+  resolver_->resolve("example.com", DnsLookupFamily::Auto, recordCallback());
+
+  time_system_.advanceTimeWait(std::chrono::seconds(20));
+  EXPECT_NE(nullptr, resolveMiss("example.com", channel_callback));
+  EXPECT_EQ(3, counter("cache_miss"));
+}
+
+TEST_F(CachingDnsResolverImplTest, TtlBounds) {
+  config_.min_ttl_ = std::chrono::seconds(10);
+  config_.max_ttl_ = std::chrono::seconds(60);
+  setUp();
+  DnsResolver::ResolveCb channel_callback;
+  resolveMiss("short.example.com", channel_callback);
+  channel_callback(DnsResolver::ResolutionStatus::Success, response({{"10.0.0.1", 0}}));
+  resolveMiss("long.example.com", channel_callback);
+  channel_callback(DnsResolver::ResolutionStatus::Success, response({{"10.0.0.2", 3600}}));
+
+  resolver_->resolve("short.example.com", DnsLookupFamily::V4Only, recordCallback());
+  EXPECT_EQ(std::chrono::seconds(10), responses_.back().front().ttl_);
+  resolver_->resolve("long.example.com", DnsLookupFamily::V4Only, recordCallback());
+  EXPECT_EQ(std::chrono::seconds(60), responses_.back().front().ttl_);
+}
+
+TEST_F(CachingDnsResolverImplTest, ZeroTtlNotCached) {
+  setUp();
+  DnsResolver::ResolveCb channel_callback;
+  resolveMiss("example.com", channel_callback);
+  channel_callback(DnsResolver::ResolutionStatus::Success, response({{"10.0.0.1", 0}}));
+  resolveMiss("example.com", channel_callback);
+  EXPECT_EQ(2, counter("cache_miss"));
+}
+
+TEST_F(CachingDnsResolverImplTest, NegativeCache) {
+  setUp();
+  DnsResolver::ResolveCb channel_callback;
+  resolveMiss("missing.example.com", channel_callback);
+  channel_callback(DnsResolver::ResolutionStatus::Failure, {});
+  EXPECT_EQ(1, counter("resolve_failure"));
+
+  EXPECT_EQ(nullptr,
+            resolver_->resolve("missing.example.com", DnsLookupFamily::V4Only, recordCallback()));
+  EXPECT_EQ(DnsResolver::ResolutionStatus::Failure, statuses_.back());
+  EXPECT_TRUE(responses_.back().empty());
+  EXPECT_EQ(1, counter("negative_cache_hit"));
+
+  time_system_.advanceTimeWait(std::chrono::seconds(5));
+  resolveMiss("missing.example.com", channel_callback);
+  EXPECT_EQ(2, counter("cache_miss"));
+}
+
+TEST_F(CachingDnsResolverImplTest, DeduplicateConcurrentLookups) {
+  setUp();
+  DnsResolver::ResolveCb channel_callback;
+  resolveMiss("example.com", channel_callback);
+  ActiveDnsQuery* second =
+      resolver_->resolve("example.com", DnsLookupFamily::V4Only, recordCallback());
+  ActiveDnsQuery* third =
+      resolver_->resolve("example.com", DnsLookupFamily::V4Only, recordCallback());
+  ASSERT_NE(nullptr, second);
+  ASSERT_NE(nullptr, third);
+  EXPECT_EQ(2, counter("query_deduplicated"));
+
+  // Cancelling some of the lookups doesn't cancel the query.
+  EXPECT_CALL(channels_[0]->active_query_, cancel()).Times(0);
+  third->cancel();
+  channel_callback(DnsResolver::ResolutionStatus::Success, response({{"10.0.0.1", 30}}));
+  EXPECT_EQ(2, responses_.size());
+  EXPECT_EQ(1, responses_[0].size());
+  EXPECT_EQ(1, responses_[1].size());
+}
+
+TEST_F(CachingDnsResolverImplTest, CancelQueryOnceAllLookupsCancelled) {
+  setUp();
+  DnsResolver::ResolveCb channel_callback;
+  ActiveDnsQuery* first = resolveMiss("example.com", channel_callback);
+  ActiveDnsQuery* second =
+      resolver_->resolve("example.com", DnsLookupFamily::V4Only, recordCallback());
+  first->cancel();
+  EXPECT_CALL(channels_[0]->active_query_, cancel());
+  second->cancel();
+  EXPECT_EQ(0, store_.gauge("dns.cache.pending_queries", Stats::Gauge::ImportMode::NeverImport)
+                   .value());
+
+  // A new lookup sends a new query.
+  resolveMiss("example.com", channel_callback);
+}
+
+// A callback may cancel lookups sharing the same query.
+TEST_F(CachingDnsResolverImplTest, CancelOtherLookupFromCallback) {
+  setUp();
+  DnsResolver::ResolveCb channel_callback;
+  ActiveDnsQuery* second = nullptr;
+  resolveMiss("example.com", channel_callback,
+              [&second](DnsResolver::ResolutionStatus, std::list<DnsResponse>&&) {
+                second->cancel();
+              });
+  second = resolver_->resolve("example.com", DnsLookupFamily::V4Only, recordCallback());
+  EXPECT_CALL(channels_[0]->active_query_, cancel()).Times(0);
+  channel_callback(DnsResolver::ResolutionStatus::Success, response({{"10.0.0.1", 30}}));
+  EXPECT_TRUE(responses_.empty());
+}
+
+TEST_F(CachingDnsResolverImplTest, SynchronousQuery) {
+  setUp();
+  EXPECT_CALL(*channels_[0], resolve("localhost", DnsLookupFamily::V4Only, _))
+      .WillOnce(Invoke([](const std::string&, DnsLookupFamily,
+                          DnsResolver::ResolveCb callback) -> ActiveDnsQuery* {
+        callback(DnsResolver::ResolutionStatus::Success, response({{"127.0.0.1", 30}}));
+        return nullptr;
+      }));
+  EXPECT_EQ(nullptr, resolver_->resolve("localhost", DnsLookupFamily::V4Only, recordCallback()));
+  EXPECT_EQ(1, responses_.size());
+  EXPECT_EQ(0, store_.gauge("dns.cache.pending_queries", Stats::Gauge::ImportMode::NeverImport)
+                   .value());
+}
+
+TEST_F(CachingDnsResolverImplTest, EvictLeastRecentlyUsed) {
+  config_.max_entries_ = 2;
+  setUp();
+  DnsResolver::ResolveCb channel_callback;
+  for (const std::string name : {"a.example.com", "b.example.com"}) {
+    resolveMiss(name, channel_callback);
+    channel_callback(DnsResolver::ResolutionStatus::Success, response({{"10.0.0.1", 30}}));
+  }
+  // Use "a" again, so that "b" is evicted next.
+  resolver_->resolve("a.example.com", DnsLookupFamily::V4Only, recordCallback());
+  resolveMiss("c.example.com", channel_callback);
+  channel_callback(DnsResolver::ResolutionStatus::Success, response({{"10.0.0.1", 30}}));
+  EXPECT_EQ(1, counter("cache_eviction"));
+
+  EXPECT_EQ(nullptr, resolver_->resolve("a.example.com", DnsLookupFamily::V4Only,
+                                        recordCallback()));
+  resolveMiss("b.example.com", channel_callback);
+}
+
+// Each name is always looked up on the same channel.
+TEST_F(CachingDnsResolverImplTest, ShardLookupsAcrossChannels) {
+  // Failures are not cached, so that every lookup reaches a channel.
+  config_.negative_ttl_ = std::chrono::seconds(0);
+  setUp(4);
+  std::map<std::string, std::set<size_t>> channels_for_name;
+  for (size_t c = 0; c < channels_.size(); ++c) {
+    ON_CALL(*channels_[c], resolve(_, _, _))
+        .WillByDefault(Invoke([&channels_for_name, c](const std::string& name, DnsLookupFamily,
+                                                      DnsResolver::ResolveCb callback) {
+          channels_for_name[name].insert(c);
+          callback(DnsResolver::ResolutionStatus::Failure, {});
+          return nullptr;
+        }));
+  }
+
+  std::set<size_t> used_channels;
+  for (int i = 0; i < 32; ++i) {
+    const std::string name = absl::StrCat("host", i, ".example.com");
+    resolver_->resolve(name, DnsLookupFamily::V4Only, recordCallback());
+    resolver_->resolve(name, DnsLookupFamily::V4Only, recordCallback());
+    ASSERT_EQ(1, channels_for_name[name].size());
+    used_channels.insert(*channels_for_name[name].begin());
+  }
+  EXPECT_GT(used_channels.size(), 1);
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
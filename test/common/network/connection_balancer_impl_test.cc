@@ -0,0 +1,103 @@
+#include <chrono>
+#include <vector>
+
+#include "common/network/connection_balancer_impl.h"
+
+#include "test/test_common/simulated_time_system.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class TestBalancedConnectionHandler : public BalancedConnectionHandler {
+public:
+  // Network::BalancedConnectionHandler
+  uint64_t numConnections() const override { return num_connections_; }
+  void incNumConnections() override { ++num_connections_; }
+  void post(Network::ConnectionSocketPtr&&) override {}
+
+  uint64_t num_connections_{};
+};
+
+// Reads the CPU time of each registered handler from cpu_times_, in registration order.
+class TestLoadAwareConnectionBalancerImpl : public LoadAwareConnectionBalancerImpl {
+public:
+  using LoadAwareConnectionBalancerImpl::LoadAwareConnectionBalancerImpl;
+
+  CpuClock currentThreadCpuClock() override {
+    const size_t index = cpu_times_.size();
+    cpu_times_.emplace_back(std::chrono::nanoseconds(0));
+    return [this, index]() { return cpu_times_[index]; };
+  }
+
+  std::vector<absl::optional<std::chrono::nanoseconds>> cpu_times_;
+};
+
+class LoadAwareConnectionBalancerImplTest : public testing::Test {
+protected:
+  LoadAwareConnectionBalancerImplTest()
+      : balancer_(time_system_, std::chrono::milliseconds(1000)) {
+    balancer_.registerHandler(handlers_[0]);
+    balancer_.registerHandler(handlers_[1]);
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  TestLoadAwareConnectionBalancerImpl balancer_;
+  TestBalancedConnectionHandler handlers_[2];
+};
+
+// Without CPU time, connections are spread evenly.
+TEST_F(LoadAwareConnectionBalancerImplTest, NoCpuTime) {
+  balancer_.cpu_times_[0] = absl::nullopt;
+  balancer_.cpu_times_[1] = absl::nullopt;
+  time_system_.advanceTimeWait(std::chrono::milliseconds(1000));
+  for (uint32_t i = 0; i < 4; ++i) {
+    balancer_.pickTargetHandler(handlers_[0]);
+  }
+  EXPECT_EQ(2, handlers_[0].num_connections_);
+  EXPECT_EQ(2, handlers_[1].num_connections_);
+}
+
+// On ties, the connection stays on the current handler.
+TEST_F(LoadAwareConnectionBalancerImplTest, TieStaysOnCurrentHandler) {
+  EXPECT_EQ(&handlers_[1], &balancer_.pickTargetHandler(handlers_[1]));
+  EXPECT_EQ(1, handlers_[1].num_connections_);
+  EXPECT_EQ(&handlers_[0], &balancer_.pickTargetHandler(handlers_[1]));
+  EXPECT_EQ(1, handlers_[0].num_connections_);
+}
+
+// Connections go to the least utilized worker, until its estimated load catches up.
+TEST_F(LoadAwareConnectionBalancerImplTest, LeastUtilizedWorker) {
+  handlers_[0].num_connections_ = 5;
+  handlers_[1].num_connections_ = 5;
+  balancer_.cpu_times_[0] = std::chrono::milliseconds(700);
+  balancer_.cpu_times_[1] = std::chrono::milliseconds(100);
+  time_system_.advanceTimeWait(std::chrono::milliseconds(1000));
+
+  // The utilizations are 0.7 and 0.1, and a connection costs 0.08.
+  for (uint32_t i = 0; i < 8; ++i) {
+    EXPECT_EQ(&handlers_[1], &balancer_.pickTargetHandler(handlers_[0]));
+  }
+  EXPECT_EQ(&handlers_[0], &balancer_.pickTargetHandler(handlers_[1]));
+
+  // The next sample restarts from the actual utilizations.
+  balancer_.cpu_times_[0] = std::chrono::milliseconds(800);
+  balancer_.cpu_times_[1] = std::chrono::milliseconds(1000);
+  time_system_.advanceTimeWait(std::chrono::milliseconds(1000));
+  EXPECT_EQ(&handlers_[0], &balancer_.pickTargetHandler(handlers_[1]));
+}
+
+TEST_F(LoadAwareConnectionBalancerImplTest, UnregisterHandler) {
+  balancer_.unregisterHandler(handlers_[1]);
+  for (uint32_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(&handlers_[0], &balancer_.pickTargetHandler(handlers_[1]));
+  }
+  EXPECT_EQ(2, handlers_[0].num_connections_);
+  EXPECT_EQ(0, handlers_[1].num_connections_);
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -1181,6 +1181,16 @@ TEST_F(ProtobufUtilityTest, UnpackToNextVersion) {
   EXPECT_TRUE(dst.ignore_health_on_host_removal());
 }
 
+// MessageUtility::unpackTo() with a malformed earlier API message throws.
+TEST_F(ProtobufUtilityTest, UnpackToNextVersionMalformed) {
+  ProtobufWkt::Any source_any;
+  source_any.set_type_url("type.googleapis.com/envoy.api.v2.Cluster");
+  source_any.set_value("\xff");
+  API_NO_BOOST(envoy::config::cluster::v3::Cluster) dst;
+  EXPECT_THROW_WITH_REGEX(MessageUtil::unpackTo(source_any, dst), EnvoyException,
+                          "Unable to unpack as envoy.api.v2.Cluster: ");
+}
+
 // MessageUtility::loadFromJson() throws on garbage JSON.
 TEST_F(ProtobufUtilityTest, LoadFromJsonGarbage) {
   envoy::config::cluster::v3::Cluster dst;
@@ -10,6 +10,7 @@
 #include "common/config/runtime_utility.h"
 #include "common/runtime/runtime_features.h"
 #include "common/runtime/runtime_impl.h"
+#include "common/runtime/runtime_keys.h"
 
 #include "test/common/stats/stat_test_utility.h"
 #include "test/mocks/event/mocks.h"
@@ -734,6 +735,80 @@ TEST_F(StaticLoaderImplTest, ProtoParsing) {
   EXPECT_EQ(2, store_.gauge("runtime.num_layers", Stats::Gauge::ImportMode::NeverImport).value());
 }
 
+// Registered keys are looked up by index, including keys registered after the snapshot was created.
+TEST_F(StaticLoaderImplTest, RegisteredKeys) {
+  base_ = TestUtility::parseYaml<ProtobufWkt::Struct>(R"EOF(
+    integer: 2
+    double: 2.5
+    boolean: true
+    percent:
+      numerator: 52
+      denominator: HUNDRED
+  )EOF");
+  const KeyHandle integer_key = KeyRegistry::registerKey("integer");
+  const KeyHandle double_key = KeyRegistry::registerKey("double");
+  const KeyHandle boolean_key = KeyRegistry::registerKey("boolean");
+  const KeyHandle missing_key = KeyRegistry::registerKey("missing");
+  const KeyHandle empty_key = KeyRegistry::registerKey("");
+  setup();
+
+  // Registering a key again returns the same index.
+  EXPECT_EQ(integer_key.index(), KeyRegistry::registerKey("integer").index());
+  EXPECT_EQ("integer", integer_key.name());
+
+  EXPECT_EQ(2UL, loader_->snapshot().getInteger(integer_key, 1));
+  EXPECT_EQ(2.5, loader_->snapshot().getDouble(double_key, 1.1));
+  EXPECT_TRUE(loader_->snapshot().getBoolean(boolean_key, false));
+  EXPECT_EQ(1UL, loader_->snapshot().getInteger(missing_key, 1));
+  EXPECT_EQ(1.1, loader_->snapshot().getDouble(missing_key, 1.1));
+  EXPECT_FALSE(loader_->snapshot().getBoolean(missing_key, false));
+  EXPECT_EQ(11UL, loader_->snapshot().getInteger(empty_key, 11));
+
+  EXPECT_TRUE(loader_->snapshot().featureEnabled(integer_key, 50, 1));
+  EXPECT_FALSE(loader_->snapshot().featureEnabled(integer_key, 50, 2));
+  EXPECT_FALSE(loader_->snapshot().featureEnabled(integer_key, 50, 2, 10));
+  EXPECT_TRUE(loader_->snapshot().featureEnabled(missing_key, 100));
+  EXPECT_FALSE(loader_->snapshot().featureEnabled(missing_key, 0));
+
+  // Registered after the snapshot was created, the key falls back to a lookup by name.
+  const KeyHandle percent_key = KeyRegistry::registerKey("percent");
+  envoy::type::v3::FractionalPercent fractional_percent;
+  fractional_percent.set_numerator(1);
+  EXPECT_TRUE(loader_->snapshot().featureEnabled(percent_key, fractional_percent, 51));
+  EXPECT_FALSE(loader_->snapshot().featureEnabled(percent_key, fractional_percent, 52));
+  EXPECT_CALL(generator_, random()).WillOnce(Return(51));
+  EXPECT_TRUE(loader_->snapshot().featureEnabled(percent_key, fractional_percent));
+
+  // New snapshots resolve all the registered keys.
+  loader_->mergeValues({{"integer", "3"}, {"missing", "true"}});
+  EXPECT_EQ(3UL, loader_->snapshot().getInteger(integer_key, 1));
+  EXPECT_TRUE(loader_->snapshot().getBoolean(missing_key, false));
+  EXPECT_FALSE(loader_->snapshot().featureEnabled(percent_key, fractional_percent, 52));
+}
+
+// Keys are only registered as long as a handle to them exists. The index of a released key is
+// reused, but snapshots do not resolve the key reusing it with the entry of the released key.
+TEST_F(StaticLoaderImplTest, ReleasedKeys) {
+  base_ = TestUtility::parseYaml<ProtobufWkt::Struct>(R"EOF(
+    reused: 2
+  )EOF");
+  setup();
+
+  const uint64_t num_keys = KeyRegistry::size();
+  absl::optional<KeyHandle> released_key = KeyRegistry::registerKey("released");
+  const uint32_t released_index = released_key->index();
+  EXPECT_EQ(num_keys + 1, KeyRegistry::size());
+  loader_->mergeValues({{"released", "1"}});
+  EXPECT_EQ(1UL, loader_->snapshot().getInteger(*released_key, 0));
+
+  released_key.reset();
+  EXPECT_EQ(num_keys, KeyRegistry::size());
+
+  const KeyHandle reused_key = KeyRegistry::registerKey("reused");
+  EXPECT_EQ(released_index, reused_key.index());
+  EXPECT_EQ(2UL, loader_->snapshot().getInteger(reused_key, 0));
+}
+
 TEST_F(StaticLoaderImplTest, RuntimeFromNonWorkerThreads) {
   // Force the thread to be considered a non-worker thread.
   tls_.registered_ = false;
@@ -0,0 +1,75 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "envoy/stats/stats_macros.h"
+
+#include "common/runtime/runtime_impl.h"
+#include "common/runtime/runtime_keys.h"
+#include "common/stats/isolated_store_impl.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Runtime {
+
+// A snapshot with num_keys integer keys, named key_0 to key_<num_keys - 1>, and the handles of the
+// keys, registered before the snapshot was created.
+class SpeedTestSnapshot {
+public:
+  explicit SpeedTestSnapshot(uint32_t num_keys)
+      : stats_{ALL_RUNTIME_STATS(POOL_COUNTER_PREFIX(store_, "runtime."),
+                                 POOL_GAUGE_PREFIX(store_, "runtime."))} {
+    ProtobufWkt::Struct values;
+    for (uint32_t i = 0; i < num_keys; i++) {
+      const std::string name = absl::StrCat("key_", i);
+      (*values.mutable_fields())[name].set_number_value(i % 100);
+      names_.push_back(name);
+      handles_.push_back(KeyRegistry::registerKey(name));
+    }
+    std::vector<Snapshot::OverrideLayerConstPtr> layers;
+    layers.emplace_back(std::make_unique<const ProtoLayer>("base", values));
+    snapshot_ = std::make_unique<SnapshotImpl>(generator_, stats_, std::move(layers));
+  }
+
+  const Snapshot& snapshot() const { return *snapshot_; }
+  const std::vector<std::string>& names() const { return names_; }
+  const std::vector<KeyHandle>& handles() const { return handles_; }
+
+private:
+  Stats::IsolatedStoreImpl store_;
+  RuntimeStats stats_;
+  RandomGeneratorImpl generator_;
+  std::unique_ptr<SnapshotImpl> snapshot_;
+  std::vector<std::string> names_;
+  std::vector<KeyHandle> handles_;
+};
+
+} // namespace Runtime
+} // namespace Envoy
+
+// featureEnabled() of every key of a snapshot, looked up by name.
+// Range arg is the number of keys.
+static void featureEnabledByName(benchmark::State& state) {
+  Envoy::Runtime::SpeedTestSnapshot snapshot(state.range(0));
+  uint64_t random_value = 0;
+  for (auto _ : state) {
+    for (const std::string& name : snapshot.names()) {
+      benchmark::DoNotOptimize(snapshot.snapshot().featureEnabled(name, 50, random_value++));
+    }
+  }
+}
+BENCHMARK(featureEnabledByName)->Range(10, 10000);
+
+// featureEnabled() of every key of a snapshot, looked up by registered key.
+// Range arg is the number of keys.
+static void featureEnabledByHandle(benchmark::State& state) {
+  Envoy::Runtime::SpeedTestSnapshot snapshot(state.range(0));
+  uint64_t random_value = 0;
+  for (auto _ : state) {
+    for (const Envoy::Runtime::KeyHandle& handle : snapshot.handles()) {
+      benchmark::DoNotOptimize(snapshot.snapshot().featureEnabled(handle, 50, random_value++));
+    }
+  }
+}
+BENCHMARK(featureEnabledByHandle)->Range(10, 10000);
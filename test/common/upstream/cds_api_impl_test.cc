@@ -17,6 +17,7 @@
 #include "test/test_common/printers.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -36,7 +37,8 @@ class CdsApiImplTest : public testing::Test {
 protected:
   void setup() {
     envoy::config::core::v3::ConfigSource cds_config;
-    cds_ = CdsApiImpl::create(cds_config, cm_, store_, validation_visitor_);
+    cds_ = CdsApiImpl::create(cds_config, cm_, store_, validation_visitor_, *api_,
+                              decode_threads_);
     cds_->setInitializedCb([this]() -> void { initialized_.ready(); });
 
     EXPECT_CALL(*cm_.subscription_factory_.subscription_, start(_));
@@ -69,6 +71,8 @@ protected:
   Config::SubscriptionCallbacks* cds_callbacks_{};
   ReadyWatcher initialized_;
   NiceMock<ProtobufMessage::MockValidationVisitor> validation_visitor_;
+  Api::ApiPtr api_{Api::createApiForTest()};
+  uint32_t decode_threads_{};
 };
 
 // Negative test for protoc-gen-validate constraints.
@@ -229,6 +233,37 @@ TEST_F(CdsApiImplTest, DeltaConfigUpdate) {
   }
 }
 
+// Clusters decoded on decode threads are added in the order of the update, and invalid ones are
+// still reported.
+TEST_F(CdsApiImplTest, ConfigUpdateWithDecodeThreads) {
+  decode_threads_ = 2;
+  {
+    InSequence s;
+    setup();
+  }
+
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> clusters;
+  {
+    InSequence s;
+    EXPECT_CALL(cm_, clusters()).WillOnce(Return(ClusterManager::ClusterInfoMap{}));
+    for (int i = 0; i < 64; i++) {
+      envoy::config::cluster::v3::Cluster cluster;
+      // The cluster without name does not satisfy its constraints.
+      if (i != 42) {
+        cluster.set_name(absl::StrCat("cluster_", i));
+        expectAdd(cluster.name(), "1");
+      }
+      clusters.Add()->PackFrom(cluster);
+    }
+    EXPECT_CALL(initialized_, ready());
+  }
+
+  EXPECT_THROW_WITH_REGEX(cds_callbacks_->onConfigUpdate(clusters, "1"), EnvoyException,
+                          "Error adding/updating cluster\\(s\\) : Proto constraint validation "
+                          "failed");
+  EXPECT_EQ("1", cds_->versionInfo());
+}
+
 TEST_F(CdsApiImplTest, ConfigUpdateAddsSecondClusterEvenIfFirstThrows) {
   {
     InSequence s;
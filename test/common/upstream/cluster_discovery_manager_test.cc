@@ -0,0 +1,89 @@
+#include <string>
+#include <vector>
+
+#include "common/upstream/cluster_discovery_manager.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+class ClusterDiscoveryManagerTest : public testing::Test {
+public:
+  ClusterDiscoveryCallbackPtr makeCallback(const std::string& id) {
+    return std::make_unique<ClusterDiscoveryCallback>(
+        [this, id](ClusterDiscoveryStatus status) -> void {
+          invocations_.push_back({id, status});
+        });
+  }
+
+  ClusterDiscoveryManager manager_;
+  std::vector<std::pair<std::string, ClusterDiscoveryStatus>> invocations_;
+};
+
+// Only the first callback of a cluster starts its discovery, and all of them are invoked once.
+TEST_F(ClusterDiscoveryManagerTest, CallbacksShareDiscovery) {
+  auto added1 = manager_.addCallback("cluster1", makeCallback("a"));
+  auto added2 = manager_.addCallback("cluster1", makeCallback("b"));
+  auto added3 = manager_.addCallback("cluster2", makeCallback("c"));
+  EXPECT_FALSE(added1.discovery_in_progress_);
+  EXPECT_TRUE(added2.discovery_in_progress_);
+  EXPECT_FALSE(added3.discovery_in_progress_);
+
+  manager_.processClusterName("cluster1", ClusterDiscoveryStatus::Available);
+  const std::vector<std::pair<std::string, ClusterDiscoveryStatus>> expected{
+      {"a", ClusterDiscoveryStatus::Available}, {"b", ClusterDiscoveryStatus::Available}};
+  EXPECT_EQ(expected, invocations_);
+
+  // Processing is done once.
+  manager_.processClusterName("cluster1", ClusterDiscoveryStatus::Available);
+  EXPECT_EQ(2UL, invocations_.size());
+
+  // A new callback starts a new discovery.
+  auto added4 = manager_.addCallback("cluster1", makeCallback("d"));
+  EXPECT_FALSE(added4.discovery_in_progress_);
+
+  manager_.processClusterName("cluster2", ClusterDiscoveryStatus::Timeout);
+  EXPECT_EQ(std::make_pair(std::string("c"), ClusterDiscoveryStatus::Timeout), invocations_.back());
+}
+
+// Deleting a handle discards its callback, even from another callback.
+TEST_F(ClusterDiscoveryManagerTest, DeletedHandlesDiscardCallbacks) {
+  auto added1 = manager_.addCallback("cluster1", makeCallback("a"));
+  auto added2 = manager_.addCallback("cluster1", makeCallback("b"));
+  ClusterDiscoveryCallbackHandlePtr handle3;
+  auto added4 = manager_.addCallback(
+      "cluster1", std::make_unique<ClusterDiscoveryCallback>(
+                      [&handle3](ClusterDiscoveryStatus) -> void { handle3.reset(); }));
+  handle3 = manager_.addCallback("cluster1", makeCallback("c")).handle_ptr_;
+  added1.handle_ptr_.reset();
+
+  manager_.processClusterName("cluster1", ClusterDiscoveryStatus::Missing);
+  const std::vector<std::pair<std::string, ClusterDiscoveryStatus>> expected{
+      {"b", ClusterDiscoveryStatus::Missing}};
+  EXPECT_EQ(expected, invocations_);
+}
+
+// Callbacks may request the discovery of the cluster they were waiting for again.
+TEST_F(ClusterDiscoveryManagerTest, CallbackRequestsDiscoveryAgain) {
+  ClusterDiscoveryManager::AddedCallbackData added2;
+  auto added1 = manager_.addCallback(
+      "cluster1",
+      std::make_unique<ClusterDiscoveryCallback>([this, &added2](ClusterDiscoveryStatus) -> void {
+        added2 = manager_.addCallback("cluster1", makeCallback("a"));
+      }));
+
+  manager_.processClusterName("cluster1", ClusterDiscoveryStatus::Timeout);
+  EXPECT_FALSE(added2.discovery_in_progress_);
+  EXPECT_TRUE(invocations_.empty());
+
+  manager_.processClusterName("cluster1", ClusterDiscoveryStatus::Available);
+  const std::vector<std::pair<std::string, ClusterDiscoveryStatus>> expected{
+      {"a", ClusterDiscoveryStatus::Available}};
+  EXPECT_EQ(expected, invocations_);
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
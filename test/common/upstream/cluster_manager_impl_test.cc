@@ -30,6 +30,16 @@ std::string clustersJson(const std::vector<std::string>& clusters) {
   return fmt::sprintf("\"clusters\": [%s]", absl::StrJoin(clusters, ","));
 }
 
+class MockOdCdsApi : public OdCdsApi {
+public:
+  MOCK_METHOD(void, updateOnDemand, (const std::string& cluster_name));
+};
+
+ClusterDiscoveryCallbackPtr makeDiscoveryCallback(std::vector<ClusterDiscoveryStatus>& statuses) {
+  return std::make_unique<ClusterDiscoveryCallback>(
+      [&statuses](ClusterDiscoveryStatus status) -> void { statuses.push_back(status); });
+}
+
 class ClusterManagerImplTest : public testing::Test {
 public:
   ClusterManagerImplTest()
@@ -885,12 +895,39 @@ TEST_F(ClusterManagerImplTest, ShutdownOrder) {
             cluster_manager_->get("cluster_1")->loadBalancer().chooseHost(nullptr));
 
   // Local reference, primary reference, thread local reference, host reference, async client
-  // reference.
-  EXPECT_EQ(5U, cluster.info().use_count());
+  // reference, thread local snapshot reference.
+  EXPECT_EQ(6U, cluster.info().use_count());
 
   // Thread local reference should be gone.
   factory_.tls_.shutdownThread();
-  EXPECT_EQ(3U, cluster.info().use_count());
+  EXPECT_EQ(4U, cluster.info().use_count());
+}
+
+// Verifies that workers only create the load balancing state of a cluster once they use it, from
+// the latest hosts.
+TEST_F(ClusterManagerImplTest, ThreadLocalClusterCreatedOnFirstUse) {
+  const std::string json = fmt::sprintf("{\"static_resources\":{%s}}",
+                                        clustersJson({defaultStaticClusterJson("cluster_1")}));
+  envoy::config::bootstrap::v3::Bootstrap bootstrap = parseBootstrapFromV2Json(json);
+  // The cluster stats are only created along with the load balancer.
+  bootstrap.mutable_cluster_manager()->set_lazy_cluster_stats(true);
+
+  create(bootstrap);
+  EXPECT_EQ(nullptr,
+            TestUtility::findCounter(factory_.stats_, "cluster.cluster_1.lb_healthy_panic"));
+
+  ThreadLocalCluster* cluster = cluster_manager_->get("cluster_1");
+  ASSERT_NE(nullptr, cluster);
+  EXPECT_EQ("cluster_1", cluster->info()->name());
+  EXPECT_EQ(nullptr,
+            TestUtility::findCounter(factory_.stats_, "cluster.cluster_1.lb_healthy_panic"));
+
+  EXPECT_EQ(1UL, cluster->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+  EXPECT_NE(nullptr,
+            TestUtility::findCounter(factory_.stats_, "cluster.cluster_1.lb_healthy_panic"));
+  EXPECT_NE(nullptr, cluster->loadBalancer().chooseHost(nullptr));
+
+  factory_.tls_.shutdownThread();
 }
 
 TEST_F(ClusterManagerImplTest, InitializeOrder) {
@@ -1378,6 +1415,78 @@ TEST_F(ClusterManagerImplTest, DynamicAddRemove) {
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(callbacks.get()));
 }
 
+// Concurrent on-demand discoveries of a cluster share a single request, and complete once the
+// cluster finished warming.
+TEST_F(ClusterManagerImplTest, OnDemandClusterDiscoveryAvailable) {
+  create(defaultConfig());
+  auto odcds = std::make_shared<MockOdCdsApi>();
+  std::vector<ClusterDiscoveryStatus> statuses;
+
+  Event::MockTimer* timer = new NiceMock<Event::MockTimer>(&factory_.dispatcher_);
+  EXPECT_CALL(*timer, enableTimer(std::chrono::milliseconds(5000), _));
+  EXPECT_CALL(*odcds, updateOnDemand("fake_cluster"));
+  ClusterDiscoveryCallbackHandlePtr handle1 = cluster_manager_->requestOnDemandClusterDiscovery(
+      odcds, "fake_cluster", makeDiscoveryCallback(statuses), std::chrono::milliseconds(5000));
+  ClusterDiscoveryCallbackHandlePtr handle2 = cluster_manager_->requestOnDemandClusterDiscovery(
+      odcds, "fake_cluster", makeDiscoveryCallback(statuses), std::chrono::milliseconds(1000));
+  EXPECT_NE(nullptr, handle1);
+  EXPECT_NE(nullptr, handle2);
+
+  std::shared_ptr<MockClusterMockPrioritySet> cluster1(new NiceMock<MockClusterMockPrioritySet>());
+  EXPECT_CALL(factory_, clusterFromProto_(_, _, _, _))
+      .WillOnce(Return(std::make_pair(cluster1, nullptr)));
+  EXPECT_CALL(*cluster1, initialize(_));
+  EXPECT_TRUE(cluster_manager_->addOrUpdateCluster(defaultStaticCluster("fake_cluster"), ""));
+  EXPECT_TRUE(statuses.empty());
+
+  cluster1->initialize_callback_();
+  EXPECT_EQ(std::vector<ClusterDiscoveryStatus>(2, ClusterDiscoveryStatus::Available), statuses);
+
+  // The cluster is available right away from now on.
+  statuses.clear();
+  EXPECT_CALL(*odcds, updateOnDemand(_)).Times(0);
+  EXPECT_EQ(nullptr, cluster_manager_->requestOnDemandClusterDiscovery(
+                         odcds, "fake_cluster", makeDiscoveryCallback(statuses),
+                         std::chrono::milliseconds(5000)));
+  EXPECT_EQ(std::vector<ClusterDiscoveryStatus>{ClusterDiscoveryStatus::Available}, statuses);
+}
+
+// On-demand discoveries fail when the cluster is missing, or with their timeout, and deleted
+// handles discard their callbacks.
+TEST_F(ClusterManagerImplTest, OnDemandClusterDiscoveryFailures) {
+  create(defaultConfig());
+  auto odcds = std::make_shared<MockOdCdsApi>();
+  std::vector<ClusterDiscoveryStatus> statuses;
+
+  EXPECT_CALL(*odcds, updateOnDemand("missing_cluster"));
+  ClusterDiscoveryCallbackHandlePtr handle1 = cluster_manager_->requestOnDemandClusterDiscovery(
+      odcds, "missing_cluster", makeDiscoveryCallback(statuses), std::chrono::milliseconds(5000));
+  ClusterDiscoveryCallbackHandlePtr handle2 = cluster_manager_->requestOnDemandClusterDiscovery(
+      odcds, "missing_cluster", makeDiscoveryCallback(statuses), std::chrono::milliseconds(5000));
+  handle2.reset();
+  cluster_manager_->notifyMissingCluster("missing_cluster");
+  EXPECT_EQ(std::vector<ClusterDiscoveryStatus>{ClusterDiscoveryStatus::Missing}, statuses);
+
+  // Only clusters being discovered are reported.
+  statuses.clear();
+  cluster_manager_->notifyMissingCluster("missing_cluster");
+  EXPECT_TRUE(statuses.empty());
+
+  Event::MockTimer* timer = new NiceMock<Event::MockTimer>(&factory_.dispatcher_);
+  EXPECT_CALL(*timer, enableTimer(std::chrono::milliseconds(1000), _));
+  EXPECT_CALL(*odcds, updateOnDemand("slow_cluster"));
+  ClusterDiscoveryCallbackHandlePtr handle3 = cluster_manager_->requestOnDemandClusterDiscovery(
+      odcds, "slow_cluster", makeDiscoveryCallback(statuses), std::chrono::milliseconds(1000));
+  timer->invokeCallback();
+  EXPECT_EQ(std::vector<ClusterDiscoveryStatus>{ClusterDiscoveryStatus::Timeout}, statuses);
+
+  // A new request discovers the cluster again.
+  EXPECT_CALL(*odcds, updateOnDemand("slow_cluster"));
+  ClusterDiscoveryCallbackHandlePtr handle4 = cluster_manager_->requestOnDemandClusterDiscovery(
+      odcds, "slow_cluster", makeDiscoveryCallback(statuses), std::chrono::milliseconds(1000));
+  EXPECT_NE(nullptr, handle4);
+}
+
 TEST_F(ClusterManagerImplTest, AddOrUpdateClusterStaticExists) {
   const std::string json = fmt::sprintf("{\"static_resources\":{%s}}",
                                         clustersJson({defaultStaticClusterJson("fake_cluster")}));
@@ -1454,6 +1563,84 @@ TEST_F(ClusterManagerImplTest, HostsPostedToTlsCluster) {
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(cluster1.get()));
 }
 
+// Verifies that the membership updates of an iteration of the main thread event loop are posted to
+// the workers at once.
+TEST_F(ClusterManagerImplTest, ThreadLocalClusterUpdatesPostedAtOnce) {
+  const std::string json = fmt::sprintf("{\"static_resources\":{%s}}",
+                                        clustersJson({defaultStaticClusterJson("fake_cluster")}));
+  std::shared_ptr<MockClusterRealPrioritySet> cluster1(new NiceMock<MockClusterRealPrioritySet>());
+  EXPECT_CALL(factory_, clusterFromProto_(_, _, _, _))
+      .WillOnce(Return(std::make_pair(cluster1, nullptr)));
+  ON_CALL(*cluster1, initializePhase()).WillByDefault(Return(Cluster::InitializePhase::Primary));
+  EXPECT_CALL(*cluster1, initialize(_));
+
+  create(parseBootstrapFromV2Json(json));
+  cluster1->initialize_callback_();
+
+  HostSharedPtr host1 = makeTestHost(cluster1->info_, "tcp://127.0.0.1:80");
+  HostSharedPtr host2 = makeTestHost(cluster1->info_, "tcp://127.0.0.1:81");
+
+  // Only the first update schedules posting to the workers.
+  Event::PostCb post_cb;
+  EXPECT_CALL(factory_.dispatcher_, post(_)).WillOnce(SaveArg<0>(&post_cb));
+  HostVector hosts{host1};
+  cluster1->priority_set_.updateHosts(
+      0, HostSetImpl::partitionHosts(std::make_shared<HostVector>(hosts),
+                                     HostsPerLocalityImpl::empty()),
+      nullptr, {host1}, {}, absl::nullopt);
+  hosts.push_back(host2);
+  cluster1->priority_set_.updateHosts(
+      0, HostSetImpl::partitionHosts(std::make_shared<HostVector>(hosts),
+                                     HostsPerLocalityImpl::empty()),
+      nullptr, {host2}, {}, absl::nullopt);
+
+  auto* tls_cluster = cluster_manager_->get(cluster1->info_->name());
+  EXPECT_EQ(0, tls_cluster->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+
+  // The worker which uses the cluster replays both updates.
+  ReadyWatcher membership_updated;
+  tls_cluster->prioritySet().addMemberUpdateCb(
+      [&membership_updated](const HostVector&, const HostVector&) -> void {
+        membership_updated.ready();
+      });
+  EXPECT_CALL(membership_updated, ready()).Times(2);
+  post_cb();
+  EXPECT_EQ(2, tls_cluster->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+
+  factory_.tls_.shutdownThread();
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(cluster1.get()));
+}
+
+// Verifies that posting the pending membership updates to the workers does nothing once the cluster
+// manager is destroyed.
+TEST_F(ClusterManagerImplTest, ThreadLocalClusterUpdatesNotPostedAfterDestruction) {
+  const std::string json = fmt::sprintf("{\"static_resources\":{%s}}",
+                                        clustersJson({defaultStaticClusterJson("fake_cluster")}));
+  std::shared_ptr<MockClusterRealPrioritySet> cluster1(new NiceMock<MockClusterRealPrioritySet>());
+  EXPECT_CALL(factory_, clusterFromProto_(_, _, _, _))
+      .WillOnce(Return(std::make_pair(cluster1, nullptr)));
+  ON_CALL(*cluster1, initializePhase()).WillByDefault(Return(Cluster::InitializePhase::Primary));
+  EXPECT_CALL(*cluster1, initialize(_));
+
+  create(parseBootstrapFromV2Json(json));
+  cluster1->initialize_callback_();
+
+  HostSharedPtr host1 = makeTestHost(cluster1->info_, "tcp://127.0.0.1:80");
+  Event::PostCb post_cb;
+  EXPECT_CALL(factory_.dispatcher_, post(_)).WillOnce(SaveArg<0>(&post_cb));
+  cluster1->priority_set_.updateHosts(
+      0, HostSetImpl::partitionHosts(std::make_shared<HostVector>(HostVector{host1}),
+                                     HostsPerLocalityImpl::empty()),
+      nullptr, {host1}, {}, absl::nullopt);
+
+  factory_.tls_.shutdownThread();
+  cluster_manager_.reset();
+  post_cb();
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(cluster1.get()));
+}
+
 // Test that we close all HTTP connection pool connections when there is a host health failure.
 TEST_F(ClusterManagerImplTest, CloseHttpConnectionsOnHealthFailure) {
   const std::string json = fmt::sprintf("{\"static_resources\":{%s}}",
@@ -0,0 +1,177 @@
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/config/core/v3/config_source.pb.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "common/protobuf/utility.h"
+#include "common/upstream/od_cds_api_impl.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/protobuf/mocks.h"
+#include "test/mocks/upstream/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::ElementsAre;
+using testing::InSequence;
+using testing::Return;
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+MATCHER_P(WithName, expectedName, "") { return arg.name() == expectedName; }
+
+class MockMissingClusterNotifier : public MissingClusterNotifier {
+public:
+  MOCK_METHOD(void, notifyMissingCluster, (absl::string_view name));
+};
+
+class OdCdsApiImplTest : public testing::Test {
+protected:
+  void setup(std::chrono::milliseconds idle_timeout = std::chrono::milliseconds(0)) {
+    envoy::config::core::v3::ConfigSource odcds_config;
+    odcds_config.mutable_api_config_source()->set_api_type(
+        envoy::config::core::v3::ApiConfigSource::DELTA_GRPC);
+    if (idle_timeout.count() > 0) {
+      idle_timer_ = new Event::MockTimer(&dispatcher_);
+    }
+    odcds_ = OdCdsApiImpl::create(odcds_config, idle_timeout, cm_, notifier_, dispatcher_, store_,
+                                  validation_visitor_);
+    odcds_callbacks_ = cm_.subscription_factory_.callbacks_;
+  }
+
+  Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource>
+  makeResources(const std::string& cluster_name) {
+    envoy::config::cluster::v3::Cluster cluster;
+    cluster.set_name(cluster_name);
+    cluster.mutable_connect_timeout()->set_seconds(1);
+    Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource> resources;
+    auto* resource = resources.Add();
+    resource->set_name(cluster_name);
+    resource->set_version("1");
+    resource->mutable_resource()->PackFrom(cluster);
+    return resources;
+  }
+
+  NiceMock<MockClusterManager> cm_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  MockMissingClusterNotifier notifier_;
+  Stats::IsolatedStoreImpl store_;
+  NiceMock<ProtobufMessage::MockValidationVisitor> validation_visitor_;
+  Event::MockTimer* idle_timer_{};
+  OdCdsApiSharedPtr odcds_;
+  Config::SubscriptionCallbacks* odcds_callbacks_{};
+};
+
+// State of the world API config sources are rejected.
+TEST_F(OdCdsApiImplTest, RejectsStateOfTheWorldApiConfigSource) {
+  envoy::config::core::v3::ConfigSource odcds_config;
+  odcds_config.mutable_api_config_source()->set_api_type(
+      envoy::config::core::v3::ApiConfigSource::GRPC);
+  EXPECT_THROW_WITH_MESSAGE(OdCdsApiImpl::create(odcds_config, std::chrono::milliseconds(0), cm_,
+                                                 notifier_, dispatcher_, store_,
+                                                 validation_visitor_),
+                            EnvoyException,
+                            "odcds: only DELTA_GRPC API config sources are supported");
+}
+
+// The subscription starts with the first requested cluster, and grows with the others.
+TEST_F(OdCdsApiImplTest, ResourceInterestGrowsWithRequests) {
+  InSequence s;
+  setup();
+
+  EXPECT_CALL(*cm_.subscription_factory_.subscription_, start(ElementsAre("cluster1")));
+  odcds_->updateOnDemand("cluster1");
+  EXPECT_CALL(*cm_.subscription_factory_.subscription_,
+              updateResourceInterest(ElementsAre("cluster1", "cluster2")));
+  odcds_->updateOnDemand("cluster2");
+}
+
+// Requesting a cluster which is already subscribed to subscribes to it again.
+TEST_F(OdCdsApiImplTest, RequestingSubscribedClusterResubscribes) {
+  InSequence s;
+  setup();
+
+  EXPECT_CALL(*cm_.subscription_factory_.subscription_, start(ElementsAre("cluster1")));
+  odcds_->updateOnDemand("cluster1");
+  EXPECT_CALL(*cm_.subscription_factory_.subscription_, updateResourceInterest(ElementsAre()));
+  EXPECT_CALL(*cm_.subscription_factory_.subscription_,
+              updateResourceInterest(ElementsAre("cluster1")));
+  odcds_->updateOnDemand("cluster1");
+}
+
+// Discovered clusters are added, and clusters removed by the management server are reported as
+// missing.
+TEST_F(OdCdsApiImplTest, AddsDiscoveredAndReportsMissingClusters) {
+  setup();
+  odcds_->updateOnDemand("cluster1");
+
+  EXPECT_CALL(cm_, addOrUpdateCluster(WithName("cluster1"), "1")).WillOnce(Return(true));
+  Protobuf::RepeatedPtrField<std::string> removed;
+  *removed.Add() = "cluster2";
+  EXPECT_CALL(cm_, removeCluster(_)).Times(0);
+  EXPECT_CALL(notifier_, notifyMissingCluster(absl::string_view("cluster2")));
+  odcds_callbacks_->onConfigUpdate(makeResources("cluster1"), removed, "1");
+  EXPECT_EQ(1UL, store_.counter("cluster_manager.odcds.cluster_discovered").value());
+  EXPECT_EQ(1UL, store_.counter("cluster_manager.odcds.cluster_missing").value());
+
+  // Removing a discovered cluster removes it from the cluster manager.
+  *removed.Mutable(0) = "cluster1";
+  EXPECT_CALL(cm_, removeCluster("cluster1")).WillOnce(Return(true));
+  EXPECT_CALL(notifier_, notifyMissingCluster(absl::string_view("cluster1")));
+  odcds_callbacks_->onConfigUpdate({}, removed, "2");
+  EXPECT_EQ(1UL, store_.counter("cluster_manager.odcds.cluster_missing").value());
+}
+
+// Invalid clusters are rejected.
+TEST_F(OdCdsApiImplTest, ValidateFail) {
+  setup();
+  Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource> resources;
+  resources.Add()->mutable_resource()->PackFrom(envoy::config::cluster::v3::Cluster());
+  EXPECT_CALL(cm_, addOrUpdateCluster(_, _)).Times(0);
+  EXPECT_THROW(odcds_callbacks_->onConfigUpdate(resources, {}, "1"), EnvoyException);
+}
+
+// Discovered clusters are removed once they served nothing for a whole idle timeout period.
+TEST_F(OdCdsApiImplTest, IdleClustersExpire) {
+  setup(std::chrono::milliseconds(1000));
+  odcds_->updateOnDemand("cluster1");
+
+  EXPECT_CALL(cm_, addOrUpdateCluster(WithName("cluster1"), "1")).WillOnce(Return(true));
+  EXPECT_CALL(*idle_timer_, enableTimer(std::chrono::milliseconds(1000), _));
+  odcds_callbacks_->onConfigUpdate(makeResources("cluster1"), {}, "1");
+
+  // The usage of the cluster is only recorded by the first check.
+  EXPECT_CALL(cm_, removeCluster(_)).Times(0);
+  EXPECT_CALL(*idle_timer_, enableTimer(std::chrono::milliseconds(1000), _));
+  idle_timer_->invokeCallback();
+
+  // The cluster served a request in the meantime.
+  ClusterStats& stats = cm_.thread_local_cluster_.cluster_.info_->stats_;
+  stats.upstream_rq_total_.inc();
+  EXPECT_CALL(*idle_timer_, enableTimer(std::chrono::milliseconds(1000), _));
+  idle_timer_->invokeCallback();
+
+  // The cluster is still serving a request.
+  stats.upstream_rq_active_.inc();
+  EXPECT_CALL(*idle_timer_, enableTimer(std::chrono::milliseconds(1000), _));
+  idle_timer_->invokeCallback();
+
+  stats.upstream_rq_active_.dec();
+  EXPECT_CALL(cm_, removeCluster("cluster1")).WillOnce(Return(true));
+  EXPECT_CALL(*cm_.subscription_factory_.subscription_, updateResourceInterest(ElementsAre()));
+  EXPECT_CALL(*idle_timer_, enableTimer(_, _)).Times(0);
+  idle_timer_->invokeCallback();
+  EXPECT_EQ(1UL, store_.counter("cluster_manager.odcds.cluster_expired").value());
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
@@ -99,7 +99,8 @@ public:
     return std::make_pair(result.first, ThreadAwareLoadBalancerPtr(result.second));
   }
 
-  CdsApiPtr createCds(const envoy::config::core::v3::ConfigSource&, ClusterManager&) override {
+  CdsApiPtr createCds(const envoy::config::core::v3::ConfigSource&, ClusterManager&,
+                      uint32_t) override {
     return CdsApiPtr{createCds_()};
   }
 
@@ -156,6 +157,7 @@ public:
 class TestClusterManagerImpl : public ClusterManagerImpl {
 public:
   using ClusterManagerImpl::ClusterManagerImpl;
+  using ClusterManagerImpl::requestOnDemandClusterDiscovery;
 
   TestClusterManagerImpl(const envoy::config::bootstrap::v3::Bootstrap& bootstrap,
                          ClusterManagerFactory& factory, Stats::Store& stats,
@@ -513,6 +513,7 @@ protected:
     EXPECT_FALSE(discovery_session.enableHashtagging());
     EXPECT_EQ(discovery_session.bufferFlushTimeoutInMs(), std::chrono::milliseconds(0));
     EXPECT_EQ(discovery_session.maxUpstreamUnknownConnections(), 0);
+    EXPECT_FALSE(discovery_session.enableAutoPipelining());
 
     NetworkFilters::Common::Redis::RespValuePtr dummy_value{
         new NetworkFilters::Common::Redis::RespValue()};
@@ -661,7 +662,7 @@ TEST_F(RedisClusterTest, EmptyDnsResponse) {
 
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(1U, cluster_->info()->stats().update_empty_.value());
+  EXPECT_EQ(1U, cluster_->info()->endpointStats().update_empty_.value());
 
   // Does not recreate the timer on subsequent DNS resolve calls.
   EXPECT_CALL(*dns_timer, enableTimer(_, _));
@@ -670,7 +671,7 @@ TEST_F(RedisClusterTest, EmptyDnsResponse) {
 
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(2U, cluster_->info()->stats().update_empty_.value());
+  EXPECT_EQ(2U, cluster_->info()->endpointStats().update_empty_.value());
 }
 
 TEST_F(RedisClusterTest, FailedDnsResponse) {
@@ -686,7 +687,7 @@ TEST_F(RedisClusterTest, FailedDnsResponse) {
 
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(0U, cluster_->info()->stats().update_empty_.value());
+  EXPECT_EQ(0U, cluster_->info()->endpointStats().update_empty_.value());
 
   // Does not recreate the timer on subsequent DNS resolve calls.
   EXPECT_CALL(*dns_timer, enableTimer(_, _));
@@ -695,7 +696,7 @@ TEST_F(RedisClusterTest, FailedDnsResponse) {
 
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(1U, cluster_->info()->stats().update_empty_.value());
+  EXPECT_EQ(1U, cluster_->info()->endpointStats().update_empty_.value());
 }
 
 TEST_F(RedisClusterTest, Basic) {
@@ -741,8 +742,8 @@ TEST_F(RedisClusterTest, RedisResolveFailure) {
 
   // Initialization will wait til the redis cluster succeed.
   expectClusterSlotFailure();
-  EXPECT_EQ(1U, cluster_->info()->stats().update_attempt_.value());
-  EXPECT_EQ(1U, cluster_->info()->stats().update_failure_.value());
+  EXPECT_EQ(1U, cluster_->info()->endpointStats().update_attempt_.value());
+  EXPECT_EQ(1U, cluster_->info()->endpointStats().update_failure_.value());
 
   expectRedisResolve(true);
   resolve_timer_->invokeCallback();
@@ -757,8 +758,8 @@ TEST_F(RedisClusterTest, RedisResolveFailure) {
   resolve_timer_->invokeCallback();
   expectClusterSlotFailure();
   expectHealthyHosts(std::list<std::string>({"127.0.0.1:22120", "127.0.0.2:22120"}));
-  EXPECT_EQ(3U, cluster_->info()->stats().update_attempt_.value());
-  EXPECT_EQ(2U, cluster_->info()->stats().update_failure_.value());
+  EXPECT_EQ(3U, cluster_->info()->endpointStats().update_attempt_.value());
+  EXPECT_EQ(2U, cluster_->info()->endpointStats().update_failure_.value());
 }
 
 TEST_F(RedisClusterTest, FactoryInitNotRedisClusterTypeFailure) {
@@ -809,8 +810,8 @@ TEST_F(RedisClusterTest, RedisErrorResponse) {
 
   EXPECT_CALL(*cluster_callback_, onClusterSlotUpdate(_, _)).Times(0);
   expectClusterSlotResponse(std::move(hello_world_response));
-  EXPECT_EQ(1U, cluster_->info()->stats().update_attempt_.value());
-  EXPECT_EQ(1U, cluster_->info()->stats().update_failure_.value());
+  EXPECT_EQ(1U, cluster_->info()->endpointStats().update_attempt_.value());
+  EXPECT_EQ(1U, cluster_->info()->endpointStats().update_failure_.value());
 
   expectRedisResolve();
   resolve_timer_->invokeCallback();
@@ -835,9 +836,9 @@ TEST_F(RedisClusterTest, RedisErrorResponse) {
     }
     expectClusterSlotResponse(createResponse(flags, no_replica));
     expectHealthyHosts(std::list<std::string>({"127.0.0.1:22120"}));
-    EXPECT_EQ(++update_attempt, cluster_->info()->stats().update_attempt_.value());
+    EXPECT_EQ(++update_attempt, cluster_->info()->endpointStats().update_attempt_.value());
     if (!flags.all()) {
-      EXPECT_EQ(++update_failure, cluster_->info()->stats().update_failure_.value());
+      EXPECT_EQ(++update_failure, cluster_->info()->endpointStats().update_failure_.value());
     }
   }
 }
@@ -872,9 +873,9 @@ TEST_F(RedisClusterTest, RedisReplicaErrorResponse) {
     }
     expectHealthyHosts(std::list<std::string>({"127.0.0.1:22120"}));
     expectClusterSlotResponse(createResponse(single_slot_master, replica_flags));
-    EXPECT_EQ(++update_attempt, cluster_->info()->stats().update_attempt_.value());
+    EXPECT_EQ(++update_attempt, cluster_->info()->endpointStats().update_attempt_.value());
     if (!(replica_flags.all() || replica_flags.none())) {
-      EXPECT_EQ(++update_failure, cluster_->info()->stats().update_failure_.value());
+      EXPECT_EQ(++update_failure, cluster_->info()->endpointStats().update_failure_.value());
     }
   }
 }
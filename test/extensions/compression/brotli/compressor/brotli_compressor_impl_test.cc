@@ -0,0 +1,131 @@
+#include "envoy/compression/compressor/config.h"
+
+#include "common/buffer/buffer_impl.h"
+
+#include "extensions/compression/brotli/compressor/brotli_compressor_impl.h"
+#include "extensions/compression/brotli/compressor/config.h"
+#include "extensions/compression/brotli/decompressor/brotli_decompressor_impl.h"
+
+#include "test/mocks/server/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Brotli {
+namespace Compressor {
+namespace {
+
+std::string jsonDocument(uint64_t i) {
+  return absl::StrCat("{\"id\":", i, ",\"name\":\"user", i * 7919 % 100000,
+                      "\",\"email\":\"user", i, "@example.com\",\"active\":true}");
+}
+
+class BrotliCompressorImplTest : public testing::Test {
+protected:
+  std::string decompress(const Buffer::Instance& compressed,
+                         std::shared_ptr<const std::string> dictionary = nullptr) {
+    Decompressor::BrotliDecompressorImpl decompressor(std::move(dictionary), 4096);
+    Buffer::OwnedImpl output;
+    decompressor.decompress(compressed, output);
+    EXPECT_EQ(0, decompressor.decompression_error_);
+    return output.toString();
+  }
+
+  Api::ApiPtr api_{Api::createApiForTest()};
+};
+
+// Each flush makes all the input so far decompressible, without ending the stream.
+TEST_F(BrotliCompressorImplTest, FlushThenFinish) {
+  BrotliCompressorImpl compressor(3, 18, BrotliCompressorImpl::EncoderMode::Text, nullptr, 4096);
+  Buffer::OwnedImpl accumulation_buffer;
+  std::string original_text;
+
+  for (uint64_t i = 0; i < 50; ++i) {
+    Buffer::OwnedImpl buffer;
+    for (uint64_t j = 0; j < 20; ++j) {
+      buffer.add(jsonDocument(i * 20 + j));
+    }
+    original_text.append(buffer.toString());
+    compressor.compress(buffer, Envoy::Compression::Compressor::State::Flush);
+    accumulation_buffer.add(buffer);
+    EXPECT_EQ(original_text, decompress(accumulation_buffer));
+  }
+
+  Buffer::OwnedImpl buffer;
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  EXPECT_NE(0, buffer.length());
+  accumulation_buffer.add(buffer);
+  EXPECT_EQ(original_text, decompress(accumulation_buffer));
+  EXPECT_LT(accumulation_buffer.length(), original_text.length() / 2);
+}
+
+TEST_F(BrotliCompressorImplTest, CallingFinishOnly) {
+  BrotliCompressorImpl compressor(3, 18, BrotliCompressorImpl::EncoderMode::Default, nullptr,
+                                  4096);
+  Buffer::OwnedImpl buffer;
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  EXPECT_NE(0, buffer.length());
+  EXPECT_EQ("", decompress(buffer));
+}
+
+TEST_F(BrotliCompressorImplTest, CompressWithSmallChunkSize) {
+  BrotliCompressorImpl compressor(0, 10, BrotliCompressorImpl::EncoderMode::Generic, nullptr,
+                                  4096);
+  Buffer::OwnedImpl buffer;
+  TestUtility::feedBufferWithRandomCharacters(buffer, 65536);
+  const std::string original_text = buffer.toString();
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  EXPECT_GT(buffer.length(), 4096);
+  EXPECT_EQ(original_text, decompress(buffer));
+}
+
+// A dictionary improves the compression of small documents looking like it.
+TEST_F(BrotliCompressorImplTest, CompressWithDictionary) {
+  std::string dictionary;
+  for (uint64_t i = 1000; i < 1010; ++i) {
+    dictionary.append(jsonDocument(i));
+  }
+
+  envoy::extensions::compression::brotli::compressor::v3::Brotli brotli;
+  BrotliCompressorFactory factory(brotli, *api_);
+  brotli.mutable_dictionary()->set_inline_string(dictionary);
+  BrotliCompressorFactory dictionary_factory(brotli, *api_);
+
+  Buffer::OwnedImpl buffer(jsonDocument(42));
+  Buffer::OwnedImpl dictionary_buffer(jsonDocument(42));
+  factory.createCompressor()->compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  dictionary_factory.createCompressor()->compress(dictionary_buffer,
+                                                  Envoy::Compression::Compressor::State::Finish);
+  EXPECT_LT(dictionary_buffer.length(), buffer.length());
+  EXPECT_EQ(jsonDocument(42),
+            decompress(dictionary_buffer, std::make_shared<const std::string>(dictionary)));
+}
+
+TEST(BrotliCompressorLibraryFactoryTest, CreateCompressor) {
+  auto* library_factory = Registry::FactoryRegistry<
+      Envoy::Compression::Compressor::NamedCompressorLibraryConfigFactory>::
+      getFactory("envoy.compression.brotli.compressor");
+  ASSERT_NE(nullptr, library_factory);
+
+  envoy::extensions::compression::brotli::compressor::v3::Brotli brotli;
+  brotli.mutable_quality()->set_value(11);
+  brotli.mutable_window_bits()->set_value(24);
+  brotli.set_encoder_mode(envoy::extensions::compression::brotli::compressor::v3::Brotli::FONT);
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  Envoy::Compression::Compressor::CompressorFactoryPtr factory =
+      library_factory->createCompressorFactoryFromProto(brotli, context);
+  EXPECT_EQ("br", factory->contentEncoding());
+  EXPECT_EQ("brotli.", factory->statsPrefix());
+  EXPECT_NE(nullptr, factory->createCompressor());
+}
+
+} // namespace
+} // namespace Compressor
+} // namespace Brotli
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,93 @@
+#include "common/buffer/buffer_impl.h"
+
+#include "extensions/compression/brotli/compressor/brotli_compressor_impl.h"
+#include "extensions/compression/brotli/decompressor/brotli_decompressor_impl.h"
+#include "extensions/compression/brotli/decompressor/config.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Brotli {
+namespace Decompressor {
+namespace {
+
+class BrotliDecompressorImplTest : public testing::Test {
+protected:
+  static std::string compress(const std::string& text,
+                              Compressor::BrotliEncoderDictionaryConstSharedPtr dictionary) {
+    Compressor::BrotliCompressorImpl compressor(
+        3, 18, Compressor::BrotliCompressorImpl::EncoderMode::Default, std::move(dictionary),
+        4096);
+    Buffer::OwnedImpl buffer(text);
+    compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+    return buffer.toString();
+  }
+};
+
+// Decompress a stream delivered in several calls, whose output is larger than the chunk.
+TEST_F(BrotliDecompressorImplTest, DecompressInSeveralCalls) {
+  Buffer::OwnedImpl input_buffer;
+  TestUtility::feedBufferWithRandomCharacters(input_buffer, 100000);
+  const std::string original_text = input_buffer.toString() + std::string(100000, 'a');
+  const std::string compressed_text = compress(original_text, nullptr);
+
+  BrotliDecompressorImpl decompressor(nullptr, 4096);
+  Buffer::OwnedImpl output_buffer;
+  for (size_t i = 0; i < compressed_text.size(); i += 7) {
+    Buffer::OwnedImpl slice(compressed_text.substr(i, 7));
+    decompressor.decompress(slice, output_buffer);
+  }
+  EXPECT_EQ(0, decompressor.decompression_error_);
+  EXPECT_EQ(original_text, output_buffer.toString());
+}
+
+TEST_F(BrotliDecompressorImplTest, CorruptedInput) {
+  std::string compressed_text = compress(std::string(1000, 'a'), nullptr);
+  compressed_text[1] ^= 0x55;
+  Buffer::OwnedImpl input_buffer(compressed_text);
+
+  BrotliDecompressorImpl decompressor(nullptr, 4096);
+  Buffer::OwnedImpl output_buffer;
+  decompressor.decompress(input_buffer, output_buffer);
+  EXPECT_LT(decompressor.decompression_error_, 0);
+}
+
+// Content compressed with a dictionary is only decompressed with the same dictionary.
+TEST_F(BrotliDecompressorImplTest, Dictionary) {
+  const std::string dictionary = "the quick brown fox jumps over the lazy dog";
+  const std::string original_text = "the lazy dog jumps over the quick brown fox";
+  Buffer::OwnedImpl compressed(compress(
+      original_text, std::make_shared<const Compressor::BrotliEncoderDictionary>(dictionary)));
+
+  BrotliDecompressorImpl decompressor(std::make_shared<const std::string>(dictionary), 4096);
+  Buffer::OwnedImpl output_buffer;
+  decompressor.decompress(compressed, output_buffer);
+  EXPECT_EQ(0, decompressor.decompression_error_);
+  EXPECT_EQ(original_text, output_buffer.toString());
+
+  BrotliDecompressorImpl no_dictionary_decompressor(nullptr, 4096);
+  output_buffer.drain(output_buffer.length());
+  no_dictionary_decompressor.decompress(compressed, output_buffer);
+  EXPECT_NE(original_text, output_buffer.toString());
+}
+
+TEST(BrotliDecompressorFactoryTest, CreateDecompressor) {
+  Api::ApiPtr api = Api::createApiForTest();
+  envoy::extensions::compression::brotli::decompressor::v3::Brotli brotli;
+  brotli.mutable_dictionary()->set_inline_string("dictionary");
+  BrotliDecompressorFactory factory(brotli, *api);
+  EXPECT_EQ("br", factory.contentEncoding());
+  EXPECT_EQ("brotli.", factory.statsPrefix());
+  EXPECT_NE(nullptr, factory.createDecompressor());
+}
+
+} // namespace
+} // namespace Decompressor
+} // namespace Brotli
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,143 @@
+#include "envoy/compression/compressor/config.h"
+
+#include "common/buffer/buffer_impl.h"
+
+#include "extensions/compression/zstd/compressor/config.h"
+#include "extensions/compression/zstd/compressor/zstd_compressor_impl.h"
+#include "extensions/compression/zstd/decompressor/zstd_decompressor_impl.h"
+
+#include "test/mocks/server/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Compressor {
+namespace {
+
+// JSON documents looking like the ones the test dictionary was trained with.
+std::string jsonDocument(uint64_t i) {
+  return absl::StrCat("{\"id\":", i, ",\"name\":\"user", i * 7919 % 100000,
+                      "\",\"email\":\"user", i, "@example.com\",\"active\":true}");
+}
+
+std::string dictionaryPath(uint32_t id) {
+  return TestEnvironment::substitute(
+      absl::StrCat("{{ test_rundir }}/test/extensions/compression/zstd/test_data/dictionary_", id));
+}
+
+class ZstdCompressorImplTest : public testing::Test {
+protected:
+  std::string decompress(const Buffer::Instance& compressed,
+                         Decompressor::ZstdDDictsConstSharedPtr dictionaries = nullptr) {
+    Decompressor::ZstdDecompressorImpl decompressor(27, std::move(dictionaries), 4096);
+    Buffer::OwnedImpl output;
+    decompressor.decompress(compressed, output);
+    EXPECT_EQ(0, decompressor.decompression_error_);
+    return output.toString();
+  }
+
+  Api::ApiPtr api_{Api::createApiForTest()};
+};
+
+// Each flush makes all the input so far decompressible, without ending the stream.
+TEST_F(ZstdCompressorImplTest, FlushThenFinish) {
+  ZstdCompressorImpl compressor(3, absl::nullopt, true, nullptr, 4096);
+  Buffer::OwnedImpl accumulation_buffer;
+  std::string original_text;
+
+  for (uint64_t i = 0; i < 50; ++i) {
+    Buffer::OwnedImpl buffer;
+    for (uint64_t j = 0; j < 20; ++j) {
+      buffer.add(jsonDocument(i * 20 + j));
+    }
+    original_text.append(buffer.toString());
+    compressor.compress(buffer, Envoy::Compression::Compressor::State::Flush);
+    accumulation_buffer.add(buffer);
+    EXPECT_EQ(original_text, decompress(accumulation_buffer));
+  }
+
+  Buffer::OwnedImpl buffer;
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  EXPECT_NE(0, buffer.length());
+  accumulation_buffer.add(buffer);
+  EXPECT_EQ(original_text, decompress(accumulation_buffer));
+  EXPECT_LT(accumulation_buffer.length(), original_text.length() / 2);
+
+  // A zstd frame starts with its magic number.
+  EXPECT_EQ("\x28\xb5\x2f\xfd", accumulation_buffer.toString().substr(0, 4));
+}
+
+TEST_F(ZstdCompressorImplTest, CallingFinishOnly) {
+  ZstdCompressorImpl compressor(3, absl::nullopt, false, nullptr, 4096);
+  Buffer::OwnedImpl buffer;
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  EXPECT_NE(0, buffer.length());
+  EXPECT_EQ("", decompress(buffer));
+}
+
+// The output chunk is smaller than the output of a single flush.
+TEST_F(ZstdCompressorImplTest, CompressWithSmallChunkSize) {
+  ZstdCompressorImpl compressor(1, 10, false, nullptr, 4096);
+  Buffer::OwnedImpl buffer;
+  TestUtility::feedBufferWithRandomCharacters(buffer, 65536);
+  const std::string original_text = buffer.toString();
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  EXPECT_GT(buffer.length(), 4096);
+  EXPECT_EQ(original_text, decompress(buffer));
+}
+
+// A dictionary improves the compression of small documents.
+TEST_F(ZstdCompressorImplTest, CompressWithDictionary) {
+  envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
+  ZstdCompressorFactory factory(zstd, *api_);
+  zstd.mutable_dictionary()->set_filename(dictionaryPath(1));
+  ZstdCompressorFactory dictionary_factory(zstd, *api_);
+
+  Buffer::OwnedImpl buffer(jsonDocument(42));
+  Buffer::OwnedImpl dictionary_buffer(jsonDocument(42));
+  factory.createCompressor()->compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  dictionary_factory.createCompressor()->compress(dictionary_buffer,
+                                                  Envoy::Compression::Compressor::State::Finish);
+  EXPECT_LT(dictionary_buffer.length(), buffer.length());
+
+  auto dictionaries = std::make_shared<const Decompressor::ZstdDDicts>(
+      std::vector<std::string>{TestEnvironment::readFileToStringForTest(dictionaryPath(1))});
+  EXPECT_EQ(jsonDocument(42), decompress(dictionary_buffer, dictionaries));
+}
+
+TEST_F(ZstdCompressorImplTest, RawContentDictionary) {
+  envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
+  zstd.mutable_dictionary()->set_inline_string(jsonDocument(1));
+  EXPECT_THROW_WITH_MESSAGE(ZstdCompressorFactory(zstd, *api_), EnvoyException,
+                            "zstd dictionary has no dictionary ID; it must be trained with zstd");
+}
+
+TEST(ZstdCompressorLibraryFactoryTest, CreateCompressor) {
+  auto* library_factory = Registry::FactoryRegistry<
+      Envoy::Compression::Compressor::NamedCompressorLibraryConfigFactory>::
+      getFactory("envoy.compression.zstd.compressor");
+  ASSERT_NE(nullptr, library_factory);
+
+  envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
+  zstd.mutable_compression_level()->set_value(19);
+  zstd.mutable_window_log()->set_value(20);
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  Envoy::Compression::Compressor::CompressorFactoryPtr factory =
+      library_factory->createCompressorFactoryFromProto(zstd, context);
+  EXPECT_EQ("zstd", factory->contentEncoding());
+  EXPECT_EQ("zstd.", factory->statsPrefix());
+  EXPECT_NE(nullptr, factory->createCompressor());
+}
+
+} // namespace
+} // namespace Compressor
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,145 @@
+#include "common/buffer/buffer_impl.h"
+
+#include "extensions/compression/zstd/compressor/zstd_compressor_impl.h"
+#include "extensions/compression/zstd/decompressor/config.h"
+#include "extensions/compression/zstd/decompressor/zstd_decompressor_impl.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+#include "zstd_errors.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Zstd {
+namespace Decompressor {
+namespace {
+
+std::string dictionary(uint32_t id) {
+  return TestEnvironment::readFileToStringForTest(TestEnvironment::substitute(absl::StrCat(
+      "{{ test_rundir }}/test/extensions/compression/zstd/test_data/dictionary_", id)));
+}
+
+class ZstdDecompressorImplTest : public testing::Test {
+protected:
+  Buffer::OwnedImpl compress(const std::string& text, absl::optional<uint32_t> window_log,
+                             const std::string& dictionary = "") {
+    Compressor::ZstdCompressorImpl compressor(
+        3, window_log, true,
+        dictionary.empty() ? nullptr : Compressor::createCDict(dictionary, 3), 4096);
+    Buffer::OwnedImpl buffer(text);
+    compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+    return buffer;
+  }
+
+  static constexpr uint32_t default_window_log_max{27};
+};
+
+// Decompress input split in small slices, which don't even hold a full frame header.
+TEST_F(ZstdDecompressorImplTest, DecompressSmallSlices) {
+  Buffer::OwnedImpl input_buffer;
+  TestUtility::feedBufferWithRandomCharacters(input_buffer, 100000);
+  const std::string original_text = input_buffer.toString();
+  Buffer::OwnedImpl compressed = compress(original_text, absl::nullopt);
+
+  Buffer::OwnedImpl sliced;
+  const std::string compressed_text = compressed.toString();
+  for (size_t i = 0; i < compressed_text.size(); i += 3) {
+    Buffer::OwnedImpl slice(compressed_text.substr(i, 3));
+    sliced.move(slice);
+  }
+
+  ZstdDecompressorImpl decompressor(default_window_log_max, nullptr, 4096);
+  Buffer::OwnedImpl output_buffer;
+  decompressor.decompress(sliced, output_buffer);
+  EXPECT_EQ(0, decompressor.decompression_error_);
+  EXPECT_EQ(original_text, output_buffer.toString());
+}
+
+// Decompress a stream delivered in several calls.
+TEST_F(ZstdDecompressorImplTest, DecompressInSeveralCalls) {
+  const std::string original_text(50000, 'a');
+  const std::string compressed_text = compress(original_text, absl::nullopt).toString();
+
+  ZstdDecompressorImpl decompressor(default_window_log_max, nullptr, 4096);
+  Buffer::OwnedImpl output_buffer;
+  for (size_t i = 0; i < compressed_text.size(); i += 5) {
+    Buffer::OwnedImpl input_buffer(compressed_text.substr(i, 5));
+    decompressor.decompress(input_buffer, output_buffer);
+  }
+  EXPECT_EQ(0, decompressor.decompression_error_);
+  EXPECT_EQ(original_text, output_buffer.toString());
+}
+
+TEST_F(ZstdDecompressorImplTest, WindowTooLarge) {
+  Buffer::OwnedImpl input_buffer;
+  TestUtility::feedBufferWithRandomCharacters(input_buffer, 100000);
+  Buffer::OwnedImpl compressed = compress(input_buffer.toString(), 20);
+
+  ZstdDecompressorImpl decompressor(10, nullptr, 4096);
+  Buffer::OwnedImpl output_buffer;
+  decompressor.decompress(compressed, output_buffer);
+  EXPECT_EQ(ZSTD_error_frameParameter_windowTooLarge, decompressor.decompression_error_);
+}
+
+TEST_F(ZstdDecompressorImplTest, CorruptedInput) {
+  Buffer::OwnedImpl input_buffer;
+  TestUtility::feedBufferWithRandomCharacters(input_buffer, 100);
+  ZstdDecompressorImpl decompressor(default_window_log_max, nullptr, 4096);
+  Buffer::OwnedImpl output_buffer;
+  decompressor.decompress(input_buffer, output_buffer);
+  EXPECT_NE(0, decompressor.decompression_error_);
+}
+
+// The dictionary of each stream is selected by its ID.
+TEST_F(ZstdDecompressorImplTest, SelectDictionary) {
+  auto dictionaries =
+      std::make_shared<const ZstdDDicts>(std::vector<std::string>{dictionary(1), dictionary(2)});
+  for (uint32_t id : {1, 2}) {
+    const std::string original_text = absl::StrCat("{\"order_id\":\"ord-00000", id, "\"}");
+    Buffer::OwnedImpl compressed = compress(original_text, absl::nullopt, dictionary(id));
+
+    ZstdDecompressorImpl decompressor(default_window_log_max, dictionaries, 4096);
+    Buffer::OwnedImpl output_buffer;
+    decompressor.decompress(compressed, output_buffer);
+    EXPECT_EQ(0, decompressor.decompression_error_);
+    EXPECT_EQ(original_text, output_buffer.toString());
+  }
+}
+
+TEST_F(ZstdDecompressorImplTest, MissingDictionary) {
+  auto dictionaries = std::make_shared<const ZstdDDicts>(std::vector<std::string>{dictionary(1)});
+  Buffer::OwnedImpl compressed = compress("{\"order_id\":\"ord-000001\"}", absl::nullopt,
+                                          dictionary(2));
+
+  ZstdDecompressorImpl decompressor(default_window_log_max, dictionaries, 4096);
+  Buffer::OwnedImpl output_buffer;
+  decompressor.decompress(compressed, output_buffer);
+  EXPECT_EQ(ZSTD_error_dictionary_wrong, decompressor.decompression_error_);
+}
+
+TEST_F(ZstdDecompressorImplTest, DuplicateDictionaryId) {
+  EXPECT_THROW_WITH_MESSAGE(ZstdDDicts(std::vector<std::string>{dictionary(1), dictionary(1)}),
+                            EnvoyException, "duplicate zstd dictionary ID 1");
+}
+
+TEST(ZstdDecompressorFactoryTest, CreateDecompressor) {
+  Api::ApiPtr api = Api::createApiForTest();
+  envoy::extensions::compression::zstd::decompressor::v3::Zstd zstd;
+  zstd.add_dictionaries()->set_filename(TestEnvironment::substitute(
+      "{{ test_rundir }}/test/extensions/compression/zstd/test_data/dictionary_1"));
+  ZstdDecompressorFactory factory(zstd, *api);
+  EXPECT_EQ("zstd", factory.contentEncoding());
+  EXPECT_EQ("zstd.", factory.statsPrefix());
+  EXPECT_NE(nullptr, factory.createDecompressor());
+}
+
+} // namespace
+} // namespace Decompressor
+} // namespace Zstd
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,65 @@
+#include <memory>
+#include <string>
+
+#include "extensions/filters/http/common/compressor/compressed_variant_cache.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Common {
+namespace Compressors {
+namespace {
+
+CompressedVariantSharedPtr variant(size_t size) {
+  return std::make_shared<const std::string>(size, 'a');
+}
+
+TEST(CompressedVariantCacheTest, LookupAndReplace) {
+  CompressedVariantCache cache(100, 50);
+  EXPECT_EQ(50, cache.maxBodyBytes());
+  EXPECT_EQ(nullptr, cache.lookup("key"));
+
+  CompressedVariantSharedPtr first = variant(10);
+  EXPECT_EQ(0, cache.insert("key", first));
+  EXPECT_EQ(first, cache.lookup("key"));
+
+  CompressedVariantSharedPtr second = variant(20);
+  EXPECT_EQ(0, cache.insert("key", second));
+  EXPECT_EQ(second, cache.lookup("key"));
+  EXPECT_EQ(1, cache.size());
+  EXPECT_EQ(20, cache.bytes());
+}
+
+TEST(CompressedVariantCacheTest, EvictLeastRecentlyUsed) {
+  CompressedVariantCache cache(100, 100);
+  cache.insert("a", variant(40));
+  cache.insert("b", variant(40));
+  // Use "a" again, so that "b" is evicted next.
+  cache.lookup("a");
+  EXPECT_EQ(1, cache.insert("c", variant(40)));
+  EXPECT_NE(nullptr, cache.lookup("a"));
+  EXPECT_EQ(nullptr, cache.lookup("b"));
+  EXPECT_NE(nullptr, cache.lookup("c"));
+  EXPECT_EQ(80, cache.bytes());
+
+  EXPECT_EQ(2, cache.insert("d", variant(100)));
+  EXPECT_EQ(1, cache.size());
+  EXPECT_EQ(100, cache.bytes());
+}
+
+TEST(CompressedVariantCacheTest, VariantLargerThanCache) {
+  CompressedVariantCache cache(100, 100);
+  cache.insert("a", variant(40));
+  EXPECT_EQ(0, cache.insert("b", variant(101)));
+  EXPECT_EQ(nullptr, cache.lookup("b"));
+  EXPECT_NE(nullptr, cache.lookup("a"));
+}
+
+} // namespace
+} // namespace Compressors
+} // namespace Common
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
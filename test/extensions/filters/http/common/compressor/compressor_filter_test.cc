@@ -34,6 +34,7 @@ public:
                                compressor_name) {}
 
   Envoy::Compression::Compressor::CompressorPtr makeCompressor() override {
+    ++compressors_created_;
     auto compressor = std::make_unique<Compression::Compressor::MockCompressor>();
     EXPECT_CALL(*compressor, compress(_, _)).Times(expected_compress_calls_);
     return compressor;
@@ -41,6 +42,8 @@ public:
 
   void setExpectedCompressCalls(uint32_t calls) { expected_compress_calls_ = calls; }
 
+  uint32_t compressors_created_{0};
+
 private:
   uint32_t expected_compress_calls_{1};
 };
@@ -1038,6 +1041,169 @@ TEST_F(CompressorFilterTest, RemoveAcceptEncodingHeader) {
   }
 }
 
+class CompressedVariantCacheTest : public CompressorFilterTest {
+protected:
+  void SetUp() override {
+    setUpFilter(R"EOF(
+{
+  "compressed_variant_cache": {
+    "max_cache_bytes": 4096,
+    "max_body_bytes": 1024
+  },
+  "compressor_library": {
+     "typed_config": {
+       "@type": "type.googleapis.com/envoy.extensions.compression.gzip.compressor.v3.Gzip"
+     }
+  }
+}
+)EOF");
+  }
+
+  // Send a response through a new filter sharing the config, in two chunks. The mock compressor
+  // leaves the data as is.
+  std::string doCachedResponse(Http::TestResponseHeaderMapImpl&& headers, const std::string& body,
+                               const std::string& path = "/asset.js") {
+    filter_ = std::make_unique<CompressorFilter>(config_);
+    filter_->setEncoderFilterCallbacks(encoder_callbacks_);
+    NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
+    filter_->setDecoderFilterCallbacks(decoder_callbacks);
+    doRequest({{":method", "get"},
+               {":authority", "example.com"},
+               {":path", path},
+               {"accept-encoding", "test"}},
+              false);
+
+    headers.setContentLength(body.size());
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+    EXPECT_EQ("test", headers.get_("content-encoding"));
+    std::string sent;
+    Buffer::OwnedImpl first_chunk(body.substr(0, body.size() / 2));
+    const Http::FilterDataStatus status = filter_->encodeData(first_chunk, false);
+    if (status == Http::FilterDataStatus::Continue) {
+      sent = first_chunk.toString();
+    } else {
+      EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, status);
+      EXPECT_EQ(0, first_chunk.length());
+    }
+    Buffer::OwnedImpl last_chunk(body.substr(body.size() / 2));
+    EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->encodeData(last_chunk, true));
+    return sent + last_chunk.toString();
+  }
+
+  uint64_t counter(const std::string& name) {
+    return stats_.counter("test.test.compressed_variant_cache_" + name).value();
+  }
+
+  const std::string body_ = std::string(256, 'a') + std::string(256, 'b');
+};
+
+// Responses without an etag are buffered, and looked up by the SHA-256 digest of their body.
+TEST_F(CompressedVariantCacheTest, LookupByBody) {
+  EXPECT_EQ(body_, doCachedResponse({{":status", "200"}}, body_));
+  EXPECT_EQ(1, counter("miss"));
+  EXPECT_EQ(1, config_->compressors_created_);
+
+  EXPECT_EQ(body_, doCachedResponse({{":status", "200"}}, body_, "/other.js"));
+  EXPECT_EQ(1, counter("hit"));
+  EXPECT_EQ(1, config_->compressors_created_);
+
+  EXPECT_EQ(body_ + "c", doCachedResponse({{":status", "200"}}, body_ + "c"));
+  EXPECT_EQ(2, counter("miss"));
+  EXPECT_EQ(2, config_->compressors_created_);
+
+  // Bodies of the same length are only served each other's variant if identical.
+  const std::string other_body = std::string(256, 'b') + std::string(256, 'a');
+  EXPECT_EQ(other_body, doCachedResponse({{":status", "200"}}, other_body));
+  EXPECT_EQ(3, counter("miss"));
+  EXPECT_EQ(3, config_->compressors_created_);
+  EXPECT_EQ(3, config_->compressedVariantCache()->size());
+}
+
+// Responses with a strong etag are looked up before their body is received, and their body is
+// replaced with the cached variant.
+TEST_F(CompressedVariantCacheTest, LookupByEtag) {
+  config_->setExpectedCompressCalls(2);
+  EXPECT_EQ(body_, doCachedResponse({{":status", "200"}, {"etag", "\"v1\""}}, body_));
+  EXPECT_EQ(1, counter("miss"));
+
+  Http::TestResponseHeaderMapImpl headers{{":status", "200"}, {"etag", "\"v1\""}};
+  EXPECT_EQ(body_, doCachedResponse(std::move(headers), std::string(512, 'x')));
+  EXPECT_EQ(1, counter("hit"));
+  EXPECT_EQ(1, config_->compressors_created_);
+
+  // The etag is specific to the resource.
+  EXPECT_EQ(std::string(512, 'x'),
+            doCachedResponse({{":status", "200"}, {"etag", "\"v1\""}}, std::string(512, 'x'),
+                             "/other.js"));
+  EXPECT_EQ(2, counter("miss"));
+}
+
+// Partial responses share the etag of the complete response, but not its body.
+TEST_F(CompressedVariantCacheTest, PartialResponsesNotCached) {
+  config_->setExpectedCompressCalls(2);
+  const std::string partial_body(256, 'a');
+  EXPECT_EQ(partial_body,
+            doCachedResponse({{":status", "206"},
+                              {"etag", "\"v1\""},
+                              {"content-range", "bytes 0-255/512"}},
+                             partial_body));
+  EXPECT_EQ(0, counter("miss"));
+  EXPECT_EQ(0, config_->compressedVariantCache()->size());
+
+  EXPECT_EQ(body_, doCachedResponse({{":status", "200"}, {"etag", "\"v1\""}}, body_));
+  EXPECT_EQ(1, counter("miss"));
+  EXPECT_EQ(0, counter("hit"));
+
+  // The complete variant is not served for a partial response either.
+  EXPECT_EQ(partial_body,
+            doCachedResponse({{":status", "206"},
+                              {"etag", "\"v1\""},
+                              {"content-range", "bytes 0-255/512"}},
+                             partial_body));
+  EXPECT_EQ(0, counter("hit"));
+  EXPECT_EQ(1, config_->compressedVariantCache()->size());
+}
+
+// Weak etags don't guarantee identical bodies.
+TEST_F(CompressedVariantCacheTest, WeakEtagLookupByBody) {
+  EXPECT_EQ(body_, doCachedResponse({{":status", "200"}, {"etag", "W/\"v1\""}}, body_));
+  const std::string other_body(512, 'x');
+  EXPECT_EQ(other_body,
+            doCachedResponse({{":status", "200"}, {"etag", "W/\"v1\""}}, other_body));
+  EXPECT_EQ(2, counter("miss"));
+  EXPECT_EQ(0, counter("hit"));
+}
+
+// Responses larger than max_body_bytes are compressed as usual, without buffering.
+TEST_F(CompressedVariantCacheTest, BodyTooLarge) {
+  config_->setExpectedCompressCalls(2);
+  const std::string body(2048, 'a');
+  EXPECT_EQ(body, doCachedResponse({{":status", "200"}}, body));
+  EXPECT_EQ(0, counter("miss"));
+  EXPECT_EQ(0, config_->compressedVariantCache()->size());
+}
+
+TEST_F(CompressedVariantCacheTest, ServeCachedVariantWithTrailers) {
+  doCachedResponse({{":status", "200"}}, body_);
+
+  filter_ = std::make_unique<CompressorFilter>(config_);
+  filter_->setEncoderFilterCallbacks(encoder_callbacks_);
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
+  filter_->setDecoderFilterCallbacks(decoder_callbacks);
+  doRequest({{":method", "get"}, {"accept-encoding", "test"}}, false);
+  Http::TestResponseHeaderMapImpl headers{{":status", "200"}, {"content-length", "512"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+  Buffer::OwnedImpl data(body_);
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(data, false));
+  std::string sent;
+  EXPECT_CALL(encoder_callbacks_, addEncodedData(_, true))
+      .WillOnce(Invoke([&](Buffer::Instance& data, bool) { sent = data.toString(); }));
+  Http::TestResponseTrailerMapImpl trailers;
+  EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter_->encodeTrailers(trailers));
+  EXPECT_EQ(body_, sent);
+  EXPECT_EQ(1, counter("hit"));
+}
+
 } // namespace Compressors
 } // namespace Common
 } // namespace HttpFilters
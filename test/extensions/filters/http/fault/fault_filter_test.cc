@@ -1245,13 +1245,14 @@ TEST_F(FaultFilterSettingsTest, CheckDefaultRuntimeKeys) {
 
   Fault::FaultSettings settings(fault);
 
-  EXPECT_EQ("fault.http.delay.fixed_delay_percent", settings.delayPercentRuntime());
-  EXPECT_EQ("fault.http.abort.abort_percent", settings.abortPercentRuntime());
-  EXPECT_EQ("fault.http.delay.fixed_duration_ms", settings.delayDurationRuntime());
-  EXPECT_EQ("fault.http.abort.http_status", settings.abortHttpStatusRuntime());
-  EXPECT_EQ("fault.http.abort.grpc_status", settings.abortGrpcStatusRuntime());
-  EXPECT_EQ("fault.http.max_active_faults", settings.maxActiveFaultsRuntime());
-  EXPECT_EQ("fault.http.rate_limit.response_percent", settings.responseRateLimitPercentRuntime());
+  EXPECT_EQ("fault.http.delay.fixed_delay_percent", settings.delayPercentRuntime().name());
+  EXPECT_EQ("fault.http.abort.abort_percent", settings.abortPercentRuntime().name());
+  EXPECT_EQ("fault.http.delay.fixed_duration_ms", settings.delayDurationRuntime().name());
+  EXPECT_EQ("fault.http.abort.http_status", settings.abortHttpStatusRuntime().name());
+  EXPECT_EQ("fault.http.abort.grpc_status", settings.abortGrpcStatusRuntime().name());
+  EXPECT_EQ("fault.http.max_active_faults", settings.maxActiveFaultsRuntime().name());
+  EXPECT_EQ("fault.http.rate_limit.response_percent",
+            settings.responseRateLimitPercentRuntime().name());
 }
 
 TEST_F(FaultFilterSettingsTest, CheckOverrideRuntimeKeys) {
@@ -1267,14 +1268,14 @@ TEST_F(FaultFilterSettingsTest, CheckOverrideRuntimeKeys) {
 
   Fault::FaultSettings settings(fault);
 
-  EXPECT_EQ("fault.delay_percent_runtime", settings.delayPercentRuntime());
-  EXPECT_EQ("fault.abort_percent_runtime", settings.abortPercentRuntime());
-  EXPECT_EQ("fault.delay_duration_runtime", settings.delayDurationRuntime());
-  EXPECT_EQ("fault.abort_http_status_runtime", settings.abortHttpStatusRuntime());
-  EXPECT_EQ("fault.abort_grpc_status_runtime", settings.abortGrpcStatusRuntime());
-  EXPECT_EQ("fault.max_active_faults_runtime", settings.maxActiveFaultsRuntime());
+  EXPECT_EQ("fault.delay_percent_runtime", settings.delayPercentRuntime().name());
+  EXPECT_EQ("fault.abort_percent_runtime", settings.abortPercentRuntime().name());
+  EXPECT_EQ("fault.delay_duration_runtime", settings.delayDurationRuntime().name());
+  EXPECT_EQ("fault.abort_http_status_runtime", settings.abortHttpStatusRuntime().name());
+  EXPECT_EQ("fault.abort_grpc_status_runtime", settings.abortGrpcStatusRuntime().name());
+  EXPECT_EQ("fault.max_active_faults_runtime", settings.maxActiveFaultsRuntime().name());
   EXPECT_EQ("fault.response_rate_limit_percent_runtime",
-            settings.responseRateLimitPercentRuntime());
+            settings.responseRateLimitPercentRuntime().name());
 }
 
 } // namespace
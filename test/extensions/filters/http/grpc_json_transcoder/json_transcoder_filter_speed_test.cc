@@ -0,0 +1,130 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "envoy/extensions/filters/http/grpc_json_transcoder/v3/transcoder.pb.h"
+
+#include "common/buffer/buffer_impl.h"
+#include "common/grpc/common.h"
+#include "common/protobuf/protobuf.h"
+
+#include "extensions/filters/http/grpc_json_transcoder/json_transcoder_filter.h"
+
+#include "test/mocks/http/mocks.h"
+#include "test/proto/bookstore.pb.h"
+#include "test/test_common/utility.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcJsonTranscoder {
+
+namespace {
+
+// Add a file and its dependencies to a descriptor set, dependencies first.
+void addFileDescriptor(const Protobuf::FileDescriptor& file,
+                       absl::flat_hash_set<std::string>& added,
+                       Protobuf::FileDescriptorSet& descriptor_set) {
+  if (!added.insert(file.name()).second) {
+    return;
+  }
+  for (int i = 0; i < file.dependency_count(); i++) {
+    addFileDescriptor(*file.dependency(i), added, descriptor_set);
+  }
+  file.CopyTo(descriptor_set.add_file());
+}
+
+} // namespace
+
+// A transcoder config of the bookstore service, loaded from the descriptors linked in the binary.
+class SpeedTestConfig {
+public:
+  SpeedTestConfig() : api_(Api::createApiForTest()) {
+    Protobuf::FileDescriptorSet descriptor_set;
+    absl::flat_hash_set<std::string> added;
+    addFileDescriptor(*bookstore::Bookstore::descriptor()->file(), added, descriptor_set);
+
+    envoy::extensions::filters::http::grpc_json_transcoder::v3::GrpcJsonTranscoder proto_config;
+    descriptor_set.SerializeToString(proto_config.mutable_proto_descriptor_bin());
+    proto_config.add_services("bookstore.Bookstore");
+    config_ = std::make_unique<JsonTranscoderConfig>(proto_config, *api_);
+  }
+
+  JsonTranscoderConfig& config() { return *config_; }
+
+private:
+  Api::ApiPtr api_;
+  std::unique_ptr<JsonTranscoderConfig> config_;
+};
+
+} // namespace GrpcJsonTranscoder
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
+
+// Transcoding of a JSON request with a large repeated field to a gRPC request.
+// Range arg is the number of elements of the repeated field.
+static void transcodeJsonRequest(benchmark::State& state) {
+  Envoy::Extensions::HttpFilters::GrpcJsonTranscoder::SpeedTestConfig config;
+  NiceMock<Envoy::Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
+
+  std::string body = R"({"id": 1, "author": "author", "title": "title", "quotes": [)";
+  for (int64_t i = 0; i < state.range(0); i++) {
+    absl::StrAppend(&body, i == 0 ? "" : ", ", "\"quote number ", i, "\"");
+  }
+  body += "]}";
+
+  for (auto _ : state) {
+    Envoy::Extensions::HttpFilters::GrpcJsonTranscoder::JsonTranscoderFilter filter(
+        config.config());
+    filter.setDecoderFilterCallbacks(decoder_callbacks);
+    Envoy::Http::TestRequestHeaderMapImpl headers{{":method", "PUT"},
+                                                  {":path", "/shelves/1/books"},
+                                                  {"content-type", "application/json"}};
+    filter.decodeHeaders(headers, false);
+    Envoy::Buffer::OwnedImpl data(body);
+    filter.decodeData(data, true);
+    benchmark::DoNotOptimize(data.length());
+  }
+}
+BENCHMARK(transcodeJsonRequest)->Range(16, 65536)->Unit(benchmark::kMicrosecond);
+
+// Transcoding of a gRPC response with a large repeated field to a JSON response.
+// Range arg is the number of elements of the repeated field.
+static void transcodeGrpcResponse(benchmark::State& state) {
+  Envoy::Extensions::HttpFilters::GrpcJsonTranscoder::SpeedTestConfig config;
+  NiceMock<Envoy::Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
+  NiceMock<Envoy::Http::MockStreamEncoderFilterCallbacks> encoder_callbacks;
+
+  bookstore::ListShelvesResponse response;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    auto* shelf = response.add_shelves();
+    shelf->set_id(i);
+    shelf->set_theme(absl::StrCat("theme number ", i));
+  }
+  const std::string frame = Envoy::Grpc::Common::serializeToGrpcFrame(response)->toString();
+
+  for (auto _ : state) {
+    Envoy::Extensions::HttpFilters::GrpcJsonTranscoder::JsonTranscoderFilter filter(
+        config.config());
+    filter.setDecoderFilterCallbacks(decoder_callbacks);
+    filter.setEncoderFilterCallbacks(encoder_callbacks);
+    Envoy::Http::TestRequestHeaderMapImpl request_headers{{":method", "GET"},
+                                                          {":path", "/shelves"}};
+    filter.decodeHeaders(request_headers, true);
+    Envoy::Http::TestResponseHeaderMapImpl response_headers{{"content-type", "application/grpc"},
+                                                            {":status", "200"}};
+    filter.encodeHeaders(response_headers, false);
+    Envoy::Buffer::OwnedImpl data(frame);
+    filter.encodeData(data, true);
+    benchmark::DoNotOptimize(data.length());
+  }
+}
+BENCHMARK(transcodeGrpcResponse)->Range(16, 65536)->Unit(benchmark::kMicrosecond);
@@ -5,13 +5,18 @@
 #include "extensions/filters/http/on_demand/on_demand_update.h"
 
 #include "test/mocks/http/mocks.h"
+#include "test/mocks/protobuf/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/upstream/mocks.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::ByMove;
+using testing::Invoke;
 using testing::Return;
+using testing::ReturnRef;
 
 namespace Envoy {
 namespace Extensions {
@@ -104,6 +109,102 @@ TEST_F(OnDemandFilterTest, OnRouteConfigUpdateCompletionRestartsActiveStream) {
   filter_->onRouteConfigUpdateCompletion(true);
 }
 
+class OnDemandClusterFilterTest : public testing::Test {
+public:
+  void SetUp() override {
+    const std::string yaml = R"EOF(
+odcds:
+  source:
+    ads: {}
+  timeout: 2s
+  idle_timeout: 60s
+)EOF";
+    envoy::extensions::filters::http::on_demand::v3::OnDemand proto_config;
+    TestUtility::loadFromYaml(yaml, proto_config);
+    auto odcds = std::make_unique<Upstream::MockOdCdsApiHandle>();
+    odcds_ = odcds.get();
+    EXPECT_CALL(cm_, allocateOdCdsApi(_, std::chrono::milliseconds(60000), _))
+        .WillOnce(Return(ByMove(std::move(odcds))));
+    auto config = std::make_shared<OnDemandFilterConfig>(proto_config, cm_, validation_visitor_);
+    filter_ = std::make_unique<OnDemandRouteUpdate>(config);
+    filter_->setDecoderFilterCallbacks(decoder_callbacks_);
+  }
+
+  // Make the route of the request lead to an unknown cluster.
+  void setUnknownCluster() {
+    EXPECT_CALL(decoder_callbacks_, clusterInfo()).WillOnce(Return(nullptr));
+    ON_CALL(decoder_callbacks_.route_->route_entry_, clusterName())
+        .WillByDefault(ReturnRef(cluster_name_));
+  }
+
+  NiceMock<Upstream::MockClusterManager> cm_;
+  NiceMock<ProtobufMessage::MockValidationVisitor> validation_visitor_;
+  Upstream::MockOdCdsApiHandle* odcds_{};
+  std::unique_ptr<OnDemandRouteUpdate> filter_;
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks_;
+  const std::string cluster_name_{"unknown_cluster"};
+};
+
+// tests decodeHeaders() when the cluster of the route is known
+TEST_F(OnDemandClusterFilterTest, DecodeHeadersWhenClusterAvailable) {
+  Http::TestRequestHeaderMapImpl headers;
+  EXPECT_CALL(*odcds_, requestOnDemandClusterDiscovery(_, _, _)).Times(0);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(headers, true));
+}
+
+// tests decodeHeaders() when the cluster of the route becomes available while being requested
+TEST_F(OnDemandClusterFilterTest, DecodeHeadersWhenClusterAvailableOnRequest) {
+  Http::TestRequestHeaderMapImpl headers;
+  setUnknownCluster();
+  EXPECT_CALL(*odcds_, requestOnDemandClusterDiscovery("unknown_cluster", _, _))
+      .WillOnce(Invoke([](const std::string&, Upstream::ClusterDiscoveryCallbackPtr callback,
+                          std::chrono::milliseconds) {
+        (*callback)(Upstream::ClusterDiscoveryStatus::Available);
+        return nullptr;
+      }));
+  EXPECT_CALL(decoder_callbacks_, continueDecoding()).Times(0);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(headers, true));
+}
+
+// tests decodeHeaders() and decodeData() while the cluster of the route is being discovered, until
+// it is available
+TEST_F(OnDemandClusterFilterTest, DecodeHeadersStopsUntilClusterAvailable) {
+  Http::TestRequestHeaderMapImpl headers;
+  Buffer::OwnedImpl buffer;
+  setUnknownCluster();
+  Upstream::ClusterDiscoveryCallbackPtr callback;
+  EXPECT_CALL(*odcds_, requestOnDemandClusterDiscovery("unknown_cluster", _,
+                                                       std::chrono::milliseconds(2000)))
+      .WillOnce(Invoke([&callback](const std::string&, Upstream::ClusterDiscoveryCallbackPtr cb,
+                                   std::chrono::milliseconds) {
+        callback = std::move(cb);
+        return std::make_unique<Upstream::MockClusterDiscoveryCallbackHandle>();
+      }));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration, filter_->decodeHeaders(headers, false));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationAndWatermark, filter_->decodeData(buffer, false));
+
+  EXPECT_CALL(decoder_callbacks_, clearRouteCache());
+  EXPECT_CALL(decoder_callbacks_, continueDecoding());
+  (*callback)(Upstream::ClusterDiscoveryStatus::Available);
+  EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->decodeData(buffer, true));
+}
+
+// tests onClusterDiscoveryCompletion() when the cluster could not be discovered
+TEST_F(OnDemandClusterFilterTest, OnClusterDiscoveryCompletionContinuesDecodingWhenMissing) {
+  filter_->setFilterIterationState(Http::FilterHeadersStatus::StopIteration);
+  EXPECT_CALL(decoder_callbacks_, clearRouteCache()).Times(0);
+  EXPECT_CALL(decoder_callbacks_, continueDecoding());
+  filter_->onClusterDiscoveryCompletion(Upstream::ClusterDiscoveryStatus::Missing);
+}
+
+// tests onClusterDiscoveryCompletion() when the discovery of the cluster timed out
+TEST_F(OnDemandClusterFilterTest, OnClusterDiscoveryCompletionContinuesDecodingOnTimeout) {
+  filter_->setFilterIterationState(Http::FilterHeadersStatus::StopIteration);
+  EXPECT_CALL(decoder_callbacks_, clearRouteCache()).Times(0);
+  EXPECT_CALL(decoder_callbacks_, continueDecoding());
+  filter_->onClusterDiscoveryCompletion(Upstream::ClusterDiscoveryStatus::Timeout);
+}
+
 } // namespace OnDemand
 } // namespace HttpFilters
 } // namespace Extensions
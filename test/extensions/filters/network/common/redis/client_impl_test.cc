@@ -187,6 +187,7 @@ class ConfigBufferSizeGTSingleRequest : public Config {
   std::chrono::milliseconds bufferFlushTimeoutInMs() const override {
     return std::chrono::milliseconds(1);
   }
+  bool enableAutoPipelining() const override { return false; }
   uint32_t maxUpstreamUnknownConnections() const override { return 0; }
   bool enableCommandStats() const override { return false; }
   ReadPolicy readPolicy() const override { return ReadPolicy::Master; }
@@ -285,6 +286,62 @@ TEST_F(RedisClientImplTest, BatchWithTimerCancelledByBufferFlush) {
   client_->close();
 }
 
+class ConfigAutoPipelining : public Config {
+  bool disableOutlierEvents() const override { return false; }
+  std::chrono::milliseconds opTimeout() const override { return std::chrono::milliseconds(25); }
+  bool enableHashtagging() const override { return false; }
+  bool enableRedirection() const override { return false; }
+  unsigned int maxBufferSizeBeforeFlush() const override { return 0; }
+  std::chrono::milliseconds bufferFlushTimeoutInMs() const override {
+    return std::chrono::milliseconds(3);
+  }
+  bool enableAutoPipelining() const override { return true; }
+  uint32_t maxUpstreamUnknownConnections() const override { return 0; }
+  bool enableCommandStats() const override { return false; }
+  ReadPolicy readPolicy() const override { return ReadPolicy::Master; }
+};
+
+TEST_F(RedisClientImplTest, AutoPipelining) {
+  // The first request is written right away since no other one is outstanding, while the next
+  // ones are written together once the event loop iteration ends.
+  InSequence s;
+
+  setup(std::make_unique<ConfigAutoPipelining>());
+
+  Common::Redis::RespValue request1;
+  MockClientCallbacks callbacks1;
+  EXPECT_CALL(*encoder_, encode(Ref(request1), _));
+  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(stats_, deliverHistogramToSinks(
+                          Property(&Stats::Metric::name, "upstream_commands.batch_size"), 1));
+  EXPECT_CALL(*upstream_connection_, write(_, false));
+  EXPECT_NE(nullptr, client_->makeRequest(request1, callbacks1));
+
+  Common::Redis::RespValue request2;
+  MockClientCallbacks callbacks2;
+  EXPECT_CALL(*encoder_, encode(Ref(request2), _));
+  EXPECT_CALL(*flush_timer_, enableTimer(std::chrono::milliseconds(0), _));
+  EXPECT_NE(nullptr, client_->makeRequest(request2, callbacks2));
+
+  Common::Redis::RespValue request3;
+  MockClientCallbacks callbacks3;
+  EXPECT_CALL(*encoder_, encode(Ref(request3), _));
+  EXPECT_NE(nullptr, client_->makeRequest(request3, callbacks3));
+
+  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(stats_, deliverHistogramToSinks(
+                          Property(&Stats::Metric::name, "upstream_commands.batch_size"), 2));
+  EXPECT_CALL(*upstream_connection_, write(_, false));
+  flush_timer_->invokeCallback();
+
+  EXPECT_CALL(*upstream_connection_, close(Network::ConnectionCloseType::NoFlush));
+  EXPECT_CALL(callbacks1, onFailure());
+  EXPECT_CALL(callbacks2, onFailure());
+  EXPECT_CALL(callbacks3, onFailure());
+  EXPECT_CALL(*connect_or_op_timer_, disableTimer());
+  client_->close();
+}
+
 TEST_F(RedisClientImplTest, Basic) {
   InSequence s;
 
@@ -346,6 +403,7 @@ class ConfigEnableCommandStats : public Config {
   std::chrono::milliseconds bufferFlushTimeoutInMs() const override {
     return std::chrono::milliseconds(0);
   }
+  bool enableAutoPipelining() const override { return false; }
   ReadPolicy readPolicy() const override { return ReadPolicy::Master; }
   uint32_t maxUpstreamUnknownConnections() const override { return 0; }
   bool enableCommandStats() const override { return true; }
@@ -709,6 +767,7 @@ class ConfigOutlierDisabled : public Config {
   std::chrono::milliseconds bufferFlushTimeoutInMs() const override {
     return std::chrono::milliseconds(0);
   }
+  bool enableAutoPipelining() const override { return false; }
   ReadPolicy readPolicy() const override { return ReadPolicy::Master; }
   uint32_t maxUpstreamUnknownConnections() const override { return 0; }
   bool enableCommandStats() const override { return false; }
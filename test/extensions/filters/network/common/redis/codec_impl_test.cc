@@ -9,6 +9,7 @@
 #include "test/test_common/printers.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gtest/gtest.h"
 
 using testing::ContainerEq;
@@ -215,6 +216,48 @@ TEST_F(RedisRespValueTest, CompositeArrayTest) {
   validateIterator(empty, {});
 }
 
+TEST_F(RedisRespValueTest, BufferedBulkStringTest) {
+  RespValue value;
+  value.type(RespType::BulkString);
+  EXPECT_EQ(nullptr, value.bulkStringBuffer());
+  auto buffer = std::make_shared<Buffer::OwnedImpl>("foo");
+  value.bulkStringBuffer(buffer);
+  EXPECT_EQ(buffer, value.bulkStringBuffer());
+
+  const RespValue& const_value = value;
+  EXPECT_EQ("foo", const_value.asString());
+  EXPECT_EQ("\"foo\"", value.toString());
+
+  RespValue string_value;
+  string_value.type(RespType::BulkString);
+  string_value.asString() = "foo";
+  EXPECT_TRUE(value == string_value);
+
+  // Copies share the buffer.
+  RespValue copy = value;
+  EXPECT_EQ(buffer, copy.bulkStringBuffer());
+  RespValue copy_assign;
+  copy_assign = value;
+  EXPECT_EQ(buffer, copy_assign.bulkStringBuffer());
+  verifyMoves(value);
+
+  // Moved from values hold an empty string.
+  RespValue move(std::move(copy));
+  EXPECT_EQ(buffer, move.bulkStringBuffer());
+  EXPECT_EQ(nullptr, copy.bulkStringBuffer());
+  EXPECT_EQ("", copy.asString());
+  RespValue move_assign;
+  move_assign = std::move(copy_assign);
+  EXPECT_EQ(buffer, move_assign.bulkStringBuffer());
+  EXPECT_EQ(nullptr, copy_assign.bulkStringBuffer());
+
+  // The non-const accessor converts the value to a string, leaving the buffer untouched.
+  value.asString().append("bar");
+  EXPECT_EQ(nullptr, value.bulkStringBuffer());
+  EXPECT_EQ("foobar", value.asString());
+  EXPECT_EQ("foo", buffer->toString());
+}
+
 class RedisEncoderDecoderImplTest : public testing::Test, public DecoderCallbacks {
 public:
   RedisEncoderDecoderImplTest() : decoder_(*this) {}
@@ -276,6 +319,61 @@ TEST_F(RedisEncoderDecoderImplTest, BulkString) {
   EXPECT_EQ(0UL, buffer_.length());
 }
 
+// Large bulk strings are moved into a buffer by the decoder, which the encoder then references.
+TEST_F(RedisEncoderDecoderImplTest, LargeBulkString) {
+  const std::string body(DecoderImpl::BufferedBulkStringMinSize * 4 + 3, 'a');
+  RespValue value;
+  value.type(RespType::BulkString);
+  value.asString() = body;
+  encoder_.encode(value, buffer_);
+  encoder_.encode(value, buffer_);
+  const std::string encoded = absl::StrCat("$", body.size(), "\r\n", body, "\r\n");
+  EXPECT_EQ(encoded + encoded, buffer_.toString());
+  decoder_.decode(buffer_);
+  EXPECT_EQ(0UL, buffer_.length());
+  ASSERT_EQ(2UL, decoded_values_.size());
+  for (const RespValuePtr& decoded : decoded_values_) {
+    ASSERT_NE(nullptr, decoded->bulkStringBuffer());
+    EXPECT_EQ(body.size(), decoded->bulkStringBuffer()->length());
+    EXPECT_EQ(value, *decoded);
+  }
+
+  // Encoding does not consume the buffer, so that values can be encoded again.
+  Buffer::OwnedImpl out;
+  encoder_.encode(*decoded_values_[0], out);
+  encoder_.encode(*decoded_values_[0], out);
+  EXPECT_EQ(body.size(), decoded_values_[0]->bulkStringBuffer()->length());
+  decoded_values_.clear();
+  decoder_.decode(out);
+  ASSERT_EQ(2UL, decoded_values_.size());
+  EXPECT_EQ(value, *decoded_values_[0]);
+  EXPECT_EQ(value, *decoded_values_[1]);
+}
+
+// Large bulk strings may be received in pieces of any size.
+TEST_F(RedisEncoderDecoderImplTest, LargeBulkStringPartial) {
+  std::vector<RespValue> values(2);
+  values[0].type(RespType::BulkString);
+  values[0].asString() = std::string(DecoderImpl::BufferedBulkStringMinSize, 'a');
+  values[1].type(RespType::BulkString);
+  values[1].asString() = "b";
+  RespValue value;
+  value.type(RespType::Array);
+  value.asArray().swap(values);
+  encoder_.encode(value, buffer_);
+
+  const std::string encoded = buffer_.toString();
+  for (uint64_t i = 0; i < encoded.size(); i += 1000) {
+    Buffer::OwnedImpl temp_buffer(encoded.substr(i, 1000));
+    decoder_.decode(temp_buffer);
+    EXPECT_EQ(0UL, temp_buffer.length());
+  }
+
+  ASSERT_EQ(1UL, decoded_values_.size());
+  EXPECT_NE(nullptr, decoded_values_[0]->asArray()[0].bulkStringBuffer());
+  EXPECT_EQ(value, *decoded_values_[0]);
+}
+
 TEST_F(RedisEncoderDecoderImplTest, Integer) {
   RespValue value;
   value.type(RespType::Integer);
@@ -428,6 +526,12 @@ TEST_F(RedisEncoderDecoderImplTest, InvalidBulkStringExpectLF) {
   EXPECT_THROW(decoder_.decode(buffer_), ProtocolError);
 }
 
+TEST_F(RedisEncoderDecoderImplTest, InvalidLargeBulkStringExpectCR) {
+  buffer_.add(absl::StrCat("$", DecoderImpl::BufferedBulkStringMinSize, "\r\n",
+                           std::string(DecoderImpl::BufferedBulkStringMinSize + 1, 'a')));
+  EXPECT_THROW(decoder_.decode(buffer_), ProtocolError);
+}
+
 } // namespace Redis
 } // namespace Common
 } // namespace NetworkFilters
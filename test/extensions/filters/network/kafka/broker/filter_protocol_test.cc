@@ -35,7 +35,7 @@ class KafkaBrokerFilterProtocolTest : public testing::Test,
 protected:
   Stats::TestUtil::TestStore scope_;
   Event::TestRealTimeSystem time_source_;
-  KafkaBrokerFilter testee_{scope_, time_source_, "prefix"};
+  KafkaBrokerFilter testee_{scope_, time_source_, "prefix", false};
 
   Network::FilterStatus consumeRequestFromBuffer() {
     return testee_.onData(RequestB::buffer_, false);
@@ -154,6 +154,93 @@ TEST_F(KafkaBrokerFilterProtocolTest, ShouldProcessMessages) {
   }
 }
 
+class KafkaBrokerFilterSkippingProtocolTest : public testing::Test,
+                                              protected RequestB,
+                                              protected ResponseB {
+protected:
+  Stats::TestUtil::TestStore scope_;
+  Event::TestRealTimeSystem time_source_;
+  KafkaBrokerFilter testee_{scope_, time_source_, "prefix", true};
+
+  Network::FilterStatus consumeRequestFromBuffer() {
+    return testee_.onData(RequestB::buffer_, false);
+  }
+
+  Network::FilterStatus consumeResponseFromBuffer() {
+    return testee_.onWrite(ResponseB::buffer_, false);
+  }
+};
+
+TEST_F(KafkaBrokerFilterSkippingProtocolTest, ShouldProcessMessagesWithoutParsingPayloads) {
+  // given
+  for (const AbstractRequestSharedPtr& message : MessageUtilities::makeAllRequests()) {
+    RequestB::putMessageIntoBuffer(*message);
+  }
+  for (const AbstractResponseSharedPtr& message : MessageUtilities::makeAllResponses()) {
+    ResponseB::putMessageIntoBuffer(*message);
+  }
+
+  // when
+  const Network::FilterStatus result1 = consumeRequestFromBuffer();
+  const Network::FilterStatus result2 = consumeResponseFromBuffer();
+
+  // then
+  ASSERT_EQ(result1, Network::FilterStatus::Continue);
+  ASSERT_EQ(result2, Network::FilterStatus::Continue);
+
+  // Metrics should be the same as if the payloads had been parsed.
+  for (int16_t i = 0; i < MessageUtilities::apiKeys(); ++i) {
+    const Stats::Counter& request_counter = scope_.counter(MessageUtilities::requestMetric(i));
+    ASSERT_EQ(request_counter.value(), MessageUtilities::requestApiVersions(i));
+    const Stats::Counter& response_counter = scope_.counter(MessageUtilities::responseMetric(i));
+    ASSERT_EQ(response_counter.value(), MessageUtilities::responseApiVersions(i));
+  }
+}
+
+TEST_F(KafkaBrokerFilterSkippingProtocolTest,
+       ShouldHandleUnknownRequestAndResponseWithoutBreaking) {
+  // given
+  const int16_t unknown_api_key = std::numeric_limits<int16_t>::max();
+
+  const RequestHeader request_header = {unknown_api_key, 0, 0, "client-id"};
+  const ProduceRequest request_data = {0, 0, {}};
+  const Request<ProduceRequest> produce_request = {request_header, request_data};
+  RequestB::putMessageIntoBuffer(produce_request);
+
+  const ResponseMetadata response_metadata = {unknown_api_key, 0, 0};
+  const ProduceResponse response_data = {{}};
+  const Response<ProduceResponse> produce_response = {response_metadata, response_data};
+  ResponseB::putMessageIntoBuffer(produce_response);
+
+  // when
+  const Network::FilterStatus result1 = consumeRequestFromBuffer();
+  const Network::FilterStatus result2 = consumeResponseFromBuffer();
+
+  // then
+  ASSERT_EQ(result1, Network::FilterStatus::Continue);
+  ASSERT_EQ(result2, Network::FilterStatus::Continue);
+  ASSERT_EQ(scope_.counter("kafka.prefix.request.unknown").value(), 1);
+  ASSERT_EQ(scope_.counter("kafka.prefix.response.unknown").value(), 1);
+}
+
+TEST_F(KafkaBrokerFilterSkippingProtocolTest, ShouldHandleBrokenRequestHeader) {
+  // given
+
+  // Request header still gets parsed, so invalid client-id length breaks the parser.
+  RequestB::putIntoBuffer(BROKEN_MESSAGE_SIZE);
+  RequestB::putIntoBuffer(static_cast<int16_t>(0)); // Api key.
+  RequestB::putIntoBuffer(static_cast<int16_t>(0)); // Api version.
+  RequestB::putIntoBuffer(static_cast<int32_t>(0)); // Correlation-id.
+  RequestB::putIntoBuffer(static_cast<int16_t>(std::numeric_limits<int16_t>::min())); // Client-id.
+
+  // when
+  const Network::FilterStatus result = consumeRequestFromBuffer();
+
+  // then
+  ASSERT_EQ(result, Network::FilterStatus::StopIteration);
+  ASSERT_EQ(testee_.getRequestDecoderForTest()->getCurrentParserForTest(), nullptr);
+}
+
 } // namespace Broker
 } // namespace Kafka
 } // namespace NetworkFilters
@@ -0,0 +1,87 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <cstdint>
+#include <vector>
+
+#include "common/buffer/buffer_impl.h"
+#include "common/stats/isolated_store_impl.h"
+
+#include "extensions/filters/network/kafka/broker/filter.h"
+#include "extensions/filters/network/kafka/external/requests.h"
+
+#include "test/test_common/simulated_time_system.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Broker {
+
+/**
+ * Feeds the broker filter with produce requests, that are the bulk of data sent by clients.
+ */
+class FilterSpeedTest {
+public:
+  FilterSpeedTest(const bool skip_payload_parsing)
+      : filter_{store_, time_system_, "prefix", skip_payload_parsing} {}
+
+  /**
+   * Puts produce requests into the buffer, each of them carrying given amount of record bytes
+   * spread over a few partitions.
+   */
+  void makeRequests(const uint32_t request_count, const uint32_t records_size) {
+    RequestEncoder encoder{requests_};
+    for (uint32_t i = 0; i < request_count; ++i) {
+      std::vector<PartitionProduceData> partitions;
+      for (int32_t partition = 0; partition < PartitionCount; ++partition) {
+        partitions.push_back({partition, Bytes(records_size / PartitionCount)});
+      }
+      const RequestHeader header = {0, 3, static_cast<int32_t>(i), "producer-client-id"};
+      const ProduceRequest data = {absl::nullopt, -1, 1000, {{"topic", partitions}}};
+      encoder.encode(Request<ProduceRequest>{header, data});
+    }
+  }
+
+  // The filter does not drain the buffer, so the same requests can be processed repeatedly.
+  void processRequests() { filter_.onData(requests_, false); }
+
+  uint64_t requestBytes() const { return requests_.length(); }
+
+private:
+  static constexpr int32_t PartitionCount = 4;
+
+  Stats::IsolatedStoreImpl store_;
+  Event::SimulatedTimeSystem time_system_;
+  KafkaBrokerFilter filter_;
+  Buffer::OwnedImpl requests_;
+};
+
+} // namespace Broker
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
+
+static void processProduceRequests(benchmark::State& state, const bool skip_payload_parsing) {
+  Envoy::Extensions::NetworkFilters::Kafka::Broker::FilterSpeedTest context{
+      skip_payload_parsing};
+  context.makeRequests(64, state.range(0));
+
+  for (auto _ : state) {
+    context.processRequests();
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * context.requestBytes());
+}
+
+static void BM_ParseProduceRequests(benchmark::State& state) {
+  processProduceRequests(state, false);
+}
+BENCHMARK(BM_ParseProduceRequests)->Range(1 << 10, 1 << 20);
+
+static void BM_SkipProduceRequests(benchmark::State& state) {
+  processProduceRequests(state, true);
+}
+BENCHMARK(BM_SkipProduceRequests)->Range(1 << 10, 1 << 20);
@@ -192,6 +192,53 @@ TEST_F(KafkaRequestParserTest, SentinelParserShouldConsumeDataUntilEndOfRequest)
   assertStringViewIncrement(data, orig_data, request_len);
 }
 
+TEST_F(KafkaRequestParserTest, SkippingParserShouldConsumeDataUntilEndOfRequest) {
+  // given
+  const int32_t request_len = 1000;
+  RequestContextSharedPtr context{new RequestContext()};
+  context->remaining_request_size_ = request_len;
+  context->request_header_ = {0, 1, 42, "client-id"};
+  SkippingParser testee{context};
+
+  const absl::string_view orig_data = putGarbageIntoBuffer(request_len * 2);
+  absl::string_view first_part = orig_data.substr(0, request_len / 2);
+  absl::string_view second_part = orig_data.substr(request_len / 2);
+
+  // when
+  const RequestParseResponse result1 = testee.parse(first_part);
+  const RequestParseResponse result2 = testee.parse(second_part);
+
+  // then
+  ASSERT_EQ(result1.hasData(), false);
+  ASSERT_EQ(result2.hasData(), true);
+  ASSERT_EQ(result2.next_parser_, nullptr);
+  ASSERT_EQ(result2.failure_data_, nullptr);
+  const auto message = std::dynamic_pointer_cast<SkippedRequest>(result2.message_);
+  ASSERT_NE(message, nullptr);
+  ASSERT_EQ(message->request_header_, context->request_header_);
+  ASSERT_EQ(message->data_size_, request_len);
+
+  ASSERT_EQ(testee.contextForTest()->remaining_request_size_, 0);
+
+  ASSERT_EQ(first_part.size(), 0);
+  ASSERT_EQ(second_part.data(), orig_data.data() + request_len);
+}
+
+TEST_F(KafkaRequestParserTest, SkippingRequestParserResolverShouldSkipOnlySupportedRequests) {
+  // given
+  const RequestParserResolver& testee = SkippingRequestParserResolver::getSkippingInstance();
+  RequestContextSharedPtr context{new RequestContext()};
+
+  // when
+  const RequestParserSharedPtr produce_parser = testee.createParser(0, 0, context);
+  const RequestParserSharedPtr unknown_parser =
+      testee.createParser(std::numeric_limits<int16_t>::max(), 0, context);
+
+  // then
+  ASSERT_NE(std::dynamic_pointer_cast<SkippingParser>(produce_parser), nullptr);
+  ASSERT_NE(std::dynamic_pointer_cast<SentinelParser>(unknown_parser), nullptr);
+}
+
 } // namespace KafkaRequestParserTest
 } // namespace Kafka
 } // namespace NetworkFilters
@@ -193,6 +193,60 @@ TEST_F(KafkaResponseParserTest, SentinelResponseParserShouldConsumeDataUntilEndO
   assertStringViewIncrement(data, orig_data, response_len);
 }
 
+TEST_F(KafkaResponseParserTest, SkippingResponseParserShouldConsumeDataUntilEndOfMessage) {
+  // given
+  const int32_t response_len = 1000;
+  ResponseContextSharedPtr context = std::make_shared<ResponseContext>();
+  context->remaining_response_size_ = response_len;
+  context->api_key_ = 0;
+  context->api_version_ = 1;
+  context->correlation_id_ = 42;
+  SkippingResponseParser testee{context};
+
+  const absl::string_view orig_data = putGarbageIntoBuffer(response_len * 2);
+  absl::string_view first_part = orig_data.substr(0, response_len / 2);
+  absl::string_view second_part = orig_data.substr(response_len / 2);
+
+  // when
+  const ResponseParseResponse result1 = testee.parse(first_part);
+  const ResponseParseResponse result2 = testee.parse(second_part);
+
+  // then
+  ASSERT_EQ(result1.hasData(), false);
+  ASSERT_EQ(result2.hasData(), true);
+  ASSERT_EQ(result2.next_parser_, nullptr);
+  ASSERT_EQ(result2.failure_data_, nullptr);
+  const auto message = std::dynamic_pointer_cast<SkippedResponse>(result2.message_);
+  ASSERT_NE(message, nullptr);
+  const ResponseMetadata expected_metadata = {0, 1, 42};
+  ASSERT_EQ(message->metadata_, expected_metadata);
+  ASSERT_EQ(message->data_size_, response_len);
+
+  ASSERT_EQ(testee.contextForTest()->remaining_response_size_, 0);
+
+  ASSERT_EQ(first_part.size(), 0);
+  ASSERT_EQ(second_part.data(), orig_data.data() + response_len);
+}
+
+TEST_F(KafkaResponseParserTest, SkippingResponseParserResolverShouldSkipOnlySupportedResponses) {
+  // given
+  const ResponseParserResolver& testee = SkippingResponseParserResolver::getSkippingInstance();
+  ResponseContextSharedPtr produce_context = std::make_shared<ResponseContext>();
+  produce_context->api_key_ = 0;
+  produce_context->api_version_ = 0;
+  ResponseContextSharedPtr unknown_context = std::make_shared<ResponseContext>();
+  unknown_context->api_key_ = std::numeric_limits<int16_t>::max();
+  unknown_context->api_version_ = 0;
+
+  // when
+  const ResponseParserSharedPtr produce_parser = testee.createParser(produce_context);
+  const ResponseParserSharedPtr unknown_parser = testee.createParser(unknown_context);
+
+  // then
+  ASSERT_NE(std::dynamic_pointer_cast<SkippingResponseParser>(produce_parser), nullptr);
+  ASSERT_NE(std::dynamic_pointer_cast<SentinelResponseParser>(unknown_parser), nullptr);
+}
+
 } // namespace KafkaResponseParserTest
 } // namespace Kafka
 } // namespace NetworkFilters
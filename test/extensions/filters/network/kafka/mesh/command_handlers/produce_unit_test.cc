@@ -0,0 +1,180 @@
+#include "extensions/filters/network/kafka/external/responses.h"
+#include "extensions/filters/network/kafka/mesh/command_handlers/produce.h"
+#include "extensions/filters/network/kafka/mesh/kafka_constants.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+namespace {
+
+class MockAbstractRequestListener : public AbstractRequestListener {
+public:
+  MOCK_METHOD(void, onRequest, (InFlightRequestSharedPtr));
+  MOCK_METHOD(void, onRequestReadyForAnswer, ());
+};
+
+class MockUpstreamKafkaConfiguration : public UpstreamKafkaConfiguration {
+public:
+  MOCK_METHOD(const ClusterConfig*, computeClusterConfigForTopic, (const std::string&), (const));
+  MOCK_METHOD((std::pair<std::string, int32_t>), getAdvertisedAddress, (), (const));
+};
+
+class MockUpstreamKafkaFacade : public UpstreamKafkaFacade {
+public:
+  MOCK_METHOD(KafkaProducer&, getProducer, (const ClusterConfig&));
+};
+
+class MockKafkaProducer : public KafkaProducer {
+public:
+  MOCK_METHOD(void, send, (const OutboundRecord&, RecordCallbackSharedPtr, uint32_t));
+};
+
+class ProduceUnitTest : public testing::Test {
+protected:
+  ProduceUnitTest() {
+    ON_CALL(configuration_, computeClusterConfigForTopic("apples"))
+        .WillByDefault(Return(&cluster_));
+    ON_CALL(configuration_, computeClusterConfigForTopic("bananas"))
+        .WillByDefault(Return(nullptr));
+    ON_CALL(facade_, getProducer(_)).WillByDefault(ReturnRef(producer_));
+  }
+
+  std::shared_ptr<ProduceRequestHolder> makeHolder(const int16_t acks,
+                                                   std::vector<TopicProduceData> topics) {
+    const RequestHeader header = {ApiKeys::Produce, 3, 42, "client"};
+    const ProduceRequest data = {absl::nullopt, acks, 1000, topics};
+    const auto request = std::make_shared<Request<ProduceRequest>>(header, data);
+    return std::make_shared<ProduceRequestHolder>(filter_, configuration_, facade_, request);
+  }
+
+  static Bytes makeBatch(const uint32_t record_count) {
+    RecordBatchBuilder builder;
+    for (uint32_t i = 0; i < record_count; i++) {
+      builder.add({"apples", 0, 1000, absl::nullopt, absl::string_view("value"), ""});
+    }
+    return builder.build();
+  }
+
+  static const PartitionProduceResponse&
+  getPartitionResponse(const AbstractResponseSharedPtr& answer, const uint32_t topic,
+                       const uint32_t partition) {
+    const auto response = std::dynamic_pointer_cast<Response<ProduceResponse>>(answer);
+    return response->data_.responses_.at(topic).partitions_.at(partition);
+  }
+
+  const ClusterConfig cluster_ = {"cluster", 1, std::chrono::milliseconds(5), 16384,
+                                  std::chrono::milliseconds(30000)};
+  testing::NiceMock<MockAbstractRequestListener> filter_;
+  testing::NiceMock<MockUpstreamKafkaConfiguration> configuration_;
+  testing::NiceMock<MockUpstreamKafkaFacade> facade_;
+  testing::NiceMock<MockKafkaProducer> producer_;
+};
+
+TEST_F(ProduceUnitTest, shouldAnswerOnceAllRecordsAreDelivered) {
+  // given
+  const auto testee =
+      makeHolder(-1, {{"apples", {{0, makeBatch(2)}, {1, makeBatch(1)}}}});
+  std::vector<std::pair<RecordCallbackSharedPtr, uint32_t>> sent;
+  EXPECT_CALL(producer_, send(_, _, _))
+      .Times(3)
+      .WillRepeatedly(Invoke([&sent](const OutboundRecord& record,
+                                     RecordCallbackSharedPtr callback, uint32_t record_id) {
+        EXPECT_EQ(record.value_, absl::make_optional<absl::string_view>("value"));
+        sent.emplace_back(callback, record_id);
+      }));
+  EXPECT_CALL(filter_, onRequestReadyForAnswer()).Times(0);
+  testee->startProcessing();
+  ASSERT_EQ(sent.size(), 3);
+  EXPECT_FALSE(testee->finished());
+
+  // when
+  sent[0].first->onRecordDelivery(sent[0].second, ErrorCodes::None, 11);
+  sent[1].first->onRecordDelivery(sent[1].second, ErrorCodes::None, 10);
+  testing::Mock::VerifyAndClearExpectations(&filter_);
+  EXPECT_CALL(filter_, onRequestReadyForAnswer());
+  sent[2].first->onRecordDelivery(sent[2].second, ErrorCodes::NotLeaderForPartition, -1);
+
+  // then
+  ASSERT_TRUE(testee->finished());
+  const AbstractResponseSharedPtr answer = testee->computeAnswer();
+  ASSERT_NE(answer, nullptr);
+  EXPECT_EQ(answer->metadata_.correlation_id_, 42);
+  EXPECT_EQ(getPartitionResponse(answer, 0, 0).error_code_, ErrorCodes::None);
+  EXPECT_EQ(getPartitionResponse(answer, 0, 0).base_offset_, 10);
+  EXPECT_EQ(getPartitionResponse(answer, 0, 1).error_code_, ErrorCodes::NotLeaderForPartition);
+}
+
+TEST_F(ProduceUnitTest, shouldAnswerImmediatelyIfNoRecordsCanBeSent) {
+  // given
+  Bytes corrupted = makeBatch(1);
+  corrupted.back() ^= 1;
+  const auto testee =
+      makeHolder(1, {{"apples", {{0, corrupted}}}, {"bananas", {{0, makeBatch(1)}}}});
+  EXPECT_CALL(producer_, send(_, _, _)).Times(0);
+  EXPECT_CALL(filter_, onRequestReadyForAnswer());
+
+  // when
+  testee->startProcessing();
+
+  // then
+  ASSERT_TRUE(testee->finished());
+  const AbstractResponseSharedPtr answer = testee->computeAnswer();
+  EXPECT_EQ(getPartitionResponse(answer, 0, 0).error_code_, ErrorCodes::CorruptMessage);
+  EXPECT_EQ(getPartitionResponse(answer, 1, 0).error_code_, ErrorCodes::UnknownTopicOrPartition);
+}
+
+TEST_F(ProduceUnitTest, shouldHandleImmediateDeliveries) {
+  // given
+  const auto testee = makeHolder(1, {{"apples", {{0, makeBatch(1)}}}});
+  EXPECT_CALL(producer_, send(_, _, _))
+      .WillOnce(Invoke([](const OutboundRecord&, RecordCallbackSharedPtr callback,
+                          uint32_t record_id) {
+        callback->onRecordDelivery(record_id, ErrorCodes::NetworkException, -1);
+      }));
+  EXPECT_CALL(filter_, onRequestReadyForAnswer());
+
+  // when
+  testee->startProcessing();
+
+  // then
+  ASSERT_TRUE(testee->finished());
+  EXPECT_EQ(getPartitionResponse(testee->computeAnswer(), 0, 0).error_code_,
+            ErrorCodes::NetworkException);
+}
+
+TEST_F(ProduceUnitTest, shouldNotAnswerRequestsWithoutAcknowledgements) {
+  // given
+  const auto testee = makeHolder(0, {{"apples", {{0, makeBatch(1)}}}});
+  RecordCallbackSharedPtr callback;
+  EXPECT_CALL(producer_, send(_, _, _))
+      .WillOnce(Invoke([&callback](const OutboundRecord&, RecordCallbackSharedPtr arg, uint32_t) {
+        callback = arg;
+      }));
+  EXPECT_CALL(filter_, onRequestReadyForAnswer());
+
+  // when
+  testee->startProcessing();
+
+  // then
+  EXPECT_TRUE(testee->finished());
+  EXPECT_EQ(testee->computeAnswer(), nullptr);
+  // The delivery of the records does not notify the filter again.
+  callback->onRecordDelivery(0, ErrorCodes::None, 0);
+}
+
+} // namespace
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,54 @@
+#include "extensions/filters/network/kafka/mesh/config.h"
+
+#include "test/mocks/server/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+
+TEST(KafkaMeshConfigFactoryUnitTest, shouldCreateFilter) {
+  // given
+  const std::string yaml = R"EOF(
+advertised_host: "proxy"
+advertised_port: 19092
+upstream_clusters:
+- cluster_name: cluster1
+  partition_count: 1
+forwarding_rules:
+- target_cluster: cluster1
+  topic_prefix: apples
+  )EOF";
+
+  KafkaMeshProtoConfig proto_config;
+  TestUtility::loadFromYamlAndValidate(yaml, proto_config);
+
+  testing::NiceMock<Server::Configuration::MockFactoryContext> context;
+  KafkaMeshConfigFactory factory;
+
+  Network::FilterFactoryCb cb = factory.createFilterFactoryFromProto(proto_config, context);
+  Network::MockConnection connection;
+  EXPECT_CALL(connection, addReadFilter(_));
+
+  // when
+  cb(connection);
+
+  // then - connection had `addReadFilter` invoked
+}
+
+TEST(KafkaMeshConfigFactoryUnitTest, shouldBeTerminalFilter) {
+  KafkaMeshConfigFactory factory;
+  EXPECT_TRUE(factory.isTerminalFilter());
+}
+
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,161 @@
+#include "common/buffer/buffer_impl.h"
+
+#include "extensions/filters/network/kafka/mesh/filter.h"
+
+#include "test/mocks/network/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+using testing::Throw;
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+namespace {
+
+class MockRequestDecoder : public RequestDecoder {
+public:
+  MockRequestDecoder() : RequestDecoder{{}} {};
+  MOCK_METHOD(void, onData, (Buffer::Instance&));
+  MOCK_METHOD(void, reset, ());
+};
+
+using MockRequestDecoderSharedPtr = std::shared_ptr<MockRequestDecoder>;
+
+class MockInFlightRequest : public InFlightRequest {
+public:
+  MOCK_METHOD(void, startProcessing, ());
+  MOCK_METHOD(bool, finished, (), (const));
+  MOCK_METHOD(AbstractResponseSharedPtr, computeAnswer, (), (const));
+  MOCK_METHOD(void, abandon, ());
+};
+
+using MockInFlightRequestSharedPtr = std::shared_ptr<MockInFlightRequest>;
+
+class MockResponse : public AbstractResponse {
+public:
+  MockResponse() : AbstractResponse{{0, 0, 0}} {};
+  MOCK_METHOD(uint32_t, computeSize, (), (const));
+  MOCK_METHOD(uint32_t, encode, (Buffer::Instance&), (const));
+};
+
+class FilterUnitTest : public testing::Test {
+protected:
+  FilterUnitTest() { testee_.initializeReadFilterCallbacks(filter_callbacks_); }
+
+  MockRequestDecoderSharedPtr request_decoder_ = std::make_shared<MockRequestDecoder>();
+  NiceMock<Network::MockReadFilterCallbacks> filter_callbacks_;
+  KafkaMeshFilter testee_{request_decoder_};
+};
+
+TEST_F(FilterUnitTest, shouldConsumeDownstreamData) {
+  // given
+  Buffer::OwnedImpl data{"data"};
+  EXPECT_CALL(*request_decoder_, onData(_));
+
+  // when
+  const Network::FilterStatus result = testee_.onData(data, false);
+
+  // then
+  EXPECT_EQ(result, Network::FilterStatus::StopIteration);
+  EXPECT_EQ(data.length(), 0);
+}
+
+TEST_F(FilterUnitTest, shouldCloseConnectionOnDecodingException) {
+  // given
+  auto request = std::make_shared<NiceMock<MockInFlightRequest>>();
+  testee_.onRequest(request);
+  Buffer::OwnedImpl data{"data"};
+  EXPECT_CALL(*request_decoder_, onData(_)).WillOnce(Throw(EnvoyException("boom")));
+  EXPECT_CALL(*request, abandon());
+  EXPECT_CALL(filter_callbacks_.connection_, close(Network::ConnectionCloseType::NoFlush));
+
+  // when
+  const Network::FilterStatus result = testee_.onData(data, false);
+
+  // then
+  EXPECT_EQ(result, Network::FilterStatus::StopIteration);
+  EXPECT_TRUE(testee_.getRequestsInFlightForTest().empty());
+}
+
+TEST_F(FilterUnitTest, shouldStartProcessingRequests) {
+  // given
+  auto request = std::make_shared<MockInFlightRequest>();
+  EXPECT_CALL(*request, startProcessing());
+
+  // when
+  testee_.onRequest(request);
+
+  // then
+  EXPECT_EQ(testee_.getRequestsInFlightForTest().size(), 1);
+}
+
+TEST_F(FilterUnitTest, shouldAnswerFinishedRequestsInOrder) {
+  // given
+  auto request1 = std::make_shared<NiceMock<MockInFlightRequest>>();
+  auto request2 = std::make_shared<NiceMock<MockInFlightRequest>>();
+  auto request3 = std::make_shared<NiceMock<MockInFlightRequest>>();
+  testee_.onRequest(request1);
+  testee_.onRequest(request2);
+  testee_.onRequest(request3);
+
+  auto response = std::make_shared<NiceMock<MockResponse>>();
+  ON_CALL(*request1, finished()).WillByDefault(Return(true));
+  ON_CALL(*request2, finished()).WillByDefault(Return(true));
+  ON_CALL(*request3, finished()).WillByDefault(Return(false));
+  EXPECT_CALL(*request1, computeAnswer()).WillOnce(Return(response));
+  // Requests without answers, e.g. produce requests with no acknowledgements.
+  EXPECT_CALL(*request2, computeAnswer()).WillOnce(Return(nullptr));
+  EXPECT_CALL(*request3, computeAnswer()).Times(0);
+  EXPECT_CALL(filter_callbacks_.connection_, write(_, false));
+
+  // when
+  testee_.onRequestReadyForAnswer();
+
+  // then
+  ASSERT_EQ(testee_.getRequestsInFlightForTest().size(), 1);
+  EXPECT_EQ(testee_.getRequestsInFlightForTest().front(), request3);
+}
+
+TEST_F(FilterUnitTest, shouldNotWriteIfFirstRequestIsNotFinished) {
+  // given
+  auto request1 = std::make_shared<NiceMock<MockInFlightRequest>>();
+  auto request2 = std::make_shared<NiceMock<MockInFlightRequest>>();
+  testee_.onRequest(request1);
+  testee_.onRequest(request2);
+  ON_CALL(*request1, finished()).WillByDefault(Return(false));
+  ON_CALL(*request2, finished()).WillByDefault(Return(true));
+  EXPECT_CALL(filter_callbacks_.connection_, write(_, _)).Times(0);
+
+  // when
+  testee_.onRequestReadyForAnswer();
+
+  // then
+  EXPECT_EQ(testee_.getRequestsInFlightForTest().size(), 2);
+}
+
+TEST_F(FilterUnitTest, shouldAbandonRequestsWhenConnectionCloses) {
+  // given
+  auto request = std::make_shared<NiceMock<MockInFlightRequest>>();
+  testee_.onRequest(request);
+  EXPECT_CALL(*request, abandon());
+
+  // when
+  testee_.onEvent(Network::ConnectionEvent::RemoteClose);
+
+  // then
+  EXPECT_TRUE(testee_.getRequestsInFlightForTest().empty());
+}
+
+} // namespace
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,133 @@
+#include "extensions/filters/network/kafka/mesh/kafka_constants.h"
+#include "extensions/filters/network/kafka/mesh/record_batch.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+namespace {
+
+absl::string_view toView(const Bytes& bytes) {
+  return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+
+// Header count 1, key "hk", value "hv".
+const std::string Headers = std::string("\x02\x04hk\x04hv", 7);
+
+Bytes buildBatch(const std::vector<OutboundRecord>& records) {
+  RecordBatchBuilder builder;
+  for (const OutboundRecord& record : records) {
+    builder.add(record);
+  }
+  return builder.build();
+}
+
+TEST(RecordBatchUnitTest, shouldExtractRecordsOfBuiltBatches) {
+  // given
+  const std::string value(300, 'v');
+  const std::vector<OutboundRecord> input = {
+      {"topic", 0, 1000, absl::string_view("key"), absl::string_view(value), ""},
+      {"topic", 0, 900, absl::nullopt, absl::string_view(""), Headers},
+      {"topic", 0, 5000000, absl::string_view(""), absl::nullopt, ""},
+  };
+  Bytes batches = buildBatch(input);
+  const Bytes second = buildBatch({input[0]});
+  batches.insert(batches.end(), second.begin(), second.end());
+
+  // when
+  std::vector<OutboundRecord> records;
+  RecordExtractor::extract("topic", 3, toView(batches), records);
+
+  // then
+  ASSERT_EQ(records.size(), 4);
+  EXPECT_EQ(records[0].topic_, "topic");
+  EXPECT_EQ(records[0].partition_, 3);
+  EXPECT_EQ(records[0].timestamp_, 1000);
+  EXPECT_EQ(records[0].key_, absl::make_optional<absl::string_view>("key"));
+  EXPECT_EQ(records[0].value_, absl::make_optional<absl::string_view>(value));
+  EXPECT_EQ(records[0].headers_, absl::string_view("\x00", 1));
+  EXPECT_EQ(records[1].timestamp_, 900);
+  EXPECT_EQ(records[1].key_, absl::nullopt);
+  EXPECT_EQ(records[1].value_, absl::make_optional<absl::string_view>(""));
+  EXPECT_EQ(records[1].headers_, Headers);
+  EXPECT_EQ(records[2].timestamp_, 5000000);
+  EXPECT_EQ(records[2].key_, absl::make_optional<absl::string_view>(""));
+  EXPECT_EQ(records[2].value_, absl::nullopt);
+  EXPECT_EQ(records[3].value_, records[0].value_);
+}
+
+TEST(RecordBatchUnitTest, shouldComputeBatchSize) {
+  // given
+  RecordBatchBuilder builder;
+  EXPECT_EQ(builder.size(), RecordBatchBuilder::HeaderSize);
+
+  // when
+  builder.add({"topic", 0, 1000, absl::string_view("key"), absl::string_view("value"), Headers});
+  builder.add({"topic", 0, 2000, absl::nullopt, absl::nullopt, ""});
+
+  // then
+  EXPECT_EQ(builder.count(), 2);
+  EXPECT_EQ(builder.size(), builder.build().size());
+}
+
+TEST(RecordBatchUnitTest, shouldRejectCorruptedBatches) {
+  // given
+  Bytes batch = buildBatch({{"topic", 0, 1000, absl::nullopt, absl::string_view("value"), ""}});
+  batch.back() ^= 1;
+
+  // when, then
+  std::vector<OutboundRecord> records;
+  try {
+    RecordExtractor::extract("topic", 0, toView(batch), records);
+    FAIL() << "corrupted batch should have been rejected";
+  } catch (const InvalidRecordBatchException& e) {
+    EXPECT_EQ(e.errorCode(), ErrorCodes::CorruptMessage);
+  }
+}
+
+TEST(RecordBatchUnitTest, shouldRejectTruncatedBatches) {
+  // given
+  Bytes batch = buildBatch({{"topic", 0, 1000, absl::nullopt, absl::string_view("value"), ""}});
+  batch.pop_back();
+
+  // when, then
+  std::vector<OutboundRecord> records;
+  EXPECT_THROW(RecordExtractor::extract("topic", 0, toView(batch), records),
+               InvalidRecordBatchException);
+}
+
+TEST(RecordBatchUnitTest, shouldRejectCompressedBatches) {
+  // given
+  Bytes batch = buildBatch({{"topic", 0, 1000, absl::nullopt, absl::string_view("value"), ""}});
+  batch[22] |= 0x01; // Gzip compression flag in the attributes.
+
+  // when, then
+  std::vector<OutboundRecord> records;
+  try {
+    RecordExtractor::extract("topic", 0, toView(batch), records);
+    FAIL() << "compressed batch should have been rejected";
+  } catch (const InvalidRecordBatchException& e) {
+    EXPECT_EQ(e.errorCode(), ErrorCodes::UnsupportedCompressionType);
+  }
+}
+
+TEST(RecordBatchUnitTest, shouldRejectLegacyMessageSets) {
+  // given
+  Bytes batch = buildBatch({{"topic", 0, 1000, absl::nullopt, absl::string_view("value"), ""}});
+  batch[16] = 1; // Magic.
+
+  // when, then
+  std::vector<OutboundRecord> records;
+  EXPECT_THROW(RecordExtractor::extract("topic", 0, toView(batch), records),
+               InvalidRecordBatchException);
+}
+
+} // namespace
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
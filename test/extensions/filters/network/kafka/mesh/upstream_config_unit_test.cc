@@ -0,0 +1,81 @@
+#include "extensions/filters/network/kafka/mesh/upstream_config.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace Kafka {
+namespace Mesh {
+namespace {
+
+KafkaMeshProtoConfig loadConfig(const std::string& yaml) {
+  KafkaMeshProtoConfig proto_config;
+  TestUtility::loadFromYamlAndValidate(yaml, proto_config);
+  return proto_config;
+}
+
+TEST(UpstreamKafkaConfigurationTest, shouldRouteTopicsToFirstMatchingCluster) {
+  // given
+  const UpstreamKafkaConfigurationImpl testee{loadConfig(R"EOF(
+advertised_host: "proxy"
+advertised_port: 19092
+upstream_clusters:
+- cluster_name: cluster1
+  partition_count: 1
+- cluster_name: cluster2
+  partition_count: 2
+  linger: 0.02s
+  max_batch_size_bytes: 1000
+  request_timeout: 1s
+forwarding_rules:
+- target_cluster: cluster1
+  topic_prefix: apples
+- target_cluster: cluster2
+  topic_prefix: apple
+  )EOF")};
+
+  // when
+  const ClusterConfig* apples = testee.computeClusterConfigForTopic("apples");
+  const ClusterConfig* apple = testee.computeClusterConfigForTopic("apple");
+  const ClusterConfig* bananas = testee.computeClusterConfigForTopic("bananas");
+
+  // then
+  const ClusterConfig cluster1 = {"cluster1", 1, std::chrono::milliseconds(5), 16384,
+                                  std::chrono::milliseconds(30000)};
+  const ClusterConfig cluster2 = {"cluster2", 2, std::chrono::milliseconds(20), 1000,
+                                  std::chrono::milliseconds(1000)};
+  ASSERT_NE(apples, nullptr);
+  EXPECT_EQ(*apples, cluster1);
+  ASSERT_NE(apple, nullptr);
+  EXPECT_EQ(*apple, cluster2);
+  EXPECT_EQ(bananas, nullptr);
+  EXPECT_EQ(testee.getAdvertisedAddress(), std::make_pair(std::string("proxy"), 19092));
+}
+
+TEST(UpstreamKafkaConfigurationTest, shouldThrowIfRuleTargetsUnknownCluster) {
+  // given
+  const KafkaMeshProtoConfig proto_config = loadConfig(R"EOF(
+advertised_host: "proxy"
+advertised_port: 19092
+upstream_clusters:
+- cluster_name: cluster1
+  partition_count: 1
+forwarding_rules:
+- target_cluster: cluster2
+  topic_prefix: apples
+  )EOF");
+
+  // when, then
+  EXPECT_THROW_WITH_MESSAGE(UpstreamKafkaConfigurationImpl{proto_config}, EnvoyException,
+                            "kafka mesh: forwarding rule targets unknown cluster 'cluster2'");
+}
+
+} // namespace
+} // namespace Mesh
+} // namespace Kafka
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -52,6 +52,86 @@ TEST(BsonImplTest, InvalodDocumentTermination) {
   EXPECT_THROW(DocumentImpl::create(buffer), EnvoyException);
 }
 
+TEST(BsonImplTest, DecodeFromBuffer) {
+  Field::ObjectId object_id;
+  object_id.fill(7);
+  DocumentSharedPtr doc =
+      DocumentImpl::create()
+          ->addDouble("double", 2.5)
+          ->addString("string", "hello")
+          ->addSymbol("symbol", "world")
+          ->addDocument("document", DocumentImpl::create()->addArray(
+                                        "array", DocumentImpl::create()->addString("0", "item")))
+          ->addBinary("binary", std::string("\0\1binary", 8))
+          ->addObjectId("object_id", std::move(object_id))
+          ->addBoolean("boolean", true)
+          ->addDatetime("datetime", 123)
+          ->addNull("null")
+          ->addRegex("regex", {"pattern", "i"})
+          ->addInt32("int32", -5)
+          ->addTimestamp("timestamp", 9)
+          ->addInt64("int64", -1);
+
+  Buffer::OwnedImpl buffer;
+  doc->encode(buffer);
+  const std::string encoded = buffer.toString();
+  buffer.add("next");
+
+  DocumentSharedPtr decoded = DocumentImpl::create(buffer);
+  EXPECT_EQ("next", buffer.toString());
+  EXPECT_EQ(doc->byteSize(), decoded->byteSize());
+  EXPECT_TRUE(*doc == *decoded);
+  EXPECT_EQ(doc->toString(), decoded->toString());
+  EXPECT_EQ("item", decoded->find("document", Field::Type::Document)
+                        ->asDocument()
+                        .find("array")
+                        ->asArray()
+                        .values()
+                        .front()
+                        ->asString());
+
+  // Unmodified documents get encoded from their original bytes.
+  Buffer::OwnedImpl output;
+  decoded->encode(output);
+  EXPECT_EQ(encoded, output.toString());
+
+  // Modified documents get encoded from their fields.
+  decoded->addInt32("added", 3);
+  EXPECT_EQ(doc->byteSize() + 1 + 6 + 4, decoded->byteSize());
+  Buffer::OwnedImpl modified;
+  decoded->encode(modified);
+  EXPECT_EQ(3, DocumentImpl::create(modified)->find("added", Field::Type::Int32)->asInt32());
+}
+
+TEST(BsonImplTest, NestedDocumentDecodedOnAccess) {
+  DocumentSharedPtr doc =
+      DocumentImpl::create()->addDocument("document", DocumentImpl::create()->addInt32("a", 1));
+  Buffer::OwnedImpl buffer;
+  doc->encode(buffer);
+
+  // Corrupt the type of the nested document's element: length (4), type (1), "document" (9),
+  // nested length (4).
+  std::string bytes = buffer.toString();
+  bytes[4 + 1 + 9 + 4] = 0x20;
+  Buffer::OwnedImpl corrupted(bytes);
+
+  DocumentSharedPtr decoded = DocumentImpl::create(corrupted);
+  EXPECT_EQ(doc->byteSize(), decoded->byteSize());
+  EXPECT_THROW(decoded->values(), EnvoyException);
+}
+
+TEST(BsonImplTest, InvalidElementLength) {
+  Buffer::OwnedImpl buffer;
+  DocumentImpl::create()->addString("hello", "world")->encode(buffer);
+
+  // Make the string length exceed the document: length (4), type (1), "hello" (6).
+  std::string bytes = buffer.toString();
+  bytes[4 + 1 + 6] = 100;
+  Buffer::OwnedImpl corrupted(bytes);
+
+  EXPECT_THROW(DocumentImpl::create(corrupted), EnvoyException);
+}
+
 TEST(BufferHelperTest, InvalidSize) {
   {
     Buffer::OwnedImpl buffer;
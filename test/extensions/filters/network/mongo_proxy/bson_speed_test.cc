@@ -0,0 +1,86 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "common/buffer/buffer_impl.h"
+
+#include "extensions/filters/network/mongo_proxy/bson_impl.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace MongoProxy {
+namespace Bson {
+
+/**
+ * Encodes a document resembling a bulk insert: a few top level fields and an array of records,
+ * added until the document reaches the given size.
+ */
+static std::string makeDocument(uint64_t size) {
+  DocumentSharedPtr records = DocumentImpl::create();
+  DocumentSharedPtr document = DocumentImpl::create()
+                                   ->addString("insert", "collection")
+                                   ->addBoolean("ordered", true)
+                                   ->addArray("documents", records);
+  for (int64_t i = 0, records_size = 0; static_cast<uint64_t>(records_size) < size; i++) {
+    Field::ObjectId object_id;
+    object_id.fill(i % 256);
+    DocumentSharedPtr record =
+        DocumentImpl::create()
+            ->addObjectId("_id", std::move(object_id))
+            ->addString("name", std::string(32, 'n'))
+            ->addInt64("value", i)
+            ->addDatetime("created", 1590000000000 + i)
+            ->addArray("tags", DocumentImpl::create()->addString("0", "tag")->addString("1", "tag"))
+            ->addBinary("payload", std::string(512, 'p'));
+    records_size += record->byteSize();
+    records->addDocument(std::to_string(i), record);
+  }
+
+  Buffer::OwnedImpl buffer;
+  document->encode(buffer);
+  return buffer.toString();
+}
+
+static void decode(benchmark::State& state, bool traverse) {
+  const std::string encoded = makeDocument(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Buffer::OwnedImpl buffer(encoded);
+    state.ResumeTiming();
+
+    DocumentSharedPtr document = DocumentImpl::create(buffer);
+    // What the proxy needs: the command name and the document size.
+    benchmark::DoNotOptimize(document->values().front()->key());
+    benchmark::DoNotOptimize(document->byteSize());
+    if (traverse) {
+      for (const FieldPtr& record : document->find("documents")->asArray().values()) {
+        benchmark::DoNotOptimize(record->asDocument().values().size());
+      }
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * encoded.size());
+}
+
+} // namespace Bson
+} // namespace MongoProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
+
+// Decodes documents accessing only their top level fields.
+static void BM_DecodeDocument(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::MongoProxy::Bson::decode(state, false);
+}
+BENCHMARK(BM_DecodeDocument)->Range(64 << 10, 16 << 20)->Unit(benchmark::kMicrosecond);
+
+// Decodes documents accessing the fields of all their nested documents.
+static void BM_DecodeAndTraverseDocument(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::MongoProxy::Bson::decode(state, true);
+}
+BENCHMARK(BM_DecodeAndTraverseDocument)
+    ->Range(64 << 10, 16 << 20)
+    ->Unit(benchmark::kMicrosecond);
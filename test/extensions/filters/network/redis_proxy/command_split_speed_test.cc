@@ -5,10 +5,12 @@
 #include <string>
 #include <vector>
 
+#include "common/buffer/buffer_impl.h"
 #include "common/common/fmt.h"
 #include "common/stats/isolated_store_impl.h"
 
 #include "extensions/filters/network/common/redis/client_impl.h"
+#include "extensions/filters/network/common/redis/codec_impl.h"
 #include "extensions/filters/network/common/redis/supported_commands.h"
 #include "extensions/filters/network/redis_proxy/command_splitter_impl.h"
 #include "extensions/filters/network/redis_proxy/router_impl.h"
@@ -84,6 +86,47 @@ public:
     }
   }
 };
+
+/**
+ * Decodes requests from a downstream buffer and encodes them to an upstream buffer, as done for
+ * the requests routed to a single server.
+ */
+class ForwardSpeedTest : public Common::Redis::DecoderCallbacks {
+public:
+  ForwardSpeedTest(uint64_t value_size) {
+    std::vector<Common::Redis::RespValue> values(3);
+    values[0].type(Common::Redis::RespType::BulkString);
+    values[0].asString() = "set";
+    values[1].type(Common::Redis::RespType::BulkString);
+    values[1].asString() = std::string(36, 'k');
+    values[2].type(Common::Redis::RespType::BulkString);
+    values[2].asString() = std::string(value_size, 'v');
+    Common::Redis::RespValue request;
+    request.type(Common::Redis::RespType::Array);
+    request.asArray().swap(values);
+
+    Buffer::OwnedImpl encoded;
+    encoder_.encode(request, encoded);
+    encoded_request_ = encoded.toString();
+  }
+
+  void forward() {
+    Buffer::OwnedImpl downstream(encoded_request_);
+    decoder_.decode(downstream);
+    upstream_.drain(upstream_.length());
+  }
+
+  // Common::Redis::DecoderCallbacks
+  void onRespValue(Common::Redis::RespValuePtr&& value) override {
+    encoder_.encode(*value, upstream_);
+  }
+
+private:
+  std::string encoded_request_;
+  Common::Redis::EncoderImpl encoder_;
+  Common::Redis::DecoderImpl decoder_{*this};
+  Buffer::OwnedImpl upstream_;
+};
 } // namespace RedisProxy
 } // namespace NetworkFilters
 } // namespace Extensions
@@ -130,3 +173,12 @@ static void BM_Split_CreateVariant(benchmark::State& state) {
   state.counters["use_count"] = request.use_count();
 }
 BENCHMARK(BM_Split_CreateVariant)->Ranges({{1, 100}, {64, 8 << 14}});
+
+static void BM_Forward(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::RedisProxy::ForwardSpeedTest context(state.range(0));
+  for (auto _ : state) {
+    context.forward();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Forward)->Range(1 << 10, 1 << 20);
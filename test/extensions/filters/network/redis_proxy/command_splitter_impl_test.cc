@@ -8,6 +8,7 @@
 
 #include "extensions/filters/network/common/redis/supported_commands.h"
 #include "extensions/filters/network/redis_proxy/command_splitter_impl.h"
+#include "extensions/filters/network/redis_proxy/near_cache_impl.h"
 
 #include "test/extensions/filters/network/common/redis/mocks.h"
 #include "test/extensions/filters/network/redis_proxy/mocks.h"
@@ -454,6 +455,95 @@ TEST_F(RedisSingleServerRequestTest, EvalNoUpstream) {
   EXPECT_EQ(1UL, store_.counter("redis.foo.command.eval.error").value());
 };
 
+TEST_F(RedisSingleServerRequestTest, NearCache) {
+  envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::NearCache config;
+  config.add_key_prefixes("user:");
+  config.mutable_ttl()->set_seconds(10);
+  Stats::IsolatedStoreImpl near_cache_store;
+  NearCache::CacheStats near_cache_stats = NearCache::Config::generateStats(near_cache_store);
+  auto near_cache = std::make_shared<NearCache::CacheImpl>(
+      std::make_shared<NearCache::Config>(config), near_cache_stats, time_system_);
+  EXPECT_CALL(*conn_pool_, nearCache()).WillRepeatedly(Return(near_cache.get()));
+
+  // The first request misses and fills the cache with its reply.
+  Common::Redis::RespValuePtr request{new Common::Redis::RespValue()};
+  makeBulkStringArray(*request, {"get", "user:1"});
+  makeRequest("user:1", std::move(request));
+  EXPECT_NE(nullptr, handle_);
+  Common::Redis::RespValuePtr response{new Common::Redis::RespValue()};
+  response->type(Common::Redis::RespType::BulkString);
+  response->asString() = "alice";
+  Common::Redis::RespValue expected_response = *response;
+  EXPECT_CALL(callbacks_, onResponse_(PointeesEq(&expected_response)));
+  pool_callbacks_->onResponse(std::move(response));
+
+  // The second one is served from the cache, without any upstream request.
+  request = std::make_unique<Common::Redis::RespValue>();
+  makeBulkStringArray(*request, {"get", "user:1"});
+  EXPECT_CALL(callbacks_, connectionAllowed()).WillOnce(Return(true));
+  EXPECT_CALL(*conn_pool_, makeRequest_(_, _, _)).Times(0);
+  EXPECT_CALL(callbacks_, onResponse_(PointeesEq(&expected_response)));
+  EXPECT_EQ(nullptr, splitter_.makeRequest(std::move(request), callbacks_));
+
+  EXPECT_EQ(1UL, near_cache_stats.hit_.value());
+  EXPECT_EQ(1UL, near_cache_stats.miss_.value());
+  EXPECT_EQ(2UL, store_.counter("redis.foo.command.get.total").value());
+  EXPECT_EQ(2UL, store_.counter("redis.foo.command.get.success").value());
+};
+
+TEST_F(RedisSingleServerRequestTest, NearCacheInvalidatedByWrites) {
+  envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::NearCache config;
+  config.add_key_prefixes("user:");
+  config.mutable_ttl()->set_seconds(10);
+  Stats::IsolatedStoreImpl near_cache_store;
+  NearCache::CacheStats near_cache_stats = NearCache::Config::generateStats(near_cache_store);
+  auto near_cache = std::make_shared<NearCache::CacheImpl>(
+      std::make_shared<NearCache::Config>(config), near_cache_stats, time_system_);
+  EXPECT_CALL(*conn_pool_, nearCache()).WillRepeatedly(Return(near_cache.get()));
+
+  auto request = [](const std::vector<std::string>& strings) {
+    Common::Redis::RespValuePtr request{new Common::Redis::RespValue()};
+    makeBulkStringArray(*request, strings);
+    return request;
+  };
+  auto respond = [this](Common::Redis::RespType type, const std::string& value) {
+    Common::Redis::RespValuePtr response{new Common::Redis::RespValue()};
+    response->type(type);
+    response->asString() = value;
+    Common::Redis::RespValue expected_response = *response;
+    EXPECT_CALL(callbacks_, onResponse_(PointeesEq(&expected_response)));
+    pool_callbacks_->onResponse(std::move(response));
+  };
+
+  makeRequest("user:1", request({"get", "user:1"}));
+  respond(Common::Redis::RespType::BulkString, "alice");
+  EXPECT_EQ(1UL, near_cache->size());
+
+  // The write removes the cached reply, so the read following it is sent upstream and observes it.
+  makeRequest("user:1", request({"SET", "user:1", "bob"}));
+  EXPECT_EQ(0UL, near_cache->size());
+  respond(Common::Redis::RespType::SimpleString, "OK");
+  makeRequest("user:1", request({"get", "user:1"}));
+  respond(Common::Redis::RespType::BulkString, "bob");
+  EXPECT_EQ(1UL, near_cache->size());
+
+  // The reply of a read pending when its key is written may predate the write, so it is not
+  // cached.
+  makeRequest("user:2", request({"get", "user:2"}));
+  ConnPool::PoolCallbacks* get_callbacks = pool_callbacks_;
+  makeRequest("user:2", request({"set", "user:2", "carol"}));
+  ConnPool::PoolCallbacks* set_callbacks = pool_callbacks_;
+  pool_callbacks_ = get_callbacks;
+  respond(Common::Redis::RespType::BulkString, "bob");
+  pool_callbacks_ = set_callbacks;
+  respond(Common::Redis::RespType::SimpleString, "OK");
+  EXPECT_EQ(1UL, near_cache->size());
+
+  EXPECT_EQ(0UL, near_cache_stats.hit_.value());
+  EXPECT_EQ(3UL, near_cache_stats.miss_.value());
+  EXPECT_EQ(1UL, near_cache_stats.invalidation_.value());
+};
+
 MATCHER_P(CompositeArrayEq, rhs, "CompositeArray should be equal") {
   const ConnPool::RespVariant& obj = arg;
   const auto& lhs = absl::get<const Common::Redis::RespValue>(obj);
@@ -721,6 +811,98 @@ TEST_F(RedisMGETCommandHandlerTest, Cancel) {
   handle_->cancel();
 };
 
+MATCHER_P(ArrayEq, rhs, "Array should be equal") {
+  const ConnPool::RespVariant& obj = arg;
+  const auto& lhs = absl::get<const Common::Redis::RespValue>(obj);
+  EXPECT_TRUE(lhs.type() == Common::Redis::RespType::Array);
+  std::vector<std::string> array;
+  for (auto const& entry : lhs.asArray()) {
+    array.emplace_back(entry.asString());
+  }
+  EXPECT_EQ(array, rhs);
+  return true;
+}
+
+// Keys of the same shard are fetched with a single mget, whose reply is scattered to them.
+TEST_F(RedisMGETCommandHandlerTest, KeyAggregation) {
+  InSequence s;
+
+  Common::Redis::RespValuePtr request{new Common::Redis::RespValue()};
+  makeBulkStringArray(*request, {"mget", "0", "1", "2"});
+  pool_callbacks_.resize(2);
+  Common::Redis::Client::MockPoolRequest pool_request1;
+  Common::Redis::Client::MockPoolRequest pool_request2;
+
+  EXPECT_CALL(callbacks_, connectionAllowed()).WillOnce(Return(true));
+  EXPECT_CALL(*conn_pool_, shardKey("0")).WillOnce(Return(absl::optional<uint64_t>(1)));
+  EXPECT_CALL(*conn_pool_, shardKey("1")).WillOnce(Return(absl::optional<uint64_t>(2)));
+  EXPECT_CALL(*conn_pool_, shardKey("2")).WillOnce(Return(absl::optional<uint64_t>(1)));
+  EXPECT_CALL(*conn_pool_,
+              makeRequest_("0", ArrayEq(std::vector<std::string>{"mget", "0", "2"}), _))
+      .WillOnce(DoAll(WithArg<2>(SaveArgAddress(&pool_callbacks_[0])), Return(&pool_request1)));
+  EXPECT_CALL(*conn_pool_,
+              makeRequest_("1", CompositeArrayEq(std::vector<std::string>{"get", "1"}), _))
+      .WillOnce(DoAll(WithArg<2>(SaveArgAddress(&pool_callbacks_[1])), Return(&pool_request2)));
+  handle_ = splitter_.makeRequest(std::move(request), callbacks_);
+  EXPECT_NE(nullptr, handle_);
+
+  Common::Redis::RespValue expected_response;
+  expected_response.type(Common::Redis::RespType::Array);
+  std::vector<Common::Redis::RespValue> elements(3);
+  elements[0].type(Common::Redis::RespType::BulkString);
+  elements[0].asString() = "a";
+  elements[1].type(Common::Redis::RespType::BulkString);
+  elements[1].asString() = "b";
+  expected_response.asArray().swap(elements);
+
+  pool_callbacks_[1]->onResponse(response("b"));
+
+  Common::Redis::RespValuePtr shard_response = std::make_unique<Common::Redis::RespValue>();
+  shard_response->type(Common::Redis::RespType::Array);
+  shard_response->asArray().push_back(*response("a"));
+  shard_response->asArray().emplace_back();
+  EXPECT_CALL(callbacks_, onResponse_(PointeesEq(&expected_response)));
+  pool_callbacks_[0]->onResponse(std::move(shard_response));
+
+  EXPECT_EQ(1UL, store_.counter("redis.foo.command.mget.total").value());
+  EXPECT_EQ(1UL, store_.counter("redis.foo.command.mget.success").value());
+};
+
+// Consecutive keys of a shard are sent without copying them, and the error of their request is
+// the response for each of them.
+TEST_F(RedisMGETCommandHandlerTest, KeyAggregationError) {
+  InSequence s;
+
+  Common::Redis::RespValuePtr request{new Common::Redis::RespValue()};
+  makeBulkStringArray(*request, {"mget", "0", "1"});
+  pool_callbacks_.resize(1);
+  Common::Redis::Client::MockPoolRequest pool_request;
+
+  EXPECT_CALL(callbacks_, connectionAllowed()).WillOnce(Return(true));
+  EXPECT_CALL(*conn_pool_, shardKey("0")).WillOnce(Return(absl::optional<uint64_t>(1)));
+  EXPECT_CALL(*conn_pool_, shardKey("1")).WillOnce(Return(absl::optional<uint64_t>(1)));
+  EXPECT_CALL(*conn_pool_,
+              makeRequest_("0", CompositeArrayEq(std::vector<std::string>{"mget", "0", "1"}), _))
+      .WillOnce(DoAll(WithArg<2>(SaveArgAddress(&pool_callbacks_[0])), Return(&pool_request)));
+  handle_ = splitter_.makeRequest(std::move(request), callbacks_);
+  EXPECT_NE(nullptr, handle_);
+
+  Common::Redis::RespValue expected_response;
+  expected_response.type(Common::Redis::RespType::Array);
+  std::vector<Common::Redis::RespValue> elements(2);
+  elements[0].type(Common::Redis::RespType::Error);
+  elements[0].asString() = "MOVED 1 host";
+  elements[1].type(Common::Redis::RespType::Error);
+  elements[1].asString() = "MOVED 1 host";
+  expected_response.asArray().swap(elements);
+
+  EXPECT_CALL(callbacks_, onResponse_(PointeesEq(&expected_response)));
+  pool_callbacks_[0]->onResponse(Common::Redis::Utility::makeError("MOVED 1 host"));
+
+  EXPECT_EQ(1UL, store_.counter("redis.foo.command.mget.total").value());
+  EXPECT_EQ(1UL, store_.counter("redis.foo.command.mget.error").value());
+};
+
 class RedisMSETCommandHandlerTest : public FragmentedRequestCommandHandlerTest {
 public:
   void setup(uint32_t num_sets, const std::list<uint64_t>& null_handle_indexes,
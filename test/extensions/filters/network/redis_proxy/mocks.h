@@ -79,6 +79,8 @@ public:
   MOCK_METHOD(Common::Redis::Client::PoolRequest*, makeRequest_,
               (const std::string& hash_key, RespVariant& request, PoolCallbacks& callbacks));
   MOCK_METHOD(bool, onRedirection, ());
+  MOCK_METHOD(NearCache::Cache*, nearCache, ());
+  MOCK_METHOD(absl::optional<uint64_t>, shardKey, (const std::string& hash_key));
 };
 } // namespace ConnPool
 
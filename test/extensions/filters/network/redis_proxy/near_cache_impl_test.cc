@@ -0,0 +1,455 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/extensions/filters/network/redis_proxy/v3/redis_proxy.pb.h"
+
+#include "common/buffer/buffer_impl.h"
+#include "common/network/utility.h"
+#include "common/stats/isolated_store_impl.h"
+
+#include "extensions/filters/network/redis_proxy/near_cache_impl.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/upstream/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::InSequence;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+using testing::SaveArg;
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+namespace NearCache {
+
+using NearCacheProto = envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::NearCache;
+
+class RedisNearCacheTest : public testing::Test, public Event::TestUsingSimulatedTime {
+public:
+  void setup(const std::string& yaml) {
+    NearCacheProto proto;
+    TestUtility::loadFromYaml(yaml, proto);
+    config_ = std::make_shared<Config>(proto);
+    stats_ = std::make_unique<CacheStats>(Config::generateStats(store_));
+    cache_ = std::make_shared<CacheImpl>(config_, *stats_, simTime());
+  }
+
+  static Common::Redis::RespValue makeRequest(const std::vector<std::string>& arguments) {
+    Common::Redis::RespValue request;
+    request.type(Common::Redis::RespType::Array);
+    for (const std::string& argument : arguments) {
+      Common::Redis::RespValue value;
+      value.type(Common::Redis::RespType::BulkString);
+      value.asString() = argument;
+      request.asArray().push_back(std::move(value));
+    }
+    return request;
+  }
+
+  static Common::Redis::RespValue makeReply(const std::string& value) {
+    Common::Redis::RespValue reply;
+    reply.type(Common::Redis::RespType::BulkString);
+    reply.asString() = value;
+    return reply;
+  }
+
+  // Look up a request which is expected to miss, and fill it with a reply.
+  void insert(const std::vector<std::string>& arguments, const std::string& value) {
+    FillPtr fill;
+    EXPECT_EQ(nullptr, cache_->lookup(makeRequest(arguments), fill));
+    ASSERT_NE(nullptr, fill);
+    fill->onReply(makeReply(value));
+  }
+
+  // Look up a request which is expected to hit, and return the reply.
+  std::string hit(const std::vector<std::string>& arguments) {
+    FillPtr fill;
+    Common::Redis::RespValuePtr reply = cache_->lookup(makeRequest(arguments), fill);
+    EXPECT_EQ(nullptr, fill);
+    if (reply == nullptr) {
+      ADD_FAILURE() << "missing reply";
+      return "";
+    }
+    return reply->asString();
+  }
+
+  bool miss(const std::vector<std::string>& arguments) {
+    FillPtr fill;
+    return cache_->lookup(makeRequest(arguments), fill) == nullptr && fill != nullptr;
+  }
+
+  // Look up a request which is expected to bypass the cache.
+  bool bypassed(const std::vector<std::string>& arguments) {
+    FillPtr fill;
+    return cache_->lookup(makeRequest(arguments), fill) == nullptr && fill == nullptr;
+  }
+
+  const std::string default_yaml_ = R"EOF(
+key_prefixes: ["user:"]
+commands: ["get", "hget"]
+max_entries: 3
+ttl: 10s
+)EOF";
+
+  Stats::IsolatedStoreImpl store_;
+  ConfigConstSharedPtr config_;
+  std::unique_ptr<CacheStats> stats_;
+  CacheImplSharedPtr cache_;
+};
+
+TEST_F(RedisNearCacheTest, ConfigDefaults) {
+  setup(R"EOF(
+key_prefixes: ["user:"]
+ttl: 1s
+)EOF");
+  EXPECT_TRUE(config_->cachesCommand("get"));
+  EXPECT_FALSE(config_->cachesCommand("hget"));
+  EXPECT_EQ(10000, config_->maxEntries());
+  EXPECT_EQ(std::chrono::milliseconds(1000), config_->ttl());
+  EXPECT_TRUE(config_->cachesKey("user:1"));
+  EXPECT_FALSE(config_->cachesKey("session:1"));
+}
+
+TEST_F(RedisNearCacheTest, ConfigInvalidCommand) {
+  EXPECT_THROW_WITH_MESSAGE(
+      setup(R"EOF(
+key_prefixes: ["user:"]
+commands: ["set"]
+ttl: 1s
+)EOF"),
+      EnvoyException,
+      "redis near cache: 'set' is not a read command hashing on its first argument");
+  EXPECT_THROW_WITH_MESSAGE(
+      setup(R"EOF(
+key_prefixes: ["user:"]
+commands: ["mget"]
+ttl: 1s
+)EOF"),
+      EnvoyException,
+      "redis near cache: 'mget' is not a read command hashing on its first argument");
+}
+
+TEST_F(RedisNearCacheTest, ConfigTrackedPrefixes) {
+  setup(R"EOF(
+key_prefixes: ["user:1", "user:", "session:", "user:", "item:"]
+commands: ["GET"]
+ttl: 1s
+)EOF");
+  EXPECT_TRUE(config_->cachesCommand("get"));
+  EXPECT_EQ((std::vector<std::string>{"item:", "session:", "user:"}), config_->trackedPrefixes());
+
+  setup(R"EOF(
+key_prefixes: ["user:", ""]
+ttl: 1s
+)EOF");
+  EXPECT_TRUE(config_->trackedPrefixes().empty());
+  EXPECT_TRUE(config_->cachesKey("anything"));
+}
+
+TEST_F(RedisNearCacheTest, HitAndMiss) {
+  setup(default_yaml_);
+
+  // Commands and keys which are not cached neither hit nor fill.
+  FillPtr fill;
+  EXPECT_EQ(nullptr, cache_->lookup(makeRequest({"strlen", "user:1"}), fill));
+  EXPECT_EQ(nullptr, fill);
+  EXPECT_EQ(nullptr, cache_->lookup(makeRequest({"get", "session:1"}), fill));
+  EXPECT_EQ(nullptr, fill);
+
+  insert({"get", "user:1"}, "alice");
+  EXPECT_EQ("alice", hit({"GET", "user:1"}));
+
+  // Replies are distinct per command and arguments, but share the entry of their key.
+  insert({"hget", "user:1", "name"}, "Alice");
+  insert({"hget", "user:1", "email"}, "alice@example.com");
+  EXPECT_EQ("Alice", hit({"hget", "user:1", "name"}));
+  EXPECT_EQ("alice@example.com", hit({"hget", "user:1", "email"}));
+  EXPECT_EQ(3, cache_->size());
+  EXPECT_EQ(3, stats_->entries_.value());
+  EXPECT_EQ(4, stats_->hit_.value());
+  EXPECT_EQ(3, stats_->miss_.value());
+}
+
+TEST_F(RedisNearCacheTest, Ttl) {
+  setup(default_yaml_);
+
+  insert({"get", "user:1"}, "alice");
+  simTime().advanceTimeWait(std::chrono::seconds(9));
+  EXPECT_EQ("alice", hit({"get", "user:1"}));
+  simTime().advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_TRUE(miss({"get", "user:1"}));
+  EXPECT_EQ(0, cache_->size());
+  EXPECT_EQ(0, stats_->entries_.value());
+}
+
+TEST_F(RedisNearCacheTest, Eviction) {
+  setup(default_yaml_);
+
+  insert({"get", "user:1"}, "1");
+  insert({"get", "user:2"}, "2");
+  insert({"get", "user:3"}, "3");
+  // Makes user:2 the least recently used.
+  EXPECT_EQ("1", hit({"get", "user:1"}));
+  insert({"get", "user:4"}, "4");
+
+  EXPECT_EQ(1, stats_->eviction_.value());
+  EXPECT_EQ(3, cache_->size());
+  EXPECT_TRUE(miss({"get", "user:2"}));
+  EXPECT_EQ("1", hit({"get", "user:1"}));
+  EXPECT_EQ("3", hit({"get", "user:3"}));
+  EXPECT_EQ("4", hit({"get", "user:4"}));
+}
+
+TEST_F(RedisNearCacheTest, Invalidate) {
+  setup(default_yaml_);
+
+  insert({"get", "user:1"}, "1");
+  insert({"hget", "user:1", "name"}, "Alice");
+  insert({"get", "user:2"}, "2");
+  cache_->invalidate("user:1");
+  cache_->invalidate("user:3");
+
+  EXPECT_EQ(1, stats_->invalidation_.value());
+  EXPECT_EQ(1, cache_->size());
+  EXPECT_TRUE(miss({"get", "user:1"}));
+  EXPECT_TRUE(miss({"hget", "user:1", "name"}));
+  EXPECT_EQ("2", hit({"get", "user:2"}));
+}
+
+TEST_F(RedisNearCacheTest, InvalidateWhilePending) {
+  setup(default_yaml_);
+
+  FillPtr fill1;
+  FillPtr fill2;
+  EXPECT_EQ(nullptr, cache_->lookup(makeRequest({"get", "user:1"}), fill1));
+  cache_->invalidate("user:1");
+  EXPECT_EQ(nullptr, cache_->lookup(makeRequest({"get", "user:1"}), fill2));
+
+  // Only the reply of the request looked up after the invalidation is cached, since the other one
+  // may predate it.
+  fill1->onReply(makeReply("old"));
+  EXPECT_EQ(0, cache_->size());
+  fill2->onReply(makeReply("new"));
+  EXPECT_EQ("new", hit({"get", "user:1"}));
+  fill1.reset();
+  fill2.reset();
+
+  // Once no request is pending, replies are cached again.
+  insert({"get", "user:2"}, "2");
+  EXPECT_EQ("2", hit({"get", "user:2"}));
+}
+
+TEST_F(RedisNearCacheTest, FlushWhilePending) {
+  setup(default_yaml_);
+
+  insert({"get", "user:1"}, "1");
+  FillPtr fill;
+  EXPECT_EQ(nullptr, cache_->lookup(makeRequest({"get", "user:2"}), fill));
+  cache_->flush();
+  fill->onReply(makeReply("2"));
+
+  EXPECT_EQ(1, stats_->flush_.value());
+  EXPECT_EQ(0, cache_->size());
+  EXPECT_EQ(0, stats_->entries_.value());
+}
+
+TEST_F(RedisNearCacheTest, ErrorNotCached) {
+  setup(default_yaml_);
+
+  FillPtr fill;
+  EXPECT_EQ(nullptr, cache_->lookup(makeRequest({"get", "user:1"}), fill));
+  Common::Redis::RespValue error;
+  error.type(Common::Redis::RespType::Error);
+  error.asString() = "ERR";
+  fill->onReply(error);
+  fill.reset();
+  EXPECT_TRUE(miss({"get", "user:1"}));
+}
+
+TEST_F(RedisNearCacheTest, FillOutlivesCache) {
+  setup(default_yaml_);
+
+  FillPtr fill;
+  EXPECT_EQ(nullptr, cache_->lookup(makeRequest({"get", "user:1"}), fill));
+  cache_.reset();
+  fill->onReply(makeReply("1"));
+  fill.reset();
+  EXPECT_EQ(0, stats_->entries_.value());
+}
+
+class RedisNearCacheTrackingTest : public RedisNearCacheTest {
+public:
+  RedisNearCacheTrackingTest() {
+    ON_CALL(*host_, address())
+        .WillByDefault(Return(Network::Utility::resolveUrl("tcp://10.0.0.1:6379")));
+  }
+
+  ~RedisNearCacheTrackingTest() override {
+    if (cache_ != nullptr) {
+      cache_->untrackAllHosts();
+    }
+  }
+
+  // Expect a connection to the host, with timers created in the order of near_cache_impl.cc.
+  void expectConnect(bool create_timers) {
+    if (create_timers) {
+      InSequence s;
+      connect_timer_ = new Event::MockTimer(&dispatcher_);
+      reconnect_timer_ = new Event::MockTimer(&dispatcher_);
+    }
+    written_.clear();
+    upstream_connection_ = new NiceMock<Network::MockClientConnection>();
+    Upstream::MockHost::MockCreateConnectionData conn_info;
+    conn_info.connection_ = upstream_connection_;
+    EXPECT_CALL(*host_, createConnection_(_, _)).WillOnce(Return(conn_info));
+    EXPECT_CALL(*upstream_connection_, addReadFilter(_))
+        .WillOnce(SaveArg<0>(&upstream_read_filter_));
+    EXPECT_CALL(*upstream_connection_, connect());
+    EXPECT_CALL(*connect_timer_, enableTimer(_, _));
+    ON_CALL(*upstream_connection_, write(_, _))
+        .WillByDefault(Invoke([this](Buffer::Instance& data, bool) -> void {
+          written_ += data.toString();
+          data.drain(data.length());
+        }));
+  }
+
+  void respond(const std::string& data) {
+    Buffer::OwnedImpl buffer(data);
+    upstream_read_filter_->onData(buffer, false);
+  }
+
+  // Complete the handshake of the tracking connection.
+  void subscribe() {
+    upstream_connection_->raiseEvent(Network::ConnectionEvent::Connected);
+    EXPECT_FALSE(connect_timer_->enabled_);
+    EXPECT_EQ("*2\r\n$6\r\nclient\r\n$2\r\nid\r\n", written_);
+    written_.clear();
+
+    respond(":42\r\n");
+    EXPECT_EQ("*8\r\n$6\r\nclient\r\n$8\r\ntracking\r\n$2\r\non\r\n$8\r\nredirect\r\n$2\r\n42\r\n"
+              "$5\r\nbcast\r\n$6\r\nprefix\r\n$5\r\nuser:\r\n"
+              "*2\r\n$9\r\nsubscribe\r\n$20\r\n__redis__:invalidate\r\n",
+              written_);
+    written_.clear();
+
+    respond("+OK\r\n*3\r\n$9\r\nsubscribe\r\n$20\r\n__redis__:invalidate\r\n:1\r\n");
+  }
+
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  std::shared_ptr<NiceMock<Upstream::MockHost>> host_{new NiceMock<Upstream::MockHost>()};
+  Event::MockTimer* connect_timer_{};
+  Event::MockTimer* reconnect_timer_{};
+  NiceMock<Network::MockClientConnection>* upstream_connection_{};
+  Network::ReadFilterSharedPtr upstream_read_filter_;
+  std::string written_;
+};
+
+TEST_F(RedisNearCacheTrackingTest, Invalidations) {
+  setup(default_yaml_);
+  expectConnect(true);
+  cache_->trackHost(host_, dispatcher_, "");
+  subscribe();
+  // Subscribing flushes the replies cached while invalidations could have been missed.
+  EXPECT_EQ(1, stats_->flush_.value());
+
+  insert({"get", "user:1"}, "1");
+  insert({"get", "user:2"}, "2");
+  respond("*3\r\n$7\r\nmessage\r\n$20\r\n__redis__:invalidate\r\n*1\r\n$6\r\nuser:1\r\n");
+  EXPECT_EQ(1, stats_->invalidation_.value());
+  EXPECT_TRUE(miss({"get", "user:1"}));
+  EXPECT_EQ("2", hit({"get", "user:2"}));
+
+  // A null list of keys invalidates all of them.
+  respond("*3\r\n$7\r\nmessage\r\n$20\r\n__redis__:invalidate\r\n*-1\r\n");
+  EXPECT_EQ(2, stats_->flush_.value());
+  EXPECT_EQ(0, cache_->size());
+
+  // Tracking the same host again keeps the existing connection.
+  cache_->trackHost(host_, dispatcher_, "");
+
+  EXPECT_CALL(*upstream_connection_, close(Network::ConnectionCloseType::NoFlush));
+  EXPECT_CALL(*reconnect_timer_, enableTimer(_, _)).Times(0);
+  cache_->untrackHost(host_);
+}
+
+// Invalidations are missed while the tracking connection is down, so the cache is flushed and
+// bypassed until subscribed again.
+TEST_F(RedisNearCacheTrackingTest, DisconnectBypassesCache) {
+  setup(default_yaml_);
+  expectConnect(true);
+  cache_->trackHost(host_, dispatcher_, "");
+  EXPECT_TRUE(bypassed({"get", "user:1"}));
+  subscribe();
+
+  insert({"get", "user:1"}, "1");
+  EXPECT_EQ("1", hit({"get", "user:1"}));
+  FillPtr fill;
+  EXPECT_EQ(nullptr, cache_->lookup(makeRequest({"get", "user:2"}), fill));
+  ASSERT_NE(nullptr, fill);
+
+  EXPECT_CALL(*reconnect_timer_, enableTimer(std::chrono::milliseconds(1000), _));
+  upstream_connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  EXPECT_EQ(2, stats_->flush_.value());
+  EXPECT_EQ(0, cache_->size());
+  EXPECT_TRUE(bypassed({"get", "user:1"}));
+  // The reply of a request pending when the connection closed may be stale.
+  fill->onReply(makeReply("2"));
+  EXPECT_EQ(0, cache_->size());
+
+  expectConnect(false);
+  reconnect_timer_->invokeCallback();
+  EXPECT_TRUE(bypassed({"get", "user:1"}));
+  subscribe();
+  EXPECT_TRUE(miss({"get", "user:1"}));
+  EXPECT_TRUE(miss({"get", "user:2"}));
+}
+
+TEST_F(RedisNearCacheTrackingTest, Auth) {
+  setup(default_yaml_);
+  expectConnect(true);
+  cache_->trackHost(host_, dispatcher_, "secret");
+  EXPECT_EQ("*2\r\n$4\r\nauth\r\n$6\r\nsecret\r\n*2\r\n$6\r\nclient\r\n$2\r\nid\r\n", written_);
+}
+
+TEST_F(RedisNearCacheTrackingTest, ErrorReconnects) {
+  setup(default_yaml_);
+  expectConnect(true);
+  cache_->trackHost(host_, dispatcher_, "");
+  upstream_connection_->raiseEvent(Network::ConnectionEvent::Connected);
+
+  // Servers older than Redis 6 reject CLIENT ID.
+  EXPECT_CALL(*reconnect_timer_, enableTimer(std::chrono::milliseconds(1000), _));
+  respond("-ERR unknown subcommand 'id'\r\n");
+  EXPECT_EQ(1, stats_->tracking_error_.value());
+
+  expectConnect(false);
+  reconnect_timer_->invokeCallback();
+
+  // The delay doubles until the connection subscribes.
+  EXPECT_CALL(*reconnect_timer_, enableTimer(std::chrono::milliseconds(2000), _));
+  connect_timer_->invokeCallback();
+  EXPECT_EQ(2, stats_->tracking_error_.value());
+
+  expectConnect(false);
+  reconnect_timer_->invokeCallback();
+  subscribe();
+
+  EXPECT_CALL(*reconnect_timer_, enableTimer(std::chrono::milliseconds(1000), _));
+  upstream_connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+}
+
+} // namespace NearCache
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
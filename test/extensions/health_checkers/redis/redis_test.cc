@@ -200,6 +200,7 @@ public:
     EXPECT_EQ(session->bufferFlushTimeoutInMs(), std::chrono::milliseconds(1));
     EXPECT_EQ(session->maxUpstreamUnknownConnections(), 0);
     EXPECT_FALSE(session->enableCommandStats());
+    EXPECT_FALSE(session->enableAutoPipelining());
     session->onDeferredDeleteBase(); // This must be called to pass assertions in the destructor.
   }
 
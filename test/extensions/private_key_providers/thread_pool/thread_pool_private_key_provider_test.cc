@@ -0,0 +1,209 @@
+#include <string>
+#include <vector>
+
+#include "envoy/extensions/private_key_providers/thread_pool/v3alpha/thread_pool.pb.h"
+
+#include "common/stats/isolated_store_impl.h"
+
+#include "extensions/private_key_providers/thread_pool/thread_pool_private_key_provider.h"
+
+#include "test/mocks/server/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "openssl/pem.h"
+#include "openssl/ssl.h"
+
+using testing::NiceMock;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+namespace {
+
+class TestCallbacks : public Ssl::PrivateKeyConnectionCallbacks {
+public:
+  TestCallbacks(Event::Dispatcher& dispatcher) : dispatcher_(dispatcher) {}
+
+  // Ssl::PrivateKeyConnectionCallbacks
+  void onPrivateKeyMethodComplete() override {
+    completed_ = true;
+    dispatcher_.exit();
+  }
+
+  Event::Dispatcher& dispatcher_;
+  bool completed_{};
+};
+
+class ThreadPoolPrivateKeyProviderTest : public testing::Test {
+protected:
+  ThreadPoolPrivateKeyProviderTest()
+      : api_(Api::createApiForTest(store_)), dispatcher_(api_->allocateDispatcher("test_thread")),
+        callbacks_(*dispatcher_), ssl_ctx_(SSL_CTX_new(TLS_method())),
+        ssl_(SSL_new(ssl_ctx_.get())) {
+    ON_CALL(factory_context_, api()).WillByDefault(ReturnRef(*api_));
+    ON_CALL(factory_context_, scope()).WillByDefault(ReturnRef(store_));
+  }
+
+  ~ThreadPoolPrivateKeyProviderTest() override {
+    if (provider_ != nullptr) {
+      provider_->unregisterPrivateKeyMethod(ssl_.get());
+    }
+  }
+
+  void createProvider(const std::string& key_file) {
+    config_.mutable_private_key()->set_filename(TestEnvironment::substitute(
+        "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/" + key_file));
+    provider_ = std::make_unique<ThreadPoolPrivateKeyMethodProvider>(config_, factory_context_);
+    provider_->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+  }
+
+  bssl::UniquePtr<EVP_PKEY> readKey(const std::string& key_file) {
+    const std::string pem = api_->fileSystem().fileReadToEnd(TestEnvironment::substitute(
+        "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/" + key_file));
+    bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(pem.data(), pem.size()));
+    return bssl::UniquePtr<EVP_PKEY>(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  }
+
+  bool verify(EVP_PKEY* pkey, uint16_t signature_algorithm, const std::string& in,
+              const uint8_t* sig, size_t sig_len) {
+    bssl::ScopedEVP_MD_CTX ctx;
+    EVP_PKEY_CTX* pctx = nullptr;
+    if (!EVP_DigestVerifyInit(ctx.get(), &pctx,
+                              SSL_get_signature_algorithm_digest(signature_algorithm), nullptr,
+                              pkey)) {
+      return false;
+    }
+    if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm) &&
+        (!EVP_PKEY_CTX_set_rsa_padding(pctx, RSA_PKCS1_PSS_PADDING) ||
+         !EVP_PKEY_CTX_set_rsa_pss_saltlen(pctx, -1))) {
+      return false;
+    }
+    return EVP_DigestVerify(ctx.get(), sig, sig_len, reinterpret_cast<const uint8_t*>(in.data()),
+                            in.size()) == 1;
+  }
+
+  void signAndVerify(const std::string& key_file, uint16_t signature_algorithm) {
+    createProvider(key_file);
+    Ssl::BoringSslPrivateKeyMethodSharedPtr method = provider_->getBoringSslPrivateKeyMethod();
+
+    const std::string in = "handshake transcript";
+    uint8_t out[1024];
+    size_t out_len = 0;
+    EXPECT_EQ(ssl_private_key_retry,
+              method->sign(ssl_.get(), out, &out_len, sizeof(out), signature_algorithm,
+                           reinterpret_cast<const uint8_t*>(in.data()), in.size()));
+    // The result is only handed over on the connection's dispatcher, so polling before that has
+    // to keep the handshake waiting.
+    EXPECT_EQ(ssl_private_key_retry, method->complete(ssl_.get(), out, &out_len, sizeof(out)));
+
+    dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+    EXPECT_TRUE(callbacks_.completed_);
+    EXPECT_EQ(ssl_private_key_success, method->complete(ssl_.get(), out, &out_len, sizeof(out)));
+    EXPECT_TRUE(verify(readKey(key_file).get(), signature_algorithm, in, out, out_len));
+
+    EXPECT_EQ(1UL, store_.counter("private_key_provider.thread_pool.sign_ops").value());
+    EXPECT_EQ(0UL, store_.counter("private_key_provider.thread_pool.failed_ops").value());
+    EXPECT_EQ(0UL, store_.counter("private_key_provider.thread_pool.queue_overflow").value());
+    EXPECT_EQ(0UL, store_.gauge("private_key_provider.thread_pool.queue_depth",
+                                Stats::Gauge::ImportMode::Accumulate)
+                       .value());
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  TestCallbacks callbacks_;
+  NiceMock<Server::Configuration::MockTransportSocketFactoryContext> factory_context_;
+  envoy::extensions::private_key_providers::thread_pool::v3alpha::ThreadPoolPrivateKeyMethodConfig
+      config_;
+  bssl::UniquePtr<SSL_CTX> ssl_ctx_;
+  bssl::UniquePtr<SSL> ssl_;
+  std::unique_ptr<ThreadPoolPrivateKeyMethodProvider> provider_;
+};
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, RsaPkcs1Sign) {
+  signAndVerify("selfsigned_key.pem", SSL_SIGN_RSA_PKCS1_SHA256);
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, RsaPssSign) {
+  signAndVerify("selfsigned_key.pem", SSL_SIGN_RSA_PSS_RSAE_SHA256);
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, EcdsaSign) {
+  signAndVerify("selfsigned_ecdsa_p256_key.pem", SSL_SIGN_ECDSA_SECP256R1_SHA256);
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, SignatureAlgorithmKeyTypeMismatch) {
+  createProvider("selfsigned_key.pem");
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method = provider_->getBoringSslPrivateKeyMethod();
+
+  const uint8_t in[] = {1, 2, 3};
+  uint8_t out[1024];
+  size_t out_len = 0;
+  EXPECT_EQ(ssl_private_key_retry, method->sign(ssl_.get(), out, &out_len, sizeof(out),
+                                                SSL_SIGN_ECDSA_SECP256R1_SHA256, in, sizeof(in)));
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  EXPECT_EQ(ssl_private_key_failure, method->complete(ssl_.get(), out, &out_len, sizeof(out)));
+  EXPECT_EQ(1UL, store_.counter("private_key_provider.thread_pool.failed_ops").value());
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, OutputBufferTooSmall) {
+  createProvider("selfsigned_key.pem");
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method = provider_->getBoringSslPrivateKeyMethod();
+
+  const uint8_t in[] = {1, 2, 3};
+  uint8_t out[16];
+  size_t out_len = 0;
+  EXPECT_EQ(ssl_private_key_retry, method->sign(ssl_.get(), out, &out_len, sizeof(out),
+                                                SSL_SIGN_RSA_PKCS1_SHA256, in, sizeof(in)));
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  EXPECT_EQ(ssl_private_key_failure, method->complete(ssl_.get(), out, &out_len, sizeof(out)));
+}
+
+// Tearing down the connection while the operation is in flight must not invoke the callbacks.
+TEST_F(ThreadPoolPrivateKeyProviderTest, UnregisterWithOperationInFlight) {
+  createProvider("selfsigned_key.pem");
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method = provider_->getBoringSslPrivateKeyMethod();
+
+  const uint8_t in[] = {1, 2, 3};
+  uint8_t out[1024];
+  size_t out_len = 0;
+  EXPECT_EQ(ssl_private_key_retry, method->sign(ssl_.get(), out, &out_len, sizeof(out),
+                                                SSL_SIGN_RSA_PKCS1_SHA256, in, sizeof(in)));
+  provider_->unregisterPrivateKeyMethod(ssl_.get());
+  // Destroying the provider joins the pool threads.
+  provider_.reset();
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_FALSE(callbacks_.completed_);
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, DoubleRegistration) {
+  createProvider("selfsigned_key.pem");
+  EXPECT_THROW_WITH_MESSAGE(
+      provider_->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_), EnvoyException,
+      "Can't distinguish between two registered providers for the same SSL object.");
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, InvalidPrivateKey) {
+  config_.mutable_private_key()->set_inline_string("not a key");
+  EXPECT_THROW_WITH_MESSAGE(ThreadPoolPrivateKeyMethodProvider(config_, factory_context_),
+                            EnvoyException,
+                            "Failed to load private key for the thread pool private key provider.");
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, CheckFips) {
+  createProvider("selfsigned_key.pem");
+  // The unit test key is a 2048 bit RSA key.
+  EXPECT_TRUE(provider_->checkFips());
+}
+
+} // namespace
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
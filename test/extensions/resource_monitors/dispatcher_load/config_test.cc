@@ -0,0 +1,42 @@
+#include "envoy/config/resource_monitor/dispatcher_load/v2alpha/dispatcher_load.pb.h"
+#include "envoy/config/resource_monitor/dispatcher_load/v2alpha/dispatcher_load.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "server/resource_monitor_config_impl.h"
+
+#include "extensions/resource_monitors/dispatcher_load/config.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace DispatcherLoadMonitor {
+namespace {
+
+TEST(DispatcherLoadMonitorFactoryTest, CreateMonitor) {
+  auto factory =
+      Registry::FactoryRegistry<Server::Configuration::ResourceMonitorFactory>::getFactory(
+          "envoy.resource_monitors.dispatcher_load");
+  EXPECT_NE(factory, nullptr);
+
+  envoy::config::resource_monitor::dispatcher_load::v2alpha::DispatcherLoadConfig config;
+  config.mutable_max_loop_duration()->set_seconds(1);
+  config.mutable_max_queue_lag()->set_seconds(1);
+  Event::MockDispatcher dispatcher;
+  testing::NiceMock<ThreadLocal::MockInstance> thread_local;
+  Api::ApiPtr api = Api::createApiForTest();
+  Server::Configuration::ResourceMonitorFactoryContextImpl context(
+      dispatcher, thread_local, *api, ProtobufMessage::getStrictValidationVisitor());
+  auto monitor = factory->createResourceMonitor(config, context);
+  EXPECT_NE(monitor, nullptr);
+}
+
+} // namespace
+} // namespace DispatcherLoadMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,131 @@
+#include <chrono>
+
+#include "envoy/config/resource_monitor/dispatcher_load/v2alpha/dispatcher_load.pb.h"
+
+#include "server/resource_monitor_config_impl.h"
+
+#include "extensions/resource_monitors/dispatcher_load/dispatcher_load_monitor.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "absl/types/optional.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace DispatcherLoadMonitor {
+namespace {
+
+class ResourcePressure : public Server::ResourceMonitor::Callbacks {
+public:
+  void onSuccess(const Server::ResourceUsage& usage) override {
+    pressure_ = usage.resource_pressure_;
+  }
+
+  void onFailure(const EnvoyException& error) override { error_ = error; }
+
+  bool hasPressure() const { return pressure_.has_value(); }
+  bool hasError() const { return error_.has_value(); }
+
+  double pressure() const { return *pressure_; }
+
+private:
+  absl::optional<double> pressure_;
+  absl::optional<EnvoyException> error_;
+};
+
+class DispatcherLoadMonitorTest : public testing::Test {
+protected:
+  DispatcherLoadMonitorTest() : api_(Api::createApiForTest(time_system_)) {}
+
+  std::unique_ptr<DispatcherLoadMonitor> createMonitor() {
+    envoy::config::resource_monitor::dispatcher_load::v2alpha::DispatcherLoadConfig config;
+    config.mutable_max_loop_duration()->set_nanos(20 * 1000 * 1000);
+    config.mutable_max_queue_lag()->set_nanos(10 * 1000 * 1000);
+    Server::Configuration::ResourceMonitorFactoryContextImpl context(
+        dispatcher_, thread_local_, *api_, ProtobufMessage::getStrictValidationVisitor());
+    return std::make_unique<DispatcherLoadMonitor>(config, context);
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Api::ApiPtr api_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  NiceMock<ThreadLocal::MockInstance> thread_local_;
+};
+
+TEST_F(DispatcherLoadMonitorTest, LoopDuration) {
+  auto monitor = createMonitor();
+
+  EXPECT_CALL(thread_local_.dispatcher_, takeMaxLoopDuration())
+      .WillOnce(Return(std::chrono::milliseconds(5)));
+  ResourcePressure resource;
+  monitor->updateResourceUsage(resource);
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_FALSE(resource.hasError());
+  EXPECT_DOUBLE_EQ(0.25, resource.pressure());
+
+  // The pressure may exceed 1.
+  EXPECT_CALL(thread_local_.dispatcher_, takeMaxLoopDuration())
+      .WillOnce(Return(std::chrono::milliseconds(30)));
+  monitor->updateResourceUsage(resource);
+  EXPECT_DOUBLE_EQ(1.5, resource.pressure());
+}
+
+TEST_F(DispatcherLoadMonitorTest, QueueLag) {
+  auto monitor = createMonitor();
+
+  // Delay the probe by 8ms.
+  Event::PostCb probe_cb;
+  Event::PostCb complete_cb;
+  EXPECT_CALL(thread_local_, runOnAllThreads(_, _))
+      .WillOnce(Invoke([&](Event::PostCb cb, Event::PostCb main_cb) {
+        probe_cb = cb;
+        complete_cb = main_cb;
+      }));
+  ResourcePressure resource;
+  monitor->updateResourceUsage(resource);
+  EXPECT_FALSE(resource.hasPressure());
+
+  time_system_.advanceTimeWait(std::chrono::milliseconds(8));
+  EXPECT_CALL(thread_local_.dispatcher_, takeMaxLoopDuration())
+      .WillOnce(Return(std::chrono::milliseconds(2)));
+  probe_cb();
+  complete_cb();
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_DOUBLE_EQ(0.8, resource.pressure());
+}
+
+TEST_F(DispatcherLoadMonitorTest, DestroyedDuringUpdate) {
+  auto monitor = createMonitor();
+
+  Event::PostCb probe_cb;
+  Event::PostCb complete_cb;
+  EXPECT_CALL(thread_local_, runOnAllThreads(_, _))
+      .WillOnce(Invoke([&](Event::PostCb cb, Event::PostCb main_cb) {
+        probe_cb = cb;
+        complete_cb = main_cb;
+      }));
+  ResourcePressure resource;
+  monitor->updateResourceUsage(resource);
+  monitor.reset();
+
+  // The callbacks of the destroyed monitor are not invoked anymore.
+  complete_cb();
+  EXPECT_FALSE(resource.hasPressure());
+}
+
+} // namespace
+} // namespace DispatcherLoadMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
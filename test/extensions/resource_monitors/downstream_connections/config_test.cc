@@ -0,0 +1,42 @@
+#include "envoy/config/resource_monitor/downstream_connections/v2alpha/downstream_connections.pb.h"
+#include "envoy/config/resource_monitor/downstream_connections/v2alpha/downstream_connections.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "server/resource_monitor_config_impl.h"
+
+#include "extensions/resource_monitors/downstream_connections/config.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace DownstreamConnectionsMonitor {
+namespace {
+
+TEST(DownstreamConnectionsMonitorFactoryTest, CreateMonitor) {
+  auto factory =
+      Registry::FactoryRegistry<Server::Configuration::ResourceMonitorFactory>::getFactory(
+          "envoy.resource_monitors.downstream_connections");
+  EXPECT_NE(factory, nullptr);
+
+  envoy::config::resource_monitor::downstream_connections::v2alpha::DownstreamConnectionsConfig
+      config;
+  config.set_max_active_downstream_connections(1000);
+  Event::MockDispatcher dispatcher;
+  testing::NiceMock<ThreadLocal::MockInstance> thread_local;
+  Api::ApiPtr api = Api::createApiForTest();
+  Server::Configuration::ResourceMonitorFactoryContextImpl context(
+      dispatcher, thread_local, *api, ProtobufMessage::getStrictValidationVisitor());
+  auto monitor = factory->createResourceMonitor(config, context);
+  EXPECT_NE(monitor, nullptr);
+}
+
+} // namespace
+} // namespace DownstreamConnectionsMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,71 @@
+#include "envoy/config/resource_monitor/downstream_connections/v2alpha/downstream_connections.pb.h"
+
+#include "server/connection_handler_impl.h"
+
+#include "extensions/resource_monitors/downstream_connections/downstream_connections_monitor.h"
+
+#include "test/mocks/event/mocks.h"
+
+#include "absl/types/optional.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace DownstreamConnectionsMonitor {
+namespace {
+
+class ResourcePressure : public Server::ResourceMonitor::Callbacks {
+public:
+  void onSuccess(const Server::ResourceUsage& usage) override {
+    pressure_ = usage.resource_pressure_;
+  }
+
+  void onFailure(const EnvoyException& error) override { error_ = error; }
+
+  bool hasPressure() const { return pressure_.has_value(); }
+  bool hasError() const { return error_.has_value(); }
+
+  double pressure() const { return *pressure_; }
+
+private:
+  absl::optional<double> pressure_;
+  absl::optional<EnvoyException> error_;
+};
+
+TEST(DownstreamConnectionsMonitorTest, CountsConnectionsOfAllHandlers) {
+  envoy::config::resource_monitor::downstream_connections::v2alpha::DownstreamConnectionsConfig
+      config;
+  config.set_max_active_downstream_connections(10);
+  DownstreamConnectionsMonitor monitor(config);
+
+  testing::NiceMock<Event::MockDispatcher> dispatcher1;
+  testing::NiceMock<Event::MockDispatcher> dispatcher2;
+  Server::ConnectionHandlerImpl handler1(dispatcher1);
+  Server::ConnectionHandlerImpl handler2(dispatcher2);
+  handler1.incNumConnections();
+  handler1.incNumConnections();
+  handler2.incNumConnections();
+
+  ResourcePressure resource;
+  monitor.updateResourceUsage(resource);
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_FALSE(resource.hasError());
+  EXPECT_DOUBLE_EQ(0.3, resource.pressure());
+
+  handler1.decNumConnections();
+  handler1.decNumConnections();
+  monitor.updateResourceUsage(resource);
+  EXPECT_DOUBLE_EQ(0.1, resource.pressure());
+
+  handler2.decNumConnections();
+  monitor.updateResourceUsage(resource);
+  EXPECT_EQ(0, resource.pressure());
+}
+
+} // namespace
+} // namespace DownstreamConnectionsMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -7,6 +7,7 @@
 #include "extensions/resource_monitors/fixed_heap/config.h"
 
 #include "test/mocks/event/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 
 #include "gtest/gtest.h"
 
@@ -25,9 +26,10 @@ TEST(FixedHeapMonitorFactoryTest, CreateMonitor) {
   envoy::config::resource_monitor::fixed_heap::v2alpha::FixedHeapConfig config;
   config.set_max_heap_size_bytes(std::numeric_limits<uint64_t>::max());
   Event::MockDispatcher dispatcher;
+  testing::NiceMock<ThreadLocal::MockInstance> thread_local;
   Api::ApiPtr api = Api::createApiForTest();
   Server::Configuration::ResourceMonitorFactoryContextImpl context(
-      dispatcher, *api, ProtobufMessage::getStrictValidationVisitor());
+      dispatcher, thread_local, *api, ProtobufMessage::getStrictValidationVisitor());
   auto monitor = factory->createResourceMonitor(config, context);
   EXPECT_NE(monitor, nullptr);
 }
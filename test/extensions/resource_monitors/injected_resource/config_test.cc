@@ -8,6 +8,7 @@
 
 #include "extensions/resource_monitors/injected_resource/config.h"
 
+#include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/utility.h"
 
@@ -29,8 +30,9 @@ TEST(InjectedResourceMonitorFactoryTest, CreateMonitor) {
   config.set_filename(TestEnvironment::temporaryPath("injected_resource"));
   Api::ApiPtr api = Api::createApiForTest();
   Event::DispatcherPtr dispatcher(api->allocateDispatcher("test_thread"));
+  testing::NiceMock<ThreadLocal::MockInstance> thread_local;
   Server::Configuration::ResourceMonitorFactoryContextImpl context(
-      *dispatcher, *api, ProtobufMessage::getStrictValidationVisitor());
+      *dispatcher, thread_local, *api, ProtobufMessage::getStrictValidationVisitor());
   Server::ResourceMonitorPtr monitor = factory->createResourceMonitor(config, context);
   EXPECT_NE(monitor, nullptr);
 }
@@ -0,0 +1,41 @@
+#include "envoy/config/resource_monitor/pressure_stall/v2alpha/pressure_stall.pb.h"
+#include "envoy/config/resource_monitor/pressure_stall/v2alpha/pressure_stall.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "server/resource_monitor_config_impl.h"
+
+#include "extensions/resource_monitors/pressure_stall/config.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace PressureStallMonitor {
+namespace {
+
+TEST(PressureStallMonitorFactoryTest, CreateMonitor) {
+  auto factory =
+      Registry::FactoryRegistry<Server::Configuration::ResourceMonitorFactory>::getFactory(
+          "envoy.resource_monitors.pressure_stall");
+  EXPECT_NE(factory, nullptr);
+
+  envoy::config::resource_monitor::pressure_stall::v2alpha::PressureStallConfig config;
+  config.set_max_stall_percent(50);
+  Event::MockDispatcher dispatcher;
+  testing::NiceMock<ThreadLocal::MockInstance> thread_local;
+  Api::ApiPtr api = Api::createApiForTest();
+  Server::Configuration::ResourceMonitorFactoryContextImpl context(
+      dispatcher, thread_local, *api, ProtobufMessage::getStrictValidationVisitor());
+  auto monitor = factory->createResourceMonitor(config, context);
+  EXPECT_NE(monitor, nullptr);
+}
+
+} // namespace
+} // namespace PressureStallMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,126 @@
+#include "envoy/config/resource_monitor/pressure_stall/v2alpha/pressure_stall.pb.h"
+
+#include "server/resource_monitor_config_impl.h"
+
+#include "extensions/resource_monitors/pressure_stall/pressure_stall_monitor.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "absl/types/optional.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace PressureStallMonitor {
+namespace {
+
+using PressureStallConfig =
+    envoy::config::resource_monitor::pressure_stall::v2alpha::PressureStallConfig;
+
+const std::string PressureContents = "some avg10=12.50 avg60=4.00 avg300=1.25 total=2178234\n"
+                                     "full avg10=2.00 avg60=0.50 avg300=0.00 total=28301\n";
+
+class ResourcePressure : public Server::ResourceMonitor::Callbacks {
+public:
+  void onSuccess(const Server::ResourceUsage& usage) override {
+    pressure_ = usage.resource_pressure_;
+    error_.reset();
+  }
+
+  void onFailure(const EnvoyException& error) override {
+    error_ = error;
+    pressure_.reset();
+  }
+
+  bool hasPressure() const { return pressure_.has_value(); }
+  bool hasError() const { return error_.has_value(); }
+
+  double pressure() const { return *pressure_; }
+
+private:
+  absl::optional<double> pressure_;
+  absl::optional<EnvoyException> error_;
+};
+
+class PressureStallMonitorTest : public testing::Test {
+protected:
+  PressureStallMonitorTest() : api_(Api::createApiForTest()) {}
+
+  std::unique_ptr<PressureStallMonitor> createMonitor(const PressureStallConfig& config) {
+    Server::Configuration::ResourceMonitorFactoryContextImpl context(
+        dispatcher_, thread_local_, *api_, ProtobufMessage::getStrictValidationVisitor());
+    return std::make_unique<PressureStallMonitor>(config, context);
+  }
+
+  Api::ApiPtr api_;
+  testing::NiceMock<Event::MockDispatcher> dispatcher_;
+  testing::NiceMock<ThreadLocal::MockInstance> thread_local_;
+};
+
+TEST(PressureStallParseTest, ParsesAverages) {
+  EXPECT_EQ(12.5, PressureStallMonitor::parseStallPercent(PressureContents, "some", "avg10"));
+  EXPECT_EQ(4, PressureStallMonitor::parseStallPercent(PressureContents, "some", "avg60"));
+  EXPECT_EQ(0.5, PressureStallMonitor::parseStallPercent(PressureContents, "full", "avg60"));
+  EXPECT_EQ(0, PressureStallMonitor::parseStallPercent(PressureContents, "full", "avg300"));
+}
+
+TEST(PressureStallParseTest, MissingAverage) {
+  // The system wide CPU pressure has no full line on older kernels.
+  EXPECT_THROW_WITH_MESSAGE(
+      PressureStallMonitor::parseStallPercent("some avg10=0.00 avg60=0.00 avg300=0.00 total=0\n",
+                                              "full", "avg10"),
+      EnvoyException, "failed to parse full avg10 pressure stall");
+  EXPECT_THROW(PressureStallMonitor::parseStallPercent("some avg10=abc\n", "some", "avg10"),
+               EnvoyException);
+  EXPECT_THROW(PressureStallMonitor::parseStallPercent("", "some", "avg10"), EnvoyException);
+}
+
+TEST_F(PressureStallMonitorTest, ReadsCgroupPressure) {
+  TestEnvironment::writeStringToFileForTest("memory.pressure", PressureContents);
+  PressureStallConfig config;
+  config.set_resource(PressureStallConfig::MEMORY);
+  config.set_stall(PressureStallConfig::SOME);
+  config.set_window(PressureStallConfig::AVG10);
+  config.set_cgroup_path(TestEnvironment::temporaryDirectory());
+  config.set_max_stall_percent(25);
+  auto monitor = createMonitor(config);
+
+  ResourcePressure resource;
+  monitor->updateResourceUsage(resource);
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_DOUBLE_EQ(0.5, resource.pressure());
+
+  TestEnvironment::writeStringToFileForTest(
+      "memory.pressure", "some avg10=30.00 avg60=4.00 avg300=1.25 total=2178234\n");
+  monitor->updateResourceUsage(resource);
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_DOUBLE_EQ(1.2, resource.pressure());
+}
+
+TEST_F(PressureStallMonitorTest, ReportsFailures) {
+  PressureStallConfig config;
+  config.set_resource(PressureStallConfig::IO);
+  config.set_cgroup_path(TestEnvironment::temporaryPath("missing_cgroup"));
+  config.set_max_stall_percent(100);
+  auto monitor = createMonitor(config);
+
+  ResourcePressure resource;
+  monitor->updateResourceUsage(resource);
+  EXPECT_TRUE(resource.hasError());
+
+  TestEnvironment::createPath(TestEnvironment::temporaryPath("missing_cgroup"));
+  TestEnvironment::writeStringToFileForTest("missing_cgroup/io.pressure", "invalid");
+  monitor->updateResourceUsage(resource);
+  EXPECT_TRUE(resource.hasError());
+}
+
+} // namespace
+} // namespace PressureStallMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
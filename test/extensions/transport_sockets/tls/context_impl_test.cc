@@ -437,6 +437,34 @@ TEST_F(SslContextImplTest, AtMostOneEcdsaCert) {
                           "at most one certificate of a given type may be specified");
 }
 
+// Any number of certificates of a given type may be selected by SNI.
+TEST_F(SslContextImplTest, SniCertificateSelectionMultipleRsaCerts) {
+  envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext tls_context;
+  const std::string tls_context_yaml = R"EOF(
+  common_tls_context:
+    tls_certificates:
+    - certificate_chain:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/selfsigned_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/selfsigned_key.pem"
+    - certificate_chain:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/san_dns_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/san_dns_key.pem"
+  sni_certificate_selection:
+    max_loaded_certificates: 1
+  )EOF";
+  TestUtility::loadFromYaml(TestEnvironment::substitute(tls_context_yaml), tls_context);
+  ServerContextConfigImpl server_context_config(tls_context, factory_context_);
+  EXPECT_EQ(1, server_context_config.maxLoadedSniCertificates());
+  Envoy::Ssl::ServerContextSharedPtr context =
+      manager_.createSslServerContext(store_, server_context_config, {});
+  EXPECT_EQ(2, context->getCertChainInformation().size());
+  // Nothing is loaded until a handshake selects a certificate.
+  EXPECT_EQ(0, store_.gauge("ssl.sni_certificates.loaded", Stats::Gauge::ImportMode::NeverImport)
+                   .value());
+}
+
 // Certificates with no subject CN and no SANs are rejected.
 TEST_F(SslContextImplTest, MustHaveSubjectOrSAN) {
   envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext tls_context;
@@ -0,0 +1,248 @@
+#include <string>
+#include <vector>
+
+#include "extensions/transport_sockets/tls/session_resumption_impl.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+#include "openssl/hmac.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+bssl::UniquePtr<SSL_SESSION> makeSession(SSL_CTX* ctx, const std::string& id) {
+  bssl::UniquePtr<SSL_SESSION> session(SSL_SESSION_new(ctx));
+  EXPECT_TRUE(SSL_SESSION_set1_id(session.get(), reinterpret_cast<const uint8_t*>(id.data()),
+                                  id.size()));
+  return session;
+}
+
+bssl::UniquePtr<SSL_CTX> makeServerContext() {
+  bssl::UniquePtr<SSL_CTX> ctx(SSL_CTX_new(TLS_method()));
+  EXPECT_TRUE(SSL_CTX_use_certificate_chain_file(
+      ctx.get(), TestEnvironment::substitute("{{ test_rundir }}/test/extensions/transport_sockets/"
+                                             "tls/test_data/selfsigned_cert.pem")
+                     .c_str()));
+  EXPECT_TRUE(SSL_CTX_use_PrivateKey_file(
+      ctx.get(),
+      TestEnvironment::substitute(
+          "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/selfsigned_key.pem")
+          .c_str(),
+      SSL_FILETYPE_PEM));
+  // Session ID based resumption only exists up to TLS 1.2.
+  EXPECT_TRUE(SSL_CTX_set_max_proto_version(ctx.get(), TLS1_2_VERSION));
+  SSL_CTX_set_options(ctx.get(), SSL_OP_NO_TICKET);
+  return ctx;
+}
+
+// Run a handshake between a new client and server over a BIO pair. Returns the client, so that
+// its session can be resumed and the resumption checked.
+bssl::UniquePtr<SSL> handshake(SSL_CTX* client_ctx, SSL_CTX* server_ctx,
+                               SSL_SESSION* session = nullptr) {
+  bssl::UniquePtr<SSL> client(SSL_new(client_ctx));
+  bssl::UniquePtr<SSL> server(SSL_new(server_ctx));
+  BIO* client_bio = nullptr;
+  BIO* server_bio = nullptr;
+  EXPECT_TRUE(BIO_new_bio_pair(&client_bio, 0, &server_bio, 0));
+  SSL_set_bio(client.get(), client_bio, client_bio);
+  SSL_set_bio(server.get(), server_bio, server_bio);
+  SSL_set_connect_state(client.get());
+  SSL_set_accept_state(server.get());
+  if (session != nullptr) {
+    SSL_set_session(client.get(), session);
+  }
+
+  bool client_done = false;
+  bool server_done = false;
+  for (int i = 0; i < 10 && !(client_done && server_done); ++i) {
+    client_done = client_done || SSL_do_handshake(client.get()) == 1;
+    server_done = server_done || SSL_do_handshake(server.get()) == 1;
+  }
+  EXPECT_TRUE(client_done && server_done);
+  return client;
+}
+
+TEST(SharedSessionCacheTest, EvictsLeastRecentlyUsed) {
+  bssl::UniquePtr<SSL_CTX> ctx(SSL_CTX_new(TLS_method()));
+  SharedSessionCache cache;
+  // One session per shard.
+  cache.ensureCapacity(16);
+
+  // Find two session IDs hashing to the same shard by inserting until one is evicted.
+  bssl::UniquePtr<SSL_SESSION> first = makeSession(ctx.get(), "session0");
+  cache.insert(first.get());
+  int i = 1;
+  for (; cache.lookup("session0") != nullptr; ++i) {
+    bssl::UniquePtr<SSL_SESSION> session = makeSession(ctx.get(), absl::StrCat("session", i));
+    cache.insert(session.get());
+  }
+  EXPECT_NE(nullptr, cache.lookup(absl::StrCat("session", i - 1)));
+  EXPECT_LE(cache.size(), 16);
+}
+
+TEST(SharedSessionCacheTest, CapacityIsNeverLowered) {
+  SharedSessionCache cache;
+  EXPECT_EQ(0, cache.capacity());
+  cache.ensureCapacity(100);
+  cache.ensureCapacity(10);
+  EXPECT_EQ(100, cache.capacity());
+}
+
+TEST(SharedSessionCacheTest, NoCapacity) {
+  bssl::UniquePtr<SSL_CTX> ctx(SSL_CTX_new(TLS_method()));
+  SharedSessionCache cache;
+  bssl::UniquePtr<SSL_SESSION> session = makeSession(ctx.get(), "session");
+  cache.insert(session.get());
+  EXPECT_EQ(0, cache.size());
+}
+
+TEST(SharedSessionCacheTest, RemoveOnlyMatchingSession) {
+  bssl::UniquePtr<SSL_CTX> ctx(SSL_CTX_new(TLS_method()));
+  SharedSessionCache cache;
+  cache.ensureCapacity(100);
+  bssl::UniquePtr<SSL_SESSION> old_session = makeSession(ctx.get(), "session");
+  bssl::UniquePtr<SSL_SESSION> new_session = makeSession(ctx.get(), "session");
+  cache.insert(old_session.get());
+  cache.insert(new_session.get());
+  EXPECT_EQ(1, cache.size());
+
+  cache.remove(old_session.get());
+  EXPECT_EQ(new_session.get(), cache.lookup("session").get());
+  cache.remove(new_session.get());
+  EXPECT_EQ(nullptr, cache.lookup("session"));
+}
+
+// Sessions stored by one context are resumed by another context sharing the cache, and by a
+// context of a new process the cache was handed over to.
+TEST(SharedSessionCacheTest, ResumeAcrossContextsAndHandover) {
+  bssl::UniquePtr<SSL_CTX> client_ctx(SSL_CTX_new(TLS_method()));
+  SSL_CTX_set_session_cache_mode(client_ctx.get(), SSL_SESS_CACHE_CLIENT);
+
+  SharedSessionCache cache;
+  cache.ensureCapacity(100);
+  bssl::UniquePtr<SSL_CTX> server_ctx1 = makeServerContext();
+  bssl::UniquePtr<SSL_CTX> server_ctx2 = makeServerContext();
+  cache.configureContext(server_ctx1.get());
+  cache.configureContext(server_ctx2.get());
+
+  bssl::UniquePtr<SSL> client = handshake(client_ctx.get(), server_ctx1.get());
+  EXPECT_FALSE(SSL_session_reused(client.get()));
+  EXPECT_EQ(1, cache.size());
+  bssl::UniquePtr<SSL_SESSION> session(SSL_get1_session(client.get()));
+
+  client = handshake(client_ctx.get(), server_ctx2.get(), session.get());
+  EXPECT_TRUE(SSL_session_reused(client.get()));
+
+  SharedSessionCache new_cache;
+  new_cache.importSessions(cache.exportSessions());
+  EXPECT_EQ(1, new_cache.size());
+  bssl::UniquePtr<SSL_CTX> server_ctx3 = makeServerContext();
+  new_cache.configureContext(server_ctx3.get());
+  client = handshake(client_ctx.get(), server_ctx3.get(), session.get());
+  EXPECT_TRUE(SSL_session_reused(client.get()));
+}
+
+TEST(SharedSessionCacheTest, ImportSkipsInvalidSessions) {
+  SharedSessionCache cache;
+  cache.importSessions({"not a session"});
+  EXPECT_EQ(0, cache.size());
+}
+
+class SessionTicketKeyRotatorTest : public testing::Test {
+protected:
+  std::string encrypt() {
+    uint8_t key_name[SSL_TICKET_KEY_NAME_LEN];
+    uint8_t iv[EVP_MAX_IV_LENGTH];
+    EXPECT_EQ(1, rotator_.processTicket(key_name, iv, cipher_ctx_.get(), hmac_ctx_.get(), 1));
+    return {reinterpret_cast<const char*>(key_name), sizeof(key_name)};
+  }
+
+  int decrypt(SessionTicketKeyRotator& rotator, std::string key_name) {
+    uint8_t iv[EVP_MAX_IV_LENGTH] = {};
+    bssl::ScopedEVP_CIPHER_CTX cipher_ctx;
+    bssl::ScopedHMAC_CTX hmac_ctx;
+    return rotator.processTicket(reinterpret_cast<uint8_t*>(&key_name[0]), iv, cipher_ctx.get(),
+                                 hmac_ctx.get(), 0);
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  SessionTicketKeyRotator rotator_{time_system_};
+  bssl::ScopedEVP_CIPHER_CTX cipher_ctx_;
+  bssl::ScopedHMAC_CTX hmac_ctx_;
+};
+
+TEST_F(SessionTicketKeyRotatorTest, NoRotationWithoutInterval) {
+  const std::string key_name = encrypt();
+  time_system_.advanceTimeWait(std::chrono::hours(24 * 365));
+  EXPECT_EQ(key_name, encrypt());
+}
+
+TEST_F(SessionTicketKeyRotatorTest, RotateKeys) {
+  rotator_.ensureInterval(std::chrono::seconds(60));
+  rotator_.ensureInterval(std::chrono::seconds(3600));
+
+  const std::string key_name1 = encrypt();
+  EXPECT_EQ(1, decrypt(rotator_, key_name1));
+  time_system_.advanceTimeWait(std::chrono::seconds(59));
+  EXPECT_EQ(key_name1, encrypt());
+
+  // The smallest interval is used.
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  const std::string key_name2 = encrypt();
+  EXPECT_NE(key_name1, key_name2);
+  // Tickets encrypted with a previous key are still accepted, and renewed.
+  EXPECT_EQ(2, decrypt(rotator_, key_name1));
+  EXPECT_EQ(1, decrypt(rotator_, key_name2));
+
+  time_system_.advanceTimeWait(std::chrono::seconds(60));
+  encrypt();
+  EXPECT_EQ(2, decrypt(rotator_, key_name1));
+  time_system_.advanceTimeWait(std::chrono::seconds(60));
+  encrypt();
+  // Only the last three keys are kept.
+  EXPECT_EQ(0, decrypt(rotator_, key_name1));
+  EXPECT_EQ(2, decrypt(rotator_, key_name2));
+}
+
+TEST_F(SessionTicketKeyRotatorTest, Handover) {
+  rotator_.ensureInterval(std::chrono::seconds(60));
+  const std::string key_name1 = encrypt();
+  time_system_.advanceTimeWait(std::chrono::seconds(60));
+  const std::string key_name2 = encrypt();
+
+  Ssl::SessionResumptionState state;
+  rotator_.exportKeys(state);
+  EXPECT_EQ(2, state.ticket_keys_.size());
+
+  SessionTicketKeyRotator new_rotator(time_system_);
+  new_rotator.ensureInterval(std::chrono::seconds(60));
+  new_rotator.importKeys(state);
+  EXPECT_EQ(1, decrypt(new_rotator, key_name2));
+  EXPECT_EQ(2, decrypt(new_rotator, key_name1));
+
+  // The key creation time is handed over too, so the new process rotates on the same schedule.
+  time_system_.advanceTimeWait(std::chrono::seconds(60));
+  EXPECT_EQ(2, decrypt(new_rotator, key_name2));
+}
+
+TEST_F(SessionTicketKeyRotatorTest, ImportSkipsInvalidKeys) {
+  const std::string key_name = encrypt();
+  Ssl::SessionResumptionState state;
+  state.ticket_keys_ = {"too short"};
+  rotator_.importKeys(state);
+  EXPECT_EQ(1, decrypt(rotator_, key_name));
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,112 @@
+// Benchmarks certificate selection by SNI for server contexts with many certificates, against a
+// scan of the certificate names as done when matching filter chains or certificates one by one.
+
+#include <string>
+#include <vector>
+
+#include "common/stats/isolated_store_impl.h"
+
+#include "extensions/transport_sockets/tls/context_impl.h"
+#include "extensions/transport_sockets/tls/sni_certificate_index.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+namespace {
+
+// Every other certificate is a wildcard certificate.
+std::vector<std::vector<std::string>> certificateNames(size_t count) {
+  std::vector<std::vector<std::string>> names;
+  names.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    if (i % 2 == 0) {
+      names.push_back({absl::StrCat("customer", i, ".example.com"),
+                       absl::StrCat("www.customer", i, ".example.com")});
+    } else {
+      names.push_back({absl::StrCat("*.customer", i, ".example.net")});
+    }
+  }
+  return names;
+}
+
+// Server names for the last certificates, which are the worst case for a scan.
+std::vector<std::string> serverNames(size_t count) {
+  return {absl::StrCat("www.customer", count - 2, ".example.com"),
+          absl::StrCat("api.customer", count - 1, ".example.net")};
+}
+
+} // namespace
+
+static void BM_SniCertificateIndexBuild(benchmark::State& state) {
+  const std::vector<std::vector<std::string>> names = certificateNames(state.range(0));
+  for (auto _ : state) {
+    SniCertificateIndex index;
+    for (const auto& certificate_names : names) {
+      index.add(certificate_names, false);
+    }
+    benchmark::DoNotOptimize(index.size());
+  }
+}
+BENCHMARK(BM_SniCertificateIndexBuild)->Arg(100)->Arg(1000)->Arg(8000)->Unit(benchmark::kMillisecond);
+
+static void BM_SniCertificateIndexFind(benchmark::State& state) {
+  SniCertificateIndex index;
+  for (const auto& certificate_names : certificateNames(state.range(0))) {
+    index.add(certificate_names, false);
+  }
+  const std::vector<std::string> server_names = serverNames(state.range(0));
+  for (auto _ : state) {
+    for (const std::string& server_name : server_names) {
+      benchmark::DoNotOptimize(index.find(server_name, false));
+    }
+  }
+}
+BENCHMARK(BM_SniCertificateIndexFind)->Arg(100)->Arg(1000)->Arg(8000);
+
+static void BM_CertificateNameScan(benchmark::State& state) {
+  const std::vector<std::vector<std::string>> names = certificateNames(state.range(0));
+  const std::vector<std::string> server_names = serverNames(state.range(0));
+  for (auto _ : state) {
+    for (const std::string& server_name : server_names) {
+      absl::optional<size_t> selected;
+      for (size_t i = 0; i < names.size() && !selected.has_value(); ++i) {
+        for (const std::string& name : names[i]) {
+          if (ContextImpl::dnsNameMatch(server_name, name.c_str())) {
+            selected = i;
+            break;
+          }
+        }
+      }
+      benchmark::DoNotOptimize(selected);
+    }
+  }
+}
+BENCHMARK(BM_CertificateNameScan)->Arg(100)->Arg(1000)->Arg(8000);
+
+// Handshakes for certificates that are already loaded only pay for a cache lookup.
+static void BM_LoadedCertificateCacheHit(benchmark::State& state) {
+  Stats::IsolatedStoreImpl store;
+  SniCertificateStats stats{ALL_SNI_CERTIFICATE_STATS(POOL_COUNTER_PREFIX(store, "sni."),
+                                                      POOL_GAUGE_PREFIX(store, "sni."))};
+  LoadedCertificateCache cache(
+      state.range(0), [](size_t) { return std::make_shared<LoadedCertificate>(); }, stats);
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    cache.get(i);
+  }
+  size_t next = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cache.get(next));
+    next = (next + 1) % state.range(0);
+  }
+}
+BENCHMARK(BM_LoadedCertificateCacheHit)->Arg(1024);
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
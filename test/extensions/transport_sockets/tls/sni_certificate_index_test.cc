@@ -0,0 +1,135 @@
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "common/stats/isolated_store_impl.h"
+
+#include "extensions/transport_sockets/tls/sni_certificate_index.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+TEST(SniCertificateIndexTest, ExactAndWildcardNames) {
+  SniCertificateIndex index;
+  EXPECT_EQ(0, index.add({"example.com", "www.example.com"}, false));
+  EXPECT_EQ(1, index.add({"*.example.com"}, false));
+  EXPECT_EQ(2, index.add({"api.example.com"}, false));
+  EXPECT_EQ(3, index.size());
+
+  EXPECT_EQ(0, index.find("example.com", false));
+  EXPECT_EQ(0, index.find("www.example.com", false));
+  // Exact names are preferred over wildcards.
+  EXPECT_EQ(2, index.find("api.example.com", false));
+  EXPECT_EQ(1, index.find("foo.example.com", false));
+  // A wildcard only matches a single label.
+  EXPECT_EQ(absl::nullopt, index.find("foo.bar.example.com", false));
+  EXPECT_EQ(absl::nullopt, index.find(".example.com", false));
+  EXPECT_EQ(absl::nullopt, index.find("example.org", false));
+  EXPECT_EQ(absl::nullopt, index.find("", false));
+}
+
+TEST(SniCertificateIndexTest, CaseInsensitive) {
+  SniCertificateIndex index;
+  index.add({"Example.COM"}, false);
+  index.add({"*.Example.ORG"}, false);
+  EXPECT_EQ(0, index.find("example.com", false));
+  EXPECT_EQ(0, index.find("EXAMPLE.com", false));
+  EXPECT_EQ(1, index.find("WWW.example.org", false));
+}
+
+TEST(SniCertificateIndexTest, PreferKeyTypeSupportedByClient) {
+  SniCertificateIndex index;
+  index.add({"example.com"}, false);
+  index.add({"example.com"}, true);
+  index.add({"rsa-only.com"}, false);
+  index.add({"ecdsa-only.com"}, true);
+
+  EXPECT_EQ(0, index.find("example.com", false));
+  EXPECT_EQ(1, index.find("example.com", true));
+  // Fall back on the first certificate for the name.
+  EXPECT_EQ(2, index.find("rsa-only.com", true));
+  EXPECT_EQ(3, index.find("ecdsa-only.com", false));
+}
+
+TEST(SniCertificateIndexTest, DuplicateNames) {
+  SniCertificateIndex index;
+  index.add({"example.com", "EXAMPLE.com"}, false);
+  index.add({"example.com"}, true);
+  EXPECT_EQ(1, index.find("example.com", true));
+}
+
+class LoadedCertificateCacheTest : public testing::Test {
+protected:
+  LoadedCertificateCacheTest()
+      : stats_{ALL_SNI_CERTIFICATE_STATS(POOL_COUNTER_PREFIX(store_, "sni."),
+                                         POOL_GAUGE_PREFIX(store_, "sni."))} {}
+
+  std::unique_ptr<LoadedCertificateCache> createCache(uint32_t capacity) {
+    return std::make_unique<LoadedCertificateCache>(
+        capacity,
+        [this](size_t index) -> LoadedCertificateConstSharedPtr {
+          loads_.push_back(index);
+          if (index == failing_index_) {
+            return nullptr;
+          }
+          return std::make_shared<LoadedCertificate>();
+        },
+        stats_);
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  SniCertificateStats stats_;
+  std::vector<size_t> loads_;
+  size_t failing_index_{std::numeric_limits<size_t>::max()};
+};
+
+TEST_F(LoadedCertificateCacheTest, LoadOnce) {
+  auto cache = createCache(10);
+  LoadedCertificateConstSharedPtr certificate = cache->get(3);
+  ASSERT_NE(nullptr, certificate);
+  EXPECT_EQ(certificate, cache->get(3));
+  EXPECT_EQ(std::vector<size_t>{3}, loads_);
+  EXPECT_EQ(1, stats_.load_.value());
+  EXPECT_EQ(1, stats_.loaded_.value());
+}
+
+TEST_F(LoadedCertificateCacheTest, EvictLeastRecentlyUsed) {
+  auto cache = createCache(2);
+  cache->get(0);
+  cache->get(1);
+  // Use 0 again, so that 1 is evicted next.
+  cache->get(0);
+  cache->get(2);
+  EXPECT_EQ(2, cache->size());
+  EXPECT_EQ(1, stats_.eviction_.value());
+  EXPECT_EQ(2, stats_.loaded_.value());
+
+  cache->get(0);
+  EXPECT_EQ((std::vector<size_t>{0, 1, 2}), loads_);
+  cache->get(1);
+  EXPECT_EQ((std::vector<size_t>{0, 1, 2, 1}), loads_);
+
+  cache.reset();
+  EXPECT_EQ(0, stats_.loaded_.value());
+}
+
+TEST_F(LoadedCertificateCacheTest, LoadErrorIsNotCached) {
+  failing_index_ = 1;
+  auto cache = createCache(2);
+  EXPECT_EQ(nullptr, cache->get(1));
+  EXPECT_EQ(nullptr, cache->get(1));
+  EXPECT_EQ((std::vector<size_t>{1, 1}), loads_);
+  EXPECT_EQ(2, stats_.load_error_.value());
+  EXPECT_EQ(0, cache->size());
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
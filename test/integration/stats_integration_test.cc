@@ -147,7 +147,8 @@ public:
       : BaseIntegrationTest(testing::TestWithParam<Network::Address::IpVersion>::GetParam()) {}
 
   static size_t computeMemoryDelta(int initial_num_clusters, int initial_num_hosts,
-                                   int final_num_clusters, int final_num_hosts, bool allow_stats) {
+                                   int final_num_clusters, int final_num_hosts, bool allow_stats,
+                                   bool lazy_cluster_stats) {
     // Use the same number of fake upstreams for both helpers in order to exclude memory overhead
     // added by the fake upstreams.
     int fake_upstreams_count = 1 + final_num_clusters * final_num_hosts;
@@ -158,12 +159,14 @@ public:
       helper.setUpstreamCount(fake_upstreams_count);
       helper.skipPortUsageValidation();
       initial_memory =
-          helper.clusterMemoryHelper(initial_num_clusters, initial_num_hosts, allow_stats);
+          helper.clusterMemoryHelper(initial_num_clusters, initial_num_hosts, allow_stats,
+                                     lazy_cluster_stats);
     }
 
     ClusterMemoryTestHelper helper;
     helper.setUpstreamCount(fake_upstreams_count);
-    return helper.clusterMemoryHelper(final_num_clusters, final_num_hosts, allow_stats) -
+    return helper.clusterMemoryHelper(final_num_clusters, final_num_hosts, allow_stats,
+                                      lazy_cluster_stats) -
            initial_memory;
   }
 
@@ -171,14 +174,17 @@ private:
   /**
    * @param num_clusters number of clusters appended to bootstrap_config
    * @param allow_stats if false, enable set_reject_all in stats_config
+   * @param lazy_cluster_stats if true, enable lazy_cluster_stats in cluster_manager
    * @return size_t the total memory allocated
    */
-  size_t clusterMemoryHelper(int num_clusters, int num_hosts, bool allow_stats) {
+  size_t clusterMemoryHelper(int num_clusters, int num_hosts, bool allow_stats,
+                             bool lazy_cluster_stats) {
     Stats::TestUtil::MemoryTest memory_test;
     config_helper_.addConfigModifier([&](envoy::config::bootstrap::v3::Bootstrap& bootstrap) {
       if (!allow_stats) {
         bootstrap.mutable_stats_config()->mutable_stats_matcher()->set_reject_all(true);
       }
+      bootstrap.mutable_cluster_manager()->set_lazy_cluster_stats(lazy_cluster_stats);
       for (int i = 1; i < num_clusters; ++i) {
         auto* cluster = bootstrap.mutable_static_resources()->add_clusters();
         cluster->set_name(absl::StrCat("cluster_", i));
@@ -219,7 +225,7 @@ TEST_P(ClusterMemoryTestRunner, MemoryLargeClusterSizeWithFakeSymbolTable) {
   // A unique instance of ClusterMemoryTest allows for multiple runs of Envoy with
   // differing configuration. This is necessary for measuring the memory consumption
   // between the different instances within the same test.
-  const size_t m100 = ClusterMemoryTestHelper::computeMemoryDelta(1, 0, 101, 0, true);
+  const size_t m100 = ClusterMemoryTestHelper::computeMemoryDelta(1, 0, 101, 0, true, false);
   const size_t m_per_cluster = (m100) / 100;
 
   // Note: if you are increasing this golden value because you are adding a
@@ -275,6 +281,8 @@ TEST_P(ClusterMemoryTestRunner, MemoryLargeClusterSizeWithFakeSymbolTable) {
   // 2020/05/05  10908    44233       44600   router: add InternalRedirectPolicy and predicate
   // 2020/05/13  10531    44425       44600   Refactor resource manager
   // 2020/05/20  11223    44491       44600   Add primary clusters tracking to cluster manager.
+  // 2026/10/18  8e2ff4b  43403       44600   upstream: split endpoint stats, allocate cluster
+  //                                          stats and load report stats separately.
 
   // Note: when adjusting this value: EXPECT_MEMORY_EQ is active only in CI
   // 'release' builds, where we control the platform and tool-chain. So you
@@ -288,7 +296,7 @@ TEST_P(ClusterMemoryTestRunner, MemoryLargeClusterSizeWithFakeSymbolTable) {
   // If you encounter a failure here, please see
   // https://github.com/envoyproxy/envoy/blob/master/source/docs/stats.md#stats-memory-tests
   // for details on how to fix.
-  EXPECT_MEMORY_EQ(m_per_cluster, 44491);
+  EXPECT_MEMORY_EQ(m_per_cluster, 43403);
   EXPECT_MEMORY_LE(m_per_cluster, 44600);
 }
 
@@ -298,7 +306,7 @@ TEST_P(ClusterMemoryTestRunner, MemoryLargeClusterSizeWithRealSymbolTable) {
   // A unique instance of ClusterMemoryTest allows for multiple runs of Envoy with
   // differing configuration. This is necessary for measuring the memory consumption
   // between the different instances within the same test.
-  const size_t m100 = ClusterMemoryTestHelper::computeMemoryDelta(1, 0, 101, 0, true);
+  const size_t m100 = ClusterMemoryTestHelper::computeMemoryDelta(1, 0, 101, 0, true, false);
   const size_t m_per_cluster = (m100) / 100;
 
   // Note: if you are increasing this golden value because you are adding a
@@ -337,6 +345,8 @@ TEST_P(ClusterMemoryTestRunner, MemoryLargeClusterSizeWithRealSymbolTable) {
   // 2020/05/05  10908    36345       36800   router: add InternalRedirectPolicy and predicate
   // 2020/05/13  10531    36537       36800   Refactor resource manager
   // 2020/05/20  11223    36603       36800   Add primary clusters tracking to cluster manager.
+  // 2026/10/18  8e2ff4b  35555       36800   upstream: split endpoint stats, allocate cluster
+  //                                          stats and load report stats separately.
 
   // Note: when adjusting this value: EXPECT_MEMORY_EQ is active only in CI
   // 'release' builds, where we control the platform and tool-chain. So you
@@ -350,17 +360,49 @@ TEST_P(ClusterMemoryTestRunner, MemoryLargeClusterSizeWithRealSymbolTable) {
   // If you encounter a failure here, please see
   // https://github.com/envoyproxy/envoy/blob/master/source/docs/stats.md#stats-memory-tests
   // for details on how to fix.
-  EXPECT_MEMORY_EQ(m_per_cluster, 36603);
+  EXPECT_MEMORY_EQ(m_per_cluster, 35555);
   EXPECT_MEMORY_LE(m_per_cluster, 36800);
 }
 
+TEST_P(ClusterMemoryTestRunner, MemoryLargeClusterSizeWithLazyClusterStats) {
+  symbol_table_creator_test_peer_.setUseFakeSymbolTables(false);
+
+  // The same clusters as in MemoryLargeClusterSizeWithRealSymbolTable, none of which is used, so
+  // that their stats and circuit breakers are never created.
+  const size_t m100 = ClusterMemoryTestHelper::computeMemoryDelta(1, 0, 101, 0, true, true);
+  const size_t m_per_cluster = (m100) / 100;
+  const size_t m100_eager = ClusterMemoryTestHelper::computeMemoryDelta(1, 0, 101, 0, true, false);
+  const size_t m_per_cluster_eager = (m100_eager) / 100;
+
+  // Unused clusters must never cost more with lazy stats than without.
+  //
+  // The upper bound is derived from the eager value of MemoryLargeClusterSizeWithRealSymbolTable,
+  // 35555 bytes, less what lazy clusters never create:
+  // - the 68 ClusterStats and the 10 circuit breaker gauges of each of the two priorities. At
+  //   about 182 bytes per stat, as measured when host stats moved to primitive counters (1456
+  //   bytes for 8 stats, see MemoryLargeHostSizeWithStats), that is about 16000 bytes.
+  // - the ClusterStats struct (576 bytes) and the two ResourceManagerImpl with their runtime keys
+  //   (about 1300 bytes).
+  // That leaves about 17650 bytes per cluster. The bound adds about 6350 bytes of headroom, less
+  // than the 12950 bytes of the ClusterStats alone, so that creating them eagerly again fails it.
+  //
+  // History of golden values:
+  //
+  // Date        PR       Bytes Per Cluster   Notes
+  //                      exact upper-bound
+  // ----------  -----    -----------------   -----
+  // 2026/10/18  8e2ff4b              24000   Initial version
+  EXPECT_MEMORY_LE(m_per_cluster, m_per_cluster_eager);
+  EXPECT_MEMORY_LE(m_per_cluster, 24000);
+}
+
 TEST_P(ClusterMemoryTestRunner, MemoryLargeHostSizeWithStats) {
   symbol_table_creator_test_peer_.setUseFakeSymbolTables(false);
 
   // A unique instance of ClusterMemoryTest allows for multiple runs of Envoy with
   // differing configuration. This is necessary for measuring the memory consumption
   // between the different instances within the same test.
-  const size_t m100 = ClusterMemoryTestHelper::computeMemoryDelta(1, 1, 1, 101, true);
+  const size_t m100 = ClusterMemoryTestHelper::computeMemoryDelta(1, 1, 1, 101, true, false);
   const size_t m_per_host = (m100) / 100;
 
   // Note: if you are increasing this golden value because you are adding a
@@ -41,6 +41,38 @@ public:
     }
   }
 
+  // The lookups of registered keys are forwarded to the lookups by name, so that expectations on
+  // names hold.
+  bool featureEnabled(const KeyHandle& key, uint64_t default_value) const override {
+    return featureEnabled(key.name(), default_value);
+  }
+  bool featureEnabled(const KeyHandle& key, uint64_t default_value,
+                      uint64_t random_value) const override {
+    return featureEnabled(key.name(), default_value, random_value);
+  }
+  bool featureEnabled(const KeyHandle& key, uint64_t default_value, uint64_t random_value,
+                      uint64_t num_buckets) const override {
+    return featureEnabled(key.name(), default_value, random_value, num_buckets);
+  }
+  bool featureEnabled(const KeyHandle& key,
+                      const envoy::type::v3::FractionalPercent& default_value) const override {
+    return featureEnabled(key.name(), default_value);
+  }
+  bool featureEnabled(const KeyHandle& key,
+                      const envoy::type::v3::FractionalPercent& default_value,
+                      uint64_t random_value) const override {
+    return featureEnabled(key.name(), default_value, random_value);
+  }
+  uint64_t getInteger(const KeyHandle& key, uint64_t default_value) const override {
+    return getInteger(key.name(), default_value);
+  }
+  double getDouble(const KeyHandle& key, double default_value) const override {
+    return getDouble(key.name(), default_value);
+  }
+  bool getBoolean(const KeyHandle& key, bool default_value) const override {
+    return getBoolean(key.name(), default_value);
+  }
+
   MOCK_METHOD(void, countDeprecatedFeatureUse, (), (const));
   MOCK_METHOD(bool, deprecatedFeatureEnabled, (absl::string_view key, bool default_enabled),
               (const));
@@ -232,6 +232,7 @@ public:
   MOCK_METHOD(void, sendParentAdminShutdownRequest, (time_t & original_start_time));
   MOCK_METHOD(void, sendParentTerminateRequest, ());
   MOCK_METHOD(ServerStatsFromParent, mergeParentStatsIfAny, (Stats::StoreRoot & stats_store));
+  MOCK_METHOD(absl::optional<Ssl::SessionResumptionState>, getParentSessionResumptionState, ());
   MOCK_METHOD(void, shutdown, ());
   MOCK_METHOD(std::string, version, ());
   MOCK_METHOD(Thread::BasicLockable&, logLock, ());
@@ -254,7 +255,8 @@ public:
   createDrainManager(envoy::config::listener::v3::Listener::DrainType drain_type) override {
     return DrainManagerPtr{createDrainManager_(drain_type)};
   }
-  LdsApiPtr createLdsApi(const envoy::config::core::v3::ConfigSource& lds_config) override {
+  LdsApiPtr createLdsApi(const envoy::config::core::v3::ConfigSource& lds_config,
+                         uint32_t) override {
     return LdsApiPtr{createLdsApi_(lds_config)};
   }
 
@@ -288,7 +290,8 @@ public:
   MOCK_METHOD(bool, addOrUpdateListener,
               (const envoy::config::listener::v3::Listener& config, const std::string& version_info,
                bool modifiable));
-  MOCK_METHOD(void, createLdsApi, (const envoy::config::core::v3::ConfigSource& lds_config));
+  MOCK_METHOD(void, createLdsApi,
+              (const envoy::config::core::v3::ConfigSource& lds_config, uint32_t decode_threads));
   MOCK_METHOD(std::vector<std::reference_wrapper<Network::ListenerConfig>>, listeners, ());
   MOCK_METHOD(uint64_t, numConnections, (), (const));
   MOCK_METHOD(bool, removeListener, (const std::string& listener_name));
@@ -31,6 +31,8 @@ public:
   MOCK_METHOD(size_t, daysUntilFirstCertExpires, (), (const));
   MOCK_METHOD(void, iterateContexts, (std::function<void(const Context&)> callback));
   MOCK_METHOD(Ssl::PrivateKeyMethodManager&, privateKeyMethodManager, ());
+  MOCK_METHOD(SessionResumptionState, exportSessionResumptionState, (), (const));
+  MOCK_METHOD(void, importSessionResumptionState, (const SessionResumptionState& state));
 };
 
 class MockConnectionInfo : public ConnectionInfo {
@@ -112,6 +114,10 @@ public:
   MOCK_METHOD(bool, requireClientCertificate, (), (const));
   MOCK_METHOD(const std::vector<SessionTicketKey>&, sessionTicketKeys, (), (const));
   MOCK_METHOD(bool, disableStatelessSessionResumption, (), (const));
+  MOCK_METHOD(absl::optional<std::chrono::seconds>, sessionTicketKeysRotationInterval, (),
+              (const));
+  MOCK_METHOD(uint32_t, sharedSessionCacheSize, (), (const));
+  MOCK_METHOD(absl::optional<uint32_t>, maxLoadedSniCertificates, (), (const));
 };
 
 class MockPrivateKeyMethodManager : public PrivateKeyMethodManager {
@@ -40,6 +40,7 @@ MockClusterInfo::MockClusterInfo()
     : http2_options_(::Envoy::Http2::Utility::initializeAndValidateOptions(
           envoy::config::core::v3::Http2ProtocolOptions())),
       stats_(ClusterInfoImpl::generateStats(stats_store_)),
+      endpoint_stats_(ClusterInfoImpl::generateEndpointStats(stats_store_)),
       transport_socket_matcher_(new NiceMock<Upstream::MockTransportSocketMatcher>()),
       load_report_stats_(ClusterInfoImpl::generateLoadReportStats(load_report_stats_store_)),
       timeout_budget_stats_(absl::make_optional<ClusterTimeoutBudgetStats>(
@@ -63,6 +64,7 @@ MockClusterInfo::MockClusterInfo()
   ON_CALL(*this, maxRequestsPerConnection())
       .WillByDefault(ReturnPointee(&max_requests_per_connection_));
   ON_CALL(*this, stats()).WillByDefault(ReturnRef(stats_));
+  ON_CALL(*this, endpointStats()).WillByDefault(ReturnRef(endpoint_stats_));
   ON_CALL(*this, statsScope()).WillByDefault(ReturnRef(stats_store_));
   // TODO(incfly): The following is a hack because it's not possible to directly embed
   // a mock transport socket factory matcher due to circular dependencies. Fix this up in a follow
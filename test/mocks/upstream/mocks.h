@@ -274,7 +274,8 @@ public:
                Outlier::EventLoggerSharedPtr outlier_event_logger, bool added_via_api));
 
   MOCK_METHOD(CdsApiPtr, createCds,
-              (const envoy::config::core::v3::ConfigSource& cds_config, ClusterManager& cm));
+              (const envoy::config::core::v3::ConfigSource& cds_config, ClusterManager& cm,
+               uint32_t decode_threads));
 
 private:
   NiceMock<Secret::MockSecretManager> secret_manager_;
@@ -286,6 +287,22 @@ public:
   ~MockClusterUpdateCallbacksHandle() override;
 };
 
+class MockClusterDiscoveryCallbackHandle : public ClusterDiscoveryCallbackHandle {
+public:
+  MockClusterDiscoveryCallbackHandle();
+  ~MockClusterDiscoveryCallbackHandle() override;
+};
+
+class MockOdCdsApiHandle : public OdCdsApiHandle {
+public:
+  MockOdCdsApiHandle();
+  ~MockOdCdsApiHandle() override;
+
+  MOCK_METHOD(ClusterDiscoveryCallbackHandlePtr, requestOnDemandClusterDiscovery,
+              (const std::string& name, ClusterDiscoveryCallbackPtr callback,
+               std::chrono::milliseconds timeout));
+};
+
 class MockClusterManager : public ClusterManager {
 public:
   explicit MockClusterManager(TimeSource& time_source);
@@ -328,6 +345,7 @@ public:
   MOCK_METHOD(bool, removeCluster, (const std::string& cluster));
   MOCK_METHOD(void, shutdown, ());
   MOCK_METHOD(const envoy::config::core::v3::BindConfig&, bindConfig, (), (const));
+  MOCK_METHOD(bool, lazyClusterStats, (), (const));
   MOCK_METHOD(Config::GrpcMuxSharedPtr, adsMux, ());
   MOCK_METHOD(Grpc::AsyncClientManager&, grpcAsyncClientManager, ());
   MOCK_METHOD(const std::string, versionInfo, (), (const));
@@ -335,6 +353,10 @@ public:
   MOCK_METHOD(ClusterUpdateCallbacksHandle*, addThreadLocalClusterUpdateCallbacks_,
               (ClusterUpdateCallbacks & callbacks));
   MOCK_METHOD(Config::SubscriptionFactory&, subscriptionFactory, ());
+  MOCK_METHOD(OdCdsApiHandlePtr, allocateOdCdsApi,
+              (const envoy::config::core::v3::ConfigSource& odcds_config,
+               std::chrono::milliseconds idle_timeout,
+               ProtobufMessage::ValidationVisitor& validation_visitor));
 
   NiceMock<Http::ConnectionPool::MockInstance> conn_pool_;
   NiceMock<Http::MockAsyncClient> async_client_;
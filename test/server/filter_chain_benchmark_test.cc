@@ -167,6 +167,11 @@ const char YamlSingleDstPortBottom[] = R"EOF(
           session_ticket_keys:
             keys:
             - filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/ticket_key_a")EOF";
+const char YamlSingleServerNameTop[] = R"EOF(
+    - filter_chain_match:
+        server_names: "server)EOF";
+const char YamlSingleServerNameBottom[] = R"EOF(.example.com"
+        transport_protocol: "tls")EOF";
 } // namespace
 
 class FilterChainBenchmarkFixture : public benchmark::Fixture {
@@ -236,6 +241,92 @@ BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainFindTest)
         {1, 4096},
     });
 
+// A listener with a filter chain per server name, as in multi-tenant deployments.
+class ServerNameFilterChainBenchmarkFixture : public benchmark::Fixture {
+public:
+  using benchmark::Fixture::SetUp;
+
+  void SetUp(::benchmark::State& state) override {
+    int64_t input_size = state.range(0);
+    std::vector<std::string> server_name_chains;
+    server_name_chains.reserve(input_size);
+    for (int i = 0; i < input_size; i++) {
+      server_name_chains.push_back(absl::StrCat(YamlSingleServerNameTop, i,
+                                                YamlSingleServerNameBottom,
+                                                YamlSingleDstPortBottom));
+    }
+    TestUtility::loadFromYaml(
+        TestEnvironment::substitute(absl::StrCat(YamlHeader, absl::StrJoin(server_name_chains, "")),
+                                    Network::Address::IpVersion::v4),
+        listener_config_);
+    filter_chains_ = listener_config_.filter_chains();
+
+    // The same listener, with one filter chain changed.
+    updated_listener_config_ = listener_config_;
+    updated_listener_config_.mutable_filter_chains(1)->set_name("updated");
+    updated_filter_chains_ = updated_listener_config_.filter_chains();
+  }
+
+  envoy::config::listener::v3::Listener listener_config_;
+  envoy::config::listener::v3::Listener updated_listener_config_;
+  absl::Span<const envoy::config::listener::v3::FilterChain* const> filter_chains_;
+  absl::Span<const envoy::config::listener::v3::FilterChain* const> updated_filter_chains_;
+  MockFilterChainFactoryBuilder dummy_builder_;
+  Init::ManagerImpl init_manager_{"fcm_benchmark"};
+};
+
+// NOLINTNEXTLINE(readability-redundant-member-init)
+BENCHMARK_DEFINE_F(ServerNameFilterChainBenchmarkFixture, FilterChainFindByServerNameTest)
+(::benchmark::State& state) {
+  std::vector<MockConnectionSocket> sockets;
+  sockets.reserve(state.range(0));
+  for (int i = 0; i < state.range(0); i++) {
+    sockets.push_back(std::move(*MockConnectionSocket::createMockConnectionSocket(
+        1234, "127.0.0.1", absl::StrCat("server", i, ".example.com"), "tls", {}, "8.8.8.8", 111)));
+  }
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  FilterChainManagerImpl filter_chain_manager{
+      std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234), factory_context,
+      init_manager_};
+
+  filter_chain_manager.addFilterChain(filter_chains_, dummy_builder_, filter_chain_manager);
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); i++) {
+      filter_chain_manager.findFilterChain(sockets[i]);
+    }
+  }
+}
+
+// The in place update of a listener where a single filter chain changed: only that filter chain is
+// built, and only that filter chain would be drained.
+BENCHMARK_DEFINE_F(ServerNameFilterChainBenchmarkFixture, FilterChainInPlaceUpdateTest)
+(::benchmark::State& state) {
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  FilterChainManagerImpl origin_filter_chain_manager{
+      std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234), factory_context,
+      init_manager_};
+  origin_filter_chain_manager.addFilterChain(filter_chains_, dummy_builder_,
+                                             origin_filter_chain_manager);
+  for (auto _ : state) {
+    FilterChainManagerImpl filter_chain_manager{
+        std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234), factory_context,
+        init_manager_, origin_filter_chain_manager};
+    filter_chain_manager.addFilterChain(updated_filter_chains_, dummy_builder_,
+                                        filter_chain_manager);
+  }
+}
+
+BENCHMARK_REGISTER_F(ServerNameFilterChainBenchmarkFixture, FilterChainFindByServerNameTest)
+    ->Ranges({
+        // scale of the chains
+        {2, 16384},
+    });
+BENCHMARK_REGISTER_F(ServerNameFilterChainBenchmarkFixture, FilterChainInPlaceUpdateTest)
+    ->Ranges({
+        // scale of the chains
+        {2, 16384},
+    });
+
 /*
 clang-format off
 
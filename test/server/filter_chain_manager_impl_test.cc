@@ -146,6 +146,42 @@ TEST_F(FilterChainManagerImplTest, AddSingleFilterChain) {
   EXPECT_NE(filter_chain, nullptr);
 }
 
+// Filter chains without source criteria are found without matching the source, while the others
+// still match on it.
+TEST_F(FilterChainManagerImplTest, FilterChainsWithAndWithoutSourceCriteria) {
+  envoy::config::listener::v3::FilterChain any_source = filter_chain_template_;
+  any_source.mutable_filter_chain_match()->add_server_names("a.example.com");
+  envoy::config::listener::v3::FilterChain wildcard_any_source = filter_chain_template_;
+  wildcard_any_source.mutable_filter_chain_match()->add_server_names("*.wild.example.com");
+  envoy::config::listener::v3::FilterChain some_source = filter_chain_template_;
+  some_source.mutable_filter_chain_match()->add_server_names("b.example.com");
+  auto* source_prefix_range = some_source.mutable_filter_chain_match()->add_source_prefix_ranges();
+  source_prefix_range->set_address_prefix("10.0.0.0");
+  source_prefix_range->mutable_prefix_len()->set_value(8);
+
+  auto any_source_filter_chain = std::make_shared<Network::MockFilterChain>();
+  auto wildcard_any_source_filter_chain = std::make_shared<Network::MockFilterChain>();
+  auto some_source_filter_chain = std::make_shared<Network::MockFilterChain>();
+  EXPECT_CALL(filter_chain_factory_builder_, buildFilterChain(_, _))
+      .WillOnce(Return(any_source_filter_chain))
+      .WillOnce(Return(wildcard_any_source_filter_chain))
+      .WillOnce(Return(some_source_filter_chain));
+  filter_chain_manager_.addFilterChain(
+      std::vector<const envoy::config::listener::v3::FilterChain*>{
+          &any_source, &wildcard_any_source, &some_source},
+      filter_chain_factory_builder_, filter_chain_manager_);
+
+  EXPECT_EQ(any_source_filter_chain.get(),
+            findFilterChainHelper(10000, "127.0.0.1", "a.example.com", "tls", {}, "8.8.8.8", 111));
+  EXPECT_EQ(wildcard_any_source_filter_chain.get(),
+            findFilterChainHelper(10000, "127.0.0.1", "www.wild.example.com", "tls", {}, "8.8.8.8",
+                                  111));
+  EXPECT_EQ(some_source_filter_chain.get(),
+            findFilterChainHelper(10000, "127.0.0.1", "b.example.com", "tls", {}, "10.1.2.3", 111));
+  EXPECT_EQ(nullptr,
+            findFilterChainHelper(10000, "127.0.0.1", "b.example.com", "tls", {}, "8.8.8.8", 111));
+}
+
 TEST_F(FilterChainManagerImplTest, LookupFilterChainContextByFilterChainMessage) {
   std::vector<envoy::config::listener::v3::FilterChain> filter_chain_messages;
 
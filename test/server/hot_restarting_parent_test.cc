@@ -5,6 +5,7 @@
 
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/server/mocks.h"
+#include "test/mocks/ssl/mocks.h"
 
 #include "gtest/gtest.h"
 
@@ -154,6 +155,25 @@ TEST_F(HotRestartingParentTest, DrainListeners) {
   hot_restarting_parent_.drainListeners();
 }
 
+TEST_F(HotRestartingParentTest, ExportSessionResumptionStateToChild) {
+  Ssl::MockContextManager context_manager;
+  Ssl::SessionResumptionState state;
+  state.sessions_ = {"session1", "session2"};
+  state.ticket_keys_ = {std::string(80, 'a')};
+  state.ticket_key_created_ = SystemTime(std::chrono::seconds(1234));
+  EXPECT_CALL(server_, sslContextManager()).WillOnce(ReturnRef(context_manager));
+  EXPECT_CALL(context_manager, exportSessionResumptionState()).WillOnce(Return(state));
+
+  HotRestartMessage::Reply::SessionResumptionState proto;
+  hot_restarting_parent_.exportSessionResumptionStateToChild(&proto);
+  ASSERT_EQ(2, proto.sessions_size());
+  EXPECT_EQ("session1", proto.sessions(0));
+  EXPECT_EQ("session2", proto.sessions(1));
+  ASSERT_EQ(1, proto.ticket_keys_size());
+  EXPECT_EQ(std::string(80, 'a'), proto.ticket_keys(0));
+  EXPECT_EQ(1234, proto.ticket_key_created_unix_seconds());
+}
+
 } // namespace
 } // namespace Server
 } // namespace Envoy
@@ -14,6 +14,7 @@
 #include "test/test_common/environment.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 
 using testing::_;
@@ -38,7 +39,8 @@ public:
     envoy::config::core::v3::ConfigSource lds_config;
     EXPECT_CALL(init_manager_, add(_));
     lds_ = std::make_unique<LdsApiImpl>(lds_config, cluster_manager_, init_manager_, store_,
-                                        listener_manager_, validation_visitor_);
+                                        listener_manager_, validation_visitor_, *api_,
+                                        decode_threads_);
     EXPECT_CALL(*cluster_manager_.subscription_factory_.subscription_, start(_));
     init_target_handle_->initialize(init_watcher_);
     lds_callbacks_ = cluster_manager_.subscription_factory_.callbacks_;
@@ -98,6 +100,8 @@ public:
   Config::SubscriptionCallbacks* lds_callbacks_{};
   std::unique_ptr<LdsApiImpl> lds_;
   NiceMock<ProtobufMessage::MockValidationVisitor> validation_visitor_;
+  Api::ApiPtr api_{Api::createApiForTest()};
+  uint32_t decode_threads_{};
 
 private:
   std::list<NiceMock<Network::MockListenerConfig>> listeners_;
@@ -208,6 +212,40 @@ TEST_F(LdsApiTest, ListenerCreationContinuesEvenAfterException) {
                             "wrong\ninvalid-listener-2: something else is wrong\n");
 }
 
+// Listeners decoded on decode threads are added in the order of the update, and invalid ones are
+// still reported.
+TEST_F(LdsApiTest, ListenerCreationWithDecodeThreads) {
+  decode_threads_ = 2;
+  InSequence s;
+
+  setup();
+
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> listeners;
+  std::vector<std::reference_wrapper<Network::ListenerConfig>> existing_listeners;
+  EXPECT_CALL(listener_manager_, listeners()).WillOnce(Return(existing_listeners));
+  EXPECT_CALL(listener_manager_, beginListenerUpdate());
+  for (int i = 0; i < 64; i++) {
+    const std::string listener_name = absl::StrCat("listener-", i);
+    if (i == 42) {
+      // The listener without address does not satisfy its constraints.
+      envoy::config::listener::v3::Listener listener;
+      listener.set_name(listener_name);
+      listeners.Add()->PackFrom(listener);
+    } else {
+      addListener(listeners, listener_name);
+      expectAdd(listener_name, "1", true);
+    }
+  }
+  EXPECT_CALL(listener_manager_, endListenerUpdate(_))
+      .WillOnce(Invoke([](ListenerManager::FailureStates&& state) { EXPECT_EQ(1, state.size()); }));
+  EXPECT_CALL(init_watcher_, ready());
+
+  EXPECT_THROW_WITH_REGEX(lds_callbacks_->onConfigUpdate(listeners, "1"), EnvoyException,
+                          "Error adding/updating listener\\(s\\) : Proto constraint "
+                          "validation failed");
+  EXPECT_EQ("1", lds_->versionInfo());
+}
+
 // Validate onConfigUpdate throws EnvoyException with duplicate listeners.
 // The first of the duplicates will be successfully applied, with the rest adding to
 // the exception message.
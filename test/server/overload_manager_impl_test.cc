@@ -219,6 +219,107 @@ TEST_F(OverloadManagerImplTest, CallbackOnlyFiresWhenStateChanges) {
   manager->stop();
 }
 
+TEST_F(OverloadManagerImplTest, ScaledTrigger) {
+  setDispatcherExpectation();
+
+  const std::string config = R"EOF(
+    resource_monitors {
+      name: "envoy.resource_monitors.fake_resource1"
+    }
+    actions {
+      name: "envoy.overload_actions.dummy_action"
+      triggers {
+        name: "envoy.resource_monitors.fake_resource1"
+        scaled {
+          scaling_threshold: 0.5
+          saturation_threshold: 0.9
+        }
+      }
+    }
+  )EOF";
+
+  auto manager(createOverloadManager(config));
+  bool is_active = false;
+  int cb_count = 0;
+  manager->registerForAction("envoy.overload_actions.dummy_action", dispatcher_,
+                             [&](OverloadActionState state) {
+                               is_active = state == OverloadActionState::Active;
+                               cb_count++;
+                             });
+  manager->start();
+
+  Stats::Gauge& active_gauge = stats_.gauge("overload.envoy.overload_actions.dummy_action.active",
+                                            Stats::Gauge::ImportMode::Accumulate);
+  Stats::Gauge& scale_percent_gauge =
+      stats_.gauge("overload.envoy.overload_actions.dummy_action.scale_percent",
+                   Stats::Gauge::ImportMode::NeverImport);
+  ThreadLocalOverloadState& overload_state = manager->getThreadLocalOverloadState();
+  const OverloadActionState& action_state =
+      overload_state.getState("envoy.overload_actions.dummy_action");
+  const double& action_scale = overload_state.getScale("envoy.overload_actions.dummy_action");
+
+  factory1_.monitor_->setPressure(0.5);
+  timer_cb_();
+  EXPECT_EQ(0, action_scale);
+  EXPECT_EQ(action_state, OverloadActionState::Inactive);
+  EXPECT_EQ(0, scale_percent_gauge.value());
+
+  // The action scales without becoming active.
+  factory1_.monitor_->setPressure(0.6);
+  timer_cb_();
+  EXPECT_DOUBLE_EQ(0.25, action_scale);
+  EXPECT_EQ(action_state, OverloadActionState::Inactive);
+  EXPECT_FALSE(is_active);
+  EXPECT_EQ(0, cb_count);
+  EXPECT_EQ(0, active_gauge.value());
+  EXPECT_EQ(25, scale_percent_gauge.value());
+
+  factory1_.monitor_->setPressure(0.95);
+  timer_cb_();
+  EXPECT_EQ(1, action_scale);
+  EXPECT_EQ(action_state, OverloadActionState::Active);
+  EXPECT_TRUE(is_active);
+  EXPECT_EQ(1, cb_count);
+  EXPECT_EQ(1, active_gauge.value());
+  EXPECT_EQ(100, scale_percent_gauge.value());
+
+  factory1_.monitor_->setPressure(0.8);
+  timer_cb_();
+  EXPECT_DOUBLE_EQ(0.75, action_scale);
+  EXPECT_EQ(action_state, OverloadActionState::Inactive);
+  EXPECT_FALSE(is_active);
+  EXPECT_EQ(2, cb_count);
+  EXPECT_EQ(0, active_gauge.value());
+
+  factory1_.monitor_->setPressure(0.1);
+  timer_cb_();
+  EXPECT_EQ(0, action_scale);
+  EXPECT_EQ(2, cb_count);
+
+  manager->stop();
+}
+
+TEST_F(OverloadManagerImplTest, ScaledTriggerThresholdsOutOfOrder) {
+  const std::string config = R"EOF(
+    resource_monitors {
+      name: "envoy.resource_monitors.fake_resource1"
+    }
+    actions {
+      name: "envoy.overload_actions.dummy_action"
+      triggers {
+        name: "envoy.resource_monitors.fake_resource1"
+        scaled {
+          scaling_threshold: 0.9
+          saturation_threshold: 0.8
+        }
+      }
+    }
+  )EOF";
+
+  EXPECT_THROW_WITH_MESSAGE(createOverloadManager(config), EnvoyException,
+                            "scaling_threshold must be less than saturation_threshold");
+}
+
 TEST_F(OverloadManagerImplTest, FailedUpdates) {
   setDispatcherExpectation();
   auto manager(createOverloadManager(getConfig()));